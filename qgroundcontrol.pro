@@ -373,6 +373,7 @@ FORMS += \
     src/ui/QGCHilConfiguration.ui \
     src/ui/QGCHilFlightGearConfiguration.ui \
     src/ui/QGCHilJSBSimConfiguration.ui \
+    src/ui/QGCHilLockstepConfiguration.ui \
     src/ui/QGCHilXPlaneConfiguration.ui \
     src/ui/QGCMAVLinkInspector.ui \
     src/ui/QGCMAVLinkLogPlayer.ui \
@@ -411,10 +412,13 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory  { APMFirmwarePlugin {
     HEADERS += \
         src/AnalyzeView/LogDownloadTest.h \
         src/Audio/AudioOutputTest.h \
+        src/FactSystem/FactMetaDataTest.h \
         src/FactSystem/FactSystemTestBase.h \
         src/FactSystem/FactSystemTestGeneric.h \
         src/FactSystem/FactSystemTestPX4.h \
         src/FactSystem/ParameterManagerTest.h \
+        src/GPS/RTCM/NTRIPSourceTest.h \
+        src/GPS/RTCM/RTCMMavlinkTest.h \
         src/MissionManager/CameraCalcTest.h \
         src/MissionManager/CameraSectionTest.h \
         src/MissionManager/CorridorScanComplexItemTest.h \
@@ -434,28 +438,43 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory  { APMFirmwarePlugin {
         src/MissionManager/SurveyMissionItemTest.h \
         src/MissionManager/TransectStyleComplexItemTest.h \
         src/MissionManager/VisualMissionItemTest.h \
+        src/qgcunittest/Crc32Test.h \
         src/qgcunittest/FileDialogTest.h \
         src/qgcunittest/FileManagerTest.h \
         src/qgcunittest/FlightGearTest.h \
         src/qgcunittest/GeoTest.h \
+        src/qgcunittest/HilLockstepProtocolTest.h \
+        src/qgcunittest/VideoLatencyProbeTest.h \
         src/qgcunittest/LinkManagerTest.h \
+        src/qgcunittest/LinkQualityStatisticsTest.h \
         src/qgcunittest/MainWindowTest.h \
+        src/qgcunittest/MAVLinkMessageStatisticsTest.h \
         src/qgcunittest/MavlinkLogTest.h \
         src/qgcunittest/MessageBoxTest.h \
+        src/qgcunittest/MockLinkSwarmTest.h \
         src/qgcunittest/MultiSignalSpy.h \
+        src/qgcunittest/PX4FirmwareBatchFlasherTest.h \
         src/qgcunittest/RadioConfigTest.h \
+        src/qgcunittest/SerialPortWatcherTest.h \
         src/qgcunittest/TCPLinkTest.h \
         src/qgcunittest/TCPLoopBackServer.h \
         src/qgcunittest/UnitTest.h \
+        src/Vehicle/ImageCoverageTest.h \
+        src/Vehicle/MAVLinkLogProcessorTest.h \
         src/Vehicle/SendMavCommandTest.h \
+        src/Vehicle/TrajectoryPointsTest.h \
+        src/Vehicle/ULogStreamDecoderTest.h \
 
     SOURCES += \
         src/AnalyzeView/LogDownloadTest.cc \
         src/Audio/AudioOutputTest.cc \
+        src/FactSystem/FactMetaDataTest.cc \
         src/FactSystem/FactSystemTestBase.cc \
         src/FactSystem/FactSystemTestGeneric.cc \
         src/FactSystem/FactSystemTestPX4.cc \
         src/FactSystem/ParameterManagerTest.cc \
+        src/GPS/RTCM/NTRIPSourceTest.cc \
+        src/GPS/RTCM/RTCMMavlinkTest.cc \
         src/MissionManager/CameraCalcTest.cc \
         src/MissionManager/CameraSectionTest.cc \
         src/MissionManager/CorridorScanComplexItemTest.cc \
@@ -475,23 +494,63 @@ DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory  { APMFirmwarePlugin {
         src/MissionManager/SurveyMissionItemTest.cc \
         src/MissionManager/TransectStyleComplexItemTest.cc \
         src/MissionManager/VisualMissionItemTest.cc \
+        src/qgcunittest/Crc32Test.cc \
         src/qgcunittest/FileDialogTest.cc \
         src/qgcunittest/FileManagerTest.cc \
         src/qgcunittest/FlightGearTest.cc \
         src/qgcunittest/GeoTest.cc \
+        src/qgcunittest/HilLockstepProtocolTest.cc \
+        src/qgcunittest/VideoLatencyProbeTest.cc \
         src/qgcunittest/LinkManagerTest.cc \
+        src/qgcunittest/LinkQualityStatisticsTest.cc \
         src/qgcunittest/MainWindowTest.cc \
+        src/qgcunittest/MAVLinkMessageStatisticsTest.cc \
         src/qgcunittest/MavlinkLogTest.cc \
         src/qgcunittest/MessageBoxTest.cc \
+        src/qgcunittest/MockLinkSwarmTest.cc \
         src/qgcunittest/MultiSignalSpy.cc \
+        src/qgcunittest/PX4FirmwareBatchFlasherTest.cc \
         src/qgcunittest/RadioConfigTest.cc \
+        src/qgcunittest/SerialPortWatcherTest.cc \
         src/qgcunittest/TCPLinkTest.cc \
         src/qgcunittest/TCPLoopBackServer.cc \
         src/qgcunittest/UnitTest.cc \
         src/qgcunittest/UnitTestList.cc \
+        src/Vehicle/ImageCoverageTest.cc \
+        src/Vehicle/MAVLinkLogProcessorTest.cc \
         src/Vehicle/SendMavCommandTest.cc \
+        src/Vehicle/TrajectoryPointsTest.cc \
+        src/Vehicle/ULogStreamDecoderTest.cc \
 } } } } } }
 
+#
+# Telemetry benchmarks, qmake CONFIG+=QGCBenchmark on top of the unit test build. Run with --benchmark[:results.json]
+#
+
+DebugBuild { PX4FirmwarePlugin { PX4FirmwarePluginFactory  { APMFirmwarePlugin { APMFirmwarePluginFactory { !MobileBuild { QGCBenchmark {
+    message("Telemetry benchmarks enabled")
+    DEFINES += QGC_BENCHMARK_BUILD
+
+    HEADERS += \
+        src/qgcunittest/TelemetryBenchmark.h \
+
+    BenchmarkSources = \
+        src/qgcunittest/TelemetryBenchmark.cc \
+
+    # The benchmarks need MockLink from the debug flavor. Only the benchmark sources are optimized, the rest of the
+    # debug build keeps its flags.
+    WindowsBuild {
+        SOURCES += $$BenchmarkSources
+    } else {
+        BenchmarkCompiler.input         = BenchmarkSources
+        BenchmarkCompiler.output        = ${QMAKE_VAR_OBJECTS_DIR}${QMAKE_FILE_BASE}$${first(QMAKE_EXT_OBJ)}
+        BenchmarkCompiler.commands      = $(CXX) -c $(CXXFLAGS) -O2 $(INCPATH) ${QMAKE_FILE_IN} -o ${QMAKE_FILE_OUT}
+        BenchmarkCompiler.dependency_type = TYPE_C
+        BenchmarkCompiler.variable_out  = OBJECTS
+        QMAKE_EXTRA_COMPILERS          += BenchmarkCompiler
+    }
+} } } } } } }
+
 # Main QGC Headers and Source files
 
 HEADERS += \
@@ -523,6 +582,7 @@ HEADERS += \
     src/MissionManager/GeoFenceManager.h \
     src/MissionManager/KML.h \
     src/MissionManager/MissionCommandList.h \
+    src/MissionManager/MissionCommandTable.h \
     src/MissionManager/MissionCommandTree.h \
     src/MissionManager/MissionCommandUIInfo.h \
     src/MissionManager/MissionController.h \
@@ -562,6 +622,7 @@ HEADERS += \
     src/QGCQGeoCoordinate.h \
     src/QGCQmlWidgetHolder.h \
     src/QGCQuickWidget.h \
+    src/QGCStartupProfiler.h \
     src/QGCTemporaryFile.h \
     src/QGCToolbox.h \
     src/QmlControls/AppMessages.h \
@@ -588,10 +649,13 @@ HEADERS += \
     src/Settings/VideoSettings.h \
     src/Terrain.h \
     src/Vehicle/MAVLinkLogManager.h \
+    src/Vehicle/ULogStreamDecoder.h \
     src/VehicleSetup/JoystickConfigController.h \
     src/comm/LinkConfiguration.h \
     src/comm/LinkInterface.h \
     src/comm/LinkManager.h \
+    src/comm/LinkQualityStatistics.h \
+    src/comm/MAVLinkMessageStatistics.h \
     src/comm/MAVLinkProtocol.h \
     src/comm/ProtocolInterface.h \
     src/comm/QGCMAVLink.h \
@@ -612,6 +676,7 @@ HEADERS += \
     src/comm/MockLink.h \
     src/comm/MockLinkFileServer.h \
     src/comm/MockLinkMissionItemHandler.h \
+    src/comm/MockLinkSwarm.h \
 }
 
 WindowsBuild {
@@ -630,6 +695,7 @@ contains(DEFINES, QGC_ENABLE_BLUETOOTH) {
 HEADERS += \
     src/comm/QGCSerialPortInfo.h \
     src/comm/SerialLink.h \
+    src/comm/SerialPortWatcher.h \
 }
 
 !MobileBuild {
@@ -641,6 +707,8 @@ HEADERS += \
     src/GPS/GPSManager.h \
     src/GPS/GPSPositionMessage.h \
     src/GPS/GPSProvider.h \
+    src/GPS/RTCM/NTRIPSource.h \
+    src/GPS/RTCM/RTCM3Parser.h \
     src/GPS/RTCM/RTCMMavlink.h \
     src/GPS/definitions.h \
     src/GPS/satellite_info.h \
@@ -654,8 +722,10 @@ HEADERS += \
     src/ViewWidgets/ViewWidgetController.h \
     src/comm/LogReplayLink.h \
     src/comm/QGCFlightGearLink.h \
+    src/comm/HilLockstepProtocol.h \
     src/comm/QGCHilLink.h \
     src/comm/QGCJSBSimLink.h \
+    src/comm/QGCLockstepHilLink.h \
     src/comm/QGCXPlaneLink.h \
     src/uas/FileManager.h \
     src/ui/HILDockWidget.h \
@@ -665,6 +735,7 @@ HEADERS += \
     src/ui/QGCHilConfiguration.h \
     src/ui/QGCHilFlightGearConfiguration.h \
     src/ui/QGCHilJSBSimConfiguration.h \
+    src/ui/QGCHilLockstepConfiguration.h \
     src/ui/QGCHilXPlaneConfiguration.h \
     src/ui/QGCMAVLinkInspector.h \
     src/ui/QGCMAVLinkLogPlayer.h \
@@ -718,6 +789,7 @@ SOURCES += \
     src/MissionManager/GeoFenceManager.cc \
     src/MissionManager/KML.cc \
     src/MissionManager/MissionCommandList.cc \
+    src/MissionManager/MissionCommandTable.cc \
     src/MissionManager/MissionCommandTree.cc \
     src/MissionManager/MissionCommandUIInfo.cc \
     src/MissionManager/MissionController.cc \
@@ -755,6 +827,7 @@ SOURCES += \
     src/QGCQGeoCoordinate.cc \
     src/QGCQmlWidgetHolder.cpp \
     src/QGCQuickWidget.cc \
+    src/QGCStartupProfiler.cc \
     src/QGCTemporaryFile.cc \
     src/QGCToolbox.cc \
     src/QmlControls/AppMessages.cc \
@@ -780,10 +853,13 @@ SOURCES += \
     src/Settings/VideoSettings.cc \
     src/Terrain.cc \
     src/Vehicle/MAVLinkLogManager.cc \
+    src/Vehicle/ULogStreamDecoder.cc \
     src/VehicleSetup/JoystickConfigController.cc \
     src/comm/LinkConfiguration.cc \
     src/comm/LinkInterface.cc \
     src/comm/LinkManager.cc \
+    src/comm/LinkQualityStatistics.cc \
+    src/comm/MAVLinkMessageStatistics.cc \
     src/comm/MAVLinkProtocol.cc \
     src/comm/QGCMAVLink.cc \
     src/comm/TCPLink.cc \
@@ -798,12 +874,14 @@ SOURCES += \
     src/comm/MockLink.cc \
     src/comm/MockLinkFileServer.cc \
     src/comm/MockLinkMissionItemHandler.cc \
+    src/comm/MockLinkSwarm.cc \
 }
 
 !NoSerialBuild {
 SOURCES += \
     src/comm/QGCSerialPortInfo.cc \
     src/comm/SerialLink.cc \
+    src/comm/SerialPortWatcher.cc \
 }
 
 contains(DEFINES, QGC_ENABLE_BLUETOOTH) {
@@ -819,6 +897,8 @@ SOURCES += \
     src/GPS/Drivers/src/ubx.cpp \
     src/GPS/GPSManager.cc \
     src/GPS/GPSProvider.cc \
+    src/GPS/RTCM/NTRIPSource.cc \
+    src/GPS/RTCM/RTCM3Parser.cc \
     src/GPS/RTCM/RTCMMavlink.cc \
     src/Joystick/JoystickSDL.cc \
     src/QGCQFileDialog.cc \
@@ -827,8 +907,10 @@ SOURCES += \
     src/ViewWidgets/CustomCommandWidgetController.cc \
     src/ViewWidgets/ViewWidgetController.cc \
     src/comm/LogReplayLink.cc \
+    src/comm/HilLockstepProtocol.cc \
     src/comm/QGCFlightGearLink.cc \
     src/comm/QGCJSBSimLink.cc \
+    src/comm/QGCLockstepHilLink.cc \
     src/comm/QGCXPlaneLink.cc \
     src/uas/FileManager.cc \
     src/ui/HILDockWidget.cc \
@@ -838,6 +920,7 @@ SOURCES += \
     src/ui/QGCHilConfiguration.cc \
     src/ui/QGCHilFlightGearConfiguration.cc \
     src/ui/QGCHilJSBSimConfiguration.cc \
+    src/ui/QGCHilLockstepConfiguration.cc \
     src/ui/QGCHilXPlaneConfiguration.cc \
     src/ui/QGCMAVLinkInspector.cc \
     src/ui/QGCMAVLinkLogPlayer.cc \
@@ -885,6 +968,8 @@ HEADERS+= \
     src/Vehicle/ADSBVehicle.h \
     src/Vehicle/MultiVehicleManager.h \
     src/Vehicle/GPSRTKFactGroup.h \
+    src/Vehicle/ImageCoverage.h \
+    src/Vehicle/TrajectoryPoints.h \
     src/Vehicle/Vehicle.h \
     src/VehicleSetup/VehicleComponent.h \
 
@@ -893,6 +978,7 @@ HEADERS+= \
         src/VehicleSetup/Bootloader.h \
         src/VehicleSetup/FirmwareImage.h \
         src/VehicleSetup/FirmwareUpgradeController.h \
+        src/VehicleSetup/PX4FirmwareBatchFlasher.h \
         src/VehicleSetup/PX4FirmwareUpgradeThread.h \
 }
 
@@ -911,6 +997,8 @@ SOURCES += \
     src/Vehicle/ADSBVehicle.cc \
     src/Vehicle/MultiVehicleManager.cc \
     src/Vehicle/GPSRTKFactGroup.cc \
+    src/Vehicle/ImageCoverage.cc \
+    src/Vehicle/TrajectoryPoints.cc \
     src/Vehicle/Vehicle.cc \
     src/VehicleSetup/VehicleComponent.cc \
 
@@ -919,6 +1007,7 @@ SOURCES += \
         src/VehicleSetup/Bootloader.cc \
         src/VehicleSetup/FirmwareImage.cc \
         src/VehicleSetup/FirmwareUpgradeController.cc \
+        src/VehicleSetup/PX4FirmwareBatchFlasher.cc \
         src/VehicleSetup/PX4FirmwareUpgradeThread.cc \
 }
 
@@ -1076,6 +1165,8 @@ INCLUDEPATH += \
 
 HEADERS += \
     src/VideoStreaming/VideoItem.h \
+    src/VideoStreaming/VideoLatencyFactGroup.h \
+    src/VideoStreaming/VideoLatencyProbe.h \
     src/VideoStreaming/VideoReceiver.h \
     src/VideoStreaming/VideoStreaming.h \
     src/VideoStreaming/VideoSurface.h \
@@ -1083,6 +1174,8 @@ HEADERS += \
 
 SOURCES += \
     src/VideoStreaming/VideoItem.cc \
+    src/VideoStreaming/VideoLatencyFactGroup.cc \
+    src/VideoStreaming/VideoLatencyProbe.cc \
     src/VideoStreaming/VideoReceiver.cc \
     src/VideoStreaming/VideoStreaming.cc \
     src/VideoStreaming/VideoSurface.cc \
@@ -1096,6 +1189,35 @@ contains (CONFIG, DISABLE_VIDEOSTREAMING) {
     include(src/VideoStreaming/VideoStreaming.pri)
 }
 
+#-------------------------------------------------------------------------------------
+#
+# Precompiled mission command tables
+#
+# The MavCmdInfo json hierarchy is collapsed for each firmware/vehicle type at build
+# time (requires python). Without the tables the json is loaded at runtime.
+
+contains (CONFIG, QGC_DISABLE_MISSION_COMMAND_TABLE) {
+    message("Disable precompiled mission command tables")
+    DEFINES += QGC_DISABLE_MISSION_COMMAND_TABLE
+} else:CustomBuild:exists($$PWD/custom/qgroundcontrol.qrc) {
+    # The custom resources may replace the MavCmdInfo json files
+    message("Disable precompiled mission command tables for custom qgroundcontrol.qrc")
+    DEFINES += QGC_DISABLE_MISSION_COMMAND_TABLE
+} else {
+    MissionCommandTableJson = \
+        $$files($$PWD/src/MissionManager/MavCmdInfo*.json) \
+        $$files($$PWD/src/FirmwarePlugin/APM/MavCmdInfo*.json) \
+        $$files($$PWD/src/FirmwarePlugin/PX4/MavCmdInfo*.json)
+
+    MissionCommandTable.input           = MissionCommandTableJson
+    MissionCommandTable.output          = $$OUT_PWD/MissionCommandTableData.cc
+    MissionCommandTable.commands        = python $$PWD/tools/generate_mission_command_table.py $$PWD ${QMAKE_FILE_OUT}
+    MissionCommandTable.depends         = $$PWD/tools/generate_mission_command_table.py
+    MissionCommandTable.variable_out    = SOURCES
+    MissionCommandTable.CONFIG         += combine
+    QMAKE_EXTRA_COMPILERS              += MissionCommandTable
+}
+
 #-------------------------------------------------------------------------------------
 # Android
 
@@ -25,7 +25,7 @@ FactGroup::FactGroup(int updateRateMsecs, const QString& metaDataFile, QObject*
     , _updateRateMSecs(updateRateMsecs)
 {
     _setupTimer();
-    _nameToFactMetaDataMap = FactMetaData::createMapFromJsonFile(metaDataFile, this);
+    _nameToFactMetaDataMap = FactMetaData::sharedMapFromJsonFile(metaDataFile);
 }
 
 FactGroup::FactGroup(int updateRateMsecs, QObject* parent)
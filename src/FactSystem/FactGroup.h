@@ -20,6 +20,10 @@
 
 Q_DECLARE_LOGGING_CATEGORY(VehicleLog)
 
+#ifdef UNITTEST_BUILD
+    class FactMetaDataTest;
+#endif
+
 /// Used to group Facts together into an object hierarachy.
 class FactGroup : public QObject
 {
@@ -58,8 +62,11 @@ private:
 protected:
     QMap<QString, Fact*>            _nameToFactMap;
     QMap<QString, FactGroup*>       _nameToFactGroupMap;
-    QMap<QString, FactMetaData*>    _nameToFactMetaDataMap;
+    QMap<QString, FactMetaData*>    _nameToFactMetaDataMap;     ///< Shared meta data when loaded from a file, must not be modified
 
+#ifdef UNITTEST_BUILD
+    friend class FactMetaDataTest;
+#endif
 };
 
 #endif
@@ -11,15 +11,22 @@
 #include "SettingsManager.h"
 #include "JsonHelper.h"
 #include "QGCApplication.h"
+#include "QGCLoggingCategory.h"
+#include "QGCStartupProfiler.h"
 
 #include <QDebug>
 #include <QtMath>
 #include <QJsonParseError>
 #include <QJsonArray>
+#include <QMutex>
+#include <QHash>
+#include <QElapsedTimer>
 
 #include <limits>
 #include <cmath>
 
+QGC_LOGGING_CATEGORY(FactMetaDataLog, "FactMetaDataLog")
+
 // Conversion Constants
 // Time
 const qreal FactMetaData::UnitConsts_s::secondsPerHour = 3600.0;
@@ -1132,7 +1139,7 @@ FactMetaData* FactMetaData::createFromJsonObject(const QJsonObject& json, QObjec
     return metaData;
 }
 
-QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonFile(const QString& jsonFilename, QObject* metaDataParent)
+static QMap<QString, FactMetaData*> _loadMapFromJsonFile(const QString& jsonFilename)
 {
     QMap<QString, FactMetaData*> metaDataMap;
 
@@ -1157,7 +1164,44 @@ QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonFile(const QString&
     }
 
     QJsonArray jsonArray = doc.array();
-    return createMapFromJsonArray(jsonArray, metaDataParent);
+    return FactMetaData::createMapFromJsonArray(jsonArray, NULL /* metaDataParent */);
+}
+
+QMap<QString, FactMetaData*> FactMetaData::sharedMapFromJsonFile(const QString& jsonFilename)
+{
+    static QMutex                                           sharedMapsMutex;
+    static QHash<QString, QMap<QString, FactMetaData*> >    sharedMaps;
+
+    QMutexLocker lock(&sharedMapsMutex);
+
+    QHash<QString, QMap<QString, FactMetaData*> >::const_iterator iter = sharedMaps.constFind(jsonFilename);
+    if (iter != sharedMaps.constEnd()) {
+        return iter.value();
+    }
+
+    QGCStartupTimer startupTimer("load", jsonFilename);
+    QElapsedTimer timer;
+    timer.start();
+    QMap<QString, FactMetaData*> metaDataMap = _loadMapFromJsonFile(jsonFilename);
+    qCDebug(FactMetaDataLog) << "Loaded" << jsonFilename << metaDataMap.count() << "facts" << timer.nsecsElapsed() / 1000 << "usecs";
+
+    // Failed loads are cached as well, there is no point in trying again
+    sharedMaps.insert(jsonFilename, metaDataMap);
+
+    return metaDataMap;
+}
+
+QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonFile(const QString& jsonFilename, QObject* metaDataParent)
+{
+    QMap<QString, FactMetaData*> metaDataMap;
+
+    QMapIterator<QString, FactMetaData*> iter(sharedMapFromJsonFile(jsonFilename));
+    while (iter.hasNext()) {
+        iter.next();
+        metaDataMap[iter.key()] = new FactMetaData(*iter.value(), metaDataParent);
+    }
+
+    return metaDataMap;
 }
 
 QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonArray(const QJsonArray jsonArray, QObject* metaDataParent)
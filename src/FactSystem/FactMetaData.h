@@ -18,6 +18,9 @@
 #include <QString>
 #include <QVariant>
 #include <QJsonObject>
+#include <QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(FactMetaDataLog)
 
 /// Holds the meta data associated with a Fact.
 ///
@@ -53,7 +56,14 @@ public:
     FactMetaData(ValueType_t type, const QString name, QObject* parent = NULL);
     FactMetaData(const FactMetaData& other, QObject* parent = NULL);
 
+    /// Returns a private copy of the meta data for the specified json file. Use this if the meta data is changed
+    /// after loading, otherwise use sharedMapFromJsonFile.
     static QMap<QString, FactMetaData*> createMapFromJsonFile(const QString& jsonFilename, QObject* metaDataParent);
+
+    /// Returns the meta data for the specified json file. The file is only read and parsed on the first call, after that
+    /// all callers get the same instances. These live until the process exits and must not be modified.
+    static QMap<QString, FactMetaData*> sharedMapFromJsonFile(const QString& jsonFilename);
+
     static QMap<QString, FactMetaData*> createMapFromJsonArray(const QJsonArray jsonArray, QObject* metaDataParent);
 
     static FactMetaData* createFromJsonObject(const QJsonObject& json, QObject* metaDataParent);
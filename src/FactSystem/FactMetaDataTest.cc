@@ -0,0 +1,79 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "FactMetaDataTest.h"
+#include "FactMetaData.h"
+#include "FactGroup.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonArray>
+
+static const char* _gpsFactFile = ":/json/Vehicle/GPSFact.json";
+
+void FactMetaDataTest::_sharedMap_test(void)
+{
+    QMap<QString, FactMetaData*> map1 = FactMetaData::sharedMapFromJsonFile(_gpsFactFile);
+    QMap<QString, FactMetaData*> map2 = FactMetaData::sharedMapFromJsonFile(_gpsFactFile);
+
+    QVERIFY(map1.count() > 0);
+    QCOMPARE(map1, map2);
+
+    // FactGroups for the same file share the meta data
+    FactGroup group1(0, _gpsFactFile);
+    FactGroup group2(0, _gpsFactFile);
+    QCOMPARE(group1._nameToFactMetaDataMap, map1);
+    QCOMPARE(group2._nameToFactMetaDataMap, map1);
+}
+
+void FactMetaDataTest::_privateCopy_test(void)
+{
+    QObject                         parent;
+    QMap<QString, FactMetaData*>    sharedMap = FactMetaData::sharedMapFromJsonFile(_gpsFactFile);
+    QMap<QString, FactMetaData*>    copyMap = FactMetaData::createMapFromJsonFile(_gpsFactFile, &parent);
+
+    QCOMPARE(copyMap.keys(), sharedMap.keys());
+    foreach (const QString& name, sharedMap.keys()) {
+        FactMetaData* sharedMetaData = sharedMap[name];
+        FactMetaData* copyMetaData = copyMap[name];
+
+        QVERIFY(sharedMetaData != copyMetaData);
+        QCOMPARE(copyMetaData->parent(), &parent);
+        QCOMPARE(copyMetaData->type(), sharedMetaData->type());
+        QCOMPARE(copyMetaData->rawUnits(), sharedMetaData->rawUnits());
+        QCOMPARE(copyMetaData->decimalPlaces(), sharedMetaData->decimalPlaces());
+    }
+
+    // Changes to the copy must not show up in the shared instance
+    FactMetaData* copyMetaData = copyMap.first();
+    QString sharedDescription = sharedMap.first()->shortDescription();
+    copyMetaData->setShortDescription(QStringLiteral("changed"));
+    QCOMPARE(sharedMap.first()->shortDescription(), sharedDescription);
+}
+
+// Repeated loads must hand out the instances from the first load instead of parsing the json again
+void FactMetaDataTest::_repeatedLoad_test(void)
+{
+    const int cLoads = 100;
+
+    QFile jsonFile(_gpsFactFile);
+    QVERIFY(jsonFile.open(QIODevice::ReadOnly | QIODevice::Text));
+    QObject                         parsedParent;
+    QMap<QString, FactMetaData*>    parsedMap = FactMetaData::createMapFromJsonArray(QJsonDocument::fromJson(jsonFile.readAll()).array(), &parsedParent);
+
+    QMap<QString, FactMetaData*> firstMap = FactMetaData::sharedMapFromJsonFile(_gpsFactFile);
+    QCOMPARE(firstMap.keys(), parsedMap.keys());
+
+    for (int i=0; i<cLoads; i++) {
+        QMap<QString, FactMetaData*> map = FactMetaData::sharedMapFromJsonFile(_gpsFactFile);
+        foreach (const QString& name, firstMap.keys()) {
+            QCOMPARE(map[name], firstMap[name]);
+        }
+    }
+}
@@ -0,0 +1,26 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef FactMetaDataTest_H
+#define FactMetaDataTest_H
+
+#include "UnitTest.h"
+
+/// Unit test for the shared FactMetaData maps
+class FactMetaDataTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _sharedMap_test(void);
+    void _privateCopy_test(void);
+    void _repeatedLoad_test(void);
+};
+
+#endif
@@ -163,6 +163,14 @@ QGCView {
                         visible:                _activeVehicle.cameraTriggerPoints.count != 0
                     }
 
+                    QGCLabel {
+                        Layout.fillWidth:       true
+                        text:                   qsTr("Survey coverage %1%, overlap %2%, gaps %3 m²").arg(_activeVehicle.imageCoverage.coveredPercent.toFixed(1)).arg(_activeVehicle.imageCoverage.overlapPercent.toFixed(1)).arg(_activeVehicle.imageCoverage.gapArea.toFixed(0))
+                        horizontalAlignment:    Text.AlignHCenter
+                        wrapMode:               Text.WordWrap
+                        visible:                _activeVehicle.imageCoverage.captureCount != 0
+                    }
+
                     QGCButton {
                         Layout.fillWidth:   true
                         text:               qsTr("Remove plan from vehicle")
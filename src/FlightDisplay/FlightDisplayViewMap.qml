@@ -163,18 +163,56 @@ FlightMap {
         property real leftToolWidth:    toolStrip.x + toolStrip.width
     }
 
-    // Add trajectory points to the map
-    MapItemView {
-        model: _mainIsMap ? _activeVehicle ? _activeVehicle.trajectoryPoints : 0 : 0
-
-        delegate: MapPolyline {
-            line.width: 3
-            line.color: "red"
-            z:          QGroundControl.zOrderTrajectoryLines
-            path: [
-                object.coordinate1,
-                object.coordinate2,
-            ]
+    // Add the trajectory of the active vehicle to the map
+    MapPolyline {
+        id:         trajectoryPolyline
+        line.width: 3
+        line.color: "red"
+        z:          QGroundControl.zOrderTrajectoryLines
+        visible:    _mainIsMap
+
+        property var _trajectoryPoints: _activeVehicle ? _activeVehicle.trajectoryPoints : null
+
+        /// Loads the whole trail, simplified to about a pixel at the current zoom level
+        function reload() {
+            if (!_trajectoryPoints) {
+                path = []
+                return
+            }
+            var coord1 = flightMap.toCoordinate(Qt.point(flightMap.width / 2, flightMap.height / 2), false /* clipToViewPort */)
+            var coord2 = flightMap.toCoordinate(Qt.point((flightMap.width / 2) + 1, flightMap.height / 2), false /* clipToViewPort */)
+            var tolerance = coord1.isValid && coord2.isValid ? coord1.distanceTo(coord2) : 0
+            path = _trajectoryPoints.simplifiedList(tolerance)
+        }
+
+        on_TrajectoryPointsChanged: reload()
+
+        Connections {
+            target: trajectoryPolyline._trajectoryPoints
+
+            onPointAdded:       trajectoryPolyline.addCoordinate(coordinate)
+            onPointsCleared:    trajectoryPolyline.path = []
+            onPointsSimplified: trajectoryPolyline.reload()
+
+            onUpdateLastPoint: {
+                if (trajectoryPolyline.pathLength() === 0) {
+                    trajectoryPolyline.addCoordinate(coordinate)
+                } else {
+                    trajectoryPolyline.replaceCoordinate(trajectoryPolyline.pathLength() - 1, coordinate)
+                }
+            }
+        }
+
+        // Reloading on every zoom step while pinching is wasted work
+        Timer {
+            id:         trajectoryReloadTimer
+            interval:   250
+            onTriggered: trajectoryPolyline.reload()
+        }
+
+        Connections {
+            target:             flightMap
+            onZoomLevelChanged: trajectoryReloadTimer.restart()
         }
     }
 
@@ -273,6 +311,24 @@ FlightMap {
         }
     }    
 
+    // Survey coverage from the camera trigger feedback, a single image with one pixel per raster cell
+    MapQuickItem {
+        id:             imageCoverageItem
+        coordinate:     _imageCoverage ? _imageCoverage.topLeft : QtPositioning.coordinate()
+        visible:        _mainIsMap && _imageCoverage && _imageCoverage.valid
+        z:              QGroundControl.zOrderTrajectoryLines
+        // Zoom level at which one image pixel is one cell, with 256 pixel tiles
+        zoomLevel:      visible ? Math.log(156543.03392 * Math.cos(coordinate.latitude * Math.PI / 180) / _imageCoverage.cellSize) / Math.LN2 : 0
+
+        property var _imageCoverage: _activeVehicle ? _activeVehicle.imageCoverage : null
+
+        sourceItem: Image {
+            source:     imageCoverageItem.visible ? "image://QGCImages/coverage/" + _activeVehicle.id + "/" + imageCoverageItem._imageCoverage.imageIndex : ""
+            cache:      false
+            smooth:     false
+        }
+    }
+
     // Camera trigger points
     MapItemView {
         model: _activeVehicle ? _activeVehicle.cameraTriggerPoints : 0
@@ -28,6 +28,8 @@ Item {
     property var    _activeVehicle:     QGroundControl.multiVehicleManager.activeVehicle
     property var    _dynamicCameras:    _activeVehicle ? _activeVehicle.dynamicCameras : null
     property bool   _connected:         _activeVehicle ? !_activeVehicle.connectionLost : false
+    property bool   _showLatency:       QGroundControl.settingsManager.videoSettings.showLatencyOverlay.rawValue
+    property var    _latency:           _videoReceiver ? _videoReceiver.latency : null
     Rectangle {
         id:             noVideo
         anchors.fill:   parent
@@ -104,5 +106,45 @@ Item {
                 QGroundControl.videoManager.fullScreen = !QGroundControl.videoManager.fullScreen
             }
         }
+        //-- Per stage latency and frame timing, see VideoLatencyProbe
+        Rectangle {
+            anchors.margins:    ScreenTools.defaultFontPixelWidth
+            anchors.top:        parent.top
+            anchors.left:       parent.left
+            width:              latencyColumn.width  + ScreenTools.defaultFontPixelWidth
+            height:             latencyColumn.height + ScreenTools.defaultFontPixelWidth
+            color:              Qt.rgba(0,0,0,0.5)
+            radius:             ScreenTools.defaultFontPixelWidth / 2
+            visible:            _showLatency && _latency
+            Column {
+                id:                 latencyColumn
+                anchors.centerIn:   parent
+                QGCLabel {
+                    color:          "white"
+                    font.pointSize: ScreenTools.smallFontPointSize
+                    text:           _latency ? qsTr("%1 fps").arg(_latency.frameRate.valueString) : ""
+                }
+                QGCLabel {
+                    color:          "white"
+                    font.pointSize: ScreenTools.smallFontPointSize
+                    text:           _latency ? qsTr("Receive %1 Decode %2 Render %3 ms").arg(_latency.receiveLatency.valueString).arg(_latency.decodeLatency.valueString).arg(_latency.renderLatency.valueString) : ""
+                }
+                QGCLabel {
+                    color:          "white"
+                    font.pointSize: ScreenTools.smallFontPointSize
+                    text:           _latency ? qsTr("Total %1 ms (max %2)").arg(_latency.totalLatency.valueString).arg(_latency.maxTotalLatency.valueString) : ""
+                }
+                QGCLabel {
+                    color:          "white"
+                    font.pointSize: ScreenTools.smallFontPointSize
+                    text:           _latency ? qsTr("Jitter %1 ms (max %2)").arg(_latency.frameJitter.valueString).arg(_latency.maxFrameJitter.valueString) : ""
+                }
+                QGCLabel {
+                    color:          "white"
+                    font.pointSize: ScreenTools.smallFontPointSize
+                    text:           _latency ? qsTr("Dropped %1 Lost %2").arg(_latency.droppedFrames.valueString).arg(_latency.lostPackets.valueString) : ""
+                }
+            }
+        }
     }
 }
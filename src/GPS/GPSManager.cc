@@ -24,6 +24,73 @@ GPSManager::GPSManager(QGCApplication* app, QGCToolbox* toolbox)
 GPSManager::~GPSManager()
 {
     disconnectGPS();
+    delete _ntripSource;
+    delete _rtcmMavlink;
+}
+
+void GPSManager::setToolbox(QGCToolbox* toolbox)
+{
+    QGCTool::setToolbox(toolbox);
+
+    _rtcmMavlink = new RTCMMavlink(*_toolbox);
+
+    _ntripSource = new NTRIPSource();
+    connect(_ntripSource, &NTRIPSource::RTCMDataUpdate, _rtcmMavlink, &RTCMMavlink::RTCMDataUpdate);
+    connect(_ntripSource, &NTRIPSource::error,          this,         &GPSManager::_ntripError);
+    connect(_ntripSource, &NTRIPSource::restored,       this,         &GPSManager::_ntripRestored);
+
+    // Only the caster connection settings need a reconnect, the others apply to the running connection
+    RTKSettings* rtkSettings = _toolbox->settingsManager()->rtkSettings();
+    Fact* rgNtripConnectionFacts[] = {
+        rtkSettings->ntripServerConnectEnabled(),
+        rtkSettings->ntripServerHostAddress(),
+        rtkSettings->ntripServerPort(),
+        rtkSettings->ntripMountpoint(),
+        rtkSettings->ntripUsername(),
+        rtkSettings->ntripPassword(),
+    };
+    for (size_t i=0; i<sizeof(rgNtripConnectionFacts)/sizeof(rgNtripConnectionFacts[0]); i++) {
+        connect(rgNtripConnectionFacts[i], &Fact::rawValueChanged, this, &GPSManager::_ntripConnectionSettingsChanged);
+    }
+    connect(rtkSettings->ntripWhitelist(),      &Fact::rawValueChanged, this, &GPSManager::_ntripFilterSettingsChanged);
+    connect(rtkSettings->ntripBandwidthLimit(), &Fact::rawValueChanged, this, &GPSManager::_ntripFilterSettingsChanged);
+
+    _ntripFilterSettingsChanged();
+    _ntripConnectionSettingsChanged();
+}
+
+void GPSManager::_ntripFilterSettingsChanged(void)
+{
+    RTKSettings* rtkSettings = _toolbox->settingsManager()->rtkSettings();
+
+    _ntripSource->setWhitelist(NTRIPSource::parseWhitelist(rtkSettings->ntripWhitelist()->rawValue().toString()));
+    _ntripSource->setBandwidthLimit(rtkSettings->ntripBandwidthLimit()->rawValue().toInt());
+}
+
+void GPSManager::_ntripConnectionSettingsChanged(void)
+{
+    RTKSettings* rtkSettings = _toolbox->settingsManager()->rtkSettings();
+
+    QString hostAddress = rtkSettings->ntripServerHostAddress()->rawValue().toString();
+    if (rtkSettings->ntripServerConnectEnabled()->rawValue().toBool() && !hostAddress.isEmpty()) {
+        _ntripSource->start(hostAddress,
+                            rtkSettings->ntripServerPort()->rawValue().toUInt(),
+                            rtkSettings->ntripMountpoint()->rawValue().toString(),
+                            rtkSettings->ntripUsername()->rawValue().toString(),
+                            rtkSettings->ntripPassword()->rawValue().toString());
+    } else {
+        _ntripSource->stop();
+    }
+}
+
+void GPSManager::_ntripError(QString errorMsg)
+{
+    qgcApp()->showMessage(errorMsg);
+}
+
+void GPSManager::_ntripRestored(void)
+{
+    qgcApp()->showMessage(tr("RTCM connection restored"));
 }
 
 void GPSManager::connectGPS(const QString& device)
@@ -35,9 +102,6 @@ void GPSManager::connectGPS(const QString& device)
     _gpsProvider = new GPSProvider(device, true, rtkSettings->surveyInAccuracyLimit()->rawValue().toDouble(), rtkSettings->surveyInMinObservationDuration()->rawValue().toInt(), _requestGpsStop);
     _gpsProvider->start();
 
-    //create RTCM device
-    _rtcmMavlink = new RTCMMavlink(*_toolbox);
-
     connect(_gpsProvider, &GPSProvider::RTCMDataUpdate, _rtcmMavlink, &RTCMMavlink::RTCMDataUpdate);
 
     //test: connect to position update
@@ -59,11 +123,7 @@ void GPSManager::disconnectGPS(void)
         }
         delete(_gpsProvider);
     }
-    if (_rtcmMavlink) {
-        delete(_rtcmMavlink);
-    }
     _gpsProvider = NULL;
-    _rtcmMavlink = NULL;
 }
 
 
@@ -12,6 +12,7 @@
 
 #include "GPSProvider.h"
 #include "RTCM/RTCMMavlink.h"
+#include "RTCM/NTRIPSource.h"
 #include <QGCToolbox.h>
 
 #include <QString>
@@ -28,6 +29,9 @@ public:
     GPSManager(QGCApplication* app, QGCToolbox* toolbox);
     ~GPSManager();
 
+    // Overrides from QGCTool
+    void setToolbox(QGCToolbox* toolbox) final;
+
     void connectGPS     (const QString& device);
     void disconnectGPS  (void);
     bool connected      (void) const { return _gpsProvider && _gpsProvider->isRunning(); }
@@ -41,10 +45,15 @@ signals:
 private slots:
     void GPSPositionUpdate(GPSPositionMessage msg);
     void GPSSatelliteUpdate(GPSSatelliteMessage msg);
+    void _ntripConnectionSettingsChanged(void);
+    void _ntripFilterSettingsChanged(void);
+    void _ntripError(QString errorMsg);
+    void _ntripRestored(void);
 
 private:
     GPSProvider* _gpsProvider = nullptr;
-    RTCMMavlink* _rtcmMavlink = nullptr;
+    RTCMMavlink* _rtcmMavlink = nullptr;       ///< Sends the corrections of the serial base station and the network source to the vehicles
+    NTRIPSource* _ntripSource = nullptr;
 
     std::atomic_bool _requestGpsStop; ///< signals the thread to quit
 };
@@ -0,0 +1,419 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+
+#include "NTRIPSource.h"
+#include "QGCLoggingCategory.h"
+
+#include <QRegularExpression>
+
+// Values of _chunkRemaining while not in the data of a chunk
+static const int _chunkSizeLine =   -1;
+static const int _chunkTrailer =    -2;     ///< CRLF after the chunk data
+static const int _chunkEnd =        -3;     ///< Last (empty) chunk received
+
+NTRIPSource::NTRIPSource(QObject* parent)
+    : QObject(parent)
+    , _socket(NULL)
+    , _state(StateIdle)
+    , _errorReported(false)
+    , _port(0)
+    , _chunked(false)
+    , _chunkRemaining(_chunkSizeLine)
+    , _bandwidthLimit(0)
+    , _tokens(0)
+    , _largestFrame(0)
+    , _framesReceived(0)
+    , _framesForwarded(0)
+    , _framesFiltered(0)
+    , _framesDropped(0)
+{
+    _reconnectTimer.setSingleShot(true);
+    _reconnectTimer.setInterval(reconnectMSecs);
+    connect(&_reconnectTimer, &QTimer::timeout, this, &NTRIPSource::_connect);
+
+    _pendingTimer.setInterval(pendingFlushMSecs);
+    connect(&_pendingTimer, &QTimer::timeout, this, &NTRIPSource::_flushPending);
+}
+
+NTRIPSource::~NTRIPSource()
+{
+    _stop(false /* reconnect */);
+}
+
+void NTRIPSource::start(const QString& hostAddress, quint16 port, const QString& mountpoint, const QString& username, const QString& password)
+{
+    _stop(false /* reconnect */);
+
+    _hostAddress =  hostAddress;
+    _port =         port;
+    _mountpoint =   mountpoint;
+    _username =     username;
+    _password =     password;
+    _errorReported = false;
+
+    _connect();
+}
+
+void NTRIPSource::stop(void)
+{
+    _stop(false /* reconnect */);
+}
+
+void NTRIPSource::_stop(bool reconnect)
+{
+    if (_socket) {
+        _socket->disconnect(this);
+        _socket->abort();
+        _socket->deleteLater();
+        _socket = NULL;
+    }
+
+    _response.clear();
+    _chunkBuffer.clear();
+    _chunkRemaining = _chunkSizeLine;
+    _parser.reset();
+    _pending.clear();
+    _pendingTimer.stop();
+    _setState(StateIdle);
+
+    if (reconnect) {
+        _reconnectTimer.start();
+    } else {
+        _reconnectTimer.stop();
+    }
+}
+
+void NTRIPSource::_setState(State_t state)
+{
+    bool wasConnected = connected();
+
+    _state = state;
+    if (wasConnected != connected()) {
+        emit connectedChanged(connected());
+        if (connected() && _errorReported) {
+            _errorReported = false;
+            emit restored();
+        }
+    }
+}
+
+void NTRIPSource::_reportError(const QString& errorMsg)
+{
+    if (!_errorReported) {
+        _errorReported = true;
+        emit error(errorMsg);
+    } else {
+        qCDebug(RTKGPSLog) << errorMsg;
+    }
+}
+
+void NTRIPSource::setBandwidthLimit(int bytesPerSecond)
+{
+    _bandwidthLimit =   qMax(0, bytesPerSecond);
+    _tokens =           _bandwidthLimit;
+    _tokenTimer.start();
+    _sendPending();
+}
+
+void NTRIPSource::_connect(void)
+{
+    qCDebug(RTKGPSLog) << "NTRIP connecting to" << _hostAddress << _port << _mountpoint;
+
+    _socket = new QTcpSocket(this);
+    connect(_socket, &QTcpSocket::connected,    this, &NTRIPSource::_connected);
+    connect(_socket, &QTcpSocket::disconnected, this, &NTRIPSource::_disconnected);
+    connect(_socket, &QTcpSocket::readyRead,    this, &NTRIPSource::_readBytes);
+    connect(_socket, static_cast<void (QTcpSocket::*)(QAbstractSocket::SocketError)>(&QTcpSocket::error), this, &NTRIPSource::_socketError);
+
+    _setState(StateConnecting);
+    _socket->connectToHost(_hostAddress, _port);
+}
+
+void NTRIPSource::_connected(void)
+{
+    if (_mountpoint.isEmpty()) {
+        // Plain RTCM relay, data follows right away
+        _setState(StateData);
+        return;
+    }
+
+    // NTRIP v2 request. v1 casters ignore the additional headers and answer with ICY 200 OK.
+    QByteArray request;
+    request += QString("GET /%1 HTTP/1.1\r\n").arg(_mountpoint).toUtf8();
+    request += QString("Host: %1\r\n").arg(_hostAddress).toUtf8();
+    request += "Ntrip-Version: Ntrip/2.0\r\n";
+    request += "User-Agent: NTRIP QGroundControl\r\n";
+    if (!_username.isEmpty()) {
+        request += "Authorization: Basic " + QString("%1:%2").arg(_username).arg(_password).toUtf8().toBase64() + "\r\n";
+    }
+    request += "Connection: close\r\n\r\n";
+
+    _setState(StateResponse);
+    _socket->write(request);
+}
+
+void NTRIPSource::_disconnected(void)
+{
+    qCDebug(RTKGPSLog) << "NTRIP disconnected";
+    _stop(true /* reconnect */);
+}
+
+void NTRIPSource::_socketError(QAbstractSocket::SocketError socketError)
+{
+    Q_UNUSED(socketError);
+
+    _reportError(tr("RTCM connection to %1:%2 failed: %3").arg(_hostAddress).arg(_port).arg(_socket->errorString()));
+    _stop(true /* reconnect */);
+}
+
+void NTRIPSource::_readBytes(void)
+{
+    QByteArray data = _socket->readAll();
+
+    if (_state == StateResponse) {
+        _response.append(data);
+        if (!_parseResponse()) {
+            return;
+        }
+        data = _response;
+        _response.clear();
+    }
+
+    if (_state == StateData) {
+        _addData(data);
+    }
+}
+
+/// Parses the caster response from _response, the data which follows the response is left in _response
+/// @return true: response complete
+bool NTRIPSource::_parseResponse(void)
+{
+    int lineEnd = _response.indexOf("\r\n");
+    if (lineEnd < 0) {
+        if (_response.size() > maxHeaderLength) {
+            _reportError(tr("NTRIP caster %1 sent an invalid response").arg(_hostAddress));
+            _stop(true /* reconnect */);
+        }
+        return false;
+    }
+
+    QByteArray statusLine = _response.left(lineEnd);
+
+    if (statusLine.startsWith("ICY 200")) {
+        // NTRIP v1
+        _chunked = false;
+        _response.remove(0, lineEnd + 2);
+    } else if (statusLine.startsWith("HTTP/") && statusLine.split(' ').value(1) == "200") {
+        // NTRIP v2
+        int headerEnd = _response.indexOf("\r\n\r\n");
+        if (headerEnd < 0) {
+            if (_response.size() > maxHeaderLength) {
+                _reportError(tr("NTRIP caster %1 sent an invalid response").arg(_hostAddress));
+                _stop(true /* reconnect */);
+            }
+            return false;
+        }
+
+        QByteArray headers = _response.mid(lineEnd + 2, headerEnd - lineEnd).toLower();
+        if (headers.contains("gnss/sourcetable")) {
+            _reportError(tr("NTRIP mountpoint %1 not found on %2").arg(_mountpoint).arg(_hostAddress));
+            _stop(true /* reconnect */);
+            return false;
+        }
+        _chunked = headers.contains("transfer-encoding: chunked");
+        _response.remove(0, headerEnd + 4);
+    } else {
+        if (statusLine.startsWith("SOURCETABLE")) {
+            _reportError(tr("NTRIP mountpoint %1 not found on %2").arg(_mountpoint).arg(_hostAddress));
+        } else {
+            _reportError(tr("NTRIP caster %1 refused the connection: %2").arg(_hostAddress).arg(QString(statusLine)));
+        }
+        _stop(true /* reconnect */);
+        return false;
+    }
+
+    qCDebug(RTKGPSLog) << "NTRIP connected" << statusLine << "chunked" << _chunked;
+    _setState(StateData);
+    return true;
+}
+
+void NTRIPSource::_addData(const QByteArray& data)
+{
+    if (_chunked) {
+        _chunkBuffer.append(data);
+        _dechunk();
+        return;
+    }
+
+    QList<QByteArray> frames;
+    _parser.addData(data, frames);
+    foreach (const QByteArray& frame, frames) {
+        _frame(frame);
+    }
+}
+
+/// Passes the data of the chunks in _chunkBuffer to the parser
+void NTRIPSource::_dechunk(void)
+{
+    QList<QByteArray> frames;
+
+    while (true) {
+        if (_chunkRemaining == _chunkSizeLine) {
+            int lineEnd = _chunkBuffer.indexOf("\r\n");
+            if (lineEnd < 0) {
+                break;
+            }
+
+            bool ok;
+            int chunkSize = _chunkBuffer.left(lineEnd).split(';')[0].trimmed().toInt(&ok, 16);
+            _chunkBuffer.remove(0, lineEnd + 2);
+            if (!ok || chunkSize < 0) {
+                _reportError(tr("NTRIP caster %1 sent invalid chunked data").arg(_hostAddress));
+                _stop(true /* reconnect */);
+                return;
+            }
+            _chunkRemaining = chunkSize == 0 ? _chunkEnd : chunkSize;
+        } else if (_chunkRemaining == _chunkTrailer) {
+            if (_chunkBuffer.size() < 2) {
+                break;
+            }
+            _chunkBuffer.remove(0, 2);
+            _chunkRemaining = _chunkSizeLine;
+        } else if (_chunkRemaining > 0 && !_chunkBuffer.isEmpty()) {
+            int count = qMin(_chunkRemaining, _chunkBuffer.size());
+            _parser.addData(_chunkBuffer.left(count), frames);
+            _chunkBuffer.remove(0, count);
+            _chunkRemaining -= count;
+            if (_chunkRemaining == 0) {
+                _chunkRemaining = _chunkTrailer;
+            }
+        } else {
+            break;
+        }
+    }
+
+    foreach (const QByteArray& frame, frames) {
+        _frame(frame);
+    }
+}
+
+void NTRIPSource::_frame(const QByteArray& frame)
+{
+    int messageType = RTCM3Parser::messageType(frame);
+
+    _framesReceived++;
+    if (!_whitelist.isEmpty() && !_whitelist.contains(messageType)) {
+        _framesFiltered++;
+        return;
+    }
+
+    if (_bandwidthLimit == 0) {
+        _framesForwarded++;
+        emit RTCMDataUpdate(frame);
+        return;
+    }
+
+    _largestFrame = qMax(_largestFrame, frame.size());
+    _refillTokens();
+    if (isObservationMessage(messageType)) {
+        // An observation which does not fit is dropped, the next epoch replaces it anyway
+        if (!_send(frame, 0)) {
+            _framesDropped++;
+        }
+    } else {
+        if (_pending.contains(messageType)) {
+            _framesDropped++;
+        }
+        _pending[messageType] = frame;
+    }
+    _sendPending();
+}
+
+void NTRIPSource::_refillTokens(void)
+{
+    // A bucket of only the limit would never fit a held back frame larger than the space above the reserve
+    double bucketSize = qMax((double)_bandwidthLimit, _largestFrame + _reserve());
+
+    _tokens = qMin(bucketSize, _tokens + ((_tokenTimer.restart() * _bandwidthLimit) / 1000.0));
+}
+
+/// Sends the frame if the bandwidth allows it
+///     @param reserve Bytes which must be left after sending
+bool NTRIPSource::_send(const QByteArray& frame, double reserve)
+{
+    if (_bandwidthLimit != 0) {
+        if (_tokens - frame.size() < reserve) {
+            return false;
+        }
+        _tokens -= frame.size();
+    }
+
+    _framesForwarded++;
+    emit RTCMDataUpdate(frame);
+    return true;
+}
+
+void NTRIPSource::_sendPending(void)
+{
+    double reserve = _reserve();
+
+    QMap<int, QByteArray>::iterator it = _pending.begin();
+    while (it != _pending.end()) {
+        if (_send(it.value(), reserve)) {
+            it = _pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Without new frames coming in the held back messages still go out once the bandwidth has refilled
+    if (_pending.isEmpty()) {
+        _pendingTimer.stop();
+    } else if (!_pendingTimer.isActive()) {
+        _pendingTimer.start();
+    }
+}
+
+void NTRIPSource::_flushPending(void)
+{
+    _refillTokens();
+    _sendPending();
+}
+
+bool NTRIPSource::isObservationMessage(int messageType)
+{
+    // Legacy GPS and GLONASS observables
+    if ((messageType >= 1001 && messageType <= 1004) || (messageType >= 1009 && messageType <= 1012)) {
+        return true;
+    }
+
+    // MSM1-7 for GPS, GLONASS, Galileo, SBAS, QZSS, BeiDou and NavIC (1071-1077 ... 1131-1137)
+    if (messageType >= 1071 && messageType <= 1137) {
+        int msm = messageType % 10;
+        return msm >= 1 && msm <= 7;
+    }
+
+    return false;
+}
+
+QSet<int> NTRIPSource::parseWhitelist(const QString& whitelist)
+{
+    QSet<int> messageTypes;
+
+    foreach (const QString& item, whitelist.split(QRegularExpression("[,\\s]+"), QString::SkipEmptyParts)) {
+        bool ok;
+        int messageType = item.toInt(&ok);
+        if (ok) {
+            messageTypes.insert(messageType);
+        }
+    }
+
+    return messageTypes;
+}
@@ -0,0 +1,132 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "RTCM3Parser.h"
+
+#include <QObject>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QSet>
+#include <QMap>
+
+/**
+ ** class NTRIPSource
+ * Receives RTCM3 corrections over TCP, either from an NTRIP caster (v1 or v2 framing, including chunked transfer) or,
+ * without a mountpoint, from a plain RTCM TCP relay. Frames are checked, filtered by message type and shaped to the
+ * bandwidth limit before being emitted through RTCMDataUpdate, the same signal GPSProvider uses for a serial base station.
+ *
+ * Under bandwidth pressure observation messages (MSM and legacy observables) are preferred. Other messages (station
+ * position, antenna, ephemerides) only use the bandwidth which is not reserved for observations; until then only the
+ * latest copy of each message type is held back, older copies are replaced. The bucket holds at least one second of
+ * bandwidth, and more if a frame plus the reserve is larger, so every frame gets through eventually.
+ *
+ * While the caster is unreachable only the first failure is reported through error, restored follows once data flows again.
+ */
+class NTRIPSource : public QObject
+{
+    Q_OBJECT
+
+public:
+    NTRIPSource(QObject* parent = NULL);
+    ~NTRIPSource();
+
+    /// Connects to the caster, reconnects until stop is called
+    ///     @param mountpoint Empty for a plain RTCM TCP relay
+    void start(const QString& hostAddress, quint16 port, const QString& mountpoint, const QString& username, const QString& password);
+    void stop(void);
+
+    /// @param messageTypes Message types to forward, empty for all
+    void setWhitelist(const QSet<int>& messageTypes) { _whitelist = messageTypes; }
+
+    /// @param bytesPerSecond Bandwidth available for corrections, 0 for unlimited
+    void setBandwidthLimit(int bytesPerSecond);
+
+    bool connected(void) const { return _state == StateData; }
+
+    int framesReceived  (void) const { return _framesReceived; }
+    int framesForwarded (void) const { return _framesForwarded; }
+    int framesFiltered  (void) const { return _framesFiltered; }
+    int framesDropped   (void) const { return _framesDropped; }     ///< Dropped or replaced due to the bandwidth limit
+    int crcErrors       (void) const { return _parser.crcErrors(); }
+
+    /// @return true: message type carries observations, which are preferred under bandwidth pressure
+    static bool isObservationMessage(int messageType);
+
+    /// Parses a comma separated list of message types
+    static QSet<int> parseWhitelist(const QString& whitelist);
+
+    static const int reconnectMSecs =       5000;
+    static const int maxHeaderLength =      4096;
+    static const int reservedPercent =      50;     ///< Percent of the bandwidth kept for observation messages
+    static const int pendingFlushMSecs =    100;    ///< Retry interval for held back messages while the stream pauses
+
+signals:
+    void RTCMDataUpdate     (QByteArray message);
+    void connectedChanged   (bool connected);
+    void error              (QString errorMsg);
+    void restored           (void);                 ///< Connection is back after a reported error
+
+private slots:
+    void _connected     (void);
+    void _disconnected  (void);
+    void _readBytes     (void);
+    void _socketError   (QAbstractSocket::SocketError socketError);
+    void _connect       (void);
+    void _flushPending  (void);
+
+private:
+    typedef enum {
+        StateIdle,
+        StateConnecting,
+        StateResponse,      ///< Waiting for the caster response
+        StateData,
+    } State_t;
+
+    void _setState          (State_t state);
+    bool _parseResponse     (void);
+    void _addData           (const QByteArray& data);
+    void _dechunk           (void);
+    void _frame             (const QByteArray& frame);
+    void _refillTokens      (void);
+    double _reserve         (void) const { return (_bandwidthLimit * reservedPercent) / 100.0; }
+    bool _send              (const QByteArray& frame, double reserve);
+    void _sendPending       (void);
+    void _stop              (bool reconnect);
+    void _reportError       (const QString& errorMsg);
+
+    QTcpSocket*         _socket;
+    QTimer              _reconnectTimer;
+    QTimer              _pendingTimer;
+    State_t             _state;
+    bool                _errorReported;         ///< Further errors are not reported until the connection is back
+    QString             _hostAddress;
+    quint16             _port;
+    QString             _mountpoint;
+    QString             _username;
+    QString             _password;
+    QByteArray          _response;
+    bool                _chunked;
+    QByteArray          _chunkBuffer;
+    int                 _chunkRemaining;        ///< Bytes left in the current chunk, -1 while reading the chunk size
+    RTCM3Parser         _parser;
+    QSet<int>           _whitelist;
+    int                 _bandwidthLimit;
+    double              _tokens;                ///< Bytes which can be sent right now
+    int                 _largestFrame;          ///< Largest frame seen so far, sizes the bucket
+    QElapsedTimer       _tokenTimer;
+    QMap<int, QByteArray> _pending;             ///< Latest held back frame by message type
+    int                 _framesReceived;
+    int                 _framesForwarded;
+    int                 _framesFiltered;
+    int                 _framesDropped;
+};
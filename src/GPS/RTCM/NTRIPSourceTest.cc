@@ -0,0 +1,325 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+
+#include "NTRIPSourceTest.h"
+
+#include <QSignalSpy>
+
+NTRIPSourceTest::NTRIPSourceTest(void)
+    : _caster(NULL)
+    , _casterSocket(NULL)
+    , _connectionCount(0)
+    , _waitForRequest(false)
+{
+
+}
+
+void NTRIPSourceTest::cleanup(void)
+{
+    delete _caster;
+    _caster = NULL;
+    _casterSocket = NULL;
+    _connectionCount = 0;
+    _request.clear();
+    _reply.clear();
+
+    UnitTest::cleanup();
+}
+
+/// @return RTCM3 frame with the specified message type, the rest of the payload is filler
+QByteArray NTRIPSourceTest::_frame(int messageType, int payloadLength)
+{
+    QByteArray frame;
+
+    frame.append((char)RTCM3Parser::preamble);
+    frame.append((char)((payloadLength >> 8) & 0x03));
+    frame.append((char)(payloadLength & 0xFF));
+    frame.append((char)((messageType >> 4) & 0xFF));
+    frame.append((char)((messageType & 0x0F) << 4));
+    for (int i=2; i<payloadLength; i++) {
+        frame.append((char)(i & 0xFF));
+    }
+
+    quint32 crc = RTCM3Parser::crc24q((const uchar*)frame.constData(), frame.size());
+    frame.append((char)((crc >> 16) & 0xFF));
+    frame.append((char)((crc >> 8) & 0xFF));
+    frame.append((char)(crc & 0xFF));
+
+    return frame;
+}
+
+void NTRIPSourceTest::_startCaster(bool waitForRequest, const QByteArray& reply)
+{
+    _waitForRequest =   waitForRequest;
+    _reply =            reply;
+
+    _caster = new QTcpServer(this);
+    connect(_caster, &QTcpServer::newConnection, this, &NTRIPSourceTest::_newConnection);
+    QVERIFY(_caster->listen(QHostAddress::LocalHost));
+}
+
+void NTRIPSourceTest::_newConnection(void)
+{
+    _casterSocket = _caster->nextPendingConnection();
+    _connectionCount++;
+    _request.clear();
+    connect(_casterSocket, &QTcpSocket::readyRead, this, &NTRIPSourceTest::_casterReadyRead);
+    if (!_waitForRequest) {
+        _casterSocket->write(_reply);
+    }
+}
+
+void NTRIPSourceTest::_casterReadyRead(void)
+{
+    bool requestComplete = _request.contains("\r\n\r\n");
+
+    _request.append(_casterSocket->readAll());
+    if (_waitForRequest && !requestComplete && _request.contains("\r\n\r\n")) {
+        _casterSocket->write(_reply);
+    }
+}
+
+void NTRIPSourceTest::_parserTest(void)
+{
+    RTCM3Parser         parser;
+    QList<QByteArray>   frames;
+    QByteArray          frame1005 = _frame(1005, 19);
+    QByteArray          frame1077 = _frame(1077, 200);
+
+    // Frames surrounded by garbage, added one byte at a time
+    QByteArray data = QByteArray("garbage") + frame1005 + QByteArray(1, (char)RTCM3Parser::preamble) + frame1077;
+    for (int i=0; i<data.size(); i++) {
+        parser.addData(data.mid(i, 1), frames);
+    }
+    QCOMPARE(frames.count(), 2);
+    QCOMPARE(frames[0], frame1005);
+    QCOMPARE(frames[1], frame1077);
+    QCOMPARE(RTCM3Parser::messageType(frames[0]), 1005);
+    QCOMPARE(RTCM3Parser::messageType(frames[1]), 1077);
+
+    // A frame with a bad CRC is skipped, the following frame is still found
+    frames.clear();
+    QByteArray badFrame = frame1005;
+    badFrame[10] = badFrame[10] ^ 0x01;
+    parser.addData(badFrame + frame1077, frames);
+    QCOMPARE(frames.count(), 1);
+    QCOMPARE(frames[0], frame1077);
+    QCOMPARE(parser.crcErrors(), 1);
+
+    // Known check value of CRC-24Q
+    QCOMPARE(RTCM3Parser::crc24q((const uchar*)"123456789", 9), (quint32)0xCDE703);
+}
+
+void NTRIPSourceTest::_isObservationMessageTest(void)
+{
+    QVERIFY(NTRIPSource::isObservationMessage(1004));
+    QVERIFY(NTRIPSource::isObservationMessage(1012));
+    QVERIFY(NTRIPSource::isObservationMessage(1074));
+    QVERIFY(NTRIPSource::isObservationMessage(1077));
+    QVERIFY(NTRIPSource::isObservationMessage(1087));
+    QVERIFY(NTRIPSource::isObservationMessage(1127));
+    QVERIFY(!NTRIPSource::isObservationMessage(1005));
+    QVERIFY(!NTRIPSource::isObservationMessage(1019));
+    QVERIFY(!NTRIPSource::isObservationMessage(1033));
+    QVERIFY(!NTRIPSource::isObservationMessage(1230));
+}
+
+void NTRIPSourceTest::_parseWhitelistTest(void)
+{
+    QCOMPARE(NTRIPSource::parseWhitelist(QString()), QSet<int>());
+    QCOMPARE(NTRIPSource::parseWhitelist("1005, 1077,1087 1230,bogus"), QSet<int>() << 1005 << 1077 << 1087 << 1230);
+}
+
+void NTRIPSourceTest::_rawRelayTest(void)
+{
+    NTRIPSource source;
+    QSignalSpy  spyData(&source, &NTRIPSource::RTCMDataUpdate);
+    QByteArray  frame1005 = _frame(1005, 19);
+    QByteArray  frame1077 = _frame(1077, 200);
+
+    _startCaster(false, frame1005 + frame1077);
+    source.start("127.0.0.1", _caster->serverPort(), QString(), QString(), QString());
+
+    QTRY_COMPARE(spyData.count(), 2);
+    QVERIFY(source.connected());
+    QVERIFY(_request.isEmpty());
+    QCOMPARE(spyData[0][0].toByteArray(), frame1005);
+    QCOMPARE(spyData[1][0].toByteArray(), frame1077);
+    QCOMPARE(source.framesReceived(), 2);
+    QCOMPARE(source.framesForwarded(), 2);
+
+    source.stop();
+    QVERIFY(!source.connected());
+}
+
+void NTRIPSourceTest::_ntripV1Test(void)
+{
+    NTRIPSource source;
+    QSignalSpy  spyData(&source, &NTRIPSource::RTCMDataUpdate);
+    QSignalSpy  spyConnected(&source, &NTRIPSource::connectedChanged);
+    QByteArray  frame1077 = _frame(1077, 200);
+
+    _startCaster(true, QByteArray("ICY 200 OK\r\n") + frame1077);
+    source.start("127.0.0.1", _caster->serverPort(), "MOUNT", "user", "pass");
+
+    QTRY_COMPARE(spyData.count(), 1);
+    QCOMPARE(spyData[0][0].toByteArray(), frame1077);
+    QCOMPARE(spyConnected.count(), 1);
+    QVERIFY(_request.startsWith("GET /MOUNT HTTP/1.1\r\n"));
+    QVERIFY(_request.contains("Authorization: Basic " + QByteArray("user:pass").toBase64() + "\r\n"));
+}
+
+void NTRIPSourceTest::_ntripV2ChunkedTest(void)
+{
+    NTRIPSource source;
+    QSignalSpy  spyData(&source, &NTRIPSource::RTCMDataUpdate);
+    QByteArray  frame1005 = _frame(1005, 19);
+    QByteArray  frame1077 = _frame(1077, 200);
+
+    // Chunk boundaries do not line up with the frames
+    QByteArray data = frame1005 + frame1077;
+    QByteArray chunk1 = data.left(30);
+    QByteArray chunk2 = data.mid(30);
+    QByteArray reply = "HTTP/1.1 200 OK\r\n"
+                       "Ntrip-Version: Ntrip/2.0\r\n"
+                       "Content-Type: gnss/data\r\n"
+                       "Transfer-Encoding: chunked\r\n\r\n";
+    reply += QByteArray::number(chunk1.size(), 16) + "\r\n" + chunk1 + "\r\n";
+    reply += QByteArray::number(chunk2.size(), 16) + ";ext=1\r\n" + chunk2 + "\r\n";
+
+    _startCaster(true, reply);
+    source.start("127.0.0.1", _caster->serverPort(), "MOUNT", QString(), QString());
+
+    QTRY_COMPARE(spyData.count(), 2);
+    QCOMPARE(spyData[0][0].toByteArray(), frame1005);
+    QCOMPARE(spyData[1][0].toByteArray(), frame1077);
+    QCOMPARE(source.crcErrors(), 0);
+    QVERIFY(!_request.contains("Authorization"));
+}
+
+void NTRIPSourceTest::_sourcetableTest(void)
+{
+    NTRIPSource source;
+    QSignalSpy  spyError(&source, &NTRIPSource::error);
+
+    _startCaster(true, "SOURCETABLE 200 OK\r\nSTR;OTHER;\r\nENDSOURCETABLE\r\n");
+    source.start("127.0.0.1", _caster->serverPort(), "MOUNT", QString(), QString());
+
+    QTRY_COMPARE(spyError.count(), 1);
+    QVERIFY(!source.connected());
+    source.stop();
+}
+
+void NTRIPSourceTest::_whitelistTest(void)
+{
+    NTRIPSource source;
+    QSignalSpy  spyData(&source, &NTRIPSource::RTCMDataUpdate);
+
+    source.setWhitelist(QSet<int>() << 1005 << 1087);
+    _startCaster(false, _frame(1005, 19) + _frame(1077, 200) + _frame(1087, 150) + _frame(1230, 8));
+    source.start("127.0.0.1", _caster->serverPort(), QString(), QString(), QString());
+
+    QTRY_COMPARE(source.framesReceived(), 4);
+    QCOMPARE(spyData.count(), 2);
+    QCOMPARE(RTCM3Parser::messageType(spyData[0][0].toByteArray()), 1005);
+    QCOMPARE(RTCM3Parser::messageType(spyData[1][0].toByteArray()), 1087);
+    QCOMPARE(source.framesFiltered(), 2);
+}
+
+void NTRIPSourceTest::_bandwidthLimitTest(void)
+{
+    NTRIPSource source;
+    QSignalSpy  spyData(&source, &NTRIPSource::RTCMDataUpdate);
+
+    // 300 bytes available. The first observation leaves 200, which is not enough for the ephemeris on top of the reserved 150.
+    // The ephemeris is held back, the second copy replaces the first one. The second observation still fits.
+    source.setBandwidthLimit(300);
+    _startCaster(false, _frame(1077, 94) + _frame(1019, 56) + _frame(1019, 56) + _frame(1087, 94));
+    source.start("127.0.0.1", _caster->serverPort(), QString(), QString(), QString());
+
+    QTRY_COMPARE(source.framesReceived(), 4);
+    QCOMPARE(spyData.count(), 2);
+    QCOMPARE(RTCM3Parser::messageType(spyData[0][0].toByteArray()), 1077);
+    QCOMPARE(RTCM3Parser::messageType(spyData[1][0].toByteArray()), 1087);
+    QCOMPARE(source.framesForwarded(), 2);
+    QCOMPARE(source.framesDropped(), 1);
+
+    // An observation larger than the bandwidth left does not fit
+    _casterSocket->write(_frame(1077, 294));
+    QTRY_COMPARE(source.framesReceived(), 5);
+    QCOMPARE(spyData.count(), 2);
+    QCOMPARE(source.framesDropped(), 2);
+}
+
+void NTRIPSourceTest::_pendingFlushTest(void)
+{
+    NTRIPSource source;
+    QSignalSpy  spyData(&source, &NTRIPSource::RTCMDataUpdate);
+
+    // The observation leaves 100 of 300 bytes, the ephemeris has to wait for the reserve to refill.
+    // Nothing follows in the stream, the ephemeris still goes out.
+    source.setBandwidthLimit(300);
+    _startCaster(false, _frame(1077, 194) + _frame(1019, 56));
+    source.start("127.0.0.1", _caster->serverPort(), QString(), QString(), QString());
+
+    QTRY_COMPARE(source.framesReceived(), 2);
+    QCOMPARE(spyData.count(), 1);
+    QTRY_COMPARE(spyData.count(), 2);
+    QCOMPARE(RTCM3Parser::messageType(spyData[1][0].toByteArray()), 1019);
+    QCOMPARE(source.framesDropped(), 0);
+}
+
+void NTRIPSourceTest::_largeFrameTest(void)
+{
+    NTRIPSource source;
+    QSignalSpy  spyData(&source, &NTRIPSource::RTCMDataUpdate);
+
+    // The 80 byte ephemeris is larger than the 50 bytes above the reserve of a 100 byte/s limit. It still goes out once
+    // the bucket has grown to fit it on top of the reserve.
+    source.setBandwidthLimit(100);
+    _startCaster(false, _frame(1019, 74));
+    source.start("127.0.0.1", _caster->serverPort(), QString(), QString(), QString());
+
+    QTRY_COMPARE(source.framesReceived(), 1);
+    QTRY_COMPARE(spyData.count(), 1);
+    QCOMPARE(RTCM3Parser::messageType(spyData[0][0].toByteArray()), 1019);
+
+    // An observation larger than the limit is dropped while the bucket refills, the next one fits
+    _casterSocket->write(_frame(1077, 144));
+    QTRY_COMPARE(source.framesReceived(), 2);
+    QCOMPARE(source.framesDropped(), 1);
+    QTest::qWait(2000);
+    _casterSocket->write(_frame(1077, 144));
+    QTRY_COMPARE(spyData.count(), 2);
+    QCOMPARE(source.framesDropped(), 1);
+}
+
+void NTRIPSourceTest::_errorReportedOnceTest(void)
+{
+    NTRIPSource source;
+    QSignalSpy  spyError(&source, &NTRIPSource::error);
+    QSignalSpy  spyRestored(&source, &NTRIPSource::restored);
+    QByteArray  frame1077 = _frame(1077, 200);
+
+    // The mountpoint is missing on the first two attempts
+    _startCaster(true, "SOURCETABLE 200 OK\r\nSTR;OTHER;\r\nENDSOURCETABLE\r\n");
+    source.start("127.0.0.1", _caster->serverPort(), "MOUNT", QString(), QString());
+
+    QTRY_COMPARE(spyError.count(), 1);
+    QTRY_COMPARE_WITH_TIMEOUT(_connectionCount, 2, NTRIPSource::reconnectMSecs * 2);
+    _reply = QByteArray("ICY 200 OK\r\n") + frame1077;
+    QTest::qWait(500);
+    QCOMPARE(spyError.count(), 1);
+    QCOMPARE(spyRestored.count(), 0);
+
+    QTRY_COMPARE_WITH_TIMEOUT(spyRestored.count(), 1, NTRIPSource::reconnectMSecs * 2);
+    QVERIFY(source.connected());
+    QCOMPARE(spyError.count(), 1);
+}
@@ -0,0 +1,57 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "UnitTest.h"
+#include "NTRIPSource.h"
+
+#include <QTcpServer>
+#include <QTcpSocket>
+
+/// Runs NTRIPSource against a local caster which replays synthesized RTCM3 frames
+class NTRIPSourceTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    NTRIPSourceTest(void);
+
+private slots:
+    void cleanup(void);
+
+    void _parserTest(void);
+    void _isObservationMessageTest(void);
+    void _parseWhitelistTest(void);
+    void _rawRelayTest(void);
+    void _ntripV1Test(void);
+    void _ntripV2ChunkedTest(void);
+    void _sourcetableTest(void);
+    void _whitelistTest(void);
+    void _bandwidthLimitTest(void);
+    void _pendingFlushTest(void);
+    void _largeFrameTest(void);
+    void _errorReportedOnceTest(void);
+
+    void _newConnection(void);
+    void _casterReadyRead(void);
+
+private:
+    static QByteArray _frame(int messageType, int payloadLength);
+
+    void _startCaster(bool waitForRequest, const QByteArray& reply);
+
+    QTcpServer*     _caster;
+    QTcpSocket*     _casterSocket;
+    int             _connectionCount;
+    bool            _waitForRequest;    ///< true: reply is sent after the request, false: right after the connection (raw relay)
+    QByteArray      _request;
+    QByteArray      _reply;
+};
@@ -0,0 +1,100 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+
+#include "RTCM3Parser.h"
+
+RTCM3Parser::RTCM3Parser(void)
+    : _crcErrors(0)
+{
+
+}
+
+void RTCM3Parser::reset(void)
+{
+    _buffer.clear();
+    _crcErrors = 0;
+}
+
+void RTCM3Parser::addData(const QByteArray& data, QList<QByteArray>& frames)
+{
+    _buffer.append(data);
+
+    const uchar*    bytes = (const uchar*)_buffer.constData();
+    int             size =  _buffer.size();
+    int             start = 0;
+
+    while (start < size) {
+        if (bytes[start] != preamble) {
+            start++;
+            continue;
+        }
+        if (size - start < headerLength) {
+            break;
+        }
+
+        // Reserved bits must be zero, otherwise this is not the start of a frame
+        if (bytes[start + 1] & 0xFC) {
+            start++;
+            continue;
+        }
+
+        int frameLength = headerLength + (((bytes[start + 1] & 0x03) << 8) | bytes[start + 2]) + crcLength;
+        if (size - start < frameLength) {
+            break;
+        }
+
+        const uchar* crc = bytes + start + frameLength - crcLength;
+        if (crc24q(bytes + start, frameLength - crcLength) == (((quint32)crc[0] << 16) | ((quint32)crc[1] << 8) | crc[2])) {
+            frames.append(_buffer.mid(start, frameLength));
+            start += frameLength;
+        } else {
+            // Resynchronize on the next preamble
+            _crcErrors++;
+            start++;
+        }
+    }
+
+    _buffer.remove(0, start);
+}
+
+int RTCM3Parser::messageType(const QByteArray& frame)
+{
+    if (frame.size() < headerLength + 2) {
+        return 0;
+    }
+    return ((uchar)frame[headerLength] << 4) | ((uchar)frame[headerLength + 1] >> 4);
+}
+
+quint32 RTCM3Parser::crc24q(const uchar* data, int length)
+{
+    static quint32 table[256];
+    static bool tableInitialized = false;
+
+    if (!tableInitialized) {
+        for (int i=0; i<256; i++) {
+            quint32 crc = i << 16;
+            for (int bit=0; bit<8; bit++) {
+                crc <<= 1;
+                if (crc & 0x1000000) {
+                    crc ^= 0x1864CFB;
+                }
+            }
+            table[i] = crc & 0xFFFFFF;
+        }
+        tableInitialized = true;
+    }
+
+    quint32 crc = 0;
+    for (int i=0; i<length; i++) {
+        crc = ((crc << 8) & 0xFFFFFF) ^ table[((crc >> 16) ^ data[i]) & 0xFF];
+    }
+
+    return crc;
+}
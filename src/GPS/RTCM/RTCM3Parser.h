@@ -0,0 +1,51 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+
+/**
+ ** class RTCM3Parser
+ * Splits a stream of bytes into RTCM3 frames. Data can be added in pieces of any size, bytes which are not part of a
+ * frame with a valid CRC are skipped.
+ *
+ * Frame: 0xD3, 6 reserved bits, 10 bit payload length, payload (starts with the 12 bit message type), 24 bit CRC-24Q
+ */
+class RTCM3Parser
+{
+public:
+    RTCM3Parser(void);
+
+    /// Adds received bytes
+    ///     @param frames Complete frames (header, payload and CRC) are appended
+    void addData(const QByteArray& data, QList<QByteArray>& frames);
+
+    /// Drops partially received data
+    void reset(void);
+
+    /// @return Frames dropped due to a bad CRC since the last reset
+    int crcErrors(void) const { return _crcErrors; }
+
+    /// @return Message type of the frame
+    static int messageType(const QByteArray& frame);
+
+    static quint32 crc24q(const uchar* data, int length);
+
+    static const uchar  preamble =          0xD3;
+    static const int    headerLength =      3;
+    static const int    crcLength =         3;
+    static const int    maxPayloadLength =  1023;
+
+private:
+    QByteArray  _buffer;
+    int         _crcErrors;
+};
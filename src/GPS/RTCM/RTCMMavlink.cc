@@ -12,24 +12,37 @@
 
 #include "MultiVehicleManager.h"
 #include "Vehicle.h"
-
-#include <cstdio>
+#include "QGCLoggingCategory.h"
 
 RTCMMavlink::RTCMMavlink(QGCToolbox& toolbox)
     : _toolbox(toolbox)
 {
     _bandwidthTimer.start();
+    _latencyClock.start();
+}
+
+RTCMMavlink::~RTCMMavlink()
+{
+    QMutexLocker lock(&_statisticsMutex);
+
+    foreach (const QMetaObject::Connection& connection, _writeConnections) {
+        disconnect(connection);
+    }
+}
+
+QMap<QString, RTCMMavlink::LinkStatistics> RTCMMavlink::linkStatistics(void)
+{
+    QMutexLocker lock(&_statisticsMutex);
+
+    return _linkStatistics;
 }
 
 void RTCMMavlink::RTCMDataUpdate(QByteArray message)
 {
     /* statistics */
     _bandwidthByteCounter += message.size();
-    qint64 elapsed = _bandwidthTimer.elapsed();
-    if (elapsed > 1000) {
-        printf("RTCM bandwidth: %.2f kB/s\n", (float) _bandwidthByteCounter / elapsed * 1000.f / 1024.f);
-        _bandwidthTimer.restart();
-        _bandwidthByteCounter = 0;
+    if (_bandwidthTimer.elapsed() > statisticsIntervalMSecs) {
+        _updateStatistics();
     }
 
     const int maxMessageLength = MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN;
@@ -53,8 +66,8 @@ void RTCMMavlink::RTCMDataUpdate(QByteArray message)
             mavlinkRtcmData.flags |= (_sequenceId & 0x1F) << 3;     // Next 5 bits are sequence id
             mavlinkRtcmData.len = length;
             memcpy(&mavlinkRtcmData.data, message.data() + start, length);
-            sendMessageToVehicle(mavlinkRtcmData);
             start += length;
+            sendMessageToVehicle(mavlinkRtcmData);
         }
     }
     ++_sequenceId;
@@ -64,14 +77,99 @@ void RTCMMavlink::sendMessageToVehicle(const mavlink_gps_rtcm_data_t& msg)
 {
     QmlObjectListModel& vehicles = *_toolbox.multiVehicleManager()->vehicles();
     MAVLinkProtocol* mavlinkProtocol = _toolbox.mavlinkProtocol();
+    QList<LinkInterface*> sentLinks;
+
     for (int i = 0; i < vehicles.count(); i++) {
         Vehicle* vehicle = qobject_cast<Vehicle*>(vehicles[i]);
+        LinkInterface* link = vehicle->priorityLink();
+
+        // The other vehicles on this link already get the copy which was sent to the first one
+        if (!link || sentLinks.contains(link)) {
+            continue;
+        }
+
         mavlink_message_t message;
         mavlink_msg_gps_rtcm_data_encode_chan(mavlinkProtocol->getSystemId(),
                                               mavlinkProtocol->getComponentId(),
-                                              vehicle->priorityLink()->mavlinkChannel(),
+                                              link->mavlinkChannel(),
                                               &message,
                                               &msg);
-        vehicle->sendMessageOnLink(vehicle->priorityLink(), message);
+        if (vehicle->sendMessageOnLink(link, message)) {
+            // Only now the link is covered, otherwise the next vehicle on it gets to try
+            sentLinks.append(link);
+
+            QMutexLocker lock(&_statisticsMutex);
+
+            if (!_writeConnections.contains(link)) {
+                // Queued to the link thread after the link's own _writeBytes, so this runs once the bytes are written
+                _writeConnections[link] = connect(link, &LinkInterface::_invokeWriteBytes, link, [this, link](QByteArray bytes) {
+                    _linkWrote(link, bytes);
+                });
+            }
+            QQueue<qint64>& pendingWrites = _pendingWrites[link];
+            if (pendingWrites.count() >= maxPendingWrites) {
+                // The vehicle dropped some of them without writing, e.g. while the link was going away
+                pendingWrites.dequeue();
+            }
+            pendingWrites.enqueue(_latencyClock.nsecsElapsed());
+
+            LinkStatistics& statistics = _linkStatistics[link->getName()];
+            int bytes = message.len + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+
+            statistics.bytesSent += bytes;
+            statistics.intervalBytes += bytes;
+            statistics.messagesSent++;
+        }
     }
 }
+
+/// Called on the link thread after the link wrote bytes
+void RTCMMavlink::_linkWrote(LinkInterface* link, const QByteArray& bytes)
+{
+    // Other messages on the link are not followed
+    if (_messageId(bytes) != MAVLINK_MSG_ID_GPS_RTCM_DATA) {
+        return;
+    }
+
+    QMutexLocker lock(&_statisticsMutex);
+
+    QQueue<qint64>& pendingWrites = _pendingWrites[link];
+    if (!pendingWrites.isEmpty()) {
+        _linkStatistics[link->getName()].latencyUsecs = (_latencyClock.nsecsElapsed() - pendingWrites.dequeue()) / 1000;
+    }
+}
+
+/// @return Message id of a MAVLink 1 or 2 packet, UINT32_MAX for anything else
+uint32_t RTCMMavlink::_messageId(const QByteArray& bytes)
+{
+    const uint8_t* data = (const uint8_t*)bytes.constData();
+
+    if (bytes.size() >= MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1 && data[0] == MAVLINK_STX_MAVLINK1) {
+        return data[5];
+    }
+    if (bytes.size() >= MAVLINK_CORE_HEADER_LEN + 1 && data[0] == MAVLINK_STX) {
+        return data[7] | (data[8] << 8) | (data[9] << 16);
+    }
+
+    return UINT32_MAX;
+}
+
+void RTCMMavlink::_updateStatistics(void)
+{
+    QMutexLocker lock(&_statisticsMutex);
+    qint64 elapsed = _bandwidthTimer.elapsed();
+
+    _bandwidth = (double)_bandwidthByteCounter / elapsed * 1000.0 / 1024.0;
+    qCDebug(RTKGPSLog) << QString("RTCM bandwidth: %1 kB/s").arg(_bandwidth, 0, 'f', 2);
+
+    for (QMap<QString, LinkStatistics>::iterator it = _linkStatistics.begin(); it != _linkStatistics.end(); ++it) {
+        LinkStatistics& statistics = it.value();
+        statistics.bandwidth = (double)statistics.intervalBytes / elapsed * 1000.0 / 1024.0;
+        statistics.intervalBytes = 0;
+        qCDebug(RTKGPSLog) << QString("RTCM link %1: %2 kB/s, %3 messages, latency %4 us")
+                              .arg(it.key()).arg(statistics.bandwidth, 0, 'f', 2).arg(statistics.messagesSent).arg(statistics.latencyUsecs);
+    }
+
+    _bandwidthTimer.restart();
+    _bandwidthByteCounter = 0;
+}
@@ -12,29 +12,70 @@
 
 #include <QObject>
 #include <QElapsedTimer>
+#include <QMap>
+#include <QMutex>
+#include <QQueue>
 
 #include "QGCToolbox.h"
 #include "MAVLinkProtocol.h"
 
+class LinkInterface;
+
 /**
  ** class RTCMMavlink
  * Receives RTCM updates and sends them via MAVLINK to the device
+ *
+ * GPS_RTCM_DATA has no target, so each fragment is encoded and sent once per link. All vehicles
+ * which share a link (for example a swarm behind one broadcast radio) receive that single copy.
+ *
+ * The latency of a link is taken from queueing a fragment to the link thread writing it. The write is seen through the
+ * link's own write signal, so any link type is covered without changes to the links.
  */
 class RTCMMavlink : public QObject
 {
     Q_OBJECT
 public:
     RTCMMavlink(QGCToolbox& toolbox);
+    ~RTCMMavlink();
     //TODO: API to select device(s)?
 
+    /// RTCM statistics of a link
+    struct LinkStatistics {
+        quint64 bytesSent = 0;          ///< MAVLink bytes sent since start
+        quint64 messagesSent = 0;       ///< GPS_RTCM_DATA messages sent since start
+        double  bandwidth = 0;          ///< kB/s over the last statistics interval
+        int     intervalBytes = 0;      ///< Bytes sent in the current statistics interval
+        qint64  latencyUsecs = -1;      ///< Queueing to link write of the last fragment written, -1 before the first one
+    };
+
+    /// @return Statistics by link name
+    QMap<QString, LinkStatistics> linkStatistics(void);
+
+    /// @return RTCM bandwidth received from the GPS in kB/s over the last statistics interval
+    double bandwidth(void) const { return _bandwidth; }
+
+    static const int statisticsIntervalMSecs = 1000;
+    static const int maxPendingWrites = 100;    ///< Queued fragments followed per link, older ones are given up
+
 public slots:
     void RTCMDataUpdate(QByteArray message);
 
 private:
     void sendMessageToVehicle(const mavlink_gps_rtcm_data_t& msg);
+    void _updateStatistics(void);
+    void _linkWrote(LinkInterface* link, const QByteArray& bytes);
+
+    static uint32_t _messageId(const QByteArray& bytes);
 
     QGCToolbox& _toolbox;
     QElapsedTimer _bandwidthTimer;
     int _bandwidthByteCounter = 0;
+    double _bandwidth = 0;
     uint8_t _sequenceId = 0;
+
+    QMutex _statisticsMutex;    ///< The links report their writes from the link threads
+    QMap<QString, LinkStatistics> _linkStatistics;
+    QElapsedTimer _latencyClock;
+    QMap<LinkInterface*, QQueue<qint64>> _pendingWrites;               ///< Queue times of the fragments not written yet
+    QMap<LinkInterface*, QMetaObject::Connection> _writeConnections;
 };
@@ -0,0 +1,59 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+
+#include "RTCMMavlinkTest.h"
+#include "RTCMMavlink.h"
+#include "MockLink.h"
+#include "MultiVehicleManager.h"
+#include "QGCApplication.h"
+
+void RTCMMavlinkTest::_sharedLinkTest(void)
+{
+    MultiVehicleManager* multiVehicleManager = qgcApp()->toolbox()->multiVehicleManager();
+
+    // The link vehicle and a swarm vehicle behind the same link
+    _mockLink = MockLink::startSwarmMockLink(1, 1, MockLinkSwarm::MessageMixLight);
+    QTRY_COMPARE_WITH_TIMEOUT(multiVehicleManager->vehicles()->count(), 2, 10000);
+
+    RTCMMavlink rtcmMavlink(*qgcApp()->toolbox());
+
+    // Fits a single GPS_RTCM_DATA
+    rtcmMavlink.RTCMDataUpdate(QByteArray(100, 0x55));
+    QTRY_COMPARE_WITH_TIMEOUT(_mockLink->receivedMessageCount(MAVLINK_MSG_ID_GPS_RTCM_DATA), 1, 1000);
+
+    // Needs two fragments
+    rtcmMavlink.RTCMDataUpdate(QByteArray(MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN + 1, 0x55));
+    QTRY_COMPARE_WITH_TIMEOUT(_mockLink->receivedMessageCount(MAVLINK_MSG_ID_GPS_RTCM_DATA), 3, 1000);
+
+    // No second copy for the other vehicle shows up later on
+    QTest::qWait(100);
+    QCOMPARE(_mockLink->receivedMessageCount(MAVLINK_MSG_ID_GPS_RTCM_DATA), 3);
+    QCOMPARE(rtcmMavlink.linkStatistics().count(), 1);
+    QCOMPARE(rtcmMavlink.linkStatistics().first().messagesSent, (quint64)3);
+}
+
+void RTCMMavlinkTest::_latencyTest(void)
+{
+    MultiVehicleManager* multiVehicleManager = qgcApp()->toolbox()->multiVehicleManager();
+
+    _mockLink = MockLink::startGenericMockLink(false);
+    QTRY_COMPARE_WITH_TIMEOUT(multiVehicleManager->vehicles()->count(), 1, 10000);
+
+    RTCMMavlink rtcmMavlink(*qgcApp()->toolbox());
+
+    // Nothing was written yet
+    rtcmMavlink.RTCMDataUpdate(QByteArray(100, 0x55));
+    QCOMPARE(rtcmMavlink.linkStatistics()[_mockLink->getName()].latencyUsecs, (qint64)-1);
+
+    // Set once the MockLink thread wrote the fragment
+    QTRY_VERIFY_WITH_TIMEOUT(rtcmMavlink.linkStatistics()[_mockLink->getName()].latencyUsecs >= 0, 1000);
+    QVERIFY(rtcmMavlink.linkStatistics()[_mockLink->getName()].latencyUsecs < 1000000);
+    QTRY_COMPARE_WITH_TIMEOUT(_mockLink->receivedMessageCount(MAVLINK_MSG_ID_GPS_RTCM_DATA), 1, 1000);
+}
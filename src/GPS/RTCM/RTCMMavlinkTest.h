@@ -0,0 +1,23 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "UnitTest.h"
+
+/// Checks that RTCMMavlink sends each correction once per link, not once per vehicle, and its link statistics
+class RTCMMavlinkTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _sharedLinkTest(void);
+    void _latencyTest(void);
+};
@@ -25,6 +25,7 @@ const char* Joystick::_throttleModeSettingsKey =        "ThrottleMode";
 const char* Joystick::_exponentialSettingsKey =         "Exponential";
 const char* Joystick::_accumulatorSettingsKey =         "Accumulator";
 const char* Joystick::_deadbandSettingsKey =            "Deadband";
+const char* Joystick::_outputRateSettingsKey =          "OutputRate";
 const char* Joystick::_txModeSettingsKey =              NULL;
 const char* Joystick::_fixedWingTXModeSettingsKey =     "TXMode_FixedWing";
 const char* Joystick::_multiRotorTXModeSettingsKey =    "TXMode_MultiRotor";
@@ -59,6 +60,23 @@ Joystick::Joystick(const QString& name, int axisCount, int buttonCount, int hatC
     , _exponential(0)
     , _accumulator(false)
     , _deadband(false)
+    , _outputRate(_defaultOutputRate)
+    , _inputChangedNsecs(-1)
+    , _lastSendNsecs(-1)
+    , _nextCalibrationRepeatNsecs(0)
+    , _statisticsStartNsecs(0)
+    , _statisticsSends(0)
+    , _statisticsLatencyCount(0)
+    , _statisticsLatencyNsecs(0)
+    , _statisticsMaxLatencyNsecs(0)
+    , _statisticsIntervalCount(0)
+    , _statisticsJitterNsecs(0)
+    , _statisticsMaxJitterNsecs(0)
+    , _sendRate(0)
+    , _inputLatencyMsecs(0)
+    , _maxInputLatencyMsecs(0)
+    , _sendJitterMsecs(0)
+    , _maxSendJitterMsecs(0)
     , _activeVehicle(NULL)
     , _pollingStartedForCalibration(false)
     , _multiVehicleManager(multiVehicleManager)
@@ -80,6 +98,7 @@ Joystick::Joystick(const QString& name, int axisCount, int buttonCount, int hatC
     _loadSettings();
 
     connect(_multiVehicleManager, &MultiVehicleManager::activeVehicleChanged, this, &Joystick::_activeVehicleChanged);
+    connect(this, &Joystick::_statisticsUpdated, this, &Joystick::_setStatistics);
 }
 
 Joystick::~Joystick()
@@ -180,6 +199,11 @@ void Joystick::_loadSettings(void)
     _accumulator = settings.value(_accumulatorSettingsKey, false).toBool();
     _deadband = settings.value(_deadbandSettingsKey, false).toBool();
 
+    _outputRate = settings.value(_outputRateSettingsKey, _defaultOutputRate).toInt(&convertOk);
+    if (!convertOk || _outputRate < 1 || _outputRate > _maxOutputRate) {
+        _outputRate = _defaultOutputRate;
+    }
+
     _throttleMode = (ThrottleMode_t)settings.value(_throttleModeSettingsKey, ThrottleModeCenterZero).toInt(&convertOk);
     badSettings |= !convertOk;
 
@@ -256,8 +280,9 @@ void Joystick::_saveSettings(void)
     settings.setValue(_accumulatorSettingsKey, _accumulator);
     settings.setValue(_deadbandSettingsKey, _deadband);
     settings.setValue(_throttleModeSettingsKey, _throttleMode);
+    settings.setValue(_outputRateSettingsKey, _outputRate);
 
-    qCDebug(JoystickLog) << "_saveSettings calibrated:throttlemode:deadband:txmode" << _calibrated << _throttleMode << _deadband << _transmitterMode;
+    qCDebug(JoystickLog) << "_saveSettings calibrated:throttlemode:deadband:txmode:outputrate" << _calibrated << _throttleMode << _deadband << _transmitterMode << _outputRate;
 
     QString minTpl  ("Axis%1Min");
     QString maxTpl  ("Axis%1Max");
@@ -392,142 +417,275 @@ float Joystick::_adjustRange(int value, Calibration_t calibration, bool withDead
 }
 
 
-void Joystick::run(void)
+/// Waits for the output period when the device can't signal new input
+bool Joystick::_waitForInput(int timeoutUsecs)
 {
-    _open();
+    QGC::SLEEP::usleep(timeoutUsecs);
+    return true;
+}
 
-    while (!_exitThread) {
-    _update();
+/// Reads the current device state. Raw signals are only emitted for changed values, except for axes during calibration.
+///     @return true: an axis or button changed
+bool Joystick::_readInputs(qint64 nowNsecs)
+{
+    bool changed = false;
+
+    // Calibration code requires axis signals even if the value hasn't changed
+    bool repeatAxes = _calibrationMode && nowNsecs >= _nextCalibrationRepeatNsecs;
+    if (repeatAxes) {
+        _nextCalibrationRepeatNsecs = nowNsecs + _calibrationRepeatMsecs * 1000000LL;
+    }
 
-        // Update axes
-        for (int axisIndex=0; axisIndex<_axisCount; axisIndex++) {
-            int newAxisValue = _getAxis(axisIndex);
-            // Calibration code requires signal to be emitted even if value hasn't changed
+    // Update axes
+    for (int axisIndex=0; axisIndex<_axisCount; axisIndex++) {
+        int newAxisValue = _getAxis(axisIndex);
+        if (newAxisValue != _rgAxisValues[axisIndex]) {
             _rgAxisValues[axisIndex] = newAxisValue;
+            changed = true;
+            emit rawAxisValueChanged(axisIndex, newAxisValue);
+        } else if (repeatAxes) {
             emit rawAxisValueChanged(axisIndex, newAxisValue);
         }
+    }
 
-        // Update buttons
-        for (int buttonIndex=0; buttonIndex<_buttonCount; buttonIndex++) {
-            bool newButtonValue = _getButton(buttonIndex);
-            if (newButtonValue != _rgButtonValues[buttonIndex]) {
-                _rgButtonValues[buttonIndex] = newButtonValue;
-                emit rawButtonPressedChanged(buttonIndex, newButtonValue);
-            }
+    // Update buttons
+    for (int buttonIndex=0; buttonIndex<_buttonCount; buttonIndex++) {
+        bool newButtonValue = _getButton(buttonIndex);
+        if (newButtonValue != _rgButtonValues[buttonIndex]) {
+            _rgButtonValues[buttonIndex] = newButtonValue;
+            changed = true;
+            emit rawButtonPressedChanged(buttonIndex, newButtonValue);
         }
+    }
 
-        // Update hat - append hat buttons to the end of the normal button list
-        int numHatButtons = 4;
-        for (int hatIndex=0; hatIndex<_hatCount; hatIndex++) {
-            for (int hatButtonIndex=0; hatButtonIndex<numHatButtons; hatButtonIndex++) {
-                // Create new index value that includes the normal button list
-                int rgButtonValueIndex = hatIndex*numHatButtons + hatButtonIndex + _buttonCount;
-                // Get hat value from joystick
-                bool newButtonValue = _getHat(hatIndex,hatButtonIndex);
-                if (newButtonValue != _rgButtonValues[rgButtonValueIndex]) {
-                    _rgButtonValues[rgButtonValueIndex] = newButtonValue;
-                    emit rawButtonPressedChanged(rgButtonValueIndex, newButtonValue);
-                }
+    // Update hat - append hat buttons to the end of the normal button list
+    int numHatButtons = 4;
+    for (int hatIndex=0; hatIndex<_hatCount; hatIndex++) {
+        for (int hatButtonIndex=0; hatButtonIndex<numHatButtons; hatButtonIndex++) {
+            // Create new index value that includes the normal button list
+            int rgButtonValueIndex = hatIndex*numHatButtons + hatButtonIndex + _buttonCount;
+            // Get hat value from joystick
+            bool newButtonValue = _getHat(hatIndex,hatButtonIndex);
+            if (newButtonValue != _rgButtonValues[rgButtonValueIndex]) {
+                _rgButtonValues[rgButtonValueIndex] = newButtonValue;
+                changed = true;
+                emit rawButtonPressedChanged(rgButtonValueIndex, newButtonValue);
             }
         }
+    }
 
-        if (_outputEnabled && _calibrated) {
-            int     axis = _rgFunctionAxis[rollFunction];
-            float   roll = _adjustRange(_rgAxisValues[axis], _rgCalibration[axis], _deadband);
+    if (changed && _inputChangedNsecs < 0) {
+        _inputChangedNsecs = nowNsecs;
+    }
 
-                    axis = _rgFunctionAxis[pitchFunction];
-            float   pitch = _adjustRange(_rgAxisValues[axis], _rgCalibration[axis], _deadband);
+    return changed;
+}
 
-                    axis = _rgFunctionAxis[yawFunction];
-            float   yaw = _adjustRange(_rgAxisValues[axis], _rgCalibration[axis],_deadband);
+/// Emits manualControl from the current axis and button values
+///     @param elapsedSecs Time since the previous call
+void Joystick::_sendManualControl(float elapsedSecs)
+{
+    int     axis = _rgFunctionAxis[rollFunction];
+    float   roll = _adjustRange(_rgAxisValues[axis], _rgCalibration[axis], _deadband);
 
-                    axis = _rgFunctionAxis[throttleFunction];
-            float   throttle = _adjustRange(_rgAxisValues[axis], _rgCalibration[axis], _throttleMode==ThrottleModeDownZero?false:_deadband);
+            axis = _rgFunctionAxis[pitchFunction];
+    float   pitch = _adjustRange(_rgAxisValues[axis], _rgCalibration[axis], _deadband);
 
-            if ( _accumulator ) {
-                static float throttle_accu = 0.f;
+            axis = _rgFunctionAxis[yawFunction];
+    float   yaw = _adjustRange(_rgAxisValues[axis], _rgCalibration[axis],_deadband);
 
-                throttle_accu += throttle*(40/1000.f); //for throttle to change from min to max it will take 1000ms (40ms is a loop time)
+            axis = _rgFunctionAxis[throttleFunction];
+    float   throttle = _adjustRange(_rgAxisValues[axis], _rgCalibration[axis], _throttleMode==ThrottleModeDownZero?false:_deadband);
 
-                throttle_accu = std::max(static_cast<float>(-1.f), std::min(throttle_accu, static_cast<float>(1.f)));
-                throttle = throttle_accu;
-            }
+    if ( _accumulator ) {
+        static float throttle_accu = 0.f;
 
-            float roll_limited = std::max(static_cast<float>(-M_PI_4), std::min(roll, static_cast<float>(M_PI_4)));
-            float pitch_limited = std::max(static_cast<float>(-M_PI_4), std::min(pitch, static_cast<float>(M_PI_4)));
-            float yaw_limited = std::max(static_cast<float>(-M_PI_4), std::min(yaw, static_cast<float>(M_PI_4)));
-            float throttle_limited = std::max(static_cast<float>(-M_PI_4), std::min(throttle, static_cast<float>(M_PI_4)));
-
-            // Map from unit circle to linear range and limit
-            roll =      std::max(-1.0f, std::min(tanf(asinf(roll_limited)), 1.0f));
-            pitch =     std::max(-1.0f, std::min(tanf(asinf(pitch_limited)), 1.0f));
-            yaw =       std::max(-1.0f, std::min(tanf(asinf(yaw_limited)), 1.0f));
-            throttle =  std::max(-1.0f, std::min(tanf(asinf(throttle_limited)), 1.0f));
-            
-            if ( _exponential != 0 ) {
-                // Exponential (0% to -50% range like most RC radios)
-                //_exponential is set by a slider in joystickConfig.qml
-
-                // Calculate new RPY with exponential applied
-                roll =      -_exponential*powf(roll,3) + (1+_exponential)*roll;
-                pitch =     -_exponential*powf(pitch,3) + (1+_exponential)*pitch;
-                yaw =       -_exponential*powf(yaw,3) + (1+_exponential)*yaw;
-            }
+        throttle_accu += throttle*elapsedSecs; //for throttle to change from min to max it will take 1000ms
 
-            // Adjust throttle to 0:1 range
-            if (_throttleMode == ThrottleModeCenterZero && _activeVehicle->supportsThrottleModeCenterZero()) {
-                if (!_activeVehicle->supportsNegativeThrust() || !_negativeThrust) {
-                    throttle = std::max(0.0f, throttle);
-                }
-            } else {
-                throttle = (throttle + 1.0f) / 2.0f;
-            }
+        throttle_accu = std::max(static_cast<float>(-1.f), std::min(throttle_accu, static_cast<float>(1.f)));
+        throttle = throttle_accu;
+    }
 
-            // Set up button pressed information
+    float roll_limited = std::max(static_cast<float>(-M_PI_4), std::min(roll, static_cast<float>(M_PI_4)));
+    float pitch_limited = std::max(static_cast<float>(-M_PI_4), std::min(pitch, static_cast<float>(M_PI_4)));
+    float yaw_limited = std::max(static_cast<float>(-M_PI_4), std::min(yaw, static_cast<float>(M_PI_4)));
+    float throttle_limited = std::max(static_cast<float>(-M_PI_4), std::min(throttle, static_cast<float>(M_PI_4)));
 
-            // We only send the buttons the firmwware has reserved
-            int reservedButtonCount = _activeVehicle->manualControlReservedButtonCount();
-            if (reservedButtonCount == -1) {
-                reservedButtonCount = _totalButtonCount;
-            }
+    // Map from unit circle to linear range and limit
+    roll =      std::max(-1.0f, std::min(tanf(asinf(roll_limited)), 1.0f));
+    pitch =     std::max(-1.0f, std::min(tanf(asinf(pitch_limited)), 1.0f));
+    yaw =       std::max(-1.0f, std::min(tanf(asinf(yaw_limited)), 1.0f));
+    throttle =  std::max(-1.0f, std::min(tanf(asinf(throttle_limited)), 1.0f));
+    
+    if ( _exponential != 0 ) {
+        // Exponential (0% to -50% range like most RC radios)
+        //_exponential is set by a slider in joystickConfig.qml
 
-            quint16 newButtonBits = 0;      // New set of button which are down
-            quint16 buttonPressedBits = 0;  // Buttons pressed for manualControl signal
-
-            for (int buttonIndex=0; buttonIndex<_totalButtonCount; buttonIndex++) {
-                quint16 buttonBit = 1 << buttonIndex;
-
-                if (!_rgButtonValues[buttonIndex]) {
-                    // Button up, just record it
-                    newButtonBits |= buttonBit;
-                } else {
-                    if (_lastButtonBits & buttonBit) {
-                        // Button was up last time through, but is now down which indicates a button press
-                        qCDebug(JoystickLog) << "button triggered" << buttonIndex;
-
-                        if (buttonIndex >= reservedButtonCount) {
-                            // Button is above firmware reserved set
-                            QString buttonAction =_rgButtonActions[buttonIndex];
-                            if (!buttonAction.isEmpty()) {
-                                _buttonAction(buttonAction);
-                            }
-                        }
-                    }
+        // Calculate new RPY with exponential applied
+        roll =      -_exponential*powf(roll,3) + (1+_exponential)*roll;
+        pitch =     -_exponential*powf(pitch,3) + (1+_exponential)*pitch;
+        yaw =       -_exponential*powf(yaw,3) + (1+_exponential)*yaw;
+    }
+
+    // Adjust throttle to 0:1 range
+    if (_throttleMode == ThrottleModeCenterZero && _activeVehicle->supportsThrottleModeCenterZero()) {
+        if (!_activeVehicle->supportsNegativeThrust() || !_negativeThrust) {
+            throttle = std::max(0.0f, throttle);
+        }
+    } else {
+        throttle = (throttle + 1.0f) / 2.0f;
+    }
 
-                    // Mark the button as pressed as long as its pressed
-                    buttonPressedBits |= buttonBit;
+    // Set up button pressed information
+
+    // We only send the buttons the firmwware has reserved
+    int reservedButtonCount = _activeVehicle->manualControlReservedButtonCount();
+    if (reservedButtonCount == -1) {
+        reservedButtonCount = _totalButtonCount;
+    }
+
+    quint16 newButtonBits = 0;      // New set of button which are down
+    quint16 buttonPressedBits = 0;  // Buttons pressed for manualControl signal
+
+    for (int buttonIndex=0; buttonIndex<_totalButtonCount; buttonIndex++) {
+        quint16 buttonBit = 1 << buttonIndex;
+
+        if (!_rgButtonValues[buttonIndex]) {
+            // Button up, just record it
+            newButtonBits |= buttonBit;
+        } else {
+            if (_lastButtonBits & buttonBit) {
+                // Button was up last time through, but is now down which indicates a button press
+                qCDebug(JoystickLog) << "button triggered" << buttonIndex;
+
+                if (buttonIndex >= reservedButtonCount) {
+                    // Button is above firmware reserved set
+                    QString buttonAction =_rgButtonActions[buttonIndex];
+                    if (!buttonAction.isEmpty()) {
+                        _buttonAction(buttonAction);
+                    }
                 }
             }
 
-            _lastButtonBits = newButtonBits;
+            // Mark the button as pressed as long as its pressed
+            buttonPressedBits |= buttonBit;
+        }
+    }
+
+    _lastButtonBits = newButtonBits;
 
-            qCDebug(JoystickValuesLog) << "name:roll:pitch:yaw:throttle" << name() << roll << -pitch << yaw << throttle;
+    qCDebug(JoystickValuesLog) << "name:roll:pitch:yaw:throttle" << name() << roll << -pitch << yaw << throttle;
 
-            emit manualControl(roll, -pitch, yaw, throttle, buttonPressedBits, _activeVehicle->joystickMode());
+    emit manualControl(roll, -pitch, yaw, throttle, buttonPressedBits, _activeVehicle->joystickMode(), elapsedSecs);
+}
+
+void Joystick::_updateStatistics(qint64 nowNsecs)
+{
+    qint64 elapsedNsecs = nowNsecs - _statisticsStartNsecs;
+
+    if (elapsedNsecs < _statisticsMsecs * 1000000LL) {
+        return;
+    }
+
+    emit _statisticsUpdated((_statisticsSends * 1e9) / elapsedNsecs,
+                            _statisticsLatencyCount ? (_statisticsLatencyNsecs / 1e6) / _statisticsLatencyCount : 0,
+                            _statisticsMaxLatencyNsecs / 1e6,
+                            _statisticsIntervalCount ? (_statisticsJitterNsecs / 1e6) / _statisticsIntervalCount : 0,
+                            _statisticsMaxJitterNsecs / 1e6);
+
+    _statisticsStartNsecs =         nowNsecs;
+    _statisticsSends =              0;
+    _statisticsLatencyCount =       0;
+    _statisticsLatencyNsecs =       0;
+    _statisticsMaxLatencyNsecs =    0;
+    _statisticsIntervalCount =      0;
+    _statisticsJitterNsecs =        0;
+    _statisticsMaxJitterNsecs =     0;
+}
+
+void Joystick::_setStatistics(double sendRate, double inputLatencyMsecs, double maxInputLatencyMsecs, double sendJitterMsecs, double maxSendJitterMsecs)
+{
+    _sendRate =             sendRate;
+    _inputLatencyMsecs =    inputLatencyMsecs;
+    _maxInputLatencyMsecs = maxInputLatencyMsecs;
+    _sendJitterMsecs =      sendJitterMsecs;
+    _maxSendJitterMsecs =   maxSendJitterMsecs;
+    emit statisticsChanged();
+}
+
+/// Input is read as soon as the device reports it, manualControl is emitted at a steady outputRate against a monotonic
+/// clock. The deadline advances by a whole period each time so the send times don't drift with processing time.
+void Joystick::run(void)
+{
+    QElapsedTimer   clock;
+    qint64          nextSendNsecs = 0;
+
+    _open();
+
+    clock.start();
+    _inputChangedNsecs = -1;
+    _lastSendNsecs = -1;
+    _nextCalibrationRepeatNsecs = 0;
+    _statisticsStartNsecs = 0;
+    _statisticsSends = 0;
+    _statisticsLatencyCount = 0;
+    _statisticsLatencyNsecs = 0;
+    _statisticsMaxLatencyNsecs = 0;
+    _statisticsIntervalCount = 0;
+    _statisticsJitterNsecs = 0;
+    _statisticsMaxJitterNsecs = 0;
+
+    while (!_exitThread) {
+        qint64 periodNsecs = 1000000000LL / _outputRate;
+        qint64 waitUsecs = (nextSendNsecs - clock.nsecsElapsed()) / 1000;
+
+        // Also wake up for calibration repeats which need the raw values at a fixed rate
+        if (_calibrationMode) {
+            waitUsecs = qMin(waitUsecs, (_nextCalibrationRepeatNsecs - clock.nsecsElapsed()) / 1000);
+        }
+        if (waitUsecs > 0) {
+            _waitForInput((int)waitUsecs);
+        }
+
+        _update();
+        _readInputs(clock.nsecsElapsed());
+
+        qint64 nowNsecs = clock.nsecsElapsed();
+        if (nowNsecs < nextSendNsecs) {
+            continue;
+        }
+
+        if (_outputEnabled && _calibrated) {
+            // Setpoint accumulators integrate over the time which actually passed, a stalled thread must not cause a jump
+            qint64 elapsedNsecs = _lastSendNsecs >= 0 ? qMin(nowNsecs - _lastSendNsecs, _maxSendIntervalMsecs * 1000000LL) : periodNsecs;
+            _sendManualControl(elapsedNsecs / 1e9f);
+
+            nowNsecs = clock.nsecsElapsed();
+            _statisticsSends++;
+            if (_inputChangedNsecs >= 0) {
+                qint64 latencyNsecs = nowNsecs - _inputChangedNsecs;
+                _statisticsLatencyCount++;
+                _statisticsLatencyNsecs += latencyNsecs;
+                _statisticsMaxLatencyNsecs = qMax(_statisticsMaxLatencyNsecs, latencyNsecs);
+            }
+            if (_lastSendNsecs >= 0) {
+                qint64 jitterNsecs = qAbs((nowNsecs - _lastSendNsecs) - periodNsecs);
+                _statisticsIntervalCount++;
+                _statisticsJitterNsecs += jitterNsecs;
+                _statisticsMaxJitterNsecs = qMax(_statisticsMaxJitterNsecs, jitterNsecs);
+            }
+            _lastSendNsecs = nowNsecs;
+        } else {
+            _lastSendNsecs = -1;
         }
+        _inputChangedNsecs = -1;
+        _updateStatistics(nowNsecs);
 
-        // Sleep, update rate of joystick is approx. 25 Hz (1000 ms / 25 = 40 ms)
-        QGC::SLEEP::msleep(40);
+        nextSendNsecs += periodNsecs;
+        if (nextSendNsecs <= nowNsecs) {
+            // We fell behind by more than a period, restart the schedule instead of sending a burst
+            nextSendNsecs = nowNsecs + periodNsecs;
+        }
     }
 
     _close();
@@ -757,6 +915,19 @@ void Joystick::setDeadband(bool deadband)
     _saveSettings();
 }
 
+void Joystick::setOutputRate(int rate)
+{
+    if (rate < 1 || rate > _maxOutputRate) {
+        qCWarning(JoystickLog) << "Invalid output rate" << rate;
+        return;
+    }
+
+    _outputRate = rate;
+
+    _saveSettings();
+    emit outputRateChanged(_outputRate);
+}
+
 void Joystick::setCalibrationMode(bool calibrating)
 {
     _calibrationMode = calibrating;
@@ -13,6 +13,7 @@
 
 #include <QObject>
 #include <QThread>
+#include <QElapsedTimer>
 
 #include "QGCLoggingCategory.h"
 #include "Vehicle.h"
@@ -77,6 +78,17 @@ public:
     Q_PROPERTY(float exponential READ exponential WRITE setExponential NOTIFY exponentialChanged)
     Q_PROPERTY(bool accumulator READ accumulator WRITE setAccumulator NOTIFY accumulatorChanged)
 	Q_PROPERTY(bool requiresCalibration READ requiresCalibration CONSTANT)
+
+    /// Rate at which manualControl is emitted in Hz, 1 to maxOutputRate
+    Q_PROPERTY(int outputRate READ outputRate WRITE setOutputRate NOTIFY outputRateChanged)
+    Q_PROPERTY(int maxOutputRate READ maxOutputRate CONSTANT)
+
+    // Output statistics, updated once a second while polling
+    Q_PROPERTY(double sendRate                  READ sendRate                   NOTIFY statisticsChanged)   ///< manualControl signals per second
+    Q_PROPERTY(double inputLatencyMsecs         READ inputLatencyMsecs          NOTIFY statisticsChanged)   ///< Average time from input change to send
+    Q_PROPERTY(double maxInputLatencyMsecs      READ maxInputLatencyMsecs       NOTIFY statisticsChanged)
+    Q_PROPERTY(double sendJitterMsecs           READ sendJitterMsecs            NOTIFY statisticsChanged)   ///< Average deviation of the send interval from the output period
+    Q_PROPERTY(double maxSendJitterMsecs        READ maxSendJitterMsecs         NOTIFY statisticsChanged)
     
     // Property accessors
 
@@ -123,6 +135,16 @@ public:
     void setTXMode(int mode);
     int getTXMode(void) { return _transmitterMode; }
 
+    int outputRate(void) { return _outputRate; }
+    void setOutputRate(int rate);
+    int maxOutputRate(void) { return _maxOutputRate; }
+
+    double sendRate(void)               { return _sendRate; }
+    double inputLatencyMsecs(void)      { return _inputLatencyMsecs; }
+    double maxInputLatencyMsecs(void)   { return _maxInputLatencyMsecs; }
+    double sendJitterMsecs(void)        { return _sendJitterMsecs; }
+    double maxSendJitterMsecs(void)     { return _maxSendJitterMsecs; }
+
     /// Set the current calibration mode
     void setCalibrationMode(bool calibrating);
     void setOutputEnabled(bool enabled);
@@ -145,6 +167,10 @@ signals:
 
     void accumulatorChanged(bool accumulator);
 
+    void outputRateChanged(int rate);
+
+    void statisticsChanged(void);
+
     void enabledChanged(bool enabled);
 
     /// Signal containing new joystick information
@@ -153,10 +179,14 @@ signals:
     ///     @param yaw      Range is -1:1, negative meaning yaw left, positive meaning yaw right
     ///     @param throttle Range is 0:1, 0 meaning no throttle, 1 meaning full throttle
     ///     @param mode     See Vehicle::JoystickMode_t enum
-    void manualControl(float roll, float pitch, float yaw, float throttle, quint16 buttons, int joystickMmode);
+    ///     @param elapsedSecs Time since the previous signal
+    void manualControl(float roll, float pitch, float yaw, float throttle, quint16 buttons, int joystickMmode, float elapsedSecs);
 
     void buttonActionTriggered(int action);
 
+    /// Statistics from the polling thread, handed to the Joystick thread affinity by a queued connection
+    void _statisticsUpdated(double sendRate, double inputLatencyMsecs, double maxInputLatencyMsecs, double sendJitterMsecs, double maxSendJitterMsecs);
+
 protected:
     void    _setDefaultCalibration(void);
     void    _saveSettings(void);
@@ -175,6 +205,15 @@ private:
     virtual int _getAxis(int i) = 0;
     virtual uint8_t _getHat(int hat,int i) = 0;
 
+    /// Waits for new input from the device
+    ///     @param timeoutUsecs Maximum time to wait
+    ///     @return true: input may have changed, false: timeout
+    virtual bool _waitForInput(int timeoutUsecs);
+
+    bool _readInputs(qint64 nowNsecs);
+    void _sendManualControl(float elapsedSecs);
+    void _updateStatistics(qint64 nowNsecs);
+
     void _updateTXModeSettingsKey(Vehicle* activeVehicle);
     int _mapFunctionMode(int mode, int function);
     void _remapAxes(int currentMode, int newMode, int (&newMapping)[maxFunction]);
@@ -214,6 +253,27 @@ protected:
     bool                _accumulator;
     bool                _deadband;
 
+    int                 _outputRate;
+
+    // Polling thread only
+    qint64              _inputChangedNsecs;         ///< Time of the first input change not sent yet, -1 for none
+    qint64              _lastSendNsecs;
+    qint64              _nextCalibrationRepeatNsecs;
+    qint64              _statisticsStartNsecs;
+    int                 _statisticsSends;
+    int                 _statisticsLatencyCount;
+    qint64              _statisticsLatencyNsecs;
+    qint64              _statisticsMaxLatencyNsecs;
+    int                 _statisticsIntervalCount;
+    qint64              _statisticsJitterNsecs;
+    qint64              _statisticsMaxJitterNsecs;
+
+    double              _sendRate;
+    double              _inputLatencyMsecs;
+    double              _maxInputLatencyMsecs;
+    double              _sendJitterMsecs;
+    double              _maxSendJitterMsecs;
+
     Vehicle*            _activeVehicle;
     bool                _pollingStartedForCalibration;
 
@@ -229,6 +289,7 @@ private:
     static const char* _exponentialSettingsKey;
     static const char* _accumulatorSettingsKey;
     static const char* _deadbandSettingsKey;
+    static const char* _outputRateSettingsKey;
     static const char* _txModeSettingsKey;
     static const char* _fixedWingTXModeSettingsKey;
     static const char* _multiRotorTXModeSettingsKey;
@@ -236,8 +297,15 @@ private:
     static const char* _vtolTXModeSettingsKey;
     static const char* _submarineTXModeSettingsKey;
 
+    static const int _defaultOutputRate =           25;
+    static const int _maxOutputRate =               100;
+    static const int _calibrationRepeatMsecs =      40;     ///< Calibration settle detection needs raw axis values even if they don't change
+    static const int _statisticsMsecs =             1000;
+    static const int _maxSendIntervalMsecs =        200;    ///< Upper bound of the elapsed time passed with manualControl
+
 private slots:
     void _activeVehicleChanged(Vehicle* activeVehicle);
+    void _setStatistics(double sendRate, double inputLatencyMsecs, double maxInputLatencyMsecs, double sendJitterMsecs, double maxSendJitterMsecs);
 };
 
 #endif
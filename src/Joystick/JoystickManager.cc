@@ -187,7 +187,13 @@ void JoystickManager::_updateAvailableJoysticks(void)
 {
 #ifdef __sdljoystick__
     SDL_Event event;
-    while (SDL_PollEvent(&event)) {
+
+    // Input events are taken by the polling thread of the active joystick (JoystickSDL::_waitForInput), only device
+    // events are handled here. Everything else, and input events without a polling thread, is discarded so the queue
+    // doesn't fill up.
+    SDL_PumpEvents();
+    while (SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_QUIT, SDL_QUIT) > 0 ||
+           SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_JOYDEVICEADDED, SDL_JOYDEVICEREMOVED) > 0) {
         switch(event.type) {
         case SDL_QUIT:
             qCDebug(JoystickManagerLog) << "SDL ERROR:" << SDL_GetError();
@@ -204,6 +210,13 @@ void JoystickManager::_updateAvailableJoysticks(void)
             break;
         }
     }
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_JOYAXISMOTION - 1);
+    SDL_FlushEvents(SDL_JOYBUTTONUP + 1, SDL_CONTROLLERAXISMOTION - 1);
+    SDL_FlushEvents(SDL_CONTROLLERBUTTONUP + 1, SDL_LASTEVENT);
+    if (!_activeJoystick || !_activeJoystick->isRunning()) {
+        SDL_FlushEvents(SDL_JOYAXISMOTION, SDL_JOYBUTTONUP);
+        SDL_FlushEvents(SDL_CONTROLLERAXISMOTION, SDL_CONTROLLERBUTTONUP);
+    }
 #elif defined(__android__)
     /*
      * TODO: Investigate Android events for Joystick hot plugging
@@ -1,9 +1,11 @@
 #include "JoystickSDL.h"
 
 #include "QGCApplication.h"
+#include "QGC.h"
 
 #include <QQmlEngine>
 #include <QTextStream>
+#include <QElapsedTimer>
 
 JoystickSDL::JoystickSDL(const QString& name, int axisCount, int buttonCount, int hatCount, int index, bool isGameController, MultiVehicleManager* multiVehicleManager)
     : Joystick(name,axisCount,buttonCount,hatCount,multiVehicleManager)
@@ -163,6 +165,45 @@ bool JoystickSDL::_update(void)
     return true;
 }
 
+/// SDL_WaitEventTimeout can't be used since it would also take the device added/removed events JoystickManager waits
+/// for, so only the input events are taken from the queue. Like SDL_WaitEventTimeout, this checks for new events every
+/// msec with the remainder of the timeout slept precisely.
+bool JoystickSDL::_waitForInput(int timeoutUsecs)
+{
+    QElapsedTimer   elapsed;
+    SDL_Event       events[16];
+
+    elapsed.start();
+    while (true) {
+        SDL_JoystickUpdate();
+
+        int count = SDL_PeepEvents(events, 16, SDL_GETEVENT, SDL_JOYAXISMOTION, SDL_JOYBUTTONUP);
+        if (count < 0) {
+            qCWarning(JoystickLog) << "SDL_PeepEvents failed:" << SDL_GetError();
+            QGC::SLEEP::usleep(timeoutUsecs);
+            return true;
+        }
+        count += qMax(0, SDL_PeepEvents(events, 16, SDL_GETEVENT, SDL_CONTROLLERAXISMOTION, SDL_CONTROLLERBUTTONUP));
+        if (count > 0) {
+            _lastInputTimer.start();
+            return true;
+        }
+
+        qint64 remainingUsecs = timeoutUsecs - (elapsed.nsecsElapsed() / 1000);
+        if (remainingUsecs <= 0) {
+            return false;
+        }
+
+        // SDL has no blocking wait for joystick events without the video subsystem on the main thread, so the device
+        // is polled. While the stick is being moved a 1 ms poll keeps input latency low. Once it is idle, sleep until
+        // the next send instead.
+        if (_lastInputTimer.isValid() && _lastInputTimer.elapsed() < _activePollMsecs) {
+            remainingUsecs = qMin(remainingUsecs, (qint64)1000);
+        }
+        QGC::SLEEP::usleep(remainingUsecs);
+    }
+}
+
 bool JoystickSDL::_getButton(int i) {
     if ( _isGameController ) {
         return !!SDL_GameControllerGetButton(sdlController, SDL_GameControllerButton(i));
@@ -7,6 +7,8 @@
 
 #include <SDL.h>
 
+#include <QElapsedTimer>
+
 class JoystickSDL : public Joystick
 {
 public:
@@ -31,11 +33,15 @@ private:
     bool _getButton(int i) final;
     int _getAxis(int i) final;
     uint8_t _getHat(int hat,int i) final;
+    bool _waitForInput(int timeoutUsecs) final;
 
     SDL_Joystick *sdlJoystick;
     SDL_GameController *sdlController;
     bool    _isGameController;
     int     _index;      ///< Index for SDL_JoystickOpen
+    QElapsedTimer _lastInputTimer;  ///< Time since the last input event, invalid before the first one
+
+    static const int _activePollMsecs = 500;    ///< Poll at 1 ms for this long after the last input
 
 };
 
@@ -32,7 +32,7 @@ CameraCalc::CameraCalc(Vehicle* vehicle, QObject* parent)
     , _cameraName                   (manualCameraName())
     , _disableRecalc                (false)
     , _distanceToSurfaceRelative    (true)
-    , _metaDataMap                  (FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/CameraCalc.FactMetaData.json"), this))
+    , _metaDataMap                  (FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/CameraCalc.FactMetaData.json")))
     , _valueSetIsDistanceFact       (0, _valueSetIsDistanceName,        FactMetaData::valueTypeBool)
     , _distanceToSurfaceFact        (0, _distanceToSurfaceName,         FactMetaData::valueTypeDouble)
     , _imageDensityFact             (0, _imageDensityName,              FactMetaData::valueTypeDouble)
@@ -24,7 +24,7 @@ const char* CameraSpec::_minTriggerIntervalName =   "MinTriggerInterval";
 CameraSpec::CameraSpec(QObject* parent)
     : QObject                   (parent)
     , _dirty                    (false)
-    , _metaDataMap              (FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/CameraSpec.FactMetaData.json"), this))
+    , _metaDataMap              (FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/CameraSpec.FactMetaData.json")))
     , _sensorWidthFact          (0, _sensorWidthName,           FactMetaData::valueTypeDouble)
     , _sensorHeightFact         (0, _sensorHeightName,          FactMetaData::valueTypeDouble)
     , _imageWidthFact           (0, _imageWidthName,            FactMetaData::valueTypeUint32)
@@ -40,7 +40,7 @@ CameraSpec::CameraSpec(QObject* parent)
 CameraSpec::CameraSpec(const CameraSpec& other, QObject* parent)
     : QObject                   (parent)
     , _dirty                    (false)
-    , _metaDataMap              (FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/CameraSpec.FactMetaData.json"), this))
+    , _metaDataMap              (FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/CameraSpec.FactMetaData.json")))
     , _sensorWidthFact          (0, _sensorWidthName,           FactMetaData::valueTypeDouble)
     , _sensorHeightFact         (0, _sensorHeightName,          FactMetaData::valueTypeDouble)
     , _imageWidthFact           (0, _imageWidthName,            FactMetaData::valueTypeUint32)
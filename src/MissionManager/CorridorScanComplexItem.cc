@@ -31,7 +31,7 @@ CorridorScanComplexItem::CorridorScanComplexItem(Vehicle* vehicle, QObject* pare
     : TransectStyleComplexItem  (vehicle, settingsGroup, parent)
     , _ignoreRecalc             (false)
     , _entryPoint               (0)
-    , _metaDataMap              (FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/CorridorScan.SettingsGroup.json"), this))
+    , _metaDataMap              (FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/CorridorScan.SettingsGroup.json")))
     , _corridorWidthFact        (settingsGroup, _metaDataMap[corridorWidthName])
 {
     _editorQml = "qrc:/qml/CorridorScanEditor.qml";
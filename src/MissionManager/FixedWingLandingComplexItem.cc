@@ -41,7 +41,7 @@ FixedWingLandingComplexItem::FixedWingLandingComplexItem(Vehicle* vehicle, QObje
     , _dirty                    (false)
     , _landingCoordSet          (false)
     , _ignoreRecalcSignals      (false)
-    , _metaDataMap              (FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/FWLandingPattern.FactMetaData.json"), this))
+    , _metaDataMap              (FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/FWLandingPattern.FactMetaData.json")))
     , _landingDistanceFact      (_metaDataMap[loiterToLandDistanceName])
     , _loiterAltitudeFact       (_metaDataMap[loiterAltitudeName])
     , _loiterRadiusFact         (_metaDataMap[loiterRadiusName])
@@ -15,6 +15,7 @@
 #include "QGroundControlQmlGlobal.h"
 #include "JsonHelper.h"
 #include "MissionCommandUIInfo.h"
+#include "QGCStartupProfiler.h"
 
 #include <QStringList>
 #include <QJsonDocument>
@@ -39,6 +40,7 @@ void MissionCommandList::_loadMavCmdInfoJson(const QString& jsonFilename, bool b
     }
 
     qCDebug(MissionCommandsLog) << "Loading" << jsonFilename;
+    QGCStartupTimer startupTimer("load", jsonFilename);
 
     QFile jsonFile(jsonFilename);
     if (!jsonFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
@@ -0,0 +1,251 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MissionCommandTable.h"
+#include "MissionCommandUIInfo.h"
+
+#include <QtEndian>
+#include <QDebug>
+
+#include <string.h>
+
+#ifndef QGC_DISABLE_MISSION_COMMAND_TABLE
+// Generated by tools/generate_mission_command_table.py
+extern const unsigned char  qgcMissionCommandTable[];
+extern const unsigned int   qgcMissionCommandTableSize;
+#endif
+
+const char MissionCommandTable::magic[4] = { 'Q', 'M', 'C', 'T' };
+
+const MissionCommandTable* MissionCommandTable::instance(void)
+{
+#ifdef QGC_DISABLE_MISSION_COMMAND_TABLE
+    static const MissionCommandTable table(NULL, 0);
+#else
+    static const MissionCommandTable table(qgcMissionCommandTable, qgcMissionCommandTableSize);
+#endif
+    return &table;
+}
+
+MissionCommandTable::MissionCommandTable(const uchar* data, uint size)
+    : _data(data)
+    , _size(size)
+    , _valid(false)
+    , _tableCount(0)
+{
+    if (!_data) {
+        return;
+    }
+
+    if (!_validRange(0, _cbHeader) || memcmp(_data, magic, sizeof(magic)) != 0 || _uint32(4) != (quint32)version) {
+        qWarning() << "MissionCommandTable: bad header";
+        return;
+    }
+
+    quint32 tableCount = _uint32(8);
+    if (!_validRange(_cbHeader, tableCount * _cbTable)) {
+        qWarning() << "MissionCommandTable: bad table count" << tableCount;
+        return;
+    }
+    for (quint32 i=0; i<tableCount; i++) {
+        quint32 tableOffset = _cbHeader + (i * _cbTable);
+        if (!_validRange(_uint32(tableOffset + 8), _uint32(tableOffset + 4) * _cbCommand)) {
+            qWarning() << "MissionCommandTable: bad table" << i;
+            return;
+        }
+    }
+
+    _tableCount = tableCount;
+    _valid = true;
+}
+
+bool MissionCommandTable::_validRange(quint32 offset, quint32 size) const
+{
+    return offset <= _size && size <= _size - offset;
+}
+
+quint32 MissionCommandTable::_uint32(quint32 offset) const
+{
+    return qFromLittleEndian<quint32>(_data + offset);
+}
+
+double MissionCommandTable::_double(quint32 offset) const
+{
+    quint64 bits = qFromLittleEndian<quint64>(_data + offset);
+    double  value;
+
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+QString MissionCommandTable::_string(quint32 offset) const
+{
+    return QString::fromUtf8((const char*)_data + offset + 4, _uint32(offset));
+}
+
+int MissionCommandTable::findTable(const QStringList& sources) const
+{
+    QString joinedSources = sources.join(QLatin1Char(';'));
+
+    for (int i=0; i<_tableCount; i++) {
+        if (_string(_uint32(_cbHeader + (i * _cbTable))) == joinedSources) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+QStringList MissionCommandTable::tableSources(int table) const
+{
+    return _string(_uint32(_cbHeader + (table * _cbTable))).split(QLatin1Char(';'));
+}
+
+QList<MAV_CMD> MissionCommandTable::commandIds(int table) const
+{
+    QList<MAV_CMD>  ids;
+    quint32         tableOffset =       _cbHeader + (table * _cbTable);
+    quint32         commandCount =      _uint32(tableOffset + 4);
+    quint32         commandsOffset =    _uint32(tableOffset + 8);
+
+    ids.reserve(commandCount);
+    for (quint32 i=0; i<commandCount; i++) {
+        ids.append((MAV_CMD)_uint32(commandsOffset + (i * _cbCommand)));
+    }
+
+    return ids;
+}
+
+const uchar* MissionCommandTable::_command(int table, MAV_CMD command) const
+{
+    quint32 tableOffset =       _cbHeader + (table * _cbTable);
+    quint32 commandsOffset =    _uint32(tableOffset + 8);
+    int     low =               0;
+    int     high =              (int)_uint32(tableOffset + 4) - 1;
+
+    while (low <= high) {
+        int     middle =    (low + high) / 2;
+        quint32 offset =    commandsOffset + (middle * _cbCommand);
+        quint32 id =        _uint32(offset);
+
+        if (id == (quint32)command) {
+            return _data + offset;
+        } else if (id < (quint32)command) {
+            low = middle + 1;
+        } else {
+            high = middle - 1;
+        }
+    }
+
+    return NULL;
+}
+
+QString MissionCommandTable::category(int table, MAV_CMD command) const
+{
+    const uchar* record = _command(table, command);
+
+    if (record && (qFromLittleEndian<quint32>(record + 4) & hasCategoryFlag)) {
+        return _string(qFromLittleEndian<quint32>(record + 8));
+    } else {
+        return MissionCommandUIInfo::_advancedCategory;
+    }
+}
+
+QString MissionCommandTable::rawName(int table, MAV_CMD command) const
+{
+    const uchar* record = _command(table, command);
+
+    if (record && (qFromLittleEndian<quint32>(record + 4) & hasRawNameFlag)) {
+        return _string(qFromLittleEndian<quint32>(record + 12));
+    } else {
+        return QString();
+    }
+}
+
+QString MissionCommandTable::friendlyName(int table, MAV_CMD command) const
+{
+    const uchar* record = _command(table, command);
+
+    if (record && (qFromLittleEndian<quint32>(record + 4) & hasFriendlyNameFlag)) {
+        return _string(qFromLittleEndian<quint32>(record + 16));
+    } else {
+        return QString();
+    }
+}
+
+MissionCommandUIInfo* MissionCommandTable::createUIInfo(int table, MAV_CMD command, QObject* parent) const
+{
+    const uchar* record = _command(table, command);
+    if (!record) {
+        return NULL;
+    }
+
+    quint32 flags =         qFromLittleEndian<quint32>(record + 4);
+    quint32 paramBits =     qFromLittleEndian<quint32>(record + 24);
+    quint32 paramOffset =   qFromLittleEndian<quint32>(record + 28);
+
+    MissionCommandUIInfo* uiInfo = new MissionCommandUIInfo(parent);
+    uiInfo->_command = command;
+
+    if (flags & hasCategoryFlag) {
+        uiInfo->_setInfoValue(MissionCommandUIInfo::_categoryJsonKey, _string(qFromLittleEndian<quint32>(record + 8)));
+    }
+    if (flags & hasRawNameFlag) {
+        uiInfo->_setInfoValue(MissionCommandUIInfo::_rawNameJsonKey, _string(qFromLittleEndian<quint32>(record + 12)));
+    }
+    if (flags & hasFriendlyNameFlag) {
+        uiInfo->_setInfoValue(MissionCommandUIInfo::_friendlyNameJsonKey, _string(qFromLittleEndian<quint32>(record + 16)));
+    }
+    if (flags & hasDescriptionFlag) {
+        uiInfo->_setInfoValue(MissionCommandUIInfo::_descriptionJsonKey, _string(qFromLittleEndian<quint32>(record + 20)));
+    }
+    if (flags & hasStandaloneCoordinateFlag) {
+        uiInfo->_setInfoValue(MissionCommandUIInfo::_standaloneCoordinateJsonKey, (bool)(flags & standaloneCoordinateFlag));
+    }
+    if (flags & hasSpecifiesCoordinateFlag) {
+        uiInfo->_setInfoValue(MissionCommandUIInfo::_specifiesCoordinateJsonKey, (bool)(flags & specifiesCoordinateFlag));
+    }
+    if (flags & hasSpecifiesAltitudeOnlyFlag) {
+        uiInfo->_setInfoValue(MissionCommandUIInfo::_specifiesAltitudeOnlyJsonKey, (bool)(flags & specifiesAltitudeOnlyFlag));
+    }
+    if (flags & hasFriendlyEditFlag) {
+        uiInfo->_setInfoValue(MissionCommandUIInfo::_friendlyEditJsonKey, (bool)(flags & friendlyEditFlag));
+    }
+
+    for (int i=1; i<=7; i++) {
+        if (paramBits & (1 << (i + 7))) {
+            uiInfo->_paramRemoveList.append(i);
+        }
+        if (!(paramBits & (1 << (i - 1)))) {
+            continue;
+        }
+
+        MissionCmdParamInfo* paramInfo = new MissionCmdParamInfo(uiInfo);
+
+        paramInfo->_param =         i;
+        paramInfo->_defaultValue =  _double(paramOffset);
+        paramInfo->_label =         _string(_uint32(paramOffset + 8));
+        paramInfo->_units =         _string(_uint32(paramOffset + 12));
+        paramInfo->_decimalPlaces = (qint32)_uint32(paramOffset + 16);
+        paramInfo->_nanUnchanged =  _uint32(paramOffset + 20) != 0;
+
+        quint32 enumCount =         _uint32(paramOffset + 24);
+        quint32 enumStringsOffset = _uint32(paramOffset + 28);
+        quint32 enumValuesOffset =  _uint32(paramOffset + 32);
+        for (quint32 j=0; j<enumCount; j++) {
+            paramInfo->_enumStrings.append(_string(_uint32(enumStringsOffset + (j * 4))));
+            paramInfo->_enumValues.append(QVariant(_double(enumValuesOffset + (j * 8))));
+        }
+
+        uiInfo->_paramInfoMap[i] = paramInfo;
+        paramOffset += _cbParam;
+    }
+
+    return uiInfo;
+}
@@ -0,0 +1,106 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef MissionCommandTable_H
+#define MissionCommandTable_H
+
+#include "QGCMAVLink.h"
+
+#include <QObject>
+#include <QStringList>
+
+class MissionCommandUIInfo;
+
+/// Read only access to the precompiled mission command tables.
+///
+/// tools/generate_mission_command_table.py collapses the MavCmdInfo json hierarchy for every firmware/vehicle type at build time
+/// into a single binary table which is compiled into the executable. Using it costs no parsing and no allocations: records are
+/// read in place and MissionCommandUIInfo objects are only created for the commands which are asked for.
+///
+/// Each table is identified by the resource names of the json files it was collapsed from, so a firmware plugin which returns
+/// other override files does not match any table and MissionCommandTree falls back to loading the json.
+///
+/// Layout, little endian, offsets are from the start of the data:
+///     Header      magic "QMCT", u32 version, u32 table count, u32 reserved
+///     Table       u32 sources string, u32 command count, u32 offset of first command
+///     Command     u32 id, u32 flags, u32 category/rawName/friendlyName/description strings, u32 param bits, u32 offset of first param
+///     Param       f64 default, u32 label/units strings, i32 decimal places, u32 nanUnchanged, u32 enum count,
+///                 u32 offset of enum string offsets, u32 offset of enum values (f64), u32 reserved
+///     String      u32 length, utf8
+/// Commands are sorted by id. Param bits 0-6 are set for available params 1-7, bits 8-14 for removed params 1-7.
+class MissionCommandTable
+{
+public:
+    /// @return Table compiled into the executable, not valid if the table generation was disabled in the build
+    static const MissionCommandTable* instance(void);
+
+    MissionCommandTable(const uchar* data, uint size);
+
+    bool isValid(void) const { return _valid; }
+
+    /// @param sources Resource names of the json files from the bottom to the top of the hierarchy
+    /// @return Index of the table which was collapsed from the specified json files, -1 for none
+    int findTable(const QStringList& sources) const;
+
+    /// @return Sources of the specified table
+    QStringList tableSources(int table) const;
+
+    int tableCount(void) const { return _tableCount; }
+
+    /// @return Ids of all commands in the table, sorted
+    QList<MAV_CMD> commandIds(int table) const;
+
+    bool contains(int table, MAV_CMD command) const { return _command(table, command) != NULL; }
+
+    /// @return Category of the command, same as MissionCommandUIInfo::category
+    QString category(int table, MAV_CMD command) const;
+
+    QString rawName     (int table, MAV_CMD command) const;
+    QString friendlyName(int table, MAV_CMD command) const;
+
+    /// Creates the ui info for the specified command
+    ///     @param parent Owner of the new object
+    /// @return NULL if the command is not in the table
+    MissionCommandUIInfo* createUIInfo(int table, MAV_CMD command, QObject* parent) const;
+
+    static const char   magic[4];
+    static const int    version = 1;
+
+    static const int    hasCategoryFlag =               1 << 0;
+    static const int    hasRawNameFlag =                1 << 1;
+    static const int    hasFriendlyNameFlag =           1 << 2;
+    static const int    hasDescriptionFlag =            1 << 3;
+    static const int    hasStandaloneCoordinateFlag =   1 << 4;
+    static const int    hasSpecifiesCoordinateFlag =    1 << 5;
+    static const int    hasSpecifiesAltitudeOnlyFlag =  1 << 6;
+    static const int    hasFriendlyEditFlag =           1 << 7;
+    static const int    standaloneCoordinateFlag =      1 << 8;
+    static const int    specifiesCoordinateFlag =       1 << 9;
+    static const int    specifiesAltitudeOnlyFlag =     1 << 10;
+    static const int    friendlyEditFlag =              1 << 11;
+
+private:
+    const uchar*    _command    (int table, MAV_CMD command) const;
+    quint32         _uint32     (quint32 offset) const;
+    double          _double     (quint32 offset) const;
+    QString         _string     (quint32 offset) const;
+    bool            _validRange (quint32 offset, quint32 size) const;
+
+    static const int _cbHeader =    16;
+    static const int _cbTable =     12;
+    static const int _cbCommand =   32;
+    static const int _cbParam =     40;
+
+    const uchar*    _data;
+    uint            _size;
+    bool            _valid;
+    int             _tableCount;
+};
+
+#endif
@@ -17,15 +17,19 @@
 #include "QGroundControlQmlGlobal.h"
 #include "MissionCommandUIInfo.h"
 #include "MissionCommandList.h"
+#include "MissionCommandTable.h"
 #include "SettingsManager.h"
 
 #include <QQmlEngine>
 
+#include <algorithm>
+
 MissionCommandTree::MissionCommandTree(QGCApplication* app, QGCToolbox* toolbox, bool unitTest)
     : QGCTool(app, toolbox)
     , _allCommandsCategory(tr("All commands"))
     , _settingsManager(NULL)
     , _unitTest(unitTest)
+    , _baseTable(-1)
 {
 }
 
@@ -37,16 +41,16 @@ void MissionCommandTree::setToolbox(QGCToolbox* toolbox)
 
 #ifdef UNITTEST_BUILD
     if (_unitTest) {
-        // Load unit testing tree
-        _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_GENERIC] =           new MissionCommandList(":/unittest/MavCmdInfoCommon.json", true, this);
-        _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_FIXED_WING] =        new MissionCommandList(":/unittest/MavCmdInfoFixedWing.json", false, this);
-        _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_QUADROTOR] =         new MissionCommandList(":/unittest/MavCmdInfoMultiRotor.json", false, this);
-        _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_VTOL_QUADROTOR] =    new MissionCommandList(":/unittest/MavCmdInfoVTOL.json", false, this);
-        _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_SUBMARINE] =         new MissionCommandList(":/unittest/MavCmdInfoSub.json", false, this);
-        _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_GROUND_ROVER] =      new MissionCommandList(":/unittest/MavCmdInfoRover.json", false, this);
+        // Unit testing tree
+        _overrideFiles[MAV_AUTOPILOT_GENERIC][MAV_TYPE_GENERIC] =           QStringLiteral(":/unittest/MavCmdInfoCommon.json");
+        _overrideFiles[MAV_AUTOPILOT_GENERIC][MAV_TYPE_FIXED_WING] =        QStringLiteral(":/unittest/MavCmdInfoFixedWing.json");
+        _overrideFiles[MAV_AUTOPILOT_GENERIC][MAV_TYPE_QUADROTOR] =         QStringLiteral(":/unittest/MavCmdInfoMultiRotor.json");
+        _overrideFiles[MAV_AUTOPILOT_GENERIC][MAV_TYPE_VTOL_QUADROTOR] =    QStringLiteral(":/unittest/MavCmdInfoVTOL.json");
+        _overrideFiles[MAV_AUTOPILOT_GENERIC][MAV_TYPE_SUBMARINE] =         QStringLiteral(":/unittest/MavCmdInfoSub.json");
+        _overrideFiles[MAV_AUTOPILOT_GENERIC][MAV_TYPE_GROUND_ROVER] =      QStringLiteral(":/unittest/MavCmdInfoRover.json");
     } else {
 #endif
-        // Load all levels of hierarchy
+        // Json files for all levels of hierarchy, they are only loaded if there is no precompiled table
         foreach (MAV_AUTOPILOT firmwareType, _toolbox->firmwarePluginManager()->supportedFirmwareTypes()) {
             FirmwarePlugin* plugin = _toolbox->firmwarePluginManager()->firmwarePluginForAutopilot(firmwareType, MAV_TYPE_QUADROTOR);
 
@@ -56,13 +60,62 @@ void MissionCommandTree::setToolbox(QGCToolbox* toolbox)
             foreach(MAV_TYPE vehicleType, vehicleTypes) {
                 QString overrideFile = plugin->missionCommandOverrides(vehicleType);
                 if (!overrideFile.isEmpty()) {
-                    _staticCommandTree[firmwareType][vehicleType] = new MissionCommandList(overrideFile, firmwareType == MAV_AUTOPILOT_GENERIC && vehicleType == MAV_TYPE_GENERIC /* baseCommandList */, this);
+                    _overrideFiles[firmwareType][vehicleType] = overrideFile;
                 }
             }
         }
 #ifdef UNITTEST_BUILD
     }
 #endif
+
+    _baseTable = MissionCommandTable::instance()->findTable(_hierarchySources(MAV_AUTOPILOT_GENERIC, MAV_TYPE_GENERIC));
+    if (_baseTable == -1) {
+        _allCommandIds = _commandList(MAV_AUTOPILOT_GENERIC, MAV_TYPE_GENERIC)->commandIds();
+    } else {
+        _allCommandIds = MissionCommandTable::instance()->commandIds(_baseTable);
+    }
+}
+
+/// Returns the command list for the specified level of the hierarchy, loading it if needed
+///     @return NULL if there is no json file for the level
+MissionCommandList* MissionCommandTree::_commandList(MAV_AUTOPILOT firmwareType, MAV_TYPE vehicleType)
+{
+    if (!_staticCommandTree[firmwareType].contains(vehicleType)) {
+        QString overrideFile = _overrideFiles[firmwareType].value(vehicleType);
+        _staticCommandTree[firmwareType][vehicleType] = overrideFile.isEmpty() ?
+                    NULL :
+                    new MissionCommandList(overrideFile, firmwareType == MAV_AUTOPILOT_GENERIC && vehicleType == MAV_TYPE_GENERIC /* baseCommandList */, this);
+    }
+
+    return _staticCommandTree[firmwareType][vehicleType];
+}
+
+/// Returns the json files which make up the collapsed hierarchy for the specified firmware and vehicle type, from the bottom to the top
+QStringList MissionCommandTree::_hierarchySources(MAV_AUTOPILOT baseFirmwareType, MAV_TYPE baseVehicleType) const
+{
+    QStringList sources;
+
+    // Any Firmware, Any Vehicle
+    sources << _overrideFiles[MAV_AUTOPILOT_GENERIC].value(MAV_TYPE_GENERIC);
+
+    // Any Firmware, Specific Vehicle
+    if (baseVehicleType != MAV_TYPE_GENERIC) {
+        sources << _overrideFiles[MAV_AUTOPILOT_GENERIC].value(baseVehicleType);
+    }
+
+    // Known Firmware, Any Vehicle
+    if (baseFirmwareType != MAV_AUTOPILOT_GENERIC) {
+        sources << _overrideFiles[baseFirmwareType].value(MAV_TYPE_GENERIC);
+
+        // Known Firmware, Specific Vehicle
+        if (baseVehicleType != MAV_TYPE_GENERIC) {
+            sources << _overrideFiles[baseFirmwareType].value(baseVehicleType);
+        }
+    }
+
+    sources.removeAll(QString());
+
+    return sources;
 }
 
 MAV_AUTOPILOT MissionCommandTree::_baseFirmwareType(MAV_AUTOPILOT firmwareType) const
@@ -105,12 +158,12 @@ void MissionCommandTree::_collapseHierarchy(Vehicle*
 
     _baseVehicleInfo(vehicle, baseFirmwareType, baseVehicleType);
 
+    if (!cmdList) {
+        return;
+    }
+
     foreach (MAV_CMD command, cmdList->commandIds()) {
-        // Only add supported command to tree (MAV_CMD_NAV_LAST is used for planned home position)
-        if (!qgcApp()->runningUnitTests()
-                && !vehicle->firmwarePlugin()->supportedMissionCommands().isEmpty()
-                && !vehicle->firmwarePlugin()->supportedMissionCommands().contains(command)
-                && command != MAV_CMD_NAV_LAST) {
+        if (!_isSupportedCommand(vehicle, command)) {
             continue;
         }
 
@@ -125,6 +178,15 @@ void MissionCommandTree::_collapseHierarchy(Vehicle*
     }
 }
 
+/// Only supported commands are added to the tree (MAV_CMD_NAV_LAST is used for planned home position)
+bool MissionCommandTree::_isSupportedCommand(Vehicle* vehicle, MAV_CMD command) const
+{
+    return qgcApp()->runningUnitTests()
+            || vehicle->firmwarePlugin()->supportedMissionCommands().isEmpty()
+            || vehicle->firmwarePlugin()->supportedMissionCommands().contains(command)
+            || command == MAV_CMD_NAV_LAST;
+}
+
 void MissionCommandTree::_buildAvailableCommands(Vehicle* vehicle)
 {
     MAV_AUTOPILOT   baseFirmwareType;
@@ -132,44 +194,97 @@ void MissionCommandTree::_buildAvailableCommands(Vehicle* vehicle)
 
     _baseVehicleInfo(vehicle, baseFirmwareType, baseVehicleType);
 
-    if (_availableCommands.contains(baseFirmwareType) &&
-            _availableCommands[baseFirmwareType].contains(baseVehicleType)) {
+    if (_availableCommandIds.contains(baseFirmwareType) &&
+            _availableCommandIds[baseFirmwareType].contains(baseVehicleType)) {
         // Available commands list already built
         return;
     }
 
     // Build new available commands list
 
-    QMap<MAV_CMD, MissionCommandUIInfo*>& collapsedTree = _availableCommands[baseFirmwareType][baseVehicleType];
+    const MissionCommandTable*  table =         MissionCommandTable::instance();
+    QStringList                 sources =       _hierarchySources(baseFirmwareType, baseVehicleType);
+    int                         tableIndex =    table->findTable(sources);
+    QList<MAV_CMD>&             commandIds =    _availableCommandIds[baseFirmwareType][baseVehicleType];
 
-    // Any Firmware, Any Vehicle
-    _collapseHierarchy(vehicle, _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_GENERIC], collapsedTree);
+    _availableTables[baseFirmwareType][baseVehicleType] = tableIndex;
 
-    // Any Firmware, Specific Vehicle
-    if (baseVehicleType != MAV_TYPE_GENERIC) {
-        _collapseHierarchy(vehicle, _staticCommandTree[MAV_AUTOPILOT_GENERIC][baseVehicleType], collapsedTree);
-    }
+    if (tableIndex == -1) {
+        qCDebug(MissionCommandsLog) << "No precompiled table, loading" << sources;
 
-    // Known Firmware, Any Vehicle
-    if (baseFirmwareType != MAV_AUTOPILOT_GENERIC) {
-        _collapseHierarchy(vehicle, _staticCommandTree[baseFirmwareType][MAV_TYPE_GENERIC], collapsedTree);
+        QMap<MAV_CMD, MissionCommandUIInfo*>& collapsedTree = _availableCommands[baseFirmwareType][baseVehicleType];
 
-        // Known Firmware, Specific Vehicle
+        // Any Firmware, Any Vehicle
+        _collapseHierarchy(vehicle, _commandList(MAV_AUTOPILOT_GENERIC, MAV_TYPE_GENERIC), collapsedTree);
+
+        // Any Firmware, Specific Vehicle
         if (baseVehicleType != MAV_TYPE_GENERIC) {
-            _collapseHierarchy(vehicle, _staticCommandTree[baseFirmwareType][baseVehicleType], collapsedTree);
+            _collapseHierarchy(vehicle, _commandList(MAV_AUTOPILOT_GENERIC, baseVehicleType), collapsedTree);
+        }
+
+        // Known Firmware, Any Vehicle
+        if (baseFirmwareType != MAV_AUTOPILOT_GENERIC) {
+            _collapseHierarchy(vehicle, _commandList(baseFirmwareType, MAV_TYPE_GENERIC), collapsedTree);
+
+            // Known Firmware, Specific Vehicle
+            if (baseVehicleType != MAV_TYPE_GENERIC) {
+                _collapseHierarchy(vehicle, _commandList(baseFirmwareType, baseVehicleType), collapsedTree);
+            }
+        }
+
+        commandIds = collapsedTree.keys();
+    } else {
+        // Ui info is created as commands are requested
+        foreach (MAV_CMD command, table->commandIds(tableIndex)) {
+            if (_isSupportedCommand(vehicle, command)) {
+                commandIds.append(command);
+            }
         }
     }
 
     // Build category list
-    QMapIterator<MAV_CMD, MissionCommandUIInfo*> iter(collapsedTree);
-    while (iter.hasNext()) {
-        iter.next();
-        QString newCategory = iter.value()->category();
-        if (!_availableCategories[baseFirmwareType][baseVehicleType].contains(newCategory)) {
-            _availableCategories[baseFirmwareType][baseVehicleType].append(newCategory);
+    QStringList& categories = _availableCategories[baseFirmwareType][baseVehicleType];
+    foreach (MAV_CMD command, commandIds) {
+        QString newCategory = _category(baseFirmwareType, baseVehicleType, command);
+        if (!categories.contains(newCategory)) {
+            categories.append(newCategory);
         }
     }
-    _availableCategories[baseFirmwareType][baseVehicleType].append(_allCommandsCategory);
+    categories.append(_allCommandsCategory);
+}
+
+/// Returns the category of an available command without creating its ui info
+QString MissionCommandTree::_category(MAV_AUTOPILOT baseFirmwareType, MAV_TYPE baseVehicleType, MAV_CMD command) const
+{
+    int tableIndex = _availableTables[baseFirmwareType][baseVehicleType];
+
+    if (tableIndex == -1) {
+        return _availableCommands[baseFirmwareType][baseVehicleType][command]->category();
+    } else {
+        return MissionCommandTable::instance()->category(tableIndex, command);
+    }
+}
+
+/// Returns the ui info for an available command, creating it from the precompiled table if needed
+///     @return NULL if the command is not available
+MissionCommandUIInfo* MissionCommandTree::_uiInfo(MAV_AUTOPILOT baseFirmwareType, MAV_TYPE baseVehicleType, MAV_CMD command)
+{
+    QMap<MAV_CMD, MissionCommandUIInfo*>& infoMap = _availableCommands[baseFirmwareType][baseVehicleType];
+
+    if (infoMap.contains(command)) {
+        return infoMap[command];
+    }
+
+    const QList<MAV_CMD>&   commandIds =    _availableCommandIds[baseFirmwareType][baseVehicleType];
+    int                     tableIndex =    _availableTables[baseFirmwareType][baseVehicleType];
+    if (tableIndex == -1 || !std::binary_search(commandIds.constBegin(), commandIds.constEnd(), command)) {
+        return NULL;
+    }
+
+    MissionCommandUIInfo* uiInfo = MissionCommandTable::instance()->createUIInfo(tableIndex, command, this);
+    infoMap[command] = uiInfo;
+
+    return uiInfo;
 }
 
 QStringList MissionCommandTree::_availableCategoriesForVehicle(Vehicle* vehicle)
@@ -185,31 +300,43 @@ QStringList MissionCommandTree::_availableCategoriesForVehicle(Vehicle* vehicle)
 
 QString MissionCommandTree::friendlyName(MAV_CMD command)
 {
-    MissionCommandList *    commandList =   _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_GENERIC];
-    MissionCommandUIInfo*   uiInfo =        commandList->getUIInfo(command);
+    const MissionCommandTable* table = MissionCommandTable::instance();
 
-    if (uiInfo) {
-        return uiInfo->friendlyName();
+    if (_baseTable != -1) {
+        if (table->contains(_baseTable, command)) {
+            return table->friendlyName(_baseTable, command);
+        }
     } else {
-        return QString("MAV_CMD(%1)").arg((int)command);
+        MissionCommandUIInfo* uiInfo = _commandList(MAV_AUTOPILOT_GENERIC, MAV_TYPE_GENERIC)->getUIInfo(command);
+        if (uiInfo) {
+            return uiInfo->friendlyName();
+        }
     }
+
+    return QString("MAV_CMD(%1)").arg((int)command);
 }
 
 QString MissionCommandTree::rawName(MAV_CMD command)
 {
-    MissionCommandList *    commandList =   _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_GENERIC];
-    MissionCommandUIInfo*   uiInfo =        commandList->getUIInfo(command);
+    const MissionCommandTable* table = MissionCommandTable::instance();
 
-    if (uiInfo) {
-        return uiInfo->rawName();
+    if (_baseTable != -1) {
+        if (table->contains(_baseTable, command)) {
+            return table->rawName(_baseTable, command);
+        }
     } else {
-        return QString("MAV_CMD(%1)").arg((int)command);
+        MissionCommandUIInfo* uiInfo = _commandList(MAV_AUTOPILOT_GENERIC, MAV_TYPE_GENERIC)->getUIInfo(command);
+        if (uiInfo) {
+            return uiInfo->rawName();
+        }
     }
+
+    return QString("MAV_CMD(%1)").arg((int)command);
 }
 
 const QList<MAV_CMD>& MissionCommandTree::allCommandIds(void) const
 {
-    return _staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_GENERIC]->commandIds();
+    return _allCommandIds;
 }
 
 const MissionCommandUIInfo* MissionCommandTree::getUIInfo(Vehicle* vehicle, MAV_CMD command)
@@ -220,12 +347,7 @@ const MissionCommandUIInfo* MissionCommandTree::getUIInfo(Vehicle* vehicle, MAV_
     _baseVehicleInfo(vehicle, baseFirmwareType, baseVehicleType);
     _buildAvailableCommands(vehicle);
 
-    const QMap<MAV_CMD, MissionCommandUIInfo*>& infoMap = _availableCommands[baseFirmwareType][baseVehicleType];
-    if (infoMap.contains(command)) {
-        return infoMap[command];
-    } else {
-        return NULL;
-    }
+    return _uiInfo(baseFirmwareType, baseVehicleType, command);
 }
 
 QVariantList MissionCommandTree::getCommandsForCategory(Vehicle* vehicle, const QString& category)
@@ -236,12 +358,11 @@ QVariantList MissionCommandTree::getCommandsForCategory(Vehicle* vehicle, const
     _baseVehicleInfo(vehicle, baseFirmwareType, baseVehicleType);
     _buildAvailableCommands(vehicle);
 
+    // Ui info is only created for the commands in the category
     QVariantList list;
-    QMap<MAV_CMD, MissionCommandUIInfo*> commandMap = _availableCommands[baseFirmwareType][baseVehicleType];
-    foreach (MAV_CMD command, commandMap.keys()) {
-        MissionCommandUIInfo* uiInfo = commandMap[command];
-        if (uiInfo->category() == category || category == _allCommandsCategory) {
-            list.append(QVariant::fromValue(uiInfo));
+    foreach (MAV_CMD command, _availableCommandIds[baseFirmwareType][baseVehicleType]) {
+        if (category == _allCommandsCategory || _category(baseFirmwareType, baseVehicleType, command) == category) {
+            list.append(QVariant::fromValue(_uiInfo(baseFirmwareType, baseVehicleType, command)));
         }
     }
 
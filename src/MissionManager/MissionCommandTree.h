@@ -40,8 +40,10 @@ class MissionCommandTreeTest;
 ///             Known Firmware, Sub
 /// For known firmwares, the override files are requested from the FirmwarePlugin.
 ///
-/// When ui info is requested for a specific vehicle the static hierarchy in _staticCommandTree is collapsed into the set of available commands in
-/// _availableCommands taking into account the appropriate set of overrides for the MAV_AUTOPILOT/MAV_TYPE combination associated with the vehicle.
+/// When ui info is requested for a specific vehicle the static hierarchy is collapsed into the set of available commands taking into account the
+/// appropriate set of overrides for the MAV_AUTOPILOT/MAV_TYPE combination associated with the vehicle. If the build contains a precompiled
+/// table for the override files of the combination (see MissionCommandTable) the json is not loaded and the ui info for a command is only
+/// created when it is first requested. Otherwise the json files are loaded on demand and collapsed into _availableCommands.
 ///
 class MissionCommandTree : public QGCTool
 {
@@ -74,17 +76,32 @@ private:
     void _buildAvailableCommands(Vehicle* vehicle);
     QStringList _availableCategoriesForVehicle(Vehicle* vehicle);
     void _baseVehicleInfo(Vehicle* vehicle, MAV_AUTOPILOT& baseFirmwareType, MAV_TYPE& baseVehicleType) const;
+    bool _isSupportedCommand(Vehicle* vehicle, MAV_CMD command) const;
+    MissionCommandList* _commandList(MAV_AUTOPILOT firmwareType, MAV_TYPE vehicleType);
+    QStringList _hierarchySources(MAV_AUTOPILOT baseFirmwareType, MAV_TYPE baseVehicleType) const;
+    QString _category(MAV_AUTOPILOT baseFirmwareType, MAV_TYPE baseVehicleType, MAV_CMD command) const;
+    MissionCommandUIInfo* _uiInfo(MAV_AUTOPILOT baseFirmwareType, MAV_TYPE baseVehicleType, MAV_CMD command);
 
 private:
     QString             _allCommandsCategory;   ///< Category which contains all available commands
-    QList<int>          _allCommandIds;         ///< List of all known command ids (not vehicle specific)
+    QList<MAV_CMD>      _allCommandIds;         ///< List of all known command ids (not vehicle specific)
     SettingsManager*    _settingsManager;
     bool                _unitTest;              ///< true: running in unit test mode
+    int                 _baseTable;             ///< Precompiled table for Any Firmware, Any Vehicle, -1 if the json is used
 
-    /// Full hierarchy
+    /// Json file for each level of the hierarchy
+    QMap<MAV_AUTOPILOT, QMap<MAV_TYPE, QString>>                                _overrideFiles;
+
+    /// Full hierarchy, levels are loaded when a collapsed hierarchy without precompiled table needs them
     QMap<MAV_AUTOPILOT, QMap<MAV_TYPE, MissionCommandList*>>                    _staticCommandTree;
 
-    /// Collapsed hierarchy for specific vehicle type
+    /// Precompiled table for specific vehicle type, -1 if collapsed from the json
+    QMap<MAV_AUTOPILOT, QMap<MAV_TYPE, int>>                                    _availableTables;
+
+    /// Sorted ids of the available commands for specific vehicle type
+    QMap<MAV_AUTOPILOT, QMap<MAV_TYPE, QList<MAV_CMD>>>                         _availableCommandIds;
+
+    /// Collapsed hierarchy for specific vehicle type, only contains the commands requested so far when using a precompiled table
     QMap<MAV_AUTOPILOT, QMap<MAV_TYPE, QMap<MAV_CMD, MissionCommandUIInfo*>>>   _availableCommands;
 
     /// Collapsed hierarchy for specific vehicle type
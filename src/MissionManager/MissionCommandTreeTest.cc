@@ -11,6 +11,7 @@
 #include "QGCApplication.h"
 #include "MissionCommandUIInfo.h"
 #include "MissionCommandList.h"
+#include "MissionCommandTable.h"
 #include "FactMetaData.h"
 
 MissionCommandTreeTest::MissionCommandTreeTest(void)
@@ -142,7 +143,7 @@ void MissionCommandTreeTest::testJsonLoad(void)
     bool showUI;
 
     // Test loading from the bad command list
-    MissionCommandList* commandList = _commandTree->_staticCommandTree[MAV_AUTOPILOT_GENERIC][MAV_TYPE_GENERIC];
+    MissionCommandList* commandList = _commandTree->_commandList(MAV_AUTOPILOT_GENERIC, MAV_TYPE_GENERIC);
     QVERIFY(commandList != NULL);
 
     // Command 1 should have all values defaulted, no params
@@ -221,3 +222,75 @@ void MissionCommandTreeTest::testAllTrees(void)
 
 }
 
+/// Verifies that every precompiled table matches the json hierarchy it was generated from
+void MissionCommandTreeTest::testPrecompiledTables(void)
+{
+    const MissionCommandTable* table = MissionCommandTable::instance();
+    if (!table->isValid()) {
+        QSKIP("Build does not contain precompiled mission command tables");
+    }
+    QVERIFY(table->tableCount() > 0);
+
+    for (int tableIndex=0; tableIndex<table->tableCount(); tableIndex++) {
+        QObject     owner;
+        QStringList sources = table->tableSources(tableIndex);
+
+        // Collapse the json the same way as MissionCommandTree
+        QMap<MAV_CMD, MissionCommandUIInfo*> collapsedTree;
+        for (int i=0; i<sources.count(); i++) {
+            MissionCommandList* commandList = new MissionCommandList(sources[i], i == 0 /* baseCommandList */, &owner);
+            QVERIFY(!commandList->commandIds().isEmpty());
+            foreach (MAV_CMD command, commandList->commandIds()) {
+                if (collapsedTree.contains(command)) {
+                    collapsedTree[command]->_overrideInfo(commandList->getUIInfo(command));
+                } else {
+                    collapsedTree[command] = new MissionCommandUIInfo(*commandList->getUIInfo(command), &owner);
+                }
+            }
+        }
+
+        QCOMPARE(table->commandIds(tableIndex), collapsedTree.keys());
+
+        foreach (MAV_CMD command, collapsedTree.keys()) {
+            const MissionCommandUIInfo* jsonInfo = collapsedTree[command];
+            const MissionCommandUIInfo* tableInfo = table->createUIInfo(tableIndex, command, &owner);
+
+            QVERIFY(tableInfo);
+            QCOMPARE(tableInfo->command(), command);
+            QCOMPARE(tableInfo->_infoMap, jsonInfo->_infoMap);
+            QCOMPARE(table->category(tableIndex, command), jsonInfo->category());
+            QCOMPARE(table->rawName(tableIndex, command), jsonInfo->rawName());
+            QCOMPARE(table->friendlyName(tableIndex, command), jsonInfo->friendlyName());
+
+            for (int i=1; i<=7; i++) {
+                bool jsonShowUI, tableShowUI;
+                const MissionCmdParamInfo* jsonParamInfo = jsonInfo->getParamInfo(i, jsonShowUI);
+                const MissionCmdParamInfo* tableParamInfo = tableInfo->getParamInfo(i, tableShowUI);
+
+                QCOMPARE(tableShowUI, jsonShowUI);
+                QCOMPARE(tableParamInfo == NULL, jsonParamInfo == NULL);
+                if (jsonParamInfo) {
+                    QCOMPARE(tableParamInfo->param(), jsonParamInfo->param());
+                    QCOMPARE(tableParamInfo->label(), jsonParamInfo->label());
+                    QCOMPARE(tableParamInfo->units(), jsonParamInfo->units());
+                    QCOMPARE(tableParamInfo->decimalPlaces(), jsonParamInfo->decimalPlaces());
+                    QCOMPARE(tableParamInfo->nanUnchanged(), jsonParamInfo->nanUnchanged());
+                    QCOMPARE(tableParamInfo->enumStrings(), jsonParamInfo->enumStrings());
+                    QCOMPARE(tableParamInfo->enumValues(), jsonParamInfo->enumValues());
+                    if (qIsNaN(jsonParamInfo->defaultValue())) {
+                        QVERIFY(qIsNaN(tableParamInfo->defaultValue()));
+                    } else {
+                        QCOMPARE(tableParamInfo->defaultValue(), jsonParamInfo->defaultValue());
+                    }
+                }
+            }
+        }
+    }
+
+    // Command trees for real vehicles use the precompiled tables
+    Vehicle* vehicle = new Vehicle(MAV_AUTOPILOT_PX4, MAV_TYPE_QUADROTOR, qgcApp()->toolbox()->firmwarePluginManager());
+    MissionCommandTree* commandTree = qgcApp()->toolbox()->missionCommandTree();
+    QVERIFY(commandTree->getUIInfo(vehicle, MAV_CMD_NAV_WAYPOINT) != NULL);
+    QVERIFY(commandTree->_availableTables[MAV_AUTOPILOT_PX4][MAV_TYPE_QUADROTOR] != -1);
+    delete vehicle;
+}
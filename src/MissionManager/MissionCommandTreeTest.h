@@ -28,6 +28,7 @@ private slots:
     void testJsonLoad(void);
     void testOverride(void);
     void testAllTrees(void);
+    void testPrecompiledTables(void);
 
 private:
     QString _rawName(int id);
@@ -76,6 +76,7 @@ private:
     bool            _nanUnchanged;
 
     friend class MissionCommandTree;
+    friend class MissionCommandTable;
     friend class MissionCommandUIInfo;
 };
 
@@ -195,6 +196,7 @@ private:
     static const char* _advancedCategory;
 
     friend class MissionCommandTree;    
+    friend class MissionCommandTable;
 #ifdef UNITTEST_BUILD
     friend class MissionCommandTreeTest;
 #endif
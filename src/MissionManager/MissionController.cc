@@ -20,6 +20,7 @@
 #include "FixedWingLandingComplexItem.h"
 #include "StructureScanComplexItem.h"
 #include "CorridorScanComplexItem.h"
+#include "TransectStyleComplexItem.h"
 #include "JsonHelper.h"
 #include "ParameterManager.h"
 #include "QGroundControlQmlGlobal.h"
@@ -311,12 +312,45 @@ void MissionController::sendItemsToVehicle(Vehicle* vehicle, QmlObjectListModel*
         QList<MissionItem*> rgMissionItems;
 
         _convertToMissionItems(visualMissionItems, rgMissionItems, vehicle);
+        _setImageCoverageSurvey(vehicle, visualMissionItems);
 
         // PlanManager takes control of MissionItems so no need to delete
         vehicle->missionManager()->writeMissionItems(rgMissionItems);
     }
 }
 
+/// Sets up the image coverage of the vehicle for the survey areas in the mission. Survey items are only available in the plan,
+/// the mission read back from the vehicle is made of simple items, so this is done when the plan is sent.
+void MissionController::_setImageCoverageSurvey(Vehicle* vehicle, QmlObjectListModel* visualMissionItems)
+{
+    QList<QList<QGeoCoordinate> >   polygons;
+    ImageCoverage::Camera           camera;
+
+    for (int i=0; i<visualMissionItems->count(); i++) {
+        QObject* item = visualMissionItems->get(i);
+
+        TransectStyleComplexItem*   transectItem =  qobject_cast<TransectStyleComplexItem*>(item);
+        SurveyMissionItem*          surveyItem =    qobject_cast<SurveyMissionItem*>(item);
+        if (transectItem && !transectItem->cameraCalc()->isManualCamera()) {
+            polygons.append(transectItem->surveyAreaPolygon()->coordinateList());
+            if (!camera.isValid()) {
+                camera = ImageCoverage::Camera(transectItem->cameraCalc(), transectItem->cameraCalc()->distanceToSurface()->rawValue().toDouble());
+            }
+        } else if (surveyItem && !surveyItem->manualGrid()->rawValue().toBool()) {
+            polygons.append(surveyItem->mapPolygon()->coordinateList());
+            if (!camera.isValid()) {
+                camera.sensorWidth =        surveyItem->cameraSensorWidth()->rawValue().toDouble();
+                camera.sensorHeight =       surveyItem->cameraSensorHeight()->rawValue().toDouble();
+                camera.focalLength =        surveyItem->cameraFocalLength()->rawValue().toDouble();
+                camera.landscape =          surveyItem->cameraOrientationLandscape()->rawValue().toBool();
+                camera.distanceToSurface =  surveyItem->gridAltitude()->rawValue().toDouble();
+            }
+        }
+    }
+
+    vehicle->imageCoverage()->setSurvey(polygons, camera);
+}
+
 int MissionController::_nextSequenceNumber(void)
 {
     if (_visualItems->count() == 0) {
@@ -1562,7 +1596,7 @@ void MissionController::_initVisualItem(VisualMissionItem* visualItem)
         // We need to track commandChanged on simple item since recalc has special handling for takeoff command
         SimpleMissionItem* simpleItem = qobject_cast<SimpleMissionItem*>(visualItem);
         if (simpleItem) {
-            connect(&simpleItem->missionItem()._commandFact, &Fact::valueChanged, this, &MissionController::_itemCommandChanged);
+            connect(&simpleItem->missionItem(), &MissionItem::commandChanged, this, &MissionController::_itemCommandChanged);
         } else {
             qWarning() << "isSimpleItem == true, yet not SimpleMissionItem";
         }
@@ -30,31 +30,49 @@ const char*  MissionItem::_jsonParam2Key =          "param2";
 const char*  MissionItem::_jsonParam3Key =          "param3";
 const char*  MissionItem::_jsonParam4Key =          "param4";
 
+/// Fact wrappers around the values of one MissionItem, see MissionItem::_materializeFacts
+class MissionItemFacts : public QObject
+{
+public:
+    MissionItemFacts(void)
+        : autoContinue  (0, "AutoContinue", FactMetaData::valueTypeUint32)
+        , command       (0, "",             FactMetaData::valueTypeUint32)
+        , frame         (0, "",             FactMetaData::valueTypeUint32)
+        , param1        (0, "Param1:",      FactMetaData::valueTypeDouble)
+        , param2        (0, "Param2:",      FactMetaData::valueTypeDouble)
+        , param3        (0, "Param3:",      FactMetaData::valueTypeDouble)
+        , param4        (0, "Param4:",      FactMetaData::valueTypeDouble)
+        , param5        (0, "Lat/X:",       FactMetaData::valueTypeDouble)
+        , param6        (0, "Lon/Y:",       FactMetaData::valueTypeDouble)
+        , param7        (0, "Alt/Z:",       FactMetaData::valueTypeDouble)
+    {
+        params[0] = &param1;
+        params[1] = &param2;
+        params[2] = &param3;
+        params[3] = &param4;
+        params[4] = &param5;
+        params[5] = &param6;
+        params[6] = &param7;
+    }
+
+    Fact    autoContinue;
+    Fact    command;
+    Fact    frame;
+    Fact    param1;
+    Fact    param2;
+    Fact    param3;
+    Fact    param4;
+    Fact    param5;
+    Fact    param6;
+    Fact    param7;
+    Fact*   params[7];
+};
+
 MissionItem::MissionItem(QObject* parent)
     : QObject(parent)
-    , _sequenceNumber(0)
-    , _doJumpId(-1)
-    , _isCurrentItem(false)
-    , _autoContinueFact             (0, "AutoContinue",                 FactMetaData::valueTypeUint32)
-    , _commandFact                  (0, "",                             FactMetaData::valueTypeUint32)
-    , _frameFact                    (0, "",                             FactMetaData::valueTypeUint32)
-    , _param1Fact                   (0, "Param1:",                      FactMetaData::valueTypeDouble)
-    , _param2Fact                   (0, "Param2:",                      FactMetaData::valueTypeDouble)
-    , _param3Fact                   (0, "Param3:",                      FactMetaData::valueTypeDouble)
-    , _param4Fact                   (0, "Param4:",                      FactMetaData::valueTypeDouble)
-    , _param5Fact                   (0, "Latitude:",                    FactMetaData::valueTypeDouble)
-    , _param6Fact                   (0, "Longitude:",                   FactMetaData::valueTypeDouble)
-    , _param7Fact                   (0, "Altitude:",                    FactMetaData::valueTypeDouble)
-{
-    // Need a good command and frame before we start passing signals around
-    _commandFact.setRawValue(MAV_CMD_NAV_WAYPOINT);
-    _frameFact.setRawValue(MAV_FRAME_GLOBAL_RELATIVE_ALT);
-
-    setAutoContinue(true);
-
-    connect(&_param1Fact, &Fact::rawValueChanged, this, &MissionItem::_param1Changed);
-    connect(&_param2Fact, &Fact::rawValueChanged, this, &MissionItem::_param2Changed);
-    connect(&_param3Fact, &Fact::rawValueChanged, this, &MissionItem::_param3Changed);
+    , _facts(NULL)
+{
+    _init();
 }
 
 MissionItem::MissionItem(int             sequenceNumber,
@@ -71,88 +89,125 @@ MissionItem::MissionItem(int             sequenceNumber,
                          bool            isCurrentItem,
                          QObject*        parent)
     : QObject(parent)
-    , _sequenceNumber(sequenceNumber)
-    , _doJumpId(-1)
-    , _isCurrentItem(isCurrentItem)
-    , _commandFact                  (0, "",                             FactMetaData::valueTypeUint32)
-    , _frameFact                    (0, "",                             FactMetaData::valueTypeUint32)
-    , _param1Fact                   (0, "Param1:",                      FactMetaData::valueTypeDouble)
-    , _param2Fact                   (0, "Param2:",                      FactMetaData::valueTypeDouble)
-    , _param3Fact                   (0, "Param3:",                      FactMetaData::valueTypeDouble)
-    , _param4Fact                   (0, "Param4:",                      FactMetaData::valueTypeDouble)
-    , _param5Fact                   (0, "Lat/X:",                       FactMetaData::valueTypeDouble)
-    , _param6Fact                   (0, "Lon/Y:",                       FactMetaData::valueTypeDouble)
-    , _param7Fact                   (0, "Alt/Z:",                       FactMetaData::valueTypeDouble)
-{
-    // Need a good command and frame before we start passing signals around
-    _commandFact.setRawValue(MAV_CMD_NAV_WAYPOINT);
-    _frameFact.setRawValue(MAV_FRAME_GLOBAL_RELATIVE_ALT);
-
-    setCommand(command);
-    setFrame(frame);
-    setAutoContinue(autoContinue);
-
-    _param1Fact.setRawValue(param1);
-    _param2Fact.setRawValue(param2);
-    _param3Fact.setRawValue(param3);
-    _param4Fact.setRawValue(param4);
-    _param5Fact.setRawValue(param5);
-    _param6Fact.setRawValue(param6);
-    _param7Fact.setRawValue(param7);
-
-    connect(&_param2Fact, &Fact::rawValueChanged, this, &MissionItem::_param2Changed);
-    connect(&_param3Fact, &Fact::rawValueChanged, this, &MissionItem::_param3Changed);
+    , _facts(NULL)
+{
+    _init();
+
+    _data.sequenceNumber =  sequenceNumber;
+    _data.command =         command;
+    _data.frame =           frame;
+    _data.autoContinue =    autoContinue;
+    _data.isCurrentItem =   isCurrentItem;
+    _data.params[0] =       param1;
+    _data.params[1] =       param2;
+    _data.params[2] =       param3;
+    _data.params[3] =       param4;
+    _data.params[4] =       param5;
+    _data.params[5] =       param6;
+    _data.params[6] =       param7;
 }
 
 MissionItem::MissionItem(const MissionItem& other, QObject* parent)
     : QObject(parent)
-    , _sequenceNumber(0)
-    , _doJumpId(-1)
-    , _isCurrentItem(false)
-    , _commandFact                  (0, "",                             FactMetaData::valueTypeUint32)
-    , _frameFact                    (0, "",                             FactMetaData::valueTypeUint32)
-    , _param1Fact                   (0, "Param1:",                      FactMetaData::valueTypeDouble)
-    , _param2Fact                   (0, "Param2:",                      FactMetaData::valueTypeDouble)
-    , _param3Fact                   (0, "Param3:",                      FactMetaData::valueTypeDouble)
-    , _param4Fact                   (0, "Param4:",                      FactMetaData::valueTypeDouble)
-    , _param5Fact                   (0, "Lat/X:",                       FactMetaData::valueTypeDouble)
-    , _param6Fact                   (0, "Lon/Y:",                       FactMetaData::valueTypeDouble)
-    , _param7Fact                   (0, "Alt/Z:",                       FactMetaData::valueTypeDouble)
-{
-    // Need a good command and frame before we start passing signals around
-    _commandFact.setRawValue(MAV_CMD_NAV_WAYPOINT);
-    _frameFact.setRawValue(MAV_FRAME_GLOBAL_RELATIVE_ALT);
+    , _facts(NULL)
+{
+    _init();
 
     *this = other;
+}
 
-    connect(&_param2Fact, &Fact::rawValueChanged, this, &MissionItem::_param2Changed);
-    connect(&_param3Fact, &Fact::rawValueChanged, this, &MissionItem::_param3Changed);
+void MissionItem::_init(void)
+{
+    memset(&_data, 0, sizeof(_data));
+    _data.command =         MAV_CMD_NAV_WAYPOINT;
+    _data.frame =           MAV_FRAME_GLOBAL_RELATIVE_ALT;
+    _data.autoContinue =    true;
+    _data.doJumpId =        -1;
 }
 
 const MissionItem& MissionItem::operator=(const MissionItem& other)
 {
-    _doJumpId = other._doJumpId;
+    _data.doJumpId = other._data.doJumpId;
 
     setCommand(other.command());
     setFrame(other.frame());
-    setSequenceNumber(other._sequenceNumber);
+    setSequenceNumber(other.sequenceNumber());
     setAutoContinue(other.autoContinue());
-    setIsCurrentItem(other._isCurrentItem);
+    setIsCurrentItem(other.isCurrentItem());
 
-    _param1Fact.setRawValue(other._param1Fact.rawValue());
-    _param2Fact.setRawValue(other._param2Fact.rawValue());
-    _param3Fact.setRawValue(other._param3Fact.rawValue());
-    _param4Fact.setRawValue(other._param4Fact.rawValue());
-    _param5Fact.setRawValue(other._param5Fact.rawValue());
-    _param6Fact.setRawValue(other._param6Fact.rawValue());
-    _param7Fact.setRawValue(other._param7Fact.rawValue());
+    for (int i=1; i<=7; i++) {
+        setParam(i, other.param(i));
+    }
 
     return *this;
 }
 
 MissionItem::~MissionItem()
 {    
+    delete _facts;
+}
 
+void MissionItem::_materializeFacts(void)
+{
+    if (_facts) {
+        return;
+    }
+
+    _facts = new MissionItemFacts();
+
+    _facts->autoContinue.setRawValue(_data.autoContinue);
+    _facts->command.setRawValue(_data.command);
+    _facts->frame.setRawValue(_data.frame);
+    for (int i=0; i<7; i++) {
+        _facts->params[i]->setRawValue(_data.params[i]);
+    }
+
+    // Edits made through the Facts go back to the data
+    connect(&_facts->autoContinue,  &Fact::rawValueChanged, this, [this](QVariant value) { _setAutoContinueData(value.toBool()); });
+    connect(&_facts->command,       &Fact::rawValueChanged, this, [this](QVariant value) { _setCommandData((MAV_CMD)value.toInt()); });
+    connect(&_facts->frame,         &Fact::rawValueChanged, this, [this](QVariant value) { _setFrameData((MAV_FRAME)value.toInt()); });
+    for (int i=0; i<7; i++) {
+        int param = i + 1;
+        connect(_facts->params[i], &Fact::rawValueChanged, this, [this, param](QVariant value) { _setParamData(param, value.toDouble()); });
+    }
+}
+
+void MissionItem::releaseFacts(void)
+{
+    if (_facts) {
+        _facts->autoContinue.disconnect(this);
+        _facts->command.disconnect(this);
+        _facts->frame.disconnect(this);
+        for (int i=0; i<7; i++) {
+            _facts->params[i]->disconnect(this);
+        }
+        _facts->deleteLater();
+        _facts = NULL;
+    }
+}
+
+Fact* MissionItem::autoContinueFact(void)
+{
+    _materializeFacts();
+    return &_facts->autoContinue;
+}
+
+Fact* MissionItem::commandFact(void)
+{
+    _materializeFacts();
+    return &_facts->command;
+}
+
+Fact* MissionItem::frameFact(void)
+{
+    _materializeFacts();
+    return &_facts->frame;
+}
+
+Fact* MissionItem::paramFact(int param)
+{
+    _materializeFacts();
+    return _facts->params[param-1];
 }
 
 void MissionItem::save(QJsonObject& json) const
@@ -161,7 +216,7 @@ void MissionItem::save(QJsonObject& json) const
     json[_jsonFrameKey] = frame();
     json[_jsonCommandKey] = command();
     json[_jsonAutoContinueKey] = autoContinue();
-    json[_jsonDoJumpIdKey] = _sequenceNumber;
+    json[_jsonDoJumpIdKey] = sequenceNumber();
 
     QJsonArray rgParams =  { param1(), param2(), param3(), param4(), param5(), param6(), param7() };
     json[_jsonParamsKey] = rgParams;
@@ -303,9 +358,9 @@ bool MissionItem::load(const QJsonObject& json, int sequenceNumber, QString& err
     setCommand((MAV_CMD)convertedJson[_jsonCommandKey].toInt());
     setFrame((MAV_FRAME)convertedJson[_jsonFrameKey].toInt());
 
-    _doJumpId = -1;
+    _data.doJumpId = -1;
     if (convertedJson.contains(_jsonDoJumpIdKey)) {
-        _doJumpId = convertedJson[_jsonDoJumpIdKey].toInt();
+        _data.doJumpId = convertedJson[_jsonDoJumpIdKey].toInt();
     }
     setIsCurrentItem(false);
     setSequenceNumber(sequenceNumber);
@@ -325,87 +380,156 @@ bool MissionItem::load(const QJsonObject& json, int sequenceNumber, QString& err
 
 void MissionItem::setSequenceNumber(int sequenceNumber)
 {
-    if (_sequenceNumber != sequenceNumber) {
-        _sequenceNumber = sequenceNumber;
-        emit sequenceNumberChanged(_sequenceNumber);
+    if (_data.sequenceNumber != sequenceNumber) {
+        _data.sequenceNumber = sequenceNumber;
+        emit sequenceNumberChanged(sequenceNumber);
     }
 }
 
 void MissionItem::setCommand(MAV_CMD command)
 {
-    if ((MAV_CMD)this->command() != command) {
-        _commandFact.setRawValue(command);
+    if (this->command() != command) {
+        if (_facts) {
+            // Comes back through _setCommandData
+            _facts->command.setRawValue(command);
+        } else {
+            _setCommandData(command);
+        }
     }
 }
 
 void MissionItem::setFrame(MAV_FRAME frame)
 {
     if (this->frame() != frame) {
-        _frameFact.setRawValue(frame);
+        if (_facts) {
+            _facts->frame.setRawValue(frame);
+        } else {
+            _setFrameData(frame);
+        }
     }
 }
 
 void MissionItem::setAutoContinue(bool autoContinue)
 {
     if (this->autoContinue() != autoContinue) {
-        _autoContinueFact.setRawValue(autoContinue);
+        if (_facts) {
+            _facts->autoContinue.setRawValue(autoContinue);
+        } else {
+            _setAutoContinueData(autoContinue);
+        }
     }
 }
 
 void MissionItem::setIsCurrentItem(bool isCurrentItem)
 {
-    if (_isCurrentItem != isCurrentItem) {
-        _isCurrentItem = isCurrentItem;
+    if (_data.isCurrentItem != isCurrentItem) {
+        _data.isCurrentItem = isCurrentItem;
         emit isCurrentItemChanged(isCurrentItem);
     }
 }
 
-void MissionItem::setParam1(double param)
+void MissionItem::setParam(int param, double value)
 {
-    if (param1() != param) {
-        _param1Fact.setRawValue(param);
+    if (this->param(param) != value) {
+        if (_facts) {
+            _facts->params[param-1]->setRawValue(value);
+        } else {
+            _setParamData(param, value);
+        }
     }
 }
 
+void MissionItem::setParam1(double param)
+{
+    setParam(1, param);
+}
+
 void MissionItem::setParam2(double param)
 {
-    if (param2() != param) {
-        _param2Fact.setRawValue(param);
-    }
+    setParam(2, param);
 }
 
 void MissionItem::setParam3(double param)
 {
-    if (param3() != param) {
-        _param3Fact.setRawValue(param);
-    }
+    setParam(3, param);
 }
 
 void MissionItem::setParam4(double param)
 {
-    if (param4() != param) {
-        _param4Fact.setRawValue(param);
-    }
+    setParam(4, param);
 }
 
 void MissionItem::setParam5(double param)
 {
-    if (param5() != param) {
-        _param5Fact.setRawValue(param);
-    }
+    setParam(5, param);
 }
 
 void MissionItem::setParam6(double param)
 {
-    if (param6() != param) {
-        _param6Fact.setRawValue(param);
-    }
+    setParam(6, param);
 }
 
 void MissionItem::setParam7(double param)
 {
-    if (param7() != param) {
-        _param7Fact.setRawValue(param);
+    setParam(7, param);
+}
+
+void MissionItem::_setCommandData(MAV_CMD command)
+{
+    if (_data.command != command) {
+        _data.command = command;
+        emit commandChanged(command);
+    }
+}
+
+void MissionItem::_setFrameData(MAV_FRAME frame)
+{
+    if (_data.frame != frame) {
+        _data.frame = frame;
+        emit frameChanged(frame);
+    }
+}
+
+void MissionItem::_setAutoContinueData(bool autoContinue)
+{
+    if (_data.autoContinue != autoContinue) {
+        _data.autoContinue = autoContinue;
+        emit autoContinueChanged(autoContinue);
+    }
+}
+
+void MissionItem::_setParamData(int param, double value)
+{
+    _data.params[param-1] = value;
+    emit paramChanged(param, value);
+
+    switch (param) {
+    case 1:
+    {
+        double gimbalPitch = specifiedGimbalPitch();
+        if (!qIsNaN(gimbalPitch)) {
+            emit specifiedGimbalPitchChanged(gimbalPitch);
+        }
+        break;
+    }
+    case 2:
+    {
+        double flightSpeed = specifiedFlightSpeed();
+        if (!qIsNaN(flightSpeed)) {
+            emit specifiedFlightSpeedChanged(flightSpeed);
+        }
+        break;
+    }
+    case 3:
+    {
+        double gimbalYaw = specifiedGimbalYaw();
+        if (!qIsNaN(gimbalYaw)) {
+            emit specifiedGimbalYawChanged(gimbalYaw);
+        }
+        break;
+    }
+    default:
+        break;
     }
 }
 
@@ -425,8 +549,8 @@ double MissionItem::specifiedFlightSpeed(void) const
 {
     double flightSpeed = std::numeric_limits<double>::quiet_NaN();
 
-    if (_commandFact.rawValue().toInt() == MAV_CMD_DO_CHANGE_SPEED && _param2Fact.rawValue().toDouble() > 0) {
-        flightSpeed = _param2Fact.rawValue().toDouble();
+    if (command() == MAV_CMD_DO_CHANGE_SPEED && param2() > 0) {
+        flightSpeed = param2();
     }
 
     return flightSpeed;
@@ -436,8 +560,8 @@ double MissionItem::specifiedGimbalYaw(void) const
 {
     double gimbalYaw = std::numeric_limits<double>::quiet_NaN();
 
-    if (_commandFact.rawValue().toInt() == MAV_CMD_DO_MOUNT_CONTROL && _param7Fact.rawValue().toInt() == MAV_MOUNT_MODE_MAVLINK_TARGETING) {
-        gimbalYaw = _param3Fact.rawValue().toDouble();
+    if (command() == MAV_CMD_DO_MOUNT_CONTROL && (int)param7() == MAV_MOUNT_MODE_MAVLINK_TARGETING) {
+        gimbalYaw = param3();
     }
 
     return gimbalYaw;
@@ -447,39 +571,9 @@ double MissionItem::specifiedGimbalPitch(void) const
 {
     double gimbalPitch = std::numeric_limits<double>::quiet_NaN();
 
-    if (_commandFact.rawValue().toInt() == MAV_CMD_DO_MOUNT_CONTROL && _param7Fact.rawValue().toInt() == MAV_MOUNT_MODE_MAVLINK_TARGETING) {
-        gimbalPitch = _param1Fact.rawValue().toDouble();
+    if (command() == MAV_CMD_DO_MOUNT_CONTROL && (int)param7() == MAV_MOUNT_MODE_MAVLINK_TARGETING) {
+        gimbalPitch = param1();
     }
 
     return gimbalPitch;
 }
-
-void MissionItem::_param1Changed(QVariant value)
-{
-    Q_UNUSED(value);
-
-    double gimbalPitch = specifiedGimbalPitch();
-    if (!qIsNaN(gimbalPitch)) {
-        emit specifiedGimbalPitchChanged(gimbalPitch);
-    }
-}
-
-void MissionItem::_param2Changed(QVariant value)
-{
-    Q_UNUSED(value);
-
-    double flightSpeed = specifiedFlightSpeed();
-    if (!qIsNaN(flightSpeed)) {
-        emit specifiedFlightSpeedChanged(flightSpeed);
-    }
-}
-
-void MissionItem::_param3Changed(QVariant value)
-{
-    Q_UNUSED(value);
-
-    double gimbalYaw = specifiedGimbalYaw();
-    if (!qIsNaN(gimbalYaw)) {
-        emit specifiedGimbalYawChanged(gimbalYaw);
-    }
-}
@@ -29,11 +29,28 @@
 class SurveyMissionItem;
 class SimpleMissionItem;
 class MissionController;
+class MissionItemFacts;
 #ifdef UNITTEST_BUILD
     class MissionItemTest;
 #endif
 
+/// Plain storage for the values of a mission item. Same fields as MISSION_ITEM_INT, except that x/y are kept as double
+/// since params 5/6 are not always coordinates.
+struct MissionItemData {
+    double      params[7];
+    int         sequenceNumber;
+    int         doJumpId;
+    uint16_t    command;
+    uint8_t     frame;
+    bool        autoContinue;
+    bool        isCurrentItem;
+};
+
 // Represents a Mavlink mission command.
+//
+// The values live in a MissionItemData. The Facts used by the editing ui are only created when one of the Fact
+// accessors is called and can be released again with releaseFacts. Large missions which are only transferred or
+// displayed never create them.
 class MissionItem : public QObject
 {
     Q_OBJECT
@@ -61,20 +78,35 @@ public:
 
     const MissionItem& operator=(const MissionItem& other);
     
-    MAV_CMD         command         (void) const { return (MAV_CMD)_commandFact.rawValue().toInt(); }
-    bool            isCurrentItem   (void) const { return _isCurrentItem; }
-    int             sequenceNumber  (void) const { return _sequenceNumber; }
-    MAV_FRAME       frame           (void) const { return (MAV_FRAME)_frameFact.rawValue().toInt(); }
-    bool            autoContinue    (void) const { return _autoContinueFact.rawValue().toBool(); }
-    double          param1          (void) const { return _param1Fact.rawValue().toDouble(); }
-    double          param2          (void) const { return _param2Fact.rawValue().toDouble(); }
-    double          param3          (void) const { return _param3Fact.rawValue().toDouble(); }
-    double          param4          (void) const { return _param4Fact.rawValue().toDouble(); }
-    double          param5          (void) const { return _param5Fact.rawValue().toDouble(); }
-    double          param6          (void) const { return _param6Fact.rawValue().toDouble(); }
-    double          param7          (void) const { return _param7Fact.rawValue().toDouble(); }
+    MAV_CMD         command         (void) const { return (MAV_CMD)_data.command; }
+    bool            isCurrentItem   (void) const { return _data.isCurrentItem; }
+    int             sequenceNumber  (void) const { return _data.sequenceNumber; }
+    MAV_FRAME       frame           (void) const { return (MAV_FRAME)_data.frame; }
+    bool            autoContinue    (void) const { return _data.autoContinue; }
+    double          param1          (void) const { return _data.params[0]; }
+    double          param2          (void) const { return _data.params[1]; }
+    double          param3          (void) const { return _data.params[2]; }
+    double          param4          (void) const { return _data.params[3]; }
+    double          param5          (void) const { return _data.params[4]; }
+    double          param6          (void) const { return _data.params[5]; }
+    double          param7          (void) const { return _data.params[6]; }
+    double          param           (int param) const { return _data.params[param-1]; }   ///< @param param 1-7
     QGeoCoordinate  coordinate      (void) const;
-    int             doJumpId        (void) const { return _doJumpId; }
+    int             doJumpId        (void) const { return _data.doJumpId; }
+
+    const MissionItemData& data(void) const { return _data; }
+
+    /// Fact accessors for the editing ui. The first call creates the Facts for this item.
+    Fact* autoContinueFact  (void);
+    Fact* commandFact       (void);
+    Fact* frameFact         (void);
+    Fact* paramFact         (int param);    ///< @param param 1-7
+
+    /// @return true: Facts have been created for this item
+    bool factsMaterialized(void) const { return _facts != NULL; }
+
+    /// Deletes the Facts of this item. Values are kept. The Facts are deleted later so the ui can let go of them.
+    void releaseFacts(void);
 
     /// @return Flight speed change value if this item supports it. If not it returns NaN.
     double specifiedFlightSpeed(void) const;
@@ -97,6 +129,7 @@ public:
     void setParam5          (double param5);
     void setParam6          (double param6);
     void setParam7          (double param7);
+    void setParam           (int param, double value);  ///< @param param 1-7
     void setCoordinate      (const QGeoCoordinate& coordinate);
     
     void save(QJsonObject& json) const;
@@ -112,30 +145,25 @@ signals:
     void specifiedGimbalYawChanged  (double gimbalYaw);
     void specifiedGimbalPitchChanged(double gimbalPitch);
 
-private slots:
-    void _param1Changed(QVariant value);
-    void _param2Changed(QVariant value);
-    void _param3Changed(QVariant value);
+    // Value change signals, sent whether or not the Facts exist
+    void commandChanged             (int command);
+    void frameChanged               (int frame);
+    void autoContinueChanged        (bool autoContinue);
+    void paramChanged               (int param, double value);
 
 private:
+    void _init                      (void);
+    void _materializeFacts          (void);
+    void _setCommandData            (MAV_CMD command);
+    void _setFrameData              (MAV_FRAME frame);
+    void _setAutoContinueData       (bool autoContinue);
+    void _setParamData              (int param, double value);
     bool _convertJsonV1ToV2(const QJsonObject& json, QJsonObject& v2Json, QString& errorString);
     bool _convertJsonV2ToV3(QJsonObject& json, QString& errorString);
 
-    int     _sequenceNumber;
-    int     _doJumpId;
-    bool    _isCurrentItem;
-
-    Fact    _autoContinueFact;
-    Fact    _commandFact;
-    Fact    _frameFact;
-    Fact    _param1Fact;
-    Fact    _param2Fact;
-    Fact    _param3Fact;
-    Fact    _param4Fact;
-    Fact    _param5Fact;
-    Fact    _param6Fact;
-    Fact    _param7Fact;
-    
+    MissionItemData     _data;
+    MissionItemFacts*   _facts;     ///< NULL until a Fact accessor is called
+
     // Keys for Json save
     static const char*  _jsonFrameKey;
     static const char*  _jsonCommandKey;
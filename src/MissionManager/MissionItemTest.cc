@@ -13,6 +13,8 @@
 #include "MultiVehicleManager.h"
 #include "MissionItem.h"
 #include "SimpleMissionItem.h"
+#include "CameraSection.h"
+#include "SpeedSection.h"
 #include "QGCApplication.h"
 
 #if 0
@@ -161,7 +163,7 @@ void MissionItemTest::_testFactSignals(void)
 
 
     // command
-    QSignalSpy commandSpy(&missionItem._commandFact, SIGNAL(valueChanged(QVariant)));
+    QSignalSpy commandSpy(missionItem.commandFact(), SIGNAL(valueChanged(QVariant)));
     missionItem.setCommand(MAV_CMD_NAV_WAYPOINT);
     QCOMPARE(commandSpy.count(), 0);
     missionItem.setCommand(MAV_CMD_NAV_ALTITUDE_WAIT);
@@ -171,7 +173,7 @@ void MissionItemTest::_testFactSignals(void)
     QCOMPARE((MAV_CMD)arguments.at(0).toInt(), MAV_CMD_NAV_ALTITUDE_WAIT);
 
     // frame
-    QSignalSpy frameSpy(&missionItem._frameFact, SIGNAL(valueChanged(QVariant)));
+    QSignalSpy frameSpy(missionItem.frameFact(), SIGNAL(valueChanged(QVariant)));
     missionItem.setFrame(MAV_FRAME_GLOBAL_RELATIVE_ALT);
     QCOMPARE(frameSpy.count(), 0);
     missionItem.setFrame(MAV_FRAME_BODY_NED);
@@ -181,7 +183,7 @@ void MissionItemTest::_testFactSignals(void)
     QCOMPARE((MAV_FRAME)arguments.at(0).toInt(), MAV_FRAME_BODY_NED);
 
     // param1
-    QSignalSpy param1Spy(&missionItem._param1Fact, SIGNAL(valueChanged(QVariant)));
+    QSignalSpy param1Spy(missionItem.paramFact(1), SIGNAL(valueChanged(QVariant)));
     missionItem.setParam1(1.0);
     QCOMPARE(param1Spy.count(), 0);
     missionItem.setParam1(2.0);
@@ -191,7 +193,7 @@ void MissionItemTest::_testFactSignals(void)
     QCOMPARE(arguments.at(0).toDouble(), 2.0);
 
     // param2
-    QSignalSpy param2Spy(&missionItem._param2Fact, SIGNAL(valueChanged(QVariant)));
+    QSignalSpy param2Spy(missionItem.paramFact(2), SIGNAL(valueChanged(QVariant)));
     missionItem.setParam2(2.0);
     QCOMPARE(param2Spy.count(), 0);
     missionItem.setParam2(3.0);
@@ -201,7 +203,7 @@ void MissionItemTest::_testFactSignals(void)
     QCOMPARE(arguments.at(0).toDouble(), 3.0);
 
     // param3
-    QSignalSpy param3Spy(&missionItem._param3Fact, SIGNAL(valueChanged(QVariant)));
+    QSignalSpy param3Spy(missionItem.paramFact(3), SIGNAL(valueChanged(QVariant)));
     missionItem.setParam3(3.0);
     QCOMPARE(param3Spy.count(), 0);
     missionItem.setParam3(4.0);
@@ -211,7 +213,7 @@ void MissionItemTest::_testFactSignals(void)
     QCOMPARE(arguments.at(0).toDouble(), 4.0);
 
     // param4
-    QSignalSpy param4Spy(&missionItem._param4Fact, SIGNAL(valueChanged(QVariant)));
+    QSignalSpy param4Spy(missionItem.paramFact(4), SIGNAL(valueChanged(QVariant)));
     missionItem.setParam4(4.0);
     QCOMPARE(param4Spy.count(), 0);
     missionItem.setParam4(5.0);
@@ -221,7 +223,7 @@ void MissionItemTest::_testFactSignals(void)
     QCOMPARE(arguments.at(0).toDouble(), 5.0);
 
     // param6
-    QSignalSpy param6Spy(&missionItem._param6Fact, SIGNAL(valueChanged(QVariant)));
+    QSignalSpy param6Spy(missionItem.paramFact(6), SIGNAL(valueChanged(QVariant)));
     missionItem.setParam6(6.0);
     QCOMPARE(param6Spy.count(), 0);
     missionItem.setParam6(7.0);
@@ -231,7 +233,7 @@ void MissionItemTest::_testFactSignals(void)
     QCOMPARE(arguments.at(0).toDouble(), 7.0);
 
     // param7
-    QSignalSpy param7Spy(&missionItem._param7Fact, SIGNAL(valueChanged(QVariant)));
+    QSignalSpy param7Spy(missionItem.paramFact(7), SIGNAL(valueChanged(QVariant)));
     missionItem.setParam7(7.0);
     QCOMPARE(param7Spy.count(), 0);
     missionItem.setParam7(8.0);
@@ -241,6 +243,110 @@ void MissionItemTest::_testFactSignals(void)
     QCOMPARE(arguments.at(0).toDouble(), 8.0);
 }
 
+// Facts must only be created when asked for and must stay in sync with the values
+void MissionItemTest::_testLazyFacts(void)
+{
+    MissionItem missionItem(1,                                  // sequenceNumber
+                            MAV_CMD_NAV_WAYPOINT,               // command
+                            MAV_FRAME_GLOBAL_RELATIVE_ALT,      // MAV_FRAME
+                            1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0,  // params
+                            true,                               // autoContinue
+                            false);                             // isCurrentItem
+
+    QSignalSpy paramSpy(&missionItem, SIGNAL(paramChanged(int,double)));
+
+    // Setters work on the data alone
+    missionItem.setParam4(40.0);
+    QCOMPARE(missionItem.factsMaterialized(), false);
+    QCOMPARE(paramSpy.count(), 1);
+    QCOMPARE(paramSpy.takeFirst().at(0).toInt(), 4);
+
+    // Facts start out with the current values
+    Fact* param4Fact = missionItem.paramFact(4);
+    QCOMPARE(missionItem.factsMaterialized(), true);
+    QCOMPARE(param4Fact->rawValue().toDouble(), 40.0);
+    QCOMPARE(missionItem.commandFact()->rawValue().toInt(), (int)MAV_CMD_NAV_WAYPOINT);
+
+    // Edits through the Facts end up in the data
+    param4Fact->setRawValue(41.0);
+    QCOMPARE(missionItem.param4(), 41.0);
+    QCOMPARE(missionItem.data().params[3], 41.0);
+    QCOMPARE(paramSpy.count(), 1);
+
+    QSignalSpy commandSpy(&missionItem, SIGNAL(commandChanged(int)));
+    missionItem.commandFact()->setRawValue(MAV_CMD_NAV_LAND);
+    QCOMPARE(missionItem.command(), MAV_CMD_NAV_LAND);
+    QCOMPARE(commandSpy.count(), 1);
+
+    // Released Facts no longer feed the data, values are kept
+    missionItem.releaseFacts();
+    QCOMPARE(missionItem.factsMaterialized(), false);
+    QCOMPARE(missionItem.param4(), 41.0);
+    QCOMPARE(missionItem.command(), MAV_CMD_NAV_LAND);
+    param4Fact->setRawValue(42.0);
+    QCOMPARE(missionItem.param4(), 41.0);
+}
+
+// Generates a large plan and checks that only the current item carries Facts
+void MissionItemTest::_testLargeMission(void)
+{
+    const int           cItems = 20000;
+    QList<MissionItem*> missionItems;
+
+    for (int i=0; i<cItems; i++) {
+        missionItems.append(new MissionItem(i,                                  // sequenceNumber
+                                            MAV_CMD_NAV_WAYPOINT,               // command
+                                            MAV_FRAME_GLOBAL_RELATIVE_ALT,      // MAV_FRAME
+                                            0, 0, 0, 0,                         // param 1-4
+                                            47.0 + (i * 1e-5), 8.0, 50.0,       // param 5-7
+                                            true,                               // autoContinue
+                                            false,                              // isCurrentItem
+                                            this));
+    }
+
+    QList<SimpleMissionItem*> simpleItems;
+    for (int i=0; i<cItems; i++) {
+        simpleItems.append(new SimpleMissionItem(_offlineVehicle, true /* editMode */, *missionItems[i], this));
+    }
+
+    int cMaterialized = 0;
+    int cSections = 0;
+    for (int i=0; i<cItems; i++) {
+        if (simpleItems[i]->missionItem().factsMaterialized() || missionItems[i]->factsMaterialized()) {
+            cMaterialized++;
+        }
+        cSections += simpleItems[i]->findChildren<CameraSection*>().count() + simpleItems[i]->findChildren<SpeedSection*>().count();
+    }
+    QCOMPARE(cMaterialized, 0);
+    QCOMPARE(cSections, 0);
+    QCOMPARE(simpleItems[cItems - 1]->coordinate().latitude(), 47.0 + ((cItems - 1) * 1e-5));
+
+    // Selecting an item builds its editing ui, deselecting it releases the Facts again
+    SimpleMissionItem* selectedItem = simpleItems[cItems / 2];
+    selectedItem->setIsCurrentItem(true);
+    QVERIFY(selectedItem->textFieldFacts()->count() > 0);
+    QCOMPARE(selectedItem->missionItem().factsMaterialized(), true);
+    selectedItem->setIsCurrentItem(false);
+    QCOMPARE(selectedItem->missionItem().factsMaterialized(), false);
+
+    // The editor asking for the sections creates them for that item only
+    QCOMPARE(selectedItem->cameraSection()->available(), true);
+    QCOMPARE(selectedItem->speedSection()->available(), true);
+    QCOMPARE(selectedItem->findChildren<CameraSection*>().count(), 1);
+    QCOMPARE(selectedItem->findChildren<SpeedSection*>().count(), 1);
+    QCOMPARE(simpleItems[0]->findChildren<CameraSection*>().count(), 0);
+
+    // Asking for a Fact materializes the Facts of that item
+    for (int i=0; i<cItems; i++) {
+        missionItems[i]->paramFact(1);
+    }
+    QCOMPARE(missionItems[0]->factsMaterialized(), true);
+    QCOMPARE(missionItems[cItems - 1]->factsMaterialized(), true);
+
+    qDeleteAll(simpleItems);
+    qDeleteAll(missionItems);
+}
+
 void MissionItemTest::_checkExpectedMissionItem(const MissionItem& missionItem, bool allNaNs)
 {
     QCOMPARE(missionItem.sequenceNumber(), _seq);
@@ -31,6 +31,8 @@ private slots:
     void _testSetGet(void);
     void _testSignals(void);
     void _testFactSignals(void);
+    void _testLazyFacts(void);
+    void _testLargeMission(void);
     void _testLoadFromStream(void);
     void _testSimpleLoadFromStream(void);
     void _testLoadFromJsonV1(void);
@@ -62,7 +62,7 @@ const QGCMapCircle& QGCMapCircle::operator=(const QGCMapCircle& other)
 
 void QGCMapCircle::_init(void)
 {
-    _nameToMetaDataMap = FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/QGCMapCircle.Facts.json"), this);
+    _nameToMetaDataMap = FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/QGCMapCircle.Facts.json"));
     _radius.setMetaData(_nameToMetaDataMap[_radiusFactName]);
 
     connect(this,       &QGCMapCircle::centerChanged,   this, &QGCMapCircle::_setDirty);
@@ -364,25 +364,11 @@ QGeoCoordinate QGCMapPolygon::vertexCoordinate(int vertex) const
 
 QList<QPointF> QGCMapPolygon::nedPolygon(void) const
 {
-    QList<QPointF>  nedPolygon;
-
-    if (count() > 0) {
-        QGeoCoordinate  tangentOrigin = vertexCoordinate(0);
-
-        for (int i=0; i<_polygonModel.count(); i++) {
-            double y, x, down;
-            QGeoCoordinate vertex = vertexCoordinate(i);
-            if (i == 0) {
-                // This avoids a nan calculation that comes out of convertGeoToNed
-                x = y = 0;
-            } else {
-                convertGeoToNed(vertex, tangentOrigin, &y, &x, &down);
-            }
-            nedPolygon += QPointF(x, y);
-        }
+    if (count() == 0) {
+        return QList<QPointF>();
     }
 
-    return nedPolygon;
+    return convertGeoToLocalPoints(coordinateList(), vertexCoordinate(0));
 }
 
 
@@ -417,8 +403,8 @@ void QGCMapPolygon::offset(double distance)
         }
 
         // Intersect the offset edges to generate new vertices
+        QList<QPointF>  rgNewNedVertices;
         QPointF         newVertex;
-        QGeoCoordinate  tangentOrigin = vertexCoordinate(0);
         for (int i=0; i<rgOffsetEdges.count(); i++) {
             int prevIndex = i == 0 ? rgOffsetEdges.count() - 1 : i - 1;
             if (rgOffsetEdges[prevIndex].intersect(rgOffsetEdges[i], &newVertex) == QLineF::NoIntersection) {
@@ -426,10 +412,9 @@ void QGCMapPolygon::offset(double distance)
                 qWarning("Intersection failed");
                 return;
             }
-            QGeoCoordinate coord;
-            convertNedToGeo(newVertex.y(), newVertex.x(), 0, tangentOrigin, &coord);
-            rgNewPolygon.append(coord);
+            rgNewNedVertices.append(newVertex);
         }
+        rgNewPolygon = convertLocalPointsToGeo(rgNewNedVertices, vertexCoordinate(0));
     }
 
     // Update internals
@@ -52,8 +52,10 @@ SimpleMissionItem::SimpleMissionItem(Vehicle* vehicle, QObject* parent)
     , _rawEdit(false)
     , _dirty(false)
     , _ignoreDirtyChangeSignals(false)
+    , _uiFactsBuilt(false)
     , _speedSection(NULL)
     , _cameraSection(NULL)
+    , _missionFlightStatusValid(false)
     , _commandTree(qgcApp()->toolbox()->missionCommandTree())
     , _altitudeRelativeToHomeFact   (0, "Altitude is relative to home", FactMetaData::valueTypeUint32)
     , _supportedCommandFact         (0, "Command:",                     FactMetaData::valueTypeUint32)
@@ -76,7 +78,6 @@ SimpleMissionItem::SimpleMissionItem(Vehicle* vehicle, QObject* parent)
     _updateOptionalSections();
 
     setDefaultsForCommand();
-    _rebuildFacts();
 
     connect(&_missionItem, &MissionItem::specifiedFlightSpeedChanged, this, &SimpleMissionItem::specifiedFlightSpeedChanged);
 
@@ -91,8 +92,10 @@ SimpleMissionItem::SimpleMissionItem(Vehicle* vehicle, bool editMode, const Miss
     , _rawEdit(false)
     , _dirty(false)
     , _ignoreDirtyChangeSignals(false)
+    , _uiFactsBuilt(false)
     , _speedSection(NULL)
     , _cameraSection(NULL)
+    , _missionFlightStatusValid(false)
     , _commandTree(qgcApp()->toolbox()->missionCommandTree())
     , _altitudeRelativeToHomeFact   (0, "Altitude is relative to home", FactMetaData::valueTypeUint32)
     , _supportedCommandFact         (0, "Command:",                     FactMetaData::valueTypeUint32)
@@ -118,9 +121,6 @@ SimpleMissionItem::SimpleMissionItem(Vehicle* vehicle, bool editMode, const Miss
     _connectSignals();
     _updateOptionalSections();
     _syncFrameToAltitudeRelativeToHome();
-    if (editMode) {
-        _rebuildFacts();
-    }
 }
 
 SimpleMissionItem::SimpleMissionItem(const SimpleMissionItem& other, QObject* parent)
@@ -129,8 +129,10 @@ SimpleMissionItem::SimpleMissionItem(const SimpleMissionItem& other, QObject* pa
     , _rawEdit(false)
     , _dirty(false)
     , _ignoreDirtyChangeSignals(false)
+    , _uiFactsBuilt(false)
     , _speedSection(NULL)
     , _cameraSection(NULL)
+    , _missionFlightStatusValid(false)
     , _commandTree(qgcApp()->toolbox()->missionCommandTree())
     , _altitudeRelativeToHomeFact   (0, "Altitude is relative to home", FactMetaData::valueTypeUint32)
     , _supportedCommandFact         (0, "Command:",                     FactMetaData::valueTypeUint32)
@@ -148,8 +150,6 @@ SimpleMissionItem::SimpleMissionItem(const SimpleMissionItem& other, QObject* pa
     _updateOptionalSections();
 
     *this = other;
-
-    _rebuildFacts();
 }
 
 const SimpleMissionItem& SimpleMissionItem::operator=(const SimpleMissionItem& other)
@@ -168,47 +168,42 @@ const SimpleMissionItem& SimpleMissionItem::operator=(const SimpleMissionItem& o
 void SimpleMissionItem::_connectSignals(void)
 {
     // Connect to change signals to track dirty state
-    connect(&_missionItem._param1Fact,  &Fact::valueChanged,                    this, &SimpleMissionItem::_setDirtyFromSignal);
-    connect(&_missionItem._param2Fact,  &Fact::valueChanged,                    this, &SimpleMissionItem::_setDirtyFromSignal);
-    connect(&_missionItem._param3Fact,  &Fact::valueChanged,                    this, &SimpleMissionItem::_setDirtyFromSignal);
-    connect(&_missionItem._param4Fact,  &Fact::valueChanged,                    this, &SimpleMissionItem::_setDirtyFromSignal);
-    connect(&_missionItem._param5Fact,  &Fact::valueChanged,                    this, &SimpleMissionItem::_setDirtyFromSignal);
-    connect(&_missionItem._param6Fact,  &Fact::valueChanged,                    this, &SimpleMissionItem::_setDirtyFromSignal);
-    connect(&_missionItem._param7Fact,  &Fact::valueChanged,                    this, &SimpleMissionItem::_setDirtyFromSignal);
-    connect(&_missionItem._frameFact,   &Fact::valueChanged,                    this, &SimpleMissionItem::_setDirtyFromSignal);
-    connect(&_missionItem._commandFact, &Fact::valueChanged,                    this, &SimpleMissionItem::_setDirtyFromSignal);
-    connect(&_missionItem,              &MissionItem::sequenceNumberChanged,    this, &SimpleMissionItem::_setDirtyFromSignal);
+    connect(&_missionItem,  &MissionItem::paramChanged,             this, &SimpleMissionItem::_setDirtyFromSignal);
+    connect(&_missionItem,  &MissionItem::frameChanged,             this, &SimpleMissionItem::_setDirtyFromSignal);
+    connect(&_missionItem,  &MissionItem::commandChanged,           this, &SimpleMissionItem::_setDirtyFromSignal);
+    connect(&_missionItem,  &MissionItem::sequenceNumberChanged,    this, &SimpleMissionItem::_setDirtyFromSignal);
 
     // Values from these facts must propagate back and forth between the real object storage
-    connect(&_altitudeRelativeToHomeFact,   &Fact::valueChanged,    this, &SimpleMissionItem::_syncAltitudeRelativeToHomeToFrame);
-    connect(&_missionItem._frameFact,       &Fact::valueChanged,    this, &SimpleMissionItem::_syncFrameToAltitudeRelativeToHome);
+    connect(&_altitudeRelativeToHomeFact,   &Fact::valueChanged,            this, &SimpleMissionItem::_syncAltitudeRelativeToHomeToFrame);
+    connect(&_missionItem,                  &MissionItem::frameChanged,     this, &SimpleMissionItem::_syncFrameToAltitudeRelativeToHome);
 
-    // These are coordinate parameters, they must emit coordinateChanged signal
-    connect(&_missionItem._param5Fact, &Fact::valueChanged, this, &SimpleMissionItem::_sendCoordinateChanged);
-    connect(&_missionItem._param6Fact, &Fact::valueChanged, this, &SimpleMissionItem::_sendCoordinateChanged);
-    connect(&_missionItem._param7Fact, &Fact::valueChanged, this, &SimpleMissionItem::_sendCoordinateChanged);
+    // Params 5-7 are coordinate parameters, they must emit coordinateChanged signal
+    connect(&_missionItem, &MissionItem::paramChanged, this, &SimpleMissionItem::_paramChanged);
 
     // The following changes may also change friendlyEditAllowed
-    connect(&_missionItem._autoContinueFact,    &Fact::valueChanged, this, &SimpleMissionItem::_sendFriendlyEditAllowedChanged);
-    connect(&_missionItem._commandFact,         &Fact::valueChanged, this, &SimpleMissionItem::_sendFriendlyEditAllowedChanged);
-    connect(&_missionItem._frameFact,           &Fact::valueChanged, this, &SimpleMissionItem::_sendFriendlyEditAllowedChanged);
+    connect(&_missionItem, &MissionItem::autoContinueChanged,   this, &SimpleMissionItem::_sendFriendlyEditAllowedChanged);
+    connect(&_missionItem, &MissionItem::commandChanged,        this, &SimpleMissionItem::_sendFriendlyEditAllowedChanged);
+    connect(&_missionItem, &MissionItem::frameChanged,          this, &SimpleMissionItem::_sendFriendlyEditAllowedChanged);
 
     // A command change triggers a number of other changes as well.
-    connect(&_missionItem._commandFact, &Fact::valueChanged, this, &SimpleMissionItem::setDefaultsForCommand);
-    connect(&_missionItem._commandFact, &Fact::valueChanged, this, &SimpleMissionItem::commandNameChanged);
-    connect(&_missionItem._commandFact, &Fact::valueChanged, this, &SimpleMissionItem::commandDescriptionChanged);
-    connect(&_missionItem._commandFact, &Fact::valueChanged, this, &SimpleMissionItem::abbreviationChanged);
-    connect(&_missionItem._commandFact, &Fact::valueChanged, this, &SimpleMissionItem::specifiesCoordinateChanged);
-    connect(&_missionItem._commandFact, &Fact::valueChanged, this, &SimpleMissionItem::specifiesAltitudeOnlyChanged);
-    connect(&_missionItem._commandFact, &Fact::valueChanged, this, &SimpleMissionItem::isStandaloneCoordinateChanged);
+    connect(&_missionItem, &MissionItem::commandChanged, this, &SimpleMissionItem::setDefaultsForCommand);
+    connect(&_missionItem, &MissionItem::commandChanged, this, &SimpleMissionItem::commandNameChanged);
+    connect(&_missionItem, &MissionItem::commandChanged, this, &SimpleMissionItem::commandDescriptionChanged);
+    connect(&_missionItem, &MissionItem::commandChanged, this, &SimpleMissionItem::abbreviationChanged);
+    connect(&_missionItem, &MissionItem::commandChanged, this, &SimpleMissionItem::specifiesCoordinateChanged);
+    connect(&_missionItem, &MissionItem::commandChanged, this, &SimpleMissionItem::specifiesAltitudeOnlyChanged);
+    connect(&_missionItem, &MissionItem::commandChanged, this, &SimpleMissionItem::isStandaloneCoordinateChanged);
 
     // Whenever these properties change the ui model changes as well
     connect(this, &SimpleMissionItem::commandChanged, this, &SimpleMissionItem::_rebuildFacts);
     connect(this, &SimpleMissionItem::rawEditChanged, this, &SimpleMissionItem::_rebuildFacts);
 
-    // These fact signals must alway signal out through SimpleMissionItem signals
-    connect(&_missionItem._commandFact,     &Fact::valueChanged, this, &SimpleMissionItem::_sendCommandChanged);
-    connect(&_missionItem._frameFact,       &Fact::valueChanged, this, &SimpleMissionItem::_sendFrameChanged);
+    // The editing ui is only shown for the current item
+    connect(this, &SimpleMissionItem::isCurrentItemChanged, this, &SimpleMissionItem::_isCurrentItemChanged);
+
+    // These signals must alway signal out through SimpleMissionItem signals
+    connect(&_missionItem, &MissionItem::commandChanged,    this, &SimpleMissionItem::_sendCommandChanged);
+    connect(&_missionItem, &MissionItem::frameChanged,      this, &SimpleMissionItem::_sendFrameChanged);
 
     // Sequence number is kept in mission iteem, so we need to propagate signal up as well
     connect(&_missionItem, &MissionItem::sequenceNumberChanged, this, &SimpleMissionItem::sequenceNumberChanged);
@@ -257,9 +252,36 @@ void SimpleMissionItem::_setupMetaData(void)
         _longitudeMetaData->setDecimalPlaces(7);
 
     }
+}
 
-    _missionItem._commandFact.setMetaData(_commandMetaData);
-    _missionItem._frameFact.setMetaData(_frameMetaData);
+void SimpleMissionItem::_buildUiFacts(void)
+{
+    if (!_uiFactsBuilt) {
+        _uiFactsBuilt = true;
+        _setupMetaData();
+        _missionItem.commandFact()->setMetaData(_commandMetaData);
+        _missionItem.frameFact()->setMetaData(_frameMetaData);
+        _rebuildFacts();
+    }
+}
+
+void SimpleMissionItem::_releaseUiFacts(void)
+{
+    if (_uiFactsBuilt) {
+        _uiFactsBuilt = false;
+        _textFieldFacts.clear();
+        _nanFacts.clear();
+        _checkboxFacts.clear();
+        _comboboxFacts.clear();
+        _missionItem.releaseFacts();
+    }
+}
+
+void SimpleMissionItem::_isCurrentItemChanged(bool isCurrentItem)
+{
+    if (!isCurrentItem) {
+        _releaseUiFacts();
+    }
 }
 
 SimpleMissionItem::~SimpleMissionItem()
@@ -377,27 +399,15 @@ void SimpleMissionItem::_rebuildTextFieldFacts(void)
     _textFieldFacts.clear();
     
     if (rawEdit()) {
-        _missionItem._param1Fact._setName("Param1");
-        _missionItem._param1Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param1Fact);
-        _missionItem._param2Fact._setName("Param2");
-        _missionItem._param2Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param2Fact);
-        _missionItem._param3Fact._setName("Param3");
-        _missionItem._param3Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param3Fact);
-        _missionItem._param4Fact._setName("Param4");
-        _missionItem._param4Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param4Fact);
-        _missionItem._param5Fact._setName("Lat/X");
-        _missionItem._param5Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param5Fact);
-        _missionItem._param6Fact._setName("Lon/Y");
-        _missionItem._param6Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param6Fact);
-        _missionItem._param7Fact._setName("Alt/Z");
-        _missionItem._param7Fact.setMetaData(_defaultParamMetaData);
-        _textFieldFacts.append(&_missionItem._param7Fact);
+        const char* rgParamNames[7] = { "Param1", "Param2", "Param3", "Param4", "Lat/X", "Lon/Y", "Alt/Z" };
+
+        for (int i=1; i<=7; i++) {
+            Fact* paramFact = _missionItem.paramFact(i);
+
+            paramFact->_setName(rgParamNames[i-1]);
+            paramFact->setMetaData(_defaultParamMetaData);
+            _textFieldFacts.append(paramFact);
+        }
     } else {
         _ignoreDirtyChangeSignals = true;
 
@@ -408,7 +418,6 @@ void SimpleMissionItem::_rebuildTextFieldFacts(void)
             command = _missionItem.command();
         }
 
-        Fact*           rgParamFacts[7] =       { &_missionItem._param1Fact, &_missionItem._param2Fact, &_missionItem._param3Fact, &_missionItem._param4Fact, &_missionItem._param5Fact, &_missionItem._param6Fact, &_missionItem._param7Fact };
         FactMetaData*   rgParamMetaData[7] =    { &_param1MetaData, &_param2MetaData, &_param3MetaData, &_param4MetaData, &_param5MetaData, &_param6MetaData, &_param7MetaData };
 
         const MissionCommandUIInfo* uiInfo = _commandTree->getUIInfo(_vehicle, command);
@@ -418,7 +427,7 @@ void SimpleMissionItem::_rebuildTextFieldFacts(void)
             const MissionCmdParamInfo* paramInfo = uiInfo->getParamInfo(i, showUI);
 
             if (showUI && paramInfo && paramInfo->enumStrings().count() == 0 && !paramInfo->nanUnchanged()) {
-                Fact*               paramFact =     rgParamFacts[i-1];
+                Fact*               paramFact =     _missionItem.paramFact(i);
                 FactMetaData*       paramMetaData = rgParamMetaData[i-1];
 
                 paramFact->_setName(paramInfo->label());
@@ -430,9 +439,11 @@ void SimpleMissionItem::_rebuildTextFieldFacts(void)
         }
 
         if (uiInfo->specifiesCoordinate() || uiInfo->specifiesAltitudeOnly()) {
-            _missionItem._param7Fact._setName("Altitude");
-            _missionItem._param7Fact.setMetaData(_altitudeMetaData);
-            _textFieldFacts.append(&_missionItem._param7Fact);
+            Fact* altitudeFact = _missionItem.paramFact(7);
+
+            altitudeFact->_setName("Altitude");
+            altitudeFact->setMetaData(_altitudeMetaData);
+            _textFieldFacts.append(altitudeFact);
         }
 
         _ignoreDirtyChangeSignals = false;
@@ -453,7 +464,6 @@ void SimpleMissionItem::_rebuildNaNFacts(void)
             command = _missionItem.command();
         }
 
-        Fact*           rgParamFacts[7] =       { &_missionItem._param1Fact, &_missionItem._param2Fact, &_missionItem._param3Fact, &_missionItem._param4Fact, &_missionItem._param5Fact, &_missionItem._param6Fact, &_missionItem._param7Fact };
         FactMetaData*   rgParamMetaData[7] =    { &_param1MetaData, &_param2MetaData, &_param3MetaData, &_param4MetaData, &_param5MetaData, &_param6MetaData, &_param7MetaData };
 
         const MissionCommandUIInfo* uiInfo = _commandTree->getUIInfo(_vehicle, command);
@@ -474,7 +484,7 @@ void SimpleMissionItem::_rebuildNaNFacts(void)
                     continue;
                 }
 
-                Fact*               paramFact =     rgParamFacts[i-1];
+                Fact*               paramFact =     _missionItem.paramFact(i);
                 FactMetaData*       paramMetaData = rgParamMetaData[i-1];
 
                 paramFact->_setName(paramInfo->label());
@@ -494,7 +504,7 @@ void SimpleMissionItem::_rebuildCheckboxFacts(void)
     _checkboxFacts.clear();
 
     if (rawEdit()) {
-        _checkboxFacts.append(&_missionItem._autoContinueFact);
+        _checkboxFacts.append(_missionItem.autoContinueFact());
     } else if ((specifiesCoordinate() || specifiesAltitudeOnly()) && !_homePositionSpecialCase) {
         _checkboxFacts.append(&_altitudeRelativeToHomeFact);
     }
@@ -505,10 +515,9 @@ void SimpleMissionItem::_rebuildComboBoxFacts(void)
     _comboboxFacts.clear();
 
     if (rawEdit()) {
-        _comboboxFacts.append(&_missionItem._commandFact);
-        _comboboxFacts.append(&_missionItem._frameFact);
+        _comboboxFacts.append(_missionItem.commandFact());
+        _comboboxFacts.append(_missionItem.frameFact());
     } else {
-        Fact*           rgParamFacts[7] =       { &_missionItem._param1Fact, &_missionItem._param2Fact, &_missionItem._param3Fact, &_missionItem._param4Fact, &_missionItem._param5Fact, &_missionItem._param6Fact, &_missionItem._param7Fact };
         FactMetaData*   rgParamMetaData[7] =    { &_param1MetaData, &_param2MetaData, &_param3MetaData, &_param4MetaData, &_param5MetaData, &_param6MetaData, &_param7MetaData };
 
         MAV_CMD command;
@@ -523,7 +532,7 @@ void SimpleMissionItem::_rebuildComboBoxFacts(void)
             const MissionCmdParamInfo* paramInfo = _commandTree->getUIInfo(_vehicle, command)->getParamInfo(i, showUI);
 
             if (showUI && paramInfo && paramInfo->enumStrings().count() != 0) {
-                Fact*               paramFact =     rgParamFacts[i-1];
+                Fact*               paramFact =     _missionItem.paramFact(i);
                 FactMetaData*       paramMetaData = rgParamMetaData[i-1];
 
                 paramFact->_setName(paramInfo->label());
@@ -539,6 +548,10 @@ void SimpleMissionItem::_rebuildComboBoxFacts(void)
 
 void SimpleMissionItem::_rebuildFacts(void)
 {
+    if (!_uiFactsBuilt) {
+        return;
+    }
+
     _rebuildTextFieldFacts();
     _rebuildNaNFacts();
     _rebuildCheckboxFacts();
@@ -589,7 +602,7 @@ void SimpleMissionItem::setDirty(bool dirty)
 {
     if (!_homePositionSpecialCase || (_dirty != dirty)) {
         _dirty = dirty;
-        if (!dirty) {
+        if (!dirty && _cameraSection) {
             _cameraSection->setDirty(false);
             _speedSection->setDirty(false);
         }
@@ -609,6 +622,13 @@ void SimpleMissionItem::_sendCoordinateChanged(void)
     emit coordinateChanged(coordinate());
 }
 
+void SimpleMissionItem::_paramChanged(int param)
+{
+    if (param >= 5) {
+        _sendCoordinateChanged();
+    }
+}
+
 void SimpleMissionItem::_syncAltitudeRelativeToHomeToFrame(const QVariant& value)
 {
     if (!_syncingAltitudeRelativeToHomeAndFrame) {
@@ -641,8 +661,7 @@ void SimpleMissionItem::setDefaultsForCommand(void)
             bool showUI;
             const MissionCmdParamInfo* paramInfo = uiInfo->getParamInfo(i, showUI);
             if (paramInfo) {
-                Fact* rgParamFacts[7] = { &_missionItem._param1Fact, &_missionItem._param2Fact, &_missionItem._param3Fact, &_missionItem._param4Fact, &_missionItem._param5Fact, &_missionItem._param6Fact, &_missionItem._param7Fact };
-                rgParamFacts[paramInfo->param()-1]->setRawValue(paramInfo->defaultValue());
+                _missionItem.setParam(paramInfo->param(), paramInfo->defaultValue().toDouble());
             }
         }
     }
@@ -714,7 +733,7 @@ void SimpleMissionItem::setSequenceNumber(int sequenceNumber)
 
 double SimpleMissionItem::specifiedFlightSpeed(void)
 {
-    if (_speedSection->specifyFlightSpeed()) {
+    if (_speedSection && _speedSection->specifyFlightSpeed()) {
         return _speedSection->flightSpeed()->rawValue().toDouble();
     } else {
         return missionItem().specifiedFlightSpeed();
@@ -723,12 +742,12 @@ double SimpleMissionItem::specifiedFlightSpeed(void)
 
 double SimpleMissionItem::specifiedGimbalYaw(void)
 {
-    return _cameraSection->available() ? _cameraSection->specifiedGimbalYaw() : missionItem().specifiedGimbalYaw();
+    return _cameraSection && _cameraSection->available() ? _cameraSection->specifiedGimbalYaw() : missionItem().specifiedGimbalYaw();
 }
 
 double SimpleMissionItem::specifiedGimbalPitch(void)
 {
-    return _cameraSection->available() ? _cameraSection->specifiedGimbalPitch() : missionItem().specifiedGimbalPitch();
+    return _cameraSection && _cameraSection->available() ? _cameraSection->specifiedGimbalPitch() : missionItem().specifiedGimbalPitch();
 }
 
 bool SimpleMissionItem::scanForSections(QmlObjectListModel* visualItems, int scanIndex, Vehicle* vehicle)
@@ -737,19 +756,25 @@ bool SimpleMissionItem::scanForSections(QmlObjectListModel* visualItems, int sca
 
     Q_UNUSED(vehicle);
 
-    if (_cameraSection->available()) {
-        sectionFound |= _cameraSection->scanForSection(visualItems, scanIndex);
+    // Sections are only available on waypoints and only consist of non-nav commands. Don't create them unless
+    // the next item could belong to one.
+    if ((MAV_CMD)command() != MAV_CMD_NAV_WAYPOINT || scanIndex >= visualItems->count()) {
+        return false;
     }
-    if (_speedSection->available()) {
-        sectionFound |= _speedSection->scanForSection(visualItems, scanIndex);
+    SimpleMissionItem* nextItem = visualItems->value<SimpleMissionItem*>(scanIndex);
+    if (!nextItem || nextItem->missionItem().command() < MAV_CMD_NAV_LAST) {
+        return false;
     }
 
+    sectionFound |= cameraSection()->scanForSection(visualItems, scanIndex);
+    sectionFound |= speedSection()->scanForSection(visualItems, scanIndex);
+
     return sectionFound;
 }
 
 void SimpleMissionItem::_updateOptionalSections(void)
 {
-    // Remove previous sections
+    // Remove previous sections, new ones are created the next time they are asked for
     if (_cameraSection) {
         _cameraSection->deleteLater();
         _cameraSection = NULL;
@@ -759,7 +784,17 @@ void SimpleMissionItem::_updateOptionalSections(void)
         _speedSection = NULL;
     }
 
-    // Add new sections
+    emit cameraSectionChanged(_cameraSection);
+    emit speedSectionChanged(_speedSection);
+    emit lastSequenceNumberChanged(lastSequenceNumber());
+}
+
+/// Most items never show or use their camera/speed sections, so they are only created on first access.
+void SimpleMissionItem::_createOptionalSections(void)
+{
+    if (_cameraSection) {
+        return;
+    }
 
     _cameraSection = new CameraSection(_vehicle, this);
     _speedSection = new SpeedSection(_vehicle, this);
@@ -767,6 +802,9 @@ void SimpleMissionItem::_updateOptionalSections(void)
         _cameraSection->setAvailable(true);
         _speedSection->setAvailable(true);
     }
+    if (_missionFlightStatusValid) {
+        _applyMissionFlightStatusToSections();
+    }
 
     connect(_cameraSection, &CameraSection::dirtyChanged,                   this, &SimpleMissionItem::_sectionDirtyChanged);
     connect(_cameraSection, &CameraSection::itemCountChanged,               this, &SimpleMissionItem::_updateLastSequenceNumber);
@@ -778,10 +816,6 @@ void SimpleMissionItem::_updateOptionalSections(void)
     connect(_speedSection,  &SpeedSection::dirtyChanged,                this, &SimpleMissionItem::_sectionDirtyChanged);
     connect(_speedSection,  &SpeedSection::itemCountChanged,            this, &SimpleMissionItem::_updateLastSequenceNumber);
     connect(_speedSection,  &SpeedSection::specifiedFlightSpeedChanged, this, &SimpleMissionItem::specifiedFlightSpeedChanged);
-
-    emit cameraSectionChanged(_cameraSection);
-    emit speedSectionChanged(_speedSection);
-    emit lastSequenceNumberChanged(lastSequenceNumber());
 }
 
 int SimpleMissionItem::lastSequenceNumber(void) const
@@ -808,8 +842,10 @@ void SimpleMissionItem::appendMissionItems(QList<MissionItem*>& items, QObject*
     items.append(new MissionItem(missionItem(), missionItemParent));
     seqNum++;
 
-    _cameraSection->appendSectionItems(items, missionItemParent, seqNum);
-    _speedSection->appendSectionItems(items, missionItemParent, seqNum);
+    if (_cameraSection) {
+        _cameraSection->appendSectionItems(items, missionItemParent, seqNum);
+        _speedSection->appendSectionItems(items, missionItemParent, seqNum);
+    }
 }
 
 void SimpleMissionItem::applyNewAltitude(double newAltitude)
@@ -834,15 +870,23 @@ void SimpleMissionItem::setMissionFlightStatus(MissionController::MissionFlightS
 {
     // If user has not already set speed/gimbal, set defaults from previous items.
     VisualMissionItem::setMissionFlightStatus(missionFlightStatus);
-    if (_speedSection->available() && !_speedSection->specifyFlightSpeed() && !qFuzzyCompare(_speedSection->flightSpeed()->rawValue().toDouble(), missionFlightStatus.vehicleSpeed)) {
-        _speedSection->flightSpeed()->setRawValue(missionFlightStatus.vehicleSpeed);
+    _missionFlightStatusValid = true;
+    if (_cameraSection) {
+        _applyMissionFlightStatusToSections();
+    }
+}
+
+void SimpleMissionItem::_applyMissionFlightStatusToSections(void)
+{
+    if (_speedSection->available() && !_speedSection->specifyFlightSpeed() && !qFuzzyCompare(_speedSection->flightSpeed()->rawValue().toDouble(), _missionFlightStatus.vehicleSpeed)) {
+        _speedSection->flightSpeed()->setRawValue(_missionFlightStatus.vehicleSpeed);
     }
     if (_cameraSection->available() && !_cameraSection->specifyGimbal()) {
-        if (!qIsNaN(missionFlightStatus.gimbalYaw) && !qFuzzyCompare(_cameraSection->gimbalYaw()->rawValue().toDouble(), missionFlightStatus.gimbalYaw)) {
-            _cameraSection->gimbalYaw()->setRawValue(missionFlightStatus.gimbalYaw);
+        if (!qIsNaN(_missionFlightStatus.gimbalYaw) && !qFuzzyCompare(_cameraSection->gimbalYaw()->rawValue().toDouble(), _missionFlightStatus.gimbalYaw)) {
+            _cameraSection->gimbalYaw()->setRawValue(_missionFlightStatus.gimbalYaw);
         }
-        if (!qIsNaN(missionFlightStatus.gimbalPitch) && !qFuzzyCompare(_cameraSection->gimbalPitch()->rawValue().toDouble(), missionFlightStatus.gimbalPitch)) {
-            _cameraSection->gimbalPitch()->setRawValue(missionFlightStatus.gimbalPitch);
+        if (!qIsNaN(_missionFlightStatus.gimbalPitch) && !qFuzzyCompare(_cameraSection->gimbalPitch()->rawValue().toDouble(), _missionFlightStatus.gimbalPitch)) {
+            _cameraSection->gimbalPitch()->setRawValue(_missionFlightStatus.gimbalPitch);
         }
     }
 }
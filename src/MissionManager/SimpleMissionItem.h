@@ -57,16 +57,17 @@ public:
     // Property accesors
     
     QString         category            (void) const;
-    MavlinkQmlSingleton::Qml_MAV_CMD command(void) const { return (MavlinkQmlSingleton::Qml_MAV_CMD)_missionItem._commandFact.cookedValue().toInt(); }
+    MavlinkQmlSingleton::Qml_MAV_CMD command(void) const { return (MavlinkQmlSingleton::Qml_MAV_CMD)_missionItem.command(); }
     bool            friendlyEditAllowed (void) const;
     bool            rawEdit             (void) const;
-    CameraSection*  cameraSection       (void) { return _cameraSection; }
-    SpeedSection*   speedSection        (void) { return _speedSection; }
+    CameraSection*  cameraSection       (void) { _createOptionalSections(); return _cameraSection; }
+    SpeedSection*   speedSection        (void) { _createOptionalSections(); return _speedSection; }
 
-    QmlObjectListModel* textFieldFacts  (void) { return &_textFieldFacts; }
-    QmlObjectListModel* nanFacts        (void) { return &_nanFacts; }
-    QmlObjectListModel* checkboxFacts   (void) { return &_checkboxFacts; }
-    QmlObjectListModel* comboboxFacts   (void) { return &_comboboxFacts; }
+    // The Fact lists are built on first use and released again when the item is no longer the current item
+    QmlObjectListModel* textFieldFacts  (void) { _buildUiFacts(); return &_textFieldFacts; }
+    QmlObjectListModel* nanFacts        (void) { _buildUiFacts(); return &_nanFacts; }
+    QmlObjectListModel* checkboxFacts   (void) { _buildUiFacts(); return &_checkboxFacts; }
+    QmlObjectListModel* comboboxFacts   (void) { _buildUiFacts(); return &_comboboxFacts; }
 
     void setRawEdit(bool rawEdit);
     
@@ -135,6 +136,8 @@ private slots:
     void _sectionDirtyChanged               (bool dirty);
     void _sendCommandChanged                (void);
     void _sendCoordinateChanged             (void);
+    void _paramChanged                      (int param);
+    void _isCurrentItemChanged              (bool isCurrentItem);
     void _sendFrameChanged                  (void);
     void _sendFriendlyEditAllowedChanged    (void);
     void _syncAltitudeRelativeToHomeToFrame (const QVariant& value);
@@ -146,7 +149,11 @@ private slots:
 private:
     void _connectSignals        (void);
     void _setupMetaData         (void);
+    void _buildUiFacts          (void);
+    void _releaseUiFacts        (void);
     void _updateOptionalSections(void);
+    void _createOptionalSections(void);
+    void _applyMissionFlightStatusToSections(void);
     void _rebuildTextFieldFacts (void);
     void _rebuildNaNFacts       (void);
     void _rebuildCheckboxFacts  (void);
@@ -156,9 +163,11 @@ private:
     bool        _rawEdit;
     bool        _dirty;
     bool        _ignoreDirtyChangeSignals;
+    bool        _uiFactsBuilt;              ///< true: Fact lists for the editing ui are populated
 
-    SpeedSection*   _speedSection;
-    CameraSection* _cameraSection;
+    SpeedSection*   _speedSection;          ///< Created on first access, NULL until then
+    CameraSection* _cameraSection;          ///< Created on first access, NULL until then
+    bool            _missionFlightStatusValid;  ///< true: _missionFlightStatus has been set, new sections pick up its values
 
     MissionCommandTree* _commandTree;
 
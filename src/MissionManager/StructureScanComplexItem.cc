@@ -52,7 +52,7 @@ StructureScanComplexItem::StructureScanComplexItem(Vehicle* vehicle, QObject* pa
     _editorQml = "qrc:/qml/StructureScanEditor.qml";
 
     if (_metaDataMap.isEmpty()) {
-        _metaDataMap = FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/StructureScan.SettingsGroup.json"), NULL /* QObject parent */);
+        _metaDataMap = FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/StructureScan.SettingsGroup.json"));
     }
 
     _altitudeFact.setMetaData   (_metaDataMap[_altitudeFactName]);
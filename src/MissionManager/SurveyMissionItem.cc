@@ -88,7 +88,7 @@ SurveyMissionItem::SurveyMissionItem(Vehicle* vehicle, QObject* parent)
     , _cameraShots(0)
     , _coveredArea(0.0)
     , _timeBetweenShots(0.0)
-    , _metaDataMap(FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/Survey.SettingsGroup.json"), this))
+    , _metaDataMap(FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/Survey.SettingsGroup.json")))
     , _manualGridFact                   (settingsGroup, _metaDataMap[manualGridName])
     , _gridAltitudeFact                 (settingsGroup, _metaDataMap[gridAltitudeName])
     , _gridAltitudeRelativeFact         (settingsGroup, _metaDataMap[gridAltitudeRelativeName])
@@ -460,16 +460,7 @@ void SurveyMissionItem::_convertTransectToGeo(const QList<QList<QPointF>>& trans
     transectSegmentsGeo.clear();
 
     for (int i=0; i<transectSegmentsNED.count(); i++) {
-        QList<QGeoCoordinate>   transectCoords;
-        const QList<QPointF>&   transectPoints = transectSegmentsNED[i];
-
-        for (int j=0; j<transectPoints.count(); j++) {
-            QGeoCoordinate coord;
-            const QPointF& point = transectPoints[j];
-            convertNedToGeo(point.y(), point.x(), 0, tangentOrigin, &coord);
-            transectCoords.append(coord);
-        }
-        transectSegmentsGeo.append(transectCoords);
+        transectSegmentsGeo.append(convertLocalPointsToGeo(transectSegmentsNED[i], tangentOrigin));
     }
 }
 
@@ -682,17 +673,10 @@ void SurveyMissionItem::_generateGrid(void)
     // Convert polygon to NED
     QGeoCoordinate tangentOrigin = _mapPolygon.pathModel().value<QGCQGeoCoordinate*>(0)->coordinate();
     qCDebug(SurveyMissionItemLog) << "Convert polygon to NED - tangentOrigin" << tangentOrigin;
-    for (int i=0; i<_mapPolygon.count(); i++) {
-        double y, x, down;
-        QGeoCoordinate vertex = _mapPolygon.pathModel().value<QGCQGeoCoordinate*>(i)->coordinate();
-        if (i == 0) {
-            // This avoids a nan calculation that comes out of convertGeoToNed
-            x = y = 0;
-        } else {
-            convertGeoToNed(vertex, tangentOrigin, &y, &x, &down);
-        }
-        polygonPoints += QPointF(x, y);
-        qCDebug(SurveyMissionItemLog) << "vertex:x:y" << vertex << polygonPoints.last().x() << polygonPoints.last().y();
+    QList<QGeoCoordinate> vertices = _mapPolygon.coordinateList();
+    polygonPoints = convertGeoToLocalPoints(vertices, tangentOrigin);
+    for (int i=0; i<polygonPoints.count(); i++) {
+        qCDebug(SurveyMissionItemLog) << "vertex:x:y" << vertices[i] << polygonPoints[i].x() << polygonPoints[i].y();
     }
 
     polygonPoints = _convexPolygon(polygonPoints);
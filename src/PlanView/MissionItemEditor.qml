@@ -213,7 +213,7 @@ Rectangle {
         anchors.topMargin:  _margin
         anchors.left:       parent.left
         anchors.top:        commandPicker.bottom
-        source:             missionItem.editorQml
+        source:             _currentItem ? missionItem.editorQml : ""   // Editor Facts are only created for the current item
         visible:            _currentItem
 
         property var    masterController:   _masterController
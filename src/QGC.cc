@@ -117,8 +117,40 @@ static const quint32 crctab[] =
     0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
 };
 
+/// Tables for processing eight bytes per step (slicing-by-8). Table 0 is crctab, table n is the crc of a byte
+/// followed by n zero bytes.
+struct Crc32SliceTables
+{
+    Crc32SliceTables(void)
+    {
+        for (int i = 0; i < 256; i++) {
+            table[0][i] = crctab[i];
+        }
+        for (int slice = 1; slice < 8; slice++) {
+            for (int i = 0; i < 256; i++) {
+                quint32 previous = table[slice - 1][i];
+                table[slice][i] = (previous >> 8) ^ crctab[previous & 0xff];
+            }
+        }
+    }
+
+    quint32 table[8][256];
+};
+
 quint32 crc32(const quint8 *src, unsigned len, unsigned state)
 {
+    static const Crc32SliceTables slices;
+    const quint32 (*t)[256] = slices.table;
+
+    // Bytes are assembled explicitly so this works regardless of host byte order and alignment
+    while (len >= 8) {
+        quint32 one = state ^ ((quint32)src[0] | ((quint32)src[1] << 8) | ((quint32)src[2] << 16) | ((quint32)src[3] << 24));
+        quint32 two = (quint32)src[4] | ((quint32)src[5] << 8) | ((quint32)src[6] << 16) | ((quint32)src[7] << 24);
+        state = t[7][one & 0xff] ^ t[6][(one >> 8) & 0xff] ^ t[5][(one >> 16) & 0xff] ^ t[4][one >> 24] ^
+                t[3][two & 0xff] ^ t[2][(two >> 8) & 0xff] ^ t[1][(two >> 16) & 0xff] ^ t[0][two >> 24];
+        src += 8;
+        len -= 8;
+    }
     for (unsigned i = 0; i < len; i++) {
         state = crctab[(state ^ src[i]) & 0xff] ^ (state >> 8);
     }
@@ -24,6 +24,8 @@
 #include <QStyleFactory>
 #include <QAction>
 #include <QStringListModel>
+#include <QQuickWindow>
+#include <QQuickItem>
 
 #ifdef QGC_ENABLE_BLUETOOTH
 #include <QBluetoothLocalDevice>
@@ -65,6 +67,8 @@
 #include "QGroundControlQmlGlobal.h"
 #include "FlightMapSettings.h"
 #include "CoordinateVector.h"
+#include "TrajectoryPoints.h"
+#include "ImageCoverage.h"
 #include "PlanMasterController.h"
 #include "VideoManager.h"
 #include "VideoSurface.h"
@@ -84,6 +88,9 @@
 #include "CameraCalc.h"
 #include "VisualMissionItem.h"
 #include "EditPositionDialogController.h"
+#include "MAVLinkLogManager.h"
+#include "QGCMapEngineManager.h"
+#include "QGCStartupProfiler.h"
 
 #ifndef NO_SERIAL_LINK
 #include "SerialLink.h"
@@ -93,6 +100,7 @@
 #include "QGCQFileDialog.h"
 #include "QGCMessageBox.h"
 #include "FirmwareUpgradeController.h"
+#include "PX4FirmwareBatchFlasher.h"
 #include "MainWindow.h"
 #include "GeoTagController.h"
 #include "MavlinkConsoleController.h"
@@ -119,9 +127,6 @@ const char* QGCApplication::_settingsVersionKey             = "SettingsVersion";
 const char* QGCApplication::_darkStyleFile          = ":/res/styles/style-dark.css";
 const char* QGCApplication::_lightStyleFile         = ":/res/styles/style-light.css";
 
-// Mavlink status structures for entire app
-mavlink_status_t m_mavlink_status[MAVLINK_COMM_NUM_BUFFERS];
-
 // Qml Singleton factories
 
 static QObject* screenToolsControllerSingletonFactory(QQmlEngine*, QJSEngine*)
@@ -169,6 +174,7 @@ QGCApplication::QGCApplication(int &argc, char* argv[], bool unitTesting)
     #endif
     , _toolbox(NULL)
     , _bluetoothAvailable(false)
+    , _firstFrameShown(false)
 {
     _app = this;
 
@@ -226,11 +232,14 @@ QGCApplication::QGCApplication(int &argc, char* argv[], bool unitTesting)
     bool fClearSettingsOptions = false; // Clear stored settings
     bool logging = false;               // Turn on logging
     QString loggingOptions;
+    bool startupTrace = false;          // Write startup trace file
+    QString startupTraceFile;
 
     CmdLineOpt_t rgCmdLineOptions[] = {
         { "--clear-settings",   &fClearSettingsOptions, NULL },
         { "--logging",          &logging,               &loggingOptions },
         { "--fake-mobile",      &_fakeMobile,           NULL },
+        { "--startup-trace",    &startupTrace,          &startupTraceFile },
     #ifdef QT_DEBUG
         { "--test-high-dpi",    &_testHighDPI,          NULL },
     #endif
@@ -239,6 +248,10 @@ QGCApplication::QGCApplication(int &argc, char* argv[], bool unitTesting)
 
     ParseCmdLineOptions(argc, argv, rgCmdLineOptions, sizeof(rgCmdLineOptions)/sizeof(rgCmdLineOptions[0]), false);
 
+    if (startupTrace) {
+        QGCStartupProfiler::instance()->setTraceFile(startupTraceFile.isEmpty() ? QDir::temp().filePath(QStringLiteral("QGCStartupTrace.json")) : startupTraceFile);
+    }
+
     // Set up timer for delayed missing fact display
     _missingParamsDelayedDisplayTimer.setSingleShot(true);
     _missingParamsDelayedDisplayTimer.setInterval(_missingParamsDelayedDisplayTimerTimeout);
@@ -324,10 +337,24 @@ QGCApplication::QGCApplication(int &argc, char* argv[], bool unitTesting)
     }
 
     // Initialize Video Streaming
-    initializeVideoStreaming(argc, argv, savePath.toUtf8().data(), gstDebugLevel.toUtf8().data());
+    {
+        QGCStartupTimer timer("startup", QStringLiteral("initializeVideoStreaming"));
+        initializeVideoStreaming(argc, argv, savePath.toUtf8().data(), gstDebugLevel.toUtf8().data());
+    }
+
+    {
+        QGCStartupTimer timer("startup", QStringLiteral("QGCToolbox"));
+        _toolbox = new QGCToolbox(this);
+    }
+    {
+        QGCStartupTimer timer("startup", QStringLiteral("setChildToolboxes"));
+        _toolbox->setChildToolboxes();
+    }
 
-    _toolbox = new QGCToolbox(this);
-    _toolbox->setChildToolboxes();
+    if (_runningUnitTests) {
+        // Tests expect every tool to be up, there is no first frame to wait for
+        _toolbox->initDeferredTools();
+    }
 }
 
 void QGCApplication::_shutdown(void)
@@ -361,9 +388,12 @@ void QGCApplication::_initCommon(void)
     qmlRegisterType<QGCMapPalette>  ("QGroundControl.Palette", 1, 0, "QGCMapPalette");
 
     qmlRegisterUncreatableType<CoordinateVector>    ("QGroundControl",                      1, 0, "CoordinateVector",       "Reference only");
+    qmlRegisterUncreatableType<TrajectoryPoints>    ("QGroundControl",                      1, 0, "TrajectoryPoints",       "Reference only");
+    qmlRegisterUncreatableType<ImageCoverage>       ("QGroundControl",                      1, 0, "ImageCoverage",          "Reference only");
     qmlRegisterUncreatableType<QmlObjectListModel>  ("QGroundControl",                      1, 0, "QmlObjectListModel",     "Reference only");
     qmlRegisterUncreatableType<MissionCommandTree>  ("QGroundControl",                      1, 0, "MissionCommandTree",     "Reference only");
     qmlRegisterUncreatableType<CameraCalc>          ("QGroundControl",                      1, 0, "CameraCalc",             "Reference only");
+    qmlRegisterUncreatableType<MAVLinkMessageStatistics>("QGroundControl",                  1, 0, "MAVLinkMessageStatistics", "Reference only");
 
     qmlRegisterUncreatableType<AutoPilotPlugin>     ("QGroundControl.AutoPilotPlugin",      1, 0, "AutoPilotPlugin",        "Reference only");
     qmlRegisterUncreatableType<VehicleComponent>    ("QGroundControl.AutoPilotPlugin",      1, 0, "VehicleComponent",       "Reference only");
@@ -397,10 +427,20 @@ void QGCApplication::_initCommon(void)
     qmlRegisterType<ViewWidgetController>           ("QGroundControl.Controllers", 1, 0, "ViewWidgetController");
     qmlRegisterType<CustomCommandWidgetController>  ("QGroundControl.Controllers", 1, 0, "CustomCommandWidgetController");
     qmlRegisterType<FirmwareUpgradeController>      ("QGroundControl.Controllers", 1, 0, "FirmwareUpgradeController");
+    qmlRegisterUncreatableType<PX4FirmwareBatchFlasher>     ("QGroundControl.Controllers", 1, 0, "PX4FirmwareBatchFlasher",     "Reference only");
+    qmlRegisterUncreatableType<PX4FirmwareBatchFlashBoard>  ("QGroundControl.Controllers", 1, 0, "PX4FirmwareBatchFlashBoard",  "Reference only");
     qmlRegisterType<GeoTagController>               ("QGroundControl.Controllers", 1, 0, "GeoTagController");
     qmlRegisterType<MavlinkConsoleController>       ("QGroundControl.Controllers", 1, 0, "MavlinkConsoleController");
 #endif
 
+    // Deferred tools are only initialized when first used, their types need to be known before that
+    qmlRegisterUncreatableType<VideoManager>        ("QGroundControl.VideoManager",         1, 0, "VideoManager",           "Reference only");
+    qmlRegisterUncreatableType<VideoReceiver>       ("QGroundControl",                      1, 0, "VideoReceiver",          "Reference only");
+    qmlRegisterUncreatableType<VideoSurface>        ("QGroundControl",                      1, 0, "VideoSurface",           "Reference only");
+    qmlRegisterUncreatableType<MAVLinkLogManager>   ("QGroundControl.MAVLinkLogManager",    1, 0, "MAVLinkLogManager",      "Reference only");
+    qmlRegisterUncreatableType<ULogStreamDecoder>   ("QGroundControl.MAVLinkLogManager",    1, 0, "ULogStreamDecoder",      "Reference only");
+    qmlRegisterUncreatableType<QGCMapEngineManager> ("QGroundControl.QGCMapEngineManager",  1, 0, "QGCMapEngineManager",    "Reference only");
+
     // Register Qml Singletons
     qmlRegisterSingletonType<QGroundControlQmlGlobal>   ("QGroundControl",                          1, 0, "QGroundControl",         qgroundcontrolQmlGlobalSingletonFactory);
     qmlRegisterSingletonType<ScreenToolsController>     ("QGroundControl.ScreenToolsController",    1, 0, "ScreenToolsController",  screenToolsControllerSingletonFactory);
@@ -416,13 +456,19 @@ bool QGCApplication::_initForNormalAppBoot(void)
     // Exit main application when last window is closed
     connect(this, &QGCApplication::lastWindowClosed, this, QGCApplication::quit);
 
+    {
+        QGCStartupTimer timer("startup", QStringLiteral("Create root window"));
 #ifdef __mobile__
-    _qmlAppEngine = toolbox()->corePlugin()->createRootWindow(this);
+        _qmlAppEngine = toolbox()->corePlugin()->createRootWindow(this);
 #else
-    // Start the user interface
-    MainWindow* mainWindow = MainWindow::_create();
-    Q_CHECK_PTR(mainWindow);
+        // Start the user interface
+        MainWindow* mainWindow = MainWindow::_create();
+        Q_CHECK_PTR(mainWindow);
 #endif
+    }
+
+    // Tools which are not needed for the first frame are initialized after it
+    _waitForFirstFrame();
 
     // Now that main window is up check for lost log files
     connect(this, &QGCApplication::checkForLostLogFiles, toolbox()->mavlinkProtocol(), &MAVLinkProtocol::checkForLostLogFiles);
@@ -453,9 +499,54 @@ bool QGCApplication::_initForNormalAppBoot(void)
 
 bool QGCApplication::_initForUnitTests(void)
 {
+    QGCStartupProfiler::instance()->finish();
     return true;
 }
 
+void QGCApplication::_waitForFirstFrame(void)
+{
+    QObject*        rootObject = _rootQmlObject();
+    QQuickWindow*   window = qobject_cast<QQuickWindow*>(rootObject);
+
+    if (!window) {
+        QQuickItem* rootItem = qobject_cast<QQuickItem*>(rootObject);
+        if (rootItem) {
+            window = rootItem->window();
+        }
+    }
+
+    if (window) {
+        // frameSwapped comes from the render thread
+        connect(window, &QQuickWindow::frameSwapped, this, &QGCApplication::_firstFrameSwapped, Qt::QueuedConnection);
+    } else {
+        qWarning() << "No window for root qml object, not waiting for first frame";
+        QTimer::singleShot(0, this, &QGCApplication::_firstFrameSwapped);
+    }
+}
+
+void QGCApplication::_firstFrameSwapped(void)
+{
+    if (_firstFrameShown) {
+        return;
+    }
+    _firstFrameShown = true;
+
+    QQuickWindow* window = qobject_cast<QQuickWindow*>(sender());
+    if (window) {
+        disconnect(window, &QQuickWindow::frameSwapped, this, &QGCApplication::_firstFrameSwapped);
+    }
+
+    QGCStartupProfiler::instance()->addMarker(QStringLiteral("First frame"));
+
+    connect(_toolbox, &QGCToolbox::deferredToolsInitialized, this, &QGCApplication::_deferredToolsInitialized);
+    _toolbox->startDeferredInit();
+}
+
+void QGCApplication::_deferredToolsInitialized(void)
+{
+    QGCStartupProfiler::instance()->finish();
+}
+
 void QGCApplication::deleteAllSettingsNextBoot(void)
 {
     QSettings settings;
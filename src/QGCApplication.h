@@ -149,9 +149,12 @@ public:
 
 private slots:
     void _missingParamsDisplay(void);
+    void _firstFrameSwapped(void);
+    void _deferredToolsInitialized(void);
 
 private:
     QObject* _rootQmlObject(void);
+    void _waitForFirstFrame(void);
 
 #ifdef __mobile__
     QQmlApplicationEngine* _qmlAppEngine;
@@ -174,6 +177,7 @@ private:
     QGCToolbox* _toolbox;
 
     bool _bluetoothAvailable;
+    bool _firstFrameShown;
 
     static const char* _settingsVersionKey;             ///< Settings key which hold settings version
     static const char* _deleteAllSettingsKey;           ///< If this settings key is set on boot, all settings will be deleted
@@ -8,6 +8,7 @@
  ****************************************************************************/
 
 #include <QDebug>
+#include <QVector>
 
 #include <cmath>
 #include <limits>
@@ -28,67 +29,148 @@
 
 static const float epsilon = std::numeric_limits<double>::epsilon();
 
-void convertGeoToNed(QGeoCoordinate coord, QGeoCoordinate origin, double* x, double* y, double* z)
+GeoProjectionOrigin::GeoProjectionOrigin(const QGeoCoordinate& origin)
+    : coord (origin)
+    , latRad(origin.latitude() * M_DEG_TO_RAD)
+    , lonRad(origin.longitude() * M_DEG_TO_RAD)
+    , sinLat(sin(latRad))
+    , cosLat(cos(latRad))
 {
-    if (coord == origin) {
-        // Short circuit to prevent NaNs in calculation
-        *x = *y = *z = 0;
-        return;
-    }
 
-    double lat_rad = coord.latitude() * M_DEG_TO_RAD;
-    double lon_rad = coord.longitude() * M_DEG_TO_RAD;
+}
 
-    double ref_lon_rad = origin.longitude() * M_DEG_TO_RAD;
-    double ref_lat_rad = origin.latitude() * M_DEG_TO_RAD;
+// Projection math shared by the single point and batch versions so both give the same results.
+// Kept free of branches other than selects, the batch loops call these back to back.
+
+static inline void _geoToNed(const GeoProjectionOrigin& origin, double lat, double lon, double* x, double* y)
+{
+    double lat_rad = lat * M_DEG_TO_RAD;
+    double d_lon_rad = lon * M_DEG_TO_RAD - origin.lonRad;
 
     double sin_lat = sin(lat_rad);
     double cos_lat = cos(lat_rad);
-    double cos_d_lon = cos(lon_rad - ref_lon_rad);
+    double cos_d_lon = cos(d_lon_rad);
 
-    double ref_sin_lat = sin(ref_lat_rad);
-    double ref_cos_lat = cos(ref_lat_rad);
+    // Rounding can push the argument just past 1 for points close to the origin
+    double cos_c = origin.sinLat * sin_lat + origin.cosLat * cos_lat * cos_d_lon;
+    cos_c = cos_c > 1.0 ? 1.0 : (cos_c < -1.0 ? -1.0 : cos_c);
 
-    double c = acos(ref_sin_lat * sin_lat + ref_cos_lat * cos_lat * cos_d_lon);
+    double c = acos(cos_c);
     double k = (fabs(c) < epsilon) ? 1.0 : (c / sin(c));
 
-    *x = k * (ref_cos_lat * sin_lat - ref_sin_lat * cos_lat * cos_d_lon) * CONSTANTS_RADIUS_OF_EARTH;
-    *y = k * cos_lat * sin(lon_rad - ref_lon_rad) * CONSTANTS_RADIUS_OF_EARTH;
-
-    *z = -(coord.altitude() - origin.altitude());
+    *x = k * (origin.cosLat * sin_lat - origin.sinLat * cos_lat * cos_d_lon) * CONSTANTS_RADIUS_OF_EARTH;
+    *y = k * cos_lat * sin(d_lon_rad) * CONSTANTS_RADIUS_OF_EARTH;
 }
 
-void convertNedToGeo(double x, double y, double z, QGeoCoordinate origin, QGeoCoordinate *coord) {
+static inline void _nedToGeo(const GeoProjectionOrigin& origin, double x, double y, double* lat, double* lon)
+{
     double x_rad = x / CONSTANTS_RADIUS_OF_EARTH;
     double y_rad = y / CONSTANTS_RADIUS_OF_EARTH;
     double c = sqrtf(x_rad * x_rad + y_rad * y_rad);
     double sin_c = sin(c);
     double cos_c = cos(c);
 
-    double ref_lon_rad = origin.longitude() * M_DEG_TO_RAD;
-    double ref_lat_rad = origin.latitude() * M_DEG_TO_RAD;
-
-    double ref_sin_lat = sin(ref_lat_rad);
-    double ref_cos_lat = cos(ref_lat_rad);
-
     double lat_rad;
     double lon_rad;
 
     if (fabs(c) > epsilon) {
-        lat_rad = asin(cos_c * ref_sin_lat + (x_rad * sin_c * ref_cos_lat) / c);
-        lon_rad = (ref_lon_rad + atan2(y_rad * sin_c, c * ref_cos_lat * cos_c - x_rad * ref_sin_lat * sin_c));
-
+        lat_rad = asin(cos_c * origin.sinLat + (x_rad * sin_c * origin.cosLat) / c);
+        lon_rad = (origin.lonRad + atan2(y_rad * sin_c, c * origin.cosLat * cos_c - x_rad * origin.sinLat * sin_c));
     } else {
-        lat_rad = ref_lat_rad;
-        lon_rad = ref_lon_rad;
+        lat_rad = origin.latRad;
+        lon_rad = origin.lonRad;
+    }
+
+    *lat = lat_rad * M_RAD_TO_DEG;
+    *lon = lon_rad * M_RAD_TO_DEG;
+}
+
+void convertGeoToNed(QGeoCoordinate coord, QGeoCoordinate origin, double* x, double* y, double* z)
+{
+    if (coord == origin) {
+        // Short circuit to prevent NaNs in calculation
+        *x = *y = *z = 0;
+        return;
     }
 
-    coord->setLatitude(lat_rad * M_RAD_TO_DEG);
-    coord->setLongitude(lon_rad * M_RAD_TO_DEG);
+    _geoToNed(GeoProjectionOrigin(origin), coord.latitude(), coord.longitude(), x, y);
+
+    *z = -(coord.altitude() - origin.altitude());
+}
+
+void convertNedToGeo(double x, double y, double z, QGeoCoordinate origin, QGeoCoordinate *coord) {
+    double lat, lon;
+
+    _nedToGeo(GeoProjectionOrigin(origin), x, y, &lat, &lon);
+
+    coord->setLatitude(lat);
+    coord->setLongitude(lon);
 
     coord->setAltitude(-z + origin.altitude());
 }
 
+void convertGeoToNed(const GeoProjectionOrigin& origin, int count, const double* lat, const double* lon, double* x, double* y)
+{
+    for (int i=0; i<count; i++) {
+        _geoToNed(origin, lat[i], lon[i], &x[i], &y[i]);
+    }
+}
+
+void convertNedToGeo(const GeoProjectionOrigin& origin, int count, const double* x, const double* y, double* lat, double* lon)
+{
+    for (int i=0; i<count; i++) {
+        _nedToGeo(origin, x[i], y[i], &lat[i], &lon[i]);
+    }
+}
+
+QList<QPointF> convertGeoToLocalPoints(const QList<QGeoCoordinate>& coords, const QGeoCoordinate& origin)
+{
+    int             count = coords.count();
+    QVector<double> lat(count);
+    QVector<double> lon(count);
+    QVector<double> north(count);
+    QVector<double> east(count);
+
+    for (int i=0; i<count; i++) {
+        lat[i] = coords[i].latitude();
+        lon[i] = coords[i].longitude();
+    }
+
+    convertGeoToNed(GeoProjectionOrigin(origin), count, lat.constData(), lon.constData(), north.data(), east.data());
+
+    QList<QPointF> points;
+    points.reserve(count);
+    for (int i=0; i<count; i++) {
+        points.append(QPointF(east[i], north[i]));
+    }
+
+    return points;
+}
+
+QList<QGeoCoordinate> convertLocalPointsToGeo(const QList<QPointF>& points, const QGeoCoordinate& origin)
+{
+    int             count = points.count();
+    QVector<double> north(count);
+    QVector<double> east(count);
+    QVector<double> lat(count);
+    QVector<double> lon(count);
+
+    for (int i=0; i<count; i++) {
+        north[i] = points[i].y();
+        east[i] = points[i].x();
+    }
+
+    convertNedToGeo(GeoProjectionOrigin(origin), count, north.constData(), east.constData(), lat.data(), lon.data());
+
+    QList<QGeoCoordinate> coords;
+    coords.reserve(count);
+    for (int i=0; i<count; i++) {
+        coords.append(QGeoCoordinate(lat[i], lon[i], origin.altitude()));
+    }
+
+    return coords;
+}
+
 int convertGeoToUTM(const QGeoCoordinate& coord, double& easting, double& northing)
 {
     return LatLonToUTMXY(coord.latitude(), coord.longitude(), -1 /* zone */, easting, northing);
@@ -19,6 +19,8 @@
 #define QGCGEO_H
 
 #include <QGeoCoordinate>
+#include <QPointF>
+#include <QList>
 
 /**
  * @brief Project a geodetic coordinate on to local tangential plane (LTP) as coordinate with East,
@@ -41,6 +43,56 @@ void convertGeoToNed(QGeoCoordinate coord, QGeoCoordinate origin, double* x, dou
  */
 void convertNedToGeo(double x, double y, double z, QGeoCoordinate origin, QGeoCoordinate *coord);
 
+/**
+ * @brief Origin of a local tangential plane with its trigonometry precomputed. Used by the batch
+ * projection functions below when many points are projected around the same origin.
+ */
+struct GeoProjectionOrigin {
+    GeoProjectionOrigin(const QGeoCoordinate& origin);
+
+    QGeoCoordinate  coord;
+    double          latRad;
+    double          lonRad;
+    double          sinLat;
+    double          cosLat;
+};
+
+/**
+ * @brief Batch version of convertGeoToNed for points which all have the origin altitude. Inputs and
+ * outputs are separate arrays of count values so the loop runs over plain doubles. Results are the
+ * same as from the single point version.
+ * @param[in] origin Precomputed origin for LTP projection.
+ * @param[in] count Number of points.
+ * @param[in] lat Latitudes in degrees.
+ * @param[in] lon Longitudes in degrees.
+ * @param[out] x North components in meters.
+ * @param[out] y East components in meters.
+ */
+void convertGeoToNed(const GeoProjectionOrigin& origin, int count, const double* lat, const double* lon, double* x, double* y);
+
+/**
+ * @brief Batch version of convertNedToGeo, see convertGeoToNed above for the layout.
+ * @param[in] origin Precomputed origin for LTP.
+ * @param[in] count Number of points.
+ * @param[in] x North components in meters.
+ * @param[in] y East components in meters.
+ * @param[out] lat Latitudes in degrees.
+ * @param[out] lon Longitudes in degrees.
+ */
+void convertNedToGeo(const GeoProjectionOrigin& origin, int count, const double* x, const double* y, double* lat, double* lon);
+
+/**
+ * @brief Projects coordinates onto the LTP around origin using the batch projection. Altitude is ignored.
+ * @return Points with x: East, y: North in meters, the layout used by the planning code.
+ */
+QList<QPointF> convertGeoToLocalPoints(const QList<QGeoCoordinate>& coords, const QGeoCoordinate& origin);
+
+/**
+ * @brief Transforms points with x: East, y: North in meters back to geodetic coordinates using the batch
+ * projection. The coordinates get the origin altitude.
+ */
+QList<QGeoCoordinate> convertLocalPointsToGeo(const QList<QPointF>& points, const QGeoCoordinate& origin);
+
 // LatLonToUTMXY
 // Converts a latitude/longitude pair to x and y coordinates in the
 // Universal Transverse Mercator projection.
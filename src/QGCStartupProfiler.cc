@@ -0,0 +1,142 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCStartupProfiler.h"
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+
+QGC_LOGGING_CATEGORY(QGCStartupProfilerLog, "QGCStartupProfilerLog")
+
+QGCStartupProfiler* QGCStartupProfiler::instance(void)
+{
+    static QGCStartupProfiler profiler;
+    return &profiler;
+}
+
+QGCStartupProfiler::QGCStartupProfiler(void)
+    : _finished(0)
+{
+    _elapsed.start();
+}
+
+int QGCStartupProfiler::_threadId(QThread* thread)
+{
+    QHash<QThread*, int>::const_iterator iter = _threadIds.constFind(thread);
+    if (iter == _threadIds.constEnd()) {
+        iter = _threadIds.insert(thread, _threadIds.count() + 1);
+    }
+    return iter.value();
+}
+
+void QGCStartupProfiler::addEvent(const char* category, const QString& name, qint64 startNSecs, qint64 durationNSecs)
+{
+    QMutexLocker lock(&_mutex);
+
+    if (_finished.load()) {
+        return;
+    }
+
+    Event event = { category, name, startNSecs, durationNSecs, _threadId(QThread::currentThread()) };
+    _events.append(event);
+}
+
+void QGCStartupProfiler::addMarker(const QString& name)
+{
+    addEvent(NULL, name, nsecsElapsed(), 0);
+}
+
+QByteArray QGCStartupProfiler::traceJson(void)
+{
+    QMutexLocker    lock(&_mutex);
+    QJsonArray      traceEvents;
+
+    foreach (const Event& event, _events) {
+        QJsonObject traceEvent;
+
+        traceEvent[QStringLiteral("name")] = event.name;
+        traceEvent[QStringLiteral("pid")] = 1;
+        traceEvent[QStringLiteral("tid")] = event.threadId;
+        traceEvent[QStringLiteral("ts")] = event.startNSecs / 1000.0;
+        if (event.category) {
+            traceEvent[QStringLiteral("cat")] = QString::fromLatin1(event.category);
+            traceEvent[QStringLiteral("ph")] = QStringLiteral("X");
+            traceEvent[QStringLiteral("dur")] = event.durationNSecs / 1000.0;
+        } else {
+            traceEvent[QStringLiteral("ph")] = QStringLiteral("i");
+            traceEvent[QStringLiteral("s")] = QStringLiteral("g");
+        }
+        traceEvents.append(traceEvent);
+    }
+
+    QJsonObject trace;
+    trace[QStringLiteral("traceEvents")] = traceEvents;
+    trace[QStringLiteral("displayTimeUnit")] = QStringLiteral("ms");
+
+    return QJsonDocument(trace).toJson(QJsonDocument::Compact);
+}
+
+void QGCStartupProfiler::finish(void)
+{
+    addMarker(QStringLiteral("Startup finished"));
+    {
+        QMutexLocker lock(&_mutex);
+        if (_finished.load()) {
+            return;
+        }
+        _finished.store(1);
+    }
+
+    if (QGCStartupProfilerLog().isDebugEnabled()) {
+        // Events are recorded when they end, so nested events come before the ones containing them
+        foreach (const Event& event, _events) {
+            if (event.category) {
+                qCDebug(QGCStartupProfilerLog) << QString("%1ms").arg(event.durationNSecs / 1.0e6, 8, 'f', 2) << event.category << event.name;
+            } else {
+                qCDebug(QGCStartupProfilerLog) << QString("@%1ms").arg(event.startNSecs / 1.0e6, 7, 'f', 2) << event.name;
+            }
+        }
+    }
+
+    if (!_traceFile.isEmpty()) {
+        QFile file(_traceFile);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(traceJson()) != -1) {
+            qDebug() << "Startup trace written to" << _traceFile;
+        } else {
+            qWarning() << "Unable to write startup trace" << _traceFile << file.errorString();
+        }
+    }
+
+    QMutexLocker lock(&_mutex);
+    _events.clear();
+}
+
+QGCStartupTimer::QGCStartupTimer(const char* category, const QString& name)
+    : _category(category)
+    , _name(name)
+    , _startNSecs(-1)
+{
+    QGCStartupProfiler* profiler = QGCStartupProfiler::instance();
+
+    if (profiler->recording()) {
+        _startNSecs = profiler->nsecsElapsed();
+    }
+}
+
+QGCStartupTimer::~QGCStartupTimer()
+{
+    if (_startNSecs != -1) {
+        QGCStartupProfiler* profiler = QGCStartupProfiler::instance();
+        profiler->addEvent(_category, _name, _startNSecs, profiler->nsecsElapsed() - _startNSecs);
+    }
+}
@@ -0,0 +1,90 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef QGCStartupProfiler_H
+#define QGCStartupProfiler_H
+
+#include "QGCLoggingCategory.h"
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+class QThread;
+
+Q_DECLARE_LOGGING_CATEGORY(QGCStartupProfilerLog)
+
+/// Collects the time spent in each startup phase, tool initialization and resource load up to the point where
+/// startup is finished. With --startup-trace:<file> the events are written as a Chrome trace event file which
+/// can be opened in chrome://tracing or Perfetto. With QGCStartupProfilerLog turned on a summary is logged.
+/// Nothing is recorded after finish, so timers on code which also runs later cost next to nothing.
+class QGCStartupProfiler
+{
+public:
+    static QGCStartupProfiler* instance(void);
+
+    /// Sets the file the trace is written to on finish
+    void setTraceFile(const QString& traceFile) { _traceFile = traceFile; }
+
+    /// Records a completed event. Thread safe.
+    ///     @param category Trace category, for example "construct", "setToolbox" or "load"
+    void addEvent(const char* category, const QString& name, qint64 startNSecs, qint64 durationNSecs);
+
+    /// Records an instant event, for example the first frame
+    void addMarker(const QString& name);
+
+    /// Stops recording, then writes the trace file and summary if enabled
+    void finish(void);
+
+    bool recording(void) const { return _finished.load() == 0; }
+
+    /// @return Nanoseconds since the profiler was created, which is the first thing main does
+    qint64 nsecsElapsed(void) const { return _elapsed.nsecsElapsed(); }
+
+    /// @return Trace in Chrome trace event JSON format
+    QByteArray traceJson(void);
+
+private:
+    QGCStartupProfiler(void);
+
+    struct Event {
+        const char* category;       ///< NULL for instant events
+        QString     name;
+        qint64      startNSecs;
+        qint64      durationNSecs;
+        int         threadId;
+    };
+
+    int _threadId(QThread* thread);
+
+    QElapsedTimer           _elapsed;
+    QMutex                  _mutex;
+    QList<Event>            _events;
+    QHash<QThread*, int>    _threadIds;
+    QString                 _traceFile;
+    QAtomicInt              _finished;
+};
+
+/// Records the time until it goes out of scope with QGCStartupProfiler
+class QGCStartupTimer
+{
+public:
+    QGCStartupTimer(const char* category, const QString& name);
+    ~QGCStartupTimer();
+
+private:
+    const char* _category;
+    QString     _name;
+    qint64      _startNSecs;    ///< -1: profiler was not recording
+};
+
+#endif
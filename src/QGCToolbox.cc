@@ -30,11 +30,24 @@
 #include "QGCOptions.h"
 #include "SettingsManager.h"
 #include "QGCApplication.h"
+#include "QGCStartupProfiler.h"
+
+#include <QTimer>
 
 #if defined(QGC_CUSTOM_BUILD)
 #include CUSTOMHEADER
 #endif
 
+template <class T>
+T* QGCToolbox::_createTool(QGCApplication* app, const char* name, bool deferred)
+{
+    QGCStartupTimer timer("construct", QString::fromLatin1(name));
+
+    T* tool = new T(app, this);
+    _addTool(tool, name, deferred);
+    return tool;
+}
+
 QGCToolbox::QGCToolbox(QGCApplication* app)
     : _audioOutput(NULL)
     , _factSystem(NULL)
@@ -56,56 +69,121 @@ QGCToolbox::QGCToolbox(QGCApplication* app)
     , _mavlinkLogManager(NULL)
     , _corePlugin(NULL)
     , _settingsManager(NULL)
+    , _childToolboxesSet(false)
 {
     // SettingsManager must be first so settings are available to any subsequent tools
-    _settingsManager =          new SettingsManager(app, this);
+    _settingsManager =          _createTool<SettingsManager>        (app, "SettingsManager");
 
     //-- Scan and load plugins
     _scanAndLoadPlugins(app);
-    _audioOutput =              new AudioOutput             (app, this);
-    _factSystem =               new FactSystem              (app, this);
-    _firmwarePluginManager =    new FirmwarePluginManager   (app, this);
+    _audioOutput =              _createTool<AudioOutput>            (app, "AudioOutput");
+    _factSystem =               _createTool<FactSystem>             (app, "FactSystem");
+    _firmwarePluginManager =    _createTool<FirmwarePluginManager>  (app, "FirmwarePluginManager");
 #ifndef __mobile__
-    _gpsManager =               new GPSManager              (app, this);
+    _gpsManager =               _createTool<GPSManager>             (app, "GPSManager");
 #endif
-    _imageProvider =            new QGCImageProvider        (app, this);
-    _joystickManager =          new JoystickManager         (app, this);
-    _linkManager =              new LinkManager             (app, this);
-    _mavlinkProtocol =          new MAVLinkProtocol         (app, this);
-    _missionCommandTree =       new MissionCommandTree      (app, this);
-    _multiVehicleManager =      new MultiVehicleManager     (app, this);
-    _mapEngineManager =         new QGCMapEngineManager     (app, this);
-    _uasMessageHandler =        new UASMessageHandler       (app, this);
-    _qgcPositionManager =       new QGCPositionManager      (app, this);
-    _followMe =                 new FollowMe                (app, this);
-    _videoManager =             new VideoManager            (app, this);
-    _mavlinkLogManager =        new MAVLinkLogManager       (app, this);
+    _imageProvider =            _createTool<QGCImageProvider>       (app, "QGCImageProvider");
+    _joystickManager =          _createTool<JoystickManager>        (app, "JoystickManager");
+    _linkManager =              _createTool<LinkManager>            (app, "LinkManager");
+    _mavlinkProtocol =          _createTool<MAVLinkProtocol>        (app, "MAVLinkProtocol");
+    _missionCommandTree =       _createTool<MissionCommandTree>     (app, "MissionCommandTree",     true /* deferred */);
+    _multiVehicleManager =      _createTool<MultiVehicleManager>    (app, "MultiVehicleManager");
+    _mapEngineManager =         _createTool<QGCMapEngineManager>    (app, "QGCMapEngineManager",    true /* deferred */);
+    _uasMessageHandler =        _createTool<UASMessageHandler>      (app, "UASMessageHandler");
+    _qgcPositionManager =       _createTool<QGCPositionManager>     (app, "QGCPositionManager");
+    _followMe =                 _createTool<FollowMe>               (app, "FollowMe");
+    _videoManager =             _createTool<VideoManager>           (app, "VideoManager",           true /* deferred */);
+    _mavlinkLogManager =        _createTool<MAVLinkLogManager>      (app, "MAVLinkLogManager",      true /* deferred */);
+}
+
+void QGCToolbox::_addTool(QGCTool* tool, const char* name, bool deferred)
+{
+    ToolInfo_t toolInfo = { tool, name, deferred };
+    _tools.append(toolInfo);
 }
 
 void QGCToolbox::setChildToolboxes(void)
 {
-    // SettingsManager must be first so settings are available to any subsequent tools
-    _settingsManager->setToolbox(this);
+    _childToolboxesSet = true;
 
-    _corePlugin->setToolbox(this);
-    _audioOutput->setToolbox(this);
-    _factSystem->setToolbox(this);
-    _firmwarePluginManager->setToolbox(this);
-#ifndef __mobile__
-    _gpsManager->setToolbox(this);
-#endif
-    _imageProvider->setToolbox(this);
-    _joystickManager->setToolbox(this);
-    _linkManager->setToolbox(this);
-    _mavlinkProtocol->setToolbox(this);
-    _missionCommandTree->setToolbox(this);
-    _multiVehicleManager->setToolbox(this);
-    _mapEngineManager->setToolbox(this);
-    _uasMessageHandler->setToolbox(this);
-    _followMe->setToolbox(this);
-    _qgcPositionManager->setToolbox(this);
-    _videoManager->setToolbox(this);
-    _mavlinkLogManager->setToolbox(this);
+    // Creation order: SettingsManager is first so settings are available to any subsequent tools
+    foreach (const ToolInfo_t& toolInfo, _tools) {
+        if (!toolInfo.deferred) {
+            _initTool(toolInfo);
+        }
+    }
+}
+
+void QGCToolbox::_initTool(const ToolInfo_t& toolInfo)
+{
+    if (!toolInfo.tool->toolboxSet()) {
+        QGCStartupTimer timer("setToolbox", QString::fromLatin1(toolInfo.name));
+        toolInfo.tool->setToolbox(this);
+    }
+}
+
+void QGCToolbox::_initDeferredTool(QGCTool* tool)
+{
+    // Nothing but the toolbox is initialized before setChildToolboxes
+    if (!_childToolboxesSet || tool->toolboxSet()) {
+        return;
+    }
+
+    foreach (const ToolInfo_t& toolInfo, _tools) {
+        if (toolInfo.tool == tool) {
+            _initTool(toolInfo);
+            break;
+        }
+    }
+}
+
+void QGCToolbox::startDeferredInit(void)
+{
+    QTimer::singleShot(0, this, &QGCToolbox::_initNextDeferredTool);
+}
+
+void QGCToolbox::_initNextDeferredTool(void)
+{
+    foreach (const ToolInfo_t& toolInfo, _tools) {
+        if (toolInfo.deferred && !toolInfo.tool->toolboxSet()) {
+            _initTool(toolInfo);
+            QTimer::singleShot(0, this, &QGCToolbox::_initNextDeferredTool);
+            return;
+        }
+    }
+
+    emit deferredToolsInitialized();
+}
+
+void QGCToolbox::initDeferredTools(void)
+{
+    foreach (const ToolInfo_t& toolInfo, _tools) {
+        _initTool(toolInfo);
+    }
+}
+
+MissionCommandTree* QGCToolbox::missionCommandTree(void)
+{
+    _initDeferredTool(_missionCommandTree);
+    return _missionCommandTree;
+}
+
+QGCMapEngineManager* QGCToolbox::mapEngineManager(void)
+{
+    _initDeferredTool(_mapEngineManager);
+    return _mapEngineManager;
+}
+
+VideoManager* QGCToolbox::videoManager(void)
+{
+    _initDeferredTool(_videoManager);
+    return _videoManager;
+}
+
+MAVLinkLogManager* QGCToolbox::mavlinkLogManager(void)
+{
+    _initDeferredTool(_mavlinkLogManager);
+    return _mavlinkLogManager;
 }
 
 void QGCToolbox::_scanAndLoadPlugins(QGCApplication* app)
@@ -114,11 +192,13 @@ void QGCToolbox::_scanAndLoadPlugins(QGCApplication* app)
     //-- Create custom plugin (Static)
     _corePlugin = (QGCCorePlugin*) new CUSTOMCLASS(app, app->toolbox());
     if(_corePlugin) {
+        _addTool(_corePlugin, "QGCCorePlugin");
         return;
     }
 #endif
     //-- No plugins found, use default instance
     _corePlugin = new QGCCorePlugin(app, app->toolbox());
+    _addTool(_corePlugin, "QGCCorePlugin");
 }
 
 QGCTool::QGCTool(QGCApplication* app, QGCToolbox* toolbox)
@@ -12,6 +12,7 @@
 #define QGCToolbox_h
 
 #include <QObject>
+#include <QList>
 
 class FactSystem;
 class FirmwarePluginManager;
@@ -32,6 +33,7 @@ class VideoManager;
 class MAVLinkLogManager;
 class QGCCorePlugin;
 class SettingsManager;
+class QGCTool;
 
 /// This is used to manage all of our top level services/tools
 class QGCToolbox : public QObject {
@@ -45,15 +47,15 @@ public:
     JoystickManager*            joystickManager(void)           { return _joystickManager; }
     LinkManager*                linkManager(void)               { return _linkManager; }
     MAVLinkProtocol*            mavlinkProtocol(void)           { return _mavlinkProtocol; }
-    MissionCommandTree*         missionCommandTree(void)        { return _missionCommandTree; }
+    MissionCommandTree*         missionCommandTree(void);
     MultiVehicleManager*        multiVehicleManager(void)       { return _multiVehicleManager; }
-    QGCMapEngineManager*        mapEngineManager(void)          { return _mapEngineManager; }
+    QGCMapEngineManager*        mapEngineManager(void);
     QGCImageProvider*           imageProvider()                 { return _imageProvider; }
     UASMessageHandler*          uasMessageHandler(void)         { return _uasMessageHandler; }
     FollowMe*                   followMe(void)                  { return _followMe; }
     QGCPositionManager*         qgcPositionManager(void)        { return _qgcPositionManager; }
-    VideoManager*               videoManager(void)              { return _videoManager; }
-    MAVLinkLogManager*          mavlinkLogManager(void)         { return _mavlinkLogManager; }
+    VideoManager*               videoManager(void);
+    MAVLinkLogManager*          mavlinkLogManager(void);
     QGCCorePlugin*              corePlugin(void)                { return _corePlugin; }
     SettingsManager*            settingsManager(void)           { return _settingsManager; }
 
@@ -61,9 +63,40 @@ public:
     GPSManager*                 gpsManager(void)                { return _gpsManager; }
 #endif
 
+    /// Initializes the deferred tools which have not been used yet, one per pass through the event loop so the
+    /// user interface stays responsive. deferredToolsInitialized is signalled once they are all done.
+    void startDeferredInit(void);
+
+    /// Initializes all deferred tools which have not been used yet right away
+    void initDeferredTools(void);
+
+signals:
+    void deferredToolsInitialized(void);
+
+private slots:
+    void _initNextDeferredTool(void);
+
 private:
+    /// Deferred tools are not needed for the first frame. Their setToolbox is called by startDeferredInit, or
+    /// when they are first asked for through the toolbox if that comes earlier. So a tool which depends on a
+    /// deferred tool pulls it in, as long as it gets it through the toolbox accessor.
+    typedef struct {
+        QGCTool*    tool;
+        const char* name;
+        bool        deferred;
+    } ToolInfo_t;
+
     void setChildToolboxes(void);
     void _scanAndLoadPlugins(QGCApplication *app);
+    void _addTool(QGCTool* tool, const char* name, bool deferred = false);
+    void _initTool(const ToolInfo_t& toolInfo);
+    void _initDeferredTool(QGCTool* tool);
+
+    template <class T>
+    T* _createTool(QGCApplication* app, const char* name, bool deferred = false);
+
+    QList<ToolInfo_t>           _tools;                 ///< In creation order, which is also the setToolbox order
+    bool                        _childToolboxesSet;
 
 
     AudioOutput*                _audioOutput;
@@ -103,6 +136,9 @@ public:
     // If you override this method, you must call the base class.
     virtual void setToolbox(QGCToolbox* toolbox);
 
+    /// @return true: setToolbox has been called
+    bool toolboxSet(void) const { return _toolbox != NULL; }
+
 protected:
     QGCApplication* _app;
     QGCToolbox*     _toolbox;
@@ -28,7 +28,7 @@ EditPositionDialogController::EditPositionDialogController(void)
     , _northingFact     (0, _northingFactName,      FactMetaData::valueTypeDouble)
 {
     if (_metaDataMap.isEmpty()) {
-        _metaDataMap = FactMetaData::createMapFromJsonFile(QStringLiteral(":/json/EditPositionDialog.FactMetaData.json"), NULL /* QObject parent */);
+        _metaDataMap = FactMetaData::sharedMapFromJsonFile(QStringLiteral(":/json/EditPositionDialog.FactMetaData.json"));
     }
 
     _latitudeFact.setMetaData   (_metaDataMap[_latitudeFactName]);
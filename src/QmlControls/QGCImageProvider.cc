@@ -18,6 +18,8 @@
 
 
 #include "QGCImageProvider.h"
+#include "MultiVehicleManager.h"
+#include "Vehicle.h"
 
 #include <QPainter>
 #include <QFont>
@@ -47,8 +49,19 @@ void QGCImageProvider::setToolbox(QGCToolbox *toolbox)
    painter.drawText(QRectF(0, 0, 320, 240), Qt::AlignCenter, "Waiting...");
 }
 
-QImage QGCImageProvider::requestImage(const QString & /* image url with vehicle id*/, QSize *, const QSize &)
+QImage QGCImageProvider::requestImage(const QString & id, QSize * size, const QSize &)
 {
+    // Image coverage overlay: "image://QGCImages/coverage/vvv/iii"
+    QStringList parts = id.split(QLatin1Char('/'));
+    if (parts.count() == 3 && parts[0] == QLatin1String("coverage")) {
+        Vehicle* vehicle = _toolbox->multiVehicleManager()->getVehicleById(parts[1].toInt());
+        QImage image = vehicle ? vehicle->imageCoverage()->image() : QImage();
+        if (size) {
+            *size = image.size();
+        }
+        return image;
+    }
+
 /*
     The QML side will request an image using a special URL, which we've registered as QGCImages.
     The URL follows this format (or anything you want to make out of it after the "QGCImages" part):
@@ -32,11 +32,7 @@ QGroundControlQmlGlobal::QGroundControlQmlGlobal(QGCApplication* app, QGCToolbox
     , _flightMapInitialZoom(17.0)
     , _linkManager(NULL)
     , _multiVehicleManager(NULL)
-    , _mapEngineManager(NULL)
     , _qgcPositionManager(NULL)
-    , _missionCommandTree(NULL)
-    , _videoManager(NULL)
-    , _mavlinkLogManager(NULL)
     , _corePlugin(NULL)
     , _firmwarePluginManager(NULL)
     , _settingsManager(NULL)
@@ -68,11 +64,7 @@ void QGroundControlQmlGlobal::setToolbox(QGCToolbox* toolbox)
 
     _linkManager            = toolbox->linkManager();
     _multiVehicleManager    = toolbox->multiVehicleManager();
-    _mapEngineManager       = toolbox->mapEngineManager();
     _qgcPositionManager     = toolbox->qgcPositionManager();
-    _missionCommandTree     = toolbox->missionCommandTree();
-    _videoManager           = toolbox->videoManager();
-    _mavlinkLogManager      = toolbox->mavlinkLogManager();
     _corePlugin             = toolbox->corePlugin();
     _firmwarePluginManager  = toolbox->firmwarePluginManager();
     _settingsManager        = toolbox->settingsManager();
@@ -161,6 +153,15 @@ void QGroundControlQmlGlobal::startAPMArduSubMockLink(bool sendStatusText)
 #endif
 }
 
+void QGroundControlQmlGlobal::startSwarmMockLink(int swarmVehicleCount)
+{
+#ifdef QT_DEBUG
+    MockLink::startSwarmMockLink(swarmVehicleCount);
+#else
+    Q_UNUSED(swarmVehicleCount);
+#endif
+}
+
 void QGroundControlQmlGlobal::stopOneMockLink(void)
 {
 #ifdef QT_DEBUG
@@ -184,6 +185,12 @@ void QGroundControlQmlGlobal::setIsVersionCheckEnabled(bool enable)
     emit isVersionCheckEnabledChanged(enable);
 }
 
+void QGroundControlQmlGlobal::setIsTimesyncEnabled(bool enable)
+{
+    qgcApp()->toolbox()->mavlinkProtocol()->enableTimesync(enable);
+    emit isTimesyncEnabledChanged(enable);
+}
+
 void QGroundControlQmlGlobal::setMavlinkSystemID(int id)
 {
     qgcApp()->toolbox()->mavlinkProtocol()->setSystemId(id);
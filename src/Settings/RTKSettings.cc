@@ -15,11 +15,27 @@
 const char* RTKSettings::RTKSettingsGroupName =                 "RTK";
 const char* RTKSettings::surveyInAccuracyLimitName =            "SurveyInAccuracyLimit";
 const char* RTKSettings::surveyInMinObservationDurationName =   "SurveyInMinObservationDuration";
+const char* RTKSettings::ntripServerConnectEnabledName =        "NtripServerConnectEnabled";
+const char* RTKSettings::ntripServerHostAddressName =           "NtripServerHostAddress";
+const char* RTKSettings::ntripServerPortName =                  "NtripServerPort";
+const char* RTKSettings::ntripMountpointName =                  "NtripMountpoint";
+const char* RTKSettings::ntripUsernameName =                    "NtripUsername";
+const char* RTKSettings::ntripPasswordName =                    "NtripPassword";
+const char* RTKSettings::ntripWhitelistName =                   "NtripWhitelist";
+const char* RTKSettings::ntripBandwidthLimitName =              "NtripBandwidthLimit";
 
 RTKSettings::RTKSettings(QObject* parent)
     : SettingsGroup(RTKSettingsGroupName, QString(RTKSettingsGroupName), parent)
     , _surveyInAccuracyLimitFact(NULL)
     , _surveyInMinObservationDurationFact(NULL)
+    , _ntripServerConnectEnabledFact(NULL)
+    , _ntripServerHostAddressFact(NULL)
+    , _ntripServerPortFact(NULL)
+    , _ntripMountpointFact(NULL)
+    , _ntripUsernameFact(NULL)
+    , _ntripPasswordFact(NULL)
+    , _ntripWhitelistFact(NULL)
+    , _ntripBandwidthLimitFact(NULL)
 {
     QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
     qmlRegisterUncreatableType<RTKSettings>("QGroundControl.SettingsManager", 1, 0, "RTKSettings", "Reference only");
@@ -42,3 +58,75 @@ Fact* RTKSettings::surveyInMinObservationDuration(void)
 
     return _surveyInMinObservationDurationFact;
 }
+
+Fact* RTKSettings::ntripServerConnectEnabled(void)
+{
+    if (!_ntripServerConnectEnabledFact) {
+        _ntripServerConnectEnabledFact = _createSettingsFact(ntripServerConnectEnabledName);
+    }
+
+    return _ntripServerConnectEnabledFact;
+}
+
+Fact* RTKSettings::ntripServerHostAddress(void)
+{
+    if (!_ntripServerHostAddressFact) {
+        _ntripServerHostAddressFact = _createSettingsFact(ntripServerHostAddressName);
+    }
+
+    return _ntripServerHostAddressFact;
+}
+
+Fact* RTKSettings::ntripServerPort(void)
+{
+    if (!_ntripServerPortFact) {
+        _ntripServerPortFact = _createSettingsFact(ntripServerPortName);
+    }
+
+    return _ntripServerPortFact;
+}
+
+Fact* RTKSettings::ntripMountpoint(void)
+{
+    if (!_ntripMountpointFact) {
+        _ntripMountpointFact = _createSettingsFact(ntripMountpointName);
+    }
+
+    return _ntripMountpointFact;
+}
+
+Fact* RTKSettings::ntripUsername(void)
+{
+    if (!_ntripUsernameFact) {
+        _ntripUsernameFact = _createSettingsFact(ntripUsernameName);
+    }
+
+    return _ntripUsernameFact;
+}
+
+Fact* RTKSettings::ntripPassword(void)
+{
+    if (!_ntripPasswordFact) {
+        _ntripPasswordFact = _createSettingsFact(ntripPasswordName);
+    }
+
+    return _ntripPasswordFact;
+}
+
+Fact* RTKSettings::ntripWhitelist(void)
+{
+    if (!_ntripWhitelistFact) {
+        _ntripWhitelistFact = _createSettingsFact(ntripWhitelistName);
+    }
+
+    return _ntripWhitelistFact;
+}
+
+Fact* RTKSettings::ntripBandwidthLimit(void)
+{
+    if (!_ntripBandwidthLimitFact) {
+        _ntripBandwidthLimitFact = _createSettingsFact(ntripBandwidthLimitName);
+    }
+
+    return _ntripBandwidthLimitFact;
+}
@@ -20,16 +20,48 @@ public:
 
     Q_PROPERTY(Fact* surveyInAccuracyLimit          READ surveyInAccuracyLimit          CONSTANT)
     Q_PROPERTY(Fact* surveyInMinObservationDuration READ surveyInMinObservationDuration CONSTANT)
+    Q_PROPERTY(Fact* ntripServerConnectEnabled      READ ntripServerConnectEnabled      CONSTANT)
+    Q_PROPERTY(Fact* ntripServerHostAddress         READ ntripServerHostAddress         CONSTANT)
+    Q_PROPERTY(Fact* ntripServerPort                READ ntripServerPort                CONSTANT)
+    Q_PROPERTY(Fact* ntripMountpoint                READ ntripMountpoint                CONSTANT)
+    Q_PROPERTY(Fact* ntripUsername                  READ ntripUsername                  CONSTANT)
+    Q_PROPERTY(Fact* ntripPassword                  READ ntripPassword                  CONSTANT)
+    Q_PROPERTY(Fact* ntripWhitelist                 READ ntripWhitelist                 CONSTANT)
+    Q_PROPERTY(Fact* ntripBandwidthLimit            READ ntripBandwidthLimit            CONSTANT)
 
     Fact* surveyInAccuracyLimit         (void);
     Fact* surveyInMinObservationDuration(void);
+    Fact* ntripServerConnectEnabled     (void);
+    Fact* ntripServerHostAddress        (void);
+    Fact* ntripServerPort               (void);
+    Fact* ntripMountpoint               (void);
+    Fact* ntripUsername                 (void);
+    Fact* ntripPassword                 (void);
+    Fact* ntripWhitelist                (void);
+    Fact* ntripBandwidthLimit           (void);
 
     static const char* RTKSettingsGroupName;
 
     static const char* surveyInAccuracyLimitName;
     static const char* surveyInMinObservationDurationName;
+    static const char* ntripServerConnectEnabledName;
+    static const char* ntripServerHostAddressName;
+    static const char* ntripServerPortName;
+    static const char* ntripMountpointName;
+    static const char* ntripUsernameName;
+    static const char* ntripPasswordName;
+    static const char* ntripWhitelistName;
+    static const char* ntripBandwidthLimitName;
 
 private:
     SettingsFact* _surveyInAccuracyLimitFact;
     SettingsFact* _surveyInMinObservationDurationFact;
+    SettingsFact* _ntripServerConnectEnabledFact;
+    SettingsFact* _ntripServerHostAddressFact;
+    SettingsFact* _ntripServerPortFact;
+    SettingsFact* _ntripMountpointFact;
+    SettingsFact* _ntripUsernameFact;
+    SettingsFact* _ntripPasswordFact;
+    SettingsFact* _ntripWhitelistFact;
+    SettingsFact* _ntripBandwidthLimitFact;
 };
@@ -32,6 +32,8 @@ const char* VideoSettings::enableStorageLimitName = "EnableStorageLimit";
 const char* VideoSettings::rtspTimeoutName =        "RtspTimeout";
 const char* VideoSettings::streamEnabledName =      "StreamEnabled";
 const char* VideoSettings::disableWhenDisarmedName ="DisableWhenDisarmed";
+const char* VideoSettings::showLatencyOverlayName = "ShowLatencyOverlay";
+const char* VideoSettings::lowLatencyModeName =     "LowLatencyMode";
 
 const char* VideoSettings::videoSourceNoVideo =     "No Video Available";
 const char* VideoSettings::videoDisabled =          "Video Stream Disabled";
@@ -54,6 +56,8 @@ VideoSettings::VideoSettings(QObject* parent)
     , _rtspTimeoutFact(NULL)
     , _streamEnabledFact(NULL)
     , _disableWhenDisarmedFact(NULL)
+    , _showLatencyOverlayFact(NULL)
+    , _lowLatencyModeFact(NULL)
 {
     QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
     qmlRegisterUncreatableType<VideoSettings>("QGroundControl.SettingsManager", 1, 0, "VideoSettings", "Reference only");
@@ -202,6 +206,22 @@ Fact* VideoSettings::disableWhenDisarmed(void)
     return _disableWhenDisarmedFact;
 }
 
+Fact* VideoSettings::showLatencyOverlay(void)
+{
+    if (!_showLatencyOverlayFact) {
+        _showLatencyOverlayFact = _createSettingsFact(showLatencyOverlayName);
+    }
+    return _showLatencyOverlayFact;
+}
+
+Fact* VideoSettings::lowLatencyMode(void)
+{
+    if (!_lowLatencyModeFact) {
+        _lowLatencyModeFact = _createSettingsFact(lowLatencyModeName);
+    }
+    return _lowLatencyModeFact;
+}
+
 bool VideoSettings::streamConfigured(void)
 {
 #if !defined(QGC_GST_STREAMING)
@@ -32,6 +32,8 @@ public:
     Q_PROPERTY(Fact* rtspTimeout            READ rtspTimeout            CONSTANT)
     Q_PROPERTY(Fact* streamEnabled          READ streamEnabled          CONSTANT)
     Q_PROPERTY(Fact* disableWhenDisarmed    READ disableWhenDisarmed    CONSTANT)
+    Q_PROPERTY(Fact* showLatencyOverlay     READ showLatencyOverlay     CONSTANT)
+    Q_PROPERTY(Fact* lowLatencyMode         READ lowLatencyMode         CONSTANT)
     Q_PROPERTY(bool  streamConfigured       READ streamConfigured       NOTIFY streamConfiguredChanged)
 
     Fact* videoSource           (void);
@@ -47,6 +49,8 @@ public:
     Fact* rtspTimeout           (void);
     Fact* streamEnabled         (void);
     Fact* disableWhenDisarmed   (void);
+    Fact* showLatencyOverlay    (void);
+    Fact* lowLatencyMode        (void);
     bool  streamConfigured      (void);
 
     static const char* videoSettingsGroupName;
@@ -64,6 +68,8 @@ public:
     static const char* rtspTimeoutName;
     static const char* streamEnabledName;
     static const char* disableWhenDisarmedName;
+    static const char* showLatencyOverlayName;
+    static const char* lowLatencyModeName;
 
     static const char* videoSourceNoVideo;
     static const char* videoDisabled;
@@ -91,6 +97,8 @@ private:
     SettingsFact* _rtspTimeoutFact;
     SettingsFact* _streamEnabledFact;
     SettingsFact* _disableWhenDisarmedFact;
+    SettingsFact* _showLatencyOverlayFact;
+    SettingsFact* _lowLatencyModeFact;
 };
 
 #endif
@@ -0,0 +1,397 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ImageCoverage.h"
+#include "CameraSpec.h"
+
+#include <QtMath>
+
+#include <algorithm>
+#include <string.h>
+
+const double ImageCoverage::_metersPerDegreeLatitude = 111319.49;
+
+ImageCoverage::Camera::Camera(CameraSpec* cameraSpec, double distanceToSurface)
+    : sensorWidth       (cameraSpec->sensorWidth()->rawValue().toDouble())
+    , sensorHeight      (cameraSpec->sensorHeight()->rawValue().toDouble())
+    , focalLength       (cameraSpec->focalLength()->rawValue().toDouble())
+    , landscape         (cameraSpec->landscape()->rawValue().toBool())
+    , distanceToSurface (distanceToSurface)
+{
+
+}
+
+ImageCoverage::ImageCoverage(QObject* parent)
+    : QObject(parent)
+    , _originLatitude(0)
+    , _originLongitude(0)
+    , _metersPerDegreeLongitude(_metersPerDegreeLatitude)
+    , _cellSize(0)
+    , _west(0)
+    , _north(0)
+    , _columns(0)
+    , _rows(0)
+    , _tileColumns(0)
+    , _surveyCells(0)
+    , _surveyCoveredCells(0)
+    , _surveyOverlapCells(0)
+    , _captureCount(0)
+    , _imageIndex(0)
+{
+    // Gaps in red, then yellow to green with more overlap. Coverage outside of the survey area in blue.
+    _palette[0][0] = qRgba(0, 0, 0, 0);
+    _palette[0][1] = _palette[0][2] = _palette[0][3] = qPremultiply(qRgba(0, 128, 255, 64));
+    _palette[1][0] = qPremultiply(qRgba(255, 0, 0, 96));
+    _palette[1][1] = qPremultiply(qRgba(255, 255, 0, 96));
+    _palette[1][2] = qPremultiply(qRgba(128, 255, 0, 96));
+    _palette[1][3] = qPremultiply(qRgba(0, 200, 0, 96));
+
+    _imageUpdateTimer.setSingleShot(true);
+    _imageUpdateTimer.setInterval(cImageUpdateMSecs);
+    connect(&_imageUpdateTimer, &QTimer::timeout, this, &ImageCoverage::_updateImage);
+}
+
+ImageCoverage::~ImageCoverage()
+{
+    _clearTiles();
+}
+
+void ImageCoverage::_clearTiles(void)
+{
+    qDeleteAll(_tiles);
+    _tiles.fill(NULL);
+}
+
+QGeoCoordinate ImageCoverage::topLeft(void) const
+{
+    if (!valid()) {
+        return QGeoCoordinate();
+    }
+    return QGeoCoordinate(_originLatitude + (_north / _metersPerDegreeLatitude), _originLongitude + (_west / _metersPerDegreeLongitude));
+}
+
+double ImageCoverage::coveredPercent(void) const
+{
+    return _surveyCells ? (100.0 * _surveyCoveredCells) / _surveyCells : 0;
+}
+
+double ImageCoverage::overlapPercent(void) const
+{
+    return _surveyCells ? (100.0 * _surveyOverlapCells) / _surveyCells : 0;
+}
+
+double ImageCoverage::gapArea(void) const
+{
+    return (_surveyCells - _surveyCoveredCells) * _cellSize * _cellSize;
+}
+
+ImageCoverage::Vector ImageCoverage::_local(const QGeoCoordinate& coordinate) const
+{
+    // Flat projection around the first survey vertex, plenty for the size of a survey
+    Vector vector;
+
+    vector.x = (coordinate.longitude() - _originLongitude) * _metersPerDegreeLongitude;
+    vector.y = (coordinate.latitude() - _originLatitude) * _metersPerDegreeLatitude;
+
+    return vector;
+}
+
+void ImageCoverage::setSurvey(const QList<QList<QGeoCoordinate> >& polygons, const Camera& camera)
+{
+    clearSurvey();
+
+    if (polygons.isEmpty() || polygons[0].isEmpty() || !camera.isValid()) {
+        return;
+    }
+
+    _camera = camera;
+    _originLatitude = polygons[0][0].latitude();
+    _originLongitude = polygons[0][0].longitude();
+    _metersPerDegreeLongitude = _metersPerDegreeLatitude * qCos(qDegreesToRadians(_originLatitude));
+
+    QList<QVector<Vector> > localPolygons;
+    double west = 0, east = 0, south = 0, north = 0;
+    foreach (const QList<QGeoCoordinate>& polygon, polygons) {
+        QVector<Vector> localPolygon;
+        foreach (const QGeoCoordinate& coordinate, polygon) {
+            Vector vector = _local(coordinate);
+            west =  qMin(west, vector.x);
+            east =  qMax(east, vector.x);
+            south = qMin(south, vector.y);
+            north = qMax(north, vector.y);
+            localPolygon.append(vector);
+        }
+        localPolygons.append(localPolygon);
+    }
+
+    // Leave room for the footprints of the images taken along the edges of the survey
+    double footprintWidth =     _camera.distanceToSurface * _camera.sensorWidth / _camera.focalLength;
+    double footprintHeight =    _camera.distanceToSurface * _camera.sensorHeight / _camera.focalLength;
+    double margin =             qMax(footprintWidth, footprintHeight);
+    double width =              (east - west) + (2 * margin);
+    double height =             (north - south) + (2 * margin);
+
+    _cellSize = qMin(footprintWidth, footprintHeight) / cCellsPerFootprint;
+    if ((width / _cellSize) * (height / _cellSize) > cMaxCells) {
+        _cellSize = qSqrt((width * height) / cMaxCells);
+    }
+
+    _west =         west - margin;
+    _north =        north + margin;
+    _columns =      qMax(1, qCeil(width / _cellSize));
+    _rows =         qMax(1, qCeil(height / _cellSize));
+    _tileColumns =  (_columns + cTileSize - 1) / cTileSize;
+    _tiles.fill(NULL, _tileColumns * ((_rows + cTileSize - 1) / cTileSize));
+    _surveyMask.fill(false, _columns * _rows);
+
+    foreach (const QVector<Vector>& localPolygon, localPolygons) {
+        _rasterize(localPolygon, true /* mask */);
+    }
+    _resetImage();
+
+    emit surveyChanged();
+    emit coverageChanged();
+    _updateImage();
+}
+
+void ImageCoverage::clearSurvey(void)
+{
+    bool wasValid = valid();
+
+    _clearTiles();
+    _tiles.clear();
+    _surveyMask.clear();
+    _image = QImage();
+    _camera = Camera();
+    _cellSize = 0;
+    _columns = _rows = _tileColumns = 0;
+    _surveyCells = _surveyCoveredCells = _surveyOverlapCells = 0;
+    _captureCount = 0;
+
+    if (wasValid) {
+        emit surveyChanged();
+        emit coverageChanged();
+        _updateImage();
+    }
+}
+
+void ImageCoverage::clear(void)
+{
+    if (!valid() || _captureCount == 0) {
+        return;
+    }
+
+    _clearTiles();
+    _surveyCoveredCells = _surveyOverlapCells = 0;
+    _captureCount = 0;
+    _resetImage();
+
+    emit coverageChanged();
+    _updateImage();
+}
+
+void ImageCoverage::_resetImage(void)
+{
+    _image = QImage(_columns, _rows, QImage::Format_ARGB32_Premultiplied);
+
+    for (int row=0; row<_rows; row++) {
+        QRgb* line = (QRgb*)_image.scanLine(row);
+        for (int column=0; column<_columns; column++) {
+            line[column] = _palette[_surveyMask.testBit((row * _columns) + column)][0];
+        }
+    }
+}
+
+void ImageCoverage::_updateImage(void)
+{
+    _imageUpdateTimer.stop();
+    emit imageIndexChanged(++_imageIndex);
+}
+
+bool ImageCoverage::addCapture(const QGeoCoordinate& coordinate, double altitudeAboveSurface, double roll, double pitch, double yaw)
+{
+    if (!valid() || !coordinate.isValid() || altitudeAboveSurface <= 0) {
+        return false;
+    }
+
+    // Rotation from camera to north/east/down
+    double cr = qCos(qDegreesToRadians(roll)),  sr = qSin(qDegreesToRadians(roll));
+    double cp = qCos(qDegreesToRadians(pitch)), sp = qSin(qDegreesToRadians(pitch));
+    double cy = qCos(qDegreesToRadians(yaw)),   sy = qSin(qDegreesToRadians(yaw));
+    double r[3][3] = {
+        { cp * cy,  (sr * sp * cy) - (cr * sy), (cr * sp * cy) + (sr * sy) },
+        { cp * sy,  (sr * sp * sy) + (cr * cy), (cr * sp * sy) - (sr * cy) },
+        { -sp,      sr * cp,                    cr * cp },
+    };
+
+    // Directions to the image corners: x towards the top of the image, y to the right, z along the optical axis
+    double frontal =    (_camera.landscape ? _camera.sensorHeight : _camera.sensorWidth) / (2 * _camera.focalLength);
+    double side =       (_camera.landscape ? _camera.sensorWidth : _camera.sensorHeight) / (2 * _camera.focalLength);
+    double corners[4][2] = { { frontal, -side }, { frontal, side }, { -frontal, side }, { -frontal, -side } };
+
+    Vector          position = _local(coordinate);
+    QVector<Vector> footprint;
+
+    for (int i=0; i<4; i++) {
+        double north =  (r[0][0] * corners[i][0]) + (r[0][1] * corners[i][1]) + r[0][2];
+        double east =   (r[1][0] * corners[i][0]) + (r[1][1] * corners[i][1]) + r[1][2];
+        double down =   (r[2][0] * corners[i][0]) + (r[2][1] * corners[i][1]) + r[2][2];
+
+        // A corner at or above the horizon has no footprint on the ground
+        if (down < 0.1) {
+            return false;
+        }
+
+        Vector corner;
+        corner.x = position.x + ((east / down) * altitudeAboveSurface);
+        corner.y = position.y + ((north / down) * altitudeAboveSurface);
+        footprint.append(corner);
+    }
+
+    _rasterize(footprint, false /* mask */);
+    _captureCount++;
+
+    emit coverageChanged();
+    if (!_imageUpdateTimer.isActive()) {
+        _imageUpdateTimer.start();
+    }
+
+    return true;
+}
+
+/// Scan converts the polygon (even-odd) with cell centers as sample points
+///     @param mask true: add the cells to the survey mask, false: add the cells to the coverage
+void ImageCoverage::_rasterize(const QVector<Vector>& polygon, bool mask)
+{
+    QVector<Vector> cellPolygon;
+    double          top =       _rows;
+    double          bottom =    -1;
+
+    foreach (const Vector& vector, polygon) {
+        // Cell coordinates, cell centers are at whole numbers
+        Vector cell;
+        cell.x = ((vector.x - _west) / _cellSize) - 0.5;
+        cell.y = ((_north - vector.y) / _cellSize) - 0.5;
+        top =       qMin(top, cell.y);
+        bottom =    qMax(bottom, cell.y);
+        cellPolygon.append(cell);
+    }
+
+    int firstRow =  qMax(0, qCeil(top));
+    int lastRow =   qMin(_rows - 1, qFloor(bottom));
+
+    QVector<double> crossings;
+    for (int row=firstRow; row<=lastRow; row++) {
+        crossings.clear();
+        for (int i=0; i<cellPolygon.count(); i++) {
+            const Vector& v1 = cellPolygon[i];
+            const Vector& v2 = cellPolygon[(i + 1) % cellPolygon.count()];
+            if ((v1.y <= row && v2.y > row) || (v2.y <= row && v1.y > row)) {
+                crossings.append(v1.x + (((row - v1.y) / (v2.y - v1.y)) * (v2.x - v1.x)));
+            }
+        }
+        std::sort(crossings.begin(), crossings.end());
+        for (int i=0; i+1<crossings.count(); i+=2) {
+            _fillSpan(row, crossings[i], crossings[i + 1], mask);
+        }
+    }
+}
+
+void ImageCoverage::_fillSpan(int row, double left, double right, bool mask)
+{
+    int firstColumn =   qMax(0, qCeil(left));
+    int lastColumn =    qMin(_columns - 1, qFloor(right));
+
+    for (int column=firstColumn; column<=lastColumn; column++) {
+        if (mask) {
+            int index = (row * _columns) + column;
+            if (!_surveyMask.testBit(index)) {
+                _surveyMask.setBit(index);
+                _surveyCells++;
+            }
+        } else {
+            _addCell(column, row);
+        }
+    }
+}
+
+void ImageCoverage::_addCell(int column, int row)
+{
+    Tile*& tile = _tiles[((row / cTileSize) * _tileColumns) + (column / cTileSize)];
+    if (!tile) {
+        tile = new Tile;
+        memset(tile->counts, 0, sizeof(tile->counts));
+    }
+
+    quint8& count = tile->counts[((row % cTileSize) * cTileSize) + (column % cTileSize)];
+    if (count == 255) {
+        return;
+    }
+    count++;
+
+    bool inSurvey = _surveyMask.testBit((row * _columns) + column);
+    if (inSurvey) {
+        if (count == 1) {
+            _surveyCoveredCells++;
+        } else if (count == 2) {
+            _surveyOverlapCells++;
+        }
+    }
+    if (count <= 3) {
+        ((QRgb*)_image.scanLine(row))[column] = _palette[inSurvey][count];
+    }
+}
+
+int ImageCoverage::overlapCount(const QGeoCoordinate& coordinate) const
+{
+    if (!valid()) {
+        return -1;
+    }
+
+    Vector  vector = _local(coordinate);
+    int     column = qFloor((vector.x - _west) / _cellSize);
+    int     row =    qFloor((_north - vector.y) / _cellSize);
+
+    if (column < 0 || column >= _columns || row < 0 || row >= _rows) {
+        return -1;
+    }
+
+    const Tile* tile = _tiles[((row / cTileSize) * _tileColumns) + (column / cTileSize)];
+    return tile ? tile->counts[((row % cTileSize) * cTileSize) + (column % cTileSize)] : 0;
+}
+
+bool ImageCoverage::gimbalToCameraAttitude(const float q[4], double& roll, double& pitch, double& yaw)
+{
+    double w = q[0], x = q[1], y = q[2], z = q[3];
+
+    if ((w * w) + (x * x) + (y * y) + (z * z) < 0.5) {
+        return false;
+    }
+
+    double rq[3][3] = {
+        { 1 - (2 * ((y * y) + (z * z))),    2 * ((x * y) - (w * z)),            2 * ((x * z) + (w * y)) },
+        { 2 * ((x * y) + (w * z)),          1 - (2 * ((x * x) + (z * z))),      2 * ((y * z) - (w * x)) },
+        { 2 * ((x * z) - (w * y)),          2 * ((y * z) + (w * x)),            1 - (2 * ((x * x) + (y * y))) },
+    };
+
+    // The gimbal looks along x at zero rotation, the camera of addCapture along z with the top of the image along x. Rotating the
+    // camera frame by 90 degrees about y lines the two up.
+    double r[3][3];
+    for (int i=0; i<3; i++) {
+        r[i][0] = -rq[i][2];
+        r[i][1] = rq[i][1];
+        r[i][2] = rq[i][0];
+    }
+
+    roll =  qRadiansToDegrees(qAtan2(r[2][1], r[2][2]));
+    pitch = qRadiansToDegrees(-qAsin(qBound(-1.0, r[2][0], 1.0)));
+    yaw =   qRadiansToDegrees(qAtan2(r[1][0], r[0][0]));
+
+    return true;
+}
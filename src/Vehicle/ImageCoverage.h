@@ -0,0 +1,152 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef ImageCoverage_H
+#define ImageCoverage_H
+
+#include <QObject>
+#include <QVector>
+#include <QBitArray>
+#include <QImage>
+#include <QTimer>
+#include <QGeoCoordinate>
+
+class CameraSpec;
+
+/// Ground coverage of the survey built from the camera capture feedback.
+///
+/// Each capture projects the image footprint from the camera position and attitude to flat ground and adds it to a raster of
+/// overlap counts around the survey polygons. Only the cells below the footprint are touched, so the work per capture does not
+/// grow with the number of captures. Counts are kept in tiles which are allocated when a footprint first reaches them.
+///
+/// The raster is also kept as a single image (one pixel per cell) which the map shows as an overlay through the image
+/// provider. The image is published at most once per cImageUpdateMSecs.
+class ImageCoverage : public QObject
+{
+    Q_OBJECT
+
+public:
+    ImageCoverage(QObject* parent = NULL);
+    ~ImageCoverage();
+
+    /// Camera used for the survey
+    struct Camera {
+        Camera(void) : sensorWidth(0), sensorHeight(0), focalLength(0), landscape(true), distanceToSurface(0) { }
+        Camera(CameraSpec* cameraSpec, double distanceToSurface);
+
+        bool isValid(void) const { return sensorWidth > 0 && sensorHeight > 0 && focalLength > 0 && distanceToSurface > 0; }
+
+        double  sensorWidth;        ///< Millimeters
+        double  sensorHeight;       ///< Millimeters
+        double  focalLength;        ///< Millimeters
+        bool    landscape;          ///< true: sensor width is across the flight direction
+        double  distanceToSurface;  ///< Planned distance to the surface in meters, used to size the raster cells
+    };
+
+    Q_PROPERTY(bool             valid           READ valid          NOTIFY surveyChanged)       ///< true: a survey is set, coverage is available
+    Q_PROPERTY(QGeoCoordinate   topLeft         READ topLeft        NOTIFY surveyChanged)       ///< Coordinate of the top left corner of the image
+    Q_PROPERTY(double           cellSize        READ cellSize       NOTIFY surveyChanged)       ///< Size of a raster cell (image pixel) in meters
+    Q_PROPERTY(int              imageIndex      READ imageIndex     NOTIFY imageIndexChanged)   ///< Incremented each time the image changes
+    Q_PROPERTY(int              captureCount    READ captureCount   NOTIFY coverageChanged)     ///< Captures added to the coverage
+    Q_PROPERTY(double           coveredPercent  READ coveredPercent NOTIFY coverageChanged)     ///< Percent of the survey area in at least one image
+    Q_PROPERTY(double           overlapPercent  READ overlapPercent NOTIFY coverageChanged)     ///< Percent of the survey area in at least two images
+    Q_PROPERTY(double           gapArea         READ gapArea        NOTIFY coverageChanged)     ///< Survey area not in any image, square meters
+
+    bool            valid           (void) const { return _columns != 0; }
+    QGeoCoordinate  topLeft         (void) const;
+    double          cellSize        (void) const { return _cellSize; }
+    int             imageIndex      (void) const { return _imageIndex; }
+    int             captureCount    (void) const { return _captureCount; }
+    double          coveredPercent  (void) const;
+    double          overlapPercent  (void) const;
+    double          gapArea         (void) const;
+
+    /// Sets up the raster around the survey polygons, clears the coverage
+    void setSurvey(const QList<QList<QGeoCoordinate> >& polygons, const Camera& camera);
+
+    /// Removes the survey, captures are ignored until a new survey is set
+    void clearSurvey(void);
+
+    /// Clears the coverage, the survey is kept
+    void clear(void);
+
+    /// Adds the footprint of a capture to the coverage
+    ///     @param coordinate Camera position
+    ///     @param altitudeAboveSurface Camera altitude above the surface in meters
+    ///     @param roll/pitch/yaw Camera attitude in degrees, all zero is a camera looking straight down with the top of the image
+    ///                           towards north (a nadir camera on a level vehicle heading north)
+    /// @return false: capture not added, no survey is set or the footprint does not reach the ground
+    bool addCapture(const QGeoCoordinate& coordinate, double altitudeAboveSurface, double roll, double pitch, double yaw);
+
+    /// Converts the attitude of a gimbal (zero rotation is looking forward) to the camera attitude used by addCapture
+    ///     @param q Quaternion w, x, y, z as sent in CAMERA_IMAGE_CAPTURED
+    /// @return false: q is not set
+    static bool gimbalToCameraAttitude(const float q[4], double& roll, double& pitch, double& yaw);
+
+    /// @return Image of the coverage, one pixel per cell, north up
+    QImage image(void) const { return _image; }
+
+    /// @return Number of images the specified coordinate is in, -1 if outside of the raster
+    int overlapCount(const QGeoCoordinate& coordinate) const;
+
+    static const int cCellsPerFootprint =   16;             ///< Raster cells across the smaller side of a planned footprint
+    static const int cMaxCells =            2048 * 2048;
+    static const int cTileSize =            64;             ///< Tiles are cTileSize * cTileSize cells
+    static const int cImageUpdateMSecs =    1000;
+
+signals:
+    void surveyChanged      (void);
+    void coverageChanged    (void);
+    void imageIndexChanged  (int imageIndex);
+
+private slots:
+    void _updateImage(void);
+
+private:
+    struct Tile {
+        quint8 counts[cTileSize * cTileSize];
+    };
+
+    struct Vector {
+        double x;   ///< Meters east
+        double y;   ///< Meters north
+    };
+
+    void    _clearTiles     (void);
+    void    _resetImage     (void);
+    void    _rasterize      (const QVector<Vector>& polygon, bool mask);
+    void    _fillSpan       (int row, double left, double right, bool mask);
+    void    _addCell        (int column, int row);
+    Vector  _local          (const QGeoCoordinate& coordinate) const;
+
+    Camera          _camera;
+    double          _originLatitude;
+    double          _originLongitude;
+    double          _metersPerDegreeLongitude;
+    double          _cellSize;
+    double          _west;                  ///< Meters east of the origin
+    double          _north;                 ///< Meters north of the origin
+    int             _columns;
+    int             _rows;
+    int             _tileColumns;
+    QVector<Tile*>  _tiles;
+    QBitArray       _surveyMask;            ///< Cells inside the survey polygons
+    int             _surveyCells;
+    int             _surveyCoveredCells;
+    int             _surveyOverlapCells;
+    int             _captureCount;
+    QImage          _image;
+    QRgb            _palette[2][4];         ///< Cell colors by [in survey][overlap count]
+    int             _imageIndex;
+    QTimer          _imageUpdateTimer;
+
+    static const double _metersPerDegreeLatitude;
+};
+
+#endif
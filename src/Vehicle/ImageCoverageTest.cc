@@ -0,0 +1,216 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ImageCoverageTest.h"
+
+#include <QSignalSpy>
+#include <QtMath>
+
+QGeoCoordinate ImageCoverageTest::_offset(double east, double north)
+{
+    static const QGeoCoordinate origin(47.3977, 8.5456);
+
+    return origin.atDistanceAndAzimuth(east, 90).atDistanceAndAzimuth(north, 0);
+}
+
+/// Sony RX100 type camera in landscape, the footprint is 1.37 * distanceToSurface across and 1.01 * distanceToSurface along the
+/// flight direction
+ImageCoverage::Camera ImageCoverageTest::_camera(double distanceToSurface)
+{
+    ImageCoverage::Camera camera;
+
+    camera.sensorWidth =        13.2;
+    camera.sensorHeight =       8.8;
+    camera.focalLength =        10.4;
+    camera.landscape =          true;
+    camera.distanceToSurface =  distanceToSurface;
+
+    return camera;
+}
+
+/// Square survey of size meters with the south west corner at the origin
+void ImageCoverageTest::_setup(ImageCoverage& coverage, double size, double distanceToSurface)
+{
+    QList<QGeoCoordinate> polygon;
+
+    polygon << _offset(0, 0) << _offset(0, size) << _offset(size, size) << _offset(size, 0);
+    coverage.setSurvey(QList<QList<QGeoCoordinate> >() << polygon, _camera(distanceToSurface));
+}
+
+void ImageCoverageTest::_setSurvey(void)
+{
+    ImageCoverage   coverage;
+    QSignalSpy      spySurvey(&coverage, &ImageCoverage::surveyChanged);
+
+    QVERIFY(!coverage.valid());
+    _setup(coverage, 200, 50);
+
+    QVERIFY(coverage.valid());
+    QCOMPARE(spySurvey.count(), 1);
+    QCOMPARE(coverage.captureCount(), 0);
+    QCOMPARE(coverage.coveredPercent(), 0.0);
+
+    // The whole survey is a gap, up to the cells along the edges
+    QVERIFY(qAbs(coverage.gapArea() - (200.0 * 200.0)) < 200.0 * 4 * coverage.cellSize());
+    QVERIFY(qAbs(coverage.cellSize() - (50.0 * 8.8 / 10.4 / ImageCoverage::cCellsPerFootprint)) < 0.001);
+
+    QImage image = coverage.image();
+    QVERIFY(!image.isNull());
+    QCOMPARE(image.width(), qCeil((200 + 2 * 50.0 * 13.2 / 10.4) / coverage.cellSize()));
+    QVERIFY(coverage.topLeft().latitude() > _offset(0, 200).latitude());
+    QVERIFY(coverage.topLeft().longitude() < _offset(0, 0).longitude());
+}
+
+void ImageCoverageTest::_noSurvey(void)
+{
+    ImageCoverage coverage;
+
+    QVERIFY(!coverage.addCapture(_offset(0, 0), 50, 0, 0, 0));
+    QCOMPARE(coverage.overlapCount(_offset(0, 0)), -1);
+
+    // A survey without camera information is not usable
+    coverage.setSurvey(QList<QList<QGeoCoordinate> >() << (QList<QGeoCoordinate>() << _offset(0, 0) << _offset(0, 100) << _offset(100, 100)), ImageCoverage::Camera());
+    QVERIFY(!coverage.valid());
+}
+
+void ImageCoverageTest::_nadirFootprint(void)
+{
+    ImageCoverage   coverage;
+    QSignalSpy      spyCoverage(&coverage, &ImageCoverage::coverageChanged);
+
+    _setup(coverage, 200, 50);
+    spyCoverage.clear();
+
+    // Footprint is 63.5 meters east/west and 42.3 meters north/south
+    QVERIFY(coverage.addCapture(_offset(100, 100), 50, 0, 0, 0));
+    QCOMPARE(spyCoverage.count(), 1);
+    QCOMPARE(coverage.captureCount(), 1);
+
+    QCOMPARE(coverage.overlapCount(_offset(100, 100)), 1);
+    QCOMPARE(coverage.overlapCount(_offset(128, 100)), 1);
+    QCOMPARE(coverage.overlapCount(_offset(72, 100)), 1);
+    QCOMPARE(coverage.overlapCount(_offset(100, 118)), 1);
+    QCOMPARE(coverage.overlapCount(_offset(135, 100)), 0);
+    QCOMPARE(coverage.overlapCount(_offset(100, 124)), 0);
+    QCOMPARE(coverage.overlapCount(_offset(100, 76)), 0);
+
+    double footprintArea = (50.0 * 13.2 / 10.4) * (50.0 * 8.8 / 10.4);
+    QVERIFY(qAbs((coverage.coveredPercent() / 100.0 * 200 * 200) - footprintArea) < footprintArea * 0.1);
+}
+
+void ImageCoverageTest::_attitude(void)
+{
+    ImageCoverage coverage;
+
+    _setup(coverage, 200, 50);
+
+    // Heading east turns the long side of the footprint north/south
+    QVERIFY(coverage.addCapture(_offset(50, 100), 50, 0, 0, 90));
+    QCOMPARE(coverage.overlapCount(_offset(50, 128)), 1);
+    QCOMPARE(coverage.overlapCount(_offset(75, 100)), 0);
+
+    // Rolled right, the camera looks left of the flight direction (west when heading north)
+    QVERIFY(coverage.addCapture(_offset(150, 100), 50, 30, 0, 0));
+    QCOMPARE(coverage.overlapCount(_offset(150 - (50 * qTan(qDegreesToRadians(30.0))), 100)), 1);
+    QCOMPARE(coverage.overlapCount(_offset(180, 100)), 0);
+
+    // Footprint does not reach the ground
+    QVERIFY(!coverage.addCapture(_offset(100, 100), 50, 0, 80, 0));
+    QCOMPARE(coverage.captureCount(), 2);
+}
+
+void ImageCoverageTest::_overlap(void)
+{
+    ImageCoverage coverage;
+
+    _setup(coverage, 200, 50);
+    coverage.addCapture(_offset(100, 100), 50, 0, 0, 0);
+    coverage.addCapture(_offset(100, 110), 50, 0, 0, 0);
+
+    QCOMPARE(coverage.overlapCount(_offset(100, 100)), 2);
+    QCOMPARE(coverage.overlapCount(_offset(100, 84)), 1);
+    QCOMPARE(coverage.overlapCount(_offset(100, 126)), 1);
+    QVERIFY(coverage.overlapPercent() > 0);
+    QVERIFY(coverage.overlapPercent() < coverage.coveredPercent());
+}
+
+void ImageCoverageTest::_fullCoverage(void)
+{
+    ImageCoverage coverage;
+
+    _setup(coverage, 200, 50);
+
+    // Lanes 50 meters apart with images every 30 meters cover the survey area with overlap
+    for (int east=0; east<=200; east+=50) {
+        for (int north=0; north<=210; north+=30) {
+            QVERIFY(coverage.addCapture(_offset(east, north), 50, 0, 0, 0));
+        }
+    }
+
+    QCOMPARE(coverage.coveredPercent(), 100.0);
+    QCOMPARE(coverage.gapArea(), 0.0);
+    QVERIFY(coverage.overlapPercent() > 25);
+}
+
+void ImageCoverageTest::_clear(void)
+{
+    ImageCoverage coverage;
+
+    _setup(coverage, 200, 50);
+    coverage.addCapture(_offset(100, 100), 50, 0, 0, 0);
+    coverage.clear();
+
+    QVERIFY(coverage.valid());
+    QCOMPARE(coverage.captureCount(), 0);
+    QCOMPARE(coverage.coveredPercent(), 0.0);
+    QCOMPARE(coverage.overlapCount(_offset(100, 100)), 0);
+
+    coverage.clearSurvey();
+    QVERIFY(!coverage.valid());
+    QVERIFY(coverage.image().isNull());
+}
+
+void ImageCoverageTest::_gimbalToCameraAttitude(void)
+{
+    double roll, pitch, yaw;
+
+    float unset[4] = { 0, 0, 0, 0 };
+    QVERIFY(!ImageCoverage::gimbalToCameraAttitude(unset, roll, pitch, yaw));
+
+    // Gimbal pitched down 90 degrees is the nadir camera
+    float down[4] = { (float)qCos(qDegreesToRadians(-45.0)), 0, (float)qSin(qDegreesToRadians(-45.0)), 0 };
+    QVERIFY(ImageCoverage::gimbalToCameraAttitude(down, roll, pitch, yaw));
+    QVERIFY(qAbs(roll) < 0.01);
+    QVERIFY(qAbs(pitch) < 0.01);
+    QVERIFY(qAbs(yaw) < 0.01);
+
+    // Gimbal pitched down 70 degrees looks 20 degrees forward
+    float forward[4] = { (float)qCos(qDegreesToRadians(-35.0)), 0, (float)qSin(qDegreesToRadians(-35.0)), 0 };
+    QVERIFY(ImageCoverage::gimbalToCameraAttitude(forward, roll, pitch, yaw));
+    QVERIFY(qAbs(pitch - 20) < 0.01);
+}
+
+void ImageCoverageTest::_benchmark10kCaptures(void)
+{
+    ImageCoverage coverage;
+
+    // 2 km square survey flown at 100 meters: 100 lanes of 100 images
+    _setup(coverage, 2000, 100);
+
+    QBENCHMARK_ONCE {
+        for (int lane=0; lane<100; lane++) {
+            for (int image=0; image<100; image++) {
+                coverage.addCapture(_offset(lane * 20, image * 20), 100, 2, -3, lane % 2 ? 180 : 0);
+            }
+        }
+    }
+
+    QCOMPARE(coverage.captureCount(), 10000);
+    QVERIFY(coverage.coveredPercent() > 99);
+}
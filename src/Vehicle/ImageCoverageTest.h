@@ -0,0 +1,37 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef ImageCoverageTest_H
+#define ImageCoverageTest_H
+
+#include "UnitTest.h"
+#include "ImageCoverage.h"
+
+class ImageCoverageTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _setSurvey(void);
+    void _noSurvey(void);
+    void _nadirFootprint(void);
+    void _attitude(void);
+    void _overlap(void);
+    void _fullCoverage(void);
+    void _clear(void);
+    void _gimbalToCameraAttitude(void);
+    void _benchmark10kCaptures(void);
+
+private:
+    QGeoCoordinate          _offset (double east, double north);
+    void                    _setup  (ImageCoverage& coverage, double size, double distanceToSurface);
+    ImageCoverage::Camera   _camera (double distanceToSurface);
+};
+
+#endif
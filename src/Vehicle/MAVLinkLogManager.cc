@@ -110,17 +110,59 @@ MAVLinkLogFiles::setUploaded(bool uploaded)
     emit uploadedChanged();
 }
 
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+MAVLinkLogWriter::MAVLinkLogWriter(const QString& fileName)
+    : _file(fileName)
+    , _error(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+bool
+MAVLinkLogWriter::open()
+{
+    //-- Unbuffered, the processor already hands over large chunks
+    return _file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered);
+}
+
+//-----------------------------------------------------------------------------
+void
+MAVLinkLogWriter::write(QByteArray data)
+{
+    if(!_error.load()) {
+        if(_file.write(data) != data.size()) {
+            qCDebug(MAVLinkLogManagerLog) << "File IO error:" << data.size() << "bytes into" << _file.fileName();
+            _error.store(1);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+MAVLinkLogWriter::close()
+{
+    _file.close();
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 MAVLinkLogProcessor::MAVLinkLogProcessor()
-    : _fd(NULL)
+    : _writer(NULL)
     , _written(0)
     , _sequence(-1)
     , _numDrops(0)
     , _gotHeader(false)
-    , _error(false)
+    , _dropoutPending(false)
+    , _lastTimestamp(0)
+    , _lastPacketMSecs(0)
+    , _dropoutRxMSecs(0)
+    , _rxMSecs(0)
+    , _lastFlushMSecs(0)
     , _record(NULL)
+    , _streamDecoder(NULL)
 {
+    _ioThread.setObjectName("MAVLinkLogWriter");
 }
 
 //-----------------------------------------------------------------------------
@@ -133,9 +175,18 @@ MAVLinkLogProcessor::~MAVLinkLogProcessor()
 void
 MAVLinkLogProcessor::close()
 {
-    if(_fd) {
-        fclose(_fd);
-        _fd = NULL;
+    if(_writer) {
+        //-- A dropout at the very end never got a following message
+        if(_dropoutPending) {
+            _writeDropout(_dropoutRxMSecs);
+        }
+        _flush();
+        //-- Queued behind all pending writes
+        QMetaObject::invokeMethod(_writer, "close", Qt::BlockingQueuedConnection);
+        _ioThread.quit();
+        _ioThread.wait();
+        delete _writer;
+        _writer = NULL;
     }
 }
 
@@ -143,7 +194,7 @@ MAVLinkLogProcessor::close()
 bool
 MAVLinkLogProcessor::valid()
 {
-    return (_fd != NULL) && (_record != NULL);
+    return (_writer != NULL) && (_record != NULL);
 }
 
 //-----------------------------------------------------------------------------
@@ -155,13 +206,19 @@ MAVLinkLogProcessor::create(MAVLinkLogManager* manager, const QString path, uint
                       id,
                       QDateTime::currentDateTime().toString("yyyy-MM-dd-hh-mm-ss-zzz").toLocal8Bit().data(),
                       manager->logExtension().toLocal8Bit().data());
-    _fd = fopen(_fileName.toLocal8Bit().data(), "wb");
-    if(_fd) {
+    _writer = new MAVLinkLogWriter(_fileName);
+    if(_writer->open()) {
+        _writer->moveToThread(&_ioThread);
+        _ioThread.start();
         _record = new MAVLinkLogFiles(manager, _fileName, true);
         _record->setWriting(true);
+        _buffer.reserve(kWriteChunkSize);
         _sequence = -1;
+        _rxTimer.start();
         return true;
     }
+    delete _writer;
+    _writer = NULL;
     return false;
 }
 
@@ -201,97 +258,160 @@ MAVLinkLogProcessor::_checkSequence(uint16_t seq, int& num_drops)
 
 //-----------------------------------------------------------------------------
 void
-MAVLinkLogProcessor::_writeData(void* data, int len)
+MAVLinkLogProcessor::_writeData(const void* data, int len)
 {
-    if(!_error) {
-        _error = fwrite(data, 1, len, _fd) != (size_t)len;
-        if(!_error) {
-            _written += len;
-            if(_record) {
-                _record->setSize(_written);
-            }
+    _buffer.append((const char*)data, len);
+    _written += len;
+    if(_buffer.size() >= kWriteChunkSize) {
+        _flush();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+MAVLinkLogProcessor::_flush()
+{
+    if(_buffer.isEmpty()) {
+        return;
+    }
+    //-- The I/O thread gets the buffer as is, we start over with a fresh one
+    QMetaObject::invokeMethod(_writer, "write", Qt::QueuedConnection, Q_ARG(QByteArray, _buffer));
+    _buffer = QByteArray();
+    _buffer.reserve(kWriteChunkSize);
+    _lastFlushMSecs = _rxMSecs;
+    if(_record) {
+        _record->setSize(_written);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+MAVLinkLogProcessor::_writeDropout(qint64 durationMSecs)
+{
+    //-- ULog dropout message: 2 byte size, 'O', 2 byte duration in ms
+    uint16_t duration = (uint16_t)qBound((qint64)1, durationMSecs, (qint64)65535);
+    uint8_t dropout[] = {2, 0, 'O', (uint8_t)(duration & 0xFF), (uint8_t)(duration >> 8)};
+    _writeData(dropout, sizeof(dropout));
+    _dropoutPending = false;
+}
+
+//-----------------------------------------------------------------------------
+void
+MAVLinkLogProcessor::_writeUlogMessage(const char* message, int len)
+{
+    //-- Data messages: 3 byte header, 2 byte msg_id, then the 8 byte timestamp every topic starts with
+    const int timestampOffset = 5;
+    bool hasTimestamp = message[2] == 'D' && len >= timestampOffset + (int)sizeof(quint64);
+    quint64 timestamp = 0;
+    if(hasTimestamp) {
+        memcpy(&timestamp, message + timestampOffset, sizeof(timestamp));
+    }
+    if(_dropoutPending) {
+        //-- The vehicle's own timestamps on either side of the gap give the real duration. If we don't
+        //   have those, the time we went without packets is the next best thing.
+        if(hasTimestamp && _lastTimestamp != 0 && timestamp > _lastTimestamp) {
+            _writeDropout((qint64)((timestamp - _lastTimestamp) / 1000));
         } else {
-            qCDebug(MAVLinkLogManagerLog) << "File IO error:" << len << "bytes into" << _fileName;
+            _writeDropout(_dropoutRxMSecs);
         }
     }
+    if(hasTimestamp) {
+        _lastTimestamp = timestamp;
+    }
+    _writeData(message, len);
+    if(_streamDecoder) {
+        _streamDecoder->processMessage(message, len);
+    }
 }
 
 //-----------------------------------------------------------------------------
-QByteArray
-MAVLinkLogProcessor::_writeUlogMessage(QByteArray& data)
+int
+MAVLinkLogProcessor::_writeUlogMessages(const char* data, int len)
 {
     //-- Write ulog data w/o integrity checking, assuming data starts with a
-    //   valid ulog message. returns the remaining data at the end.
-    while(data.length() > 2) {
-        uint8_t* ptr = (uint8_t*)data.data();
+    //   valid ulog message. Returns the number of bytes used, the rest is the
+    //   start of a message which continues in the next packet.
+    int offset = 0;
+    while(len - offset > 2) {
+        const uint8_t* ptr = (const uint8_t*)data + offset;
         int message_length = ptr[0] + (ptr[1] * 256) + 3; // 3 = ULog msg header
-        if(message_length > data.length())
+        if(message_length > len - offset)
             break;
-        _writeData(data.data(), message_length);
-        data.remove(0, message_length);
+        _writeUlogMessage(data + offset, message_length);
+        offset += message_length;
     }
-    return data;
+    return offset;
+}
+
+//-----------------------------------------------------------------------------
+bool
+MAVLinkLogProcessor::processStreamData(uint16_t sequence, uint8_t first_message, const QByteArray& data)
+{
+    return processStreamData(sequence, first_message, data, _rxTimer.elapsed());
 }
 
 //-----------------------------------------------------------------------------
 bool
-MAVLinkLogProcessor::processStreamData(uint16_t sequence, uint8_t first_message, QByteArray data)
+MAVLinkLogProcessor::processStreamData(uint16_t sequence, uint8_t first_message, const QByteArray& data, qint64 rxMSecs)
 {
     int num_drops = 0;
-    _error = false;
-    while(_checkSequence(sequence, num_drops)) {
-        //-- The first 16 bytes need special treatment (this sounds awfully brittle)
-        if(!_gotHeader) {
-            if(data.size() < 16) {
-                //-- Shouldn't happen but if it does, we might as well close shop.
-                qCWarning(MAVLinkLogManagerLog) << "Corrupt log header. Canceling log download.";
-                return false;
-            }
-            //-- Write header
-            _writeData(data.data(), 16);
-            data.remove(0, 16);
-            _gotHeader = true;
-            // What about data start offset now that we removed 16 bytes off the start?
-        }
-        if(_gotHeader && num_drops > 0) {
-            if(num_drops > 25) num_drops = 25;
-            //-- Hocus Pocus
-            //   Write a dropout message. We don't really know the actual duration,
-            //   so just use the number of drops * 10 ms
-            uint8_t bogus[] = {2, 0, 79, 0, 0};
-            bogus[3] = num_drops * 10;
-            _writeData(bogus, sizeof(bogus));
-        }
-        if(num_drops > 0) {
-            _writeUlogMessage(_ulogMessage);
-            _ulogMessage.clear();
-            //-- If no useful information in this message. Drop it.
-            if(first_message == 255) {
-                break;
-            }
-            if(first_message > 0) {
-                data.remove(0, first_message);
-                first_message = 0;
-            }
-        }
-        if(first_message == 255 && _ulogMessage.length() > 0) {
-            _ulogMessage.append(data);
-            break;
+    if(!_checkSequence(sequence, num_drops)) {
+        return !_writer->error();
+    }
+    _rxMSecs = rxMSecs;
+    const char* ptr = data.constData();
+    int len = data.size();
+    //-- The first 16 bytes need special treatment (this sounds awfully brittle)
+    if(!_gotHeader) {
+        if(len < 16) {
+            //-- Shouldn't happen but if it does, we might as well close shop.
+            qCWarning(MAVLinkLogManagerLog) << "Corrupt log header. Canceling log download.";
+            return false;
         }
-        if(_ulogMessage.length()) {
-            _writeData(_ulogMessage.data(), _ulogMessage.length());
-            if(first_message) {
-                _writeData(data.left(first_message).data(), first_message);
-            }
-            _ulogMessage.clear();
+        //-- Write header
+        _writeData(ptr, 16);
+        ptr += 16;
+        len -= 16;
+        _gotHeader = true;
+        //-- The first message follows the header directly, whether the offset counts the header or not
+        first_message = first_message == 255 ? 0 : qMax((int)first_message - 16, 0);
+    }
+    if(num_drops > 0) {
+        //-- Whatever we had of a message spanning the gap is lost
+        _ulogMessage.resize(0);
+        if(!_dropoutPending) {
+            _dropoutPending = true;
+            _dropoutRxMSecs = 0;
         }
-        if(first_message) {
-            data.remove(0, first_message);
+        _dropoutRxMSecs += _rxMSecs - _lastPacketMSecs;
+    }
+    _lastPacketMSecs = _rxMSecs;
+    //-- Slow streams still reach the disk (and the size shown) regularly
+    if(_rxMSecs - _lastFlushMSecs >= kFlushIntervalMSecs) {
+        _flush();
+    }
+    if(first_message == 255) {
+        //-- No message starts in this packet. Unless we are in the middle of one, there is nothing useful in it.
+        if(_ulogMessage.length() > 0) {
+            _ulogMessage.append(ptr, len);
+            _ulogMessage.remove(0, _writeUlogMessages(_ulogMessage.constData(), _ulogMessage.length()));
         }
-        _ulogMessage = _writeUlogMessage(data);
-        break;
+        return !_writer->error();
+    }
+    if(first_message > len) {
+        qCWarning(MAVLinkLogManagerLog) << "Invalid first message offset" << first_message << "in" << len << "bytes";
+        _ulogMessage.resize(0);
+        return !_writer->error();
     }
-    return !_error;
+    if(_ulogMessage.length()) {
+        //-- Bytes ahead of the first message finish the one from the previous packet
+        _ulogMessage.append(ptr, first_message);
+        _writeUlogMessages(_ulogMessage.constData(), _ulogMessage.length());
+        _ulogMessage.resize(0);
+    }
+    int used = first_message + _writeUlogMessages(ptr + first_message, len - first_message);
+    _ulogMessage.append(ptr + used, len - used);
+    return !_writer->error();
 }
 
 //-----------------------------------------------------------------------------
@@ -337,7 +457,6 @@ MAVLinkLogManager::setToolbox(QGCToolbox* toolbox)
 {
     QGCTool::setToolbox(toolbox);
     QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
-    qmlRegisterUncreatableType<MAVLinkLogManager>("QGroundControl.MAVLinkLogManager", 1, 0, "MAVLinkLogManager", "Reference only");
     //-- Logging location
     _ulogExtension  = ".";
     _ulogExtension += qgcApp()->toolbox()->settingsManager()->appSettings()->logFileExtension;
@@ -358,6 +477,10 @@ MAVLinkLogManager::setToolbox(QGCToolbox* toolbox)
         }
         qCDebug(MAVLinkLogManagerLog) << "MAVLink logs directory:" << _logPath;
         connect(toolbox->multiVehicleManager(), &MultiVehicleManager::activeVehicleChanged, this, &MAVLinkLogManager::_activeVehicleChanged);
+        //-- Initialization is deferred, a vehicle may already be there
+        if(toolbox->multiVehicleManager()->activeVehicle()) {
+            _activeVehicleChanged(toolbox->multiVehicleManager()->activeVehicle());
+        }
     }
 }
 
@@ -856,7 +979,7 @@ MAVLinkLogManager::_activeVehicleChanged(Vehicle* vehicle)
 
 //-----------------------------------------------------------------------------
 void
-MAVLinkLogManager::_mavlinkLogData(Vehicle* /*vehicle*/, uint8_t /*target_system*/, uint8_t /*target_component*/, uint16_t sequence, uint8_t first_message, QByteArray data, bool /*acked*/)
+MAVLinkLogManager::_mavlinkLogData(Vehicle* /*vehicle*/, uint8_t /*target_system*/, uint8_t /*target_component*/, uint16_t sequence, uint8_t first_message, const QByteArray& data, bool /*acked*/)
 {
     if(_logProcessor && _logProcessor->valid()) {
         if(!_logProcessor->processStreamData(sequence, first_message, data)) {
@@ -922,6 +1045,8 @@ MAVLinkLogManager::_createNewLog()
     }
     _logProcessor = new MAVLinkLogProcessor;
     if(_logProcessor->create(this, _logPath, _vehicle->id())) {
+        _streamDecoder.start(_vehicle->id());
+        _logProcessor->setStreamDecoder(&_streamDecoder);
         _insertNewLog(_logProcessor->record());
         emit logFilesChanged();
     } else {
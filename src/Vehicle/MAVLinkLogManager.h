@@ -12,11 +12,16 @@
 #define MAVLinkLogManager_H
 
 #include <QObject>
+#include <QThread>
+#include <QFile>
+#include <QAtomicInt>
+#include <QElapsedTimer>
 
 #include "QmlObjectListModel.h"
 #include "QGCLoggingCategory.h"
 #include "QGCToolbox.h"
 #include "Vehicle.h"
+#include "ULogStreamDecoder.h"
 
 Q_DECLARE_LOGGING_CATEGORY(MAVLinkLogManagerLog)
 
@@ -72,6 +77,22 @@ private:
     bool                _uploaded;
 };
 
+//-----------------------------------------------------------------------------
+//-- Writes the log file on its own thread so disk stalls don't hold up the MAVLink stream
+class MAVLinkLogWriter : public QObject
+{
+    Q_OBJECT
+public:
+    MAVLinkLogWriter                (const QString& fileName);
+    bool                open        ();
+    bool                error       () const { return _error.load() != 0; }
+    Q_INVOKABLE void    write       (QByteArray data);
+    Q_INVOKABLE void    close       ();
+private:
+    QFile               _file;
+    QAtomicInt          _error;
+};
+
 //-----------------------------------------------------------------------------
 class MAVLinkLogProcessor
 {
@@ -83,21 +104,43 @@ public:
     bool                create      (MAVLinkLogManager *manager, const QString path, uint8_t id);
     MAVLinkLogFiles*    record      () { return _record; }
     QString             fileName    () { return _fileName; }
-    bool                processStreamData(uint16_t _sequence, uint8_t first_message, QByteArray data);
+    int                 numDrops    () { return _numDrops; }
+    bool                processStreamData(uint16_t _sequence, uint8_t first_message, const QByteArray& data);
+    //-- Same, with the receive time (ms since create) given by the caller instead of read from the clock
+    bool                processStreamData(uint16_t _sequence, uint8_t first_message, const QByteArray& data, qint64 rxMSecs);
+    //-- Complete messages are also handed to the decoder, if any
+    void                setStreamDecoder(ULogStreamDecoder* decoder) { _streamDecoder = decoder; }
+
+    //-- Output is handed to the I/O thread in chunks of this size
+    static const int    kWriteChunkSize = 64 * 1024;
+    //-- Partial chunks are handed over at least this often
+    static const int    kFlushIntervalMSecs = 1000;
 private:
     bool                _checkSequence(uint16_t seq, int &num_drops);
-    QByteArray          _writeUlogMessage(QByteArray &data);
-    void                _writeData(void* data, int len);
+    int                 _writeUlogMessages(const char* data, int len);
+    void                _writeUlogMessage(const char* message, int len);
+    void                _writeDropout(qint64 durationMSecs);
+    void                _writeData(const void* data, int len);
+    void                _flush();
 private:
-    FILE*               _fd;
+    MAVLinkLogWriter*   _writer;
+    QThread             _ioThread;
+    QByteArray          _buffer;            ///< Output not yet handed to the I/O thread
     quint32             _written;
     int                 _sequence;
     int                 _numDrops;
     bool                _gotHeader;
-    bool                _error;
-    QByteArray          _ulogMessage;
+    QByteArray          _ulogMessage;       ///< Start of a message which continues in the next packet
+    bool                _dropoutPending;    ///< Sequence gap seen, dropout is written once the next message tells us how long it was
+    quint64             _lastTimestamp;     ///< Timestamp (usecs) of the last data message written
+    qint64              _lastPacketMSecs;   ///< Receive time of the last packet in sequence
+    qint64              _dropoutRxMSecs;    ///< Receive time gap of the pending dropout
+    qint64              _rxMSecs;           ///< Receive time of the packet being processed
+    qint64              _lastFlushMSecs;
+    QElapsedTimer       _rxTimer;
     QString             _fileName;
     MAVLinkLogFiles*    _record;
+    ULogStreamDecoder*  _streamDecoder;
 };
 
 //-----------------------------------------------------------------------------
@@ -124,6 +167,7 @@ public:
     Q_PROPERTY(QmlObjectListModel*  logFiles            READ    logFiles                                        NOTIFY logFilesChanged)
     Q_PROPERTY(int                  windSpeed           READ    windSpeed           WRITE setWindSpeed          NOTIFY windSpeedChanged)
     Q_PROPERTY(QString              rating              READ    rating              WRITE setRating             NOTIFY ratingChanged)
+    Q_PROPERTY(ULogStreamDecoder*   streamDecoder       READ    streamDecoder                                   CONSTANT)
 
     Q_INVOKABLE void uploadLog      ();
     Q_INVOKABLE void deleteLog      ();
@@ -148,6 +192,7 @@ public:
     QString     logExtension        () { return _ulogExtension; }
 
     QmlObjectListModel* logFiles    () { return &_logFiles; }
+    ULogStreamDecoder*  streamDecoder() { return &_streamDecoder; }
 
     void        setEmailAddress     (QString email);
     void        setDescription      (QString description);
@@ -191,7 +236,7 @@ private slots:
     void _dataAvailable             ();
     void _uploadProgress            (qint64 bytesSent, qint64 bytesTotal);
     void _activeVehicleChanged      (Vehicle* vehicle);
-    void _mavlinkLogData            (Vehicle* vehicle, uint8_t target_system, uint8_t target_component, uint16_t sequence, uint8_t first_message, QByteArray data, bool acked);
+    void _mavlinkLogData            (Vehicle* vehicle, uint8_t target_system, uint8_t target_component, uint16_t sequence, uint8_t first_message, const QByteArray& data, bool acked);
     void _armedChanged              (bool armed);
     void _mavCommandResult          (int vehicleId, int component, int command, int result, bool noReponseFromVehicle);
 
@@ -226,6 +271,7 @@ private:
     QString                 _rating;
     bool                    _publicLog;
     QString                 _ulogExtension;
+    ULogStreamDecoder       _streamDecoder;
 
 };
 
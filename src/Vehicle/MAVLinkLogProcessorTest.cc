@@ -0,0 +1,193 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkLogProcessorTest.h"
+#include "MAVLinkLogManager.h"
+#include "QGCApplication.h"
+
+void MAVLinkLogProcessorTest::init(void)
+{
+    UnitTest::init();
+    _logDir = new QTemporaryDir;
+    QVERIFY(_logDir->isValid());
+}
+
+void MAVLinkLogProcessorTest::cleanup(void)
+{
+    delete _logDir;
+    _logDir = NULL;
+    _log.clear();
+    _packets.clear();
+    UnitTest::cleanup();
+}
+
+/// Generates a ULog stream of data messages and cuts it into LOGGING_DATA packets the way PX4 streams it
+///     @param largeMessageInterval Every n-th message is large enough to span several packets
+void MAVLinkLogProcessorTest::_buildLog(int cMessages, quint64 intervalUSecs, int payloadSize, int largeMessageInterval)
+{
+    const int           cbPacket = MAVLINK_MSG_LOGGING_DATA_FIELD_DATA_LEN;
+    QList<int>          messageStarts;
+    QList<quint64>      messageTimestamps;
+
+    // File header: magic, version, timestamp
+    const char header[16] = { 'U', 'L', 'o', 'g', 0x01, 0x12, 0x35, 0x01, 0, 0, 0, 0, 0, 0, 0, 0 };
+    messageStarts.append(0);
+    messageTimestamps.append(0);
+    _log.append(header, sizeof(header));
+
+    for (int i=0; i<cMessages; i++) {
+        quint64 timestamp = (i + 1) * intervalUSecs;
+        int     cbPayload = (largeMessageInterval && (i % largeMessageInterval) == 0) ? cbPacket * 3 : payloadSize;
+        int     msgSize = 2 + sizeof(timestamp) + cbPayload;
+
+        messageStarts.append(_log.size());
+        messageTimestamps.append(timestamp);
+
+        _log.append((char)(msgSize & 0xFF));
+        _log.append((char)(msgSize >> 8));
+        _log.append('D');
+        _log.append((char)(i & 0xFF));
+        _log.append((char)0);
+        _log.append((const char*)&timestamp, sizeof(timestamp));
+        for (int j=0; j<cbPayload; j++) {
+            _log.append((char)(j + i));
+        }
+    }
+
+    int messageIndex = 0;
+    for (int offset=0, sequence=0; offset<_log.size(); offset+=cbPacket, sequence++) {
+        Packet_t packet;
+
+        packet.sequence = sequence;
+        packet.data = _log.mid(offset, cbPacket);
+        packet.firstMessage = 255;
+        while (messageIndex < messageStarts.count() && messageStarts[messageIndex] < offset + cbPacket) {
+            if (packet.firstMessage == 255 && messageStarts[messageIndex] >= offset) {
+                packet.firstMessage = messageStarts[messageIndex] - offset;
+            }
+            messageIndex++;
+        }
+        packet.timestamp = messageTimestamps[messageIndex - 1];
+        _packets.append(packet);
+    }
+}
+
+QByteArray MAVLinkLogProcessorTest::_readLog(MAVLinkLogProcessor& processor)
+{
+    processor.close();
+    delete processor.record();
+
+    QFile file(processor.fileName());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+void MAVLinkLogProcessorTest::_stream_test(void)
+{
+    MAVLinkLogProcessor processor;
+
+    _buildLog(2000, 1000, 40, 50);
+    QVERIFY(processor.create(qgcApp()->toolbox()->mavlinkLogManager(), _logDir->path(), 1));
+
+    foreach (const Packet_t& packet, _packets) {
+        QVERIFY(processor.processStreamData(packet.sequence, packet.firstMessage, packet.data));
+        // Duplicates are ignored
+        QVERIFY(processor.processStreamData(packet.sequence, packet.firstMessage, packet.data));
+    }
+
+    QCOMPARE(processor.numDrops(), 0);
+    QVERIFY(_readLog(processor) == _log);
+}
+
+void MAVLinkLogProcessorTest::_dropout_test(void)
+{
+    MAVLinkLogProcessor processor;
+
+    _buildLog(500, 1000, 40, 0);
+    QVERIFY(processor.create(qgcApp()->toolbox()->mavlinkLogManager(), _logDir->path(), 1));
+
+    const int firstDropped = 10;
+    const int cDropped = 3;
+    for (int i=0; i<_packets.count(); i++) {
+        if (i < firstDropped || i >= firstDropped + cDropped) {
+            QVERIFY(processor.processStreamData(_packets[i].sequence, _packets[i].firstMessage, _packets[i].data));
+        }
+    }
+    QCOMPARE(processor.numDrops(), cDropped);
+
+    // Walk the messages: the dropout has to cover exactly the time between the data messages on either side
+    QByteArray  log = _readLog(processor);
+    int         offset = 16;
+    int         cDropouts = 0;
+    int         dropoutMSecs = 0;
+    quint64     lastTimestamp = 0;
+    quint64     timestampBeforeDropout = 0;
+    quint64     timestampAfterDropout = 0;
+
+    while (offset < log.size()) {
+        QVERIFY(log.size() - offset >= 3);
+        const uint8_t*  ptr = (const uint8_t*)log.constData() + offset;
+        int             msgSize = ptr[0] + (ptr[1] * 256);
+
+        QVERIFY(offset + 3 + msgSize <= log.size());
+        if (ptr[2] == 'O') {
+            cDropouts++;
+            dropoutMSecs = ptr[3] + (ptr[4] * 256);
+            timestampBeforeDropout = lastTimestamp;
+        } else {
+            QCOMPARE((char)ptr[2], 'D');
+            quint64 timestamp;
+            memcpy(&timestamp, ptr + 5, sizeof(timestamp));
+            QVERIFY(timestamp > lastTimestamp);
+            if (cDropouts && !timestampAfterDropout) {
+                timestampAfterDropout = timestamp;
+            }
+            lastTimestamp = timestamp;
+        }
+        offset += 3 + msgSize;
+    }
+
+    QCOMPARE(cDropouts, 1);
+    QVERIFY(timestampAfterDropout > timestampBeforeDropout);
+    QCOMPARE(dropoutMSecs, (int)((timestampAfterDropout - timestampBeforeDropout) / 1000));
+    // Three 249 byte packets of 53 byte messages at 1 kHz
+    QVERIFY(dropoutMSecs > 10);
+}
+
+void MAVLinkLogProcessorTest::_replay2x_test(void)
+{
+    MAVLinkLogProcessor processor;
+
+    // About 2.3 MB of log covering 2 seconds, fed at twice the rate it was logged. The receive clock is driven
+    // from the log timestamps so the outcome doesn't depend on how fast the machine running the test is.
+    _buildLog(20000, 100, 100, 200);
+    QVERIFY(processor.create(qgcApp()->toolbox()->mavlinkLogManager(), _logDir->path(), 1));
+
+    quint64 firstTimestamp = _packets.first().timestamp;
+    quint32 lastSize = 0;
+    qint64  lastSizeChangeMSecs = 0;
+
+    foreach (const Packet_t& packet, _packets) {
+        qint64 rxMSecs = (qint64)(packet.timestamp - firstTimestamp) / 1000 / 2;
+
+        QVERIFY(processor.processStreamData(packet.sequence, packet.firstMessage, packet.data, rxMSecs));
+
+        // The size shown for the log never falls behind by more than a flush interval
+        if (processor.record()->size() != lastSize) {
+            lastSize = processor.record()->size();
+            lastSizeChangeMSecs = rxMSecs;
+        }
+        QVERIFY(rxMSecs - lastSizeChangeMSecs <= MAVLinkLogProcessor::kFlushIntervalMSecs);
+    }
+
+    QCOMPARE(processor.numDrops(), 0);
+    QVERIFY(_readLog(processor) == _log);
+}
@@ -0,0 +1,48 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef MAVLinkLogProcessorTest_H
+#define MAVLinkLogProcessorTest_H
+
+#include "UnitTest.h"
+
+#include <QTemporaryDir>
+
+class MAVLinkLogProcessor;
+
+/// Unit test for MAVLinkLogProcessor, feeds it LOGGING_DATA packets cut from a generated ULog stream
+class MAVLinkLogProcessorTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void init(void);
+    void cleanup(void);
+
+    void _stream_test(void);
+    void _dropout_test(void);
+    void _replay2x_test(void);
+
+private:
+    typedef struct {
+        uint16_t    sequence;
+        uint8_t     firstMessage;
+        QByteArray  data;
+        quint64     timestamp;      ///< Timestamp of the last message starting in or before the packet
+    } Packet_t;
+
+    void _buildLog(int cMessages, quint64 intervalUSecs, int payloadSize, int largeMessageInterval);
+    QByteArray _readLog(MAVLinkLogProcessor& processor);
+
+    QTemporaryDir*  _logDir;
+    QByteArray      _log;
+    QList<Packet_t> _packets;
+};
+
+#endif
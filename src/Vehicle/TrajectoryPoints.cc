@@ -0,0 +1,249 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TrajectoryPoints.h"
+#include "Vehicle.h"
+
+#include <QtMath>
+
+const double TrajectoryPoints::cInitialToleranceMeters =    1.0;
+const double TrajectoryPoints::_metersPerDegreeLatitude =   111319.49;
+
+// Keep the trail smaller on mobile due to perf impact of long lines
+#ifdef __mobile__
+const int TrajectoryPoints::cMaxPoints = 2000;
+#else
+const int TrajectoryPoints::cMaxPoints = 10000;
+#endif
+
+TrajectoryPoints::TrajectoryPoints(Vehicle* vehicle, QObject* parent)
+    : QObject(parent)
+    , _vehicle(vehicle)
+    , _tolerance(cInitialToleranceMeters)
+    , _originLatitude(0)
+    , _originLongitude(0)
+    , _metersPerDegreeLongitude(_metersPerDegreeLatitude)
+{
+
+}
+
+void TrajectoryPoints::start(void)
+{
+    clear();
+    if (_vehicle) {
+        connect(_vehicle, &Vehicle::coordinateChanged, this, &TrajectoryPoints::_vehicleCoordinateChanged, Qt::UniqueConnection);
+        addSample(_vehicle->coordinate());
+    }
+}
+
+void TrajectoryPoints::stop(void)
+{
+    if (_vehicle) {
+        disconnect(_vehicle, &Vehicle::coordinateChanged, this, &TrajectoryPoints::_vehicleCoordinateChanged);
+    }
+}
+
+void TrajectoryPoints::clear(void)
+{
+    _points.clear();
+    _segmentSamples.clear();
+    _tolerance = cInitialToleranceMeters;
+    emit pointsCleared();
+}
+
+void TrajectoryPoints::_vehicleCoordinateChanged(QGeoCoordinate coordinate)
+{
+    addSample(coordinate);
+}
+
+void TrajectoryPoints::addSample(const QGeoCoordinate& coordinate)
+{
+    if (!coordinate.isValid()) {
+        return;
+    }
+
+    Point point = _point(coordinate);
+
+    if (_points.count() < 2) {
+        if (_points.count() == 0 || _distance(_points.last(), point) >= cInitialToleranceMeters) {
+            _points.append(point);
+            emit pointAdded(coordinate);
+        }
+        return;
+    }
+
+    Point& lastPoint = _points.last();
+
+    // Position noise while the vehicle is not moving is not worth a point
+    if (_distance(lastPoint, point) < cInitialToleranceMeters) {
+        return;
+    }
+
+    // The last point can move to the new sample if all the samples it moved through stay within tolerance of the new line
+    const Point&    previousPoint =     _points[_points.count() - 2];
+    bool            withinTolerance =   _segmentSamples.count() < cMaxSegmentSamples && _segmentDistance(lastPoint, previousPoint, point) <= _tolerance;
+    for (int i=0; withinTolerance && i<_segmentSamples.count(); i++) {
+        withinTolerance = _segmentDistance(_segmentSamples[i], previousPoint, point) <= _tolerance;
+    }
+
+    if (withinTolerance) {
+        _segmentSamples.append(lastPoint);
+        lastPoint = point;
+        emit updateLastPoint(coordinate);
+    } else {
+        _segmentSamples.clear();
+        _points.append(point);
+        emit pointAdded(coordinate);
+
+        if (_points.count() > cMaxPoints) {
+            _compact();
+        }
+    }
+}
+
+/// Simplifies the trail with increasing tolerance until it is down to half of cMaxPoints
+void TrajectoryPoints::_compact(void)
+{
+    // The last point is not part of the simplification since it still follows the vehicle. The one before it is kept
+    // since the samples in _segmentSamples are relative to it.
+    Point lastPoint = _points.last();
+
+    do {
+        _tolerance *= 2;
+        _points = _simplify(_points, _points.count() - 1, _tolerance);
+        _points.append(lastPoint);
+    } while (_points.count() > cMaxPoints / 2);
+
+    emit pointsSimplified();
+}
+
+QVariantList TrajectoryPoints::list(void) const
+{
+    QVariantList list;
+
+    list.reserve(_points.count());
+    foreach (const Point& point, _points) {
+        list.append(QVariant::fromValue(_coordinate(point)));
+    }
+
+    return list;
+}
+
+QVariantList TrajectoryPoints::simplifiedList(double toleranceMeters) const
+{
+    if (toleranceMeters <= _tolerance || _points.count() < 3) {
+        return list();
+    }
+
+    QVariantList list;
+
+    foreach (const Point& point, _simplify(_points, _points.count(), toleranceMeters)) {
+        list.append(QVariant::fromValue(_coordinate(point)));
+    }
+
+    return list;
+}
+
+TrajectoryPoints::Point TrajectoryPoints::_point(const QGeoCoordinate& coordinate)
+{
+    // Positions are projected to a flat plane around the first point of the trail, which is plenty for a tolerance of meters
+    if (_points.isEmpty()) {
+        _originLatitude = coordinate.latitude();
+        _originLongitude = coordinate.longitude();
+        _metersPerDegreeLongitude = _metersPerDegreeLatitude * qCos(qDegreesToRadians(_originLatitude));
+    }
+
+    Point point;
+
+    point.latitude =    coordinate.latitude();
+    point.longitude =   coordinate.longitude();
+    point.altitude =    coordinate.altitude();
+    point.x =           (point.longitude - _originLongitude) * _metersPerDegreeLongitude;
+    point.y =           (point.latitude - _originLatitude) * _metersPerDegreeLatitude;
+
+    return point;
+}
+
+QGeoCoordinate TrajectoryPoints::_coordinate(const Point& point)
+{
+    return QGeoCoordinate(point.latitude, point.longitude, point.altitude);
+}
+
+double TrajectoryPoints::_distance(const Point& point1, const Point& point2)
+{
+    return qSqrt(qPow(point1.x - point2.x, 2) + qPow(point1.y - point2.y, 2));
+}
+
+/// @return Distance from point to the segment from start to end
+double TrajectoryPoints::_segmentDistance(const Point& point, const Point& start, const Point& end)
+{
+    double dx =             end.x - start.x;
+    double dy =             end.y - start.y;
+    double lengthSquared =  (dx * dx) + (dy * dy);
+
+    if (lengthSquared == 0) {
+        return _distance(point, start);
+    }
+
+    double t = qBound(0.0, (((point.x - start.x) * dx) + ((point.y - start.y) * dy)) / lengthSquared, 1.0);
+
+    Point projection = start;
+    projection.x += t * dx;
+    projection.y += t * dy;
+
+    return _distance(point, projection);
+}
+
+/// Douglas-Peucker simplification
+///     @param count Number of points from the start of points to simplify
+/// @return Simplified points, the first and last point are always kept
+QVector<TrajectoryPoints::Point> TrajectoryPoints::_simplify(const QVector<Point>& points, int count, double tolerance)
+{
+    QVector<Point> simplified;
+
+    if (count < 3) {
+        simplified = points.mid(0, count);
+        return simplified;
+    }
+
+    QVector<bool>               keep(count, false);
+    QVector<QPair<int, int> >   ranges;
+
+    keep[0] = true;
+    keep[count - 1] = true;
+    ranges.append(qMakePair(0, count - 1));
+
+    while (!ranges.isEmpty()) {
+        QPair<int, int> range = ranges.takeLast();
+        double          maxDistance = 0;
+        int             maxIndex = -1;
+
+        for (int i=range.first + 1; i<range.second; i++) {
+            double distance = _segmentDistance(points[i], points[range.first], points[range.second]);
+            if (distance > maxDistance) {
+                maxDistance = distance;
+                maxIndex = i;
+            }
+        }
+
+        if (maxIndex != -1 && maxDistance > tolerance) {
+            keep[maxIndex] = true;
+            ranges.append(qMakePair(range.first, maxIndex));
+            ranges.append(qMakePair(maxIndex, range.second));
+        }
+    }
+
+    for (int i=0; i<count; i++) {
+        if (keep[i]) {
+            simplified.append(points[i]);
+        }
+    }
+
+    return simplified;
+}
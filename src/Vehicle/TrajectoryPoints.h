@@ -0,0 +1,98 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef TrajectoryPoints_H
+#define TrajectoryPoints_H
+
+#include <QObject>
+#include <QVector>
+#include <QVariantList>
+#include <QGeoCoordinate>
+
+class Vehicle;
+
+/// Flight trail of a vehicle, shown on the map as a single polyline.
+///
+/// Points are sampled from the vehicle position updates and simplified as they arrive: the last point of the trail follows
+/// the vehicle until the positions it passed through are no longer within tolerance of the straight line from the previous
+/// point. Only then a new point is added. Once the trail reaches cMaxPoints it is simplified again (Douglas-Peucker) with
+/// a larger tolerance, so the whole flight is kept at a bounded cost.
+///
+/// The map loads the trail with list/simplifiedList and then follows pointAdded/updateLastPoint. It must reload the trail on
+/// pointsSimplified.
+class TrajectoryPoints : public QObject
+{
+    Q_OBJECT
+
+public:
+    TrajectoryPoints(Vehicle* vehicle, QObject* parent = NULL);
+
+    /// @return All points of the trail (QGeoCoordinate), the last point is the latest vehicle position
+    Q_INVOKABLE QVariantList list(void) const;
+
+    /// @return Trail without the points which are closer than toleranceMeters to the simplified line, used to match the
+    ///         trail to the zoom level of the map
+    Q_INVOKABLE QVariantList simplifiedList(double toleranceMeters) const;
+
+    /// Clears the trail and starts following the vehicle position
+    void start(void);
+
+    /// Stops following the vehicle position, the trail is kept
+    void stop(void);
+
+    void clear(void);
+
+    /// Adds a vehicle position to the trail
+    void addSample(const QGeoCoordinate& coordinate);
+
+    int     count       (void) const { return _points.count(); }
+    double  tolerance   (void) const { return _tolerance; }
+
+    static const double cInitialToleranceMeters;
+    static const int    cMaxPoints;
+    static const int    cMaxSegmentSamples = 100;   ///< Limits the work per sample
+
+signals:
+    void pointAdded         (QGeoCoordinate coordinate);
+    void updateLastPoint    (QGeoCoordinate coordinate);
+    void pointsCleared      (void);
+    void pointsSimplified   (void);
+
+private slots:
+    void _vehicleCoordinateChanged(QGeoCoordinate coordinate);
+
+private:
+    struct Point {
+        double latitude;
+        double longitude;
+        double altitude;
+        double x;           ///< Meters east of the first point of the trail
+        double y;           ///< Meters north of the first point of the trail
+    };
+
+    Point _point(const QGeoCoordinate& coordinate);
+    void  _compact(void);
+
+    static QGeoCoordinate   _coordinate     (const Point& point);
+    static double           _distance       (const Point& point1, const Point& point2);
+    static double           _segmentDistance(const Point& point, const Point& start, const Point& end);
+    static QVector<Point>   _simplify       (const QVector<Point>& points, int count, double tolerance);
+
+    Vehicle*        _vehicle;
+    QVector<Point>  _points;                    ///< Points of the trail, the last one follows the vehicle
+    QVector<Point>  _segmentSamples;            ///< Samples the last point moved through since the previous point
+    double          _tolerance;
+    double          _originLatitude;
+    double          _originLongitude;
+    double          _metersPerDegreeLongitude;
+
+    static const double _metersPerDegreeLatitude;
+};
+
+#endif
@@ -0,0 +1,119 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TrajectoryPointsTest.h"
+#include "TrajectoryPoints.h"
+
+#include <QSignalSpy>
+
+QGeoCoordinate TrajectoryPointsTest::_offset(double east, double north)
+{
+    static const QGeoCoordinate origin(47.3977, 8.5456, 500);
+
+    return origin.atDistanceAndAzimuth(east, 90).atDistanceAndAzimuth(north, 0);
+}
+
+void TrajectoryPointsTest::_straightLine(void)
+{
+    TrajectoryPoints    trajectoryPoints(NULL);
+    QSignalSpy          spyAdded(&trajectoryPoints, &TrajectoryPoints::pointAdded);
+    QSignalSpy          spyUpdate(&trajectoryPoints, &TrajectoryPoints::updateLastPoint);
+
+    for (int i=0; i<=100; i++) {
+        trajectoryPoints.addSample(_offset(i * 5, 0));
+    }
+
+    // A straight line only needs the start and the vehicle position
+    QCOMPARE(trajectoryPoints.count(), 2);
+    QCOMPARE(spyAdded.count(), 2);
+    QCOMPARE(spyUpdate.count(), 99);
+
+    QVariantList list = trajectoryPoints.list();
+    QVERIFY(list[0].value<QGeoCoordinate>().distanceTo(_offset(0, 0)) < 0.01);
+    QVERIFY(list[1].value<QGeoCoordinate>().distanceTo(_offset(500, 0)) < 0.01);
+}
+
+void TrajectoryPointsTest::_stationaryNoise(void)
+{
+    TrajectoryPoints trajectoryPoints(NULL);
+
+    trajectoryPoints.addSample(_offset(0, 0));
+    trajectoryPoints.addSample(_offset(10, 0));
+    for (int i=0; i<50; i++) {
+        trajectoryPoints.addSample(_offset(10 + ((i % 3) * 0.2), (i % 2) * 0.3));
+    }
+
+    QCOMPARE(trajectoryPoints.count(), 2);
+    QVERIFY(trajectoryPoints.list()[1].value<QGeoCoordinate>().distanceTo(_offset(10, 0)) < 0.01);
+}
+
+void TrajectoryPointsTest::_corner(void)
+{
+    TrajectoryPoints trajectoryPoints(NULL);
+
+    for (int i=0; i<=20; i++) {
+        trajectoryPoints.addSample(_offset(i * 5, 0));
+    }
+    for (int i=1; i<=20; i++) {
+        trajectoryPoints.addSample(_offset(100, i * 5));
+    }
+
+    // The corner must stay in the trail within the tolerance
+    QVariantList list = trajectoryPoints.list();
+    QCOMPARE(list.count(), 3);
+    QVERIFY(list[1].value<QGeoCoordinate>().distanceTo(_offset(100, 0)) <= 5 + TrajectoryPoints::cInitialToleranceMeters);
+    QVERIFY(list[2].value<QGeoCoordinate>().distanceTo(_offset(100, 100)) < 0.01);
+}
+
+void TrajectoryPointsTest::_simplifiedList(void)
+{
+    TrajectoryPoints trajectoryPoints(NULL);
+
+    // Zig zag 10 meters to each side, every sample is a point of the trail
+    for (int i=0; i<=20; i++) {
+        trajectoryPoints.addSample(_offset(i * 20, (i % 2) ? 10 : -10));
+    }
+    QCOMPARE(trajectoryPoints.count(), 21);
+
+    QCOMPARE(trajectoryPoints.simplifiedList(TrajectoryPoints::cInitialToleranceMeters).count(), 21);
+    QCOMPARE(trajectoryPoints.simplifiedList(100).count(), 2);
+}
+
+void TrajectoryPointsTest::_compact(void)
+{
+    TrajectoryPoints    trajectoryPoints(NULL);
+    QSignalSpy          spySimplified(&trajectoryPoints, &TrajectoryPoints::pointsSimplified);
+
+    for (int i=0; i<=TrajectoryPoints::cMaxPoints; i++) {
+        trajectoryPoints.addSample(_offset(i * 20, (i % 2) ? 10 : -10));
+    }
+
+    QCOMPARE(spySimplified.count(), 1);
+    QVERIFY(trajectoryPoints.count() <= TrajectoryPoints::cMaxPoints / 2);
+    QVERIFY(trajectoryPoints.tolerance() > TrajectoryPoints::cInitialToleranceMeters);
+
+    // The whole flight is kept
+    QVariantList list = trajectoryPoints.list();
+    QVERIFY(list.first().value<QGeoCoordinate>().distanceTo(_offset(0, -10)) < 0.01);
+    QVERIFY(list.last().value<QGeoCoordinate>().distanceTo(_offset(TrajectoryPoints::cMaxPoints * 20, (TrajectoryPoints::cMaxPoints % 2) ? 10 : -10)) < 0.01);
+}
+
+void TrajectoryPointsTest::_clear(void)
+{
+    TrajectoryPoints    trajectoryPoints(NULL);
+    QSignalSpy          spyCleared(&trajectoryPoints, &TrajectoryPoints::pointsCleared);
+
+    trajectoryPoints.addSample(_offset(0, 0));
+    trajectoryPoints.addSample(_offset(10, 0));
+    trajectoryPoints.clear();
+
+    QCOMPARE(spyCleared.count(), 1);
+    QCOMPARE(trajectoryPoints.count(), 0);
+    QCOMPARE(trajectoryPoints.tolerance(), TrajectoryPoints::cInitialToleranceMeters);
+}
@@ -0,0 +1,33 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef TrajectoryPointsTest_H
+#define TrajectoryPointsTest_H
+
+#include "UnitTest.h"
+
+#include <QGeoCoordinate>
+
+class TrajectoryPointsTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _straightLine(void);
+    void _stationaryNoise(void);
+    void _corner(void);
+    void _simplifiedList(void);
+    void _compact(void);
+    void _clear(void);
+
+private:
+    QGeoCoordinate _offset(double east, double north);
+};
+
+#endif
@@ -0,0 +1,686 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ULogStreamDecoder.h"
+
+#include <QDateTime>
+#include <QQmlEngine>
+
+#include <string.h>
+
+QGC_LOGGING_CATEGORY(ULogStreamDecoderLog, "ULogStreamDecoderLog")
+
+ULogStreamFactGroup::ULogStreamFactGroup(QObject* parent)
+    : FactGroup(0, parent)
+{
+
+}
+
+Fact* ULogStreamFactGroup::fact(const QString& name)
+{
+    if (_nameToFactMap.contains(name)) {
+        return _nameToFactMap[name];
+    }
+
+    Fact* fact = new Fact(0, name, FactMetaData::valueTypeDouble, this);
+    _addFact(fact, name);
+    // Handed out to QML through subscribe, the group keeps ownership
+    QQmlEngine::setObjectOwnership(fact, QQmlEngine::CppOwnership);
+    return fact;
+}
+
+ULogStreamFactGroup* ULogStreamFactGroup::group(const QString& name)
+{
+    if (_nameToFactGroupMap.contains(name)) {
+        return qobject_cast<ULogStreamFactGroup*>(_nameToFactGroupMap[name]);
+    }
+
+    ULogStreamFactGroup* group = new ULogStreamFactGroup(this);
+    _addFactGroup(group, name);
+    return group;
+}
+
+ULogStreamDecoder::ULogStreamDecoder(QObject* parent)
+    : QObject(parent)
+    , _vehicleId(0)
+    , _timeOffsetValid(false)
+    , _timeOffsetMSecs(0)
+{
+    _factUpdateTimer.setInterval(cFactUpdateRateMSecs);
+    _factUpdateTimer.setSingleShot(false);
+    connect(&_factUpdateTimer, &QTimer::timeout, this, &ULogStreamDecoder::_updateFacts);
+}
+
+ULogStreamDecoder::~ULogStreamDecoder()
+{
+    qDeleteAll(_subscriptions);
+}
+
+void ULogStreamDecoder::start(int vehicleId)
+{
+    _vehicleId = vehicleId;
+    _formats.clear();
+    _formatSizes.clear();
+    _loggedTopics.clear();
+    _decoders.clear();
+    _timeOffsetValid = false;
+    emit topicsChanged();
+}
+
+QStringList ULogStreamDecoder::topics(void) const
+{
+    QStringList topics;
+
+    foreach (const LoggedTopic& topic, _loggedTopics) {
+        QString name = _groupName(topic.name, topic.multiId);
+        if (!topics.contains(name)) {
+            topics.append(name);
+        }
+    }
+    topics.sort();
+
+    return topics;
+}
+
+QStringList ULogStreamDecoder::subscriptions(void) const
+{
+    QStringList subscriptions;
+
+    foreach (const Subscription* subscription, _subscriptions) {
+        subscriptions.append(QStringLiteral("%1.%2").arg(_groupName(subscription->topic, subscription->multiId)).arg(subscription->field));
+    }
+
+    return subscriptions;
+}
+
+/// Splits a topic as listed in topics into the topic name and instance. Names which aren't in the log are taken as is.
+void ULogStreamDecoder::_splitListedTopic(const QString& listedTopic, QString& topic, int& multiId) const
+{
+    foreach (const LoggedTopic& loggedTopic, _loggedTopics) {
+        if (_groupName(loggedTopic.name, loggedTopic.multiId) == listedTopic) {
+            topic = loggedTopic.name;
+            multiId = loggedTopic.multiId;
+            return;
+        }
+    }
+
+    topic = listedTopic;
+    multiId = 0;
+}
+
+QStringList ULogStreamDecoder::fields(const QString& topic) const
+{
+    QStringList fields;
+    QString     format;
+    int         multiId;
+
+    _splitListedTopic(topic, format, multiId);
+    _appendFields(format, QString(), fields, 0);
+    return fields;
+}
+
+void ULogStreamDecoder::_appendFields(const QString& format, const QString& prefix, QStringList& fields, int depth) const
+{
+    if (depth > _cMaxNestingDepth || !_formats.contains(format)) {
+        return;
+    }
+
+    foreach (const FormatField& formatField, _formats[format]) {
+        FieldType_t type = _basicType(formatField.typeName);
+
+        if (type == TypeChar || formatField.name.startsWith(QStringLiteral("_padding"))) {
+            continue;
+        }
+
+        QStringList names;
+        if (formatField.arraySize) {
+            for (int i=0; i<formatField.arraySize; i++) {
+                names.append(QStringLiteral("%1%2[%3]").arg(prefix).arg(formatField.name).arg(i));
+            }
+        } else {
+            names.append(prefix + formatField.name);
+        }
+
+        foreach (const QString& name, names) {
+            if (type == TypeNested) {
+                _appendFields(formatField.typeName, name + QStringLiteral("."), fields, depth + 1);
+            } else {
+                fields.append(name);
+            }
+        }
+    }
+}
+
+ULogStreamDecoder::Subscription* ULogStreamDecoder::_subscription(const QString& topic, const QString& field, int multiId) const
+{
+    foreach (Subscription* subscription, _subscriptions) {
+        if (subscription->topic == topic && subscription->field == field && subscription->multiId == multiId) {
+            return subscription;
+        }
+    }
+    return NULL;
+}
+
+/// @return Subscription for the specified entry of subscriptions
+ULogStreamDecoder::Subscription* ULogStreamDecoder::_subscription(const QString& subscription) const
+{
+    int index = subscriptions().indexOf(subscription);
+
+    return index == -1 ? NULL : _subscriptions[index];
+}
+
+Fact* ULogStreamDecoder::subscribe(const QString& topic, const QString& field, int multiId)
+{
+    Subscription* subscription = _subscription(topic, field, multiId);
+
+    if (!subscription) {
+        QString groupName = _groupName(topic, multiId);
+
+        subscription = new Subscription;
+        subscription->topic = topic;
+        subscription->field = field;
+        subscription->multiId = multiId;
+        subscription->curveName = QStringLiteral("ULog:%1.%2").arg(groupName).arg(field);
+        subscription->fact = _values.group(groupName)->fact(field);
+        subscription->value = 0;
+        subscription->updated = false;
+        _subscriptions.append(subscription);
+
+        qCDebug(ULogStreamDecoderLog) << "Subscribed" << subscription->curveName;
+
+        _resolveAll();
+        if (!_factUpdateTimer.isActive()) {
+            _factUpdateTimer.start();
+        }
+        emit subscriptionsChanged();
+    }
+
+    return subscription->fact;
+}
+
+void ULogStreamDecoder::unsubscribe(const QString& topic, const QString& field, int multiId)
+{
+    Subscription* subscription = _subscription(topic, field, multiId);
+
+    if (subscription) {
+        // The Fact stays in the values group, QML may still be bound to it
+        _subscriptions.removeOne(subscription);
+        _resolveAll();
+        delete subscription;
+
+        if (_subscriptions.isEmpty()) {
+            _factUpdateTimer.stop();
+        }
+        emit subscriptionsChanged();
+    }
+}
+
+Fact* ULogStreamDecoder::subscribeListed(const QString& listedTopic, const QString& field)
+{
+    QString topic;
+    int     multiId;
+
+    _splitListedTopic(listedTopic, topic, multiId);
+    return subscribe(topic, field, multiId);
+}
+
+Fact* ULogStreamDecoder::subscriptionFact(const QString& subscription) const
+{
+    Subscription* entry = _subscription(subscription);
+
+    return entry ? entry->fact : NULL;
+}
+
+void ULogStreamDecoder::removeSubscription(const QString& subscription)
+{
+    Subscription* entry = _subscription(subscription);
+
+    if (entry) {
+        unsubscribe(entry->topic, entry->field, entry->multiId);
+    }
+}
+
+void ULogStreamDecoder::processMessage(const char* message, int length)
+{
+    const int cbHeader = 3;
+
+    if (length < cbHeader) {
+        return;
+    }
+
+    const char* payload = message + cbHeader;
+    int         cbPayload = length - cbHeader;
+
+    switch (message[2]) {
+    case 'D':
+        _processData(payload, cbPayload);
+        break;
+    case 'F':
+        _processFormat(payload, cbPayload);
+        break;
+    case 'A':
+        _processAddLogged(payload, cbPayload);
+        break;
+    case 'R':
+        _processRemoveLogged(payload, cbPayload);
+        break;
+    default:
+        // Info, parameters, logged strings, sync and dropouts have nothing to plot
+        break;
+    }
+}
+
+void ULogStreamDecoder::_processFormat(const char* payload, int length)
+{
+    // "message_name:type field;type[n] field;..."
+    QString format = QString::fromLatin1(payload, length);
+    int     colon = format.indexOf(QLatin1Char(':'));
+
+    if (colon <= 0) {
+        qCWarning(ULogStreamDecoderLog) << "Invalid format" << format;
+        return;
+    }
+
+    QString             name = format.left(colon);
+    QList<FormatField>  fields;
+
+    foreach (const QString& fieldString, format.mid(colon + 1).split(QLatin1Char(';'), QString::SkipEmptyParts)) {
+        QStringList parts = fieldString.split(QLatin1Char(' '), QString::SkipEmptyParts);
+        if (parts.count() != 2) {
+            qCWarning(ULogStreamDecoderLog) << "Invalid field" << fieldString << "in format" << name;
+            return;
+        }
+
+        FormatField field;
+        field.typeName = parts[0];
+        field.name = parts[1];
+        field.arraySize = 0;
+
+        int bracket = field.typeName.indexOf(QLatin1Char('['));
+        if (bracket != -1) {
+            bool ok;
+            field.arraySize = field.typeName.mid(bracket + 1, field.typeName.length() - bracket - 2).toInt(&ok);
+            if (!ok || field.arraySize <= 0 || !field.typeName.endsWith(QLatin1Char(']'))) {
+                qCWarning(ULogStreamDecoderLog) << "Invalid array size" << fieldString << "in format" << name;
+                return;
+            }
+            field.typeName = field.typeName.left(bracket);
+        }
+        fields.append(field);
+    }
+
+    _formats[name] = fields;
+    _formatSizes.clear();
+
+    // Formats normally all come before the first topic is added, this only happens for out of order definitions
+    if (!_loggedTopics.isEmpty()) {
+        _resolveAll();
+    }
+}
+
+void ULogStreamDecoder::_processAddLogged(const char* payload, int length)
+{
+    // uint8_t multi_id, uint16_t msg_id, char message_name[]
+    const int cbFixed = 3;
+
+    if (length <= cbFixed) {
+        return;
+    }
+
+    uint16_t    msgId;
+    LoggedTopic topic;
+
+    memcpy(&msgId, payload + 1, sizeof(msgId));
+    topic.multiId = (uint8_t)payload[0];
+    topic.name = QString::fromLatin1(payload + cbFixed, length - cbFixed);
+    _loggedTopics[msgId] = topic;
+
+    _resolve(msgId);
+    emit topicsChanged();
+}
+
+void ULogStreamDecoder::_processRemoveLogged(const char* payload, int length)
+{
+    uint16_t msgId;
+
+    if (length < (int)sizeof(msgId)) {
+        return;
+    }
+
+    memcpy(&msgId, payload, sizeof(msgId));
+    _loggedTopics.remove(msgId);
+
+    _resolve(msgId);
+    emit topicsChanged();
+}
+
+void ULogStreamDecoder::_processData(const char* payload, int length)
+{
+    uint16_t msgId;
+
+    if (length < (int)sizeof(msgId)) {
+        return;
+    }
+
+    memcpy(&msgId, payload, sizeof(msgId));
+    if (msgId >= _decoders.count()) {
+        return;
+    }
+
+    const TopicDecoder& decoder = _decoders.at(msgId);
+    const char*         data = payload + sizeof(msgId);
+    int                 cbData = length - sizeof(msgId);
+
+    if (decoder.fields.isEmpty() || cbData < decoder.minSize) {
+        return;
+    }
+
+    quint64 msecs;
+    if (decoder.timestampOffset != -1) {
+        quint64 timestamp;
+        memcpy(&timestamp, data + decoder.timestampOffset, sizeof(timestamp));
+
+        // The log uses boot time, the charts want Unix time. Logs are streamed close to real time, so the
+        // offset from the first message is good enough.
+        if (!_timeOffsetValid) {
+            _timeOffsetMSecs = QDateTime::currentMSecsSinceEpoch() - (qint64)(timestamp / 1000);
+            _timeOffsetValid = true;
+        }
+        msecs = _timeOffsetMSecs + timestamp / 1000;
+    } else {
+        msecs = QDateTime::currentMSecsSinceEpoch();
+    }
+
+    for (int i=0; i<decoder.fields.count(); i++) {
+        const DecodedField& field = decoder.fields[i];
+        double value = _value(data + field.offset, field.type);
+
+        field.subscription->value = value;
+        field.subscription->updated = true;
+        emit valueChanged(_vehicleId, field.subscription->curveName, field.unit, value, msecs);
+    }
+}
+
+void ULogStreamDecoder::_resolveAll(void)
+{
+    _decoders.clear();
+
+    foreach (uint16_t msgId, _loggedTopics.keys()) {
+        _resolve(msgId);
+    }
+}
+
+void ULogStreamDecoder::_resolve(uint16_t msgId)
+{
+    if (msgId >= _decoders.count()) {
+        _decoders.resize(msgId + 1);
+    }
+
+    TopicDecoder& decoder = _decoders[msgId];
+    decoder = TopicDecoder();
+
+    QMap<uint16_t, LoggedTopic>::const_iterator iter = _loggedTopics.constFind(msgId);
+    if (iter == _loggedTopics.constEnd()) {
+        return;
+    }
+    const LoggedTopic& topic = iter.value();
+
+    foreach (Subscription* subscription, _subscriptions) {
+        if (subscription->topic != topic.name || subscription->multiId != topic.multiId) {
+            continue;
+        }
+
+        DecodedField    field;
+        int             size;
+
+        if (!_fieldLayout(topic.name, subscription->field, field.offset, field.type)) {
+            qCWarning(ULogStreamDecoderLog) << "Field not in topic format" << subscription->curveName;
+            continue;
+        }
+        field.subscription = subscription;
+
+        switch (field.type) {
+        case TypeInt8:      field.unit = QStringLiteral("int8_t");      size = 1;   break;
+        case TypeUInt8:     field.unit = QStringLiteral("uint8_t");     size = 1;   break;
+        case TypeInt16:     field.unit = QStringLiteral("int16_t");     size = 2;   break;
+        case TypeUInt16:    field.unit = QStringLiteral("uint16_t");    size = 2;   break;
+        case TypeInt32:     field.unit = QStringLiteral("int32_t");     size = 4;   break;
+        case TypeUInt32:    field.unit = QStringLiteral("uint32_t");    size = 4;   break;
+        case TypeInt64:     field.unit = QStringLiteral("int64_t");     size = 8;   break;
+        case TypeUInt64:    field.unit = QStringLiteral("uint64_t");    size = 8;   break;
+        case TypeFloat:     field.unit = QStringLiteral("float");       size = 4;   break;
+        case TypeDouble:    field.unit = QStringLiteral("double");      size = 8;   break;
+        default:            field.unit = QStringLiteral("bool");        size = 1;   break;
+        }
+
+        decoder.minSize = qMax(decoder.minSize, field.offset + size);
+        decoder.fields.append(field);
+    }
+
+    if (!decoder.fields.isEmpty()) {
+        int         offset;
+        FieldType_t type;
+
+        if (_fieldLayout(topic.name, QStringLiteral("timestamp"), offset, type) && type == TypeUInt64) {
+            decoder.timestampOffset = offset;
+            decoder.minSize = qMax(decoder.minSize, offset + (int)sizeof(quint64));
+        }
+        qCDebug(ULogStreamDecoderLog) << "Decoding" << decoder.fields.count() << "fields of" << _groupName(topic.name, topic.multiId) << "msg_id" << msgId;
+    }
+}
+
+bool ULogStreamDecoder::_fieldLayout(const QString& format, const QString& path, int& offset, FieldType_t& type) const
+{
+    QString     currentFormat = format;
+    QStringList parts = path.split(QLatin1Char('.'));
+
+    offset = 0;
+
+    for (int i=0; i<parts.count(); i++) {
+        QString name = parts[i];
+        int     element = -1;
+        bool    last = i == parts.count() - 1;
+
+        int bracket = name.indexOf(QLatin1Char('['));
+        if (bracket != -1) {
+            bool ok;
+            element = name.mid(bracket + 1, name.length() - bracket - 2).toInt(&ok);
+            if (!ok || element < 0 || !name.endsWith(QLatin1Char(']'))) {
+                return false;
+            }
+            name = name.left(bracket);
+        }
+
+        QHash<QString, QList<FormatField> >::const_iterator iter = _formats.constFind(currentFormat);
+        if (iter == _formats.constEnd()) {
+            return false;
+        }
+
+        bool    found = false;
+        int     fieldOffset = 0;
+
+        foreach (const FormatField& formatField, iter.value()) {
+            int elementSize = _typeSize(formatField.typeName);
+            if (elementSize < 0) {
+                // Unknown type, nothing after it can be located
+                return false;
+            }
+
+            if (formatField.name == name) {
+                if (formatField.arraySize ? element >= formatField.arraySize || element < 0 : element != -1) {
+                    return false;
+                }
+
+                offset += fieldOffset + qMax(element, 0) * elementSize;
+                type = _basicType(formatField.typeName);
+                if (type == TypeNested) {
+                    if (last) {
+                        return false;
+                    }
+                    currentFormat = formatField.typeName;
+                } else if (!last || type == TypeChar) {
+                    return false;
+                }
+                found = true;
+                break;
+            }
+
+            fieldOffset += elementSize * qMax(formatField.arraySize, 1);
+        }
+
+        if (!found) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int ULogStreamDecoder::_typeSize(const QString& typeName, int depth) const
+{
+    int size;
+
+    if (_basicType(typeName, &size) != TypeNested) {
+        return size;
+    }
+
+    QHash<QString, int>::const_iterator sizeIter = _formatSizes.constFind(typeName);
+    if (sizeIter != _formatSizes.constEnd()) {
+        return sizeIter.value();
+    }
+
+    QHash<QString, QList<FormatField> >::const_iterator iter = _formats.constFind(typeName);
+    if (depth > _cMaxNestingDepth || iter == _formats.constEnd()) {
+        return -1;
+    }
+
+    size = 0;
+    foreach (const FormatField& formatField, iter.value()) {
+        int fieldSize = _typeSize(formatField.typeName, depth + 1);
+        if (fieldSize < 0) {
+            return -1;
+        }
+        size += fieldSize * qMax(formatField.arraySize, 1);
+    }
+    _formatSizes[typeName] = size;
+
+    return size;
+}
+
+QString ULogStreamDecoder::_groupName(const QString& topic, int multiId)
+{
+    return multiId ? QStringLiteral("%1_%2").arg(topic).arg(multiId) : topic;
+}
+
+ULogStreamDecoder::FieldType_t ULogStreamDecoder::_basicType(const QString& typeName, int* size)
+{
+    static const struct {
+        const char*     name;
+        FieldType_t     type;
+        int             size;
+    } rgTypes[] = {
+        { "int8_t",     TypeInt8,   1 },
+        { "uint8_t",    TypeUInt8,  1 },
+        { "int16_t",    TypeInt16,  2 },
+        { "uint16_t",   TypeUInt16, 2 },
+        { "int32_t",    TypeInt32,  4 },
+        { "uint32_t",   TypeUInt32, 4 },
+        { "int64_t",    TypeInt64,  8 },
+        { "uint64_t",   TypeUInt64, 8 },
+        { "float",      TypeFloat,  4 },
+        { "double",     TypeDouble, 8 },
+        { "bool",       TypeBool,   1 },
+        { "char",       TypeChar,   1 },
+    };
+
+    for (size_t i=0; i<sizeof(rgTypes)/sizeof(rgTypes[0]); i++) {
+        if (typeName == QLatin1String(rgTypes[i].name)) {
+            if (size) {
+                *size = rgTypes[i].size;
+            }
+            return rgTypes[i].type;
+        }
+    }
+
+    if (size) {
+        *size = -1;
+    }
+    return TypeNested;
+}
+
+double ULogStreamDecoder::_value(const char* data, FieldType_t type)
+{
+    switch (type) {
+    case TypeInt8:
+        return *(const int8_t*)data;
+    case TypeUInt8:
+    case TypeBool:
+        return *(const uint8_t*)data;
+    case TypeInt16:
+    {
+        int16_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+    case TypeUInt16:
+    {
+        uint16_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+    case TypeInt32:
+    {
+        int32_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+    case TypeUInt32:
+    {
+        uint32_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+    case TypeInt64:
+    {
+        int64_t value;
+        memcpy(&value, data, sizeof(value));
+        return (double)value;
+    }
+    case TypeUInt64:
+    {
+        uint64_t value;
+        memcpy(&value, data, sizeof(value));
+        return (double)value;
+    }
+    case TypeFloat:
+    {
+        float value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+    case TypeDouble:
+    {
+        double value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+    default:
+        return 0;
+    }
+}
+
+void ULogStreamDecoder::_updateFacts(void)
+{
+    foreach (Subscription* subscription, _subscriptions) {
+        if (subscription->updated) {
+            subscription->fact->setRawValue(subscription->value);
+            subscription->updated = false;
+        }
+    }
+}
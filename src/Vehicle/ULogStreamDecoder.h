@@ -0,0 +1,191 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef ULogStreamDecoder_H
+#define ULogStreamDecoder_H
+
+#include "FactGroup.h"
+#include "QGCLoggingCategory.h"
+
+#include <QObject>
+#include <QHash>
+#include <QMap>
+#include <QVector>
+#include <QTimer>
+
+Q_DECLARE_LOGGING_CATEGORY(ULogStreamDecoderLog)
+
+/// FactGroup whose Facts and sub groups are created as topics/fields are subscribed
+class ULogStreamFactGroup : public FactGroup
+{
+    Q_OBJECT
+
+public:
+    ULogStreamFactGroup(QObject* parent = NULL);
+
+    /// @return Fact for the specified name, created if needed
+    Fact* fact(const QString& name);
+
+    /// @return Sub group for the specified name, created if needed
+    ULogStreamFactGroup* group(const QString& name);
+};
+
+/// Decodes the ULog messages of a log which is streamed over MAVLink while it is being written. The format and
+/// logged topic tables are kept for the duration of the log. Only subscribed fields are decoded: data messages
+/// of other topics are dropped after a single table lookup, so the cost per message is bounded by the number of
+/// subscribed fields of its topic.
+///
+/// Every decoded value is published through valueChanged, which has the same signature as UAS::valueChanged so it
+/// can feed the line charts directly. The latest value of each field is also available as a Fact through the
+/// values FactGroup: one sub group per topic ("sensor_combined", "sensor_gyro_1" for instance 1) with one Fact per
+/// subscribed field. Facts are updated at most every cFactUpdateRateMSecs.
+class ULogStreamDecoder : public QObject
+{
+    Q_OBJECT
+
+public:
+    ULogStreamDecoder(QObject* parent = NULL);
+    ~ULogStreamDecoder();
+
+    Q_PROPERTY(QStringList  topics          READ topics         NOTIFY topicsChanged)           ///< Topics in the current log
+    Q_PROPERTY(QStringList  subscriptions   READ subscriptions  NOTIFY subscriptionsChanged)    ///< "<topic>.<field>", topic as listed in topics
+    Q_PROPERTY(FactGroup*   values          READ values         CONSTANT)
+
+    /// @return Numeric fields of the specified topic, array elements and nested fields are listed individually
+    ///         (for example "q[0]" or "control.roll"). The topic can also be given as listed in topics.
+    Q_INVOKABLE QStringList fields(const QString& topic) const;
+
+    /// Starts decoding the specified field. The topic does not need to be in the log yet, subscriptions are
+    /// kept across logs.
+    ///     @param topic Topic name, for example "vehicle_attitude"
+    ///     @param field Field name as returned by fields
+    ///     @param multiId Topic instance
+    /// @return Fact which holds the latest value
+    Q_INVOKABLE Fact* subscribe(const QString& topic, const QString& field, int multiId = 0);
+
+    Q_INVOKABLE void unsubscribe(const QString& topic, const QString& field, int multiId = 0);
+
+    /// Same as subscribe, with the topic as listed in topics ("sensor_gyro_1" for instance 1)
+    Q_INVOKABLE Fact* subscribeListed(const QString& listedTopic, const QString& field);
+
+    /// @return Fact which holds the latest value of the specified entry of subscriptions, NULL if there is none
+    Q_INVOKABLE Fact* subscriptionFact(const QString& subscription) const;
+
+    /// Removes the specified entry of subscriptions
+    Q_INVOKABLE void removeSubscription(const QString& subscription);
+
+    /// Called when a new log starts. Clears the format and topic tables.
+    ///     @param vehicleId Id used for valueChanged
+    void start(int vehicleId);
+
+    /// Processes one complete ULog message, including the 3 byte message header
+    void processMessage(const char* message, int length);
+
+    QStringList topics          (void) const;
+    QStringList subscriptions   (void) const;
+    FactGroup*  values          (void) { return &_values; }
+
+    static const int cFactUpdateRateMSecs = 100;
+
+signals:
+    void topicsChanged(void);
+    void subscriptionsChanged(void);
+    void valueChanged(int uasId, const QString& name, const QString& unit, const QVariant& value, quint64 msecs);
+
+private slots:
+    void _updateFacts(void);
+
+private:
+    typedef enum {
+        TypeInt8,
+        TypeUInt8,
+        TypeInt16,
+        TypeUInt16,
+        TypeInt32,
+        TypeUInt32,
+        TypeInt64,
+        TypeUInt64,
+        TypeFloat,
+        TypeDouble,
+        TypeBool,
+        TypeChar,
+        TypeNested,     ///< Another format
+    } FieldType_t;
+
+    /// One field of a format message
+    struct FormatField {
+        QString     typeName;
+        QString     name;
+        int         arraySize;      ///< 0: not an array
+    };
+
+    struct LoggedTopic {
+        QString     name;
+        int         multiId;
+    };
+
+    struct Subscription {
+        QString     topic;
+        QString     field;
+        int         multiId;
+        QString     curveName;
+        Fact*       fact;
+        double      value;          ///< Latest value, not yet in the Fact if updated is set
+        bool        updated;
+    };
+
+    /// Subscribed field of a topic with its location in the data message
+    struct DecodedField {
+        int             offset;
+        FieldType_t     type;
+        QString         unit;
+        Subscription*   subscription;
+    };
+
+    /// Everything needed to decode the data messages of one msg_id
+    struct TopicDecoder {
+        TopicDecoder() : minSize(0), timestampOffset(-1) { }
+
+        int                     minSize;            ///< Data messages shorter than this are ignored
+        int                     timestampOffset;    ///< -1: topic has no timestamp
+        QVector<DecodedField>   fields;             ///< Empty: nothing subscribed
+    };
+
+    void _processFormat         (const char* payload, int length);
+    void _processAddLogged      (const char* payload, int length);
+    void _processRemoveLogged   (const char* payload, int length);
+    void _processData           (const char* payload, int length);
+    void _resolve               (uint16_t msgId);
+    void _resolveAll            (void);
+    bool _fieldLayout           (const QString& format, const QString& path, int& offset, FieldType_t& type) const;
+    int  _typeSize              (const QString& typeName, int depth = 0) const;
+    void _appendFields          (const QString& format, const QString& prefix, QStringList& fields, int depth) const;
+    Subscription* _subscription (const QString& topic, const QString& field, int multiId) const;
+    Subscription* _subscription (const QString& subscription) const;
+    void _splitListedTopic      (const QString& listedTopic, QString& topic, int& multiId) const;
+
+    static QString      _groupName  (const QString& topic, int multiId);
+    static FieldType_t  _basicType  (const QString& typeName, int* size = NULL);
+    static double       _value      (const char* data, FieldType_t type);
+
+    int                                 _vehicleId;
+    QHash<QString, QList<FormatField> > _formats;           ///< Format messages by name
+    mutable QHash<QString, int>         _formatSizes;       ///< Cache of nested format sizes
+    QMap<uint16_t, LoggedTopic>         _loggedTopics;      ///< By msg_id
+    QVector<TopicDecoder>               _decoders;          ///< Indexed by msg_id
+    QList<Subscription*>                _subscriptions;
+    bool                                _timeOffsetValid;
+    qint64                              _timeOffsetMSecs;   ///< Log timestamps (boot time) to Unix time
+    ULogStreamFactGroup                 _values;
+    QTimer                              _factUpdateTimer;
+
+    static const int _cMaxNestingDepth = 8;
+};
+
+#endif
@@ -0,0 +1,224 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ULogStreamDecoderTest.h"
+#include "ULogStreamDecoder.h"
+
+#include <QSignalSpy>
+
+void ULogStreamDecoderTest::_sendMessage(ULogStreamDecoder& decoder, char type, const QByteArray& payload)
+{
+    QByteArray message;
+
+    message.append((char)(payload.size() & 0xFF));
+    message.append((char)(payload.size() >> 8));
+    message.append(type);
+    message.append(payload);
+    decoder.processMessage(message.constData(), message.size());
+}
+
+void ULogStreamDecoderTest::_sendDefinitions(ULogStreamDecoder& decoder)
+{
+    _sendMessage(decoder, 'F', QByteArray("vehicle_attitude:uint64_t timestamp;float[4] q;uint8_t[4] _padding0;"));
+    _sendMessage(decoder, 'F', QByteArray("actuator_group:float roll;float pitch;"));
+    _sendMessage(decoder, 'F', QByteArray("actuator_out:uint64_t timestamp;int16_t count;actuator_group[2] group;char[3] name;uint8_t armed;"));
+
+    struct {
+        uint8_t     multiId;
+        uint16_t    msgId;
+        const char* name;
+    } rgAdd[] = {
+        { 0, _attitudeMsgId,    "vehicle_attitude" },
+        { 1, _attitude1MsgId,   "vehicle_attitude" },
+        { 0, _actuatorsMsgId,   "actuator_out" },
+    };
+
+    for (size_t i=0; i<sizeof(rgAdd)/sizeof(rgAdd[0]); i++) {
+        QByteArray payload;
+        payload.append((char)rgAdd[i].multiId);
+        payload.append((const char*)&rgAdd[i].msgId, sizeof(rgAdd[i].msgId));
+        payload.append(rgAdd[i].name);
+        _sendMessage(decoder, 'A', payload);
+    }
+}
+
+void ULogStreamDecoderTest::_sendAttitude(ULogStreamDecoder& decoder, uint16_t msgId, quint64 timestamp, float q2)
+{
+    QByteArray  payload;
+    float       q[4] = { 1.0f, 0.0f, q2, 0.0f };
+
+    payload.append((const char*)&msgId, sizeof(msgId));
+    payload.append((const char*)&timestamp, sizeof(timestamp));
+    payload.append((const char*)q, sizeof(q));
+    payload.append(4, 0);
+    _sendMessage(decoder, 'D', payload);
+}
+
+void ULogStreamDecoderTest::_sendActuators(ULogStreamDecoder& decoder, quint64 timestamp, float pitch1, uint8_t armed)
+{
+    QByteArray  payload;
+    uint16_t    msgId = _actuatorsMsgId;
+    int16_t     count = 2;
+    float       group[4] = { 0.1f, 0.2f, 0.3f, pitch1 };
+
+    payload.append((const char*)&msgId, sizeof(msgId));
+    payload.append((const char*)&timestamp, sizeof(timestamp));
+    payload.append((const char*)&count, sizeof(count));
+    payload.append((const char*)group, sizeof(group));
+    payload.append("abc", 3);
+    payload.append((char)armed);
+    _sendMessage(decoder, 'D', payload);
+}
+
+void ULogStreamDecoderTest::_fields_test(void)
+{
+    ULogStreamDecoder decoder;
+
+    decoder.start(1);
+    _sendDefinitions(decoder);
+
+    QCOMPARE(decoder.topics(), QStringList() << "actuator_out" << "vehicle_attitude" << "vehicle_attitude_1");
+    QCOMPARE(decoder.fields("vehicle_attitude"), QStringList() << "timestamp" << "q[0]" << "q[1]" << "q[2]" << "q[3]");
+    QCOMPARE(decoder.fields("actuator_out"), QStringList() << "timestamp" << "count" << "group[0].roll" << "group[0].pitch" << "group[1].roll" << "group[1].pitch" << "armed");
+
+    // A new log starts from empty tables
+    decoder.start(1);
+    QVERIFY(decoder.topics().isEmpty());
+    QVERIFY(decoder.fields("vehicle_attitude").isEmpty());
+}
+
+void ULogStreamDecoderTest::_decode_test(void)
+{
+    ULogStreamDecoder   decoder;
+    QSignalSpy          spy(&decoder, &ULogStreamDecoder::valueChanged);
+
+    decoder.start(1);
+    _sendDefinitions(decoder);
+
+    Fact* q2Fact =      decoder.subscribe("vehicle_attitude", "q[2]");
+    Fact* q2Fact1 =     decoder.subscribe("vehicle_attitude", "q[2]", 1);
+    Fact* pitchFact =   decoder.subscribe("actuator_out", "group[1].pitch");
+    Fact* armedFact =   decoder.subscribe("actuator_out", "armed");
+    QVERIFY(q2Fact && q2Fact1 && pitchFact && armedFact);
+    QVERIFY(q2Fact != q2Fact1);
+    QCOMPARE(decoder.subscribe("vehicle_attitude", "q[2]"), q2Fact);
+    QCOMPARE(decoder.values()->getFactGroup("vehicle_attitude_1")->getFact("q[2]"), q2Fact1);
+
+    _sendAttitude(decoder, _attitudeMsgId, 1000000, 0.5f);
+    QCOMPARE(spy.count(), 1);
+    QList<QVariant> arguments = spy.takeFirst();
+    QCOMPARE(arguments[0].toInt(), 1);
+    QCOMPARE(arguments[1].toString(), QStringLiteral("ULog:vehicle_attitude.q[2]"));
+    QCOMPARE(arguments[2].toString(), QStringLiteral("float"));
+    QCOMPARE(arguments[3].toDouble(), 0.5);
+    quint64 msecs = arguments[4].toULongLong();
+
+    // Timestamps are relative to the first one
+    _sendAttitude(decoder, _attitude1MsgId, 1250000, -0.25f);
+    QCOMPARE(spy.count(), 1);
+    arguments = spy.takeFirst();
+    QCOMPARE(arguments[1].toString(), QStringLiteral("ULog:vehicle_attitude_1.q[2]"));
+    QCOMPARE(arguments[3].toDouble(), -0.25);
+    QCOMPARE(arguments[4].toULongLong(), msecs + 250);
+
+    // Fields after a nested array and a string
+    _sendActuators(decoder, 1500000, 0.75f, 1);
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(spy[0][1].toString(), QStringLiteral("ULog:actuator_out.group[1].pitch"));
+    QCOMPARE(spy[0][3].toDouble(), 0.75);
+    QCOMPARE(spy[1][1].toString(), QStringLiteral("ULog:actuator_out.armed"));
+    QCOMPARE(spy[1][2].toString(), QStringLiteral("uint8_t"));
+    QCOMPARE(spy[1][3].toDouble(), 1.0);
+    spy.clear();
+
+    // Truncated data messages are ignored
+    _sendMessage(decoder, 'D', QByteArray("\x03\x00\x01\x02", 4));
+    QCOMPARE(spy.count(), 0);
+
+    // Facts are updated at the fact update rate
+    QTest::qWait(ULogStreamDecoder::cFactUpdateRateMSecs * 3);
+    QCOMPARE(q2Fact->rawValue().toDouble(), 0.5);
+    QCOMPARE(q2Fact1->rawValue().toDouble(), -0.25);
+    QCOMPARE(pitchFact->rawValue().toDouble(), 0.75);
+    QCOMPARE(armedFact->rawValue().toDouble(), 1.0);
+}
+
+void ULogStreamDecoderTest::_subscription_test(void)
+{
+    ULogStreamDecoder   decoder;
+    QSignalSpy          spy(&decoder, &ULogStreamDecoder::valueChanged);
+
+    // Subscribed ahead of the log
+    decoder.subscribe("vehicle_attitude", "q[2]");
+    decoder.subscribe("vehicle_attitude", "no_such_field");
+    decoder.start(1);
+    _sendDefinitions(decoder);
+
+    // Nothing subscribed for these
+    _sendActuators(decoder, 1000, 0.5f, 1);
+    _sendAttitude(decoder, _attitude1MsgId, 1000, 0.5f);
+    _sendAttitude(decoder, _unloggedMsgId, 1000, 0.5f);
+    QCOMPARE(spy.count(), 0);
+
+    _sendAttitude(decoder, _attitudeMsgId, 2000, 0.5f);
+    QCOMPARE(spy.count(), 1);
+    spy.clear();
+
+    // Removed topic
+    QByteArray remove;
+    remove.append((char)_attitudeMsgId);
+    remove.append((char)0);
+    _sendMessage(decoder, 'R', remove);
+    _sendAttitude(decoder, _attitudeMsgId, 3000, 0.5f);
+    QCOMPARE(spy.count(), 0);
+
+    // The subscription carries over to the next log, but not the tables
+    decoder.start(1);
+    _sendAttitude(decoder, _attitudeMsgId, 4000, 0.5f);
+    QCOMPARE(spy.count(), 0);
+    _sendDefinitions(decoder);
+    _sendAttitude(decoder, _attitudeMsgId, 5000, 0.5f);
+    QCOMPARE(spy.count(), 1);
+    spy.clear();
+
+    decoder.unsubscribe("vehicle_attitude", "q[2]");
+    _sendAttitude(decoder, _attitudeMsgId, 6000, 0.5f);
+    QCOMPARE(spy.count(), 0);
+}
+
+void ULogStreamDecoderTest::_listedTopic_test(void)
+{
+    ULogStreamDecoder   decoder;
+    QSignalSpy          spy(&decoder, &ULogStreamDecoder::valueChanged);
+    QSignalSpy          subscriptionsSpy(&decoder, &ULogStreamDecoder::subscriptionsChanged);
+
+    decoder.start(1);
+    _sendDefinitions(decoder);
+
+    // Topics as listed carry the instance, which has to map back to the topic and instance
+    QCOMPARE(decoder.fields("vehicle_attitude_1"), decoder.fields("vehicle_attitude"));
+    Fact* fact = decoder.subscribeListed("vehicle_attitude_1", "q[2]");
+    QCOMPARE(decoder.subscribe("vehicle_attitude", "q[2]", 1), fact);
+    QCOMPARE(subscriptionsSpy.count(), 1);
+    QCOMPARE(decoder.subscriptions(), QStringList() << "vehicle_attitude_1.q[2]");
+    QCOMPARE(decoder.subscriptionFact("vehicle_attitude_1.q[2]"), fact);
+    QVERIFY(decoder.subscriptionFact("vehicle_attitude.q[2]") == NULL);
+
+    _sendAttitude(decoder, _attitude1MsgId, 1000, 0.5f);
+    _sendAttitude(decoder, _attitudeMsgId, 1000, 0.5f);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy[0][1].toString(), QStringLiteral("ULog:vehicle_attitude_1.q[2]"));
+    spy.clear();
+
+    decoder.removeSubscription("vehicle_attitude_1.q[2]");
+    QCOMPARE(subscriptionsSpy.count(), 2);
+    QVERIFY(decoder.subscriptions().isEmpty());
+    _sendAttitude(decoder, _attitude1MsgId, 2000, 0.5f);
+    QCOMPARE(spy.count(), 0);
+}
@@ -0,0 +1,40 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef ULogStreamDecoderTest_H
+#define ULogStreamDecoderTest_H
+
+#include "UnitTest.h"
+
+class ULogStreamDecoder;
+
+/// Unit test for ULogStreamDecoder
+class ULogStreamDecoderTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _fields_test(void);
+    void _decode_test(void);
+    void _subscription_test(void);
+    void _listedTopic_test(void);
+
+private:
+    void _sendDefinitions(ULogStreamDecoder& decoder);
+    void _sendMessage(ULogStreamDecoder& decoder, char type, const QByteArray& payload);
+    void _sendAttitude(ULogStreamDecoder& decoder, uint16_t msgId, quint64 timestamp, float q2);
+    void _sendActuators(ULogStreamDecoder& decoder, quint64 timestamp, float pitch1, uint8_t armed);
+
+    static const uint16_t _attitudeMsgId =  3;
+    static const uint16_t _attitude1MsgId = 4;
+    static const uint16_t _actuatorsMsgId = 7;
+    static const uint16_t _unloggedMsgId =  9;
+};
+
+#endif
@@ -23,7 +23,6 @@
 #include "PlanMasterController.h"
 #include "GeoFenceManager.h"
 #include "RallyPointManager.h"
-#include "CoordinateVector.h"
 #include "ParameterManager.h"
 #include "QGCApplication.h"
 #include "QGCImageProvider.h"
@@ -143,6 +142,9 @@ Vehicle::Vehicle(LinkInterface*             link,
     , _base_mode(0)
     , _custom_mode(0)
     , _nextSendMessageMultipleIndex(0)
+    , _flightDistanceHaveFirstCoordinate(false)
+    , _trajectoryPoints(NULL)
+    , _imageCoverage(NULL)
     , _firmwarePluginManager(firmwarePluginManager)
     , _joystickManager(joystickManager)
     , _flowImageIndex(0)
@@ -260,8 +262,8 @@ Vehicle::Vehicle(LinkInterface*             link,
     _sendMultipleTimer.start(_sendMessageMultipleIntraMessageDelay);
     connect(&_sendMultipleTimer, &QTimer::timeout, this, &Vehicle::_sendMessageMultipleNext);
 
-    _mapTrajectoryTimer.setInterval(_mapTrajectoryMsecsBetweenPoints);
-    connect(&_mapTrajectoryTimer, &QTimer::timeout, this, &Vehicle::_addNewMapTrajectoryPoint);
+    _flightTimeUpdater.setInterval(_flightTimeUpdateMSecs);
+    connect(&_flightTimeUpdater, &QTimer::timeout, this, &Vehicle::_updateFlightTime);
 
     // Create camera manager instance
     _cameras = _firmwarePlugin->createCameraManager(this);
@@ -330,6 +332,9 @@ Vehicle::Vehicle(MAV_AUTOPILOT              firmwareType,
     , _base_mode(0)
     , _custom_mode(0)
     , _nextSendMessageMultipleIndex(0)
+    , _flightDistanceHaveFirstCoordinate(false)
+    , _trajectoryPoints(NULL)
+    , _imageCoverage(NULL)
     , _firmwarePluginManager(firmwarePluginManager)
     , _joystickManager(NULL)
     , _flowImageIndex(0)
@@ -382,6 +387,9 @@ void Vehicle::_commonInit(void)
     connect(this, &Vehicle::homePositionChanged,    this, &Vehicle::_updateDistanceToHome);
     connect(this, &Vehicle::hobbsMeterChanged,      this, &Vehicle::_updateHobbsMeter);
 
+    _trajectoryPoints = new TrajectoryPoints(this, this);
+    _imageCoverage = new ImageCoverage(this);
+
     _missionManager = new MissionManager(this);
     connect(_missionManager, &MissionManager::error,                    this, &Vehicle::_missionManagerError);
     connect(_missionManager, &MissionManager::newMissionItemsAvailable, this, &Vehicle::_missionLoadComplete);
@@ -734,6 +742,9 @@ void Vehicle::_handleCameraFeedback(const mavlink_message_t& message)
     QGeoCoordinate imageCoordinate((double)feedback.lat / qPow(10.0, 7.0), (double)feedback.lng / qPow(10.0, 7.0), feedback.alt_msl);
     qCDebug(VehicleLog) << "_handleCameraFeedback coord:index" << imageCoordinate << feedback.img_idx;
     _cameraTriggerPoints.append(new QGCQGeoCoordinate(imageCoordinate, this));
+
+    // ArduPilot sends the vehicle attitude, the camera is taken as fixed looking down
+    _imageCoverage->addCapture(imageCoordinate, feedback.alt_rel, feedback.roll, feedback.pitch, feedback.yaw);
 }
 #endif
 
@@ -747,6 +758,15 @@ void Vehicle::_handleCameraImageCaptured(const mavlink_message_t& message)
     qCDebug(VehicleLog) << "_handleCameraFeedback coord:index" << imageCoordinate << feedback.image_index << feedback.capture_result;
     if (feedback.capture_result == 1) {
         _cameraTriggerPoints.append(new QGCQGeoCoordinate(imageCoordinate, this));
+
+        // Without a gimbal attitude the camera is taken as fixed looking down
+        double roll, pitch, yaw;
+        if (!ImageCoverage::gimbalToCameraAttitude(feedback.q, roll, pitch, yaw)) {
+            roll =  _rollFact.rawValue().toDouble();
+            pitch = _pitchFact.rawValue().toDouble();
+            yaw =   _headingFact.rawValue().toDouble();
+        }
+        _imageCoverage->addCapture(imageCoordinate, feedback.relative_alt / 1000.0, roll, pitch, yaw);
     }
 }
 
@@ -2018,38 +2038,32 @@ void Vehicle::_rallyPointManagerError(int errorCode, const QString& errorMsg)
     qgcApp()->showMessage(tr("Rally Point transfer failed. Retry transfer. Error: %1").arg(errorMsg));
 }
 
-void Vehicle::_addNewMapTrajectoryPoint(void)
+void Vehicle::_updateFlightTime(void)
 {
-    if (_mapTrajectoryHaveFirstCoordinate) {
-        // Keep three minutes of trajectory on mobile due to perf impact of lines
-#ifdef __mobile__
-        if (_mapTrajectoryList.count() * _mapTrajectoryMsecsBetweenPoints > 3 * 1000 * 60) {
-            _mapTrajectoryList.removeAt(0)->deleteLater();
-        }
-#endif
-        _mapTrajectoryList.append(new CoordinateVector(_mapTrajectoryLastCoordinate, _coordinate, this));
-        _flightDistanceFact.setRawValue(_flightDistanceFact.rawValue().toDouble() + _mapTrajectoryLastCoordinate.distanceTo(_coordinate));
+    if (_flightDistanceHaveFirstCoordinate) {
+        _flightDistanceFact.setRawValue(_flightDistanceFact.rawValue().toDouble() + _flightDistanceLastCoordinate.distanceTo(_coordinate));
     }
-    _mapTrajectoryHaveFirstCoordinate = true;
-    _mapTrajectoryLastCoordinate = _coordinate;
+    _flightDistanceHaveFirstCoordinate = true;
+    _flightDistanceLastCoordinate = _coordinate;
     _flightTimeFact.setRawValue((double)_flightTimer.elapsed() / 1000.0);
 }
 
 void Vehicle::_clearTrajectoryPoints(void)
 {
-    _mapTrajectoryList.clearAndDeleteContents();
+    _trajectoryPoints->clear();
 }
 
 void Vehicle::_clearCameraTriggerPoints(void)
 {
     _cameraTriggerPoints.clearAndDeleteContents();
+    _imageCoverage->clear();
 }
 
 void Vehicle::_mapTrajectoryStart(void)
 {
-    _mapTrajectoryHaveFirstCoordinate = false;
-    _clearTrajectoryPoints();
-    _mapTrajectoryTimer.start();
+    _flightDistanceHaveFirstCoordinate = false;
+    _trajectoryPoints->start();
+    _flightTimeUpdater.start();
     _flightTimer.start();
     _flightDistanceFact.setRawValue(0);
     _flightTimeFact.setRawValue(0);
@@ -2057,7 +2071,8 @@ void Vehicle::_mapTrajectoryStart(void)
 
 void Vehicle::_mapTrajectoryStop()
 {
-    _mapTrajectoryTimer.stop();
+    _trajectoryPoints->stop();
+    _flightTimeUpdater.stop();
 }
 
 void Vehicle::_startPlanRequest(void)
@@ -2186,7 +2201,7 @@ void Vehicle::virtualTabletJoystickValue(double roll, double pitch, double yaw,
 {
     // The following if statement prevents the virtualTabletJoystick from sending values if the standard joystick is enabled
     if ( !_joystickEnabled ) {
-        _uas->setExternalControlSetpoint(roll, pitch, yaw, thrust, 0, JoystickModeRC);
+        _uas->setExternalControlSetpoint(roll, pitch, yaw, thrust, 0, JoystickModeRC, 0);
     }
 }
 
@@ -20,6 +20,8 @@
 #include "MAVLinkProtocol.h"
 #include "UASMessageHandler.h"
 #include "SettingsFact.h"
+#include "TrajectoryPoints.h"
+#include "ImageCoverage.h"
 
 class UAS;
 class UASInterface;
@@ -281,8 +283,9 @@ public:
     Q_PROPERTY(QStringList          flightModes             READ flightModes                                            CONSTANT)
     Q_PROPERTY(QString              flightMode              READ flightMode             WRITE setFlightMode             NOTIFY flightModeChanged)
     Q_PROPERTY(bool                 hilMode                 READ hilMode                WRITE setHilMode                NOTIFY hilModeChanged)
-    Q_PROPERTY(QmlObjectListModel*  trajectoryPoints        READ trajectoryPoints                                       CONSTANT)
+    Q_PROPERTY(TrajectoryPoints*    trajectoryPoints        READ trajectoryPoints                                       CONSTANT)
     Q_PROPERTY(QmlObjectListModel*  cameraTriggerPoints     READ cameraTriggerPoints                                    CONSTANT)
+    Q_PROPERTY(ImageCoverage*       imageCoverage           READ imageCoverage                                          CONSTANT)
     Q_PROPERTY(float                latitude                READ latitude                                               NOTIFY coordinateChanged)
     Q_PROPERTY(float                longitude               READ longitude                                              NOTIFY coordinateChanged)
     Q_PROPERTY(bool                 messageTypeNone         READ messageTypeNone                                        NOTIFY messageTypeChanged)
@@ -568,8 +571,9 @@ public:
     QString prearmError(void) const { return _prearmError; }
     void setPrearmError(const QString& prearmError);
 
-    QmlObjectListModel* trajectoryPoints(void) { return &_mapTrajectoryList; }
+    TrajectoryPoints*   trajectoryPoints(void) { return _trajectoryPoints; }
     QmlObjectListModel* cameraTriggerPoints(void) { return &_cameraTriggerPoints; }
+    ImageCoverage*      imageCoverage(void) { return _imageCoverage; }
     QmlObjectListModel* adsbVehicles(void) { return &_adsbVehicles; }
 
     int  flowImageIndex() { return _flowImageIndex; }
@@ -835,7 +839,7 @@ signals:
     void mavlinkScaledImu3(mavlink_message_t message);
 
     // Mavlink Log Download
-    void mavlinkLogData (Vehicle* vehicle, uint8_t target_system, uint8_t target_component, uint16_t sequence, uint8_t first_message, QByteArray data, bool acked);
+    void mavlinkLogData (Vehicle* vehicle, uint8_t target_system, uint8_t target_component, uint16_t sequence, uint8_t first_message, const QByteArray& data, bool acked);
 
     /// Signalled in response to usage of sendMavCommand
     ///     @param vehicleId Vehicle which command was sent to
@@ -856,7 +860,7 @@ private slots:
     void _linkInactiveOrDeleted(LinkInterface* link);
     void _sendMessageOnLink(LinkInterface* link, mavlink_message_t message);
     void _sendMessageMultipleNext(void);
-    void _addNewMapTrajectoryPoint(void);
+    void _updateFlightTime(void);
     void _parametersReady(bool parametersReady);
     void _remoteControlRSSIChanged(uint8_t rssi);
     void _handleFlightModeChanged(const QString& flightMode);
@@ -1060,13 +1064,14 @@ private:
     int     _nextSendMessageMultipleIndex;
 
     QTime               _flightTimer;
-    QTimer              _mapTrajectoryTimer;
-    QmlObjectListModel  _mapTrajectoryList;
-    QGeoCoordinate      _mapTrajectoryLastCoordinate;
-    bool                _mapTrajectoryHaveFirstCoordinate;
-    static const int    _mapTrajectoryMsecsBetweenPoints = 1000;
+    QTimer              _flightTimeUpdater;
+    QGeoCoordinate      _flightDistanceLastCoordinate;
+    bool                _flightDistanceHaveFirstCoordinate;
+    static const int    _flightTimeUpdateMSecs = 1000;
+    TrajectoryPoints*   _trajectoryPoints;
 
     QmlObjectListModel  _cameraTriggerPoints;
+    ImageCoverage*      _imageCoverage;
 
     QmlObjectListModel              _adsbVehicles;
     QMap<uint32_t, ADSBVehicle*>    _adsbICAOMap;
@@ -15,15 +15,22 @@
 #include "Bootloader.h"
 #include "QGCLoggingCategory.h"
 
-#include <QFile>
+#include <QBuffer>
 #include <QSerialPortInfo>
 #include <QDebug>
 #include <QTime>
+#include <QElapsedTimer>
 
 #include "QGC.h"
 
 Bootloader::Bootloader(QObject *parent) :
-    QObject(parent)
+    QObject(parent),
+    _boardID(0),
+    _boardFlashSize(0),
+    _imageCRC(0),
+    _bootloaderVersion(0),
+    _programWindow(1),
+    _programBytesPerSecond(0)
 {
 
 }
@@ -173,16 +180,113 @@ bool Bootloader::erase(QSerialPort* port)
 
 bool Bootloader::program(QSerialPort* port, const FirmwareImage* image)
 {
+    QElapsedTimer   timer;
+    bool            success;
+    
+    timer.start();
+    _programBytesPerSecond = 0;
+    
     if (image->imageIsBinFormat()) {
-        return _binProgram(port, image);
+        if (_programWindow > 1) {
+            success = _binProgramPipelined(port, image);
+            if (!success) {
+                // Start over one block per round trip, which works with any bootloader
+                qCDebug(FirmwareUpgradeLog) << "Pipelined program failed, retrying one block at a time:" << _errorString;
+                
+                // Throw away any responses still in flight
+                while (port->waitForReadyRead(200)) {
+                    port->readAll();
+                }
+                port->clear();
+                
+                success = sync(port) && erase(port) && _binProgram(port, image);
+            }
+        } else {
+            success = _binProgram(port, image);
+        }
     } else {
-        return _ihxProgram(port, image);
+        success = _ihxProgram(port, image);
+    }
+    
+    if (success) {
+        _programBytesPerSecond = image->imageSize() / (qMax(timer.elapsed(), (qint64)1) / 1000.0);
+        qCDebug(FirmwareUpgradeLog) << "Program complete - bytes:" << image->imageSize() << "msecs:" << timer.elapsed() << "bytes/sec:" << _programBytesPerSecond << "window:" << _programWindow;
+    }
+    
+    return success;
+}
+
+/// We calculate the CRC using the entire flash size, filling the remainder with 0xFF.
+void Bootloader::_imageCRCFill(uint32_t bytesSent)
+{
+    uint8_t fill[256];
+    memset(fill, 0xFF, sizeof(fill));
+    
+    while (bytesSent < _boardFlashSize) {
+        uint32_t bytesToFill = qMin(_boardFlashSize - bytesSent, (uint32_t)sizeof(fill));
+        _imageCRC = QGC::crc32(fill, bytesToFill, _imageCRC);
+        bytesSent += bytesToFill;
+    }
+}
+
+/// Programs a bin image keeping up to _programWindow PROTO_PROG_MULTI blocks in flight. The bootloader answers
+/// each block in order, so responses are matched to blocks by position. The first failed response aborts.
+bool Bootloader::_binProgramPipelined(QSerialPort* port, const FirmwareImage* image)
+{
+    QByteArray  imageBytes = image->binBytes();
+    uint32_t    imageSize = (uint32_t)imageBytes.size();
+    
+    Q_ASSERT((imageSize % 4) == 0);
+    
+    const uint8_t*  imageData = (const uint8_t*)imageBytes.constData();
+    uint32_t        bytesSent = 0;
+    uint32_t        bytesAcked = 0;
+    QList<int>      blocksInFlight;         ///< Sizes of the blocks sent but not answered yet
+    uint8_t         blockBuf[PROG_MULTI_MAX + 3];
+    
+    Q_ASSERT(PROG_MULTI_MAX <= 0x8F);
+    
+    _imageCRC = QGC::crc32(imageData, imageSize, 0);
+    
+    while (bytesAcked < imageSize) {
+        // Fill the window. Each block goes out as one write.
+        while (bytesSent < imageSize && blocksInFlight.count() < _programWindow) {
+            int bytesToSend = qMin(imageSize - bytesSent, (uint32_t)PROG_MULTI_MAX);
+            
+            blockBuf[0] = PROTO_PROG_MULTI;
+            blockBuf[1] = (uint8_t)bytesToSend;
+            memcpy(&blockBuf[2], &imageData[bytesSent], bytesToSend);
+            blockBuf[bytesToSend + 2] = PROTO_EOC;
+            
+            if (!_write(port, blockBuf, bytesToSend + 3)) {
+                _errorString = tr("Flash failed: %1 at address 0x%2").arg(_errorString).arg(bytesSent, 8, 16, QLatin1Char('0'));
+                return false;
+            }
+            
+            blocksInFlight.append(bytesToSend);
+            bytesSent += bytesToSend;
+        }
+        port->flush();
+        
+        // Responses come back in order, one per block
+        if (!_getCommandResponse(port)) {
+            _errorString = tr("Flash failed: %1 at address 0x%2").arg(_errorString).arg(bytesAcked, 8, 16, QLatin1Char('0'));
+            return false;
+        }
+        bytesAcked += blocksInFlight.takeFirst();
+        
+        emit updateProgress(bytesAcked, imageSize);
     }
+    
+    _imageCRCFill(imageSize);
+    
+    return true;
 }
 
 bool Bootloader::_binProgram(QSerialPort* port, const FirmwareImage* image)
 {
-    QFile firmwareFile(image->binFilename());
+    QBuffer firmwareFile;
+    firmwareFile.setData(image->binBytes());
     if (!firmwareFile.open(QIODevice::ReadOnly)) {
         _errorString = tr("Unable to open firmware file %1: %2").arg(image->binFilename()).arg(firmwareFile.errorString());
         return false;
@@ -238,12 +342,7 @@ bool Bootloader::_binProgram(QSerialPort* port, const FirmwareImage* image)
     }
     firmwareFile.close();
     
-    // We calculate the CRC using the entire flash size, filling the remainder with 0xFF.
-    while (bytesSent < _boardFlashSize) {
-        const uint8_t fill = 0xFF;
-        _imageCRC = QGC::crc32(&fill, 1, _imageCRC);
-        bytesSent++;
-    }
+    _imageCRCFill(bytesSent);
     
     return true;
 }
@@ -338,6 +437,19 @@ bool Bootloader::verify(QSerialPort* port, const FirmwareImage* image)
     return ret;
 }
 
+bool Bootloader::flashMatchesImage(QSerialPort* port, const FirmwareImage* image)
+{
+    if (!canCompareFlash(image)) {
+        return false;
+    }
+    
+    const QByteArray& imageBytes = image->binBytes();
+    _imageCRC = QGC::crc32((const uint8_t*)imageBytes.constData(), imageBytes.size(), 0);
+    _imageCRCFill(imageBytes.size());
+    
+    return _verifyCRC(port);
+}
+
 /// @brief Verify the flash on bootloader reading it back and comparing it against the original image
 bool Bootloader::_verifyBytes(QSerialPort* port, const FirmwareImage* image)
 {
@@ -352,7 +464,8 @@ bool Bootloader::_binVerifyBytes(QSerialPort* port, const FirmwareImage* image)
 {
     Q_ASSERT(image->imageIsBinFormat());
     
-    QFile firmwareFile(image->binFilename());
+    QBuffer firmwareFile;
+    firmwareFile.setData(image->binBytes());
     if (!firmwareFile.open(QIODevice::ReadOnly)) {
         _errorString = tr("Unable to open firmware file %1: %2").arg(image->binFilename()).arg(firmwareFile.errorString());
         return false;
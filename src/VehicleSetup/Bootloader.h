@@ -42,12 +42,20 @@ public:
     /// @brief Erases the current program
     bool erase(QSerialPort* port);
     
-    /// @brief Program the board with the specified image
+    /// @brief Program the board with the specified image. If programming with several blocks in flight fails, the
+    /// board is re-synced, erased and programmed again one block at a time.
     bool program(QSerialPort* port, const FirmwareImage* image);
     
     /// @brief Verify the board flash.
     bool verify(QSerialPort* port, const FirmwareImage* image);
     
+    /// @brief Checks whether the board already holds the image by comparing CRCs, without changing the flash.
+    /// Only possible for bin images with bootloader rev 3 and above, false otherwise.
+    bool flashMatchesImage(QSerialPort* port, const FirmwareImage* image);
+
+    /// @return true: flashMatchesImage is able to compare the flash of the connected board against the image
+    bool canCompareFlash(const FirmwareImage* image) const { return image->imageIsBinFormat() && _bootloaderVersion > 2; }
+    
     /// @brief Retrieve a set of board info from the bootloader of PX4 FMU and PX4 Flow boards
     ///     @param bootloaderVersion Returned INFO_BL_REV
     ///     @param boardID Returned INFO_BOARD_ID
@@ -60,6 +68,19 @@ public:
     /// @brief Sends a PROTO_REBOOT command to the bootloader
     bool reboot(QSerialPort* port);
     
+    /// @brief Sets the number of PROTO_PROG_MULTI blocks which are sent before waiting for the first response when
+    /// programming a bin image. 1 programs one block per round trip, which is the original behavior and is
+    /// what ihx (3DR Radio) images always use.
+    void setProgramWindow(int window) { _programWindow = qMax(1, window); }
+    int programWindow(void) const { return _programWindow; }
+    
+    /// @brief Throughput of the last successful program() call in bytes per second
+    double programBytesPerSecond(void) const { return _programBytesPerSecond; }
+    
+    /// @brief Default program window for PX4 boards. The bootloader handles commands strictly in order, so
+    /// queued blocks only have to fit in its receive buffer.
+    static const int programWindowDefault = 4;
+    
     // Supported bootloader board ids
     static const int boardIDPX4FMUV1 = 5;       ///< PX4 V1 board, as from USB PID
     static const int boardIDPX4FMUV2 = 9;       ///< PX4 V2 board, as from USB PID
@@ -85,6 +106,8 @@ signals:
     
 private:
     bool _binProgram(QSerialPort* port, const FirmwareImage* image);
+    bool _binProgramPipelined(QSerialPort* port, const FirmwareImage* image);
+    void _imageCRCFill(uint32_t bytesSent);
     bool _ihxProgram(QSerialPort* port, const FirmwareImage* image);
     
     bool _write(QSerialPort* port, const uint8_t* data, qint64 maxSize);
@@ -141,6 +164,8 @@ private:
     uint32_t    _boardFlashSize;    ///< flash size for currently connected board
     uint32_t    _imageCRC;          ///< CRC for image in currently selected firmware file
     uint32_t    _bootloaderVersion; ///< Bootloader version
+    int         _programWindow;     ///< Number of PROTO_PROG_MULTI blocks in flight
+    double      _programBytesPerSecond;
     
     QString _firmwareFilename;      ///< Currently selected firmware file to flash
     
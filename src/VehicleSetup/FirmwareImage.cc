@@ -49,6 +49,7 @@ FirmwareImage::FirmwareImage(QObject* parent) :
 bool FirmwareImage::load(const QString& imageFilename, uint32_t boardId)
 {
     _imageSize = 0;
+    _binBytes.clear();
     _boardId = boardId;
     
     if (imageFilename.endsWith(".bin")) {
@@ -359,6 +360,7 @@ bool FirmwareImage::_px4Load(const QString& imageFilename)
     decompressFile.close();
     
     _binFilename = decompressFilename;
+    _binBytes = decompressedBytes;
     
     return true;
 }
@@ -450,7 +452,8 @@ bool FirmwareImage::_binLoad(const QString& imageFilename)
         return false;
     }
     
-    _imageSize = (uint32_t)binFile.size();
+    _binBytes = binFile.readAll();
+    _imageSize = (uint32_t)_binBytes.size();
     
     binFile.close();
     
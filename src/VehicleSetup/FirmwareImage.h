@@ -46,6 +46,10 @@ public:
     /// @return Filename for .bin file
     QString binFilename(void) const { return _binFilename; }
     
+    /// @return Decoded .bin image. It is loaded once and can be read from any number of flashing sessions and
+    /// threads at the same time, as long as the image is not loaded again.
+    const QByteArray& binBytes(void) const { return _binBytes; }
+    
     /// @return Block count from .ihx image
     uint16_t ihxBlockCount(void) const;
     
@@ -86,6 +90,7 @@ private:
     bool                    _binFormat;
     uint32_t                _boardId;
     QString                 _binFilename;
+    QByteArray              _binBytes;
     QList<IntelHexBlock_t>  _ihxBlocks;
     uint32_t                _imageSize;
 
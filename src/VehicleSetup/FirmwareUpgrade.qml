@@ -398,6 +398,56 @@ SetupPage {
                 }
             }
 
+            // Batch flashing of many boards at once
+            RowLayout {
+                Layout.preferredWidth:  parent.width
+                spacing:                ScreenTools.defaultFontPixelWidth
+                visible:                !_singleFirmwareMode
+
+                QGCButton {
+                    text:       controller.batchFlasher.active ? qsTr("Stop Batch Flash") : (controller.batchFlasher.busy ? qsTr("Stopping...") : qsTr("Batch Flash..."))
+                    enabled:    controller.batchFlasher.active || !controller.batchFlasher.busy
+                    onClicked:  controller.batchFlasher.active ? controller.stopBatchFlash() : controller.startBatchFlash()
+                }
+
+                QGCLabel {
+                    Layout.fillWidth:   true
+                    text:               controller.batchFlasher.summary
+                    visible:            controller.batchFlasher.active || controller.batchFlasher.boards.count > 0
+                }
+            }
+
+            Column {
+                Layout.preferredWidth:  parent.width
+                visible:                controller.batchFlasher.boards.count > 0
+
+                Repeater {
+                    model: controller.batchFlasher.boards
+
+                    RowLayout {
+                        width:      parent.width
+                        spacing:    ScreenTools.defaultFontPixelWidth
+
+                        QGCLabel {
+                            Layout.preferredWidth:  ScreenTools.defaultFontPixelWidth * 20
+                            text:                   object.portName
+                        }
+                        ProgressBar {
+                            Layout.preferredWidth:  ScreenTools.defaultFontPixelWidth * 20
+                            value:                  object.progress
+                        }
+                        QGCLabel {
+                            Layout.fillWidth:   true
+                            elide:              Text.ElideRight
+                            color:              object.state === PX4FirmwareBatchFlashBoard.StateFailed ? qgcPal.warningText : qgcPal.text
+                            text:               object.bytesPerSecond > 0 ?
+                                                    qsTr("%1 (%2 KB/s)").arg(object.status).arg((object.bytesPerSecond / 1024).toFixed(1)) :
+                                                    object.status
+                        }
+                    }
+                }
+            }
+
             ProgressBar {
                 id:                 progressBar
                 Layout.preferredWidth:              parent.width
@@ -69,6 +69,9 @@ FirmwareUpgradeController::FirmwareUpgradeController(void)
     
     connect(&_eraseTimer, &QTimer::timeout, this, &FirmwareUpgradeController::_eraseProgressTick);
 
+    _batchFlasher = new PX4FirmwareBatchFlasher(this);
+    connect(_batchFlasher, &PX4FirmwareBatchFlasher::busyChanged, this, &FirmwareUpgradeController::_batchFlashBusyChanged);
+
     _initFirmwareHash();
     _determinePX4StableVersion();
 }
@@ -119,6 +122,51 @@ void FirmwareUpgradeController::flashSingleFirmwareMode(void)
     flash(SingleFirmwareMode, StableFirmware, DefaultVehicleFirmware);
 }
 
+void FirmwareUpgradeController::startBatchFlash(void)
+{
+    if (_batchFlasher->busy()) {
+        return;
+    }
+
+    QString firmwareFilename = QGCQFileDialog::getOpenFileName(NULL,                                                                // Parent to main window
+                                                               tr("Select Firmware File"),                                          // Dialog Caption
+                                                               QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation), // Initial directory
+                                                               tr("Firmware Files (*.px4 *.bin)"));                                 // File filter
+    if (firmwareFilename.isEmpty()) {
+        return;
+    }
+    
+    // Single board search would fight with the batch over the ports
+    cancel();
+    _threadController->stopFindBoardLoop();
+    
+    LinkManager* linkMgr = qgcApp()->toolbox()->linkManager();
+    linkMgr->setConnectionsSuspended(tr("Connect not allowed during Firmware Upgrade."));
+    if (!qgcApp()->toolbox()->multiVehicleManager()->activeVehicle()) {
+        linkMgr->disconnectAll();
+    }
+    
+    _appendStatusLog(tr("Batch flashing %1 to all boards plugged in").arg(firmwareFilename));
+    _batchFlasher->start(firmwareFilename);
+}
+
+void FirmwareUpgradeController::stopBatchFlash(void)
+{
+    _batchFlasher->stop();
+    if (_batchFlasher->busy()) {
+        _appendStatusLog(tr("Batch flash stopping, waiting for boards being flashed"));
+    }
+}
+
+void FirmwareUpgradeController::_batchFlashBusyChanged(bool busy)
+{
+    // Boards are only searched for again once no batch worker uses the ports anymore
+    if (!busy) {
+        _appendStatusLog(tr("Batch flash stopped: %1").arg(_batchFlasher->summary()));
+        _threadController->startFindBoardLoop();
+    }
+}
+
 void FirmwareUpgradeController::cancel(void)
 {
     _eraseTimer.stop();
@@ -15,6 +15,7 @@
 #define FirmwareUpgradeController_H
 
 #include "PX4FirmwareUpgradeThread.h"
+#include "PX4FirmwareBatchFlasher.h"
 #include "LinkManager.h"
 #include "FirmwareImage.h"
 
@@ -104,6 +105,7 @@ public:
     Q_PROPERTY(QStringList      apmAvailableVersions        READ apmAvailableVersions                                   NOTIFY apmAvailableVersionsChanged)
     Q_PROPERTY(QString          px4StableVersion            READ px4StableVersion                                       NOTIFY px4StableVersionChanged)
     Q_PROPERTY(QString          px4BetaVersion              READ px4BetaVersion                                         NOTIFY px4BetaVersionChanged)
+    Q_PROPERTY(PX4FirmwareBatchFlasher* batchFlasher        READ batchFlasher                                           CONSTANT)
 
     /// TextArea for log output
     Q_PROPERTY(QQuickItem* statusLog READ statusLog WRITE setStatusLog)
@@ -127,6 +129,13 @@ public:
 
     Q_INVOKABLE FirmwareVehicleType_t vehicleTypeFromVersionIndex(int index);
     
+    /// Asks for a firmware file and flashes it to every PX4 board which is connected or gets connected, in parallel
+    Q_INVOKABLE void startBatchFlash(void);
+    
+    /// Stops picking up new boards for the batch, boards which are being flashed are finished. The single board
+    /// search starts again once the last of them is done.
+    Q_INVOKABLE void stopBatchFlash(void);
+    
     // overload, not exposed to qml side
     void flash(const FirmwareIdentifier& firmwareId);
 
@@ -149,6 +158,8 @@ public:
     QString px4StableVersion(void) { return _px4StableVersion; }
     QString px4BetaVersion(void) { return _px4BetaVersion; }
 
+    PX4FirmwareBatchFlasher* batchFlasher(void) { return _batchFlasher; }
+
     bool pixhawkBoard(void) const { return _foundBoardType == QGCSerialPortInfo::BoardTypePixhawk; }
     bool px4FlowBoard(void) const { return _foundBoardType == QGCSerialPortInfo::BoardTypePX4Flow; }
 
@@ -183,6 +194,7 @@ private slots:
     void _apmVersionDownloadFinished(QString remoteFile, QString localFile);
     void _px4ReleasesGithubDownloadFinished(QString remoteFile, QString localFile);
     void _px4ReleasesGithubDownloadError(QString errorMsg);
+    void _batchFlashBusyChanged(bool busy);
 
 private:
     void _getFirmwareFile(FirmwareIdentifier firmwareId);
@@ -236,6 +248,8 @@ private:
     /// @brief Thread controller which is used to run bootloader commands on separate thread
     PX4FirmwareUpgradeThreadController* _threadController;
     
+    PX4FirmwareBatchFlasher* _batchFlasher;
+    
     static const int    _eraseTickMsec = 500;       ///< Progress bar update tick time for erase
     static const int    _eraseTotalMsec = 15000;    ///< Estimated amount of time erase takes
     int                 _eraseTickCount;            ///< Number of ticks for erase progress update
@@ -497,6 +497,40 @@ SetupPage {
                                 }
                             }
 
+                            Column {
+                                spacing: ScreenTools.defaultFontPixelHeight / 3
+
+                                QGCLabel {
+                                    text:               qsTr("Output rate:")
+                                }
+
+                                Row {
+                                    QGCSlider {
+                                        id:             outputRateSlider
+                                        minimumValue:   5
+                                        maximumValue:   _activeJoystick ? _activeJoystick.maxOutputRate : 100
+                                        stepSize:       5
+
+                                        Component.onCompleted: value=_activeJoystick.outputRate
+                                        onValueChanged: _activeJoystick.outputRate=value
+                                    }
+
+                                    QGCLabel {
+                                        text:   qsTr("%1 Hz").arg(outputRateSlider.value)
+                                    }
+                                }
+
+                                QGCLabel {
+                                    text:       qsTr("Sent: %1 Hz  Latency: %2 ms (max %3)  Jitter: %4 ms (max %5)")
+                                                    .arg(_activeJoystick.sendRate.toFixed(1))
+                                                    .arg(_activeJoystick.inputLatencyMsecs.toFixed(1))
+                                                    .arg(_activeJoystick.maxInputLatencyMsecs.toFixed(1))
+                                                    .arg(_activeJoystick.sendJitterMsecs.toFixed(2))
+                                                    .arg(_activeJoystick.maxSendJitterMsecs.toFixed(2))
+                                    visible:    _activeJoystick ? _activeJoystick.sendRate > 0 : false
+                                }
+                            }
+
                             QGCCheckBox {
                                 id:         advancedSettings
                                 checked:    _activeVehicle.joystickMode != 0
@@ -0,0 +1,530 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+
+/// @file
+///     @brief Flashes many PX4 boards at the same time, for example a bench of boards on a USB hub.
+
+#include "PX4FirmwareBatchFlasher.h"
+#include "QGCLoggingCategory.h"
+#include "QGCSerialPortInfo.h"
+#include "SerialPortWatcher.h"
+#include "QGC.h"
+
+PX4FirmwareBatchFlashBoard::PX4FirmwareBatchFlashBoard(const QString& portName, QObject* parent)
+    : QObject(parent)
+    , _portName(portName)
+    , _boardId(0)
+    , _state(StateConnecting)
+    , _progress(0)
+    , _bytesPerSecond(0)
+{
+
+}
+
+void PX4FirmwareBatchFlashBoard::setBoardId(int boardId)
+{
+    if (boardId != _boardId) {
+        _boardId = boardId;
+        emit boardIdChanged(boardId);
+    }
+}
+
+void PX4FirmwareBatchFlashBoard::setState(State_t state)
+{
+    if (state != _state) {
+        _state = state;
+        emit stateChanged(state);
+    }
+}
+
+void PX4FirmwareBatchFlashBoard::setStatus(const QString& status)
+{
+    if (status != _status) {
+        _status = status;
+        emit statusChanged(status);
+    }
+}
+
+void PX4FirmwareBatchFlashBoard::setProgress(double progress)
+{
+    if (!qFuzzyCompare(progress, _progress)) {
+        _progress = progress;
+        emit progressChanged(progress);
+    }
+}
+
+void PX4FirmwareBatchFlashBoard::setBytesPerSecond(double bytesPerSecond)
+{
+    if (!qFuzzyCompare(bytesPerSecond, _bytesPerSecond)) {
+        _bytesPerSecond = bytesPerSecond;
+        emit bytesPerSecondChanged(bytesPerSecond);
+    }
+}
+
+PX4FirmwareBatchFlashWorker::PX4FirmwareBatchFlashWorker(const QString& systemLocation)
+    : _systemLocation(systemLocation)
+    , _bootloader(NULL)
+    , _port(NULL)
+    , _recheck(false)
+    , _cancelled(0)
+{
+
+}
+
+PX4FirmwareBatchFlashWorker::~PX4FirmwareBatchFlashWorker()
+{
+    if (_port && _port->isOpen()) {
+        _port->close();
+    }
+}
+
+void PX4FirmwareBatchFlashWorker::findBootloader(void)
+{
+    qCDebug(FirmwareUpgradeLog) << "Batch: looking for bootloader" << _systemLocation;
+
+    // Created here so they belong to the worker thread
+    _bootloader = new Bootloader(this);
+    _port = new QSerialPort(this);
+    connect(_bootloader, &Bootloader::updateProgress, this, &PX4FirmwareBatchFlashWorker::updateProgress);
+
+    // The bootloader only waits a few seconds after power up, keep trying for about that long
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < _findBootloaderTimeoutMsecs) {
+        if (_finishIfCancelled()) {
+            return;
+        }
+        if (_bootloader->open(_port, _systemLocation)) {
+            uint32_t bootloaderVersion, boardID, flashSize;
+
+            if (_bootloader->sync(_port) && _bootloader->getPX4BoardInfo(_port, bootloaderVersion, boardID, flashSize)) {
+                qCDebug(FirmwareUpgradeLog) << "Batch: found bootloader" << _systemLocation << bootloaderVersion << boardID << flashSize;
+                emit foundBootloader(boardID, flashSize);
+                return;
+            }
+            _port->close();
+        }
+        QGC::SLEEP::msleep(100);
+    }
+
+    emit finished(false, tr("Bootloader not found: %1").arg(_bootloader->errorString()), 0);
+}
+
+void PX4FirmwareBatchFlashWorker::flash(void)
+{
+    if (_finishIfCancelled()) {
+        return;
+    }
+    if (!_image) {
+        abort(tr("No firmware image"));
+        return;
+    }
+
+    // Boards come back in the bootloader after the reboot at the end of a flash, there is no need to flash them again.
+    // Older bootloaders can't report the flash CRC. Reflashing those would reboot them into the next recheck, so the
+    // verified flash from before stands.
+    if (_recheck && !_bootloader->canCompareFlash(_image.data())) {
+        _bootloader->reboot(_port);
+        emit finished(true, QString(), 0);
+        return;
+    }
+    if (_bootloader->flashMatchesImage(_port, _image.data())) {
+        emit status(tr("Firmware already current"));
+        _bootloader->reboot(_port);
+        emit finished(true, QString(), 0);
+        return;
+    }
+
+    if (_finishIfCancelled()) {
+        return;
+    }
+    emit status(tr("Erasing..."));
+    if (!_bootloader->erase(_port)) {
+        abort(_bootloader->errorString());
+        return;
+    }
+
+    if (_finishIfCancelled()) {
+        return;
+    }
+    emit status(tr("Programming..."));
+    _bootloader->setProgramWindow(Bootloader::programWindowDefault);
+    if (!_bootloader->program(_port, _image.data())) {
+        abort(_bootloader->errorString());
+        return;
+    }
+
+    emit status(tr("Verifying..."));
+    // verify reboots the board regardless of the result
+    if (!_bootloader->verify(_port, _image.data())) {
+        emit finished(false, _bootloader->errorString(), 0);
+        return;
+    }
+
+    emit finished(true, QString(), _bootloader->programBytesPerSecond());
+}
+
+void PX4FirmwareBatchFlashWorker::abort(const QString& errorString)
+{
+    if (_port && _port->isOpen()) {
+        _bootloader->reboot(_port);
+    }
+    emit finished(false, errorString, 0);
+}
+
+/// Checked between steps, a running bootloader command is not interrupted
+///     @return true: Worker was cancelled and has finished
+bool PX4FirmwareBatchFlashWorker::_finishIfCancelled(void)
+{
+    if (_cancelled.load()) {
+        abort(tr("Cancelled"));
+        return true;
+    }
+    return false;
+}
+
+PX4FirmwareBatchFlasher::PX4FirmwareBatchFlasher(QObject* parent, SerialPortWatcher::Backend_t watcherBackend)
+    : QObject(parent)
+    , _active(false)
+    , _busy(false)
+    , _watcherBackend(watcherBackend)
+    , _portWatcher(NULL)
+    , _completeCount(0)
+    , _failedCount(0)
+    , _bytesFlashed(0)
+{
+
+}
+
+PX4FirmwareBatchFlasher::~PX4FirmwareBatchFlasher()
+{
+    // Running workers are not waited for, that would block the ui until their flash completes. They are cancelled
+    // and clean up after themselves. Each worker holds its own reference to the image it uses.
+    emit cancelSessions();
+    foreach (const Session_t& session, _sessions) {
+        disconnect(session.worker, NULL, this, NULL);
+        connect(session.thread, &QThread::finished, session.thread, &QObject::deleteLater);
+        session.thread->quit();
+    }
+
+    _boards.clearAndDeleteContents();
+}
+
+bool PX4FirmwareBatchFlasher::start(const QString& firmwareFilename)
+{
+    if (_active) {
+        return true;
+    }
+    if (_busy) {
+        qCDebug(FirmwareUpgradeLog) << "Batch: start refused, previous batch still finishing";
+        return false;
+    }
+
+    qCDebug(FirmwareUpgradeLog) << "Batch: start" << firmwareFilename;
+
+    if (firmwareFilename != _firmwareFilename) {
+        _images.clear();
+        _firmwareFilename = firmwareFilename;
+    }
+
+    // Boards from a previous batch which are done are dropped from the list
+    for (int i=_boards.count()-1; i>=0; i--) {
+        PX4FirmwareBatchFlashBoard* board = _boards.value<PX4FirmwareBatchFlashBoard*>(i);
+        if (board->state() == PX4FirmwareBatchFlashBoard::StateComplete ||
+                board->state() == PX4FirmwareBatchFlashBoard::StateFailed ||
+                board->state() == PX4FirmwareBatchFlashBoard::StateCancelled) {
+            _boards.removeAt(i)->deleteLater();
+        }
+    }
+    _completeCount = 0;
+    _failedCount = 0;
+    _bytesFlashed = 0;
+    _elapsed.invalidate();
+
+    _active = true;
+    emit activeChanged(true);
+    _updateBusy();
+    emit summaryChanged();
+
+    // The watcher reports the ports which are already present on start as well
+    _portWatcher = new SerialPortWatcher(_watcherBackend, this);
+    connect(_portWatcher, &SerialPortWatcher::portAdded, this, &PX4FirmwareBatchFlasher::_portAdded);
+    _portWatcher->start();
+
+    return true;
+}
+
+void PX4FirmwareBatchFlasher::stop(void)
+{
+    if (!_active) {
+        return;
+    }
+
+    qCDebug(FirmwareUpgradeLog) << "Batch: stop";
+
+    _portWatcher->deleteLater();
+    _portWatcher = NULL;
+
+    // Sessions which haven't started flashing would only pick up more boards
+    for (int i=0; i<_sessions.count(); i++) {
+        Session_t& session = _sessions[i];
+        if (session.board->state() != PX4FirmwareBatchFlashBoard::StateFlashing) {
+            session.cancelled = true;
+            session.worker->cancel();
+        }
+    }
+
+    _active = false;
+    emit activeChanged(false);
+    _updateBusy();
+}
+
+void PX4FirmwareBatchFlasher::_updateBusy(void)
+{
+    bool busy = _active || !_sessions.isEmpty();
+    if (busy != _busy) {
+        _busy = busy;
+        emit busyChanged(busy);
+    }
+}
+
+/// Counts the boards by state, so a port which comes back for a recheck isn't counted twice
+void PX4FirmwareBatchFlasher::_updateCounts(void)
+{
+    _completeCount = 0;
+    _failedCount = 0;
+    for (int i=0; i<_boards.count(); i++) {
+        PX4FirmwareBatchFlashBoard* board = _boards.value<PX4FirmwareBatchFlashBoard*>(i);
+        if (board->state() == PX4FirmwareBatchFlashBoard::StateComplete) {
+            _completeCount++;
+        } else if (board->state() == PX4FirmwareBatchFlashBoard::StateFailed) {
+            _failedCount++;
+        }
+    }
+}
+
+bool PX4FirmwareBatchFlasher::_portIsFlashable(const QString& systemLocation)
+{
+    foreach (QGCSerialPortInfo portInfo, QGCSerialPortInfo::availablePorts()) {
+        if (portInfo.systemLocation() == systemLocation) {
+            QGCSerialPortInfo::BoardType_t  boardType;
+            QString                         boardName;
+
+            // Radios need to be forced into their bootloader, which is only supported one at a time
+            return portInfo.canFlash() && portInfo.getBoardInfo(boardType, boardName) && boardType != QGCSerialPortInfo::BoardTypeSiKRadio;
+        }
+    }
+    return false;
+}
+
+void PX4FirmwareBatchFlasher::_portAdded(const QString& systemLocation)
+{
+    if (!_active || !_portIsFlashable(systemLocation)) {
+        return;
+    }
+
+    PX4FirmwareBatchFlashBoard* board = NULL;
+    for (int i=0; i<_boards.count(); i++) {
+        PX4FirmwareBatchFlashBoard* existingBoard = _boards.value<PX4FirmwareBatchFlashBoard*>(i);
+        if (existingBoard->portName() == systemLocation) {
+            board = existingBoard;
+            break;
+        }
+    }
+    foreach (const Session_t& session, _sessions) {
+        if (session.board == board) {
+            // Still working on this port
+            return;
+        }
+    }
+
+    Session_t session;
+
+    // A port which already completed usually comes back because the board rebooted. That only needs a recheck.
+    session.recheck = board && board->state() == PX4FirmwareBatchFlashBoard::StateComplete;
+    session.cancelled = false;
+    if (!board) {
+        board = new PX4FirmwareBatchFlashBoard(systemLocation, this);
+        _boards.append(board);
+    }
+    if (!session.recheck) {
+        board->setState(PX4FirmwareBatchFlashBoard::StateConnecting);
+        board->setStatus(tr("Connecting..."));
+        board->setProgress(0);
+        board->setBytesPerSecond(0);
+    }
+
+    session.board = board;
+    session.worker = new PX4FirmwareBatchFlashWorker(systemLocation);
+    session.thread = new QThread();     // No parent, the thread may outlive the flasher
+    session.worker->moveToThread(session.thread);
+
+    connect(session.thread, &QThread::started,                          session.worker, &PX4FirmwareBatchFlashWorker::findBootloader);
+    connect(session.thread, &QThread::finished,                         session.worker, &QObject::deleteLater);
+    connect(session.worker, &PX4FirmwareBatchFlashWorker::foundBootloader,  this, &PX4FirmwareBatchFlasher::_foundBootloader);
+    connect(session.worker, &PX4FirmwareBatchFlashWorker::status,           this, &PX4FirmwareBatchFlasher::_status);
+    connect(session.worker, &PX4FirmwareBatchFlashWorker::updateProgress,   this, &PX4FirmwareBatchFlasher::_updateProgress);
+    connect(session.worker, &PX4FirmwareBatchFlashWorker::finished,         this, &PX4FirmwareBatchFlasher::_finished);
+    connect(this,           &PX4FirmwareBatchFlasher::cancelSessions,       session.worker, &PX4FirmwareBatchFlashWorker::cancel, Qt::DirectConnection);
+
+    _sessions.append(session);
+    session.thread->start();
+    emit summaryChanged();
+}
+
+PX4FirmwareBatchFlasher::Session_t* PX4FirmwareBatchFlasher::_session(QObject* worker)
+{
+    for (int i=0; i<_sessions.count(); i++) {
+        if (_sessions[i].worker == worker) {
+            return &_sessions[i];
+        }
+    }
+    return NULL;
+}
+
+/// Returns the decoded image for the specified board id, decoding it on first use
+QSharedPointer<const FirmwareImage> PX4FirmwareBatchFlasher::_image(uint32_t boardId, QString& errorString)
+{
+    if (_images.contains(boardId)) {
+        return _images[boardId];
+    }
+
+    FirmwareImage*          image = new FirmwareImage();
+    QMetaObject::Connection statusConnection = connect(image, &FirmwareImage::statusMessage, [&errorString](const QString& message) { errorString = message; });
+
+    QElapsedTimer timer;
+    timer.start();
+    if (!image->load(_firmwareFilename, boardId)) {
+        delete image;
+        if (errorString.isEmpty()) {
+            errorString = tr("Image load failed");
+        }
+        return QSharedPointer<const FirmwareImage>();
+    }
+    disconnect(statusConnection);
+    errorString.clear();
+    qCDebug(FirmwareUpgradeLog) << "Batch: decoded image for board id" << boardId << "msecs:" << timer.elapsed();
+
+    // The last reference may be dropped on a worker thread
+    QSharedPointer<const FirmwareImage> sharedImage(image, &QObject::deleteLater);
+    _images[boardId] = sharedImage;
+    return sharedImage;
+}
+
+void PX4FirmwareBatchFlasher::_foundBootloader(int boardId, int flashSize)
+{
+    Session_t* session = _session(sender());
+    if (!session) {
+        return;
+    }
+
+    QString                             errorString;
+    QSharedPointer<const FirmwareImage> image = _image(boardId, errorString);
+
+    session->board->setBoardId(boardId);
+    if (!image) {
+        QMetaObject::invokeMethod(session->worker, "abort", Qt::QueuedConnection, Q_ARG(QString, errorString));
+        return;
+    }
+    if (flashSize != 0 && image->imageSize() > (uint32_t)flashSize) {
+        QMetaObject::invokeMethod(session->worker, "abort", Qt::QueuedConnection, Q_ARG(QString, tr("Image size of %1 is too large for board flash size %2").arg(image->imageSize()).arg(flashSize)));
+        return;
+    }
+
+    if (!session->recheck) {
+        session->board->setState(PX4FirmwareBatchFlashBoard::StateFlashing);
+        if (!_elapsed.isValid()) {
+            _elapsed.start();
+        }
+    }
+
+    session->worker->setImage(image);
+    session->worker->setRecheck(session->recheck);
+    QMetaObject::invokeMethod(session->worker, "flash", Qt::QueuedConnection);
+}
+
+void PX4FirmwareBatchFlasher::_status(const QString& statusText)
+{
+    Session_t* session = _session(sender());
+    if (session && !session->recheck) {
+        session->board->setStatus(statusText);
+    }
+}
+
+void PX4FirmwareBatchFlasher::_updateProgress(int curr, int total)
+{
+    Session_t* session = _session(sender());
+    if (session && total > 0) {
+        session->board->setProgress((double)curr / (double)total);
+    }
+}
+
+void PX4FirmwareBatchFlasher::_finished(bool success, const QString& errorString, double bytesPerSecond)
+{
+    Session_t* session = _session(sender());
+    if (!session) {
+        return;
+    }
+
+    PX4FirmwareBatchFlashBoard* board = session->board;
+    bool programmed = bytesPerSecond > 0;
+
+    qCDebug(FirmwareUpgradeLog) << "Batch: finished" << board->portName() << success << errorString << bytesPerSecond << "recheck:" << session->recheck;
+
+    if (session->recheck && !programmed) {
+        // The board came back after its reboot. Either the bootloader was already gone or the firmware is
+        // current, the earlier result stands.
+    } else if (session->cancelled && !success) {
+        // Stopped before flashing started, this isn't a failure of the board
+        board->setState(PX4FirmwareBatchFlashBoard::StateCancelled);
+        board->setStatus(errorString);
+    } else if (success) {
+        board->setState(PX4FirmwareBatchFlashBoard::StateComplete);
+        board->setStatus(programmed ? tr("Complete") : tr("Firmware already current"));
+        board->setProgress(1);
+        board->setBytesPerSecond(bytesPerSecond);
+        if (programmed && _images.contains(board->boardId())) {
+            _bytesFlashed += _images[board->boardId()]->imageSize();
+        }
+    } else {
+        board->setState(PX4FirmwareBatchFlashBoard::StateFailed);
+        board->setStatus(errorString);
+    }
+    _updateCounts();
+
+    connect(session->thread, &QThread::finished, session->thread, &QObject::deleteLater);
+    session->thread->quit();
+    for (int i=0; i<_sessions.count(); i++) {
+        if (_sessions[i].worker == sender()) {
+            _sessions.removeAt(i);
+            break;
+        }
+    }
+
+    _updateBusy();
+    emit summaryChanged();
+}
+
+double PX4FirmwareBatchFlasher::totalBytesPerSecond(void) const
+{
+    if (!_elapsed.isValid() || _elapsed.elapsed() == 0) {
+        return 0;
+    }
+    return _bytesFlashed / (_elapsed.elapsed() / 1000.0);
+}
+
+QString PX4FirmwareBatchFlasher::summary(void) const
+{
+    return tr("%1 complete, %2 failed, %3 in progress, %4 KB/s overall")
+            .arg(_completeCount)
+            .arg(_failedCount)
+            .arg(_sessions.count())
+            .arg(totalBytesPerSecond() / 1024.0, 0, 'f', 1);
+}
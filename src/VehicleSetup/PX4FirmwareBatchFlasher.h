@@ -0,0 +1,214 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+
+/// @file
+///     @brief Flashes many PX4 boards at the same time, for example a bench of boards on a USB hub.
+
+#ifndef PX4FirmwareBatchFlasher_H
+#define PX4FirmwareBatchFlasher_H
+
+#include "Bootloader.h"
+#include "FirmwareImage.h"
+#include "QmlObjectListModel.h"
+#include "SerialPortWatcher.h"
+
+#include <QObject>
+#include <QThread>
+#include <QHash>
+#include <QSerialPort>
+#include <QElapsedTimer>
+#include <QSharedPointer>
+#include <QAtomicInt>
+
+#include <stdint.h>
+
+/// State of one board in a batch, shown in the batch flash list
+class PX4FirmwareBatchFlashBoard : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef enum {
+        StateConnecting,    ///< Waiting for the bootloader
+        StateFlashing,      ///< Erase, program and verify
+        StateComplete,
+        StateFailed,
+        StateCancelled      ///< Batch was stopped before flashing started, not counted as failed
+    } State_t;
+
+    Q_ENUMS(State_t)
+
+    PX4FirmwareBatchFlashBoard(const QString& portName, QObject* parent = NULL);
+
+    Q_PROPERTY(QString  portName        READ portName                               CONSTANT)
+    Q_PROPERTY(int      boardId         MEMBER _boardId                             NOTIFY boardIdChanged)
+    Q_PROPERTY(State_t  state           MEMBER _state                               NOTIFY stateChanged)
+    Q_PROPERTY(QString  status          MEMBER _status                              NOTIFY statusChanged)
+    Q_PROPERTY(double   progress        MEMBER _progress                            NOTIFY progressChanged)     ///< 0 to 1
+    Q_PROPERTY(double   bytesPerSecond  MEMBER _bytesPerSecond                      NOTIFY bytesPerSecondChanged)
+
+    QString portName(void) const { return _portName; }
+    int     boardId (void) const { return _boardId; }
+    State_t state   (void) const { return _state; }
+
+    void setBoardId(int boardId);
+    void setState(State_t state);
+    void setStatus(const QString& status);
+    void setProgress(double progress);
+    void setBytesPerSecond(double bytesPerSecond);
+
+signals:
+    void boardIdChanged(int boardId);
+    void stateChanged(State_t state);
+    void statusChanged(const QString& status);
+    void progressChanged(double progress);
+    void bytesPerSecondChanged(double bytesPerSecond);
+
+private:
+    QString _portName;
+    int     _boardId;
+    State_t _state;
+    QString _status;
+    double  _progress;
+    double  _bytesPerSecond;
+};
+
+/// Runs the bootloader for one board. Each worker lives on its own thread so boards are flashed in parallel.
+class PX4FirmwareBatchFlashWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    PX4FirmwareBatchFlashWorker(const QString& systemLocation);
+    ~PX4FirmwareBatchFlashWorker();
+
+    /// Sets the image for the next flash call. Must be called before flash is queued to the worker thread.
+    /// The worker keeps its own reference, so the image stays valid even if the flasher drops it.
+    void setImage(QSharedPointer<const FirmwareImage> image) { _image = image; }
+
+    /// Marks the flash as a recheck of a board which already completed. Must be called before flash is queued.
+    void setRecheck(bool recheck) { _recheck = recheck; }
+
+signals:
+    void foundBootloader(int boardId, int flashSize);
+    void status(const QString& statusText);
+    void updateProgress(int curr, int total);
+    void finished(bool success, const QString& errorString, double bytesPerSecond);
+
+public slots:
+    /// Opens the port and waits for the bootloader to answer
+    void findBootloader(void);
+
+    /// Erases, programs and verifies the board, then reboots it. The image is only read.
+    void flash(void);
+
+    /// Reboots the board if the bootloader is open and finishes with the specified error
+    void abort(const QString& errorString);
+
+    /// Makes the worker give up at the next step. Thread safe, connect with Qt::DirectConnection since the
+    /// worker thread is blocked while searching or flashing.
+    void cancel(void) { _cancelled.store(1); }
+
+private:
+    bool _finishIfCancelled(void);
+
+    QString                                 _systemLocation;
+    Bootloader*                             _bootloader;
+    QSerialPort*                            _port;
+    QSharedPointer<const FirmwareImage>     _image;
+    bool                                    _recheck;
+    QAtomicInt                              _cancelled;
+
+    static const int _findBootloaderTimeoutMsecs = 5000;
+};
+
+/// Flashes the same firmware file to every flashable board which shows up while the batch is active. Boards
+/// which are already connected when the batch starts are included. Each firmware image is decoded once per
+/// board id and shared read-only by all workers.
+class PX4FirmwareBatchFlasher : public QObject
+{
+    Q_OBJECT
+
+public:
+    PX4FirmwareBatchFlasher(QObject* parent = NULL, SerialPortWatcher::Backend_t watcherBackend = SerialPortWatcher::BackendAuto);
+    ~PX4FirmwareBatchFlasher();
+
+    Q_PROPERTY(bool                 active          READ active         NOTIFY activeChanged)
+    Q_PROPERTY(bool                 busy            READ busy           NOTIFY busyChanged)
+    Q_PROPERTY(QmlObjectListModel*  boards          READ boards         CONSTANT)
+    Q_PROPERTY(int                  completeCount   MEMBER _completeCount   NOTIFY summaryChanged)
+    Q_PROPERTY(int                  failedCount     MEMBER _failedCount     NOTIFY summaryChanged)
+    Q_PROPERTY(QString              summary         READ summary        NOTIFY summaryChanged)
+
+    /// Starts flashing the specified firmware file (.px4 or .bin) to all boards
+    ///     @return false: Previous batch is still finishing its sessions, nothing was started
+    bool start(const QString& firmwareFilename);
+
+    /// Stops accepting new boards. Boards still waiting for their bootloader are cancelled, boards which are
+    /// being flashed are finished. busy goes false once the last session is done.
+    void stop(void);
+
+    bool                active  (void) const { return _active; }
+    bool                busy    (void) const { return _busy; }
+    SerialPortWatcher*  portWatcher(void) { return _portWatcher; }     ///< Only valid while active
+    QmlObjectListModel* boards  (void) { return &_boards; }
+    QString             summary (void) const;
+
+    /// @return Number of bytes flashed per second of wall clock time, over all boards
+    double totalBytesPerSecond(void) const;
+
+signals:
+    void activeChanged(bool active);
+    void busyChanged(bool busy);
+    void summaryChanged(void);
+
+    /// Tells all workers to give up. Delivered directly since the worker threads block.
+    void cancelSessions(void);
+
+protected:
+    /// @return true: Board on this port should be flashed
+    virtual bool _portIsFlashable(const QString& systemLocation);
+
+private slots:
+    void _portAdded(const QString& systemLocation);
+    void _foundBootloader(int boardId, int flashSize);
+    void _status(const QString& statusText);
+    void _updateProgress(int curr, int total);
+    void _finished(bool success, const QString& errorString, double bytesPerSecond);
+
+private:
+    typedef struct {
+        PX4FirmwareBatchFlashBoard*     board;
+        PX4FirmwareBatchFlashWorker*    worker;
+        QThread*                        thread;
+        bool                            recheck;    ///< Board on this port already completed, most likely it rebooted
+        bool                            cancelled;
+    } Session_t;
+
+    Session_t* _session(QObject* worker);
+    QSharedPointer<const FirmwareImage> _image(uint32_t boardId, QString& errorString);
+    void _updateBusy(void);
+    void _updateCounts(void);
+
+    bool                                _active;
+    bool                                _busy;          ///< Active or sessions still running
+    SerialPortWatcher::Backend_t        _watcherBackend;
+    QString                             _firmwareFilename;
+    SerialPortWatcher*                  _portWatcher;
+    QmlObjectListModel                  _boards;
+    QList<Session_t>                    _sessions;
+    QHash<uint32_t, QSharedPointer<const FirmwareImage> > _images;  ///< Decoded image per board id, shared with the workers
+    int                                 _completeCount; ///< Boards in StateComplete, each port counts once
+    int                                 _failedCount;   ///< Boards in StateFailed
+    quint64                             _bytesFlashed;
+    QElapsedTimer                       _elapsed;       ///< Started when the first board begins flashing
+};
+
+#endif
@@ -33,6 +33,7 @@ PX4FirmwareUpgradeThreadWorker::PX4FirmwareUpgradeThreadWorker(PX4FirmwareUpgrad
     
     connect(_controller, &PX4FirmwareUpgradeThreadController::_initThreadWorker,            this, &PX4FirmwareUpgradeThreadWorker::_init);
     connect(_controller, &PX4FirmwareUpgradeThreadController::_startFindBoardLoopOnThread,  this, &PX4FirmwareUpgradeThreadWorker::_startFindBoardLoop);
+    connect(_controller, &PX4FirmwareUpgradeThreadController::_stopFindBoardLoopOnThread,   this, &PX4FirmwareUpgradeThreadWorker::_stopFindBoardLoop);
     connect(_controller, &PX4FirmwareUpgradeThreadController::_flashOnThread,               this, &PX4FirmwareUpgradeThreadWorker::_flash);
     connect(_controller, &PX4FirmwareUpgradeThreadController::_rebootOnThread,              this, &PX4FirmwareUpgradeThreadWorker::_reboot);
     connect(_controller, &PX4FirmwareUpgradeThreadController::_cancel,                      this, &PX4FirmwareUpgradeThreadWorker::_cancel);
@@ -80,6 +81,11 @@ void PX4FirmwareUpgradeThreadWorker::_startFindBoardLoop(void)
     _findBoardOnce();
 }
 
+void PX4FirmwareUpgradeThreadWorker::_stopFindBoardLoop(void)
+{
+    _timerRetry->stop();
+}
+
 void PX4FirmwareUpgradeThreadWorker::_findBoardOnce(void)
 {
     qCDebug(FirmwareUpgradeVerboseLog) << "_findBoardOnce";
@@ -280,9 +286,10 @@ void PX4FirmwareUpgradeThreadWorker::_flash(void)
     if (_erase()) {
         emit status(tr("Programming new version..."));
         
+        _bootloader->setProgramWindow(Bootloader::programWindowDefault);
         if (_bootloader->program(_bootloaderPort, _controller->image())) {
             qCDebug(FirmwareUpgradeLog) << "Program complete";
-            emit status("Program complete");
+            emit status(tr("Program complete (%1 KB/s)").arg(_bootloader->programBytesPerSecond() / 1024.0, 0, 'f', 1));
         } else {
             _bootloaderPort->deleteLater();
             _bootloaderPort = NULL;
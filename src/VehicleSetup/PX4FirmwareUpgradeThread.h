@@ -56,6 +56,7 @@ signals:
 private slots:
     void _init(void);
     void _startFindBoardLoop(void);
+    void _stopFindBoardLoop(void);
     void _reboot(void);
     void _flash(void);
     void _findBoardOnce(void);
@@ -95,6 +96,9 @@ public:
     /// continue until cancelFind is called. Signals foundBoard and boardGone as boards come and go.
     void startFindBoardLoop(void);
     
+    /// @brief Stops the find board loop, for example while the ports are used by a batch flash
+    void stopFindBoardLoop(void) { emit _stopFindBoardLoopOnThread(); }
+    
     void cancel(void);
     
     /// @brief Sends a reboot command to the bootloader
@@ -136,6 +140,7 @@ signals:
     // Internal signals to communicate with thread worker
     void _initThreadWorker(void);
     void _startFindBoardLoopOnThread(void);
+    void _stopFindBoardLoopOnThread(void);
     void _rebootOnThread(void);
     void _flashOnThread(void);
     void _cancel(void);
@@ -0,0 +1,60 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "VideoLatencyFactGroup.h"
+
+const char* VideoLatencyFactGroup::_frameRateFactName =         "frameRate";
+const char* VideoLatencyFactGroup::_receiveLatencyFactName =    "receiveLatency";
+const char* VideoLatencyFactGroup::_decodeLatencyFactName =     "decodeLatency";
+const char* VideoLatencyFactGroup::_renderLatencyFactName =     "renderLatency";
+const char* VideoLatencyFactGroup::_totalLatencyFactName =      "totalLatency";
+const char* VideoLatencyFactGroup::_maxTotalLatencyFactName =   "maxTotalLatency";
+const char* VideoLatencyFactGroup::_frameJitterFactName =       "frameJitter";
+const char* VideoLatencyFactGroup::_maxFrameJitterFactName =    "maxFrameJitter";
+const char* VideoLatencyFactGroup::_droppedFramesFactName =     "droppedFrames";
+const char* VideoLatencyFactGroup::_lostPacketsFactName =       "lostPackets";
+
+VideoLatencyFactGroup::VideoLatencyFactGroup(QObject* parent)
+    : FactGroup(1000, ":/json/VideoLatencyFact.json", parent)
+    , _frameRateFact        (0, _frameRateFactName,         FactMetaData::valueTypeDouble)
+    , _receiveLatencyFact   (0, _receiveLatencyFactName,    FactMetaData::valueTypeDouble)
+    , _decodeLatencyFact    (0, _decodeLatencyFactName,     FactMetaData::valueTypeDouble)
+    , _renderLatencyFact    (0, _renderLatencyFactName,     FactMetaData::valueTypeDouble)
+    , _totalLatencyFact     (0, _totalLatencyFactName,      FactMetaData::valueTypeDouble)
+    , _maxTotalLatencyFact  (0, _maxTotalLatencyFactName,   FactMetaData::valueTypeDouble)
+    , _frameJitterFact      (0, _frameJitterFactName,       FactMetaData::valueTypeDouble)
+    , _maxFrameJitterFact   (0, _maxFrameJitterFactName,    FactMetaData::valueTypeDouble)
+    , _droppedFramesFact    (0, _droppedFramesFactName,     FactMetaData::valueTypeUint32)
+    , _lostPacketsFact      (0, _lostPacketsFactName,       FactMetaData::valueTypeUint32)
+{
+    _addFact(&_frameRateFact,       _frameRateFactName);
+    _addFact(&_receiveLatencyFact,  _receiveLatencyFactName);
+    _addFact(&_decodeLatencyFact,   _decodeLatencyFactName);
+    _addFact(&_renderLatencyFact,   _renderLatencyFactName);
+    _addFact(&_totalLatencyFact,    _totalLatencyFactName);
+    _addFact(&_maxTotalLatencyFact, _maxTotalLatencyFactName);
+    _addFact(&_frameJitterFact,     _frameJitterFactName);
+    _addFact(&_maxFrameJitterFact,  _maxFrameJitterFactName);
+    _addFact(&_droppedFramesFact,   _droppedFramesFactName);
+    _addFact(&_lostPacketsFact,     _lostPacketsFactName);
+}
+
+void VideoLatencyFactGroup::update(const VideoLatencyStatistics& statistics)
+{
+    _frameRateFact.setRawValue          (statistics.frameRate);
+    _receiveLatencyFact.setRawValue     (statistics.receiveMsecs);
+    _decodeLatencyFact.setRawValue      (statistics.decodeMsecs);
+    _renderLatencyFact.setRawValue      (statistics.renderMsecs);
+    _totalLatencyFact.setRawValue       (statistics.totalMsecs);
+    _maxTotalLatencyFact.setRawValue    (statistics.maxTotalMsecs);
+    _frameJitterFact.setRawValue        (statistics.frameJitterMsecs);
+    _maxFrameJitterFact.setRawValue     (statistics.maxFrameJitterMsecs);
+    _droppedFramesFact.setRawValue      (statistics.droppedFrames);
+    _lostPacketsFact.setRawValue        (statistics.lostPackets);
+}
@@ -0,0 +1,69 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "FactGroup.h"
+#include "VideoLatencyProbe.h"
+
+/// Video pipeline timing from VideoLatencyProbe, updated once a second while streaming
+class VideoLatencyFactGroup : public FactGroup
+{
+    Q_OBJECT
+
+public:
+    VideoLatencyFactGroup(QObject* parent = NULL);
+
+    Q_PROPERTY(Fact* frameRate              READ frameRate              CONSTANT)
+    Q_PROPERTY(Fact* receiveLatency         READ receiveLatency         CONSTANT)
+    Q_PROPERTY(Fact* decodeLatency          READ decodeLatency          CONSTANT)
+    Q_PROPERTY(Fact* renderLatency          READ renderLatency          CONSTANT)
+    Q_PROPERTY(Fact* totalLatency           READ totalLatency           CONSTANT)
+    Q_PROPERTY(Fact* maxTotalLatency        READ maxTotalLatency        CONSTANT)
+    Q_PROPERTY(Fact* frameJitter            READ frameJitter            CONSTANT)
+    Q_PROPERTY(Fact* maxFrameJitter         READ maxFrameJitter         CONSTANT)
+    Q_PROPERTY(Fact* droppedFrames          READ droppedFrames          CONSTANT)
+    Q_PROPERTY(Fact* lostPackets            READ lostPackets            CONSTANT)
+
+    Fact* frameRate                 (void) { return &_frameRateFact; }
+    Fact* receiveLatency            (void) { return &_receiveLatencyFact; }
+    Fact* decodeLatency             (void) { return &_decodeLatencyFact; }
+    Fact* renderLatency             (void) { return &_renderLatencyFact; }
+    Fact* totalLatency              (void) { return &_totalLatencyFact; }
+    Fact* maxTotalLatency           (void) { return &_maxTotalLatencyFact; }
+    Fact* frameJitter               (void) { return &_frameJitterFact; }
+    Fact* maxFrameJitter            (void) { return &_maxFrameJitterFact; }
+    Fact* droppedFrames             (void) { return &_droppedFramesFact; }
+    Fact* lostPackets               (void) { return &_lostPacketsFact; }
+
+    void update(const VideoLatencyStatistics& statistics);
+
+    static const char* _frameRateFactName;
+    static const char* _receiveLatencyFactName;
+    static const char* _decodeLatencyFactName;
+    static const char* _renderLatencyFactName;
+    static const char* _totalLatencyFactName;
+    static const char* _maxTotalLatencyFactName;
+    static const char* _frameJitterFactName;
+    static const char* _maxFrameJitterFactName;
+    static const char* _droppedFramesFactName;
+    static const char* _lostPacketsFactName;
+
+private:
+    Fact _frameRateFact;
+    Fact _receiveLatencyFact;
+    Fact _decodeLatencyFact;
+    Fact _renderLatencyFact;
+    Fact _totalLatencyFact;
+    Fact _maxTotalLatencyFact;
+    Fact _frameJitterFact;
+    Fact _maxFrameJitterFact;
+    Fact _droppedFramesFact;
+    Fact _lostPacketsFact;
+};
@@ -0,0 +1,336 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "VideoLatencyProbe.h"
+
+#if defined(QGC_GST_STREAMING)
+
+#include <QMutexLocker>
+
+VideoLatencyProbe::VideoLatencyProbe(void)
+    : _attached(false)
+    , _rtp(false)
+{
+    for (int i=0; i<ProbeCount; i++) {
+        _pads[i] =              NULL;
+        _probeIds[i] =          0;
+        _probeInfo[i].probe =   this;
+        _probeInfo[i].type =    (Probe_t)i;
+    }
+    _clock.start();
+    _reset();
+}
+
+VideoLatencyProbe::~VideoLatencyProbe()
+{
+    detach();
+}
+
+void VideoLatencyProbe::_reset(void)
+{
+    for (int i=0; i<maxPendingFrames; i++) {
+        _frames[i].pts =            GST_CLOCK_TIME_NONE;
+        _frames[i].sourceNsecs =    -1;
+        _frames[i].depayNsecs =     -1;
+        _frames[i].decodeNsecs =    -1;
+        _frames[i].done =           true;
+    }
+    _nextFrame =            0;
+    _frameSourceNsecs =     -1;
+    _haveSequence =         false;
+    _lastSequence =         0;
+    _lastSinkNsecs =        -1;
+    _averageIntervalNsecs = 0;
+
+    _periodStartNsecs =     _clock.nsecsElapsed();
+    _frameCount =           0;
+    _receiveNsecs =         0;
+    _decodeNsecs =          0;
+    _renderNsecs =          0;
+    _totalNsecs =           0;
+    _maxTotalNsecs =        0;
+    _intervalCount =        0;
+    _jitterNsecs =          0;
+    _maxJitterNsecs =       0;
+
+    _droppedFrames =        0;
+    _lostPackets =          0;
+}
+
+void VideoLatencyProbe::attach(GstPad* sourcePad, GstPad* depayPad, GstPad* decodePad, GstPad* sinkPad, bool rtp)
+{
+    detach();
+
+    QMutexLocker lock(&_mutex);
+
+    _reset();
+    _rtp = rtp;
+    _pads[ProbeSource] =    sourcePad;
+    _pads[ProbeDepay] =     depayPad;
+    _pads[ProbeDecode] =    decodePad;
+    _pads[ProbeSink] =      sinkPad;
+
+    for (int i=0; i<ProbeCount; i++) {
+        if (_pads[i]) {
+            gst_object_ref(_pads[i]);
+            _probeIds[i] = gst_pad_add_probe(_pads[i],
+                                             (GstPadProbeType)(GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST),
+                                             _probeCallback,
+                                             &_probeInfo[i],
+                                             _probeRemoved);
+        }
+    }
+    _attached = true;
+}
+
+void VideoLatencyProbe::detach(void)
+{
+    int removedCount = 0;
+
+    {
+        // Callbacks which are already running return without touching the frame state from here on
+        QMutexLocker lock(&_mutex);
+        _attached = false;
+    }
+
+    for (int i=0; i<ProbeCount; i++) {
+        if (_pads[i]) {
+            if (_probeIds[i]) {
+                gst_pad_remove_probe(_pads[i], _probeIds[i]);
+                removedCount++;
+            }
+            gst_object_unref(_pads[i]);
+            _pads[i] = NULL;
+        }
+        _probeIds[i] = 0;
+    }
+
+    // GStreamer only releases a removed probe once its running callbacks returned, wait for that before the probe goes away
+    _probesRemoved.acquire(removedCount);
+}
+
+void VideoLatencyProbe::_probeRemoved(gpointer user_data)
+{
+    ((ProbeInfo*)user_data)->probe->_probesRemoved.release();
+}
+
+GstPadProbeReturn VideoLatencyProbe::_probeCallback(GstPad* pad, GstPadProbeInfo* info, gpointer user_data)
+{
+    Q_UNUSED(pad);
+
+    ProbeInfo*          probeInfo = (ProbeInfo*)user_data;
+    VideoLatencyProbe*  pThis = probeInfo->probe;
+    QMutexLocker        lock(&pThis->_mutex);
+    qint64              nowNsecs = pThis->_clock.nsecsElapsed();
+
+    if (!pThis->_attached) {
+        return GST_PAD_PROBE_OK;
+    }
+
+    if (GST_PAD_PROBE_INFO_TYPE(info) & GST_PAD_PROBE_TYPE_BUFFER) {
+        pThis->_buffer(probeInfo->type, GST_PAD_PROBE_INFO_BUFFER(info), nowNsecs);
+    } else if (GST_PAD_PROBE_INFO_TYPE(info) & GST_PAD_PROBE_TYPE_BUFFER_LIST) {
+        GstBufferList* list = GST_PAD_PROBE_INFO_BUFFER_LIST(info);
+        for (guint i=0; i<gst_buffer_list_length(list); i++) {
+            pThis->_buffer(probeInfo->type, gst_buffer_list_get(list, i), nowNsecs);
+        }
+    }
+
+    return GST_PAD_PROBE_OK;
+}
+
+void VideoLatencyProbe::_buffer(Probe_t type, GstBuffer* buffer, qint64 nowNsecs)
+{
+    switch (type) {
+    case ProbeSource:
+        _source(buffer, nowNsecs);
+        break;
+    case ProbeDepay:
+        _depay(buffer, nowNsecs);
+        break;
+    case ProbeDecode:
+        _decode(buffer, nowNsecs);
+        break;
+    case ProbeSink:
+        _sink(buffer, nowNsecs);
+        break;
+    default:
+        break;
+    }
+}
+
+void VideoLatencyProbe::_source(GstBuffer* buffer, qint64 nowNsecs)
+{
+    if (_frameSourceNsecs < 0) {
+        _frameSourceNsecs = nowNsecs;
+    }
+
+    if (_rtp) {
+        GstMapInfo map;
+
+        if (gst_buffer_map(buffer, &map, GST_MAP_READ)) {
+            // RTP version 2, sequence number in bytes 2-3
+            if (map.size >= 4 && (map.data[0] >> 6) == 2) {
+                quint16 sequence = (map.data[2] << 8) | map.data[3];
+                if (_haveSequence) {
+                    quint16 gap = sequence - _lastSequence - 1;
+                    if (gap < 0x8000) {
+                        _lostPackets += gap;
+                        _lastSequence = sequence;
+                    }
+                    // else late or duplicate packet
+                } else {
+                    _haveSequence = true;
+                    _lastSequence = sequence;
+                }
+            }
+            gst_buffer_unmap(buffer, &map);
+        }
+    }
+}
+
+void VideoLatencyProbe::_depay(GstBuffer* buffer, qint64 nowNsecs)
+{
+    GstClockTime    pts = GST_BUFFER_PTS(buffer);
+    Frame_t*        lastFrame = &_frames[(_nextFrame + maxPendingFrames - 1) % maxPendingFrames];
+
+    // NAL aligned output sends a frame in several buffers with the same PTS
+    if (GST_CLOCK_TIME_IS_VALID(pts) && lastFrame->depayNsecs >= 0 && lastFrame->pts == pts) {
+        return;
+    }
+
+    Frame_t* frame = &_frames[_nextFrame];
+    if (!frame->done) {
+        // Fell out of the ring without reaching the sink
+        _droppedFrames++;
+    }
+    frame->pts =            pts;
+    frame->sourceNsecs =    _frameSourceNsecs >= 0 ? _frameSourceNsecs : nowNsecs;
+    frame->depayNsecs =     nowNsecs;
+    frame->decodeNsecs =    -1;
+    frame->done =           false;
+
+    _nextFrame = (_nextFrame + 1) % maxPendingFrames;
+    _frameSourceNsecs = -1;
+}
+
+void VideoLatencyProbe::_decode(GstBuffer* buffer, qint64 nowNsecs)
+{
+    Frame_t* frame = _findFrame(GST_BUFFER_PTS(buffer), false /* decoded */);
+
+    if (frame) {
+        frame->decodeNsecs = nowNsecs;
+    }
+}
+
+void VideoLatencyProbe::_sink(GstBuffer* buffer, qint64 nowNsecs)
+{
+    Frame_t* frame = _findFrame(GST_BUFFER_PTS(buffer), true /* decoded */);
+
+    if (!frame) {
+        return;
+    }
+
+    // Frames received before this one which haven't made it to the sink were dropped along the way
+    _retireOlder((int)(frame - _frames));
+    frame->done = true;
+
+    qint64 totalNsecs = nowNsecs - frame->sourceNsecs;
+    _frameCount++;
+    _receiveNsecs +=    frame->depayNsecs - frame->sourceNsecs;
+    _decodeNsecs +=     frame->decodeNsecs - frame->depayNsecs;
+    _renderNsecs +=     nowNsecs - frame->decodeNsecs;
+    _totalNsecs +=      totalNsecs;
+    _maxTotalNsecs =    qMax(_maxTotalNsecs, totalNsecs);
+
+    if (_lastSinkNsecs >= 0) {
+        qint64 intervalNsecs = nowNsecs - _lastSinkNsecs;
+        if (_averageIntervalNsecs > 0) {
+            qint64 jitterNsecs = qAbs(intervalNsecs - (qint64)_averageIntervalNsecs);
+            _intervalCount++;
+            _jitterNsecs += jitterNsecs;
+            _maxJitterNsecs = qMax(_maxJitterNsecs, jitterNsecs);
+            _averageIntervalNsecs += (intervalNsecs - _averageIntervalNsecs) / 16.0;
+        } else {
+            _averageIntervalNsecs = intervalNsecs;
+        }
+    }
+    _lastSinkNsecs = nowNsecs;
+}
+
+/// Finds a pending frame, oldest first
+///     @param pts Frame PTS, the oldest pending frame is used if the PTS is not valid
+///     @param decoded true: frame must have been decoded, false: frame must not have been decoded yet
+VideoLatencyProbe::Frame_t* VideoLatencyProbe::_findFrame(GstClockTime pts, bool decoded)
+{
+    for (int i=0; i<maxPendingFrames; i++) {
+        Frame_t* frame = &_frames[(_nextFrame + i) % maxPendingFrames];
+
+        if (frame->done || (frame->decodeNsecs >= 0) != decoded) {
+            continue;
+        }
+        if (!GST_CLOCK_TIME_IS_VALID(pts) || frame->pts == pts) {
+            return frame;
+        }
+    }
+
+    return NULL;
+}
+
+/// Marks pending frames received before the frame at index as dropped
+void VideoLatencyProbe::_retireOlder(int index)
+{
+    for (int i=_nextFrame; i!=index; i=(i + 1) % maxPendingFrames) {
+        Frame_t* frame = &_frames[i];
+
+        if (!frame->done) {
+            frame->done = true;
+            _droppedFrames++;
+        }
+    }
+}
+
+VideoLatencyStatistics VideoLatencyProbe::takeStatistics(void)
+{
+    QMutexLocker            lock(&_mutex);
+    VideoLatencyStatistics  statistics;
+    qint64                  nowNsecs = _clock.nsecsElapsed();
+    qint64                  periodNsecs = nowNsecs - _periodStartNsecs;
+
+    statistics.frames =         _frameCount;
+    statistics.frameRate =      periodNsecs > 0 ? (_frameCount * 1e9) / periodNsecs : 0;
+    if (_frameCount) {
+        statistics.receiveMsecs =   (_receiveNsecs / 1e6) / _frameCount;
+        statistics.decodeMsecs =    (_decodeNsecs / 1e6) / _frameCount;
+        statistics.renderMsecs =    (_renderNsecs / 1e6) / _frameCount;
+        statistics.totalMsecs =     (_totalNsecs / 1e6) / _frameCount;
+    }
+    statistics.maxTotalMsecs =  _maxTotalNsecs / 1e6;
+    if (_intervalCount) {
+        statistics.frameJitterMsecs = (_jitterNsecs / 1e6) / _intervalCount;
+    }
+    statistics.maxFrameJitterMsecs = _maxJitterNsecs / 1e6;
+    statistics.droppedFrames =  _droppedFrames;
+    statistics.lostPackets =    _lostPackets;
+
+    _periodStartNsecs = nowNsecs;
+    _frameCount =       0;
+    _receiveNsecs =     0;
+    _decodeNsecs =      0;
+    _renderNsecs =      0;
+    _totalNsecs =       0;
+    _maxTotalNsecs =    0;
+    _intervalCount =    0;
+    _jitterNsecs =      0;
+    _maxJitterNsecs =   0;
+
+    return statistics;
+}
+
+#endif
@@ -0,0 +1,158 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef VideoLatencyProbe_H
+#define VideoLatencyProbe_H
+
+#include <QtGlobal>
+#include <QMutex>
+#include <QSemaphore>
+#include <QElapsedTimer>
+
+#if defined(QGC_GST_STREAMING)
+#include <gst/gst.h>
+#endif
+
+/// Per stage frame timing of a video pipeline over one statistics period
+struct VideoLatencyStatistics {
+    VideoLatencyStatistics()
+        : frames(0)
+        , frameRate(0)
+        , receiveMsecs(0)
+        , decodeMsecs(0)
+        , renderMsecs(0)
+        , totalMsecs(0)
+        , maxTotalMsecs(0)
+        , frameJitterMsecs(0)
+        , maxFrameJitterMsecs(0)
+        , droppedFrames(0)
+        , lostPackets(0)
+    {}
+
+    int     frames;                 ///< Frames which reached the sink
+    double  frameRate;              ///< Frames per second at the sink
+    double  receiveMsecs;           ///< First data of a frame at the source to depayloaded frame (transfer, jitter buffer, depay)
+    double  decodeMsecs;            ///< Depayloaded frame to decoded frame (parser, queue, decoder)
+    double  renderMsecs;            ///< Decoded frame to the video sink
+    double  totalMsecs;             ///< First data of a frame at the source to the video sink
+    double  maxTotalMsecs;
+    double  frameJitterMsecs;       ///< Average deviation of the interval between frames at the sink from the average interval
+    double  maxFrameJitterMsecs;
+    quint32 droppedFrames;          ///< Depayloaded frames which never reached the sink, since attach
+    quint32 lostPackets;            ///< RTP sequence number gaps at the source, since attach
+};
+
+#if defined(QGC_GST_STREAMING)
+
+/// Measures where video latency comes from using buffer pad probes at four points of a receive pipeline:
+///     source  - data as it leaves the source (or jitter buffer), before the depayloader/demuxer
+///     depay   - frames as they leave the depayloader/demuxer
+///     decode  - decoded frames
+///     sink    - frames arriving at the video sink
+///
+/// A frame starts with the first source buffer after the previous frame was depayloaded. Frames are followed through
+/// decoder and sink by their PTS. All times are taken from a monotonic clock in the streaming threads, the probes only
+/// update counters under a lock and don't allocate.
+///
+/// Frames are expected to reach the sink in the order they were depayloaded. A frame which reaches the sink retires the
+/// older pending frames as dropped, so with B-frames, where decode order differs from display order, reordered frames
+/// are counted as dropped and their latency is missing from the statistics.
+class VideoLatencyProbe
+{
+public:
+    VideoLatencyProbe(void);
+    ~VideoLatencyProbe();
+
+    /// Installs the probes, any pad may be NULL. Pads are referenced until detach.
+    ///     @param rtp true: source buffers are RTP packets, sequence number gaps are counted as lost packets
+    void attach(GstPad* sourcePad, GstPad* depayPad, GstPad* decodePad, GstPad* sinkPad, bool rtp);
+
+    /// Removes the probes, must be called before the pipeline is destroyed
+    void detach(void);
+
+    bool attached(void) const { return _attached; }
+
+    /// @return Statistics since the previous call
+    VideoLatencyStatistics takeStatistics(void);
+
+    static const int maxPendingFrames = 64;    ///< Frames followed between depay and sink
+
+private:
+    typedef enum {
+        ProbeSource,
+        ProbeDepay,
+        ProbeDecode,
+        ProbeSink,
+        ProbeCount
+    } Probe_t;
+
+    typedef struct {
+        GstClockTime    pts;
+        qint64          sourceNsecs;
+        qint64          depayNsecs;
+        qint64          decodeNsecs;
+        bool            done;               ///< Reached the sink or was dropped
+    } Frame_t;
+
+    static GstPadProbeReturn _probeCallback(GstPad* pad, GstPadProbeInfo* info, gpointer user_data);
+    static void _probeRemoved(gpointer user_data);
+
+    void        _reset          (void);
+    void        _buffer         (Probe_t type, GstBuffer* buffer, qint64 nowNsecs);
+    void        _source         (GstBuffer* buffer, qint64 nowNsecs);
+    void        _depay          (GstBuffer* buffer, qint64 nowNsecs);
+    void        _decode         (GstBuffer* buffer, qint64 nowNsecs);
+    void        _sink           (GstBuffer* buffer, qint64 nowNsecs);
+    Frame_t*    _findFrame      (GstClockTime pts, bool decoded);
+    void        _retireOlder    (int index);
+
+    struct ProbeInfo {
+        VideoLatencyProbe*  probe;
+        Probe_t             type;
+    };
+
+    bool            _attached;
+    bool            _rtp;
+    GstPad*         _pads[ProbeCount];
+    gulong          _probeIds[ProbeCount];
+    ProbeInfo       _probeInfo[ProbeCount];
+
+    QMutex          _mutex;
+    QSemaphore      _probesRemoved;         ///< Released once a removed probe has no callback running anymore
+    QElapsedTimer   _clock;
+
+    // Frame tracking, ring of the last maxPendingFrames depayloaded frames
+    Frame_t         _frames[maxPendingFrames];
+    int             _nextFrame;
+    qint64          _frameSourceNsecs;      ///< First source buffer of the frame being received, -1 for none
+    bool            _haveSequence;
+    quint16         _lastSequence;
+    qint64          _lastSinkNsecs;
+    double          _averageIntervalNsecs;
+
+    // Accumulated since the last takeStatistics
+    qint64          _periodStartNsecs;
+    int             _frameCount;
+    qint64          _receiveNsecs;
+    qint64          _decodeNsecs;
+    qint64          _renderNsecs;
+    qint64          _totalNsecs;
+    qint64          _maxTotalNsecs;
+    int             _intervalCount;
+    qint64          _jitterNsecs;
+    qint64          _maxJitterNsecs;
+
+    // Totals since attach
+    quint32         _droppedFrames;
+    quint32         _lostPackets;
+};
+
+#endif
+
+#endif
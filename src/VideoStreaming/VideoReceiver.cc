@@ -24,8 +24,10 @@
 #include <QDir>
 #include <QDateTime>
 #include <QSysInfo>
+#include <QThread>
 
 QGC_LOGGING_CATEGORY(VideoReceiverLog, "VideoReceiverLog")
+QGC_LOGGING_CATEGORY(VideoReceiverLatencyLog, "VideoReceiverLatencyLog")
 
 #if defined(QGC_GST_STREAMING)
 
@@ -45,6 +47,18 @@ static const char* kVideoMuxes[] =
 
 #define NUM_MUXES (sizeof(kVideoMuxes) / sizeof(char*))
 
+// RTSP jitter buffer latency
+static const int        kRtspLatencyMs =                17;
+static const int        kLowLatencyRtspLatencyMs =      10;
+
+// Low latency profile: encoded data queued ahead of the decoder before the oldest is dropped
+static const guint64    kLowLatencyDecodeQueueNs =      100 * GST_MSECOND;
+// Low latency profile: frames later than this at the sink are dropped
+static const gint64     kLowLatencyMaxLatenessNs =      20 * GST_MSECOND;
+static const int        kLowLatencyMaxDecoderThreads =  4;
+// Low latency profile: recording queue, large enough that a slow disk doesn't hold up the display branch
+static const guint      kLowLatencyRecordQueueBytes =   32 * 1024 * 1024;
+
 #endif
 
 
@@ -61,8 +75,12 @@ VideoReceiver::VideoReceiver(QObject* parent)
     , _pipeline(NULL)
     , _pipelineStopRec(NULL)
     , _videoSink(NULL)
+    , _videoSinkSync(FALSE)
+    , _videoSinkQos(FALSE)
+    , _videoSinkMaxLateness(-1)
     , _socket(NULL)
     , _serverPresent(false)
+    , _lowLatency(false)
 #endif
     , _videoSurface(NULL)
     , _videoRunning(false)
@@ -109,7 +127,55 @@ VideoReceiver::_setVideoSink(GstElement* sink)
     if (sink) {
         _videoSink = sink;
         gst_object_ref_sink(_videoSink);
+        g_object_get(G_OBJECT(_videoSink),
+                     "sync",                &_videoSinkSync,
+                     "qos",                 &_videoSinkQos,
+                     "max-lateness",        &_videoSinkMaxLateness,
+                     NULL);
+    }
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Default profile: blocking queues, every frame is shown no matter how late.
+// Low latency profile: leaky queues around the decoder and a synchronized sink
+// with QoS, so on a congested link frames are dropped instead of queued. Data
+// dropped ahead of the decoder shows as artifacts until the next key frame.
+// The recording branch hangs off the tee before these queues and never drops.
+#if defined(QGC_GST_STREAMING)
+void
+VideoReceiver::_configureDisplayBranch(GstElement* queue, GstElement* decoder, GstElement* queue1)
+{
+    if (_lowLatency) {
+        // Leaky downstream: drop the oldest buffer when full
+        g_object_set(G_OBJECT(queue),
+                     "leaky",               2,
+                     "max-size-buffers",    (guint)0,
+                     "max-size-bytes",      (guint)0,
+                     "max-size-time",       kLowLatencyDecodeQueueNs,
+                     NULL);
+        g_object_set(G_OBJECT(queue1),
+                     "leaky",               2,
+                     "max-size-buffers",    (guint)1,
+                     "max-size-bytes",      (guint)0,
+                     "max-size-time",       (guint64)0,
+                     NULL);
+        // avdec_h264 uses slice threading for live sources, so threads don't add frames of delay
+        g_object_set(G_OBJECT(decoder), "max-threads", qBound(1, QThread::idealThreadCount(), kLowLatencyMaxDecoderThreads), NULL);
+        g_object_set(G_OBJECT(_videoSink),
+                     "sync",                TRUE,
+                     "qos",                 TRUE,
+                     "max-lateness",        kLowLatencyMaxLatenessNs,
+                     NULL);
+    } else {
+        // The sink is reused across restarts, put back what VideoSurface set up
+        g_object_set(G_OBJECT(_videoSink),
+                     "sync",                _videoSinkSync,
+                     "qos",                 _videoSinkQos,
+                     "max-lateness",        _videoSinkMaxLateness,
+                     NULL);
     }
+    qCDebug(VideoReceiverLog) << "Low latency profile:" << _lowLatency;
 }
 #endif
 
@@ -239,6 +305,8 @@ VideoReceiver::start()
     bool isRtsp = _uri.contains("rtsp://");
     bool isTCP  = _uri.contains("tcp://");
 
+    _lowLatency = _videoSettings->lowLatencyMode()->rawValue().toBool();
+
     //-- For RTSP and TCP, check to see if server is there first
     if(!_serverPresent && (isRtsp || isTCP)) {
         _timer.start(100);
@@ -285,7 +353,11 @@ VideoReceiver::start()
             QUrl url(_uri);
             g_object_set(G_OBJECT(dataSource), "host", qPrintable(url.host()), "port", url.port(), NULL );
         } else {
-            g_object_set(G_OBJECT(dataSource), "location", qPrintable(_uri), "latency", 17, "udp-reconnect", 1, "timeout", static_cast<guint64>(5000000), NULL);
+            g_object_set(G_OBJECT(dataSource), "location", qPrintable(_uri), "latency", _lowLatency ? kLowLatencyRtspLatencyMs : kRtspLatencyMs, "udp-reconnect", 1, "timeout", static_cast<guint64>(5000000), NULL);
+            if (_lowLatency) {
+                // Drop packets which arrive too late for the jitter buffer instead of growing it
+                g_object_set(G_OBJECT(dataSource), "drop-on-latency", TRUE, NULL);
+            }
         }
 
         // Currently, we expect H264 when using anything except for TCP.  Long term we may want this to be settable
@@ -328,6 +400,8 @@ VideoReceiver::start()
             break;
         }
 
+        _configureDisplayBranch(queue, decoder, queue1);
+
         gst_bin_add_many(GST_BIN(_pipeline), dataSource, demux, parser, _tee, queue, decoder, queue1, _videoSink, NULL);
         pipelineUp = true;
 
@@ -349,12 +423,14 @@ VideoReceiver::start()
             g_signal_connect(demux, "pad-added", G_CALLBACK(newPadCB), parser);
         } else {
             g_signal_connect(dataSource, "pad-added", G_CALLBACK(newPadCB), demux);
-            if(!gst_element_link_many(demux, parser, _tee, queue, decoder, _videoSink, NULL)) {
+            if(!gst_element_link_many(demux, parser, _tee, queue, decoder, queue1, _videoSink, NULL)) {
                 qCritical() << "Unable to link RTSP elements.";
                 break;
             }
         }
 
+        _attachLatencyProbe(demux, parser, decoder, isUdp || isRtsp);
+
         dataSource = demux = parser = queue = decoder = queue1 = NULL;
 
         GstBus* bus = NULL;
@@ -379,6 +455,8 @@ VideoReceiver::start()
     if (!running) {
         qCritical() << "VideoReceiver::start() failed";
 
+        _latencyProbe.detach();
+
         // In newer versions, the pipeline will clean up all references that are added to it
         if (_pipeline != NULL) {
             gst_object_unref(_pipeline);
@@ -476,6 +554,8 @@ VideoReceiver::_shutdownPipeline() {
         bus = NULL;
     }
     gst_element_set_state(_pipeline, GST_STATE_NULL);
+    _latencyProbe.detach();
+    _latencyFactGroup.update(VideoLatencyStatistics());
     gst_bin_remove(GST_BIN(_pipeline), _videoSink);
     gst_object_unref(_pipeline);
     _pipeline = NULL;
@@ -659,6 +739,14 @@ VideoReceiver::startRecording(const QString &videoFile)
     emit videoFileChanged();
 
     g_object_set(G_OBJECT(_sink->filesink), "location", qPrintable(_videoFile), NULL);
+    if (_lowLatency) {
+        // Never leaky, but a deep queue so the tee isn't held up, and with it the display branch
+        g_object_set(G_OBJECT(_sink->queue),
+                     "max-size-buffers",    (guint)0,
+                     "max-size-time",       (guint64)0,
+                     "max-size-bytes",      kLowLatencyRecordQueueBytes,
+                     NULL);
+    }
     qCDebug(VideoReceiverLog) << "New video file:" << _videoFile;
 
     gst_object_ref(_sink->queue);
@@ -802,11 +890,65 @@ VideoReceiver::_unlinkCallBack(GstPad* pad, GstPadProbeInfo* info, gpointer user
 }
 #endif
 
+//-----------------------------------------------------------------------------
+// Timestamps buffers entering the depayloader/demuxer, leaving it, leaving the
+// decoder and arriving at the video sink. See VideoLatencyProbe.
+#if defined(QGC_GST_STREAMING)
+void
+VideoReceiver::_attachLatencyProbe(GstElement* demux, GstElement* parser, GstElement* decoder, bool rtp)
+{
+    GstPad* sourcePad   = gst_element_get_static_pad(demux,      "sink");
+    GstPad* depayPad    = gst_element_get_static_pad(parser,     "sink");
+    GstPad* decodePad   = gst_element_get_static_pad(decoder,    "src");
+    GstPad* sinkPad     = gst_element_get_static_pad(_videoSink, "sink");
+
+    _latencyProbe.attach(sourcePad, depayPad, decodePad, sinkPad, rtp);
+
+    if (sourcePad) {
+        gst_object_unref(sourcePad);
+    }
+    if (depayPad) {
+        gst_object_unref(depayPad);
+    }
+    if (decodePad) {
+        gst_object_unref(decodePad);
+    }
+    if (sinkPad) {
+        gst_object_unref(sinkPad);
+    }
+}
+#endif
+
+//-----------------------------------------------------------------------------
+#if defined(QGC_GST_STREAMING)
+void
+VideoReceiver::_updateLatency()
+{
+    if(!_latencyProbe.attached()) {
+        return;
+    }
+    VideoLatencyStatistics statistics = _latencyProbe.takeStatistics();
+    _latencyFactGroup.update(statistics);
+    qCDebug(VideoReceiverLatencyLog) << "fps:receive:decode:render:total:maxTotal:jitter:maxJitter:dropped:lost"
+                                     << statistics.frameRate
+                                     << statistics.receiveMsecs
+                                     << statistics.decodeMsecs
+                                     << statistics.renderMsecs
+                                     << statistics.totalMsecs
+                                     << statistics.maxTotalMsecs
+                                     << statistics.frameJitterMsecs
+                                     << statistics.maxFrameJitterMsecs
+                                     << statistics.droppedFrames
+                                     << statistics.lostPackets;
+}
+#endif
+
 //-----------------------------------------------------------------------------
 void
 VideoReceiver::_updateTimer()
 {
 #if defined(QGC_GST_STREAMING)
+    _updateLatency();
     if(_videoSurface) {
         if(stopping() || starting()) {
             return;
@@ -23,12 +23,14 @@
 #include <QTcpSocket>
 
 #include "VideoSurface.h"
+#include "VideoLatencyFactGroup.h"
 
 #if defined(QGC_GST_STREAMING)
 #include <gst/gst.h>
 #endif
 
 Q_DECLARE_LOGGING_CATEGORY(VideoReceiverLog)
+Q_DECLARE_LOGGING_CATEGORY(VideoReceiverLatencyLog)
 
 class VideoSettings;
 
@@ -44,6 +46,7 @@ public:
     Q_PROPERTY(QString          imageFile           READ    imageFile           NOTIFY  imageFileChanged)
     Q_PROPERTY(QString          videoFile           READ    videoFile           NOTIFY  videoFileChanged)
     Q_PROPERTY(bool             showFullScreen      READ    showFullScreen      WRITE   setShowFullScreen     NOTIFY showFullScreenChanged)
+    Q_PROPERTY(FactGroup*       latency             READ    latency             CONSTANT)
 
     explicit VideoReceiver(QObject* parent = 0);
     ~VideoReceiver();
@@ -61,6 +64,7 @@ public:
     QString         imageFile       () { return _imageFile; }
     QString         videoFile       () { return _videoFile; }
     bool            showFullScreen  () { return _showFullScreen; }
+    FactGroup*      latency         () { return &_latencyFactGroup; }
 
     void            grabImage       (QString imageFile);
 
@@ -124,10 +128,16 @@ private:
     void                        _shutdownPipeline       ();
     void                        _cleanupOldVideos       ();
     void                        _setVideoSink           (GstElement* sink);
+    void                        _configureDisplayBranch (GstElement* queue, GstElement* decoder, GstElement* queue1);
+    void                        _attachLatencyProbe     (GstElement* demux, GstElement* parser, GstElement* decoder, bool rtp);
+    void                        _updateLatency          ();
 
     GstElement*     _pipeline;
     GstElement*     _pipelineStopRec;
     GstElement*     _videoSink;
+    gboolean        _videoSinkSync;         ///< Settings of the sink as handed over, restored by the default profile
+    gboolean        _videoSinkQos;
+    gint64          _videoSinkMaxLateness;
 
     //-- Wait for Video Server to show up before starting
     QTimer          _frameTimer;
@@ -135,6 +145,9 @@ private:
     QTcpSocket*     _socket;
     bool            _serverPresent;
 
+    VideoLatencyProbe   _latencyProbe;
+    bool                _lowLatency;    ///< Pipeline was built with the low latency profile
+
 #endif
 
     QString         _uri;
@@ -144,6 +157,7 @@ private:
     bool            _videoRunning;
     bool            _showFullScreen;
     VideoSettings*  _videoSettings;
+    VideoLatencyFactGroup _latencyFactGroup;
 };
 
 #endif // VIDEORECEIVER_H
@@ -0,0 +1,197 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "HilLockstepProtocol.h"
+
+#include <QtEndian>
+
+#include <string.h>
+
+static const char _stateMagic[4] =     { 'L', 'S', 'S', 'T' };
+static const char _controlsMagic[4] =  { 'L', 'S', 'C', 'T' };
+
+static inline quint8 _readU8(const char* data, int offset)
+{
+    return (quint8)data[offset];
+}
+
+static inline quint32 _readU32(const char* data, int offset)
+{
+    return qFromLittleEndian<quint32>((const uchar*)data + offset);
+}
+
+static inline quint64 _readU64(const char* data, int offset)
+{
+    return qFromLittleEndian<quint64>((const uchar*)data + offset);
+}
+
+static inline float _readFloat(const char* data, int offset)
+{
+    quint32 bits = _readU32(data, offset);
+    float   value;
+
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static inline double _readDouble(const char* data, int offset)
+{
+    quint64 bits = _readU64(data, offset);
+    double  value;
+
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static inline void _writeU8(char* buffer, int offset, quint8 value)
+{
+    buffer[offset] = (char)value;
+}
+
+static inline void _writeU16(char* buffer, int offset, quint16 value)
+{
+    qToLittleEndian<quint16>(value, (uchar*)buffer + offset);
+}
+
+static inline void _writeU32(char* buffer, int offset, quint32 value)
+{
+    qToLittleEndian<quint32>(value, (uchar*)buffer + offset);
+}
+
+static inline void _writeU64(char* buffer, int offset, quint64 value)
+{
+    qToLittleEndian<quint64>(value, (uchar*)buffer + offset);
+}
+
+static inline void _writeFloat(char* buffer, int offset, float value)
+{
+    quint32 bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+    _writeU32(buffer, offset, bits);
+}
+
+static inline void _writeDouble(char* buffer, int offset, double value)
+{
+    quint64 bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+    _writeU64(buffer, offset, bits);
+}
+
+/// @return true: data holds a valid state packet
+bool HilLockstepProtocol::decodeState(const char* data, int length, HilLockstepState& state)
+{
+    if (length != stateSize || memcmp(data, _stateMagic, sizeof(_stateMagic)) != 0 || _readU8(data, 4) != version) {
+        return false;
+    }
+
+    state.gpsValid =        _readU8(data, 5) & stateFlagGpsValid;
+    state.step =            _readU32(data, 8);
+    state.timeUsecs =       _readU64(data, 12);
+    state.xacc =            _readFloat(data, 20);
+    state.yacc =            _readFloat(data, 24);
+    state.zacc =            _readFloat(data, 28);
+    state.xgyro =           _readFloat(data, 32);
+    state.ygyro =           _readFloat(data, 36);
+    state.zgyro =           _readFloat(data, 40);
+    state.xmag =            _readFloat(data, 44);
+    state.ymag =            _readFloat(data, 48);
+    state.zmag =            _readFloat(data, 52);
+    state.absPressure =     _readFloat(data, 56);
+    state.diffPressure =    _readFloat(data, 60);
+    state.pressureAlt =     _readFloat(data, 64);
+    state.temperature =     _readFloat(data, 68);
+    state.latitude =        _readDouble(data, 72);
+    state.longitude =       _readDouble(data, 80);
+    state.altitude =        _readFloat(data, 88);
+    state.vn =              _readFloat(data, 92);
+    state.ve =              _readFloat(data, 96);
+    state.vd =              _readFloat(data, 100);
+    state.eph =             _readFloat(data, 104);
+    state.epv =             _readFloat(data, 108);
+    state.fixType =         _readU8(data, 112);
+    state.satellites =      _readU8(data, 113);
+
+    return true;
+}
+
+/// @param buffer Must hold stateSize bytes
+/// @return Number of bytes written
+int HilLockstepProtocol::encodeState(const HilLockstepState& state, char* buffer)
+{
+    memcpy(buffer, _stateMagic, sizeof(_stateMagic));
+    _writeU8    (buffer, 4,     version);
+    _writeU8    (buffer, 5,     state.gpsValid ? stateFlagGpsValid : 0);
+    _writeU16   (buffer, 6,     0);
+    _writeU32   (buffer, 8,     state.step);
+    _writeU64   (buffer, 12,    state.timeUsecs);
+    _writeFloat (buffer, 20,    state.xacc);
+    _writeFloat (buffer, 24,    state.yacc);
+    _writeFloat (buffer, 28,    state.zacc);
+    _writeFloat (buffer, 32,    state.xgyro);
+    _writeFloat (buffer, 36,    state.ygyro);
+    _writeFloat (buffer, 40,    state.zgyro);
+    _writeFloat (buffer, 44,    state.xmag);
+    _writeFloat (buffer, 48,    state.ymag);
+    _writeFloat (buffer, 52,    state.zmag);
+    _writeFloat (buffer, 56,    state.absPressure);
+    _writeFloat (buffer, 60,    state.diffPressure);
+    _writeFloat (buffer, 64,    state.pressureAlt);
+    _writeFloat (buffer, 68,    state.temperature);
+    _writeDouble(buffer, 72,    state.latitude);
+    _writeDouble(buffer, 80,    state.longitude);
+    _writeFloat (buffer, 88,    state.altitude);
+    _writeFloat (buffer, 92,    state.vn);
+    _writeFloat (buffer, 96,    state.ve);
+    _writeFloat (buffer, 100,   state.vd);
+    _writeFloat (buffer, 104,   state.eph);
+    _writeFloat (buffer, 108,   state.epv);
+    _writeU8    (buffer, 112,   state.fixType);
+    _writeU8    (buffer, 113,   state.satellites);
+    _writeU16   (buffer, 114,   0);
+
+    return stateSize;
+}
+
+/// @return true: data holds a valid controls packet
+bool HilLockstepProtocol::decodeControls(const char* data, int length, HilLockstepControls& controls)
+{
+    if (length != controlsSize || memcmp(data, _controlsMagic, sizeof(_controlsMagic)) != 0 || _readU8(data, 4) != version) {
+        return false;
+    }
+
+    controls.mode =         _readU8(data, 5);
+    controls.step =         _readU32(data, 8);
+    controls.timeUsecs =    _readU64(data, 12);
+    controls.flags =        _readU64(data, 20);
+    for (int i=0; i<16; i++) {
+        controls.controls[i] = _readFloat(data, 28 + (i * 4));
+    }
+
+    return true;
+}
+
+/// @param buffer Must hold controlsSize bytes
+/// @return Number of bytes written
+int HilLockstepProtocol::encodeControls(const HilLockstepControls& controls, char* buffer)
+{
+    memcpy(buffer, _controlsMagic, sizeof(_controlsMagic));
+    _writeU8    (buffer, 4,     version);
+    _writeU8    (buffer, 5,     controls.mode);
+    _writeU16   (buffer, 6,     0);
+    _writeU32   (buffer, 8,     controls.step);
+    _writeU64   (buffer, 12,    controls.timeUsecs);
+    _writeU64   (buffer, 20,    controls.flags);
+    for (int i=0; i<16; i++) {
+        _writeFloat(buffer, 28 + (i * 4), controls.controls[i]);
+    }
+
+    return controlsSize;
+}
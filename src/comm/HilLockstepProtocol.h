@@ -0,0 +1,112 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef HilLockstepProtocol_H
+#define HilLockstepProtocol_H
+
+#include <QtGlobal>
+#include <QMetaType>
+
+/// Simulator state of one lockstep simulation step
+struct HilLockstepState {
+    quint32 step;
+    quint64 timeUsecs;          ///< Simulation time
+    bool    gpsValid;           ///< true: GPS fields hold a new GPS sample
+    float   xacc;               ///< m/s^2, body frame
+    float   yacc;
+    float   zacc;
+    float   xgyro;              ///< rad/s, body frame
+    float   ygyro;
+    float   zgyro;
+    float   xmag;               ///< Gauss, body frame
+    float   ymag;
+    float   zmag;
+    float   absPressure;        ///< hPa
+    float   diffPressure;       ///< hPa
+    float   pressureAlt;        ///< m
+    float   temperature;        ///< degrees C
+    double  latitude;           ///< degrees
+    double  longitude;          ///< degrees
+    float   altitude;           ///< m AMSL
+    float   vn;                 ///< m/s, NED
+    float   ve;
+    float   vd;
+    float   eph;                ///< m
+    float   epv;                ///< m
+    quint8  fixType;
+    quint8  satellites;
+};
+
+/// Autopilot controls answering one lockstep simulation step
+struct HilLockstepControls {
+    quint32 step;
+    quint64 timeUsecs;          ///< Autopilot time the controls were computed at
+    quint64 flags;              ///< HIL_ACTUATOR_CONTROLS flags
+    quint8  mode;               ///< MAV_MODE_FLAG bitmask
+    float   controls[16];       ///< -1..1, throttle 0..1
+};
+
+Q_DECLARE_METATYPE(HilLockstepState)
+
+/// Binary lockstep HIL protocol between QGC and a simulator over UDP, one datagram per packet. All values are little endian.
+///
+/// The simulator sends a state packet for each step and waits for the controls packet with the same step number before
+/// it advances. QGC forwards the state to the autopilot and answers with the controls the autopilot computed from it, so
+/// the simulation runs as fast as the autopilot acknowledges steps.
+///
+///     State packet (simulator -> QGC), stateSize bytes
+///         0   char[4] "LSST"
+///         4   u8      version
+///         5   u8      flags (stateFlagGpsValid)
+///         6   u16     reserved
+///         8   u32     step
+///         12  u64     simulation time in usecs
+///         20  f32[3]  acceleration m/s^2
+///         32  f32[3]  angular rate rad/s
+///         44  f32[3]  magnetic field Gauss
+///         56  f32     absolute pressure hPa
+///         60  f32     differential pressure hPa
+///         64  f32     pressure altitude m
+///         68  f32     temperature C
+///         72  f64     latitude degrees
+///         80  f64     longitude degrees
+///         88  f32     altitude m AMSL
+///         92  f32[3]  velocity NED m/s
+///         104 f32     eph m
+///         108 f32     epv m
+///         112 u8      GPS fix type
+///         113 u8      satellites
+///         114 u16     reserved
+///
+///     Controls packet (QGC -> simulator), controlsSize bytes
+///         0   char[4] "LSCT"
+///         4   u8      version
+///         5   u8      mode
+///         6   u16     reserved
+///         8   u32     step
+///         12  u64     autopilot time in usecs
+///         20  u64     flags
+///         28  f32[16] controls
+///
+/// Encoding and decoding work on caller provided buffers and don't allocate.
+class HilLockstepProtocol
+{
+public:
+    static bool decodeState     (const char* data, int length, HilLockstepState& state);
+    static int  encodeState     (const HilLockstepState& state, char* buffer);
+    static bool decodeControls  (const char* data, int length, HilLockstepControls& controls);
+    static int  encodeControls  (const HilLockstepControls& controls, char* buffer);
+
+    static const quint8 version =               1;
+    static const int    stateSize =             116;
+    static const int    controlsSize =          92;
+    static const quint8 stateFlagGpsValid =     0x01;
+};
+
+#endif
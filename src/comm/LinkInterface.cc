@@ -10,8 +10,8 @@
 #include "LinkInterface.h"
 #include "QGCApplication.h"
 
-/// mavlink channel to use for this link, as used by mavlink_parse_char. The mavlink channel is only
-/// set into the link when it is added to LinkManager
+/// mavlink channel to use for this link, as used by the mavlink_msg_*_pack_chan functions. The mavlink
+/// channel is only set into the link when it is added to LinkManager
 uint8_t LinkInterface::mavlinkChannel(void) const
 {
     if (!_mavlinkChannelSet) {
@@ -41,10 +41,19 @@ LinkInterface::LinkInterface(SharedLinkConfigurationPointer& config)
     memset(_outDataWriteAmounts,0, sizeof(_outDataWriteAmounts));
     memset(_outDataWriteTimes,  0, sizeof(_outDataWriteTimes));
 
+    memset(&_mavlinkTxStatus, 0, sizeof(_mavlinkTxStatus));
+    resetMavlinkReceiveState();
+
     QObject::connect(this, &LinkInterface::_invokeWriteBytes, this, &LinkInterface::_writeBytes);
     qRegisterMetaType<LinkInterface*>("LinkInterface*");
 }
 
+void LinkInterface::resetMavlinkReceiveState(void)
+{
+    memset(&_mavlinkReceiveState, 0, sizeof(_mavlinkReceiveState));
+    _mavlinkReceiveState.status.parse_state = MAVLINK_PARSE_STATE_IDLE;
+}
+
 /// This function logs the send times and amounts of datas for input. Data is used for calculating
 /// the transmission rate.
 ///     @param byteCount Number of bytes received
@@ -112,10 +112,26 @@ public:
         return _getCurrentDataRate(_outDataIndex, _outDataWriteTimes, _outDataWriteAmounts);
     }
     
-    /// mavlink channel to use for this link, as used by mavlink_parse_char. The mavlink channel is only
-    /// set into the link when it is added to LinkManager
+    /// mavlink channel to use for this link, as used by the mavlink_msg_*_pack_chan functions. The mavlink
+    /// channel is only set into the link when it is added to LinkManager
     uint8_t mavlinkChannel(void) const;
 
+    /// MAVLink receive state for this link. Each link owns its own parser so the number of links is not tied to
+    /// the fixed size channel tables of the MAVLink library.
+    struct MavlinkReceiveState {
+        mavlink_message_t   buffer;                 ///< Parser buffer
+        mavlink_status_t    status;                 ///< Parser status
+        int                 totalReceiveCounter;    ///< The total number of successfully received messages
+        int                 totalLossCounter;       ///< Total messages lost during transmission.
+        int                 totalErrorCounter;      ///< Total count of all parsing errors. Generally <= totalLossCounter.
+    };
+
+    MavlinkReceiveState*        mavlinkReceiveState(void)       { return &_mavlinkReceiveState; }
+    const MavlinkReceiveState*  mavlinkReceiveState(void) const { return &_mavlinkReceiveState; }
+
+    /// Resets the parser and counters
+    void resetMavlinkReceiveState(void);
+
     /// Returns whether this link is high latency or not. High latency links should only perform
     /// minimal communication with vehicle.
     ///     signals: highLatencyChanged
@@ -253,7 +269,9 @@ private:
     void _setMavlinkChannel(uint8_t channel);
     
     bool _mavlinkChannelSet;    ///< true: _mavlinkChannel has been set
-    uint8_t _mavlinkChannel;    ///< mavlink channel to use for this link, as used by mavlink_parse_char
+    uint8_t _mavlinkChannel;    ///< mavlink channel to use for this link, as used by mavlink_msg_*_pack_chan
+    mavlink_status_t _mavlinkTxStatus;          ///< Outbound status for _mavlinkChannel
+    MavlinkReceiveState _mavlinkReceiveState;
     
     static const int _dataRateBufferSize = 20; ///< Specify how many data points to capture for data rate calculations.
     
@@ -48,13 +48,20 @@ LinkManager::LinkManager(QGCApplication* app, QGCToolbox* toolbox)
     , _configUpdateSuspended(false)
     , _configurationsLoaded(false)
     , _connectionsSuspended(false)
-    , _mavlinkChannelsUsedBitMask(1)    // We never use channel 0 to avoid sequence numbering problems
+    , _mavlinkChannelsUsed(QGCMAVLink::maxChannels)
     , _autoConnectSettings(NULL)
     , _mavlinkProtocol(NULL)
+#ifndef NO_SERIAL_LINK
+    , _serialPortWatcher(NULL)
+    , _serialPortInfoListDirty(true)
+#endif
 #ifndef __mobile__
     , _nmeaPort(NULL)
 #endif
 {
+    // We never use channel 0 to avoid sequence numbering problems
+    _mavlinkChannelsUsed.setBit(0);
+
     qmlRegisterUncreatableType<LinkManager>         ("QGroundControl", 1, 0, "LinkManager",         "Reference only");
     qmlRegisterUncreatableType<LinkConfiguration>   ("QGroundControl", 1, 0, "LinkConfiguration",   "Reference only");
     qmlRegisterUncreatableType<LinkInterface>       ("QGroundControl", 1, 0, "LinkInterface",       "Reference only");
@@ -64,6 +71,9 @@ LinkManager::LinkManager(QGCApplication* app, QGCToolbox* toolbox)
     _activeLinkCheckTimer.setSingleShot(false);
     connect(&_activeLinkCheckTimer, &QTimer::timeout, this, &LinkManager::_activeLinkCheck);
 #endif
+
+    _portListTimer.setSingleShot(true);
+    connect(&_portListTimer, &QTimer::timeout, this, &LinkManager::_updateAutoConnectLinks);
 }
 
 LinkManager::~LinkManager()
@@ -80,11 +90,63 @@ void LinkManager::setToolbox(QGCToolbox *toolbox)
     _autoConnectSettings = toolbox->settingsManager()->autoConnectSettings();
     _mavlinkProtocol = _toolbox->mavlinkProtocol();
 
-    connect(&_portListTimer, &QTimer::timeout, this, &LinkManager::_updateAutoConnectLinks);
-    _portListTimer.start(_autoconnectUpdateTimerMSecs); // timeout must be long enough to get past bootloader on second pass
+    // Autoconnect passes are event driven: ports coming and going, settings changes and links going away (for UDP re-add).
+    // Passes only repeat on a timer while a port is waiting to get past the bootloader.
+    QList<Fact*> autoConnectFacts;
+    autoConnectFacts << _autoConnectSettings->autoConnectUDP()
+                     << _autoConnectSettings->autoConnectPixhawk()
+                     << _autoConnectSettings->autoConnectSiKRadio()
+                     << _autoConnectSettings->autoConnectPX4Flow()
+                     << _autoConnectSettings->autoConnectRTKGPS()
+                     << _autoConnectSettings->autoConnectLibrePilot()
+                     << _autoConnectSettings->autoConnectNmeaPort()
+                     << _autoConnectSettings->autoConnectNmeaBaud();
+    foreach (Fact* fact, autoConnectFacts) {
+        connect(fact, &Fact::rawValueChanged, this, &LinkManager::_scheduleAutoConnectPass);
+    }
+    connect(this, &LinkManager::linkDeleted, this, &LinkManager::_scheduleAutoConnectPass);
+#ifndef __mobile__
+    connect(_toolbox->gpsManager(), &GPSManager::onDisconnect, this, &LinkManager::_scheduleAutoConnectPass);
+#endif
 
+#ifndef NO_SERIAL_LINK
+    _serialPortWatcher = new SerialPortWatcher(SerialPortWatcher::BackendAuto, this);
+    connect(_serialPortWatcher, &SerialPortWatcher::portAdded,      this, &LinkManager::_serialPortAdded);
+    connect(_serialPortWatcher, &SerialPortWatcher::portRemoved,    this, &LinkManager::_serialPortRemoved);
+    _serialPortWatcher->start();
+#endif
+
+    // First pass must be late enough to get past the bootloader
+    _portListTimer.start(_autoconnectUpdateTimerMSecs);
 }
 
+void LinkManager::_scheduleAutoConnectPass(void)
+{
+    if (!_portListTimer.isActive() || _portListTimer.remainingTime() > 0) {
+        _portListTimer.start(0);
+    }
+}
+
+#ifndef NO_SERIAL_LINK
+void LinkManager::_serialPortAdded(void)
+{
+    _serialPortInfoListDirty = true;
+    _scheduleAutoConnectPass();
+}
+
+void LinkManager::_serialPortRemoved(const QString& systemLocation)
+{
+    for (int i=0; i<_serialPortInfoList.count(); i++) {
+        if (_serialPortInfoList[i].systemLocation() == systemLocation) {
+            _serialPortInfoList.removeAt(i);
+            break;
+        }
+    }
+    _autoconnectWaitList.remove(systemLocation);
+    _scheduleAutoConnectPass();
+}
+#endif
+
 // This should only be used by Qml code
 void LinkManager::createConnectedLink(LinkConfiguration* config)
 {
@@ -181,7 +243,7 @@ void LinkManager::_addLink(LinkInterface* link)
     }
 
     if (!containsLink(link)) {
-        int mavlinkChannel = _reserveMavlinkChannel();
+        int mavlinkChannel = _reserveMavlinkChannel(&link->_mavlinkTxStatus);
         if (mavlinkChannel != 0) {
             link->_setMavlinkChannel(mavlinkChannel);
         } else {
@@ -476,18 +538,25 @@ void LinkManager::_updateAutoConnectLinks(void)
 
 #ifndef NO_SERIAL_LINK
     QStringList currentPorts;
-    QList<QGCSerialPortInfo> portList;
+    bool        bootloaderFound = false;
+    bool        waitingForConnect = false;
 
 #ifdef __android__
     // Android builds only support a single serial connection. Repeatedly calling availablePorts after that one serial
     // port is connected leaks file handles due to a bug somewhere in android serial code. In order to work around that
     // bug after we connect the first serial port we stop probing for additional ports.
-    if (!_sharedAutoconnectConfigurations.count()) {
-        portList = QGCSerialPortInfo::availablePorts();
+    _serialPortWatcher->setPollingEnabled(!_sharedAutoconnectConfigurations.count());
+    if (_sharedAutoconnectConfigurations.count()) {
+        _serialPortInfoList.clear();
+        _serialPortInfoListDirty = false;
     }
-#else
-    portList = QGCSerialPortInfo::availablePorts();
 #endif
+    // Ports are only enumerated again after one shows up, removals are applied to the list directly
+    if (_serialPortInfoListDirty) {
+        _serialPortInfoList = QGCSerialPortInfo::availablePorts();
+        _serialPortInfoListDirty = false;
+    }
+    QList<QGCSerialPortInfo> portList = _serialPortInfoList;
 
     // Iterate Comm Ports
     foreach (QGCSerialPortInfo portInfo, portList) {
@@ -536,6 +605,7 @@ void LinkManager::_updateAutoConnectLinks(void)
             if (portInfo.isBootloader()) {
                 // Don't connect to bootloader
                 qCDebug(LinkManagerLog) << "Waiting for bootloader to finish" << portInfo.systemLocation();
+                bootloaderFound = true;
                 continue;
             }
 
@@ -544,10 +614,14 @@ void LinkManager::_updateAutoConnectLinks(void)
             } else if (!_autoconnectWaitList.contains(portInfo.systemLocation())) {
                 // We don't connect to the port the first time we see it. The ability to correctly detect whether we
                 // are in the bootloader is flaky from a cross-platform standpoint. So by putting it on a wait list
-                // and only connect on the second pass we leave enough time for the board to boot up.
+                // and only connect once it has been there for _autoconnectConnectDelayMSecs we leave enough time for the
+                // board to boot up. Passes can come early (hot-plug events), so the wait is measured and not counted.
                 qCDebug(LinkManagerLog) << "Waiting for next autoconnect pass" << portInfo.systemLocation();
-                _autoconnectWaitList[portInfo.systemLocation()] = 1;
-            } else if (++_autoconnectWaitList[portInfo.systemLocation()] * _autoconnectUpdateTimerMSecs > _autoconnectConnectDelayMSecs) {
+                _autoconnectWaitList[portInfo.systemLocation()].start();
+                waitingForConnect = true;
+            } else if (_autoconnectWaitList[portInfo.systemLocation()].elapsed() < _autoconnectConnectDelayMSecs) {
+                waitingForConnect = true;
+            } else {
                 SerialConfiguration* pSerialConfig = NULL;
 
                 _autoconnectWaitList.remove(portInfo.systemLocation());
@@ -654,6 +728,14 @@ void LinkManager::_updateAutoConnectLinks(void)
 #endif
 
 #endif
+
+    if (bootloaderFound) {
+        // Bootloader detection is based on the port description, which doesn't always change through a hot-plug event
+        _serialPortInfoListDirty = true;
+    }
+    if (bootloaderFound || waitingForConnect) {
+        _portListTimer.start(_autoconnectUpdateTimerMSecs);
+    }
 #endif // NO_SERIAL_LINK
 }
 
@@ -979,16 +1061,16 @@ void LinkManager::startAutoConnectedLinks(void)
     }
 }
 
-int LinkManager::_reserveMavlinkChannel(void)
+int LinkManager::_reserveMavlinkChannel(mavlink_status_t* status)
 {
     // Find a mavlink channel to use for this link, Channel 0 is reserved for internal use.
-    for (int mavlinkChannel=1; mavlinkChannel<32; mavlinkChannel++) {
-        if (!(_mavlinkChannelsUsedBitMask & 1 << mavlinkChannel)) {
-            mavlink_reset_channel_status(mavlinkChannel);
+    for (int mavlinkChannel=1; mavlinkChannel<_mavlinkChannelsUsed.count(); mavlinkChannel++) {
+        if (!_mavlinkChannelsUsed.testBit(mavlinkChannel)) {
+            memset(status, 0, sizeof(*status));
+            QGCMAVLink::setChannelStatus(mavlinkChannel, status);
             // Start the channel on Mav 1 protocol
-            mavlink_status_t* mavlinkStatus = mavlink_get_channel_status(mavlinkChannel);
-            mavlinkStatus->flags |= MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
-            _mavlinkChannelsUsedBitMask |= 1 << mavlinkChannel;
+            status->flags |= MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+            _mavlinkChannelsUsed.setBit(mavlinkChannel);
             return mavlinkChannel;
         }
     }
@@ -998,5 +1080,9 @@ int LinkManager::_reserveMavlinkChannel(void)
 
 void LinkManager::_freeMavlinkChannel(int channel)
 {
-    _mavlinkChannelsUsedBitMask &= ~(1 << channel);
+    if (channel <= 0 || channel >= _mavlinkChannelsUsed.count()) {
+        return;
+    }
+    QGCMAVLink::setChannelStatus(channel, NULL);
+    _mavlinkChannelsUsed.clearBit(channel);
 }
@@ -17,6 +17,8 @@
 #include <QList>
 #include <QMultiMap>
 #include <QMutex>
+#include <QBitArray>
+#include <QElapsedTimer>
 
 #include "LinkConfiguration.h"
 #include "LinkInterface.h"
@@ -31,6 +33,8 @@
 
 #ifndef NO_SERIAL_LINK
     #include "SerialLink.h"
+    #include "SerialPortWatcher.h"
+    #include "QGCSerialPortInfo.h"
 #endif
 
 #ifdef QT_DEBUG
@@ -100,7 +104,7 @@ public:
     void setConnectionsSuspended(QString reason);
 
     /// Sets the flag to allow new connections to be made
-    void setConnectionsAllowed(void) { _connectionsSuspended = false; }
+    void setConnectionsAllowed(void) { _connectionsSuspended = false; _scheduleAutoConnectPass(); }
 
     /// Creates, connects (and adds) a link  based on the given configuration instance.
     /// Link takes ownership of config.
@@ -154,8 +158,9 @@ public:
     void startAutoConnectedLinks(void);
 
     /// Reserves a mavlink channel for use
+    ///     @param status Outbound status for the channel, owned by the caller until the channel is freed
     /// @return Mavlink channel index, 0 for no channels available
-    int _reserveMavlinkChannel(void);
+    int _reserveMavlinkChannel(mavlink_status_t* status);
 
     /// Free the specified mavlink channel for re-use
     void _freeMavlinkChannel(int channel);
@@ -188,8 +193,11 @@ private slots:
     void _linkConnected(void);
     void _linkDisconnected(void);
     void _linkConnectionRemoved(LinkInterface* link);
+    void _scheduleAutoConnectPass(void);
 #ifndef NO_SERIAL_LINK
     void _activeLinkCheck(void);
+    void _serialPortAdded(void);
+    void _serialPortRemoved(const QString& systemLocation);
 #endif
 
 private:
@@ -208,8 +216,8 @@ private:
     bool    _configurationsLoaded;                      ///< true: Link configurations have been loaded
     bool    _connectionsSuspended;                      ///< true: all new connections should not be allowed
     QString _connectionsSuspendedReason;                ///< User visible reason for suspension
-    QTimer  _portListTimer;
-    uint32_t _mavlinkChannelsUsedBitMask;
+    QTimer  _portListTimer;                             ///< Single shot, runs the next autoconnect pass
+    QBitArray _mavlinkChannelsUsed;                     ///< Indexed by mavlink channel
 
     AutoConnectSettings*    _autoConnectSettings;
     MAVLinkProtocol*        _mavlinkProtocol;
@@ -220,13 +228,17 @@ private:
     QString                                 _autoConnectRTKPort;
     QmlObjectListModel                      _qmlConfigurations;
 
-    QMap<QString, int>  _autoconnectWaitList;   ///< key: QGCSerialPortInfo.systemLocation, value: wait count
+    QMap<QString, QElapsedTimer> _autoconnectWaitList;  ///< key: QGCSerialPortInfo.systemLocation, value: time since the port was first seen
     QStringList _commPortList;
     QStringList _commPortDisplayList;
 
 #ifndef NO_SERIAL_LINK
     QTimer              _activeLinkCheckTimer;                  ///< Timer which checks for a vehicle showing up on a usb direct link
     QList<SerialLink*>  _activeLinkCheckList;                   ///< List of links we are waiting for a vehicle to show up on
+
+    SerialPortWatcher*          _serialPortWatcher;             ///< Hot-plug notifications, autoconnect passes only run when ports change
+    QList<QGCSerialPortInfo>    _serialPortInfoList;            ///< Port information as of the last enumeration
+    bool                        _serialPortInfoListDirty;       ///< true: a port was added since the last enumeration
     static const int    _activeLinkCheckTimeoutMSecs = 15000;   ///< Amount of time to wait for a heatbeat. Keep in mind ArduPilot stack heartbeat is slow to come.
 #endif
 
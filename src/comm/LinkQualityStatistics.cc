@@ -0,0 +1,240 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "LinkQualityStatistics.h"
+#include "LinkInterface.h"
+#include "MAVLinkMessageStatistics.h"
+#include "QGCLoggingCategory.h"
+
+QGC_LOGGING_CATEGORY(LinkQualityStatisticsLog, "LinkQualityStatisticsLog")
+
+const double LinkQualityStatistics::_rttLowpass = 0.2;
+
+LinkQualityStatistics::LinkQualityStatistics(QObject* parent)
+    : QObject(parent)
+    , _lastSnapshotUSecs(0)
+{
+    _elapsed.start();
+
+    _snapshotTimer.setInterval(cSnapshotIntervalMSecs);
+    _snapshotTimer.setSingleShot(false);
+    connect(&_snapshotTimer, &QTimer::timeout, this, &LinkQualityStatistics::updateSnapshots);
+    _snapshotTimer.start();
+}
+
+LinkQualityStatistics::Stream& LinkQualityStatistics::_stream(LinkInterface* link, uint8_t sysid, uint8_t compid)
+{
+    StreamKey key = _streamKey(link, sysid, compid);
+
+    QHash<StreamKey, int>::const_iterator iter = _streamIndex.constFind(key);
+    if (iter == _streamIndex.constEnd()) {
+        Stream newStream;
+        memset(&newStream, 0, sizeof(newStream));
+        newStream.link = link;
+        newStream.sysid = sysid;
+        newStream.compid = compid;
+        newStream.lastSeq = -1;
+        newStream.rttMSecs = -1;
+        iter = _streamIndex.insert(key, _streams.count());
+        _streams.append(newStream);
+        qCDebug(LinkQualityStatisticsLog) << "New stream" << link << sysid << compid;
+    }
+
+    return _streams[iter.value()];
+}
+
+int LinkQualityStatistics::update(LinkInterface* link, const mavlink_message_t& message)
+{
+    Stream& stream = _stream(link, message.sysid, message.compid);
+    int lostDelta = 0;
+
+    stream.bytes += MAVLinkMessageStatistics::wireLength(message);
+
+    if (stream.lastSeq == -1) {
+        stream.lastSeq = message.seq;
+        stream.seenMask = 1;
+        stream.received++;
+    } else {
+        uint8_t ahead = (uint8_t)(message.seq - stream.lastSeq);
+
+        if (ahead == 0) {
+            stream.duplicates++;
+        } else if (ahead < 128) {
+            // Newer message, anything skipped is counted as lost until it shows up
+            lostDelta = ahead - 1;
+            stream.lost += lostDelta;
+            stream.seenMask = ahead < _cSeenWindow ? ((stream.seenMask << ahead) | 1) : 1;
+            stream.lastSeq = message.seq;
+            stream.received++;
+        } else {
+            int behind = 256 - ahead;
+            if (behind < _cSeenWindow) {
+                quint64 seenBit = 1ull << behind;
+                if (stream.seenMask & seenBit) {
+                    stream.duplicates++;
+                } else {
+                    stream.seenMask |= seenBit;
+                    stream.reordered++;
+                    stream.received++;
+                    if (stream.lost > 0) {
+                        stream.lost--;
+                        lostDelta = -1;
+                    }
+                }
+            } else {
+                // Too far back to be a late message, the sender most likely restarted its sequence
+                stream.lastSeq = message.seq;
+                stream.seenMask = 1;
+                stream.received++;
+            }
+        }
+    }
+
+    if (message.msgid == MAVLINK_MSG_ID_TIMESYNC) {
+        _updateRtt(stream, message);
+    }
+
+    return lostDelta;
+}
+
+void LinkQualityStatistics::_updateRtt(Stream& stream, const mavlink_message_t& message)
+{
+    mavlink_timesync_t timesync;
+    mavlink_msg_timesync_decode(&message, &timesync);
+
+    if (timesync.tc1 == 0) {
+        // Request from the other side, not a reply
+        return;
+    }
+
+    double rttMSecs = (timesyncTimestamp() - timesync.ts1) / 1.0e6;
+    if (rttMSecs < 0 || rttMSecs > _cMaxRttMSecs) {
+        // Not a reply to one of our requests
+        return;
+    }
+
+    if (stream.rttMSecs < 0) {
+        stream.rttMSecs = rttMSecs;
+    } else {
+        stream.rttMSecs += _rttLowpass * (rttMSecs - stream.rttMSecs);
+    }
+}
+
+void LinkQualityStatistics::removeLink(LinkInterface* link)
+{
+    QVector<Stream> streams;
+
+    _streamIndex.clear();
+    for (int i=0; i<_streams.count(); i++) {
+        const Stream& stream = _streams[i];
+        if (stream.link != link) {
+            _streamIndex.insert(_streamKey(stream.link, stream.sysid, stream.compid), streams.count());
+            streams.append(stream);
+        }
+    }
+    _streams = streams;
+
+    QVector<Snapshot> snapshots;
+
+    _snapshotIndex.clear();
+    for (int i=0; i<_snapshots.count(); i++) {
+        const Snapshot& snapshot = _snapshots[i];
+        if (snapshot.link != link) {
+            _snapshotIndex.insert(_streamKey(snapshot.link, snapshot.sysid, snapshot.compid), snapshots.count());
+            snapshots.append(snapshot);
+        }
+    }
+    _snapshots = snapshots;
+}
+
+void LinkQualityStatistics::updateSnapshots(void)
+{
+    qint64 nowUSecs = _elapsed.nsecsElapsed() / 1000;
+    double elapsedSecs = (nowUSecs - _lastSnapshotUSecs) / 1000000.0;
+    _lastSnapshotUSecs = nowUSecs;
+
+    _snapshots.resize(_streams.count());
+    _snapshotIndex.clear();
+
+    for (int i=0; i<_streams.count(); i++) {
+        Stream&     stream = _streams[i];
+        Snapshot&   snapshot = _snapshots[i];
+
+        // Late arrivals can take back losses from a previous window
+        qint64 windowReceived =     stream.received - stream.windowReceived;
+        qint64 windowLost =         qMax((qint64)stream.lost - (qint64)stream.windowLost, (qint64)0);
+        qint64 windowDuplicates =   stream.duplicates - stream.windowDuplicates;
+        qint64 windowReordered =    stream.reordered - stream.windowReordered;
+        qint64 windowExpected =     windowReceived + windowLost;
+
+        snapshot.link =             stream.link;
+        snapshot.sysid =            stream.sysid;
+        snapshot.compid =           stream.compid;
+        snapshot.received =         stream.received;
+        snapshot.lost =             stream.lost;
+        snapshot.duplicates =       stream.duplicates;
+        snapshot.reordered =        stream.reordered;
+        snapshot.lossPercent =      windowExpected ? (windowLost * 100.0) / windowExpected : 0;
+        snapshot.duplicatePercent = windowReceived ? (windowDuplicates * 100.0) / windowReceived : 0;
+        snapshot.reorderPercent =   windowReceived ? (windowReordered * 100.0) / windowReceived : 0;
+        snapshot.rateHz =           elapsedSecs > 0 ? windowReceived / elapsedSecs : 0;
+        snapshot.bytesPerSecond =   elapsedSecs > 0 ? (stream.bytes - stream.windowBytes) / elapsedSecs : 0;
+        snapshot.rttMSecs =         stream.rttMSecs;
+
+        stream.windowReceived =     stream.received;
+        stream.windowLost =         stream.lost;
+        stream.windowDuplicates =   stream.duplicates;
+        stream.windowReordered =    stream.reordered;
+        stream.windowBytes =        stream.bytes;
+
+        _snapshotIndex.insert(_streamKey(stream.link, stream.sysid, stream.compid), i);
+    }
+
+    emit snapshotsUpdated();
+}
+
+const LinkQualityStatistics::Snapshot* LinkQualityStatistics::snapshot(LinkInterface* link, uint8_t sysid, uint8_t compid) const
+{
+    QHash<StreamKey, int>::const_iterator iter = _snapshotIndex.constFind(_streamKey(link, sysid, compid));
+    if (iter == _snapshotIndex.constEnd()) {
+        return NULL;
+    }
+    return &_snapshots[iter.value()];
+}
+
+QVariantList LinkQualityStatistics::statisticsList(int sysid) const
+{
+    QVariantList list;
+
+    for (int i=0; i<_snapshots.count(); i++) {
+        const Snapshot& snapshot = _snapshots[i];
+
+        if (sysid != 0 && sysid != snapshot.sysid) {
+            continue;
+        }
+
+        QVariantMap map;
+        map[QStringLiteral("link")] = QVariant::fromValue((QObject*)snapshot.link);
+        map[QStringLiteral("sysid")] = snapshot.sysid;
+        map[QStringLiteral("compid")] = snapshot.compid;
+        map[QStringLiteral("received")] = snapshot.received;
+        map[QStringLiteral("lost")] = snapshot.lost;
+        map[QStringLiteral("duplicates")] = snapshot.duplicates;
+        map[QStringLiteral("reordered")] = snapshot.reordered;
+        map[QStringLiteral("lossPercent")] = snapshot.lossPercent;
+        map[QStringLiteral("duplicatePercent")] = snapshot.duplicatePercent;
+        map[QStringLiteral("reorderPercent")] = snapshot.reorderPercent;
+        map[QStringLiteral("rateHz")] = snapshot.rateHz;
+        map[QStringLiteral("bytesPerSecond")] = snapshot.bytesPerSecond;
+        map[QStringLiteral("rttMSecs")] = snapshot.rttMSecs;
+        list.append(map);
+    }
+
+    return list;
+}
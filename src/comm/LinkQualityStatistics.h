@@ -0,0 +1,129 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef LinkQualityStatistics_H
+#define LinkQualityStatistics_H
+
+#include <QObject>
+#include <QHash>
+#include <QPair>
+#include <QVector>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVariant>
+#include <QLoggingCategory>
+
+#include "QGCMAVLink.h"
+
+class LinkInterface;
+
+Q_DECLARE_LOGGING_CATEGORY(LinkQualityStatisticsLog)
+
+/// Link quality statistics per (link, sysid, compid). Sequence numbers are tracked separately for each link, so
+/// redundant links to the same vehicle do not disturb each other. update() is called by MAVLinkProtocol for every
+/// parsed message and only touches counters. Windowed loss/duplicate/reorder percentages and rates are computed
+/// by a timer and published as snapshots every cSnapshotIntervalMSecs.
+class LinkQualityStatistics : public QObject
+{
+    Q_OBJECT
+
+public:
+    LinkQualityStatistics(QObject* parent = NULL);
+
+    Q_PROPERTY(int streamCount READ streamCount NOTIFY snapshotsUpdated)
+
+    static const int cSnapshotIntervalMSecs = 1000;
+
+    /// Published state of one stream. Percentages and rates are over the last snapshot interval.
+    struct Snapshot {
+        LinkInterface*  link;
+        uint8_t         sysid;
+        uint8_t         compid;
+        quint64         received;           ///< Total messages received
+        quint64         lost;               ///< Total messages lost, late arrivals are removed again
+        quint64         duplicates;         ///< Total messages received more than once
+        quint64         reordered;          ///< Total messages which arrived after a later sequence number
+        double          lossPercent;
+        double          duplicatePercent;
+        double          reorderPercent;
+        double          rateHz;
+        double          bytesPerSecond;
+        double          rttMSecs;           ///< Filtered TIMESYNC round trip time, -1 if the component never answered
+    };
+
+    /// Called for each received message. Must be called from the thread the object lives in.
+    ///     @param link Link the message was received on, only used as a key
+    /// @return Change to the number of lost messages caused by this message. Negative for a late arrival of a
+    ///         message which was already counted as lost.
+    int update(LinkInterface* link, const mavlink_message_t& message);
+
+    /// Drops all streams for the specified link
+    void removeLink(LinkInterface* link);
+
+    /// Recomputes the windowed values and publishes new snapshots. Normally called by the internal timer.
+    void updateSnapshots(void);
+
+    /// @return Snapshots as of the last snapshotsUpdated signal
+    const QVector<Snapshot>& snapshots(void) const { return _snapshots; }
+
+    /// @return Snapshot for the specified stream, NULL if not published yet. Pointer is only valid until the next snapshotsUpdated signal.
+    const Snapshot* snapshot(LinkInterface* link, uint8_t sysid, uint8_t compid) const;
+
+    int streamCount(void) const { return _snapshots.count(); }
+
+    /// @return ts1 value to use in an outgoing TIMESYNC request. Replies with this value are used to measure round trip time.
+    int64_t timesyncTimestamp(void) const { return _elapsed.nsecsElapsed() + 1; }
+
+    /// @return List of maps with the snapshot values for each stream, filtered by sysid (0 for all)
+    Q_INVOKABLE QVariantList statisticsList(int sysid = 0) const;
+
+signals:
+    /// Emitted every cSnapshotIntervalMSecs after the snapshots are recomputed
+    void snapshotsUpdated(void);
+
+private:
+    typedef QPair<LinkInterface*, quint16> StreamKey;
+
+    struct Stream {
+        LinkInterface*  link;
+        uint8_t         sysid;
+        uint8_t         compid;
+        int             lastSeq;            ///< Highest sequence number seen, -1 for none
+        quint64         seenMask;           ///< Bit n set: lastSeq - n has been received
+        quint64         received;
+        quint64         lost;
+        quint64         duplicates;
+        quint64         reordered;
+        quint64         bytes;
+        quint64         windowReceived;     ///< Totals at the start of the current window
+        quint64         windowLost;
+        quint64         windowDuplicates;
+        quint64         windowReordered;
+        quint64         windowBytes;
+        double          rttMSecs;
+    };
+
+    static StreamKey _streamKey(LinkInterface* link, uint8_t sysid, uint8_t compid) { return StreamKey(link, (sysid << 8) | compid); }
+    Stream& _stream(LinkInterface* link, uint8_t sysid, uint8_t compid);
+    void _updateRtt(Stream& stream, const mavlink_message_t& message);
+
+    QVector<Stream>         _streams;
+    QHash<StreamKey, int>   _streamIndex;       ///< Key to index into _streams
+    QVector<Snapshot>       _snapshots;
+    QHash<StreamKey, int>   _snapshotIndex;     ///< Key to index into _snapshots
+    QElapsedTimer           _elapsed;
+    qint64                  _lastSnapshotUSecs;
+    QTimer                  _snapshotTimer;
+
+    static const int        _cSeenWindow = 64;          ///< Number of sequence numbers behind the newest which are checked for late arrival
+    static const int        _cMaxRttMSecs = 10000;      ///< TIMESYNC replies older than this are ignored
+    static const double     _rttLowpass;
+};
+
+#endif
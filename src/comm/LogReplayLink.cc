@@ -76,6 +76,7 @@ LogReplayLink::LogReplayLink(SharedLinkConfigurationPointer& config)
     }
 
     _errorTitle = tr("Log Replay Error");
+    _resetLogParser();
     
     _readTickTimer.moveToThread(this);
     
@@ -100,16 +101,11 @@ bool LogReplayLink::_connect(void)
         return false;
     }
 
-    _mavlinkChannel = qgcApp()->toolbox()->linkManager()->_reserveMavlinkChannel();
-    if (_mavlinkChannel == 0) {
-        qWarning() << "No mavlink channels available";
-        return false;
-    }
-
     if (isRunning()) {
         quit();
         wait();
     }
+    _resetLogParser();
     start(HighPriority);
     return true;
 }
@@ -121,10 +117,6 @@ void LogReplayLink::_disconnect(void)
         wait();
         _connected = false;
 
-        if (_mavlinkChannel != 0) {
-            qgcApp()->toolbox()->linkManager()->_freeMavlinkChannel(_mavlinkChannel);
-        }
-
         emit disconnected();
     }
 }
@@ -160,6 +152,14 @@ void LogReplayLink::_writeBytes(const QByteArray bytes)
     Q_UNUSED(bytes);
 }
 
+/// Resets the parser used to read messages from the log file. Log replay does not use a mavlink channel for parsing.
+void LogReplayLink::_resetLogParser(void)
+{
+    memset(&_logParserBuffer, 0, sizeof(_logParserBuffer));
+    memset(&_logParserStatus, 0, sizeof(_logParserStatus));
+    _logParserStatus.parse_state = MAVLINK_PARSE_STATE_IDLE;
+}
+
 /// Parses a BigEndian quint64 timestamp
 /// @return A Unix timestamp in microseconds UTC for found message or 0 if parsing failed
 quint64 LogReplayLink::_parseTimestamp(const QByteArray& bytes)
@@ -188,7 +188,7 @@ quint64 LogReplayLink::_readNextMavlinkMessage(QByteArray& bytes)
 
     while (_logFile.getChar(&nextByte)) { // Loop over every byte
         mavlink_message_t message;
-        bool messageFound = mavlink_parse_char(_mavlinkChannel, nextByte, &message, &status);
+        bool messageFound = QGCMAVLink::parseChar(&_logParserBuffer, &_logParserStatus, nextByte, &message, &status);
 
         if (status.parse_state == MAVLINK_PARSE_STATE_GOT_STX) {
             // This is the possible beginning of a mavlink message, clear any partial bytes
@@ -216,7 +216,7 @@ quint64 LogReplayLink::_seekToNextMavlinkMessage(mavlink_message_t* nextMsg)
     qint64              messageStartPos = -1;
 
     while (_logFile.getChar(&nextByte)) { // Loop over every byte
-        bool messageFound = mavlink_parse_char(_mavlinkChannel, nextByte, nextMsg, &status);
+        bool messageFound = QGCMAVLink::parseChar(&_logParserBuffer, &_logParserStatus, nextByte, nextMsg, &status);
 
         if (status.parse_state == MAVLINK_PARSE_STATE_GOT_STX) {
             // This is the possible beginning of a mavlink message
@@ -113,6 +113,7 @@ private:
 
     void _replayError(const QString& errorMsg);
     quint64 _parseTimestamp(const QByteArray& bytes);
+    void _resetLogParser(void);
     quint64 _seekToNextMavlinkMessage(mavlink_message_t* nextMsg);
     quint64 _readNextMavlinkMessage(QByteArray& bytes);
     bool _loadLogFile(void);
@@ -130,9 +131,11 @@ private:
     LogReplayLinkConfiguration* _logReplayConfig;
 
     bool    _connected;
-    int     _mavlinkChannel;
     QTimer  _readTickTimer;      ///< Timer which signals a read of next log record
 
+    mavlink_message_t   _logParserBuffer;   ///< Parser buffer for reading messages from the log file
+    mavlink_status_t    _logParserStatus;   ///< Parser status for reading messages from the log file
+
     QString _errorTitle; ///< Title for communicatorError signals
 
     quint64 _logCurrentTimeUSecs;   ///< The timestamp of the next message in the log file.
@@ -0,0 +1,298 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkMessageStatistics.h"
+#include "QGCLoggingCategory.h"
+
+#include <QFile>
+#include <QTextStream>
+#include <QStringList>
+#include <QtNumeric>
+#include <QDebug>
+
+QGC_LOGGING_CATEGORY(MAVLinkMessageStatisticsLog, "MAVLinkMessageStatisticsLog")
+
+const double MAVLinkMessageStatistics::_intervalLowpass = 0.05;
+
+MAVLinkMessageStatistics::MAVLinkMessageStatistics(QObject* parent)
+    : QObject(parent)
+    , _lastRateUpdateUSecs(0)
+{
+    _elapsed.start();
+
+    _rateTimer.setInterval(cRateIntervalMSecs);
+    _rateTimer.setSingleShot(false);
+    connect(&_rateTimer, &QTimer::timeout, this, &MAVLinkMessageStatistics::_updateRates);
+    _rateTimer.start();
+}
+
+int MAVLinkMessageStatistics::wireLength(const mavlink_message_t& message)
+{
+    int length = message.len;
+
+    if (message.magic == MAVLINK_STX_MAVLINK1) {
+        length += MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1 + 2;
+    } else {
+        length += MAVLINK_NUM_NON_PAYLOAD_BYTES;
+        if (message.incompat_flags & MAVLINK_IFLAG_SIGNED) {
+            length += MAVLINK_SIGNATURE_BLOCK_LEN;
+        }
+    }
+
+    return length;
+}
+
+void MAVLinkMessageStatistics::update(const mavlink_message_t& message)
+{
+    quint64 key = _statsKey(message.sysid, message.compid, message.msgid);
+    qint64 nowUSecs = _elapsed.nsecsElapsed() / 1000;
+
+    QHash<quint64, int>::const_iterator iter = _statsIndex.constFind(key);
+    if (iter == _statsIndex.constEnd()) {
+        MessageStats newStats;
+        memset(&newStats, 0, sizeof(newStats));
+        newStats.sysid = message.sysid;
+        newStats.compid = message.compid;
+        newStats.msgid = message.msgid;
+        newStats.lastReceiveUSecs = nowUSecs;
+        iter = _statsIndex.insert(key, _stats.count());
+        _stats.append(newStats);
+        qCDebug(MAVLinkMessageStatisticsLog) << "New message" << message.sysid << message.compid << message.msgid;
+    }
+
+    MessageStats& stats = _stats[iter.value()];
+
+    if (stats.count != 0) {
+        double intervalMSecs = (nowUSecs - stats.lastReceiveUSecs) / 1000.0;
+        if (stats.count == 1) {
+            stats.meanIntervalMSecs = intervalMSecs;
+        } else {
+            stats.meanIntervalMSecs += _intervalLowpass * (intervalMSecs - stats.meanIntervalMSecs);
+        }
+        double deviationMSecs = qAbs(intervalMSecs - stats.meanIntervalMSecs);
+        stats.jitterMSecs += _intervalLowpass * (deviationMSecs - stats.jitterMSecs);
+
+        int bin = 0;
+        while (bin < cJitterBins - 1 && deviationMSecs >= jitterBinUpperMSecs(bin)) {
+            bin++;
+        }
+        stats.jitterHistogram[bin]++;
+    }
+
+    stats.count++;
+    stats.bytes += wireLength(message);
+    stats.lastReceiveUSecs = nowUSecs;
+    stats.lastMessage = message;
+}
+
+double MAVLinkMessageStatistics::jitterBinUpperMSecs(int bin)
+{
+    static const double binUpperMSecs[cJitterBins] = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 0 };
+
+    if (bin < 0 || bin >= cJitterBins - 1) {
+        return qInf();
+    }
+    return binUpperMSecs[bin];
+}
+
+void MAVLinkMessageStatistics::_updateRates(void)
+{
+    qint64 nowUSecs = _elapsed.nsecsElapsed() / 1000;
+    double elapsedSecs = (nowUSecs - _lastRateUpdateUSecs) / 1000000.0;
+    _lastRateUpdateUSecs = nowUSecs;
+
+    if (elapsedSecs <= 0) {
+        return;
+    }
+
+    for (int i=0; i<_stats.count(); i++) {
+        MessageStats& stats = _stats[i];
+
+        stats.rateHz = (stats.count - stats.rateCount) / elapsedSecs;
+        stats.bytesPerSecond = (stats.bytes - stats.rateBytes) / elapsedSecs;
+        stats.rateCount = stats.count;
+        stats.rateBytes = stats.bytes;
+    }
+
+    emit statisticsUpdated();
+}
+
+const MAVLinkMessageStatistics::MessageStats* MAVLinkMessageStatistics::stats(uint8_t sysid, uint8_t compid, uint32_t msgid) const
+{
+    QHash<quint64, int>::const_iterator iter = _statsIndex.constFind(_statsKey(sysid, compid, msgid));
+    if (iter == _statsIndex.constEnd()) {
+        return NULL;
+    }
+    return &_stats[iter.value()];
+}
+
+void MAVLinkMessageStatistics::clear(void)
+{
+    _stats.clear();
+    _statsIndex.clear();
+    emit statisticsUpdated();
+}
+
+QString MAVLinkMessageStatistics::fieldTypeName(const mavlink_field_info_t& fieldInfo)
+{
+    static const char* typeNames[] = { "char", "uint8_t", "int8_t", "uint16_t", "int16_t", "uint32_t", "int32_t", "uint64_t", "int64_t", "float", "double" };
+
+    QString typeName;
+    if (fieldInfo.type < sizeof(typeNames) / sizeof(typeNames[0])) {
+        typeName = typeNames[fieldInfo.type];
+    }
+    if (fieldInfo.array_length > 0 && fieldInfo.type != MAVLINK_TYPE_CHAR) {
+        typeName += QString("[%1]").arg(fieldInfo.array_length);
+    }
+    return typeName;
+}
+
+template <typename T>
+static QVariant _fieldValue(const uint8_t* data, unsigned int arrayLength)
+{
+    if (arrayLength == 0) {
+        T value;
+        memcpy(&value, data, sizeof(T));
+        return QVariant::fromValue(value);
+    }
+
+    QStringList values;
+    for (unsigned int i=0; i<arrayLength; i++) {
+        T value;
+        memcpy(&value, data + (i * sizeof(T)), sizeof(T));
+        values.append(QString::number(value));
+    }
+    return values.join(QStringLiteral(", "));
+}
+
+QVariant MAVLinkMessageStatistics::fieldValue(const mavlink_message_t& message, const mavlink_field_info_t& fieldInfo)
+{
+    const uint8_t* data = (const uint8_t*)&message.payload64[0] + fieldInfo.wire_offset;
+
+    switch (fieldInfo.type) {
+    case MAVLINK_TYPE_CHAR:
+        if (fieldInfo.array_length > 0) {
+            return QString::fromLatin1((const char*)data, qstrnlen((const char*)data, fieldInfo.array_length));
+        }
+        return QString(QChar::fromLatin1(*(const char*)data));
+    case MAVLINK_TYPE_UINT8_T:
+        return _fieldValue<uint8_t>(data, fieldInfo.array_length);
+    case MAVLINK_TYPE_INT8_T:
+        return _fieldValue<int8_t>(data, fieldInfo.array_length);
+    case MAVLINK_TYPE_UINT16_T:
+        return _fieldValue<uint16_t>(data, fieldInfo.array_length);
+    case MAVLINK_TYPE_INT16_T:
+        return _fieldValue<int16_t>(data, fieldInfo.array_length);
+    case MAVLINK_TYPE_UINT32_T:
+        return _fieldValue<uint32_t>(data, fieldInfo.array_length);
+    case MAVLINK_TYPE_INT32_T:
+        return _fieldValue<int32_t>(data, fieldInfo.array_length);
+    case MAVLINK_TYPE_UINT64_T:
+        return _fieldValue<quint64>(data, fieldInfo.array_length);
+    case MAVLINK_TYPE_INT64_T:
+        return _fieldValue<qint64>(data, fieldInfo.array_length);
+    case MAVLINK_TYPE_FLOAT:
+        return _fieldValue<float>(data, fieldInfo.array_length);
+    case MAVLINK_TYPE_DOUBLE:
+        return _fieldValue<double>(data, fieldInfo.array_length);
+    }
+
+    return QVariant();
+}
+
+QVariantList MAVLinkMessageStatistics::messageList(int sysid, int compid) const
+{
+    QVariantList list;
+
+    for (int i=0; i<_stats.count(); i++) {
+        const MessageStats& stats = _stats[i];
+
+        if ((sysid != 0 && sysid != stats.sysid) || (compid != 0 && compid != stats.compid)) {
+            continue;
+        }
+
+        const mavlink_message_info_t* msgInfo = mavlink_get_message_info(&stats.lastMessage);
+
+        QVariantMap map;
+        map[QStringLiteral("sysid")] = stats.sysid;
+        map[QStringLiteral("compid")] = stats.compid;
+        map[QStringLiteral("msgid")] = stats.msgid;
+        map[QStringLiteral("name")] = msgInfo ? QString(msgInfo->name) : QString::number(stats.msgid);
+        map[QStringLiteral("count")] = stats.count;
+        map[QStringLiteral("bytes")] = stats.bytes;
+        map[QStringLiteral("rateHz")] = stats.rateHz;
+        map[QStringLiteral("bytesPerSecond")] = stats.bytesPerSecond;
+        map[QStringLiteral("meanIntervalMSecs")] = stats.meanIntervalMSecs;
+        map[QStringLiteral("jitterMSecs")] = stats.jitterMSecs;
+        QVariantList histogram;
+        for (int bin=0; bin<cJitterBins; bin++) {
+            histogram.append(stats.jitterHistogram[bin]);
+        }
+        map[QStringLiteral("jitterHistogram")] = histogram;
+        list.append(map);
+    }
+
+    return list;
+}
+
+QVariantMap MAVLinkMessageStatistics::decodeMessage(int sysid, int compid, int msgid) const
+{
+    QVariantMap map;
+
+    const MessageStats* msgStats = stats(sysid, compid, msgid);
+    if (msgStats) {
+        const mavlink_message_info_t* msgInfo = mavlink_get_message_info(&msgStats->lastMessage);
+        if (msgInfo) {
+            for (unsigned int i=0; i<msgInfo->num_fields; i++) {
+                map[msgInfo->fields[i].name] = fieldValue(msgStats->lastMessage, msgInfo->fields[i]);
+            }
+        }
+    }
+
+    return map;
+}
+
+bool MAVLinkMessageStatistics::exportToCSV(const QString& filename) const
+{
+    QFile file(filename);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning() << "MAVLinkMessageStatistics::exportToCSV unable to open file" << filename << file.errorString();
+        return false;
+    }
+
+    QTextStream stream(&file);
+
+    stream << "sysid,compid,msgid,name,count,bytes,rate_hz,bytes_per_second,mean_interval_ms,jitter_ms";
+    for (int bin=0; bin<cJitterBins; bin++) {
+        if (bin == cJitterBins - 1) {
+            stream << QString(",jitter_ge_%1ms").arg(jitterBinUpperMSecs(bin - 1));
+        } else {
+            stream << QString(",jitter_lt_%1ms").arg(jitterBinUpperMSecs(bin));
+        }
+    }
+    stream << "\n";
+
+    for (int i=0; i<_stats.count(); i++) {
+        const MessageStats& stats = _stats[i];
+        const mavlink_message_info_t* msgInfo = mavlink_get_message_info(&stats.lastMessage);
+
+        stream << (int)stats.sysid << "," << (int)stats.compid << "," << stats.msgid << ","
+               << (msgInfo ? msgInfo->name : "") << ","
+               << stats.count << "," << stats.bytes << ","
+               << stats.rateHz << "," << stats.bytesPerSecond << ","
+               << stats.meanIntervalMSecs << "," << stats.jitterMSecs;
+        for (int bin=0; bin<cJitterBins; bin++) {
+            stream << "," << stats.jitterHistogram[bin];
+        }
+        stream << "\n";
+    }
+
+    return stream.status() == QTextStream::Ok;
+}
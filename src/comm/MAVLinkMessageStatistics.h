@@ -0,0 +1,113 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef MAVLinkMessageStatistics_H
+#define MAVLinkMessageStatistics_H
+
+#include <QObject>
+#include <QHash>
+#include <QVector>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVariant>
+#include <QLoggingCategory>
+
+#include "QGCMAVLink.h"
+
+Q_DECLARE_LOGGING_CATEGORY(MAVLinkMessageStatisticsLog)
+
+/// Collects per (sysid, compid, msgid) receive statistics. update() is called by MAVLinkProtocol
+/// for every parsed message and only touches counters, so it is cheap enough to always run.
+/// Rates are computed from the counters by a 1 Hz timer and message payloads are only decoded
+/// when asked for (inspector view, QML).
+class MAVLinkMessageStatistics : public QObject
+{
+    Q_OBJECT
+
+public:
+    MAVLinkMessageStatistics(QObject* parent = NULL);
+
+    Q_PROPERTY(int messageTypeCount READ messageTypeCount NOTIFY statisticsUpdated)
+
+    static const int cJitterBins = 10;      ///< Number of inter-arrival jitter histogram bins
+    static const int cRateIntervalMSecs = 1000;
+
+    struct MessageStats {
+        uint8_t             sysid;
+        uint8_t             compid;
+        uint32_t            msgid;
+        quint64             count;                          ///< Total messages received
+        quint64             bytes;                          ///< Total bytes on the wire, including header and checksum
+        quint64             rateCount;                      ///< count at last rate update
+        quint64             rateBytes;                      ///< bytes at last rate update
+        double              rateHz;
+        double              bytesPerSecond;
+        qint64              lastReceiveUSecs;               ///< Receive time of lastMessage, relative to collector start
+        double              meanIntervalMSecs;              ///< Low pass filtered inter-arrival time
+        double              jitterMSecs;                    ///< Low pass filtered deviation from meanIntervalMSecs
+        quint32             jitterHistogram[cJitterBins];   ///< Counts of deviation from meanIntervalMSecs, see jitterBinUpperMSecs
+        mavlink_message_t   lastMessage;
+    };
+
+    /// Called for each received message. Must be called from the thread the object lives in.
+    void update(const mavlink_message_t& message);
+
+    /// @return Statistics for the specified message, NULL if not seen yet. Pointer is only valid until the next update call.
+    const MessageStats* stats(uint8_t sysid, uint8_t compid, uint32_t msgid) const;
+
+    /// @return All collected statistics. Reference is only valid until the next update call.
+    const QVector<MessageStats>& allStats(void) const { return _stats; }
+
+    int messageTypeCount(void) const { return _stats.count(); }
+
+    /// @return Number of bytes the message took on the wire, including header, checksum and signature
+    static int wireLength(const mavlink_message_t& message);
+
+    /// Upper bound in milliseconds for each jitter histogram bin, the last bin is open ended
+    static double jitterBinUpperMSecs(int bin);
+
+    /// Decodes a single field of a message
+    ///     @return Field value, arrays are returned as a comma separated string
+    static QVariant fieldValue(const mavlink_message_t& message, const mavlink_field_info_t& fieldInfo);
+
+    /// @return Field type as a string, for example "uint16_t[8]"
+    static QString fieldTypeName(const mavlink_field_info_t& fieldInfo);
+
+    /// @return List of maps with the statistics for each message, filtered by sysid/compid (0 for all)
+    Q_INVOKABLE QVariantList messageList(int sysid = 0, int compid = 0) const;
+
+    /// @return Map of field name to value for the last received instance of the specified message
+    Q_INVOKABLE QVariantMap decodeMessage(int sysid, int compid, int msgid) const;
+
+    /// Writes the statistics as CSV
+    ///     @return false: unable to write file
+    Q_INVOKABLE bool exportToCSV(const QString& filename) const;
+
+    Q_INVOKABLE void clear(void);
+
+signals:
+    /// Emitted at cRateIntervalMSecs after rates are recomputed
+    void statisticsUpdated(void);
+
+private slots:
+    void _updateRates(void);
+
+private:
+    static quint64 _statsKey(uint8_t sysid, uint8_t compid, uint32_t msgid) { return ((quint64)sysid << 32) | ((quint64)compid << 24) | (msgid & 0xFFFFFF); }
+
+    QVector<MessageStats>   _stats;
+    QHash<quint64, int>     _statsIndex;        ///< Key to index into _stats
+    QElapsedTimer           _elapsed;
+    qint64                  _lastRateUpdateUSecs;
+    QTimer                  _rateTimer;
+
+    static const double     _intervalLowpass;
+};
+
+#endif
@@ -60,15 +60,11 @@ MAVLinkProtocol::MAVLinkProtocol(QGCApplication* app, QGCToolbox* toolbox)
     , _logSuspendError(false)
     , _logSuspendReplay(false)
     , _vehicleWasArmed(false)
+    , _timesyncEnabled(false)
     , _tempLogFile(QString("%2.%3").arg(_tempLogFileTemplate).arg(_logFileExtension))
     , _linkMgr(NULL)
     , _multiVehicleManager(NULL)
 {
-    memset(&totalReceiveCounter, 0, sizeof(totalReceiveCounter));
-    memset(&totalLossCounter, 0, sizeof(totalLossCounter));
-    memset(&totalErrorCounter, 0, sizeof(totalErrorCounter));
-    memset(&currReceiveCounter, 0, sizeof(currReceiveCounter));
-    memset(&currLossCounter, 0, sizeof(currLossCounter));
 }
 
 MAVLinkProtocol::~MAVLinkProtocol()
@@ -106,17 +102,8 @@ void MAVLinkProtocol::setToolbox(QGCToolbox *toolbox)
 
    loadSettings();
 
-   // All the *Counter variables are not initialized here, as they should be initialized
-   // on a per-link basis before those links are used. @see resetMetadataForLink().
-
-   // Initialize the list for tracking dropped messages to invalid.
-   for (int i = 0; i < 256; i++)
-   {
-       for (int j = 0; j < 256; j++)
-       {
-           lastIndex[i][j] = -1;
-       }
-   }
+   // The receive counters are owned by each link and initialized before those links are used.
+   // @see resetMetadataForLink().
 
    connect(this, &MAVLinkProtocol::protocolStatusMessage,   _app, &QGCApplication::criticalMessageBoxOnMainThread);
    connect(this, &MAVLinkProtocol::saveTelemetryLog,        _app, &QGCApplication::saveTelemetryLogOnMainThread);
@@ -125,7 +112,11 @@ void MAVLinkProtocol::setToolbox(QGCToolbox *toolbox)
    connect(_multiVehicleManager, &MultiVehicleManager::vehicleAdded, this, &MAVLinkProtocol::_vehicleCountChanged);
    connect(_multiVehicleManager, &MultiVehicleManager::vehicleRemoved, this, &MAVLinkProtocol::_vehicleCountChanged);
 
+   connect(_linkMgr, &LinkManager::linkDeleted, &_linkStatistics, &LinkQualityStatistics::removeLink);
+   connect(&_linkStatistics, &LinkQualityStatistics::snapshotsUpdated, this, &MAVLinkProtocol::_linkStatisticsUpdated);
+
    emit versionCheckChanged(m_enable_version_check);
+   emit timesyncChanged(_timesyncEnabled);
 }
 
 void MAVLinkProtocol::loadSettings()
@@ -134,6 +125,7 @@ void MAVLinkProtocol::loadSettings()
     QSettings settings;
     settings.beginGroup("QGC_MAVLINK_PROTOCOL");
     enableVersionCheck(settings.value("VERSION_CHECK_ENABLED", m_enable_version_check).toBool());
+    enableTimesync(settings.value("TIMESYNC_ENABLED", _timesyncEnabled).toBool());
 
     // Only set system id if it was valid
     int temp = settings.value("GCS_SYSTEM_ID", systemId).toInt();
@@ -149,19 +141,16 @@ void MAVLinkProtocol::storeSettings()
     QSettings settings;
     settings.beginGroup("QGC_MAVLINK_PROTOCOL");
     settings.setValue("VERSION_CHECK_ENABLED", m_enable_version_check);
+    settings.setValue("TIMESYNC_ENABLED", _timesyncEnabled);
     settings.setValue("GCS_SYSTEM_ID", systemId);
     // Parameter interface settings
 }
 
 void MAVLinkProtocol::resetMetadataForLink(LinkInterface *link)
 {
-    int channel = link->mavlinkChannel();
-    totalReceiveCounter[channel] = 0;
-    totalLossCounter[channel] = 0;
-    totalErrorCounter[channel] = 0;
-    currReceiveCounter[channel] = 0;
-    currLossCounter[channel] = 0;
+    link->resetMavlinkReceiveState();
     link->setDecodedFirstMavlinkPacket(false);
+    _linkStatistics.removeLink(link);
 }
 
 /**
@@ -185,13 +174,16 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, QByteArray b)
     mavlink_status_t status;
 
     int mavlinkChannel = link->mavlinkChannel();
+    LinkInterface::MavlinkReceiveState* receiveState = link->mavlinkReceiveState();
 
     static int nonmavlinkCount = 0;
     static bool checkedUserNonMavlink = false;
     static bool warnedUserNonMavlink = false;
 
     for (int position = 0; position < b.size(); position++) {
-        unsigned int decodeState = mavlink_parse_char(mavlinkChannel, (uint8_t)(b[position]), &message, &status);
+        unsigned int decodeState = QGCMAVLink::parseChar(&receiveState->buffer, &receiveState->status, (uint8_t)(b[position]), &message, &status);
+
+        receiveState->totalErrorCounter += status.packet_rx_drop_count;
 
         if (decodeState == 0 && !link->decodedFirstMavlinkPacket())
         {
@@ -221,7 +213,7 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, QByteArray b)
             if (!link->decodedFirstMavlinkPacket()) {
                 link->setDecodedFirstMavlinkPacket(true);
                 mavlink_status_t* mavlinkStatus = mavlink_get_channel_status(mavlinkChannel);
-                if (!(mavlinkStatus->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1) && (mavlinkStatus->flags & MAVLINK_STATUS_FLAG_OUT_MAVLINK1)) {
+                if (!(receiveState->status.flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1) && (mavlinkStatus->flags & MAVLINK_STATUS_FLAG_OUT_MAVLINK1)) {
                     qDebug() << "Switching outbound to mavlink 2.0 due to incoming mavlink 2.0 packet:" << mavlinkStatus << mavlinkChannel << mavlinkStatus->flags;
                     mavlinkStatus->flags &= ~MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
 
@@ -283,7 +275,7 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, QByteArray b)
             // Detect if we are talking to an old radio not supporting v2
             mavlink_status_t* mavlinkStatus = mavlink_get_channel_status(mavlinkChannel);
             if (message.msgid == MAVLINK_MSG_ID_RADIO_STATUS) {
-                if ((mavlinkStatus->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1)
+                if ((receiveState->status.flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1)
                 && !(mavlinkStatus->flags & MAVLINK_STATUS_FLAG_OUT_MAVLINK1)) {
 
                     _radio_version_mismatch_count++;
@@ -301,47 +293,13 @@ void MAVLinkProtocol::receiveBytes(LinkInterface* link, QByteArray b)
             }
 
             // Increase receive counter
-            totalReceiveCounter[mavlinkChannel]++;
-            currReceiveCounter[mavlinkChannel]++;
-
-            // Determine what the next expected sequence number is, accounting for
-            // never having seen a message for this system/component pair.
-            int lastSeq = lastIndex[message.sysid][message.compid];
-            int expectedSeq = (lastSeq == -1) ? message.seq : (lastSeq + 1);
-
-            // And if we didn't encounter that sequence number, record the error
-            if (message.seq != expectedSeq)
-            {
+            receiveState->totalReceiveCounter++;
 
-                // Determine how many messages were skipped
-                int lostMessages = message.seq - expectedSeq;
+            // Sequence tracking is per link, so redundant links to the same vehicle don't count each other's messages as lost.
+            // Loss percentages are published by _linkStatistics at a fixed rate.
+            receiveState->totalLossCounter += _linkStatistics.update(link, message);
 
-                // Out of order messages or wraparound can cause this, but we just ignore these conditions for simplicity
-                if (lostMessages < 0)
-                {
-                    lostMessages = 0;
-                }
-
-                // And log how many were lost for all time and just this timestep
-                totalLossCounter[mavlinkChannel] += lostMessages;
-                currLossCounter[mavlinkChannel] += lostMessages;
-            }
-
-            // And update the last sequence number for this system/component pair
-            lastIndex[message.sysid][message.compid] = expectedSeq;
-
-            // Update on every 32th packet
-            if ((totalReceiveCounter[mavlinkChannel] & 0x1F) == 0)
-            {
-                // Calculate new loss ratio
-                // Receive loss
-                float receiveLossPercent = (double)currLossCounter[mavlinkChannel]/(double)(currReceiveCounter[mavlinkChannel]+currLossCounter[mavlinkChannel]);
-                receiveLossPercent *= 100.0f;
-                currLossCounter[mavlinkChannel] = 0;
-                currReceiveCounter[mavlinkChannel] = 0;
-                emit receiveLossPercentChanged(message.sysid, receiveLossPercent);
-                emit receiveLossTotalChanged(message.sysid, totalLossCounter[mavlinkChannel]);
-            }
+            _messageStatistics.update(message);
 
             // The packet is emitted as a whole, as it is only 255 - 261 bytes short
             // kind of inefficient, but no issue for a groundstation pc.
@@ -382,6 +340,12 @@ void MAVLinkProtocol::enableVersionCheck(bool enabled)
     emit versionCheckChanged(enabled);
 }
 
+void MAVLinkProtocol::enableTimesync(bool enabled)
+{
+    _timesyncEnabled = enabled;
+    emit timesyncChanged(enabled);
+}
+
 void MAVLinkProtocol::_vehicleCountChanged(void)
 {
     int count = _multiVehicleManager->vehicles()->count();
@@ -392,6 +356,51 @@ void MAVLinkProtocol::_vehicleCountChanged(void)
     }
 }
 
+/// Publishes the loss of the best link to each system and, if enabled, sends TIMESYNC requests which
+/// LinkQualityStatistics uses to measure round trip time
+void MAVLinkProtocol::_linkStatisticsUpdated(void)
+{
+    const QVector<LinkQualityStatistics::Snapshot>& snapshots = _linkStatistics.snapshots();
+    QMap<int, const LinkQualityStatistics::Snapshot*> bestSnapshots;
+
+    for (int i=0; i<snapshots.count(); i++) {
+        const LinkQualityStatistics::Snapshot* snapshot = &snapshots[i];
+        if (snapshot->rateHz <= 0) {
+            // Stream has gone quiet during the last window
+            continue;
+        }
+        const LinkQualityStatistics::Snapshot* bestSnapshot = bestSnapshots.value(snapshot->sysid, NULL);
+        if (!bestSnapshot || snapshot->lossPercent < bestSnapshot->lossPercent) {
+            bestSnapshots[snapshot->sysid] = snapshot;
+        }
+    }
+
+    for (QMap<int, const LinkQualityStatistics::Snapshot*>::const_iterator iter = bestSnapshots.constBegin(); iter != bestSnapshots.constEnd(); iter++) {
+        emit receiveLossPercentChanged(iter.key(), iter.value()->lossPercent);
+        emit receiveLossTotalChanged(iter.key(), iter.value()->lost);
+    }
+
+    if (!_timesyncEnabled) {
+        return;
+    }
+
+    QList<LinkInterface*> links = _linkMgr->links();
+    for (int i=0; i<links.count(); i++) {
+        LinkInterface* link = links[i];
+
+        if (!link->isConnected() || !link->decodedFirstMavlinkPacket() || link->highLatency()) {
+            continue;
+        }
+
+        mavlink_message_t   message;
+        uint8_t             buffer[MAVLINK_MAX_PACKET_LEN];
+
+        mavlink_msg_timesync_pack_chan(getSystemId(), getComponentId(), link->mavlinkChannel(), &message, 0, _linkStatistics.timesyncTimestamp());
+        int len = mavlink_msg_to_send_buffer(buffer, &message);
+        link->writeBytesSafe((const char*)buffer, len);
+    }
+}
+
 /// @brief Closes the log file if it is open
 bool MAVLinkProtocol::_closeLogFile(void)
 {
@@ -24,6 +24,8 @@
 #include "QGC.h"
 #include "QGCTemporaryFile.h"
 #include "QGCToolbox.h"
+#include "MAVLinkMessageStatistics.h"
+#include "LinkQualityStatistics.h"
 
 class LinkManager;
 class MultiVehicleManager;
@@ -57,6 +59,10 @@ public:
     bool versionCheckEnabled() const {
         return m_enable_version_check;
     }
+    /** @brief Get state of TIMESYNC requests used to measure link round trip time */
+    bool timesyncEnabled() const {
+        return _timesyncEnabled;
+    }
     /** @brief Get the protocol version */
     int getVersion() {
         return MAVLINK_VERSION;
@@ -70,27 +76,33 @@ public:
      * @returns -1 if this is not available for this protocol, # of packets otherwise.
      */
     qint32 getReceivedPacketCount(const LinkInterface *link) const {
-        return totalReceiveCounter[link->mavlinkChannel()];
+        return link->mavlinkReceiveState()->totalReceiveCounter;
     }
     /**
      * Retrieve a total of all parsing errors for the specified link.
      * @returns -1 if this is not available for this protocol, # of errors otherwise.
      */
     qint32 getParsingErrorCount(const LinkInterface *link) const {
-        return totalErrorCounter[link->mavlinkChannel()];
+        return link->mavlinkReceiveState()->totalErrorCounter;
     }
     /**
      * Retrieve a total of all dropped packets for the specified link.
      * @returns -1 if this is not available for this protocol, # of packets otherwise.
      */
     qint32 getDroppedPacketCount(const LinkInterface *link) const {
-        return totalLossCounter[link->mavlinkChannel()];
+        return link->mavlinkReceiveState()->totalLossCounter;
     }
     /**
      * Reset the counters for all metadata for this link.
      */
     virtual void resetMetadataForLink(LinkInterface *link);
     
+    /// Per message receive statistics for all links
+    MAVLinkMessageStatistics* messageStatistics(void) { return &_messageStatistics; }
+
+    /// Loss/duplicate/reorder/rate/latency statistics per link, system and component
+    LinkQualityStatistics* linkStatistics(void) { return &_linkStatistics; }
+
     /// Suspend/Restart logging during replay.
     void suspendLogForReplay(bool suspend);
 
@@ -110,6 +122,9 @@ public slots:
     /** @brief Enable / disable version check */
     void enableVersionCheck(bool enabled);
 
+    /** @brief Enable / disable sending TIMESYNC requests on each link with the link statistics */
+    void enableTimesync(bool enabled);
+
     /** @brief Load protocol settings */
     void loadSettings();
     /** @brief Store protocol settings */
@@ -124,12 +139,6 @@ public slots:
 protected:
     bool m_enable_version_check; ///< Enable checking of version match of MAV and QGC
     QMutex receiveMutex;        ///< Mutex to protect receiveBytes function
-    int lastIndex[256][256];    ///< Store the last received sequence ID for each system/componenet pair
-    int totalReceiveCounter[MAVLINK_COMM_NUM_BUFFERS];    ///< The total number of successfully received messages
-    int totalLossCounter[MAVLINK_COMM_NUM_BUFFERS];       ///< Total messages lost during transmission.
-    int totalErrorCounter[MAVLINK_COMM_NUM_BUFFERS];      ///< Total count of all parsing errors. Generally <= totalLossCounter.
-    int currReceiveCounter[MAVLINK_COMM_NUM_BUFFERS];     ///< Received messages during this sample time window. Used for calculating loss %.
-    int currLossCounter[MAVLINK_COMM_NUM_BUFFERS];        ///< Lost messages during this sample time window. Used for calculating loss %.
     bool versionMismatchIgnore;
     int systemId;
     unsigned _current_version;
@@ -143,13 +152,16 @@ signals:
     void messageReceived(LinkInterface* link, mavlink_message_t message);
     /** @brief Emitted if version check is enabled / disabled */
     void versionCheckChanged(bool enabled);
+    /** @brief Emitted if TIMESYNC requests are enabled / disabled */
+    void timesyncChanged(bool enabled);
     /** @brief Emitted if a message from the protocol should reach the user */
     void protocolStatusMessage(const QString& title, const QString& message);
     /** @brief Emitted if a new system ID was set */
     void systemIdChanged(int systemId);
 
+    /// Emitted at LinkQualityStatistics::cSnapshotIntervalMSecs with the values of the best link to the system
     void receiveLossPercentChanged(int uasId, float lossPercent);
-    void receiveLossTotalChanged(int uasId, int totalLoss);
+    void receiveLossTotalChanged(int uasId, quint64 totalLoss);
 
     /**
      * @brief Emitted if a new radio status packet received
@@ -173,6 +185,7 @@ signals:
 
 private slots:
     void _vehicleCountChanged(void);
+    void _linkStatisticsUpdated(void);
     
 private:
     bool _closeLogFile(void);
@@ -182,6 +195,7 @@ private:
     bool _logSuspendError;      ///< true: Logging suspended due to error
     bool _logSuspendReplay;     ///< true: Logging suspended due to replay
     bool _vehicleWasArmed;      ///< true: Vehicle was armed during log sequence
+    bool _timesyncEnabled;      ///< true: Send TIMESYNC requests to measure round trip time
 
     QGCTemporaryFile    _tempLogFile;            ///< File to log to
     static const char*  _tempLogFileTemplate;    ///< Template for temporary log file
@@ -189,6 +203,9 @@ private:
 
     LinkManager*            _linkMgr;
     MultiVehicleManager*    _multiVehicleManager;
+
+    MAVLinkMessageStatistics _messageStatistics;
+    LinkQualityStatistics   _linkStatistics;
 };
 
 #endif // MAVLINKPROTOCOL_H_
@@ -11,6 +11,7 @@
 #include "MockLink.h"
 #include "QGCLoggingCategory.h"
 #include "QGCApplication.h"
+#include "QGC.h"
 
 #ifdef UNITTEST_BUILD
 #include "UnitTest.h"
@@ -46,6 +47,9 @@ const char* MockConfiguration::_vehicleTypeKey =    "VehicleType";
 const char* MockConfiguration::_sendStatusTextKey = "SendStatusText";
 const char* MockConfiguration::_highLatencyKey =    "HighLatency";
 const char* MockConfiguration::_failureModeKey =    "FailureMode";
+const char* MockConfiguration::_swarmVehicleCountKey =  "SwarmVehicleCount";
+const char* MockConfiguration::_swarmSeedKey =          "SwarmSeed";
+const char* MockConfiguration::_swarmMessageMixKey =    "SwarmMessageMix";
 
 MockLink::MockLink(SharedLinkConfigurationPointer& config)
     : LinkInterface                         (config)
@@ -65,8 +69,10 @@ MockLink::MockLink(SharedLinkConfigurationPointer& config)
     , _vehicleLongitude                     (_defaultVehicleLongitude + ((_vehicleSystemId - 128) * 0.0001))
     , _vehicleAltitude                      (_defaultVehicleAltitude)
     , _fileServer                           (NULL)
+    , _swarm                                (NULL)
     , _sendStatusText                       (false)
     , _apmSendHomePositionOnEmptyList       (false)
+    , _telemetryPaused                      (false)
     , _failureMode                          (MockConfiguration::FailNone)
     , _sendHomePositionDelayCount           (10)    // No home position for 4 seconds
     , _sendGPSPositionDelayCount            (100)   // No gps lock for 5 seconds
@@ -96,6 +102,16 @@ MockLink::MockLink(SharedLinkConfigurationPointer& config)
 
     _loadParams();
 
+    if (mockConfig->swarmVehicleCount() > 0) {
+        _swarm = new MockLinkSwarm(this,
+                                   _nextVehicleSystemId,
+                                   mockConfig->swarmVehicleCount(),
+                                   mockConfig->swarmSeed(),
+                                   MockLinkSwarm::config((MockLinkSwarm::MessageMix_t)mockConfig->swarmMessageMix()));
+        _nextVehicleSystemId += _swarm->vehicleCount();
+        qCDebug(MockLinkLog) << "Swarm vehicles" << _swarm->firstSystemId() << "to" << _nextVehicleSystemId - 1;
+    }
+
     _adsbVehicleCoordinate = QGeoCoordinate(_vehicleLatitude, _vehicleLongitude).atDistanceAndAzimuth(1000, _adsbAngle);
     _adsbVehicleCoordinate.setAltitude(100);
 }
@@ -103,6 +119,7 @@ MockLink::MockLink(SharedLinkConfigurationPointer& config)
 MockLink::~MockLink(void)
 {
     _disconnect();
+    delete _swarm;
     if (!_logDownloadFilename.isEmpty()) {
         QFile::remove(_logDownloadFilename);
     }
@@ -112,14 +129,16 @@ bool MockLink::_connect(void)
 {
     if (!_connected) {
         _connected = true;
-        _mavlinkChannel = qgcApp()->toolbox()->linkManager()->_reserveMavlinkChannel();
+        _mavlinkChannel = qgcApp()->toolbox()->linkManager()->_reserveMavlinkChannel(&_vehicleMavlinkTxStatus);
         if (_mavlinkChannel == 0) {
             qWarning() << "No mavlink channels available";
             return false;
         }
         // MockLinks use Mavlink 2.0
-        mavlink_status_t* mavlinkStatus = mavlink_get_channel_status(_mavlinkChannel);
-        mavlinkStatus->flags &= ~MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+        _vehicleMavlinkTxStatus.flags &= ~MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+        memset(&_mavlinkRxBuffer, 0, sizeof(_mavlinkRxBuffer));
+        memset(&_mavlinkRxStatus, 0, sizeof(_mavlinkRxStatus));
+        _mavlinkRxStatus.parse_state = MAVLINK_PARSE_STATE_IDLE;
         start();
         emit connected();
     }
@@ -165,7 +184,7 @@ void MockLink::run(void)
 
 void MockLink::_run1HzTasks(void)
 {
-    if (_mavlinkStarted && _connected) {
+    if (_mavlinkStarted && _connected && !_telemetryPaused) {
         if (_highLatency) {
             _sendHighLatency2();
         } else {
@@ -197,6 +216,9 @@ void MockLink::_run10HzTasks(void)
 
     if (_mavlinkStarted && _connected) {
         _sendHeartBeat();
+        if (_telemetryPaused) {
+            return;
+        }
         if (_sendGPSPositionDelayCount > 0) {
             // We delay gps position for better testing
             _sendGPSPositionDelayCount--;
@@ -215,6 +237,9 @@ void MockLink::_run500HzTasks(void)
     if (_mavlinkStarted && _connected) {
         _paramRequestListWorker();
         _logDownloadWorker();
+        if (_swarm && !_telemetryPaused) {
+            _swarm->run();
+        }
     }
 }
 
@@ -423,7 +448,15 @@ void MockLink::_handleIncomingMavlinkBytes(const uint8_t* bytes, int cBytes)
 
     for (qint64 i=0; i<cBytes; i++)
     {
-        if (!mavlink_parse_char(_mavlinkChannel, bytes[i], &msg, &comm)) {
+        if (!QGCMAVLink::parseChar(&_mavlinkRxBuffer, &_mavlinkRxStatus, bytes[i], &msg, &comm)) {
+            continue;
+        }
+
+        _receivedMessageCountsMutex.lock();
+        _receivedMessageCounts[msg.msgid]++;
+        _receivedMessageCountsMutex.unlock();
+
+        if (_swarm && _swarm->handleMessage(msg)) {
             continue;
         }
 
@@ -472,12 +505,23 @@ void MockLink::_handleIncomingMavlinkBytes(const uint8_t* bytes, int cBytes)
             _handleLogRequestData(msg);
             break;
 
+        case MAVLINK_MSG_ID_TIMESYNC:
+            _handleTimesync(msg);
+            break;
+
         default:
             break;
         }
     }
 }
 
+int MockLink::receivedMessageCount(uint32_t msgid)
+{
+    QMutexLocker locker(&_receivedMessageCountsMutex);
+
+    return _receivedMessageCounts.value(msgid, 0);
+}
+
 void MockLink::_handleHeartBeat(const mavlink_message_t& msg)
 {
     Q_UNUSED(msg);
@@ -1067,6 +1111,9 @@ MockConfiguration::MockConfiguration(const QString& name)
     , _sendStatusText   (false)
     , _highLatency      (false)
     , _failureMode      (FailNone)
+    , _swarmVehicleCount(0)
+    , _swarmSeed        (0)
+    , _swarmMessageMix  (MockLinkSwarm::MessageMixTypical)
 {
 
 }
@@ -1074,11 +1121,14 @@ MockConfiguration::MockConfiguration(const QString& name)
 MockConfiguration::MockConfiguration(MockConfiguration* source)
     : LinkConfiguration(source)
 {
-    _firmwareType =     source->_firmwareType;
-    _vehicleType =      source->_vehicleType;
-    _sendStatusText =   source->_sendStatusText;
-    _highLatency =      source->_highLatency;
-    _failureMode =      source->_failureMode;
+    _firmwareType =       source->_firmwareType;
+    _vehicleType =        source->_vehicleType;
+    _sendStatusText =     source->_sendStatusText;
+    _highLatency =        source->_highLatency;
+    _failureMode =        source->_failureMode;
+    _swarmVehicleCount =  source->_swarmVehicleCount;
+    _swarmSeed =          source->_swarmSeed;
+    _swarmMessageMix =    source->_swarmMessageMix;
 }
 
 void MockConfiguration::copyFrom(LinkConfiguration *source)
@@ -1091,11 +1141,14 @@ void MockConfiguration::copyFrom(LinkConfiguration *source)
         return;
     }
 
-    _firmwareType =     usource->_firmwareType;
-    _vehicleType =      usource->_vehicleType;
-    _sendStatusText =   usource->_sendStatusText;
-    _highLatency =      usource->_highLatency;
-    _failureMode =      usource->_failureMode;
+    _firmwareType =       usource->_firmwareType;
+    _vehicleType =        usource->_vehicleType;
+    _sendStatusText =     usource->_sendStatusText;
+    _highLatency =        usource->_highLatency;
+    _failureMode =        usource->_failureMode;
+    _swarmVehicleCount =  usource->_swarmVehicleCount;
+    _swarmSeed =          usource->_swarmSeed;
+    _swarmMessageMix =    usource->_swarmMessageMix;
 }
 
 void MockConfiguration::saveSettings(QSettings& settings, const QString& root)
@@ -1106,6 +1159,9 @@ void MockConfiguration::saveSettings(QSettings& settings, const QString& root)
     settings.setValue(_sendStatusTextKey, _sendStatusText);
     settings.setValue(_highLatencyKey, _highLatency);
     settings.setValue(_failureModeKey, (int)_failureMode);
+    settings.setValue(_swarmVehicleCountKey, _swarmVehicleCount);
+    settings.setValue(_swarmSeedKey, _swarmSeed);
+    settings.setValue(_swarmMessageMixKey, _swarmMessageMix);
     settings.sync();
     settings.endGroup();
 }
@@ -1118,6 +1174,9 @@ void MockConfiguration::loadSettings(QSettings& settings, const QString& root)
     _sendStatusText = settings.value(_sendStatusTextKey, false).toBool();
     _highLatency = settings.value(_highLatencyKey, false).toBool();
     _failureMode = (FailureMode_t)settings.value(_failureModeKey, (int)FailNone).toInt();
+    _swarmVehicleCount = settings.value(_swarmVehicleCountKey, 0).toInt();
+    _swarmSeed = settings.value(_swarmSeedKey, 0).toInt();
+    _swarmMessageMix = settings.value(_swarmMessageMixKey, (int)MockLinkSwarm::MessageMixTypical).toInt();
     settings.endGroup();
 }
 
@@ -1203,6 +1262,20 @@ MockLink*  MockLink::startAPMArduSubMockLink(bool sendStatusText, MockConfigurat
     return _startMockLink(mockConfig);
 }
 
+MockLink*  MockLink::startSwarmMockLink(int swarmVehicleCount, int seed, MockLinkSwarm::MessageMix_t messageMix)
+{
+    MockConfiguration* mockConfig = new MockConfiguration("Swarm MockLink");
+
+    mockConfig->setFirmwareType(MAV_AUTOPILOT_GENERIC);
+    mockConfig->setVehicleType(MAV_TYPE_QUADROTOR);
+    mockConfig->setSendStatusText(false);
+    mockConfig->setSwarmVehicleCount(swarmVehicleCount);
+    mockConfig->setSwarmSeed(seed);
+    mockConfig->setSwarmMessageMix(messageMix);
+
+    return _startMockLink(mockConfig);
+}
+
 void MockLink::_sendRCChannels(void)
 {
     mavlink_message_t   msg;
@@ -1282,6 +1355,28 @@ void MockLink::_handleLogRequestList(const mavlink_message_t& msg)
     respondWithMavlinkMessage(responseMsg);
 }
 
+/// Answers TIMESYNC requests the way PX4 does
+void MockLink::_handleTimesync(const mavlink_message_t& msg)
+{
+    mavlink_timesync_t request;
+
+    mavlink_msg_timesync_decode(&msg, &request);
+
+    if (request.tc1 != 0) {
+        // Reply to a request of ours, we never send any
+        return;
+    }
+
+    mavlink_message_t responseMsg;
+    mavlink_msg_timesync_pack_chan(_vehicleSystemId,
+                                   _vehicleComponentId,
+                                   _mavlinkChannel,
+                                   &responseMsg,
+                                   (int64_t)QGC::groundTimeUsecs() * 1000,  // tc1
+                                   request.ts1);                    // ts1
+    respondWithMavlinkMessage(responseMsg);
+}
+
 void MockLink::_handleLogRequestData(const mavlink_message_t& msg)
 {
     mavlink_log_request_data_t request;
@@ -12,11 +12,15 @@
 #define MOCKLINK_H
 
 #include <QMap>
+#include <QMutex>
 #include <QLoggingCategory>
 #include <QGeoCoordinate>
 
+#include <atomic>
+
 #include "MockLinkMissionItemHandler.h"
 #include "MockLinkFileServer.h"
+#include "MockLinkSwarm.h"
 #include "LinkManager.h"
 #include "QGCMAVLink.h"
 
@@ -33,6 +37,9 @@ public:
     Q_PROPERTY(int      vehicle     READ vehicle            WRITE setVehicle        NOTIFY vehicleChanged)
     Q_PROPERTY(bool     sendStatus  READ sendStatusText     WRITE setSendStatusText NOTIFY sendStatusChanged)
     Q_PROPERTY(bool     highLatency READ highLatency        WRITE setHighLatency    NOTIFY highLatencyChanged)
+    Q_PROPERTY(int      swarmVehicleCount   READ swarmVehicleCount  WRITE setSwarmVehicleCount  NOTIFY swarmChanged)
+    Q_PROPERTY(int      swarmSeed           READ swarmSeed          WRITE setSwarmSeed          NOTIFY swarmChanged)
+    Q_PROPERTY(int      swarmMessageMix     READ swarmMessageMix    WRITE setSwarmMessageMix    NOTIFY swarmChanged)
 
     // QML Access
     int     firmware        () { return (int)_firmwareType; }
@@ -55,6 +62,18 @@ public:
     bool sendStatusText(void) { return _sendStatusText; }
     void setSendStatusText(bool sendStatusText) { _sendStatusText = sendStatusText; emit sendStatusChanged(); }
 
+    /// @param swarmVehicleCount Additional lightweight vehicles simulated on the link for load testing, 0 for none
+    int swarmVehicleCount(void) const { return _swarmVehicleCount; }
+    void setSwarmVehicleCount(int swarmVehicleCount) { _swarmVehicleCount = swarmVehicleCount; emit swarmChanged(); }
+
+    /// @param swarmSeed Seed for the swarm motion, the same seed gives the same messages
+    int swarmSeed(void) const { return _swarmSeed; }
+    void setSwarmSeed(int swarmSeed) { _swarmSeed = swarmSeed; emit swarmChanged(); }
+
+    /// @param swarmMessageMix MockLinkSwarm::MessageMix_t
+    int swarmMessageMix(void) const { return _swarmMessageMix; }
+    void setSwarmMessageMix(int swarmMessageMix) { _swarmMessageMix = swarmMessageMix; emit swarmChanged(); }
+
     typedef enum {
         FailNone,                           // No failures
         FailParamNoReponseToRequestList,    // Do no respond to PARAM_REQUEST_LIST
@@ -77,6 +96,7 @@ signals:
     void vehicleChanged     ();
     void sendStatusChanged  ();
     void highLatencyChanged ();
+    void swarmChanged       ();
 
 private:
     MAV_AUTOPILOT   _firmwareType;
@@ -84,12 +104,18 @@ private:
     bool            _sendStatusText;
     bool            _highLatency;
     FailureMode_t   _failureMode;
+    int             _swarmVehicleCount;
+    int             _swarmSeed;
+    int             _swarmMessageMix;
 
     static const char* _firmwareTypeKey;
     static const char* _vehicleTypeKey;
     static const char* _sendStatusTextKey;
     static const char* _highLatencyKey;
     static const char* _failureModeKey;
+    static const char* _swarmVehicleCountKey;
+    static const char* _swarmSeedKey;
+    static const char* _swarmMessageMixKey;
 };
 
 class MockLink : public LinkInterface
@@ -120,6 +146,19 @@ public:
 
     MockLinkFileServer* getFileServer(void) { return _fileServer; }
 
+    /// @return Swarm simulated on this link, NULL for none
+    MockLinkSwarm* swarm(void) { return _swarm; }
+
+    /// @return Channel the vehicle side of the link packs its messages on
+    uint8_t vehicleMavlinkChannel(void) const { return _mavlinkChannel; }
+
+    /// @return Number of messages with the specified id received from QGC over this link
+    int receivedMessageCount(uint32_t msgid);
+
+    /// Stops the periodic telemetry of the link vehicle and the swarm, only the heartbeat of the link vehicle keeps going.
+    /// Responses to requests from QGC are still sent.
+    void setTelemetryPaused(bool paused) { _telemetryPaused = paused; }
+
     // Virtuals from LinkInterface
     virtual QString getName(void) const { return _name; }
     virtual void requestReset(void){ }
@@ -157,6 +196,9 @@ public:
     static MockLink* startAPMArduPlaneMockLink   (bool sendStatusText, MockConfiguration::FailureMode_t failureMode = MockConfiguration::FailNone);
     static MockLink* startAPMArduSubMockLink     (bool sendStatusText, MockConfiguration::FailureMode_t failureMode = MockConfiguration::FailNone);
 
+    /// Starts a generic vehicle link which also simulates swarmVehicleCount swarm vehicles
+    static MockLink* startSwarmMockLink          (int swarmVehicleCount, int seed = 0, MockLinkSwarm::MessageMix_t messageMix = MockLinkSwarm::MessageMixTypical);
+
 private slots:
     virtual void _writeBytes(const QByteArray bytes);
 
@@ -190,6 +232,7 @@ private:
     void _handlePreFlightCalibration(const mavlink_command_long_t& request);
     void _handleLogRequestList(const mavlink_message_t& msg);
     void _handleLogRequestData(const mavlink_message_t& msg);
+    void _handleTimesync(const mavlink_message_t& msg);
     float _floatUnionForParam(int componentId, const QString& paramName);
     void _setParamFloatUnionIntoMap(int componentId, const QString& paramName, float paramFloat);
     void _sendHomePosition(void);
@@ -211,6 +254,13 @@ private:
     bool    _connected;
     int     _mavlinkChannel;
 
+    mavlink_status_t    _vehicleMavlinkTxStatus;    ///< Outbound status for _mavlinkChannel
+    mavlink_message_t   _mavlinkRxBuffer;           ///< Parser buffer for bytes sent to the vehicle
+    mavlink_status_t    _mavlinkRxStatus;           ///< Parser status for bytes sent to the vehicle
+
+    QMutex              _receivedMessageCountsMutex;
+    QMap<uint32_t, int> _receivedMessageCounts;     ///< Messages received from QGC by message id
+
     uint8_t _vehicleSystemId;
     uint8_t _vehicleComponentId;
 
@@ -231,9 +281,11 @@ private:
     double              _vehicleAltitude;
 
     MockLinkFileServer* _fileServer;
+    MockLinkSwarm*      _swarm;
 
     bool _sendStatusText;
     bool _apmSendHomePositionOnEmptyList;
+    std::atomic_bool _telemetryPaused;
     MockConfiguration::FailureMode_t _failureMode;
 
     int _sendHomePositionDelayCount;
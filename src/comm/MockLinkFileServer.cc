@@ -10,6 +10,7 @@
 
 #include "MockLinkFileServer.h"
 #include "MockLink.h"
+#include "QGC.h"
 
 const MockLinkFileServer::ErrorMode_t MockLinkFileServer::rgFailureModes[] = {
     MockLinkFileServer::errModeNoResponse,
@@ -29,10 +30,8 @@ const MockLinkFileServer::FileTestCase MockLinkFileServer::rgFileTestCases[MockL
     { "multi.qgc",      sizeof(((FileManager::Request*)0)->data) + 1,     2,    false },
 };
 
-// We only support a single fixed session
-const uint8_t MockLinkFileServer::_sessionId = 1;
-
 MockLinkFileServer::MockLinkFileServer(uint8_t systemIdServer, uint8_t componentIdServer, MockLink* mockLink) :
+    _maxSessions(FileManager::maxDownloadSessions),
     _errMode(errModeNone),
     _systemIdServer(systemIdServer),
     _componentIdServer(componentIdServer),
@@ -128,10 +127,11 @@ void MockLinkFileServer::_openCommand(uint8_t senderSystemId, uint8_t senderComp
     // Check path against one of our known test cases
 
     bool found = false;
+    uint32_t fileLength = 0;
     for (size_t i=0; i<cFileTestCases; i++) {
         if (path == rgFileTestCases[i].filename) {
             found = true;
-            _readFileLength = rgFileTestCases[i].length;
+            fileLength = rgFileTestCases[i].length;
             break;
         }
     }
@@ -140,13 +140,25 @@ void MockLinkFileServer::_openCommand(uint8_t senderSystemId, uint8_t senderComp
         return;
     }
     
+    if (_sessions.count() >= _maxSessions) {
+        _sendNak(senderSystemId, senderComponentId, FileManager::kErrNoSessionsAvailable, outgoingSeqNumber, FileManager::kCmdOpenFileRO);
+        return;
+    }
+    
+    // Hand out the lowest free session id, so ids get reused the same way they are on the vehicle
+    uint8_t session = 1;
+    while (_sessions.contains(session)) {
+        session++;
+    }
+    _sessions[session] = fileLength;
+    
     response.hdr.opcode = FileManager::kRspAck;
 	response.hdr.req_opcode = FileManager::kCmdOpenFileRO;
-    response.hdr.session = _sessionId;
+    response.hdr.session = session;
     
     // Data contains file length
     response.hdr.size = sizeof(uint32_t);
-    response.openFileLength = _readFileLength;
+    response.openFileLength = fileLength;
     
     _sendResponse(senderSystemId, senderComponentId, &response, outgoingSeqNumber);
 }
@@ -156,11 +168,13 @@ void MockLinkFileServer::_readCommand(uint8_t senderSystemId, uint8_t senderComp
     FileManager::Request	response;
     uint16_t				outgoingSeqNumber = _nextSeqNumber(seqNumber);
 
-    if (request->hdr.session != _sessionId) {
-		_sendNak(senderSystemId, senderComponentId, FileManager::kErrFail, outgoingSeqNumber, FileManager::kCmdReadFile);
+    if (!_sessions.contains(request->hdr.session)) {
+		_sendNak(senderSystemId, senderComponentId, FileManager::kErrInvalidSession, outgoingSeqNumber, FileManager::kCmdReadFile, request->hdr.session);
         return;
     }
     
+    uint8_t session = request->hdr.session;
+    uint32_t fileLength = _sessions[session];
     uint32_t readOffset = request->hdr.offset;  // offset into file for reading
     uint8_t cDataBytes = 0;                     // current number of data bytes used
     
@@ -168,7 +182,7 @@ void MockLinkFileServer::_readCommand(uint8_t senderSystemId, uint8_t senderComp
         // If we get here it means the client is requesting additional data past the first request
         if (_errMode == errModeNakSecondResponse) {
             // Nak error all subsequent requests
-            _sendNak(senderSystemId, senderComponentId, FileManager::kErrFail, outgoingSeqNumber, FileManager::kCmdReadFile);
+            _sendNak(senderSystemId, senderComponentId, FileManager::kErrFail, outgoingSeqNumber, FileManager::kCmdReadFile, session);
             return;
         } else if (_errMode == errModeNoSecondResponse) {
             // No rsponse for all subsequent requests
@@ -176,20 +190,20 @@ void MockLinkFileServer::_readCommand(uint8_t senderSystemId, uint8_t senderComp
         }
     }
     
-    if (readOffset >= _readFileLength) {
-        _sendNak(senderSystemId, senderComponentId, FileManager::kErrEOF, outgoingSeqNumber, FileManager::kCmdReadFile);
+    if (readOffset >= fileLength) {
+        _sendNak(senderSystemId, senderComponentId, FileManager::kErrEOF, outgoingSeqNumber, FileManager::kCmdReadFile, session);
         return;
     }
     
     // Write file bytes. Data is a repeating sequence of 0x00, 0x01, .. 0xFF.
-    for (; cDataBytes < sizeof(response.data) && readOffset < _readFileLength; readOffset++, cDataBytes++) {
+    for (; cDataBytes < sizeof(response.data) && readOffset < fileLength; readOffset++, cDataBytes++) {
         response.data[cDataBytes] = readOffset & 0xFF;
     }
     
     // We should always have written something, otherwise there is something wrong with the code above
     Q_ASSERT(cDataBytes);
     
-    response.hdr.session = _sessionId;
+    response.hdr.session = session;
     response.hdr.size = cDataBytes;
     response.hdr.offset = request->hdr.offset;
     response.hdr.opcode = FileManager::kRspAck;
@@ -203,23 +217,26 @@ void MockLinkFileServer::_streamCommand(uint8_t senderSystemId, uint8_t senderCo
     uint16_t                outgoingSeqNumber = _nextSeqNumber(seqNumber);
     FileManager::Request    response;
 
-    if (request->hdr.session != _sessionId) {
-		_sendNak(senderSystemId, senderComponentId, FileManager::kErrFail, outgoingSeqNumber, FileManager::kCmdBurstReadFile);
+    if (!_sessions.contains(request->hdr.session)) {
+		_sendNak(senderSystemId, senderComponentId, FileManager::kErrInvalidSession, outgoingSeqNumber, FileManager::kCmdBurstReadFile, request->hdr.session);
         return;
     }
     
-    uint32_t readOffset = 0;	// offset into file for reading
-    uint32_t ackOffset = 0;     // offset for ack
+    uint8_t session = request->hdr.session;
+    uint32_t fileLength = _sessions[session];
+    uint32_t readOffset = request->hdr.offset;	// offset into file for reading, bursts pick up where the request asks for
+    uint32_t ackOffset;         // offset for ack
     uint8_t cDataAck;           // number of bytes in ack
     
-    while (readOffset < _readFileLength) {
+    while (readOffset < fileLength) {
         cDataAck = 0;
+        ackOffset = readOffset;
         
         if (readOffset != 0) {
             // If we get here it means the client is requesting additional data past the first request
             if (_errMode == errModeNakSecondResponse) {
                 // Nak error all subsequent requests
-                _sendNak(senderSystemId, senderComponentId, FileManager::kErrFail, outgoingSeqNumber, FileManager::kCmdBurstReadFile);
+                _sendNak(senderSystemId, senderComponentId, FileManager::kErrFail, outgoingSeqNumber, FileManager::kCmdBurstReadFile, session);
                 return;
             } else if (_errMode == errModeNoSecondResponse) {
                 // No response for all subsequent requests
@@ -228,38 +245,77 @@ void MockLinkFileServer::_streamCommand(uint8_t senderSystemId, uint8_t senderCo
         }
         
         // Write file bytes. Data is a repeating sequence of 0x00, 0x01, .. 0xFF.
-        for (; cDataAck < sizeof(response.data) && readOffset < _readFileLength; readOffset++, cDataAck++) {
+        for (; cDataAck < sizeof(response.data) && readOffset < fileLength; readOffset++, cDataAck++) {
             response.data[cDataAck] = readOffset & 0xFF;
         }
         
         // We should always have written something, otherwise there is something wrong with the code above
         Q_ASSERT(cDataAck);
         
-        response.hdr.session = _sessionId;
+        response.hdr.session = session;
         response.hdr.size = cDataAck;
         response.hdr.offset = ackOffset;
         response.hdr.opcode = FileManager::kRspAck;
         response.hdr.req_opcode = FileManager::kCmdBurstReadFile;
+        response.hdr.burstComplete = readOffset >= fileLength;
         
         _sendResponse(senderSystemId, senderComponentId, &response, outgoingSeqNumber);
         
         outgoingSeqNumber = _nextSeqNumber(outgoingSeqNumber);
-        ackOffset += cDataAck;
     }
 	
-    _sendNak(senderSystemId, senderComponentId, FileManager::kErrEOF, outgoingSeqNumber, FileManager::kCmdBurstReadFile);
+    _sendNak(senderSystemId, senderComponentId, FileManager::kErrEOF, outgoingSeqNumber, FileManager::kCmdBurstReadFile, session);
+}
+
+/// @brief Handles CalcFileCRC32 command requests. The CRC is calculated over the same data returned by Read.
+void MockLinkFileServer::_calcFileCrc32Command(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber)
+{
+    FileManager::Request    response;
+    uint16_t                outgoingSeqNumber = _nextSeqNumber(seqNumber);
+
+    ensureNullTemination(request);
+    QString path = (char *)request->data;
+
+    const FileTestCase* testCase = NULL;
+    for (size_t i=0; i<cFileTestCases; i++) {
+        if (path == rgFileTestCases[i].filename) {
+            testCase = &rgFileTestCases[i];
+            break;
+        }
+    }
+    if (!testCase) {
+        _sendNak(senderSystemId, senderComponentId, FileManager::kErrFail, outgoingSeqNumber, FileManager::kCmdCalcFileCRC32);
+        return;
+    }
+
+    uint32_t crc = 0;
+    for (uint32_t offset=0; offset<testCase->length; offset++) {
+        quint8 byte = offset & 0xFF;
+        crc = QGC::crc32(&byte, 1, crc);
+    }
+    if (_errMode == errModeBadCrc) {
+        crc = ~crc;
+    }
+
+    response.hdr.opcode = FileManager::kRspAck;
+    response.hdr.req_opcode = FileManager::kCmdCalcFileCRC32;
+    response.hdr.session = 0;
+    response.hdr.size = sizeof(uint32_t);
+    response.fileCrc32 = crc;
+
+    _sendResponse(senderSystemId, senderComponentId, &response, outgoingSeqNumber);
 }
 
 void MockLinkFileServer::_terminateCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber)
 {
     uint16_t outgoingSeqNumber = _nextSeqNumber(seqNumber);
 
-    if (request->hdr.session != _sessionId) {
-		_sendNak(senderSystemId, senderComponentId, FileManager::kErrInvalidSession, outgoingSeqNumber, FileManager::kCmdTerminateSession);
+    if (_sessions.remove(request->hdr.session) == 0) {
+		_sendNak(senderSystemId, senderComponentId, FileManager::kErrInvalidSession, outgoingSeqNumber, FileManager::kCmdTerminateSession, request->hdr.session);
         return;
     }
     
-	_sendAck(senderSystemId, senderComponentId, outgoingSeqNumber, FileManager::kCmdTerminateSession);
+	_sendAck(senderSystemId, senderComponentId, outgoingSeqNumber, FileManager::kCmdTerminateSession, request->hdr.session);
 	
     emit terminateCommandReceived();
 }
@@ -268,6 +324,7 @@ void MockLinkFileServer::_resetCommand(uint8_t senderSystemId, uint8_t senderCom
 {
     uint16_t outgoingSeqNumber = _nextSeqNumber(seqNumber);
     
+    _sessions.clear();
     _sendAck(senderSystemId, senderComponentId, outgoingSeqNumber, FileManager::kCmdResetSessions);
     
     emit resetCommandReceived();
@@ -348,6 +405,10 @@ void MockLinkFileServer::handleFTPMessage(const mavlink_message_t& message)
             _streamCommand(message.sysid, message.compid, request, incomingSeqNumber);
             break;
 
+        case FileManager::kCmdCalcFileCRC32:
+            _calcFileCrc32Command(message.sysid, message.compid, request, incomingSeqNumber);
+            break;
+
         case FileManager::kCmdTerminateSession:
             _terminateCommand(message.sysid, message.compid, request, incomingSeqNumber);
             break;
@@ -364,26 +425,26 @@ void MockLinkFileServer::handleFTPMessage(const mavlink_message_t& message)
 }
 
 /// @brief Sends an Ack
-void MockLinkFileServer::_sendAck(uint8_t targetSystemId, uint8_t targetComponentId, uint16_t seqNumber, FileManager::Opcode reqOpcode)
+void MockLinkFileServer::_sendAck(uint8_t targetSystemId, uint8_t targetComponentId, uint16_t seqNumber, FileManager::Opcode reqOpcode, uint8_t session)
 {
     FileManager::Request ackResponse;
     
     ackResponse.hdr.opcode = FileManager::kRspAck;
 	ackResponse.hdr.req_opcode = reqOpcode;
-    ackResponse.hdr.session = 0;
+    ackResponse.hdr.session = session;
     ackResponse.hdr.size = 0;
     
     _sendResponse(targetSystemId, targetComponentId, &ackResponse, seqNumber);
 }
 
 /// @brief Sends a Nak with the specified error code.
-void MockLinkFileServer::_sendNak(uint8_t targetSystemId, uint8_t targetComponentId, FileManager::ErrorCode error, uint16_t seqNumber, FileManager::Opcode reqOpcode)
+void MockLinkFileServer::_sendNak(uint8_t targetSystemId, uint8_t targetComponentId, FileManager::ErrorCode error, uint16_t seqNumber, FileManager::Opcode reqOpcode, uint8_t session)
 {
     FileManager::Request nakResponse;
 
     nakResponse.hdr.opcode = FileManager::kRspNak;
 	nakResponse.hdr.req_opcode = reqOpcode;
-    nakResponse.hdr.session = 0;
+    nakResponse.hdr.session = session;
     nakResponse.hdr.size = 1;
     nakResponse.data[0] = error;
     
@@ -17,6 +17,7 @@
 #include "FileManager.h"
 
 #include <QStringList>
+#include <QMap>
 
 class MockLink;
 
@@ -39,15 +40,20 @@ public:
         errModeNakResponse,         ///< Nak all requests
         errModeNoSecondResponse,    ///< No response to subsequent request to initial command
         errModeNakSecondResponse,   ///< Nak subsequent request to initial command
-        errModeBadSequence          ///< Return response with bad sequence number
+        errModeBadSequence,         ///< Return response with bad sequence number
+        errModeBadCrc               ///< Return a CalcFileCRC32 result which does not match the file contents
     } ErrorMode_t;
     
     /// @brief Sets the error mode for command responses. This allows you to simulate various server errors.
     void setErrorMode(ErrorMode_t errMode) { _errMode = errMode; };
     
+    /// @brief Sets the number of sessions which can be open at the same time. Open commands past that are Nak'ed
+    /// with kErrNoSessionsAvailable.
+    void setMaxSessions(int maxSessions) { _maxSessions = maxSessions; }
+    
     /// @brief Array of failure modes you can cycle through for testing. By looping through this array you can avoid
     /// hardcoding the specific error modes in your unit test. This way when new error modes are added your unit test
-    /// code may not need to be modified.
+    /// code may not need to be modified. errModeBadCrc is not part of it since it only applies to downloads.
     static const ErrorMode_t rgFailureModes[];
     
     /// @brief The number of ErrorModes in the rgFailureModes array.
@@ -80,13 +86,14 @@ signals:
     void resetCommandReceived(void);
     
 private:
-	void _sendAck(uint8_t targetSystemId, uint8_t targetComponentId, uint16_t seqNumber, FileManager::Opcode reqOpcode);
-    void _sendNak(uint8_t targetSystemId, uint8_t targetComponentId, FileManager::ErrorCode error, uint16_t seqNumber, FileManager::Opcode reqOpcode);
+	void _sendAck(uint8_t targetSystemId, uint8_t targetComponentId, uint16_t seqNumber, FileManager::Opcode reqOpcode, uint8_t session = 0);
+    void _sendNak(uint8_t targetSystemId, uint8_t targetComponentId, FileManager::ErrorCode error, uint16_t seqNumber, FileManager::Opcode reqOpcode, uint8_t session = 0);
     void _sendResponse(uint8_t targetSystemId, uint8_t targetComponentId, FileManager::Request* request, uint16_t seqNumber);
     void _listCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber);
     void _openCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber);
     void _readCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber);
 	void _streamCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber);
+    void _calcFileCrc32Command(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber);
     void _terminateCommand(uint8_t senderSystemId, uint8_t senderComponentId, FileManager::Request* request, uint16_t seqNumber);
     void _resetCommand(uint8_t senderSystemId, uint8_t senderComponentId, uint16_t seqNumber);
     uint16_t _nextSeqNumber(uint16_t seqNumber);
@@ -96,8 +103,8 @@ private:
 
     QStringList _fileList;  ///< List of files returned by List command
     
-    static const uint8_t    _sessionId;
-    uint8_t                 _readFileLength;    ///< Length of active file being read
+    QMap<uint8_t, uint32_t> _sessions;          ///< Open sessions, session id to length of the file being read
+    int                     _maxSessions;       ///< Maximum number of open sessions, as specified by setMaxSessions
     ErrorMode_t             _errMode;           ///< Currently set error mode, as specified by setErrorMode
     const uint8_t           _systemIdServer;    ///< System ID for server
     const uint8_t           _componentIdServer; ///< Component ID for server
@@ -0,0 +1,925 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MockLinkSwarm.h"
+#include "MockLink.h"
+
+#include <QtMath>
+
+#include <string.h>
+
+const double MockLinkSwarm::_originLatitude =  47.397;
+const double MockLinkSwarm::_originLongitude = 8.5455;
+const double MockLinkSwarm::_originAltitude =  488.056;
+const double MockLinkSwarm::_swarmAreaSize =   2000;
+const double MockLinkSwarm::_trafficAreaSize = 20000;
+
+static const double _metersPerDegreeLatitude =  111319.5;
+static const double _gravity =                  9.80665;
+
+MockLinkSwarm::Config MockLinkSwarm::config(MessageMix_t messageMix)
+{
+    Config config;
+
+    switch (messageMix) {
+    case MessageMixLight:
+        config.heartbeatHz =            1;
+        config.attitudeHz =             10;
+        config.highresImuHz =           0;
+        config.globalPositionHz =       5;
+        config.gpsRawIntHz =            1;
+        config.sysStatusHz =            1;
+        config.vfrHudHz =               4;
+        config.adsbVehicleCount =       0;
+        config.adsbHz =                 0;
+        config.statusTextBurstSecs =    0;
+        config.statusTextBurstCount =   0;
+        config.paramCount =             100;
+        config.missionItemCount =       10;
+        break;
+    case MessageMixTypical:
+        config.heartbeatHz =            1;
+        config.attitudeHz =             50;
+        config.highresImuHz =           50;
+        config.globalPositionHz =       10;
+        config.gpsRawIntHz =            5;
+        config.sysStatusHz =            2;
+        config.vfrHudHz =               10;
+        config.adsbVehicleCount =       20;
+        config.adsbHz =                 1;
+        config.statusTextBurstSecs =    10;
+        config.statusTextBurstCount =   5;
+        config.paramCount =             300;
+        config.missionItemCount =       30;
+        break;
+    case MessageMixHeavy:
+        config.heartbeatHz =            1;
+        config.attitudeHz =             250;
+        config.highresImuHz =           250;
+        config.globalPositionHz =       50;
+        config.gpsRawIntHz =            10;
+        config.sysStatusHz =            5;
+        config.vfrHudHz =               25;
+        config.adsbVehicleCount =       100;
+        config.adsbHz =                 2;
+        config.statusTextBurstSecs =    2;
+        config.statusTextBurstCount =   20;
+        config.paramCount =             1000;
+        config.missionItemCount =       100;
+        break;
+    }
+
+    return config;
+}
+
+MockLinkSwarm::MockLinkSwarm(MockLink* mockLink, int firstSystemId, int vehicleCount, quint32 seed, const Config& config)
+    : _mockLink         (mockLink)
+    , _firstSystemId    (firstSystemId)
+    , _config           (config)
+    , _randomState      ((seed * 2654435761u) ^ 0x9E3779B9)
+    , _tick             (0)
+    , _runTimerTick     (0)
+    , _messagesSent     (0)
+    , _bytesSent        (0)
+    , _capture          (NULL)
+{
+    if (_randomState == 0) {
+        _randomState = 1;
+    }
+
+    vehicleCount = qBound(0, vehicleCount, qMin(maxVehicleCount, 255 - firstSystemId));
+    for (int i=0; i<vehicleCount; i++) {
+        Vehicle vehicle;
+
+        vehicle.systemId =              firstSystemId + i;
+        vehicle.txSeq =                 0;
+        vehicle.centerNorth =           _randomRange(-_swarmAreaSize / 2, _swarmAreaSize / 2);
+        vehicle.centerEast =            _randomRange(-_swarmAreaSize / 2, _swarmAreaSize / 2);
+        vehicle.radius =                _randomRange(50, 300);
+        vehicle.angularSpeed =          _randomRange(5, 20) / vehicle.radius * (_random() & 1 ? 1 : -1);
+        vehicle.phase =                 _randomRange(0, 2 * M_PI);
+        vehicle.altitude =              _randomRange(30, 120);
+        vehicle.altitudeAmplitude =     _randomRange(0, 10);
+        vehicle.baseMode =              MAV_MODE_FLAG_CUSTOM_MODE_ENABLED;
+        vehicle.customMode =            0;
+        vehicle.paramListIndex =        -1;
+        vehicle.writeCount =            -1;
+        vehicle.writeType =             MAV_MISSION_TYPE_MISSION;
+
+        vehicle.paramValues.resize(_config.paramCount);
+        for (int j=0; j<_config.paramCount; j++) {
+            vehicle.paramValues[j] = _randomRange(-1000, 1000);
+        }
+
+        for (int j=0; j<_config.missionItemCount; j++) {
+            vehicle.missionItems[MAV_MISSION_TYPE_MISSION].append(_missionItem(vehicle, j));
+        }
+
+        _vehicles.append(vehicle);
+    }
+
+    for (int i=0; i<_config.adsbVehicleCount; i++) {
+        Aircraft aircraft;
+
+        aircraft.icaoAddress =  0x100000 + i;
+        aircraft.north =        _randomRange(-_trafficAreaSize / 2, _trafficAreaSize / 2);
+        aircraft.east =         _randomRange(-_trafficAreaSize / 2, _trafficAreaSize / 2);
+        aircraft.heading =      _randomRange(0, 2 * M_PI);
+        aircraft.speed =        _randomRange(50, 250);
+        aircraft.altitude =     _randomRange(500, 10000);
+
+        _aircraft.append(aircraft);
+    }
+}
+
+/// xorshift32, the same sequence on all platforms
+quint32 MockLinkSwarm::_random(void)
+{
+    _randomState ^= _randomState << 13;
+    _randomState ^= _randomState >> 17;
+    _randomState ^= _randomState << 5;
+    return _randomState;
+}
+
+double MockLinkSwarm::_randomRange(double min, double max)
+{
+    return min + ((_random() / 4294967296.0) * (max - min));
+}
+
+/// @return true: a message of a stream at the specified rate is due in this tick. Streams of different vehicles are staggered.
+bool MockLinkSwarm::_due(int rateHz, int index) const
+{
+    if (rateHz <= 0) {
+        return false;
+    }
+
+    quint64 tick = _tick + (index * 7);
+    return ((tick + 1) * rateHz) / tickHz != (tick * rateHz) / tickHz;
+}
+
+void MockLinkSwarm::run(void)
+{
+    if (!_runTimer.isValid()) {
+        _runTimer.start();
+        _runTimerTick = _tick;
+    }
+
+    quint64 targetTick = _runTimerTick + ((_runTimer.elapsed() * tickHz) / 1000);
+    if (targetTick <= _tick) {
+        return;
+    }
+
+    quint64 count = targetTick - _tick;
+    if (count > (quint64)maxTicksPerRun) {
+        // Drop the simulation time which can't be caught up with
+        _runTimerTick += count - maxTicksPerRun;
+        count = maxTicksPerRun;
+    }
+    runTicks(count);
+}
+
+void MockLinkSwarm::runTicks(int count)
+{
+    for (int i=0; i<count; i++) {
+        _runTick();
+        _tick++;
+    }
+}
+
+void MockLinkSwarm::_runTick(void)
+{
+    for (int i=0; i<_vehicles.count(); i++) {
+        Vehicle& vehicle = _vehicles[i];
+
+        if (_due(_config.heartbeatHz, i)) {
+            _sendHeartbeat(vehicle);
+        }
+        if (_due(_config.sysStatusHz, i)) {
+            _sendSysStatus(vehicle);
+        }
+
+        bool attitude =         _due(_config.attitudeHz, i);
+        bool highresImu =       _due(_config.highresImuHz, i);
+        bool globalPosition =   _due(_config.globalPositionHz, i);
+        bool gpsRawInt =        _due(_config.gpsRawIntHz, i);
+        bool vfrHud =           _due(_config.vfrHudHz, i);
+        if (attitude || highresImu || globalPosition || gpsRawInt || vfrHud) {
+            State state = _state(vehicle);
+
+            if (attitude) {
+                _sendAttitude(vehicle, state);
+            }
+            if (highresImu) {
+                _sendHighresImu(vehicle, state);
+            }
+            if (globalPosition) {
+                _sendGlobalPosition(vehicle, state);
+            }
+            if (gpsRawInt) {
+                _sendGpsRawInt(vehicle, state);
+            }
+            if (vfrHud) {
+                _sendVfrHud(vehicle, state);
+            }
+        }
+
+        if (_config.statusTextBurstSecs > 0 && ((_tick + (i * 7)) % (_config.statusTextBurstSecs * tickHz)) == 0) {
+            _sendStatusTextBurst(vehicle);
+        }
+
+        if (vehicle.paramListIndex != -1) {
+            _sendParamValue(vehicle, vehicle.paramListIndex);
+            if (++vehicle.paramListIndex >= vehicle.paramValues.count()) {
+                vehicle.paramListIndex = -1;
+            }
+        }
+    }
+
+    if (_vehicles.count()) {
+        for (int i=0; i<_aircraft.count(); i++) {
+            if (_due(_config.adsbHz, i)) {
+                _sendAdsbVehicle(_vehicles[i % _vehicles.count()], _aircraft[i]);
+            }
+        }
+    }
+}
+
+MockLinkSwarm::State MockLinkSwarm::_state(const Vehicle& vehicle) const
+{
+    State   state;
+    double  time =          (double)_tick / tickHz;
+    double  angle =         vehicle.phase + (vehicle.angularSpeed * time);
+    double  climbPhase =    vehicle.phase + (0.1 * time);
+    double  speed =         qAbs(vehicle.radius * vehicle.angularSpeed);
+
+    state.north =           vehicle.centerNorth + (vehicle.radius * qCos(angle));
+    state.east =            vehicle.centerEast + (vehicle.radius * qSin(angle));
+    state.altitude =        vehicle.altitude + (vehicle.altitudeAmplitude * qSin(climbPhase));
+    state.velocityNorth =   -vehicle.radius * vehicle.angularSpeed * qSin(angle);
+    state.velocityEast =    vehicle.radius * vehicle.angularSpeed * qCos(angle);
+    state.velocityDown =    -vehicle.altitudeAmplitude * 0.1 * qCos(climbPhase);
+    state.yaw =             qAtan2(state.velocityEast, state.velocityNorth);
+    state.yawRate =         vehicle.angularSpeed;
+    state.roll =            qAtan(speed * vehicle.angularSpeed / _gravity);     // Coordinated turn
+    state.pitch =           qAtan2(-state.velocityDown, speed);
+
+    return state;
+}
+
+QGeoCoordinate MockLinkSwarm::_toCoordinate(double north, double east, double altitude) const
+{
+    return QGeoCoordinate(_originLatitude + (north / _metersPerDegreeLatitude),
+                          _originLongitude + (east / (_metersPerDegreeLatitude * qCos(qDegreesToRadians(_originLatitude)))),
+                          _originAltitude + altitude);
+}
+
+QGeoCoordinate MockLinkSwarm::coordinate(int vehicleIndex) const
+{
+    State state = _state(_vehicles[vehicleIndex]);
+    return _toCoordinate(state.north, state.east, state.altitude);
+}
+
+/// Waypoints spread around the circle of the vehicle
+mavlink_mission_item_t MockLinkSwarm::_missionItem(const Vehicle& vehicle, int seq) const
+{
+    mavlink_mission_item_t  item;
+    double                  angle = vehicle.phase + ((2 * M_PI * seq) / qMax(1, _config.missionItemCount));
+    QGeoCoordinate          coord = _toCoordinate(vehicle.centerNorth + (vehicle.radius * qCos(angle)), vehicle.centerEast + (vehicle.radius * qSin(angle)), 0);
+
+    memset(&item, 0, sizeof(item));
+    item.seq =          seq;
+    item.frame =        MAV_FRAME_GLOBAL_RELATIVE_ALT;
+    item.command =      MAV_CMD_NAV_WAYPOINT;
+    item.autocontinue = 1;
+    item.x =            coord.latitude();
+    item.y =            coord.longitude();
+    item.z =            vehicle.altitude;
+    item.mission_type = MAV_MISSION_TYPE_MISSION;
+
+    return item;
+}
+
+/// Sets up the channel status for packing a message of the vehicle
+///     @return Channel to pack the message on
+uint8_t MockLinkSwarm::_beginPack(Vehicle& vehicle)
+{
+    uint8_t             channel = _mockLink ? _mockLink->vehicleMavlinkChannel() : 0;
+    mavlink_status_t*   status = mavlink_get_channel_status(channel);
+
+    // Swap in the sequence of the vehicle, QGC tracks packet loss by system id
+    uint8_t linkSeq = status->current_tx_seq;
+    status->current_tx_seq = vehicle.txSeq;
+    vehicle.txSeq = linkSeq;
+
+    return channel;
+}
+
+void MockLinkSwarm::_endPack(Vehicle& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_status_t* status = mavlink_get_channel_status(_mockLink ? _mockLink->vehicleMavlinkChannel() : 0);
+
+    uint8_t vehicleSeq = status->current_tx_seq;
+    status->current_tx_seq = vehicle.txSeq;
+    vehicle.txSeq = vehicleSeq;
+
+    _messagesSent++;
+    _bytesSent += mavlink_msg_get_send_buffer_length(&msg);
+    _messageCounts[msg.msgid]++;
+
+    if (_capture) {
+        _capture->append(msg);
+    }
+    if (_mockLink) {
+        _mockLink->respondWithMavlinkMessage(msg);
+    }
+}
+
+void MockLinkSwarm::_sendHeartbeat(Vehicle& vehicle)
+{
+    mavlink_message_t   msg;
+    mavlink_heartbeat_t heartbeat;
+
+    memset(&heartbeat, 0, sizeof(heartbeat));
+    heartbeat.type =            MAV_TYPE_QUADROTOR;
+    heartbeat.autopilot =       MAV_AUTOPILOT_GENERIC;
+    heartbeat.base_mode =       vehicle.baseMode;
+    heartbeat.custom_mode =     vehicle.customMode;
+    heartbeat.system_status =   vehicle.baseMode & MAV_MODE_FLAG_SAFETY_ARMED ? MAV_STATE_ACTIVE : MAV_STATE_STANDBY;
+    heartbeat.mavlink_version = 3;
+
+    mavlink_msg_heartbeat_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &msg, &heartbeat);
+    _endPack(vehicle, msg);
+}
+
+void MockLinkSwarm::_sendAttitude(Vehicle& vehicle, const State& state)
+{
+    mavlink_message_t   msg;
+    mavlink_attitude_t  attitude;
+
+    memset(&attitude, 0, sizeof(attitude));
+    attitude.time_boot_ms = (_tick * 1000) / tickHz;
+    attitude.roll =         state.roll + _randomRange(-0.002, 0.002);
+    attitude.pitch =        state.pitch + _randomRange(-0.002, 0.002);
+    attitude.yaw =          state.yaw;
+    attitude.pitchspeed =   state.yawRate * qSin(state.roll);
+    attitude.yawspeed =     state.yawRate * qCos(state.roll);
+
+    mavlink_msg_attitude_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &msg, &attitude);
+    _endPack(vehicle, msg);
+}
+
+void MockLinkSwarm::_sendHighresImu(Vehicle& vehicle, const State& state)
+{
+    mavlink_message_t       msg;
+    mavlink_highres_imu_t   imu;
+
+    memset(&imu, 0, sizeof(imu));
+    imu.time_usec =         (_tick * 1000000) / tickHz;
+    imu.xacc =              _randomRange(-0.05, 0.05);
+    imu.yacc =              _randomRange(-0.05, 0.05);
+    imu.zacc =              (-_gravity / qCos(state.roll)) + _randomRange(-0.05, 0.05);
+    imu.xgyro =             _randomRange(-0.005, 0.005);
+    imu.ygyro =             (state.yawRate * qSin(state.roll)) + _randomRange(-0.005, 0.005);
+    imu.zgyro =             (state.yawRate * qCos(state.roll)) + _randomRange(-0.005, 0.005);
+    imu.xmag =              0.21 * qCos(state.yaw);
+    imu.ymag =              -0.21 * qSin(state.yaw);
+    imu.zmag =              0.42;
+    imu.abs_pressure =      1013.25 * qPow(1 - (2.25577e-5 * (_originAltitude + state.altitude)), 5.25588);
+    imu.pressure_alt =      _originAltitude + state.altitude;
+    imu.temperature =       25;
+    imu.fields_updated =    0x1FFF;
+
+    mavlink_msg_highres_imu_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &msg, &imu);
+    _endPack(vehicle, msg);
+}
+
+void MockLinkSwarm::_sendGlobalPosition(Vehicle& vehicle, const State& state)
+{
+    mavlink_message_t               msg;
+    mavlink_global_position_int_t   position;
+    QGeoCoordinate                  coord = _toCoordinate(state.north, state.east, state.altitude);
+
+    memset(&position, 0, sizeof(position));
+    position.time_boot_ms = (_tick * 1000) / tickHz;
+    position.lat =          coord.latitude() * 1e7;
+    position.lon =          coord.longitude() * 1e7;
+    position.alt =          coord.altitude() * 1000;
+    position.relative_alt = state.altitude * 1000;
+    position.vx =           state.velocityNorth * 100;
+    position.vy =           state.velocityEast * 100;
+    position.vz =           state.velocityDown * 100;
+    position.hdg =          fmod(qRadiansToDegrees(state.yaw) + 360, 360) * 100;
+
+    mavlink_msg_global_position_int_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &msg, &position);
+    _endPack(vehicle, msg);
+}
+
+void MockLinkSwarm::_sendGpsRawInt(Vehicle& vehicle, const State& state)
+{
+    mavlink_message_t       msg;
+    mavlink_gps_raw_int_t   gps;
+    QGeoCoordinate          coord = _toCoordinate(state.north, state.east, state.altitude);
+
+    memset(&gps, 0, sizeof(gps));
+    gps.time_usec =             (_tick * 1000000) / tickHz;
+    gps.fix_type =              GPS_FIX_TYPE_3D_FIX;
+    gps.lat =                   coord.latitude() * 1e7;
+    gps.lon =                   coord.longitude() * 1e7;
+    gps.alt =                   coord.altitude() * 1000;
+    gps.eph =                   80;
+    gps.epv =                   120;
+    gps.vel =                   qSqrt((state.velocityNorth * state.velocityNorth) + (state.velocityEast * state.velocityEast)) * 100;
+    gps.cog =                   fmod(qRadiansToDegrees(state.yaw) + 360, 360) * 100;
+    gps.satellites_visible =    12;
+
+    mavlink_msg_gps_raw_int_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &msg, &gps);
+    _endPack(vehicle, msg);
+}
+
+void MockLinkSwarm::_sendSysStatus(Vehicle& vehicle)
+{
+    mavlink_message_t       msg;
+    mavlink_sys_status_t    sysStatus;
+    uint32_t                sensors = MAV_SYS_STATUS_SENSOR_3D_GYRO | MAV_SYS_STATUS_SENSOR_3D_ACCEL | MAV_SYS_STATUS_SENSOR_3D_MAG |
+                                      MAV_SYS_STATUS_SENSOR_ABSOLUTE_PRESSURE | MAV_SYS_STATUS_SENSOR_GPS;
+    int                     elapsedSecs = _tick / tickHz;
+
+    memset(&sysStatus, 0, sizeof(sysStatus));
+    sysStatus.onboard_control_sensors_present = sensors;
+    sysStatus.onboard_control_sensors_enabled = sensors;
+    sysStatus.onboard_control_sensors_health =  sensors;
+    sysStatus.load =                            350;
+    sysStatus.voltage_battery =                 qMax(14000, 16800 - (elapsedSecs * 2));
+    sysStatus.current_battery =                 1500;
+    sysStatus.battery_remaining =               qMax(0, 100 - (elapsedSecs / 20));
+
+    mavlink_msg_sys_status_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &msg, &sysStatus);
+    _endPack(vehicle, msg);
+}
+
+void MockLinkSwarm::_sendVfrHud(Vehicle& vehicle, const State& state)
+{
+    mavlink_message_t   msg;
+    mavlink_vfr_hud_t   vfrHud;
+    double              speed = qSqrt((state.velocityNorth * state.velocityNorth) + (state.velocityEast * state.velocityEast));
+
+    memset(&vfrHud, 0, sizeof(vfrHud));
+    vfrHud.airspeed =       speed;
+    vfrHud.groundspeed =    speed;
+    vfrHud.heading =        fmod(qRadiansToDegrees(state.yaw) + 360, 360);
+    vfrHud.throttle =       50;
+    vfrHud.alt =            _originAltitude + state.altitude;
+    vfrHud.climb =          -state.velocityDown;
+
+    mavlink_msg_vfr_hud_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &msg, &vfrHud);
+    _endPack(vehicle, msg);
+}
+
+void MockLinkSwarm::_sendAdsbVehicle(Vehicle& vehicle, const Aircraft& aircraft)
+{
+    mavlink_message_t       msg;
+    mavlink_adsb_vehicle_t  adsb;
+    double                  distance =  aircraft.speed * _tick / tickHz;
+    double                  halfSize =  _trafficAreaSize / 2;
+    double                  north =     aircraft.north + (distance * qCos(aircraft.heading)) + halfSize;
+    double                  east =      aircraft.east + (distance * qSin(aircraft.heading)) + halfSize;
+
+    // Wrap around at the edges of the traffic area
+    north = fmod(fmod(north, _trafficAreaSize) + _trafficAreaSize, _trafficAreaSize) - halfSize;
+    east = fmod(fmod(east, _trafficAreaSize) + _trafficAreaSize, _trafficAreaSize) - halfSize;
+    QGeoCoordinate coord = _toCoordinate(north, east, aircraft.altitude - _originAltitude);
+
+    memset(&adsb, 0, sizeof(adsb));
+    adsb.ICAO_address =     aircraft.icaoAddress;
+    adsb.lat =              coord.latitude() * 1e7;
+    adsb.lon =              coord.longitude() * 1e7;
+    adsb.altitude_type =    ADSB_ALTITUDE_TYPE_GEOMETRIC;
+    adsb.altitude =         aircraft.altitude * 1000;
+    adsb.heading =          qRadiansToDegrees(aircraft.heading) * 100;
+    adsb.hor_velocity =     aircraft.speed * 100;
+    adsb.emitter_type =     ADSB_EMITTER_TYPE_LARGE;
+    adsb.tslc =             1;
+    adsb.flags =            ADSB_FLAGS_VALID_COORDS | ADSB_FLAGS_VALID_ALTITUDE | ADSB_FLAGS_VALID_HEADING | ADSB_FLAGS_VALID_VELOCITY | ADSB_FLAGS_VALID_CALLSIGN | ADSB_FLAGS_SIMULATED;
+    snprintf(adsb.callsign, sizeof(adsb.callsign), "SW%06X", aircraft.icaoAddress & 0xFFFFFF);
+
+    mavlink_msg_adsb_vehicle_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &msg, &adsb);
+    _endPack(vehicle, msg);
+}
+
+void MockLinkSwarm::_sendStatusTextBurst(Vehicle& vehicle)
+{
+    // No severities which pop up a message box, a burst should load the message handling and not block the UI
+    static const MAV_SEVERITY rgSeverities[] = { MAV_SEVERITY_INFO, MAV_SEVERITY_NOTICE, MAV_SEVERITY_WARNING, MAV_SEVERITY_DEBUG };
+
+    for (int i=0; i<_config.statusTextBurstCount; i++) {
+        mavlink_message_t       msg;
+        mavlink_statustext_t    statusText;
+
+        memset(&statusText, 0, sizeof(statusText));
+        statusText.severity = rgSeverities[i % (sizeof(rgSeverities) / sizeof(rgSeverities[0]))];
+        snprintf(statusText.text, sizeof(statusText.text), "Swarm vehicle %d status %d at %llu", vehicle.systemId, i, (unsigned long long)(_tick / tickHz));
+
+        mavlink_msg_statustext_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &msg, &statusText);
+        _endPack(vehicle, msg);
+    }
+}
+
+void MockLinkSwarm::_sendParamValue(Vehicle& vehicle, int index)
+{
+    mavlink_message_t       msg;
+    mavlink_param_value_t   paramValue;
+
+    memset(&paramValue, 0, sizeof(paramValue));
+    snprintf(paramValue.param_id, sizeof(paramValue.param_id), "SWARM_P%04d", index);
+    paramValue.param_value =    vehicle.paramValues[index];
+    paramValue.param_type =     MAV_PARAM_TYPE_REAL32;
+    paramValue.param_count =    vehicle.paramValues.count();
+    paramValue.param_index =    index;
+
+    mavlink_msg_param_value_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &msg, &paramValue);
+    _endPack(vehicle, msg);
+}
+
+void MockLinkSwarm::_sendMissionAck(Vehicle& vehicle, const mavlink_message_t& request, int missionType, MAV_MISSION_RESULT result)
+{
+    mavlink_message_t       msg;
+    mavlink_mission_ack_t   ack;
+
+    memset(&ack, 0, sizeof(ack));
+    ack.target_system =     request.sysid;
+    ack.target_component =  request.compid;
+    ack.type =              result;
+    ack.mission_type =      missionType;
+
+    mavlink_msg_mission_ack_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &msg, &ack);
+    _endPack(vehicle, msg);
+}
+
+void MockLinkSwarm::_sendMissionRequest(Vehicle& vehicle, const mavlink_message_t& request, int seq)
+{
+    mavlink_message_t           msg;
+    mavlink_mission_request_t   missionRequest;
+
+    memset(&missionRequest, 0, sizeof(missionRequest));
+    missionRequest.target_system =      request.sysid;
+    missionRequest.target_component =   request.compid;
+    missionRequest.seq =                seq;
+    missionRequest.mission_type =       vehicle.writeType;
+
+    mavlink_msg_mission_request_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &msg, &missionRequest);
+    _endPack(vehicle, msg);
+}
+
+/// @return Target system of a message QGC sends to vehicles, -1 for messages without a target
+int MockLinkSwarm::_targetSystem(const mavlink_message_t& msg) const
+{
+    switch (msg.msgid) {
+    case MAVLINK_MSG_ID_PARAM_REQUEST_LIST:
+        return mavlink_msg_param_request_list_get_target_system(&msg);
+    case MAVLINK_MSG_ID_PARAM_REQUEST_READ:
+        return mavlink_msg_param_request_read_get_target_system(&msg);
+    case MAVLINK_MSG_ID_PARAM_SET:
+        return mavlink_msg_param_set_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MISSION_REQUEST_LIST:
+        return mavlink_msg_mission_request_list_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MISSION_REQUEST:
+        return mavlink_msg_mission_request_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MISSION_REQUEST_INT:
+        return mavlink_msg_mission_request_int_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MISSION_COUNT:
+        return mavlink_msg_mission_count_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MISSION_ITEM:
+        return mavlink_msg_mission_item_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MISSION_ITEM_INT:
+        return mavlink_msg_mission_item_int_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MISSION_ACK:
+        return mavlink_msg_mission_ack_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MISSION_SET_CURRENT:
+        return mavlink_msg_mission_set_current_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MISSION_CLEAR_ALL:
+        return mavlink_msg_mission_clear_all_get_target_system(&msg);
+    case MAVLINK_MSG_ID_COMMAND_LONG:
+        return mavlink_msg_command_long_get_target_system(&msg);
+    case MAVLINK_MSG_ID_COMMAND_INT:
+        return mavlink_msg_command_int_get_target_system(&msg);
+    case MAVLINK_MSG_ID_SET_MODE:
+        return mavlink_msg_set_mode_get_target_system(&msg);
+    case MAVLINK_MSG_ID_MANUAL_CONTROL:
+        return mavlink_msg_manual_control_get_target(&msg);
+    case MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL:
+        return mavlink_msg_file_transfer_protocol_get_target_system(&msg);
+    case MAVLINK_MSG_ID_LOG_REQUEST_LIST:
+        return mavlink_msg_log_request_list_get_target_system(&msg);
+    case MAVLINK_MSG_ID_LOG_REQUEST_DATA:
+        return mavlink_msg_log_request_data_get_target_system(&msg);
+    case MAVLINK_MSG_ID_REQUEST_DATA_STREAM:
+        return mavlink_msg_request_data_stream_get_target_system(&msg);
+    default:
+        return -1;
+    }
+}
+
+bool MockLinkSwarm::handleMessage(const mavlink_message_t& msg)
+{
+    int targetSystem = _targetSystem(msg);
+
+    if (!isSwarmVehicle(targetSystem)) {
+        return false;
+    }
+
+    Vehicle& vehicle = _vehicles[targetSystem - _firstSystemId];
+
+    switch (msg.msgid) {
+    case MAVLINK_MSG_ID_PARAM_REQUEST_LIST:
+        _handleParamRequestList(vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_PARAM_REQUEST_READ:
+        _handleParamRequestRead(vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_PARAM_SET:
+        _handleParamSet(vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_MISSION_REQUEST_LIST:
+        _handleMissionRequestList(vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_MISSION_REQUEST:
+    case MAVLINK_MSG_ID_MISSION_REQUEST_INT:
+        _handleMissionRequest(vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_MISSION_COUNT:
+        _handleMissionCount(vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_MISSION_ITEM:
+    case MAVLINK_MSG_ID_MISSION_ITEM_INT:
+        _handleMissionItem(vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_MISSION_CLEAR_ALL:
+        _handleMissionClearAll(vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_COMMAND_LONG:
+        _handleCommandLong(vehicle, msg);
+        break;
+    case MAVLINK_MSG_ID_SET_MODE:
+        _handleSetMode(vehicle, msg);
+        break;
+    default:
+        // Addressed to the swarm vehicle but not simulated
+        break;
+    }
+
+    return true;
+}
+
+void MockLinkSwarm::_handleParamRequestList(Vehicle& vehicle, const mavlink_message_t& msg)
+{
+    Q_UNUSED(msg);
+
+    // Parameters are sent one per tick by _runTick
+    vehicle.paramListIndex = vehicle.paramValues.count() ? 0 : -1;
+}
+
+void MockLinkSwarm::_handleParamRequestRead(Vehicle& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_param_request_read_t request;
+
+    mavlink_msg_param_request_read_decode(&msg, &request);
+
+    int index = request.param_index;
+    if (index < 0) {
+        char paramId[MAVLINK_MSG_PARAM_REQUEST_READ_FIELD_PARAM_ID_LEN + 1];
+        paramId[MAVLINK_MSG_PARAM_REQUEST_READ_FIELD_PARAM_ID_LEN] = 0;
+        strncpy(paramId, request.param_id, MAVLINK_MSG_PARAM_REQUEST_READ_FIELD_PARAM_ID_LEN);
+        if (sscanf(paramId, "SWARM_P%d", &index) != 1) {
+            return;
+        }
+    }
+
+    if (index >= 0 && index < vehicle.paramValues.count()) {
+        _sendParamValue(vehicle, index);
+    }
+}
+
+void MockLinkSwarm::_handleParamSet(Vehicle& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_param_set_t request;
+    int                 index;
+
+    mavlink_msg_param_set_decode(&msg, &request);
+
+    char paramId[MAVLINK_MSG_PARAM_SET_FIELD_PARAM_ID_LEN + 1];
+    paramId[MAVLINK_MSG_PARAM_SET_FIELD_PARAM_ID_LEN] = 0;
+    strncpy(paramId, request.param_id, MAVLINK_MSG_PARAM_SET_FIELD_PARAM_ID_LEN);
+
+    if (sscanf(paramId, "SWARM_P%d", &index) == 1 && index >= 0 && index < vehicle.paramValues.count()) {
+        vehicle.paramValues[index] = request.param_value;
+        _sendParamValue(vehicle, index);
+    }
+}
+
+void MockLinkSwarm::_handleMissionRequestList(Vehicle& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_mission_request_list_t  request;
+    mavlink_mission_count_t         count;
+    mavlink_message_t               responseMsg;
+
+    mavlink_msg_mission_request_list_decode(&msg, &request);
+
+    memset(&count, 0, sizeof(count));
+    count.target_system =       msg.sysid;
+    count.target_component =    msg.compid;
+    count.count =               vehicle.missionItems.value(request.mission_type).count();
+    count.mission_type =        request.mission_type;
+
+    mavlink_msg_mission_count_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &responseMsg, &count);
+    _endPack(vehicle, responseMsg);
+}
+
+void MockLinkSwarm::_handleMissionRequest(Vehicle& vehicle, const mavlink_message_t& msg)
+{
+    int seq;
+    int missionType;
+
+    if (msg.msgid == MAVLINK_MSG_ID_MISSION_REQUEST_INT) {
+        mavlink_mission_request_int_t request;
+        mavlink_msg_mission_request_int_decode(&msg, &request);
+        seq =           request.seq;
+        missionType =   request.mission_type;
+    } else {
+        mavlink_mission_request_t request;
+        mavlink_msg_mission_request_decode(&msg, &request);
+        seq =           request.seq;
+        missionType =   request.mission_type;
+    }
+
+    const QList<mavlink_mission_item_t> items = vehicle.missionItems.value(missionType);
+    if (seq >= items.count()) {
+        _sendMissionAck(vehicle, msg, missionType, MAV_MISSION_INVALID_SEQUENCE);
+        return;
+    }
+
+    mavlink_message_t       responseMsg;
+    mavlink_mission_item_t  item = items[seq];
+
+    item.target_system =    msg.sysid;
+    item.target_component = msg.compid;
+    item.seq =              seq;
+    item.current =          seq == 0;
+    item.mission_type =     missionType;
+
+    if (msg.msgid == MAVLINK_MSG_ID_MISSION_REQUEST_INT) {
+        mavlink_mission_item_int_t itemInt;
+
+        memset(&itemInt, 0, sizeof(itemInt));
+        itemInt.target_system =     item.target_system;
+        itemInt.target_component =  item.target_component;
+        itemInt.seq =               item.seq;
+        itemInt.frame =             item.frame;
+        itemInt.command =           item.command;
+        itemInt.current =           item.current;
+        itemInt.autocontinue =      item.autocontinue;
+        itemInt.param1 =            item.param1;
+        itemInt.param2 =            item.param2;
+        itemInt.param3 =            item.param3;
+        itemInt.param4 =            item.param4;
+        itemInt.x =                 item.x * 1e7;
+        itemInt.y =                 item.y * 1e7;
+        itemInt.z =                 item.z;
+        itemInt.mission_type =      item.mission_type;
+        mavlink_msg_mission_item_int_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &responseMsg, &itemInt);
+    } else {
+        mavlink_msg_mission_item_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &responseMsg, &item);
+    }
+    _endPack(vehicle, responseMsg);
+}
+
+void MockLinkSwarm::_handleMissionCount(Vehicle& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_mission_count_t count;
+
+    mavlink_msg_mission_count_decode(&msg, &count);
+
+    vehicle.writeItems.clear();
+    vehicle.writeType = count.mission_type;
+    if (count.count == 0) {
+        vehicle.writeCount = -1;
+        vehicle.missionItems[count.mission_type].clear();
+        _sendMissionAck(vehicle, msg, count.mission_type, MAV_MISSION_ACCEPTED);
+    } else {
+        vehicle.writeCount = count.count;
+        _sendMissionRequest(vehicle, msg, 0);
+    }
+}
+
+void MockLinkSwarm::_handleMissionItem(Vehicle& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_mission_item_t item;
+
+    if (msg.msgid == MAVLINK_MSG_ID_MISSION_ITEM_INT) {
+        mavlink_mission_item_int_t itemInt;
+
+        mavlink_msg_mission_item_int_decode(&msg, &itemInt);
+        memset(&item, 0, sizeof(item));
+        item.seq =          itemInt.seq;
+        item.frame =        itemInt.frame;
+        item.command =      itemInt.command;
+        item.current =      itemInt.current;
+        item.autocontinue = itemInt.autocontinue;
+        item.param1 =       itemInt.param1;
+        item.param2 =       itemInt.param2;
+        item.param3 =       itemInt.param3;
+        item.param4 =       itemInt.param4;
+        item.x =            itemInt.x * 1e-7;
+        item.y =            itemInt.y * 1e-7;
+        item.z =            itemInt.z;
+        item.mission_type = itemInt.mission_type;
+    } else {
+        mavlink_msg_mission_item_decode(&msg, &item);
+    }
+
+    if (vehicle.writeCount == -1 || item.seq != vehicle.writeItems.count()) {
+        // Not the item we asked for, QGC retries the request
+        return;
+    }
+
+    vehicle.writeItems.append(item);
+    if (vehicle.writeItems.count() < vehicle.writeCount) {
+        _sendMissionRequest(vehicle, msg, vehicle.writeItems.count());
+    } else {
+        vehicle.missionItems[vehicle.writeType] = vehicle.writeItems;
+        vehicle.writeItems.clear();
+        vehicle.writeCount = -1;
+        _sendMissionAck(vehicle, msg, vehicle.writeType, MAV_MISSION_ACCEPTED);
+    }
+}
+
+void MockLinkSwarm::_handleMissionClearAll(Vehicle& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_mission_clear_all_t clearAll;
+
+    mavlink_msg_mission_clear_all_decode(&msg, &clearAll);
+
+    if (clearAll.mission_type == MAV_MISSION_TYPE_ALL) {
+        vehicle.missionItems.clear();
+    } else {
+        vehicle.missionItems.remove(clearAll.mission_type);
+    }
+    _sendMissionAck(vehicle, msg, clearAll.mission_type, MAV_MISSION_ACCEPTED);
+}
+
+void MockLinkSwarm::_handleCommandLong(Vehicle& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_command_long_t  request;
+    mavlink_command_ack_t   ack;
+    mavlink_message_t       responseMsg;
+
+    mavlink_msg_command_long_decode(&msg, &request);
+
+    memset(&ack, 0, sizeof(ack));
+    ack.command =   request.command;
+    ack.result =    MAV_RESULT_UNSUPPORTED;
+
+    switch (request.command) {
+    case MAV_CMD_COMPONENT_ARM_DISARM:
+        if (request.param1 == 0.0f) {
+            vehicle.baseMode &= ~MAV_MODE_FLAG_SAFETY_ARMED;
+        } else {
+            vehicle.baseMode |= MAV_MODE_FLAG_SAFETY_ARMED;
+        }
+        ack.result = MAV_RESULT_ACCEPTED;
+        break;
+    case MAV_CMD_PREFLIGHT_STORAGE:
+        ack.result = MAV_RESULT_ACCEPTED;
+        break;
+    case MAV_CMD_REQUEST_AUTOPILOT_CAPABILITIES:
+    {
+        mavlink_autopilot_version_t version;
+
+        memset(&version, 0, sizeof(version));
+        version.capabilities = MAV_PROTOCOL_CAPABILITY_MAVLINK2;
+        version.flight_sw_version = (1 << (8*3)) | FIRMWARE_VERSION_TYPE_OFFICIAL;
+        mavlink_msg_autopilot_version_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &responseMsg, &version);
+        _endPack(vehicle, responseMsg);
+        ack.result = MAV_RESULT_ACCEPTED;
+        break;
+    }
+    }
+
+    mavlink_msg_command_ack_encode_chan(vehicle.systemId, MAV_COMP_ID_AUTOPILOT1, _beginPack(vehicle), &responseMsg, &ack);
+    _endPack(vehicle, responseMsg);
+}
+
+void MockLinkSwarm::_handleSetMode(Vehicle& vehicle, const mavlink_message_t& msg)
+{
+    mavlink_set_mode_t request;
+
+    mavlink_msg_set_mode_decode(&msg, &request);
+
+    vehicle.baseMode =      request.base_mode;
+    vehicle.customMode =    request.custom_mode;
+}
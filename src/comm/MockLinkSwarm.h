@@ -0,0 +1,197 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef MockLinkSwarm_H
+#define MockLinkSwarm_H
+
+#include <QList>
+#include <QMap>
+#include <QVector>
+#include <QElapsedTimer>
+#include <QGeoCoordinate>
+
+#include "QGCMAVLink.h"
+
+class MockLink;
+
+/// Simulates a swarm of lightweight vehicles on a single MockLink for load testing.
+///
+/// Each swarm vehicle has its own system id and sends heartbeat, attitude, IMU, position, GPS, system status and HUD streams at the
+/// rates of the configured message mix. The swarm also sends ADS-B traffic and periodic status text bursts, and answers parameter
+/// and mission traffic (generic firmware, synthetic parameters, a generated mission) so the full vehicle setup of QGC is exercised.
+///
+/// Everything is driven by a simulation tick of 1 / tickHz seconds. Motion, sensor noise and message content are a function of
+/// the seed and the tick only, so two swarms with the same seed and configuration produce the same messages. Ticks are run to
+/// keep up with real time, when the link thread falls behind the simulation time is dropped instead of sending bursts.
+class MockLinkSwarm
+{
+public:
+    typedef enum {
+        MessageMixLight,        ///< Rates of a vehicle on a low bandwidth telemetry radio
+        MessageMixTypical,      ///< Rates of a vehicle on a WiFi link
+        MessageMixHeavy,        ///< High rate attitude/IMU streams, dense ADS-B traffic, frequent status text bursts
+    } MessageMix_t;
+
+    /// Message mix. Rates are per vehicle in Hz, 0 disables the stream.
+    struct Config {
+        int heartbeatHz;
+        int attitudeHz;
+        int highresImuHz;
+        int globalPositionHz;
+        int gpsRawIntHz;
+        int sysStatusHz;
+        int vfrHudHz;
+        int adsbVehicleCount;       ///< ADS-B aircraft in the swarm area, reported by the swarm vehicles in turn
+        int adsbHz;                 ///< Rate per ADS-B aircraft
+        int statusTextBurstSecs;    ///< Seconds between status text bursts of a vehicle, 0 for none
+        int statusTextBurstCount;   ///< Status texts per burst
+        int paramCount;             ///< Parameters per vehicle
+        int missionItemCount;       ///< Items of the mission a vehicle starts with
+    };
+
+    static Config config(MessageMix_t messageMix);
+
+    /// @param mockLink Link the messages are sent on, NULL to only count the messages
+    /// @param firstSystemId System id of the first swarm vehicle, the others follow
+    MockLinkSwarm(MockLink* mockLink, int firstSystemId, int vehicleCount, quint32 seed, const Config& config);
+
+    int vehicleCount(void) const { return _vehicles.count(); }
+    int firstSystemId(void) const { return _firstSystemId; }
+
+    /// @return true: systemId belongs to a swarm vehicle
+    bool isSwarmVehicle(int systemId) const { return systemId >= _firstSystemId && systemId < _firstSystemId + _vehicles.count(); }
+
+    /// @param capture Sent messages are also appended to this list, NULL for none
+    void setCapture(QList<mavlink_message_t>* capture) { _capture = capture; }
+
+    /// Runs the ticks which are due in real time
+    void run(void);
+
+    /// Runs the specified number of ticks regardless of real time
+    void runTicks(int count);
+
+    /// Handles a message sent by QGC
+    /// @return true: message was addressed to a swarm vehicle and is handled
+    bool handleMessage(const mavlink_message_t& msg);
+
+    /// @return Simulated position of the vehicle at the current tick
+    QGeoCoordinate coordinate(int vehicleIndex) const;
+
+    quint64 tick            (void) const { return _tick; }
+    quint64 messagesSent    (void) const { return _messagesSent; }
+    quint64 bytesSent       (void) const { return _bytesSent; }
+    int     messageCount    (int msgId) const { return _messageCounts.value(msgId); }
+
+    static const int tickHz =           500;
+    static const int maxTicksPerRun =   25;     ///< Simulation time dropped when the link thread falls behind more than this
+    static const int maxVehicleCount =  100;
+
+private:
+    struct State {
+        double north;           ///< Meters from the swarm origin
+        double east;
+        double altitude;        ///< Meters above home
+        double velocityNorth;   ///< Meters per second
+        double velocityEast;
+        double velocityDown;
+        double roll;            ///< Radians
+        double pitch;
+        double yaw;
+        double yawRate;         ///< Radians per second
+    };
+
+    /// Vehicle flies a circle with a slowly changing altitude
+    struct Vehicle {
+        uint8_t     systemId;
+        uint8_t     txSeq;                  ///< Each vehicle has its own packet sequence on the shared channel
+        double      centerNorth;
+        double      centerEast;
+        double      radius;
+        double      angularSpeed;           ///< Radians per second, negative for counter clockwise
+        double      phase;
+        double      altitude;
+        double      altitudeAmplitude;
+        uint8_t     baseMode;
+        uint32_t    customMode;
+        QVector<float> paramValues;
+        int         paramListIndex;         ///< Next parameter of a PARAM_REQUEST_LIST, -1 for none in progress
+        QMap<int, QList<mavlink_mission_item_t> > missionItems;    ///< Items by MAV_MISSION_TYPE
+        QList<mavlink_mission_item_t> writeItems;                   ///< Items received by the upload in progress
+        int         writeCount;             ///< Items of the upload in progress, -1 for none
+        int         writeType;
+    };
+
+    /// ADS-B aircraft flies a straight line, wrapping around at the edges of the traffic area
+    struct Aircraft {
+        uint32_t    icaoAddress;
+        double      north;
+        double      east;
+        double      heading;                ///< Radians
+        double      speed;                  ///< Meters per second
+        double      altitude;
+    };
+
+    quint32 _random         (void);
+    double  _randomRange    (double min, double max);
+    bool    _due            (int rateHz, int index) const;
+    void    _runTick        (void);
+    State   _state          (const Vehicle& vehicle) const;
+    QGeoCoordinate _toCoordinate(double north, double east, double altitude) const;
+    int     _targetSystem   (const mavlink_message_t& msg) const;
+    mavlink_mission_item_t _missionItem(const Vehicle& vehicle, int seq) const;
+
+    uint8_t _beginPack      (Vehicle& vehicle);
+    void    _endPack        (Vehicle& vehicle, const mavlink_message_t& msg);
+
+    void _sendHeartbeat         (Vehicle& vehicle);
+    void _sendAttitude          (Vehicle& vehicle, const State& state);
+    void _sendHighresImu        (Vehicle& vehicle, const State& state);
+    void _sendGlobalPosition    (Vehicle& vehicle, const State& state);
+    void _sendGpsRawInt         (Vehicle& vehicle, const State& state);
+    void _sendSysStatus         (Vehicle& vehicle);
+    void _sendVfrHud            (Vehicle& vehicle, const State& state);
+    void _sendAdsbVehicle       (Vehicle& vehicle, const Aircraft& aircraft);
+    void _sendStatusTextBurst   (Vehicle& vehicle);
+    void _sendParamValue        (Vehicle& vehicle, int index);
+    void _sendMissionAck        (Vehicle& vehicle, const mavlink_message_t& request, int missionType, MAV_MISSION_RESULT result);
+    void _sendMissionRequest    (Vehicle& vehicle, const mavlink_message_t& request, int seq);
+
+    void _handleParamRequestList    (Vehicle& vehicle, const mavlink_message_t& msg);
+    void _handleParamRequestRead    (Vehicle& vehicle, const mavlink_message_t& msg);
+    void _handleParamSet            (Vehicle& vehicle, const mavlink_message_t& msg);
+    void _handleMissionRequestList  (Vehicle& vehicle, const mavlink_message_t& msg);
+    void _handleMissionRequest      (Vehicle& vehicle, const mavlink_message_t& msg);
+    void _handleMissionCount        (Vehicle& vehicle, const mavlink_message_t& msg);
+    void _handleMissionItem         (Vehicle& vehicle, const mavlink_message_t& msg);
+    void _handleMissionClearAll     (Vehicle& vehicle, const mavlink_message_t& msg);
+    void _handleCommandLong         (Vehicle& vehicle, const mavlink_message_t& msg);
+    void _handleSetMode             (Vehicle& vehicle, const mavlink_message_t& msg);
+
+    MockLink*           _mockLink;
+    int                 _firstSystemId;
+    Config              _config;
+    quint32             _randomState;
+    QList<Vehicle>      _vehicles;
+    QList<Aircraft>     _aircraft;
+    quint64             _tick;
+    QElapsedTimer       _runTimer;
+    quint64             _runTimerTick;      ///< Tick when _runTimer was started
+    quint64             _messagesSent;
+    quint64             _bytesSent;
+    QMap<int, int>      _messageCounts;     ///< Messages sent by message id
+    QList<mavlink_message_t>* _capture;
+
+    static const double _originLatitude;
+    static const double _originLongitude;
+    static const double _originAltitude;
+    static const double _swarmAreaSize;     ///< Meters, vehicle circles are centered in a square of this size
+    static const double _trafficAreaSize;   ///< Meters, ADS-B traffic flies in a square of this size
+};
+
+#endif
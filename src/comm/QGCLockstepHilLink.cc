@@ -0,0 +1,273 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCLockstepHilLink.h"
+#include "Vehicle.h"
+#include "UAS.h"
+
+#include <QHostInfo>
+
+#include <string.h>
+
+QGCLockstepHilLink::QGCLockstepHilLink(Vehicle* vehicle, QHostAddress localHost, quint16 localPort)
+    : _vehicle                  (vehicle)
+    , _localHost                (localHost)
+    , _localPort                (localPort)
+    , _simulatorPort            (0)
+    , _socket                   (NULL)
+    , _stepTimer                (NULL)
+    , _statisticsTimer          (NULL)
+    , _connectState             (false)
+    , _stepPending              (false)
+    , _statisticsSteps          (0)
+    , _statisticsLatencyNsecs   (0)
+    , _statisticsMaxLatencyNsecs(0)
+    , _stepTimeouts             (0)
+{
+    // Slots run on the simulation thread, same as the other HIL links
+    moveToThread(this);
+
+    qRegisterMetaType<HilLockstepState>("HilLockstepState");
+
+    _name = tr("Lockstep HIL Link (port:%1)").arg(_localPort);
+}
+
+QGCLockstepHilLink::~QGCLockstepHilLink()
+{
+    quit();
+    wait();
+}
+
+void QGCLockstepHilLink::run(void)
+{
+    _socket = new QUdpSocket();
+    _connectState = _socket->bind(_localHost, _localPort, QAbstractSocket::ReuseAddressHint);
+    if (!_connectState) {
+        emit statusMessage(tr("Binding port %1 failed").arg(_localPort));
+        delete _socket;
+        _socket = NULL;
+        emit simulationConnected(false);
+        return;
+    }
+
+    _stepTimer = new QTimer();
+    _stepTimer->setSingleShot(true);
+    _stepTimer->setInterval(stepTimeoutMsecs);
+    _statisticsTimer = new QTimer();
+    _statisticsTimer->setInterval(statisticsMsecs);
+
+    connect(_socket,            &QUdpSocket::readyRead, this, &QGCLockstepHilLink::readBytes);
+    connect(_stepTimer,         &QTimer::timeout,       this, &QGCLockstepHilLink::_stepTimeout);
+    connect(_statisticsTimer,   &QTimer::timeout,       this, &QGCLockstepHilLink::_updateStatistics);
+
+    connect(_vehicle->uas(),    &UAS::hilControlsChanged,               this, &QGCLockstepHilLink::updateControls,          Qt::QueuedConnection);
+    connect(_vehicle,           &Vehicle::hilActuatorControlsChanged,   this, &QGCLockstepHilLink::updateActuatorControls,  Qt::QueuedConnection);
+    connect(this,               &QGCLockstepHilLink::lockstepStateReceived, _vehicle->uas(), &UAS::sendHilLockstepState,    Qt::QueuedConnection);
+
+    _stepPending =  false;
+    _stepTimeouts = 0;
+    _statisticsSteps = 0;
+    _statisticsLatencyNsecs = 0;
+    _statisticsMaxLatencyNsecs = 0;
+    _statisticsElapsed.start();
+    _statisticsTimer->start();
+
+    emit statusMessage(tr("Waiting for simulator on port %1..").arg(_localPort));
+    emit simulationConnected(true);
+    emit simulationConnected();
+
+    exec();
+
+    disconnect(_vehicle->uas(), &UAS::hilControlsChanged,               this, &QGCLockstepHilLink::updateControls);
+    disconnect(_vehicle,        &Vehicle::hilActuatorControlsChanged,   this, &QGCLockstepHilLink::updateActuatorControls);
+    disconnect(this,            &QGCLockstepHilLink::lockstepStateReceived, _vehicle->uas(), &UAS::sendHilLockstepState);
+
+    delete _statisticsTimer;
+    _statisticsTimer = NULL;
+    delete _stepTimer;
+    _stepTimer = NULL;
+    _socket->close();
+    delete _socket;
+    _socket = NULL;
+    _connectState = false;
+
+    emit simulationDisconnected();
+    emit simulationConnected(false);
+}
+
+bool QGCLockstepHilLink::connectSimulation(void)
+{
+    if (!isRunning()) {
+        start(HighPriority);
+    }
+    return true;
+}
+
+bool QGCLockstepHilLink::disconnectSimulation(void)
+{
+    // Thread cleans up once the event loop exits
+    quit();
+    return true;
+}
+
+qint64 QGCLockstepHilLink::bytesAvailable(void)
+{
+    return _socket ? _socket->pendingDatagramSize() : 0;
+}
+
+void QGCLockstepHilLink::setPort(int port)
+{
+    _localPort = port;
+    _name = tr("Lockstep HIL Link (port:%1)").arg(_localPort);
+    if (isRunning()) {
+        disconnectSimulation();
+        wait();
+        connectSimulation();
+    }
+}
+
+QString QGCLockstepHilLink::getRemoteHost(void)
+{
+    return QString("%1:%2").arg(_simulatorHost.toString()).arg(_simulatorPort);
+}
+
+/// Sets where controls are sent until the simulator sends its first state
+///     @param host host:port
+void QGCLockstepHilLink::setRemoteHost(const QString& host)
+{
+    QHostInfo info = QHostInfo::fromName(host.split(":").first());
+    if (info.error() == QHostInfo::NoError && !info.addresses().isEmpty()) {
+        _simulatorHost = info.addresses().first();
+        _simulatorPort = host.split(":").last().toUShort();
+        emit remoteChanged(getRemoteHost());
+    }
+}
+
+void QGCLockstepHilLink::readBytes(void)
+{
+    while (_socket->hasPendingDatagrams()) {
+        QHostAddress    sender;
+        quint16         senderPort;
+        qint64          length = _socket->readDatagram(_rxBuffer, sizeof(_rxBuffer), &sender, &senderPort);
+
+        if (!HilLockstepProtocol::decodeState(_rxBuffer, (int)length, _pendingState)) {
+            continue;
+        }
+
+        if (sender != _simulatorHost || senderPort != _simulatorPort) {
+            _simulatorHost = sender;
+            _simulatorPort = senderPort;
+            emit remoteChanged(getRemoteHost());
+        }
+
+        // A new state replaces a pending one, the simulator has given up on it
+        _stepPending = true;
+        _stepLatencyTimer.start();
+        _stepTimer->start();
+        emit lockstepStateReceived(_pendingState);
+    }
+}
+
+void QGCLockstepHilLink::_stepTimeout(void)
+{
+    if (_stepPending) {
+        _stepTimeouts++;
+        _stepTimer->start();
+        emit lockstepStateReceived(_pendingState);
+    }
+}
+
+void QGCLockstepHilLink::updateControls(quint64 time, float rollAilerons, float pitchElevator, float yawRudder, float throttle, quint8 systemMode, quint8 navMode)
+{
+    Q_UNUSED(navMode);
+
+    HilLockstepControls controls;
+
+    memset(&controls, 0, sizeof(controls));
+    controls.timeUsecs =    time;
+    controls.mode =         systemMode;
+    controls.controls[0] =  rollAilerons;
+    controls.controls[1] =  pitchElevator;
+    controls.controls[2] =  yawRudder;
+    controls.controls[3] =  throttle;
+    _sendControls(controls);
+}
+
+void QGCLockstepHilLink::updateActuatorControls(quint64 time, quint64 flags,
+                                                float ctl_0, float ctl_1, float ctl_2, float ctl_3, float ctl_4, float ctl_5, float ctl_6, float ctl_7,
+                                                float ctl_8, float ctl_9, float ctl_10, float ctl_11, float ctl_12, float ctl_13, float ctl_14, float ctl_15,
+                                                quint8 mode)
+{
+    HilLockstepControls controls;
+
+    controls.timeUsecs =        time;
+    controls.flags =            flags;
+    controls.mode =             mode;
+    controls.controls[0] =      ctl_0;
+    controls.controls[1] =      ctl_1;
+    controls.controls[2] =      ctl_2;
+    controls.controls[3] =      ctl_3;
+    controls.controls[4] =      ctl_4;
+    controls.controls[5] =      ctl_5;
+    controls.controls[6] =      ctl_6;
+    controls.controls[7] =      ctl_7;
+    controls.controls[8] =      ctl_8;
+    controls.controls[9] =      ctl_9;
+    controls.controls[10] =     ctl_10;
+    controls.controls[11] =     ctl_11;
+    controls.controls[12] =     ctl_12;
+    controls.controls[13] =     ctl_13;
+    controls.controls[14] =     ctl_14;
+    controls.controls[15] =     ctl_15;
+    _sendControls(controls);
+}
+
+/// Acknowledges the pending step with the controls. Controls computed before the pending step (time 0 means the autopilot
+/// does not fill in its time) belong to an earlier step and are dropped.
+void QGCLockstepHilLink::_sendControls(HilLockstepControls& controls)
+{
+    if (!_stepPending || !_socket || _simulatorPort == 0) {
+        return;
+    }
+    if (controls.timeUsecs != 0 && controls.timeUsecs < _pendingState.timeUsecs) {
+        return;
+    }
+
+    controls.step = _pendingState.step;
+    int length = HilLockstepProtocol::encodeControls(controls, _txBuffer);
+    _socket->writeDatagram(_txBuffer, length, _simulatorHost, _simulatorPort);
+
+    qint64 latencyNsecs = _stepLatencyTimer.nsecsElapsed();
+    _stepPending = false;
+    _stepTimer->stop();
+    _statisticsSteps++;
+    _statisticsLatencyNsecs += latencyNsecs;
+    _statisticsMaxLatencyNsecs = qMax(_statisticsMaxLatencyNsecs, latencyNsecs);
+}
+
+void QGCLockstepHilLink::_writeBytes(const QByteArray data)
+{
+    if (_socket && _simulatorPort != 0) {
+        _socket->writeDatagram(data, _simulatorHost, _simulatorPort);
+    }
+}
+
+void QGCLockstepHilLink::_updateStatistics(void)
+{
+    qint64  elapsedMsecs =      _statisticsElapsed.restart();
+    double  stepRate =          elapsedMsecs ? (_statisticsSteps * 1000.0) / elapsedMsecs : 0;
+    double  latencyMsecs =      _statisticsSteps ? (_statisticsLatencyNsecs / 1e6) / _statisticsSteps : 0;
+    double  maxLatencyMsecs =   _statisticsMaxLatencyNsecs / 1e6;
+
+    emit lockstepStatisticsChanged(stepRate, latencyMsecs, maxLatencyMsecs, _stepTimeouts);
+
+    _statisticsSteps = 0;
+    _statisticsLatencyNsecs = 0;
+    _statisticsMaxLatencyNsecs = 0;
+}
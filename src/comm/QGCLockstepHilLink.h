@@ -0,0 +1,113 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef QGCLockstepHilLink_H
+#define QGCLockstepHilLink_H
+
+#include <QUdpSocket>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include "QGCHilLink.h"
+#include "HilLockstepProtocol.h"
+
+class Vehicle;
+
+/// Sensor level HIL with a simulator which steps in lockstep with the autopilot (see HilLockstepProtocol).
+///
+/// Each state packet is forwarded to the autopilot as HIL_SENSOR/HIL_GPS stamped with the simulation time. The next
+/// HIL_ACTUATOR_CONTROLS (or HIL_CONTROLS) computed at or after that time acknowledges the step and is sent back to the
+/// simulator. Nothing is throttled or time stamped by wall clock, so runs are reproducible at any speed. If the autopilot
+/// does not answer within stepTimeoutMsecs the state is forwarded again.
+class QGCLockstepHilLink : public QGCHilLink
+{
+    Q_OBJECT
+
+public:
+    QGCLockstepHilLink(Vehicle* vehicle, QHostAddress localHost = QHostAddress::Any, quint16 localPort = 14570);
+    ~QGCLockstepHilLink();
+
+    bool    isConnected         (void) { return _connectState; }
+    qint64  bytesAvailable      (void);
+    int     getPort             (void) const { return _localPort; }
+    QString getName             (void) { return _name; }
+    QString getRemoteHost       (void);
+    QString getVersion          (void) { return tr("Lockstep v%1").arg(HilLockstepProtocol::version); }
+    int     getAirFrameIndex    (void) { return -1; }
+    bool    sensorHilEnabled    (void) { return true; }
+
+    void run(void);
+
+    static const int stepTimeoutMsecs =     200;
+    static const int statisticsMsecs =      1000;
+
+signals:
+    /// Simulator state to forward to the autopilot
+    void lockstepStateReceived(HilLockstepState state);
+
+    /// Emitted every statisticsMsecs while connected
+    ///     @param stepRate Acknowledged steps per second
+    ///     @param controlLatencyMsecs Average time from receiving a state to sending the controls for it
+    ///     @param maxControlLatencyMsecs
+    ///     @param stepTimeouts Steps forwarded again since the start of the simulation
+    void lockstepStatisticsChanged(double stepRate, double controlLatencyMsecs, double maxControlLatencyMsecs, int stepTimeouts);
+
+public slots:
+    void setPort            (int port);
+    void setRemoteHost      (const QString& host);
+    void updateControls     (quint64 time, float rollAilerons, float pitchElevator, float yawRudder, float throttle, quint8 systemMode, quint8 navMode);
+    void updateActuatorControls(quint64 time, quint64 flags,
+                                float ctl_0, float ctl_1, float ctl_2, float ctl_3, float ctl_4, float ctl_5, float ctl_6, float ctl_7,
+                                float ctl_8, float ctl_9, float ctl_10, float ctl_11, float ctl_12, float ctl_13, float ctl_14, float ctl_15,
+                                quint8 mode);
+    void processError       (QProcess::ProcessError err) { Q_UNUSED(err); }
+    void setVersion         (const QString& version) { Q_UNUSED(version); }
+    void enableSensorHIL    (bool enable) { Q_UNUSED(enable); }
+    void selectAirframe     (const QString& airframe) { Q_UNUSED(airframe); }
+    void readBytes          (void);
+    bool connectSimulation  (void);
+    bool disconnectSimulation(void);
+
+private slots:
+    void _writeBytes        (const QByteArray data);
+    void _stepTimeout       (void);
+    void _updateStatistics  (void);
+
+protected:
+    void setName(QString name) { _name = name; }
+
+private:
+    void _sendControls(HilLockstepControls& controls);
+
+    Vehicle*            _vehicle;
+    QString             _name;
+    QHostAddress        _localHost;
+    quint16             _localPort;
+    QHostAddress        _simulatorHost;     ///< Controls go to the sender of the last state packet
+    quint16             _simulatorPort;
+    QUdpSocket*         _socket;
+    QTimer*             _stepTimer;
+    QTimer*             _statisticsTimer;
+    bool                _connectState;
+
+    bool                _stepPending;       ///< true: _pendingState is waiting for controls
+    HilLockstepState    _pendingState;
+    QElapsedTimer       _stepLatencyTimer;
+
+    char                _rxBuffer[HilLockstepProtocol::stateSize + 1];  ///< One byte more to detect oversized datagrams
+    char                _txBuffer[HilLockstepProtocol::controlsSize];
+
+    QElapsedTimer       _statisticsElapsed;
+    int                 _statisticsSteps;
+    qint64              _statisticsLatencyNsecs;
+    qint64              _statisticsMaxLatencyNsecs;
+    int                 _stepTimeouts;
+};
+
+#endif
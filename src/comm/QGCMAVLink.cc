@@ -9,6 +9,48 @@
 
 #include "QGCMAVLink.h"
 
+#include <QDebug>
+
+static mavlink_status_t     _internalChannelStatus;                         ///< Channel 0 is reserved for internal use
+static mavlink_status_t     _unassignedChannelStatus;                       ///< Scratch status for channels nobody owns
+static mavlink_status_t*    _channelStatus[QGCMAVLink::maxChannels] = { &_internalChannelStatus };
+
+mavlink_status_t* mavlink_get_channel_status(uint8_t chan)
+{
+    mavlink_status_t* status = _channelStatus[chan];
+    return status ? status : &_unassignedChannelStatus;
+}
+
+void QGCMAVLink::setChannelStatus(uint8_t channel, mavlink_status_t* status)
+{
+    if (channel == 0) {
+        qWarning() << "QGCMAVLink::setChannelStatus channel 0 is reserved";
+        return;
+    }
+    _channelStatus[channel] = status;
+}
+
+uint8_t QGCMAVLink::parseChar(mavlink_message_t* rxBuffer, mavlink_status_t* rxStatus, uint8_t c, mavlink_message_t* message, mavlink_status_t* status)
+{
+    uint8_t msgReceived = mavlink_frame_char_buffer(rxBuffer, rxStatus, c, message, status);
+
+    if (msgReceived == MAVLINK_FRAMING_BAD_CRC || msgReceived == MAVLINK_FRAMING_BAD_SIGNATURE) {
+        // Treat as a parse failure and restart parsing, same as mavlink_parse_char. mavlink_parse_char counts the
+        // error in rxStatus, which only shows up in status after the next character, report it right away instead.
+        status->packet_rx_drop_count++;
+        rxStatus->msg_received = MAVLINK_FRAMING_INCOMPLETE;
+        rxStatus->parse_state = MAVLINK_PARSE_STATE_IDLE;
+        if (c == MAVLINK_STX) {
+            rxStatus->parse_state = MAVLINK_PARSE_STATE_GOT_STX;
+            rxBuffer->len = 0;
+            mavlink_start_checksum(rxBuffer);
+        }
+        return 0;
+    }
+
+    return msgReceived;
+}
+
 bool QGCMAVLink::isFixedWing(MAV_TYPE mavType)
 {
     return mavType == MAV_TYPE_FIXED_WING;
@@ -18,14 +18,27 @@
 #define QGCMAVLINK_H
 
 #define MAVLINK_USE_MESSAGE_INFO
-#define MAVLINK_EXTERNAL_RX_STATUS  // Single m_mavlink_status instance is in QGCApplication.cc
+#define MAVLINK_GET_CHANNEL_STATUS  // Channel status is owned by each link, see QGCMAVLink::setChannelStatus
 #include <stddef.h>                 // Hack workaround for Mav 2.0 header problem with respect to offsetof usage
 #include <mavlink_types.h>
-extern mavlink_status_t m_mavlink_status[MAVLINK_COMM_NUM_BUFFERS];
+mavlink_status_t* mavlink_get_channel_status(uint8_t chan);
 #include <mavlink.h>
 
 class QGCMAVLink {
 public:
+    /// Number of channel ids which can be addressed by the mavlink_msg_*_pack_chan api. Channel 0 is reserved for internal use.
+    static const int maxChannels = 256;
+
+    /// Associates the outbound status (sequence numbers, protocol version flags) of a channel with the object which owns it.
+    ///     @param status Status to use for channel, NULL to release the channel
+    static void setChannelStatus(uint8_t channel, mavlink_status_t* status);
+
+    /// Same as mavlink_parse_char but works on the specified parser state instead of the fixed size channel tables.
+    ///     @param rxBuffer Parser buffer
+    ///     @param rxStatus Parser status
+    ///     @param status Returns the parser state after c, packet_rx_drop_count is the number of parse errors c caused
+    static uint8_t parseChar(mavlink_message_t* rxBuffer, mavlink_status_t* rxStatus, uint8_t c, mavlink_message_t* message, mavlink_status_t* status);
+
     static bool isFixedWing(MAV_TYPE mavType);
     static bool isRover(MAV_TYPE mavType);
     static bool isSub(MAV_TYPE mavType);
@@ -0,0 +1,227 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "SerialPortWatcher.h"
+#include "QGCSerialPortInfo.h"
+#include "QGCLoggingCategory.h"
+
+#include <QSocketNotifier>
+#include <QFileInfo>
+
+#ifdef QGC_SERIAL_PORT_WATCHER_NETLINK
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#endif
+
+QGC_LOGGING_CATEGORY(SerialPortWatcherLog, "SerialPortWatcherLog")
+
+SerialPortWatcher::SerialPortWatcher(Backend_t backend, QObject* parent)
+    : QObject(parent)
+    , _backend(backend)
+    , _netlinkSocket(-1)
+    , _netlinkNotifier(NULL)
+{
+    _pollTimer.setInterval(cPollIntervalMSecs);
+    _pollTimer.setSingleShot(false);
+    connect(&_pollTimer, &QTimer::timeout, this, &SerialPortWatcher::_poll);
+}
+
+SerialPortWatcher::~SerialPortWatcher()
+{
+    delete _netlinkNotifier;
+#ifdef QGC_SERIAL_PORT_WATCHER_NETLINK
+    if (_netlinkSocket != -1) {
+        ::close(_netlinkSocket);
+    }
+#endif
+}
+
+void SerialPortWatcher::start(void)
+{
+    if (_backend == BackendAuto || _backend == BackendNetlink) {
+        _backend = _openNetlink() ? BackendNetlink : BackendPolling;
+    }
+    qCDebug(SerialPortWatcherLog) << "Backend" << _backend;
+
+    if (_backend == BackendManual) {
+        return;
+    }
+
+    _poll();
+    if (_backend == BackendPolling) {
+        _pollTimer.start();
+    }
+}
+
+void SerialPortWatcher::setPollingEnabled(bool enabled)
+{
+    if (_backend != BackendPolling) {
+        return;
+    }
+    if (enabled && !_pollTimer.isActive()) {
+        _pollTimer.start();
+    } else if (!enabled) {
+        _pollTimer.stop();
+    }
+}
+
+void SerialPortWatcher::_poll(void)
+{
+    QSet<QString> ports;
+
+    foreach (const QGCSerialPortInfo& portInfo, QGCSerialPortInfo::availablePorts()) {
+        ports.insert(portInfo.systemLocation());
+    }
+    _setPorts(ports);
+}
+
+void SerialPortWatcher::_setPorts(const QSet<QString>& ports)
+{
+    QSet<QString> removed = _ports - ports;
+    QSet<QString> added = ports - _ports;
+
+    _ports = ports;
+
+    foreach (const QString& systemLocation, removed) {
+        qCDebug(SerialPortWatcherLog) << "Port removed" << systemLocation;
+        emit portRemoved(systemLocation);
+    }
+    foreach (const QString& systemLocation, added) {
+        qCDebug(SerialPortWatcherLog) << "Port added" << systemLocation;
+        emit portAdded(systemLocation);
+    }
+}
+
+bool SerialPortWatcher::_openNetlink(void)
+{
+#ifdef QGC_SERIAL_PORT_WATCHER_NETLINK
+    // Listen to udev if it is running, so the device node and its permissions are ready when the event arrives.
+    // Without udev (containers, minimal systems) the kernel events are all there is.
+    const unsigned int kernelGroup =    1;
+    const unsigned int udevGroup =      2;
+    bool udevRunning = QFileInfo::exists(QStringLiteral("/run/udev/control"));
+
+    _netlinkSocket = ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+    if (_netlinkSocket == -1) {
+        qCWarning(SerialPortWatcherLog) << "Unable to open netlink socket, falling back to polling" << strerror(errno);
+        return false;
+    }
+
+    struct sockaddr_nl address;
+    memset(&address, 0, sizeof(address));
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = udevRunning ? udevGroup : kernelGroup;
+    if (::bind(_netlinkSocket, (struct sockaddr*)&address, sizeof(address)) == -1) {
+        qCWarning(SerialPortWatcherLog) << "Unable to bind netlink socket, falling back to polling" << strerror(errno);
+        ::close(_netlinkSocket);
+        _netlinkSocket = -1;
+        return false;
+    }
+
+    _netlinkNotifier = new QSocketNotifier(_netlinkSocket, QSocketNotifier::Read, this);
+    connect(_netlinkNotifier, &QSocketNotifier::activated, this, &SerialPortWatcher::_readNetlink);
+
+    qCDebug(SerialPortWatcherLog) << "Listening for hot-plug events from" << (udevRunning ? "udev" : "kernel");
+    return true;
+#else
+    return false;
+#endif
+}
+
+void SerialPortWatcher::_readNetlink(void)
+{
+#ifdef QGC_SERIAL_PORT_WATCHER_NETLINK
+    char buffer[8192];
+
+    while (true) {
+        ssize_t cBytes = ::recv(_netlinkSocket, buffer, sizeof(buffer), 0);
+        if (cBytes <= 0) {
+            break;
+        }
+        processUevent(QByteArray::fromRawData(buffer, cBytes));
+    }
+#endif
+}
+
+void SerialPortWatcher::processUevent(const QByteArray& uevent)
+{
+    // udev monitor messages: "libudev\0" header with the offset and length of the properties.
+    // Kernel messages: "action@devpath\0" followed by the properties.
+    const int cbUdevHeaderMin = 24;
+    int propertiesStart = 0;
+    int propertiesEnd = uevent.count();
+
+    if (uevent.startsWith(QByteArray("libudev\0", 8))) {
+        if (uevent.count() < cbUdevHeaderMin) {
+            return;
+        }
+        quint32 propertiesOffset;
+        quint32 propertiesLength;
+        memcpy(&propertiesOffset, uevent.constData() + 16, sizeof(propertiesOffset));
+        memcpy(&propertiesLength, uevent.constData() + 20, sizeof(propertiesLength));
+        if (propertiesOffset > (quint32)uevent.count() || propertiesLength > (quint32)uevent.count() - propertiesOffset) {
+            return;
+        }
+        propertiesStart = propertiesOffset;
+        propertiesEnd = propertiesOffset + propertiesLength;
+    } else {
+        propertiesStart = uevent.indexOf('\0') + 1;
+        if (propertiesStart == 0) {
+            return;
+        }
+    }
+
+    QByteArray action;
+    QByteArray subsystem;
+    QByteArray devName;
+    QByteArray devPath;
+
+    int position = propertiesStart;
+    while (position < propertiesEnd) {
+        int end = uevent.indexOf('\0', position);
+        if (end == -1 || end > propertiesEnd) {
+            end = propertiesEnd;
+        }
+        QByteArray property = uevent.mid(position, end - position);
+        position = end + 1;
+
+        if (property.startsWith("ACTION=")) {
+            action = property.mid(7);
+        } else if (property.startsWith("SUBSYSTEM=")) {
+            subsystem = property.mid(10);
+        } else if (property.startsWith("DEVNAME=")) {
+            devName = property.mid(8);
+        } else if (property.startsWith("DEVPATH=")) {
+            devPath = property.mid(8);
+        }
+    }
+
+    // Virtual ttys (consoles, ptys) are not serial ports
+    if (subsystem != "tty" || devName.isEmpty() || devPath.startsWith("/devices/virtual/")) {
+        return;
+    }
+
+    QString systemLocation = QString::fromLocal8Bit(devName);
+    if (!systemLocation.startsWith(QLatin1Char('/'))) {
+        systemLocation.prepend(QStringLiteral("/dev/"));
+    }
+
+    QSet<QString> ports = _ports;
+    if (action == "add") {
+        ports.insert(systemLocation);
+    } else if (action == "remove") {
+        ports.remove(systemLocation);
+    } else {
+        return;
+    }
+    _setPorts(ports);
+}
@@ -0,0 +1,84 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef SerialPortWatcher_H
+#define SerialPortWatcher_H
+
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+#include <QLoggingCategory>
+
+class QSocketNotifier;
+
+Q_DECLARE_LOGGING_CATEGORY(SerialPortWatcherLog)
+
+#if defined(Q_OS_LINUX) && !defined(__android__)
+#define QGC_SERIAL_PORT_WATCHER_NETLINK
+#endif
+
+/// Keeps track of which serial ports are present and signals when ports come and go. On Linux the kernel/udev
+/// hot-plug events are read from a netlink socket, so nothing is enumerated until a device actually changes.
+/// Everywhere else, or if the socket can't be opened, the port list is polled.
+class SerialPortWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef enum {
+        BackendAuto,        ///< Netlink if available, polling otherwise
+        BackendNetlink,
+        BackendPolling,
+        BackendManual,      ///< No event source, events are only delivered through processUevent
+    } Backend_t;
+
+    SerialPortWatcher(Backend_t backend = BackendAuto, QObject* parent = NULL);
+    ~SerialPortWatcher();
+
+    /// Starts watching. The initial port list is read once.
+    void start(void);
+
+    /// @return Backend actually in use
+    Backend_t backend(void) const { return _backend; }
+
+    /// @return System locations (for example /dev/ttyACM0) of the ports currently present
+    QStringList ports(void) const { return _ports.toList(); }
+
+    bool containsPort(const QString& systemLocation) const { return _ports.contains(systemLocation); }
+
+    /// Turns polling on/off. Only affects the polling backend.
+    void setPollingEnabled(bool enabled);
+
+    /// Processes one raw uevent in either kernel or udev monitor format. Called for each netlink message,
+    /// public so tests can act as the event source.
+    void processUevent(const QByteArray& uevent);
+
+    static const int cPollIntervalMSecs = 1000;
+
+signals:
+    void portAdded(const QString& systemLocation);
+    void portRemoved(const QString& systemLocation);
+
+private slots:
+    void _poll(void);
+    void _readNetlink(void);
+
+private:
+    bool _openNetlink(void);
+    void _setPorts(const QSet<QString>& ports);
+
+    Backend_t           _backend;
+    QSet<QString>       _ports;
+    QTimer              _pollTimer;
+    int                 _netlinkSocket;
+    QSocketNotifier*    _netlinkNotifier;
+};
+
+#endif
@@ -26,6 +26,7 @@
 #include <QStringListModel>
 #include "QGCApplication.h"
 #include "AppMessages.h"
+#include "QGCStartupProfiler.h"
 
 #ifndef __mobile__
     #include "QGCSerialPortInfo.h"
@@ -36,6 +37,10 @@
     #include "UnitTest.h"
 #endif
 
+#ifdef QGC_BENCHMARK_BUILD
+    #include "TelemetryBenchmark.h"
+#endif
+
 #ifdef QT_DEBUG
     #include "CmdLineOptParser.h"
     #ifdef Q_OS_WIN
@@ -102,6 +107,9 @@ jint JNI_OnLoad(JavaVM* vm, void* reserved)
 
 int main(int argc, char *argv[])
 {
+    // Startup times are relative to this
+    QGCStartupProfiler::instance();
+
 #ifndef __mobile__
     RunGuard guard("QGroundControlRunGuardKey");
     if (!guard.tryToRun()) {
@@ -169,6 +177,7 @@ int main(int argc, char *argv[])
     Q_IMPORT_PLUGIN(QGeoServiceProviderFactoryQGC)
 
     bool runUnitTests = false;          // Run unit tests
+    bool runBenchmarks = false;         // Run telemetry benchmarks
 
 #ifdef QT_DEBUG
     // We parse a small set of command line options here prior to QGCApplication in order to handle the ones
@@ -178,10 +187,19 @@ int main(int argc, char *argv[])
     bool quietWindowsAsserts = false;   // Don't let asserts pop dialog boxes
 
     QString unitTestOptions;
+#ifdef QGC_BENCHMARK_BUILD
+    QString benchmarkOutputFile;        // Benchmark results file, stdout if empty
+    QString benchmarkTlogFile;          // Recorded traffic to replay
+    bool benchmarkTlog = false;
+#endif
     CmdLineOpt_t rgCmdLineOptions[] = {
         { "--unittest",             &runUnitTests,          &unitTestOptions },
         { "--unittest-stress",      &stressUnitTests,       &unitTestOptions },
         { "--no-windows-assert-ui", &quietWindowsAsserts,   NULL },
+#ifdef QGC_BENCHMARK_BUILD
+        { "--benchmark",            &runBenchmarks,         &benchmarkOutputFile },
+        { "--benchmark-tlog",       &benchmarkTlog,         &benchmarkTlogFile },
+#endif
         // Add additional command line option flags here
     };
 
@@ -206,8 +224,12 @@ int main(int argc, char *argv[])
 #endif
 #endif // QT_DEBUG
 
-    QGCApplication* app = new QGCApplication(argc, argv, runUnitTests);
-    Q_CHECK_PTR(app);
+    QGCApplication* app;
+    {
+        QGCStartupTimer timer("startup", QStringLiteral("QGCApplication"));
+        app = new QGCApplication(argc, argv, runUnitTests || runBenchmarks);
+        Q_CHECK_PTR(app);
+    }
 
 #ifdef Q_OS_LINUX
     QApplication::setWindowIcon(QIcon(":/res/resources/icons/qgroundcontrol.ico"));
@@ -220,9 +242,15 @@ int main(int argc, char *argv[])
     // on in the code.
     qRegisterMetaType<QList<QPair<QByteArray,QByteArray> > >();
 
-    app->_initCommon();
-    //-- Initialize Cache System
-    getQGCMapEngine()->init();
+    {
+        QGCStartupTimer timer("startup", QStringLiteral("_initCommon"));
+        app->_initCommon();
+    }
+    //-- Initialize Cache System. The database work itself is done by the cache worker thread.
+    {
+        QGCStartupTimer timer("startup", QStringLiteral("QGCMapEngine::init"));
+        getQGCMapEngine()->init();
+    }
 
     int exitCode = 0;
 
@@ -246,10 +274,21 @@ int main(int argc, char *argv[])
         }
     } else
 #endif
-    {
-        if (!app->_initForNormalAppBoot()) {
+#ifdef QGC_BENCHMARK_BUILD
+    if (runBenchmarks) {
+        if (!app->_initForUnitTests()) {
             return -1;
         }
+        exitCode = TelemetryBenchmark(benchmarkOutputFile, benchmarkTlogFile).run();
+    } else
+#endif
+    {
+        {
+            QGCStartupTimer timer("startup", QStringLiteral("_initForNormalAppBoot"));
+            if (!app->_initForNormalAppBoot()) {
+                return -1;
+            }
+        }
         exitCode = app->exec();
     }
 
@@ -0,0 +1,94 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "Crc32Test.h"
+#include "QGC.h"
+
+#include <QByteArray>
+
+/// Reference implementation: the original one byte at a time loop, with the table entries computed bit by bit
+quint32 Crc32Test::_bytewiseCrc32(const quint8* src, unsigned len, quint32 state)
+{
+    for (unsigned i = 0; i < len; i++) {
+        quint32 entry = (state ^ src[i]) & 0xff;
+        for (int bit = 0; bit < 8; bit++) {
+            entry = (entry & 1) ? (entry >> 1) ^ 0xedb88320 : entry >> 1;
+        }
+        state = entry ^ (state >> 8);
+    }
+    return state;
+}
+
+void Crc32Test::_knownVectors_test(void)
+{
+    static const struct {
+        const char* data;
+        quint32     crc;
+    } rgVectors[] = {
+        { "",                                               0x00000000 },
+        { "a",                                              0xe8b7be43 },
+        { "abc",                                            0x352441c2 },
+        { "123456789",                                      0xcbf43926 },
+        { "message digest",                                 0x20159d7f },
+        { "The quick brown fox jumps over the lazy dog",    0x414fa339 },
+    };
+
+    for (size_t i = 0; i < sizeof(rgVectors) / sizeof(rgVectors[0]); i++) {
+        const quint8*   data = (const quint8*)rgVectors[i].data;
+        unsigned        len = (unsigned)qstrlen(rgVectors[i].data);
+
+        // QGC::crc32 is the raw update step, the standard check value adds the initial and final inversion
+        QCOMPARE(QGC::crc32(data, len, 0xffffffff) ^ 0xffffffff, rgVectors[i].crc);
+        QCOMPARE(QGC::crc32(data, len, 0), _bytewiseCrc32(data, len, 0));
+    }
+
+    // 2MB of 0xFF, the flash fill the bootloader checks against
+    QByteArray fill(2 * 1024 * 1024, (char)0xff);
+    QCOMPARE(QGC::crc32((const quint8*)fill.constData(), fill.size(), 0), _bytewiseCrc32((const quint8*)fill.constData(), fill.size(), 0));
+}
+
+// Every length and alignment around the eight byte step must match the original implementation
+void Crc32Test::_matchesBytewise_test(void)
+{
+    QByteArray buffer(256, 0);
+    for (int i = 0; i < buffer.size(); i++) {
+        buffer[i] = (char)((i * 37 + 11) & 0xff);
+    }
+    const quint8* data = (const quint8*)buffer.constData();
+
+    for (unsigned offset = 0; offset < 8; offset++) {
+        for (unsigned len = 0; len <= 64; len++) {
+            QCOMPARE(QGC::crc32(data + offset, len, 0), _bytewiseCrc32(data + offset, len, 0));
+            QCOMPARE(QGC::crc32(data + offset, len, 0x12345678), _bytewiseCrc32(data + offset, len, 0x12345678));
+        }
+    }
+}
+
+// Feeding the data in pieces must give the same result as a single call
+void Crc32Test::_chunked_test(void)
+{
+    QByteArray buffer(1000, 0);
+    for (int i = 0; i < buffer.size(); i++) {
+        buffer[i] = (char)((i * 131 + 7) & 0xff);
+    }
+    const quint8*   data = (const quint8*)buffer.constData();
+    quint32         expected = QGC::crc32(data, buffer.size(), 0);
+
+    static const unsigned rgChunkSizes[] = { 1, 3, 7, 8, 9, 252, 256 };
+    for (size_t i = 0; i < sizeof(rgChunkSizes) / sizeof(rgChunkSizes[0]); i++) {
+        quint32     crc = 0;
+        unsigned    done = 0;
+        while (done < (unsigned)buffer.size()) {
+            unsigned chunk = qMin(rgChunkSizes[i], (unsigned)buffer.size() - done);
+            crc = QGC::crc32(data + done, chunk, crc);
+            done += chunk;
+        }
+        QCOMPARE(crc, expected);
+    }
+}
@@ -0,0 +1,29 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef Crc32Test_H
+#define Crc32Test_H
+
+#include "UnitTest.h"
+
+/// Unit test for QGC::crc32
+class Crc32Test : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _knownVectors_test(void);
+    void _matchesBytewise_test(void);
+    void _chunked_test(void);
+
+private:
+    static quint32 _bytewiseCrc32(const quint8* src, unsigned len, quint32 state);
+};
+
+#endif
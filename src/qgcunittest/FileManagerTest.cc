@@ -41,6 +41,7 @@ void FileManagerTest::init(void)
     
     // Reset any internal state back to normal
     _fileServer->setErrorMode(MockLinkFileServer::errModeNone);
+    _fileServer->setMaxSessions(FileManager::maxDownloadSessions);
     _fileListReceived.clear();
 
     connect(_fileManager, &FileManager::listEntry, this, &FileManagerTest::listEntry);
@@ -199,178 +200,255 @@ void FileManagerTest::_listTest(void)
     _fileServer->enableRandromDrops(false);
 }
 
-#if 0
-// Trying to write test code for read and burst mode download as well as implement support in MockLineFileServer reached a point
-// of diminishing returns where the test code and mock server were generating more bugs in themselves than finding problems.
+void FileManagerTest::_gapsTest(void)
+{
+    FileManagerGaps gaps;
+
+    gaps.reset(1000);
+    QCOMPARE(gaps.count(), 1);
+    QCOMPARE(gaps.missingBytes(), (uint32_t)1000);
+    QCOMPARE(gaps.nextGap(500), (uint32_t)500);
+
+    // Blocks in order
+    gaps.received(0, 100);
+    gaps.received(100, 100);
+    QCOMPARE(gaps.count(), 1);
+    QCOMPARE(gaps.missingBytes(), (uint32_t)800);
+    QCOMPARE(gaps.nextGap(0), (uint32_t)200);
+
+    // Dropped blocks leave holes behind
+    gaps.received(300, 100);
+    gaps.received(600, 100);
+    QCOMPARE(gaps.count(), 3);
+    QCOMPARE(gaps.missingBytes(), (uint32_t)600);
+    QCOMPARE(gaps.nextGap(350), (uint32_t)400);
+    QCOMPARE(gaps.nextGap(700), (uint32_t)700);
+
+    // Duplicates change nothing
+    gaps.received(300, 100);
+    QCOMPARE(gaps.count(), 3);
+    QCOMPARE(gaps.missingBytes(), (uint32_t)600);
+
+    // A block overlapping several gaps
+    gaps.received(250, 400);
+    QCOMPARE(gaps.count(), 2);
+    QCOMPARE(gaps.missingBytes(), (uint32_t)350);
+    QCOMPARE(gaps.nextGap(0), (uint32_t)200);
+
+    // Past the last gap wraps around to the first one
+    gaps.received(700, 300);
+    QCOMPARE(gaps.nextGap(900), (uint32_t)200);
+
+    gaps.received(200, 50);
+    QCOMPARE(gaps.count(), 0);
+    QVERIFY(gaps.isEmpty());
+    QCOMPARE(gaps.missingBytes(), (uint32_t)0);
+
+    gaps.reset(0);
+    QVERIFY(gaps.isEmpty());
+}
+
 void FileManagerTest::_readDownloadTest(void)
+{
+    _downloadTest(false /* stream */);
+}
+
+void FileManagerTest::_streamDownloadTest(void)
+{
+    _downloadTest(true /* stream */);
+}
+
+/// Runs each file test case through a successful download, followed by each of the server failure modes
+///     @param stream true: download using Burst reads, false: download using Read
+void FileManagerTest::_downloadTest(bool stream)
 {
     Q_ASSERT(_fileManager);
     Q_ASSERT(_multiSpy);
     Q_ASSERT(_multiSpy->checkNoSignals() == true);
     
-    // We setup a spy on the Reset command signal of the mock file server so that we can determine that a
-    // Reset command was correctly sent after the Open/Read commands complete.
+    // Each download closes its own session with a Terminate command. Reset is only used to clean up after a failed Open,
+    // since it would close the sessions of all other downloads as well.
+    QSignalSpy terminateSpy(_fileServer, SIGNAL(terminateCommandReceived()));
     QSignalSpy resetSpy(_fileServer, SIGNAL(resetCommandReceived()));
     
     // Send a bogus path
-    _fileManager->downloadPath("bogus", QDir::temp());
-    _multiSpy->waitForSignalByIndex(commandErrorSignalIndex, _ackTimerTimeoutMsecs);
+    _startDownload("bogus", stream);
+    _waitForDownloads(1);
     QCOMPARE(_multiSpy->checkOnlySignalByMask(commandErrorSignalMask), true);
     _multiSpy->clearAllSignals();
+    QCOMPARE(terminateSpy.count(), 0);
     QCOMPARE(resetSpy.count(), 0);
 
-    // Clean previous downloads
-    for (size_t i=0; i<MockLinkFileServer::cFileTestCases; i++) {
-        QString filePath = QDir::temp().absoluteFilePath(MockLinkFileServer::rgFileTestCases[i].filename);
-        if (QFile::exists(filePath)) {
-            Q_ASSERT(QFile::remove(filePath));
-        }
-    }
+    _cleanDownloads();
     
     // Run through the set of file test cases
     for (size_t i=0; i<MockLinkFileServer::cFileTestCases; i++) {
         const MockLinkFileServer::FileTestCase* testCase = &MockLinkFileServer::rgFileTestCases[i];
+        QString filePath = QDir::temp().absoluteFilePath(testCase->filename);
+        
+        // Run what should be a successful file download test case. No servers errors are being simulated.
+        _startDownload(testCase->filename, stream);
+        _waitForDownloads(1);
+        QCOMPARE(_multiSpy->checkOnlySignalByMask(commandCompleteSignalMask), true);
+        QCOMPARE(terminateSpy.count(), 1);
+        QCOMPARE(resetSpy.count(), 0);
+        _validateFileContents(filePath, testCase->length);
+        _multiSpy->clearAllSignals();
+        terminateSpy.clear();
         
         // Run through the various failure modes for this test case
         for (size_t j=0; j<MockLinkFileServer::cFailureModes; j++) {
-            qDebug() << "Testing successful download";
-			
-            // Run what should be a successful file download test case. No servers errors are being simulated.
-            _fileServer->setErrorMode(MockLinkFileServer::errModeNone);
-            _fileManager->downloadPath(testCase->filename, QDir::temp());
-            QTest::qWait(_ackTimerTimeoutMsecs); // Let the file manager timeout
-            
-            // This should be a successful download
-            QCOMPARE(_multiSpy->checkOnlySignalByMask(commandCompleteSignalMask), true);
-            _multiSpy->clearAllSignals();
-            
-            // We should get a single Reset command to close the session
-            QCOMPARE(resetSpy.count(), 1);
-            resetSpy.clear();
-            
-            // Validate file contents
-            QString filePath = QDir::temp().absoluteFilePath(MockLinkFileServer::rgFileTestCases[i].filename);
-            _validateFileContents(filePath, MockLinkFileServer::rgFileTestCases[i].length);
             MockLinkFileServer::ErrorMode_t errMode = MockLinkFileServer::rgFailureModes[j];
             
-            qDebug() << "Testing failure mode:" << errMode;
+            QFile::remove(filePath);
             _fileServer->setErrorMode(errMode);
+            _startDownload(testCase->filename, stream);
+            _waitForDownloads(1);
             
-            _fileManager->downloadPath(testCase->filename, QDir::temp());
-            QTest::qWait(_ackTimerTimeoutMsecs); // Let the file manager timeout
-            
-            if (errMode == MockLinkFileServer::errModeNakResponse) {
-                // This will Nak the Open call which will fail the download, but not cause a Reset
+            switch (errMode) {
+            case MockLinkFileServer::errModeNoResponse:
+                // Open times out, the vehicle may still have opened a session which is cleaned up with a Reset
+                QCOMPARE(_multiSpy->checkOnlySignalByMask(commandErrorSignalMask), true);
+                QCOMPARE(terminateSpy.count(), 0);
+                QCOMPARE(resetSpy.count(), 1);
+                break;
+                
+            case MockLinkFileServer::errModeNakResponse:
+                // Open is Nak'ed, so there is no session to close
                 QCOMPARE(_multiSpy->checkOnlySignalByMask(commandErrorSignalMask), true);
+                QCOMPARE(terminateSpy.count(), 0);
                 QCOMPARE(resetSpy.count(), 0);
-            } else {
-                if (testCase->packetCount == 1 && (errMode == MockLinkFileServer::errModeNoSecondResponse || errMode == MockLinkFileServer::errModeNakSecondResponse)) {
-                    // The downloaded file fits within a single Ack response, hence there is no second Read issued.
-                    // This should result in a successful download, followed by a Reset
+                break;
+                
+            case MockLinkFileServer::errModeBadSequence:
+                // The Open Ack is dropped and the session cleaned up with a Reset. The Ack to the Reset has a bad sequence
+                // number as well, which is a second error.
+                QCOMPARE(_multiSpy->checkOnlySignalsByMask(commandErrorSignalMask), true);
+                QCOMPARE(terminateSpy.count(), 0);
+                QCOMPARE(resetSpy.count(), 1);
+                break;
+                
+            default:
+                if (testCase->packetCount == 1) {
+                    // The downloaded file fits within a single Ack response, hence there is no second request which could fail
                     QCOMPARE(_multiSpy->checkOnlySignalByMask(commandCompleteSignalMask), true);
-                    QCOMPARE(resetSpy.count(), 1);
-                    
-                    // Validate file contents
-                    QString filePath = QDir::temp().absoluteFilePath(testCase->filename);
+                    QCOMPARE(terminateSpy.count(), 1);
+                    QCOMPARE(resetSpy.count(), 0);
                     _validateFileContents(filePath, testCase->length);
                 } else {
-                    // Download should have failed, followed by a aReset
+                    // Download fails on the second part of the file, the session is still closed
                     QCOMPARE(_multiSpy->checkOnlySignalByMask(commandErrorSignalMask), true);
-                    QCOMPARE(resetSpy.count(), 1);
+                    QCOMPARE(terminateSpy.count(), 1);
+                    QCOMPARE(resetSpy.count(), 0);
                 }
+                break;
+            }
+            
+            // A failed download must not leave a partial file behind
+            if (_multiSpy->getSpyByIndex(commandErrorSignalIndex)->count() != 0) {
+                QVERIFY(!QFile::exists(filePath));
             }
 
             // Cleanup for next iteration
             _multiSpy->clearAllSignals();
+            terminateSpy.clear();
             resetSpy.clear();
             _fileServer->setErrorMode(MockLinkFileServer::errModeNone);
         }
     }
 }
 
-void FileManagerTest::_streamDownloadTest(void)
+void FileManagerTest::_crcMismatchTest(void)
+{
+    Q_ASSERT(_fileManager);
+    Q_ASSERT(_multiSpy);
+    Q_ASSERT(_multiSpy->checkNoSignals() == true);
+    
+    QSignalSpy terminateSpy(_fileServer, SIGNAL(terminateCommandReceived()));
+    
+    _cleanDownloads();
+    
+    // All bytes come down, but the CRC the vehicle calculates doesn't match what we received
+    _fileServer->setErrorMode(MockLinkFileServer::errModeBadCrc);
+    
+    for (int i=0; i<2; i++) {
+        bool stream = i == 1;
+        const MockLinkFileServer::FileTestCase* testCase = &MockLinkFileServer::rgFileTestCases[MockLinkFileServer::cFileTestCases - 1];
+        
+        _startDownload(testCase->filename, stream);
+        _waitForDownloads(1);
+        
+        // The session is closed before the file is verified, the file is thrown away once verification fails
+        QCOMPARE(_multiSpy->checkOnlySignalByMask(commandErrorSignalMask), true);
+        QCOMPARE(terminateSpy.count(), 1);
+        QVERIFY(!QFile::exists(QDir::temp().absoluteFilePath(testCase->filename)));
+        
+        _multiSpy->clearAllSignals();
+        terminateSpy.clear();
+    }
+}
+
+void FileManagerTest::_concurrentDownloadTest(void)
 {
     Q_ASSERT(_fileManager);
     Q_ASSERT(_multiSpy);
     Q_ASSERT(_multiSpy->checkNoSignals() == true);
     
-    // We setup a spy on the Reset command signal of the mock file server so that we can determine that a
-    // Reset command was correctly sent after the Open/Read commands complete.
+    QSignalSpy terminateSpy(_fileServer, SIGNAL(terminateCommandReceived()));
     QSignalSpy resetSpy(_fileServer, SIGNAL(resetCommandReceived()));
+    QSignalSpy downloadCompleteSpy(_fileManager, SIGNAL(downloadComplete(const QString&)));
     
-    // Send a bogus path
-    _fileManager->streamPath("bogus", QDir::temp());
-    _multiSpy->waitForSignalByIndex(commandErrorSignalIndex, _ackTimerTimeoutMsecs);
-    QCOMPARE(_multiSpy->checkOnlySignalByMask(commandErrorSignalMask), true);
-    _multiSpy->clearAllSignals();
+    _cleanDownloads();
+    
+    // The vehicle has less sessions than there are downloads. The last download is Nak'ed with kErrNoSessionsAvailable
+    // and has to wait for one of the others to finish. The multi packet file goes first so it is still running by then.
+    _fileServer->setMaxSessions(MockLinkFileServer::cFileTestCases - 1);
+    for (int i=(int)MockLinkFileServer::cFileTestCases - 1; i>=0; i--) {
+        _fileManager->downloadPath(MockLinkFileServer::rgFileTestCases[i].filename, QDir::temp());
+    }
+    _waitForDownloads((int)MockLinkFileServer::cFileTestCases);
+    
+    // Running out of sessions is not an error. Each download closes its own session, without resetting the others.
+    QCOMPARE(_multiSpy->getSpyByIndex(commandCompleteSignalIndex)->count(), (int)MockLinkFileServer::cFileTestCases);
+    QCOMPARE(_multiSpy->checkNoSignalByMask(commandErrorSignalMask), true);
+    QCOMPARE(downloadCompleteSpy.count(), (int)MockLinkFileServer::cFileTestCases);
+    QCOMPARE(terminateSpy.count(), (int)MockLinkFileServer::cFileTestCases);
     QCOMPARE(resetSpy.count(), 0);
-
-    // Clean previous downloads
+    
     for (size_t i=0; i<MockLinkFileServer::cFileTestCases; i++) {
-        QString filePath = QDir::temp().absoluteFilePath(MockLinkFileServer::rgFileTestCases[i].filename);
-        if (QFile::exists(filePath)) {
-            Q_ASSERT(QFile::remove(filePath));
-        }
+        _validateFileContents(QDir::temp().absoluteFilePath(MockLinkFileServer::rgFileTestCases[i].filename), MockLinkFileServer::rgFileTestCases[i].length);
+    }
+}
+
+void FileManagerTest::_startDownload(const QString& filename, bool stream)
+{
+    if (stream) {
+        _fileManager->streamPath(filename, QDir::temp());
+    } else {
+        _fileManager->downloadPath(filename, QDir::temp());
     }
+}
+
+/// Waits until the specified number of downloads either completed or failed
+void FileManagerTest::_waitForDownloads(int count)
+{
+    QElapsedTimer timer;
     
-    // Run through the set of file test cases
-    for (size_t i=0; i<MockLinkFileServer::cFileTestCases; i++) {
-        const MockLinkFileServer::FileTestCase* testCase = &MockLinkFileServer::rgFileTestCases[i];
-        
-        // Run through the various failure modes for this test case
-        for (size_t j=0; j<MockLinkFileServer::cFailureModes; j++) {
-            qDebug() << "Testing successful download";
-			
-            // Run what should be a successful file download test case. No servers errors are being simulated.
-            _fileServer->setErrorMode(MockLinkFileServer::errModeNone);
-            _fileManager->streamPath(testCase->filename, QDir::temp());
-            QTest::qWait(_ackTimerTimeoutMsecs); // Let the file manager timeout
-            
-            // This should be a successful download
-            QCOMPARE(_multiSpy->checkOnlySignalByMask(commandCompleteSignalMask), true);
-            _multiSpy->clearAllSignals();
-            
-            // We should get a single Reset command to close the session
-            QCOMPARE(resetSpy.count(), 1);
-            resetSpy.clear();
-            
-            // Validate file contents
-            QString filePath = QDir::temp().absoluteFilePath(MockLinkFileServer::rgFileTestCases[i].filename);
-            _validateFileContents(filePath, MockLinkFileServer::rgFileTestCases[i].length);
-            MockLinkFileServer::ErrorMode_t errMode = MockLinkFileServer::rgFailureModes[j];
-            
-            qDebug() << "Testing failure mode:" << errMode;
-            _fileServer->setErrorMode(errMode);
-            
-            _fileManager->downloadPath(testCase->filename, QDir::temp());
-            QTest::qWait(_ackTimerTimeoutMsecs); // Let the file manager timeout
-            
-            if (errMode == MockLinkFileServer::errModeNakResponse) {
-                // This will Nak the Open call which will fail the download, but not cause a Reset
-                QCOMPARE(_multiSpy->checkOnlySignalByMask(commandErrorSignalMask), true);
-                QCOMPARE(resetSpy.count(), 0);
-            } else {
-                if (testCase->packetCount == 1 && (errMode == MockLinkFileServer::errModeNoSecondResponse || errMode == MockLinkFileServer::errModeNakSecondResponse)) {
-                    // The downloaded file fits within a single Ack response, hence there is no second Read issued.
-                    // This should result in a successful download, followed by a Reset
-                    QCOMPARE(_multiSpy->checkOnlySignalByMask(commandCompleteSignalMask), true);
-                    QCOMPARE(resetSpy.count(), 1);
-                    
-                    // Validate file contents
-                    QString filePath = QDir::temp().absoluteFilePath(testCase->filename);
-                    _validateFileContents(filePath, testCase->length);
-                } else {
-                    // Download should have failed, followed by a aReset
-                    QCOMPARE(_multiSpy->checkOnlySignalByMask(commandErrorSignalMask), true);
-                    QCOMPARE(resetSpy.count(), 1);
-                }
-            }
+    timer.start();
+    while (_multiSpy->getSpyByIndex(commandCompleteSignalIndex)->count() + _multiSpy->getSpyByIndex(commandErrorSignalIndex)->count() < count &&
+           timer.elapsed() < _downloadTimeoutMsecs * count) {
+        QTest::qWait(10);
+    }
+    
+    // Let the responses which are still on their way come in, so they don't show up in the next test
+    QTest::qWait(FileManager::ackTimerTimeoutMsecs * 2);
+}
 
-            // Cleanup for next iteration
-            _multiSpy->clearAllSignals();
-            resetSpy.clear();
-            _fileServer->setErrorMode(MockLinkFileServer::errModeNone);
-        }
+/// Removes the files left behind by previous downloads
+void FileManagerTest::_cleanDownloads(void)
+{
+    for (size_t i=0; i<MockLinkFileServer::cFileTestCases; i++) {
+        QFile::remove(QDir::temp().absoluteFilePath(MockLinkFileServer::rgFileTestCases[i].filename));
     }
 }
 
@@ -392,4 +470,3 @@ void FileManagerTest::_validateFileContents(const QString& filePath, uint8_t len
 		QCOMPARE((uint8_t)bytes[i], (uint8_t)(i & 0xFF));
 	}
 }
-#endif
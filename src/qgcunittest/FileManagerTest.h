@@ -40,11 +40,20 @@ private slots:
     void _ackTest(void);
     void _noAckTest(void);
     void _listTest(void);
+    void _gapsTest(void);
+    void _readDownloadTest(void);
+    void _streamDownloadTest(void);
+    void _crcMismatchTest(void);
+    void _concurrentDownloadTest(void);
 	
     // Connected to FileManager listEntry signal
     void listEntry(const QString& entry);
     
 private:
+    void _downloadTest(bool stream);
+    void _startDownload(const QString& filename, bool stream);
+    void _waitForDownloads(int count);
+    void _cleanDownloads(void);
     void _validateFileContents(const QString& filePath, uint8_t length);
 
     enum {
@@ -74,6 +83,9 @@ private:
     /// As such it must be larger than the Ack Timeout used by the FileManager.
     static const int _ackTimerTimeoutMsecs = FileManager::ackTimerMaxRetries * FileManager::ackTimerTimeoutMsecs * 2;
     
+    /// @brief Upper bound for a single download to either complete or fail, including the retries of each download request
+    static const int _downloadTimeoutMsecs = _ackTimerTimeoutMsecs * 4;
+    
     QStringList _fileListReceived;
 };
 
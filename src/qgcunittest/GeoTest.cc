@@ -16,6 +16,8 @@
 #include "GeoTest.h"
 #include "QGCGeo.h"
 
+#include <QElapsedTimer>
+
 /*
 GeoTest::GeoTest(void)
 {
@@ -91,3 +93,99 @@ void GeoTest::_convertNedToGeoAtOrigin_test(void)
     QCOMPARE(coord.longitude(), expectedLon);
     QCOMPARE(coord.altitude(), expectedAlt);
 }
+
+void GeoTest::_generatePoints(int count, QVector<double>& lat, QVector<double>& lon)
+{
+    // Points spread over roughly 10km around the origin, like a large survey
+    lat.resize(count);
+    lon.resize(count);
+    for (int i=0; i<count; i++) {
+        lat[i] = _origin.latitude() + ((i % 1000) - 500) * 0.0001;
+        lon[i] = _origin.longitude() + ((i / 1000) % 1000 - 500) * 0.0001;
+    }
+}
+
+void GeoTest::_batchMatchesSingle_test(void)
+{
+    const int       cPoints = 5000;
+    QVector<double> lat, lon;
+    QVector<double> north(cPoints), east(cPoints);
+    QVector<double> batchLat(cPoints), batchLon(cPoints);
+
+    _generatePoints(cPoints, lat, lon);
+    lat[0] = _origin.latitude();
+    lon[0] = _origin.longitude();
+
+    GeoProjectionOrigin projectionOrigin(_origin);
+    convertGeoToNed(projectionOrigin, cPoints, lat.constData(), lon.constData(), north.data(), east.data());
+    convertNedToGeo(projectionOrigin, cPoints, north.constData(), east.constData(), batchLat.data(), batchLon.data());
+
+    for (int i=0; i<cPoints; i++) {
+        double x, y, z;
+        convertGeoToNed(QGeoCoordinate(lat[i], lon[i], 0), _origin, &x, &y, &z);
+        QCOMPARE(north[i], x);
+        QCOMPARE(east[i], y);
+
+        QGeoCoordinate coord;
+        convertNedToGeo(north[i], east[i], 0, _origin, &coord);
+        QCOMPARE(batchLat[i], coord.latitude());
+        QCOMPARE(batchLon[i], coord.longitude());
+    }
+
+    // The origin itself projects to exactly zero
+    QCOMPARE(north[0], 0.0);
+    QCOMPARE(east[0], 0.0);
+
+    // List helpers use x: East, y: North
+    QList<QGeoCoordinate> coords;
+    coords << _origin << QGeoCoordinate(lat[1], lon[1], 0);
+    QList<QPointF> points = convertGeoToLocalPoints(coords, _origin);
+    QCOMPARE(points.count(), 2);
+    QCOMPARE(points[1].x(), east[1]);
+    QCOMPARE(points[1].y(), north[1]);
+
+    QList<QGeoCoordinate> roundTrip = convertLocalPointsToGeo(points, _origin);
+    QCOMPARE(roundTrip.count(), 2);
+    QCOMPARE(roundTrip[1].latitude(), batchLat[1]);
+    QCOMPARE(roundTrip[1].longitude(), batchLon[1]);
+    QCOMPARE(roundTrip[1].altitude(), _origin.altitude());
+}
+
+void GeoTest::_batchBenchmark_test(void)
+{
+    const int       cPoints = 200000;
+    QVector<double> lat, lon;
+    QVector<double> north(cPoints), east(cPoints);
+    QElapsedTimer   timer;
+
+    _generatePoints(cPoints, lat, lon);
+
+    timer.start();
+    for (int i=0; i<cPoints; i++) {
+        double z;
+        convertGeoToNed(QGeoCoordinate(lat[i], lon[i], 0), _origin, &north[i], &east[i], &z);
+    }
+    qint64 singleNSecs = qMax(timer.nsecsElapsed(), (qint64)1);
+
+    timer.start();
+    convertGeoToNed(GeoProjectionOrigin(_origin), cPoints, lat.constData(), lon.constData(), north.data(), east.data());
+    qint64 batchNSecs = qMax(timer.nsecsElapsed(), (qint64)1);
+
+    qDebug() << "convertGeoToNed points/s single:" << (qint64)(cPoints * 1.0e9 / singleNSecs)
+             << "batch:" << (qint64)(cPoints * 1.0e9 / batchNSecs);
+
+    timer.start();
+    for (int i=0; i<cPoints; i++) {
+        QGeoCoordinate coord;
+        convertNedToGeo(north[i], east[i], 0, _origin, &coord);
+        lat[i] = coord.latitude();
+    }
+    singleNSecs = qMax(timer.nsecsElapsed(), (qint64)1);
+
+    timer.start();
+    convertNedToGeo(GeoProjectionOrigin(_origin), cPoints, north.constData(), east.constData(), lat.data(), lon.data());
+    batchNSecs = qMax(timer.nsecsElapsed(), (qint64)1);
+
+    qDebug() << "convertNedToGeo points/s single:" << (qint64)(cPoints * 1.0e9 / singleNSecs)
+             << "batch:" << (qint64)(cPoints * 1.0e9 / batchNSecs);
+}
@@ -17,6 +17,7 @@
 #define GEOTEST_H
 
 #include <QGeoCoordinate>
+#include <QVector>
 
 #include "UnitTest.h"
 
@@ -34,7 +35,13 @@ private slots:
     void _convertGeoToNedAtOrigin_test(void);
     void _convertNedToGeo_test(void);
     void _convertNedToGeoAtOrigin_test(void);
+    void _batchMatchesSingle_test(void);
+    void _batchBenchmark_test(void);
+
 private:
+    void _generatePoints(int count, QVector<double>& lat, QVector<double>& lon);
+
+
     QGeoCoordinate _origin;
 };
 
@@ -0,0 +1,155 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "HilLockstepProtocolTest.h"
+#include "HilLockstepProtocol.h"
+
+#include <QtEndian>
+
+static HilLockstepState _testState(void)
+{
+    HilLockstepState state;
+
+    memset(&state, 0, sizeof(state));
+    state.step =            123456;
+    state.timeUsecs =       Q_UINT64_C(9876543210);
+    state.gpsValid =        true;
+    state.xacc =            0.1f;
+    state.yacc =            -0.2f;
+    state.zacc =            -9.81f;
+    state.xgyro =           0.01f;
+    state.ygyro =           -0.02f;
+    state.zgyro =           0.03f;
+    state.xmag =            0.21f;
+    state.ymag =            0.01f;
+    state.zmag =            0.42f;
+    state.absPressure =     1013.25f;
+    state.diffPressure =    0.5f;
+    state.pressureAlt =     488.0f;
+    state.temperature =     15.0f;
+    state.latitude =        47.3977419;
+    state.longitude =       8.5455938;
+    state.altitude =        488.5f;
+    state.vn =              1.5f;
+    state.ve =              -2.5f;
+    state.vd =              0.25f;
+    state.eph =             0.3f;
+    state.epv =             0.6f;
+    state.fixType =         3;
+    state.satellites =      12;
+
+    return state;
+}
+
+void HilLockstepProtocolTest::_stateRoundTrip(void)
+{
+    HilLockstepState    state = _testState();
+    HilLockstepState    decoded;
+    char                buffer[HilLockstepProtocol::stateSize];
+
+    QCOMPARE(HilLockstepProtocol::encodeState(state, buffer), (int)HilLockstepProtocol::stateSize);
+    QVERIFY(HilLockstepProtocol::decodeState(buffer, HilLockstepProtocol::stateSize, decoded));
+
+    QCOMPARE(decoded.step,          state.step);
+    QCOMPARE(decoded.timeUsecs,     state.timeUsecs);
+    QCOMPARE(decoded.gpsValid,      state.gpsValid);
+    QCOMPARE(decoded.xacc,          state.xacc);
+    QCOMPARE(decoded.zacc,          state.zacc);
+    QCOMPARE(decoded.zgyro,         state.zgyro);
+    QCOMPARE(decoded.zmag,          state.zmag);
+    QCOMPARE(decoded.absPressure,   state.absPressure);
+    QCOMPARE(decoded.temperature,   state.temperature);
+    QCOMPARE(decoded.latitude,      state.latitude);
+    QCOMPARE(decoded.longitude,     state.longitude);
+    QCOMPARE(decoded.altitude,      state.altitude);
+    QCOMPARE(decoded.vd,            state.vd);
+    QCOMPARE(decoded.epv,           state.epv);
+    QCOMPARE(decoded.fixType,       state.fixType);
+    QCOMPARE(decoded.satellites,    state.satellites);
+
+    state.gpsValid = false;
+    HilLockstepProtocol::encodeState(state, buffer);
+    QVERIFY(HilLockstepProtocol::decodeState(buffer, HilLockstepProtocol::stateSize, decoded));
+    QCOMPARE(decoded.gpsValid, false);
+}
+
+void HilLockstepProtocolTest::_controlsRoundTrip(void)
+{
+    HilLockstepControls controls;
+    HilLockstepControls decoded;
+    char                buffer[HilLockstepProtocol::controlsSize];
+
+    controls.step =         42;
+    controls.timeUsecs =    Q_UINT64_C(1234567890123);
+    controls.flags =        1;
+    controls.mode =         0xC0;
+    for (int i=0; i<16; i++) {
+        controls.controls[i] = (i - 8) / 8.0f;
+    }
+
+    QCOMPARE(HilLockstepProtocol::encodeControls(controls, buffer), (int)HilLockstepProtocol::controlsSize);
+    QVERIFY(HilLockstepProtocol::decodeControls(buffer, HilLockstepProtocol::controlsSize, decoded));
+
+    QCOMPARE(decoded.step,      controls.step);
+    QCOMPARE(decoded.timeUsecs, controls.timeUsecs);
+    QCOMPARE(decoded.flags,     controls.flags);
+    QCOMPARE(decoded.mode,      controls.mode);
+    for (int i=0; i<16; i++) {
+        QCOMPARE(decoded.controls[i], controls.controls[i]);
+    }
+}
+
+/// Simulators implement the documented layout, make sure the encoding matches it
+void HilLockstepProtocolTest::_stateLayout(void)
+{
+    HilLockstepState    state = _testState();
+    char                buffer[HilLockstepProtocol::stateSize];
+
+    HilLockstepProtocol::encodeState(state, buffer);
+
+    QCOMPARE(QByteArray(buffer, 4), QByteArray("LSST"));
+    QCOMPARE((int)buffer[4], (int)HilLockstepProtocol::version);
+    QCOMPARE((int)buffer[5], (int)HilLockstepProtocol::stateFlagGpsValid);
+    QCOMPARE(qFromLittleEndian<quint32>((const uchar*)buffer + 8), state.step);
+    QCOMPARE(qFromLittleEndian<quint64>((const uchar*)buffer + 12), state.timeUsecs);
+
+    quint64 latitudeBits = qFromLittleEndian<quint64>((const uchar*)buffer + 72);
+    double  latitude;
+    memcpy(&latitude, &latitudeBits, sizeof(latitude));
+    QCOMPARE(latitude, state.latitude);
+
+    QCOMPARE((int)(quint8)buffer[112], (int)state.fixType);
+    QCOMPARE((int)(quint8)buffer[113], (int)state.satellites);
+}
+
+void HilLockstepProtocolTest::_invalidPackets(void)
+{
+    HilLockstepState    state = _testState();
+    HilLockstepState    decoded;
+    HilLockstepControls controls;
+    char                buffer[HilLockstepProtocol::stateSize];
+
+    HilLockstepProtocol::encodeState(state, buffer);
+
+    // Wrong size
+    QVERIFY(!HilLockstepProtocol::decodeState(buffer, HilLockstepProtocol::stateSize - 1, decoded));
+    QVERIFY(!HilLockstepProtocol::decodeState(buffer, 0, decoded));
+
+    // A state packet is not a controls packet
+    QVERIFY(!HilLockstepProtocol::decodeControls(buffer, HilLockstepProtocol::controlsSize, controls));
+
+    // Wrong version
+    buffer[4] = HilLockstepProtocol::version + 1;
+    QVERIFY(!HilLockstepProtocol::decodeState(buffer, HilLockstepProtocol::stateSize, decoded));
+
+    // Wrong magic
+    HilLockstepProtocol::encodeState(state, buffer);
+    buffer[0] = 'X';
+    QVERIFY(!HilLockstepProtocol::decodeState(buffer, HilLockstepProtocol::stateSize, decoded));
+}
@@ -0,0 +1,27 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef HilLockstepProtocolTest_H
+#define HilLockstepProtocolTest_H
+
+#include "UnitTest.h"
+
+/// Unit tests for the lockstep HIL packet encoding
+class HilLockstepProtocolTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _stateRoundTrip(void);
+    void _controlsRoundTrip(void);
+    void _stateLayout(void);
+    void _invalidPackets(void);
+};
+
+#endif
@@ -16,6 +16,9 @@
 #include "LinkManagerTest.h"
 #include "MockLink.h"
 #include "QGCApplication.h"
+#include "UDPLink.h"
+
+#include <QUdpSocket>
 
 LinkManagerTest::LinkManagerTest(void) :
     _linkMgr(NULL),
@@ -115,3 +118,120 @@ void LinkManagerTest::_deleteSignals_test(void)
     QList<QVariant> signalArgs = spy->takeFirst();
     QCOMPARE(signalArgs.count(), 1);
 }
+
+/// Connects a large number of UDP links and feeds each of them a heartbeat which is split across two datagrams. The
+/// halves are interleaved across links, so this only works if every link has its own channel and parser state.
+void LinkManagerTest::_multipleUdpLinks_test(void)
+{
+    Q_ASSERT(_linkMgr);
+    Q_ASSERT(_linkMgr->links().count() == 0);
+
+    const int       cUdpLinks =         128;
+    const quint16   udpLinkBasePort =   24550;
+
+    QList<LinkInterface*> udpLinks;
+    QSet<int> channels;
+
+    for (int i=0; i<cUdpLinks; i++) {
+        UDPConfiguration* udpConfig = new UDPConfiguration(QStringLiteral("UDP Link %1").arg(i));
+        udpConfig->setLocalPort(udpLinkBasePort + i);
+        udpConfig->setDynamic(true);
+        SharedLinkConfigurationPointer config = _linkMgr->addConfiguration(udpConfig);
+
+        LinkInterface* link = _linkMgr->createConnectedLink(config);
+        QVERIFY(link);
+        udpLinks.append(link);
+        channels.insert(link->mavlinkChannel());
+    }
+    QCOMPARE(_linkMgr->links().count(), cUdpLinks);
+    QCOMPARE(channels.count(), cUdpLinks);
+    QVERIFY(!channels.contains(0));
+
+    MAVLinkProtocol* mavlinkProtocol = qgcApp()->toolbox()->mavlinkProtocol();
+    QSignalSpy spyHeartbeat(mavlinkProtocol, SIGNAL(vehicleHeartbeatInfo(LinkInterface*, int, int, int, int)));
+
+    // Heartbeats come from a camera component so MultiVehicleManager does not create vehicles for them
+    QList<QByteArray> heartbeats;
+    for (int i=0; i<cUdpLinks; i++) {
+        mavlink_message_t   msg;
+        uint8_t             buffer[MAVLINK_MAX_PACKET_LEN];
+
+        mavlink_msg_heartbeat_pack_chan(i + 1, MAV_COMP_ID_CAMERA, 0, &msg, MAV_TYPE_GENERIC, MAV_AUTOPILOT_INVALID, 0, 0, MAV_STATE_ACTIVE);
+        heartbeats.append(QByteArray((const char*)buffer, mavlink_msg_to_send_buffer(buffer, &msg)));
+    }
+
+    QUdpSocket sender;
+    for (int half=0; half<2; half++) {
+        for (int i=0; i<cUdpLinks; i++) {
+            const QByteArray& heartbeat = heartbeats[i];
+            int split = heartbeat.count() / 2;
+            QByteArray datagram = half == 0 ? heartbeat.left(split) : heartbeat.mid(split);
+            QCOMPARE(sender.writeDatagram(datagram, QHostAddress::LocalHost, udpLinkBasePort + i), (qint64)datagram.count());
+        }
+        QTest::qWait(100);
+    }
+
+    for (int i=0; i<50 && spyHeartbeat.count() < cUdpLinks; i++) {
+        QTest::qWait(100);
+    }
+    QCOMPARE(spyHeartbeat.count(), cUdpLinks);
+
+    QSet<LinkInterface*> heartbeatLinks;
+    for (int i=0; i<spyHeartbeat.count(); i++) {
+        QList<QVariant> signalArgs = spyHeartbeat[i];
+        LinkInterface* link = qobject_cast<LinkInterface*>(qvariant_cast<QObject*>(signalArgs[0]));
+        int vehicleId = signalArgs[1].toInt();
+        QVERIFY(vehicleId >= 1 && vehicleId <= cUdpLinks);
+        QCOMPARE(link, udpLinks[vehicleId - 1]);
+        heartbeatLinks.insert(link);
+    }
+    QCOMPARE(heartbeatLinks.count(), cUdpLinks);
+
+    for (int i=0; i<udpLinks.count(); i++) {
+        QCOMPARE(mavlinkProtocol->getParsingErrorCount(udpLinks[i]), 0);
+        _linkMgr->disconnectLink(udpLinks[i]);
+    }
+    QTest::qWait(100);
+    QCOMPARE(_linkMgr->links().count(), 0);
+}
+
+/// Feeds a heartbeat with a broken checksum followed by a good one
+void LinkManagerTest::_parsingErrors_test(void)
+{
+    Q_ASSERT(_linkMgr);
+    Q_ASSERT(_linkMgr->links().count() == 0);
+
+    const quint16 udpLinkPort = 24550;
+
+    UDPConfiguration* udpConfig = new UDPConfiguration(QStringLiteral("UDP Link"));
+    udpConfig->setLocalPort(udpLinkPort);
+    udpConfig->setDynamic(true);
+    SharedLinkConfigurationPointer config = _linkMgr->addConfiguration(udpConfig);
+    LinkInterface* link = _linkMgr->createConnectedLink(config);
+    QVERIFY(link);
+
+    MAVLinkProtocol* mavlinkProtocol = qgcApp()->toolbox()->mavlinkProtocol();
+    QSignalSpy spyHeartbeat(mavlinkProtocol, SIGNAL(vehicleHeartbeatInfo(LinkInterface*, int, int, int, int)));
+
+    mavlink_message_t   msg;
+    uint8_t             buffer[MAVLINK_MAX_PACKET_LEN];
+
+    mavlink_msg_heartbeat_pack_chan(1, MAV_COMP_ID_CAMERA, 0, &msg, MAV_TYPE_GENERIC, MAV_AUTOPILOT_INVALID, 0, 0, MAV_STATE_ACTIVE);
+    QByteArray heartbeat((const char*)buffer, mavlink_msg_to_send_buffer(buffer, &msg));
+    QByteArray corrupt = heartbeat;
+    corrupt[corrupt.count() - 1] = corrupt[corrupt.count() - 1] ^ 0xFF;
+
+    QUdpSocket sender;
+    QCOMPARE(sender.writeDatagram(corrupt + heartbeat, QHostAddress::LocalHost, udpLinkPort), (qint64)(corrupt.count() + heartbeat.count()));
+
+    for (int i=0; i<50 && spyHeartbeat.count() < 1; i++) {
+        QTest::qWait(100);
+    }
+    QCOMPARE(spyHeartbeat.count(), 1);
+    QCOMPARE(mavlinkProtocol->getReceivedPacketCount(link), 1);
+    QCOMPARE(mavlinkProtocol->getParsingErrorCount(link), 1);
+
+    _linkMgr->disconnectLink(link);
+    QTest::qWait(100);
+    QCOMPARE(_linkMgr->links().count(), 0);
+}
@@ -35,6 +35,8 @@ private slots:
     void _delete_test(void);
     void _addSignals_test(void);
     void _deleteSignals_test(void);
+    void _multipleUdpLinks_test(void);
+    void _parsingErrors_test(void);
 
 private:
     enum {
@@ -0,0 +1,153 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "LinkQualityStatisticsTest.h"
+#include "LinkQualityStatistics.h"
+#include "MAVLinkProtocol.h"
+#include "MockLink.h"
+#include "QGCApplication.h"
+
+// LinkQualityStatistics only uses the link as a key, so these are never dereferenced
+static LinkInterface* const _link1 = reinterpret_cast<LinkInterface*>(0x1000);
+static LinkInterface* const _link2 = reinterpret_cast<LinkInterface*>(0x2000);
+
+static mavlink_message_t _heartbeat(uint8_t sysid, uint8_t compid, uint8_t seq)
+{
+    mavlink_message_t message;
+    mavlink_msg_heartbeat_pack(sysid, compid, &message, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_PX4, 0, 0, MAV_STATE_ACTIVE);
+    message.seq = seq;
+    return message;
+}
+
+void LinkQualityStatisticsTest::_sequence_test(void)
+{
+    LinkQualityStatistics statistics;
+
+    // In order, including wrap around
+    QCOMPARE(statistics.update(_link1, _heartbeat(1, 1, 254)), 0);
+    QCOMPARE(statistics.update(_link1, _heartbeat(1, 1, 255)), 0);
+    QCOMPARE(statistics.update(_link1, _heartbeat(1, 1, 0)), 0);
+
+    // Gap of 3
+    QCOMPARE(statistics.update(_link1, _heartbeat(1, 1, 4)), 3);
+
+    // Two of the missing ones show up late, one of them twice
+    QCOMPARE(statistics.update(_link1, _heartbeat(1, 1, 2)), -1);
+    QCOMPARE(statistics.update(_link1, _heartbeat(1, 1, 1)), -1);
+    QCOMPARE(statistics.update(_link1, _heartbeat(1, 1, 2)), 0);
+
+    // Duplicate of the newest
+    QCOMPARE(statistics.update(_link1, _heartbeat(1, 1, 4)), 0);
+
+    // Far behind is treated as a sender restart, not loss
+    QCOMPARE(statistics.update(_link1, _heartbeat(1, 1, 150)), 0);
+    QCOMPARE(statistics.update(_link1, _heartbeat(1, 1, 151)), 0);
+
+    statistics.updateSnapshots();
+    const LinkQualityStatistics::Snapshot* snapshot = statistics.snapshot(_link1, 1, 1);
+    QVERIFY(snapshot);
+    QCOMPARE(snapshot->received, (quint64)8);
+    QCOMPARE(snapshot->lost, (quint64)1);
+    QCOMPARE(snapshot->duplicates, (quint64)2);
+    QCOMPARE(snapshot->reordered, (quint64)2);
+    QCOMPARE(snapshot->rttMSecs, -1.0);
+}
+
+void LinkQualityStatisticsTest::_redundantLinks_test(void)
+{
+    LinkQualityStatistics statistics;
+
+    // Each link only sees every other message from the vehicle. With shared sequence tracking this would show up as
+    // loss on both links.
+    for (int seq=0; seq<20; seq++) {
+        QCOMPARE(statistics.update(seq & 1 ? _link1 : _link2, _heartbeat(1, 1, seq)), seq < 2 ? 0 : 1);
+    }
+    // Both links see all messages from component 2
+    for (int seq=0; seq<20; seq++) {
+        QCOMPARE(statistics.update(_link1, _heartbeat(1, 2, seq)), 0);
+        QCOMPARE(statistics.update(_link2, _heartbeat(1, 2, seq)), 0);
+    }
+
+    statistics.updateSnapshots();
+    QCOMPARE(statistics.streamCount(), 4);
+    QCOMPARE(statistics.snapshot(_link1, 1, 2)->lost, (quint64)0);
+    QCOMPARE(statistics.snapshot(_link2, 1, 2)->lost, (quint64)0);
+    QCOMPARE(statistics.snapshot(_link1, 1, 2)->duplicates, (quint64)0);
+    QCOMPARE(statistics.snapshot(_link1, 1, 1)->lost, (quint64)9);
+    QCOMPARE(statistics.snapshot(_link2, 1, 1)->lost, (quint64)9);
+
+    statistics.removeLink(_link1);
+    QCOMPARE(statistics.streamCount(), 2);
+    QVERIFY(!statistics.snapshot(_link1, 1, 1));
+    QVERIFY(statistics.snapshot(_link2, 1, 1));
+}
+
+void LinkQualityStatisticsTest::_snapshot_test(void)
+{
+    LinkQualityStatistics statistics;
+
+    // 8 received, 2 lost
+    for (int seq=0; seq<10; seq++) {
+        if (seq != 3 && seq != 7) {
+            statistics.update(_link1, _heartbeat(1, 1, seq));
+        }
+    }
+    statistics.updateSnapshots();
+
+    const LinkQualityStatistics::Snapshot* snapshot = statistics.snapshot(_link1, 1, 1);
+    QVERIFY(snapshot);
+    QCOMPARE(snapshot->lossPercent, 20.0);
+    QCOMPARE(snapshot->duplicatePercent, 0.0);
+    QVERIFY(snapshot->rateHz > 0);
+    QVERIFY(snapshot->bytesPerSecond > 0);
+
+    // Next window is clean, late arrival of 7 must not produce negative loss
+    statistics.update(_link1, _heartbeat(1, 1, 7));
+    for (int seq=10; seq<13; seq++) {
+        statistics.update(_link1, _heartbeat(1, 1, seq));
+    }
+    statistics.updateSnapshots();
+
+    snapshot = statistics.snapshot(_link1, 1, 1);
+    QCOMPARE(snapshot->lossPercent, 0.0);
+    QCOMPARE(snapshot->reorderPercent, 25.0);
+    QCOMPARE(snapshot->lost, (quint64)1);
+
+    QVariantList list = statistics.statisticsList(1);
+    QCOMPARE(list.count(), 1);
+    QCOMPARE(list[0].toMap()[QStringLiteral("received")].toULongLong(), (quint64)12);
+    QVERIFY(statistics.statisticsList(2).isEmpty());
+}
+
+/// MockLink answers the TIMESYNC requests MAVLinkProtocol sends with each snapshot
+void LinkQualityStatisticsTest::_timesyncRtt_test(void)
+{
+    MAVLinkProtocol*        mavlinkProtocol = qgcApp()->toolbox()->mavlinkProtocol();
+    LinkQualityStatistics*  statistics = mavlinkProtocol->linkStatistics();
+    bool                    timesyncEnabled = mavlinkProtocol->timesyncEnabled();
+
+    _connectMockLink();
+    mavlinkProtocol->enableTimesync(true);
+
+    double rttMSecs = -1;
+    for (int i=0; i<50 && rttMSecs < 0; i++) {
+        QTest::qWait(100);
+        const QVector<LinkQualityStatistics::Snapshot>& snapshots = statistics->snapshots();
+        for (int j=0; j<snapshots.count(); j++) {
+            if (snapshots[j].link == _mockLink && snapshots[j].sysid == _mockLink->vehicleId() && snapshots[j].rttMSecs >= 0) {
+                rttMSecs = snapshots[j].rttMSecs;
+            }
+        }
+    }
+    QVERIFY(rttMSecs >= 0);
+    QVERIFY(rttMSecs < 10000);
+
+    mavlinkProtocol->enableTimesync(timesyncEnabled);
+    _disconnectMockLink();
+}
@@ -0,0 +1,27 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef LinkQualityStatisticsTest_H
+#define LinkQualityStatisticsTest_H
+
+#include "UnitTest.h"
+
+/// Unit test for LinkQualityStatistics
+class LinkQualityStatisticsTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _sequence_test(void);
+    void _redundantLinks_test(void);
+    void _snapshot_test(void);
+    void _timesyncRtt_test(void);
+};
+
+#endif
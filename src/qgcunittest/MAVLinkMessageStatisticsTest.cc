@@ -0,0 +1,93 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkMessageStatisticsTest.h"
+#include "MAVLinkMessageStatistics.h"
+
+#include <QTemporaryFile>
+
+static mavlink_message_t _heartbeat(uint8_t sysid, uint8_t compid, uint32_t customMode)
+{
+    mavlink_message_t message;
+    mavlink_msg_heartbeat_pack(sysid, compid, &message, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_PX4, 0, customMode, MAV_STATE_ACTIVE);
+    return message;
+}
+
+void MAVLinkMessageStatisticsTest::_counts_test(void)
+{
+    MAVLinkMessageStatistics statistics;
+
+    statistics.update(_heartbeat(1, 1, 0));
+    const MAVLinkMessageStatistics::MessageStats* stats = statistics.stats(1, 1, MAVLINK_MSG_ID_HEARTBEAT);
+    QVERIFY(stats);
+    quint64 messageBytes = stats->bytes;
+    QVERIFY(messageBytes > 0);
+
+    statistics.update(_heartbeat(1, 1, 0));
+    statistics.update(_heartbeat(1, 1, 0));
+    statistics.update(_heartbeat(1, 2, 0));
+
+    // Pointers are invalidated by update
+    stats = statistics.stats(1, 1, MAVLINK_MSG_ID_HEARTBEAT);
+    QVERIFY(stats);
+    QCOMPARE(stats->count, (quint64)3);
+    QCOMPARE(stats->bytes, messageBytes * 3);
+
+    quint64 histogramTotal = 0;
+    for (int bin=0; bin<MAVLinkMessageStatistics::cJitterBins; bin++) {
+        histogramTotal += stats->jitterHistogram[bin];
+    }
+    QCOMPARE(histogramTotal, (quint64)2);
+
+    stats = statistics.stats(1, 2, MAVLINK_MSG_ID_HEARTBEAT);
+    QVERIFY(stats);
+    QCOMPARE(stats->count, (quint64)1);
+
+    QVERIFY(!statistics.stats(2, 1, MAVLINK_MSG_ID_HEARTBEAT));
+    QCOMPARE(statistics.messageTypeCount(), 2);
+    QCOMPARE(statistics.messageList(1, 2).count(), 1);
+    QCOMPARE(statistics.messageList().count(), 2);
+
+    statistics.clear();
+    QCOMPARE(statistics.messageTypeCount(), 0);
+}
+
+void MAVLinkMessageStatisticsTest::_decode_test(void)
+{
+    MAVLinkMessageStatistics statistics;
+
+    statistics.update(_heartbeat(1, 1, 1));
+    statistics.update(_heartbeat(1, 1, 42));
+
+    QVariantMap fields = statistics.decodeMessage(1, 1, MAVLINK_MSG_ID_HEARTBEAT);
+    QCOMPARE(fields[QStringLiteral("custom_mode")].toUInt(), 42u);
+    QCOMPARE(fields[QStringLiteral("autopilot")].toUInt(), (uint)MAV_AUTOPILOT_PX4);
+
+    QVERIFY(statistics.decodeMessage(1, 1, MAVLINK_MSG_ID_SYS_STATUS).isEmpty());
+}
+
+void MAVLinkMessageStatisticsTest::_export_test(void)
+{
+    MAVLinkMessageStatistics statistics;
+
+    statistics.update(_heartbeat(1, 1, 0));
+    statistics.update(_heartbeat(2, 1, 0));
+
+    QTemporaryFile tempFile;
+    QVERIFY(tempFile.open());
+    tempFile.close();
+
+    QVERIFY(statistics.exportToCSV(tempFile.fileName()));
+
+    QVERIFY(tempFile.open());
+    QStringList lines = QString(tempFile.readAll()).split(QStringLiteral("\n"), QString::SkipEmptyParts);
+    QCOMPARE(lines.count(), 3);
+    QVERIFY(lines[0].startsWith(QStringLiteral("sysid,compid,msgid,name")));
+    QVERIFY(lines[1].startsWith(QStringLiteral("1,1,0,HEARTBEAT,1,")));
+}
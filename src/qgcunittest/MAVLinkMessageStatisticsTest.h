@@ -0,0 +1,26 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef MAVLinkMessageStatisticsTest_H
+#define MAVLinkMessageStatisticsTest_H
+
+#include "UnitTest.h"
+
+/// Unit test for MAVLinkMessageStatistics
+class MAVLinkMessageStatisticsTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _counts_test(void);
+    void _decode_test(void);
+    void _export_test(void);
+};
+
+#endif
@@ -0,0 +1,124 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MockLinkSwarmTest.h"
+#include "MockLink.h"
+#include "MultiVehicleManager.h"
+#include "ParameterManager.h"
+#include "QGCApplication.h"
+
+void MockLinkSwarmTest::_messageMix(void)
+{
+    MockLinkSwarm::Config   config = MockLinkSwarm::config(MockLinkSwarm::MessageMixTypical);
+    MockLinkSwarm           swarm(NULL, 200, 4, 1, config);
+    int                     secs = config.statusTextBurstSecs;
+
+    QCOMPARE(swarm.vehicleCount(), 4);
+    QVERIFY(swarm.isSwarmVehicle(200));
+    QVERIFY(swarm.isSwarmVehicle(203));
+    QVERIFY(!swarm.isSwarmVehicle(204));
+
+    swarm.runTicks(MockLinkSwarm::tickHz * secs);
+
+    // Over whole seconds each stream sends exactly its rate
+    QCOMPARE(swarm.messageCount(MAVLINK_MSG_ID_HEARTBEAT),             config.heartbeatHz * 4 * secs);
+    QCOMPARE(swarm.messageCount(MAVLINK_MSG_ID_ATTITUDE),              config.attitudeHz * 4 * secs);
+    QCOMPARE(swarm.messageCount(MAVLINK_MSG_ID_HIGHRES_IMU),           config.highresImuHz * 4 * secs);
+    QCOMPARE(swarm.messageCount(MAVLINK_MSG_ID_GLOBAL_POSITION_INT),   config.globalPositionHz * 4 * secs);
+    QCOMPARE(swarm.messageCount(MAVLINK_MSG_ID_GPS_RAW_INT),           config.gpsRawIntHz * 4 * secs);
+    QCOMPARE(swarm.messageCount(MAVLINK_MSG_ID_SYS_STATUS),            config.sysStatusHz * 4 * secs);
+    QCOMPARE(swarm.messageCount(MAVLINK_MSG_ID_VFR_HUD),               config.vfrHudHz * 4 * secs);
+    QCOMPARE(swarm.messageCount(MAVLINK_MSG_ID_ADSB_VEHICLE),          config.adsbHz * config.adsbVehicleCount * secs);
+    QCOMPARE(swarm.messageCount(MAVLINK_MSG_ID_STATUSTEXT),            config.statusTextBurstCount * 4);
+    QCOMPARE(swarm.messageCount(MAVLINK_MSG_ID_PARAM_VALUE),           0);
+    QVERIFY(swarm.bytesSent() > swarm.messagesSent() * MAVLINK_NUM_NON_PAYLOAD_BYTES);
+}
+
+void MockLinkSwarmTest::_deterministic(void)
+{
+    MockLinkSwarm::Config config = MockLinkSwarm::config(MockLinkSwarm::MessageMixLight);
+    MockLinkSwarm swarm1(NULL, 200, 10, 42, config);
+    MockLinkSwarm swarm2(NULL, 200, 10, 42, config);
+    MockLinkSwarm swarm3(NULL, 200, 10, 43, config);
+
+    QGeoCoordinate start = swarm1.coordinate(0);
+
+    swarm1.runTicks(2000);
+    swarm2.runTicks(2000);
+    swarm3.runTicks(2000);
+
+    for (int i=0; i<swarm1.vehicleCount(); i++) {
+        QCOMPARE(swarm1.coordinate(i), swarm2.coordinate(i));
+        QVERIFY(swarm1.coordinate(i) != swarm3.coordinate(i));
+
+        // Circles are centered in the swarm area
+        QVERIFY(swarm1.coordinate(i).distanceTo(QGeoCoordinate(47.397, 8.5455)) < 1800);
+    }
+    QCOMPARE(swarm1.bytesSent(), swarm2.bytesSent());
+    QVERIFY(swarm1.coordinate(0).distanceTo(start) > 1);
+}
+
+void MockLinkSwarmTest::_parameterAndMissionTraffic(void)
+{
+    MockLinkSwarm::Config   config = MockLinkSwarm::config(MockLinkSwarm::MessageMixLight);
+    MockLinkSwarm           swarm(NULL, 200, 2, 1, config);
+    mavlink_message_t       msg;
+
+    // Messages to other vehicles are left to the link
+    mavlink_msg_param_request_list_pack_chan(255, MAV_COMP_ID_MISSIONPLANNER, 0, &msg, 128, MAV_COMP_ID_ALL);
+    QVERIFY(!swarm.handleMessage(msg));
+    mavlink_msg_heartbeat_pack_chan(255, MAV_COMP_ID_MISSIONPLANNER, 0, &msg, MAV_TYPE_GCS, MAV_AUTOPILOT_INVALID, 0, 0, MAV_STATE_ACTIVE);
+    QVERIFY(!swarm.handleMessage(msg));
+
+    // Parameters are sent one per tick
+    mavlink_msg_param_request_list_pack_chan(255, MAV_COMP_ID_MISSIONPLANNER, 0, &msg, 201, MAV_COMP_ID_ALL);
+    QVERIFY(swarm.handleMessage(msg));
+    swarm.runTicks(config.paramCount + 10);
+    QCOMPARE(swarm.messageCount(MAVLINK_MSG_ID_PARAM_VALUE), config.paramCount);
+
+    mavlink_msg_param_request_read_pack_chan(255, MAV_COMP_ID_MISSIONPLANNER, 0, &msg, 201, MAV_COMP_ID_AUTOPILOT1, "SWARM_P0003", -1);
+    QVERIFY(swarm.handleMessage(msg));
+    QCOMPARE(swarm.messageCount(MAVLINK_MSG_ID_PARAM_VALUE), config.paramCount + 1);
+
+    // Mission download
+    mavlink_msg_mission_request_list_pack_chan(255, MAV_COMP_ID_MISSIONPLANNER, 0, &msg, 200, MAV_COMP_ID_AUTOPILOT1, MAV_MISSION_TYPE_MISSION);
+    QVERIFY(swarm.handleMessage(msg));
+    QCOMPARE(swarm.messageCount(MAVLINK_MSG_ID_MISSION_COUNT), 1);
+    mavlink_msg_mission_request_pack_chan(255, MAV_COMP_ID_MISSIONPLANNER, 0, &msg, 200, MAV_COMP_ID_AUTOPILOT1, 0, MAV_MISSION_TYPE_MISSION);
+    QVERIFY(swarm.handleMessage(msg));
+    QCOMPARE(swarm.messageCount(MAVLINK_MSG_ID_MISSION_ITEM), 1);
+
+    // Mission upload of two items
+    mavlink_msg_mission_count_pack_chan(255, MAV_COMP_ID_MISSIONPLANNER, 0, &msg, 200, MAV_COMP_ID_AUTOPILOT1, 2, MAV_MISSION_TYPE_MISSION);
+    QVERIFY(swarm.handleMessage(msg));
+    for (int seq=0; seq<2; seq++) {
+        QCOMPARE(swarm.messageCount(MAVLINK_MSG_ID_MISSION_REQUEST), seq + 1);
+        mavlink_msg_mission_item_pack_chan(255, MAV_COMP_ID_MISSIONPLANNER, 0, &msg, 200, MAV_COMP_ID_AUTOPILOT1, seq,
+                                           MAV_FRAME_GLOBAL_RELATIVE_ALT, MAV_CMD_NAV_WAYPOINT, 0, 1, 0, 0, 0, 0, 47.4, 8.5, 50, MAV_MISSION_TYPE_MISSION);
+        QVERIFY(swarm.handleMessage(msg));
+    }
+    QCOMPARE(swarm.messageCount(MAVLINK_MSG_ID_MISSION_ACK), 1);
+}
+
+void MockLinkSwarmTest::_swarmMockLink(void)
+{
+    MultiVehicleManager* multiVehicleManager = qgcApp()->toolbox()->multiVehicleManager();
+
+    _mockLink = MockLink::startSwarmMockLink(3, 1, MockLinkSwarm::MessageMixLight);
+    QVERIFY(_mockLink->swarm());
+    QCOMPARE(_mockLink->swarm()->vehicleCount(), 3);
+
+    // The link vehicle and the swarm vehicles show up and complete their parameter load
+    QTRY_COMPARE_WITH_TIMEOUT(multiVehicleManager->vehicles()->count(), 4, 10000);
+    for (int i=0; i<_mockLink->swarm()->vehicleCount(); i++) {
+        Vehicle* vehicle = multiVehicleManager->getVehicleById(_mockLink->swarm()->firstSystemId() + i);
+        QVERIFY(vehicle);
+        QTRY_VERIFY_WITH_TIMEOUT(vehicle->parameterManager()->parametersReady(), 10000);
+    }
+}
@@ -0,0 +1,27 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef MockLinkSwarmTest_H
+#define MockLinkSwarmTest_H
+
+#include "UnitTest.h"
+#include "MockLinkSwarm.h"
+
+class MockLinkSwarmTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _messageMix(void);
+    void _deterministic(void);
+    void _parameterAndMissionTraffic(void);
+    void _swarmMockLink(void);
+};
+
+#endif
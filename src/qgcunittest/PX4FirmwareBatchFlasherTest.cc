@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "PX4FirmwareBatchFlasherTest.h"
+#include "PX4FirmwareBatchFlasher.h"
+
+#include <QSignalSpy>
+#include <QElapsedTimer>
+
+/// Treats the fake test ports as flashable boards and ignores any real ports
+class TestBatchFlasher : public PX4FirmwareBatchFlasher
+{
+public:
+    TestBatchFlasher(void)
+        : PX4FirmwareBatchFlasher(NULL, SerialPortWatcher::BackendManual)
+    { }
+
+    /// Plugs in a fake board, the port doesn't exist so the worker never finds a bootloader
+    void plugIn(const char* devName)
+    {
+        QByteArray devPath = QByteArray("/devices/pci0000:00/0000:00:14.0/usb1/1-2/1-2:1.0/tty/") + devName;
+        QByteArray event;
+        event.append(QByteArray("add@") + devPath).append('\0');
+        event.append(QByteArray("ACTION=add")).append('\0');
+        event.append(QByteArray("DEVPATH=") + devPath).append('\0');
+        event.append(QByteArray("SUBSYSTEM=tty")).append('\0');
+        event.append(QByteArray("DEVNAME=") + devName).append('\0');
+        portWatcher()->processUevent(event);
+    }
+
+protected:
+    bool _portIsFlashable(const QString& systemLocation) { return systemLocation.startsWith(QStringLiteral("/dev/ttyQGCTest")); }
+};
+
+/// Must stay below the worker's bootloader search timeout, otherwise the sessions end on their own
+static const int _cancelTimeoutMsecs = 3000;
+
+void PX4FirmwareBatchFlasherTest::_startStopRestart_test(void)
+{
+    TestBatchFlasher flasher;
+    QSignalSpy busySpy(&flasher, SIGNAL(busyChanged(bool)));
+
+    QCOMPARE(flasher.start(QStringLiteral("test.px4")), true);
+    QCOMPARE(flasher.active(), true);
+    QCOMPARE(flasher.busy(), true);
+    QCOMPARE(busySpy.count(), 1);
+
+    flasher.plugIn("ttyQGCTest0");
+    flasher.plugIn("ttyQGCTest1");
+    QCOMPARE(flasher.boards()->count(), 2);
+
+    // Stop cancels the sessions still searching, busy only clears once their workers are done
+    flasher.stop();
+    QCOMPARE(flasher.active(), false);
+    QCOMPARE(flasher.busy(), true);
+    QCOMPARE(flasher.start(QStringLiteral("test.px4")), false);
+    QCOMPARE(flasher.active(), false);
+
+    QVERIFY(busySpy.wait(_cancelTimeoutMsecs));
+    QCOMPARE(flasher.busy(), false);
+    QCOMPARE(busySpy.last()[0].toBool(), false);
+    for (int i=0; i<flasher.boards()->count(); i++) {
+        PX4FirmwareBatchFlashBoard* board = flasher.boards()->value<PX4FirmwareBatchFlashBoard*>(i);
+        QCOMPARE(board->state(), PX4FirmwareBatchFlashBoard::StateCancelled);
+    }
+    QCOMPARE(flasher.property("failedCount").toInt(), 0);
+    QCOMPARE(flasher.property("completeCount").toInt(), 0);
+
+    // Restart drops the cancelled boards and picks up new ones
+    busySpy.clear();
+    QCOMPARE(flasher.start(QStringLiteral("test.px4")), true);
+    QCOMPARE(flasher.busy(), true);
+    QCOMPARE(flasher.boards()->count(), 0);
+    flasher.plugIn("ttyQGCTest0");
+    QCOMPARE(flasher.boards()->count(), 1);
+
+    flasher.stop();
+    QVERIFY(busySpy.wait(_cancelTimeoutMsecs));
+    QCOMPARE(flasher.busy(), false);
+}
+
+void PX4FirmwareBatchFlasherTest::_destroyWhileBusy_test(void)
+{
+    TestBatchFlasher* flasher = new TestBatchFlasher();
+
+    QCOMPARE(flasher->start(QStringLiteral("test.px4")), true);
+    flasher->plugIn("ttyQGCTest0");
+    QCOMPARE(flasher->boards()->count(), 1);
+
+    // Workers are cancelled and left to clean up after themselves instead of being waited for
+    QElapsedTimer timer;
+    timer.start();
+    delete flasher;
+    QVERIFY(timer.elapsed() < _cancelTimeoutMsecs);
+}
@@ -0,0 +1,26 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef PX4FirmwareBatchFlasherTest_H
+#define PX4FirmwareBatchFlasherTest_H
+
+#include "UnitTest.h"
+
+/// Unit test for the batch flasher session lifetime. Ports are faked through a manual SerialPortWatcher and
+/// never answer, so sessions stay in the bootloader search until they are cancelled.
+class PX4FirmwareBatchFlasherTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _startStopRestart_test(void);
+    void _destroyWhileBusy_test(void);
+};
+
+#endif
@@ -0,0 +1,108 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "SerialPortWatcherTest.h"
+#include "SerialPortWatcher.h"
+
+#include <QSignalSpy>
+
+/// Builds a uevent in the format the kernel sends it
+static QByteArray _kernelEvent(const char* action, const char* devPath, const char* subsystem, const char* devName)
+{
+    QByteArray event;
+    event.append(QByteArray(action) + "@" + devPath).append('\0');
+    event.append(QByteArray("ACTION=") + action).append('\0');
+    event.append(QByteArray("DEVPATH=") + devPath).append('\0');
+    event.append(QByteArray("SUBSYSTEM=") + subsystem).append('\0');
+    event.append(QByteArray("DEVNAME=") + devName).append('\0');
+    event.append(QByteArray("SEQNUM=1234")).append('\0');
+    return event;
+}
+
+/// Builds a uevent in the format udev forwards it to monitors
+static QByteArray _udevEvent(const char* action, const char* devPath, const char* subsystem, const char* devName)
+{
+    QByteArray properties;
+    properties.append(QByteArray("ACTION=") + action).append('\0');
+    properties.append(QByteArray("DEVPATH=") + devPath).append('\0');
+    properties.append(QByteArray("SUBSYSTEM=") + subsystem).append('\0');
+    properties.append(QByteArray("DEVNAME=/dev/") + devName).append('\0');
+
+    const quint32 headerSize = 40;
+    quint32 header[10];
+    memset(header, 0, sizeof(header));
+    memcpy(header, "libudev\0", 8);
+    header[3] = headerSize;
+    header[4] = headerSize;
+    header[5] = properties.count();
+
+    return QByteArray((const char*)header, sizeof(header)) + properties;
+}
+
+void SerialPortWatcherTest::_kernelEvent_test(void)
+{
+    SerialPortWatcher watcher(SerialPortWatcher::BackendManual);
+    watcher.start();
+    QCOMPARE(watcher.backend(), SerialPortWatcher::BackendManual);
+    QCOMPARE(watcher.ports().count(), 0);
+
+    QSignalSpy spyAdded(&watcher, SIGNAL(portAdded(const QString&)));
+    QSignalSpy spyRemoved(&watcher, SIGNAL(portRemoved(const QString&)));
+
+    watcher.processUevent(_kernelEvent("add", "/devices/pci0000:00/0000:00:14.0/usb1/1-2/1-2:1.0/tty/ttyACM0", "tty", "ttyACM0"));
+    QCOMPARE(spyAdded.count(), 1);
+    QCOMPARE(spyAdded[0][0].toString(), QStringLiteral("/dev/ttyACM0"));
+    QVERIFY(watcher.containsPort(QStringLiteral("/dev/ttyACM0")));
+
+    // Repeated add is not a change
+    watcher.processUevent(_kernelEvent("add", "/devices/pci0000:00/0000:00:14.0/usb1/1-2/1-2:1.0/tty/ttyACM0", "tty", "ttyACM0"));
+    QCOMPARE(spyAdded.count(), 1);
+
+    watcher.processUevent(_kernelEvent("remove", "/devices/pci0000:00/0000:00:14.0/usb1/1-2/1-2:1.0/tty/ttyACM0", "tty", "ttyACM0"));
+    QCOMPARE(spyRemoved.count(), 1);
+    QCOMPARE(spyRemoved[0][0].toString(), QStringLiteral("/dev/ttyACM0"));
+    QCOMPARE(watcher.ports().count(), 0);
+}
+
+void SerialPortWatcherTest::_udevEvent_test(void)
+{
+    SerialPortWatcher watcher(SerialPortWatcher::BackendManual);
+    watcher.start();
+
+    QSignalSpy spyAdded(&watcher, SIGNAL(portAdded(const QString&)));
+
+    watcher.processUevent(_udevEvent("add", "/devices/pci0000:00/0000:00:14.0/usb1/1-3/1-3:1.0/ttyUSB0/tty/ttyUSB0", "tty", "ttyUSB0"));
+    watcher.processUevent(_udevEvent("add", "/devices/pci0000:00/0000:00:14.0/usb1/1-4/1-4:1.0/tty/ttyACM1", "tty", "ttyACM1"));
+    QCOMPARE(spyAdded.count(), 2);
+    QCOMPARE(watcher.ports().count(), 2);
+    QVERIFY(watcher.containsPort(QStringLiteral("/dev/ttyUSB0")));
+    QVERIFY(watcher.containsPort(QStringLiteral("/dev/ttyACM1")));
+
+    // Truncated header must be ignored
+    watcher.processUevent(_udevEvent("remove", "/devices/pci0000:00/0000:00:14.0/usb1/1-4/1-4:1.0/tty/ttyACM1", "tty", "ttyACM1").left(20));
+    QCOMPARE(watcher.ports().count(), 2);
+}
+
+void SerialPortWatcherTest::_ignoredEvent_test(void)
+{
+    SerialPortWatcher watcher(SerialPortWatcher::BackendManual);
+    watcher.start();
+
+    QSignalSpy spyAdded(&watcher, SIGNAL(portAdded(const QString&)));
+
+    // Virtual tty, other subsystem, other action and garbage
+    watcher.processUevent(_kernelEvent("add", "/devices/virtual/tty/tty5", "tty", "tty5"));
+    watcher.processUevent(_kernelEvent("add", "/devices/pci0000:00/0000:00:14.0/usb1/1-2/1-2:1.0", "usb", "bus/usb/001/004"));
+    watcher.processUevent(_kernelEvent("change", "/devices/pci0000:00/0000:00:14.0/usb1/1-2/1-2:1.0/tty/ttyACM0", "tty", "ttyACM0"));
+    watcher.processUevent(QByteArray("garbage"));
+    watcher.processUevent(QByteArray());
+
+    QCOMPARE(spyAdded.count(), 0);
+    QCOMPARE(watcher.ports().count(), 0);
+}
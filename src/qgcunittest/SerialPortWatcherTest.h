@@ -0,0 +1,26 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef SerialPortWatcherTest_H
+#define SerialPortWatcherTest_H
+
+#include "UnitTest.h"
+
+/// Unit test for SerialPortWatcher, using fake hot-plug events
+class SerialPortWatcherTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _kernelEvent_test(void);
+    void _udevEvent_test(void);
+    void _ignoredEvent_test(void);
+};
+
+#endif
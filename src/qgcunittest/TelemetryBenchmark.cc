@@ -0,0 +1,377 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TelemetryBenchmark.h"
+#include "MockLink.h"
+#include "MultiVehicleManager.h"
+#include "MAVLinkProtocol.h"
+#include "LinkManager.h"
+#include "ParameterManager.h"
+#include "QGCApplication.h"
+#include "QGC.h"
+
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QDateTime>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+// Heap allocations are only counted on the dispatching thread while a measurement runs, the link threads and everything
+// outside of the measurement pass straight through. On glibc malloc itself is wrapped, which also catches the allocations
+// of the Qt containers. Elsewhere only operator new is counted.
+
+static thread_local bool    _countAllocations = false;
+static thread_local quint64 _allocationCount = 0;
+
+#ifdef __GLIBC__
+
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size)
+{
+    if (_countAllocations) {
+        _allocationCount++;
+    }
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+    if (_countAllocations) {
+        _allocationCount++;
+    }
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    if (_countAllocations) {
+        _allocationCount++;
+    }
+    return __libc_realloc(ptr, size);
+}
+
+}
+
+#else
+
+void* operator new(size_t size)
+{
+    if (_countAllocations) {
+        _allocationCount++;
+    }
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    free(ptr);
+}
+
+#endif
+
+TelemetryBenchmark::TelemetryBenchmark(const QString& outputFile, const QString& tlogFile)
+    : _outputFile   (outputFile)
+    , _tlogFile     (tlogFile)
+    , _mockLink     (NULL)
+    , _vehicle      (NULL)
+{
+
+}
+
+int TelemetryBenchmark::run(void)
+{
+    if (!_connectMockLink()) {
+        qWarning() << "Benchmark vehicle failed to connect";
+        return -1;
+    }
+
+    QJsonArray benchmarks;
+
+    benchmarks.append(_runInbound(QStringLiteral("InboundLight"),   _syntheticTraffic(MockLinkSwarm::MessageMixLight)));
+    benchmarks.append(_runInbound(QStringLiteral("InboundTypical"), _syntheticTraffic(MockLinkSwarm::MessageMixTypical)));
+    benchmarks.append(_runInbound(QStringLiteral("InboundHeavy"),   _syntheticTraffic(MockLinkSwarm::MessageMixHeavy)));
+    if (!_tlogFile.isEmpty()) {
+        QList<QByteArray> packets = _recordedTraffic();
+        if (packets.isEmpty()) {
+            qWarning() << "No mavlink messages in" << _tlogFile;
+            _disconnectMockLink();
+            return -1;
+        }
+        benchmarks.append(_runInbound(QStringLiteral("InboundRecorded"), packets));
+    }
+    benchmarks.append(_runOutbound(QStringLiteral("Outbound"), outboundMessageCount));
+
+    _disconnectMockLink();
+
+    QJsonObject results;
+    results[QStringLiteral("version")] =    qgcApp()->applicationVersion();
+    results[QStringLiteral("date")] =       QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    results[QStringLiteral("benchmarks")] = benchmarks;
+
+    QByteArray json = QJsonDocument(results).toJson();
+    if (_outputFile.isEmpty()) {
+        fputs(json.constData(), stdout);
+    } else {
+        QFile file(_outputFile);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size()) {
+            qWarning() << "Unable to write benchmark results" << _outputFile << file.errorString();
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+bool TelemetryBenchmark::_connectMockLink(void)
+{
+    MultiVehicleManager* multiVehicleManager = qgcApp()->toolbox()->multiVehicleManager();
+
+    // The synthetic traffic is sent as the swarm vehicle, the MockLink vehicle keeps its own system id and sequence
+    _mockLink = MockLink::startSwarmMockLink(1, 0, MockLinkSwarm::MessageMixLight);
+
+    QElapsedTimer timeout;
+    timeout.start();
+    while (timeout.elapsed() < 10000) {
+        _vehicle = multiVehicleManager->getVehicleById(_mockLink->swarm()->firstSystemId());
+        if (_vehicle && _vehicle->parameterManager()->parametersReady() && _vehicle->initialPlanRequestComplete()) {
+            return true;
+        }
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 100);
+    }
+
+    return false;
+}
+
+void TelemetryBenchmark::_disconnectMockLink(void)
+{
+    if (_mockLink) {
+        QSignalSpy linkSpy(qgcApp()->toolbox()->linkManager(), SIGNAL(linkDeleted(LinkInterface*)));
+
+        qgcApp()->toolbox()->linkManager()->disconnectLink(_mockLink);
+        linkSpy.wait(1000);
+
+        _mockLink = NULL;
+        _vehicle = NULL;
+    }
+}
+
+/// @return Packets of the message mix as sent by the MockLink vehicle
+QList<QByteArray> TelemetryBenchmark::_syntheticTraffic(MockLinkSwarm::MessageMix_t messageMix)
+{
+    QList<mavlink_message_t>    messages;
+    QList<QByteArray>           packets;
+    MockLinkSwarm               swarm(NULL, _vehicle->id(), 1, 1, MockLinkSwarm::config(messageMix));
+
+    swarm.setCapture(&messages);
+    swarm.runTicks(MockLinkSwarm::tickHz * syntheticSeconds);
+
+    foreach (const mavlink_message_t& message, messages) {
+        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+        int     len = mavlink_msg_to_send_buffer(buffer, &message);
+
+        packets.append(QByteArray((const char*)buffer, len));
+    }
+
+    return packets;
+}
+
+/// Reads the vehicle messages from the tlog, they are re-addressed to the MockLink vehicle so the Vehicle processes
+/// them like its own telemetry.
+QList<QByteArray> TelemetryBenchmark::_recordedTraffic(void)
+{
+    QList<QByteArray>   packets;
+    QFile               file(_tlogFile);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Unable to open" << _tlogFile << file.errorString();
+        return packets;
+    }
+
+    QByteArray          bytes = file.readAll();
+    mavlink_message_t   rxBuffer;
+    mavlink_status_t    rxStatus;
+    mavlink_message_t   message;
+    mavlink_status_t    status;
+    int                 gcsSystemId = qgcApp()->toolbox()->mavlinkProtocol()->getSystemId();
+
+    memset(&rxBuffer, 0, sizeof(rxBuffer));
+    memset(&rxStatus, 0, sizeof(rxStatus));
+
+    // Each tlog entry is a 64 bit timestamp followed by the packet
+    int position = 0;
+    while (position + (int)sizeof(quint64) < bytes.size()) {
+        position += sizeof(quint64);
+
+        bool received = false;
+        while (!received && position < bytes.size()) {
+            received = QGCMAVLink::parseChar(&rxBuffer, &rxStatus, (uint8_t)bytes[position++], &message, &status) == MAVLINK_FRAMING_OK;
+        }
+        if (!received || message.sysid == gcsSystemId) {
+            continue;
+        }
+
+        const mavlink_msg_entry_t* entry = mavlink_get_msg_entry(message.msgid);
+        if (!entry) {
+            continue;
+        }
+        mavlink_finalize_message_chan(&message, _vehicle->id(), message.compid, 0, entry->min_msg_len, message.len, entry->crc_extra);
+
+        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+        int     len = mavlink_msg_to_send_buffer(buffer, &message);
+        packets.append(QByteArray((const char*)buffer, len));
+    }
+
+    return packets;
+}
+
+QJsonObject TelemetryBenchmark::_runInbound(const QString& name, const QList<QByteArray>& packets)
+{
+    MAVLinkProtocol*    mavlinkProtocol = qgcApp()->toolbox()->mavlinkProtocol();
+    QVector<qint64>     latencies(packets.count());
+    QElapsedTimer       elapsed;
+    QElapsedTimer       latency;
+
+    _startMeasurement();
+    elapsed.start();
+    for (int i=0; i<packets.count(); i++) {
+        latency.start();
+        mavlinkProtocol->receiveBytes(_mockLink, packets[i]);
+        latencies[i] = latency.nsecsElapsed();
+
+        if (i % eventLoopInterval == 0) {
+            // Queued work such as the FactGroup updates is part of the throughput
+            QCoreApplication::processEvents();
+        }
+    }
+    QCoreApplication::processEvents();
+    qint64 elapsedNsecs = elapsed.nsecsElapsed();
+
+    return _result(name, latencies, elapsedNsecs, _stopMeasurement());
+}
+
+QJsonObject TelemetryBenchmark::_runOutbound(const QString& name, int count)
+{
+    QVector<qint64>     latencies(count);
+    QElapsedTimer       elapsed;
+    QElapsedTimer       latency;
+    mavlink_message_t   message;
+
+    mavlink_msg_heartbeat_pack_chan(qgcApp()->toolbox()->mavlinkProtocol()->getSystemId(),
+                                    qgcApp()->toolbox()->mavlinkProtocol()->getComponentId(),
+                                    _mockLink->mavlinkChannel(),
+                                    &message,
+                                    MAV_TYPE_GCS,
+                                    MAV_AUTOPILOT_INVALID,
+                                    MAV_MODE_MANUAL_ARMED,
+                                    0,
+                                    MAV_STATE_ACTIVE);
+
+    _startMeasurement();
+    elapsed.start();
+    for (int i=0; i<count; i++) {
+        // Latency is until the bytes are handed to the link thread
+        latency.start();
+        _vehicle->sendMessageOnLink(_mockLink, message);
+        QCoreApplication::sendPostedEvents(_vehicle, QEvent::MetaCall);
+        latencies[i] = latency.nsecsElapsed();
+
+        if (i % eventLoopInterval == 0) {
+            QCoreApplication::processEvents();
+        }
+    }
+    QCoreApplication::processEvents();
+    qint64 elapsedNsecs = elapsed.nsecsElapsed();
+
+    return _result(name, latencies, elapsedNsecs, _stopMeasurement());
+}
+
+/// Pauses the MockLink telemetry and starts counting allocations
+void TelemetryBenchmark::_startMeasurement(void)
+{
+    _mockLink->setTelemetryPaused(true);
+
+    // Telemetry which is already on its way is not part of the measurement
+    QGC::SLEEP::msleep(100);
+    QCoreApplication::processEvents();
+
+    _allocationCount = 0;
+    _countAllocations = true;
+}
+
+/// @return Allocations since _startMeasurement
+quint64 TelemetryBenchmark::_stopMeasurement(void)
+{
+    _countAllocations = false;
+    _mockLink->setTelemetryPaused(false);
+
+    return _allocationCount;
+}
+
+QJsonObject TelemetryBenchmark::_result(const QString& name, QVector<qint64>& latencies, qint64 elapsedNsecs, quint64 allocations)
+{
+    QJsonObject result;
+    int         count = latencies.count();
+
+    std::sort(latencies.begin(), latencies.end());
+
+    result[QStringLiteral("name")] =                    name;
+    result[QStringLiteral("messages")] =                count;
+    result[QStringLiteral("messagesPerSecond")] =       elapsedNsecs ? (count * 1e9) / elapsedNsecs : 0.0;
+    result[QStringLiteral("p50LatencyUsecs")] =         count ? latencies[count / 2] / 1000.0 : 0.0;
+    result[QStringLiteral("p99LatencyUsecs")] =         count ? latencies[qMin(count - 1, (count * 99) / 100)] / 1000.0 : 0.0;
+    result[QStringLiteral("allocationsPerMessage")] =   count ? (double)allocations / count : 0.0;
+    result[QStringLiteral("peakMemoryKB")] =            (double)_peakMemoryKB();
+
+    return result;
+}
+
+/// @return Peak resident memory of the process, -1 if not available on this platform
+qint64 TelemetryBenchmark::_peakMemoryKB(void)
+{
+#ifdef Q_OS_UNIX
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef Q_OS_MAC
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+    return -1;
+}
@@ -0,0 +1,71 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef TelemetryBenchmark_H
+#define TelemetryBenchmark_H
+
+#include <QObject>
+#include <QList>
+#include <QJsonObject>
+
+#include "MockLinkSwarm.h"
+
+class MockLink;
+class Vehicle;
+
+/// Measures the telemetry paths end to end against a MockLink swarm vehicle:
+///     Inbound: MAVLinkProtocol::receiveBytes -> Vehicle -> FactGroup, fed with synthetic (MockLinkSwarm message mixes) or
+///              recorded (tlog) traffic
+///     Outbound: Vehicle::sendMessageOnLink -> LinkInterface
+/// Each benchmark reports messages/s, p50/p99 dispatch latency, heap allocations per message on the dispatching thread and
+/// the peak memory of the process. Results are written as json so they can be compared across commits
+/// (see tools/compare_benchmarks.py).
+///
+/// The benchmark vehicle is a swarm vehicle, so its system id is not shared with the telemetry of the MockLink vehicle.
+/// The MockLink telemetry is paused while measuring.
+///
+/// Built with qmake CONFIG+=QGCBenchmark on top of the unit test build, run with --benchmark[:results.json].
+class TelemetryBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// @param outputFile Json results are written to this file, empty for stdout
+    /// @param tlogFile Recorded traffic to replay in addition to the synthetic traffic, empty for none
+    TelemetryBenchmark(const QString& outputFile, const QString& tlogFile);
+
+    /// @return 0: all benchmarks ran, -1: failure
+    int run(void);
+
+    static const int syntheticSeconds =     60;     ///< Seconds of synthetic traffic for each message mix
+    static const int outboundMessageCount = 20000;
+    static const int eventLoopInterval =    100;    ///< Messages between running the event loop, which is not counted as latency
+
+private:
+    bool    _connectMockLink    (void);
+    void    _disconnectMockLink (void);
+    void    _startMeasurement   (void);
+    quint64 _stopMeasurement    (void);
+
+    QList<QByteArray>   _syntheticTraffic   (MockLinkSwarm::MessageMix_t messageMix);
+    QList<QByteArray>   _recordedTraffic    (void);
+
+    QJsonObject _runInbound     (const QString& name, const QList<QByteArray>& packets);
+    QJsonObject _runOutbound    (const QString& name, int count);
+    QJsonObject _result         (const QString& name, QVector<qint64>& latencies, qint64 elapsedNsecs, quint64 allocations);
+
+    static qint64 _peakMemoryKB(void);
+
+    QString     _outputFile;
+    QString     _tlogFile;
+    MockLink*   _mockLink;
+    Vehicle*    _vehicle;
+};
+
+#endif
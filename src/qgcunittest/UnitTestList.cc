@@ -11,6 +11,7 @@
 // We keep the list of all unit tests in a global location so it's easier to see which
 // ones are enabled/disabled
 
+#include "FactMetaDataTest.h"
 #include "FactSystemTestGeneric.h"
 #include "FactSystemTestPX4.h"
 #include "FileDialogTest.h"
@@ -32,6 +33,10 @@
 #include "MissionCommandTreeTest.h"
 #include "LogDownloadTest.h"
 #include "SendMavCommandTest.h"
+#include "TrajectoryPointsTest.h"
+#include "ImageCoverageTest.h"
+#include "MAVLinkLogProcessorTest.h"
+#include "ULogStreamDecoderTest.h"
 #include "VisualMissionItemTest.h"
 #include "CameraSectionTest.h"
 #include "SpeedSectionTest.h"
@@ -44,7 +49,18 @@
 #include "CorridorScanComplexItemTest.h"
 #include "TransectStyleComplexItemTest.h"
 #include "CameraCalcTest.h"
+#include "MAVLinkMessageStatisticsTest.h"
+#include "LinkQualityStatisticsTest.h"
+#include "SerialPortWatcherTest.h"
+#include "RTCM/NTRIPSourceTest.h"
+#include "MockLinkSwarmTest.h"
+#include "HilLockstepProtocolTest.h"
+#include "VideoLatencyProbeTest.h"
+#include "Crc32Test.h"
+#include "PX4FirmwareBatchFlasherTest.h"
+#include "RTCM/RTCMMavlinkTest.h"
 
+UT_REGISTER_TEST(FactMetaDataTest)
 UT_REGISTER_TEST(FactSystemTestGeneric)
 UT_REGISTER_TEST(FactSystemTestPX4)
 UT_REGISTER_TEST(FileDialogTest)
@@ -63,6 +79,10 @@ UT_REGISTER_TEST(ParameterManagerTest)
 UT_REGISTER_TEST(MissionCommandTreeTest)
 UT_REGISTER_TEST(LogDownloadTest)
 UT_REGISTER_TEST(SendMavCommandTest)
+UT_REGISTER_TEST(TrajectoryPointsTest)
+UT_REGISTER_TEST(ImageCoverageTest)
+UT_REGISTER_TEST(MAVLinkLogProcessorTest)
+UT_REGISTER_TEST(ULogStreamDecoderTest)
 UT_REGISTER_TEST(SurveyMissionItemTest)
 UT_REGISTER_TEST(CameraSectionTest)
 UT_REGISTER_TEST(SpeedSectionTest)
@@ -75,6 +95,16 @@ UT_REGISTER_TEST(CorridorScanComplexItemTest)
 UT_REGISTER_TEST(TransectStyleComplexItemTest)
 UT_REGISTER_TEST(QGCMapPolylineTest)
 UT_REGISTER_TEST(CameraCalcTest)
+UT_REGISTER_TEST(MAVLinkMessageStatisticsTest)
+UT_REGISTER_TEST(LinkQualityStatisticsTest)
+UT_REGISTER_TEST(SerialPortWatcherTest)
+UT_REGISTER_TEST(NTRIPSourceTest)
+UT_REGISTER_TEST(MockLinkSwarmTest)
+UT_REGISTER_TEST(HilLockstepProtocolTest)
+UT_REGISTER_TEST(VideoLatencyProbeTest)
+UT_REGISTER_TEST(Crc32Test)
+UT_REGISTER_TEST(PX4FirmwareBatchFlasherTest)
+UT_REGISTER_TEST(RTCMMavlinkTest)
 
 // List of unit test which are currently disabled.
 // If disabling a new test, include reason in comment.
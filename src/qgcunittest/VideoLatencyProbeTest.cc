@@ -0,0 +1,152 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "VideoLatencyProbeTest.h"
+#include "VideoLatencyProbe.h"
+
+#if defined(QGC_GST_STREAMING)
+
+static const int    _testFrames =   60;
+
+static const char*  _senderPipeline =
+        "videotestsrc is-live=true num-buffers=60 ! video/x-raw,width=320,height=240,framerate=30/1 ! "
+        "x264enc tune=zerolatency speed-preset=ultrafast key-int-max=15 ! rtph264pay config-interval=1 ! "
+        "udpsink host=127.0.0.1 port=5610";
+
+static const char*  _receiverPipeline =
+        "udpsrc port=5610 caps=\"application/x-rtp, media=(string)video, clock-rate=(int)90000, encoding-name=(string)H264\" ! "
+        "rtph264depay name=depay ! h264parse name=parser ! queue ! avdec_h264 name=decoder ! queue ! "
+        "fakesink name=sink sync=false";
+
+/// Attaches the probe to the receive pipeline the same way VideoReceiver does
+static void _attachProbe(VideoLatencyProbe& probe, GstElement* receiver)
+{
+    GstElement* depay =     gst_bin_get_by_name(GST_BIN(receiver), "depay");
+    GstElement* parser =    gst_bin_get_by_name(GST_BIN(receiver), "parser");
+    GstElement* decoder =   gst_bin_get_by_name(GST_BIN(receiver), "decoder");
+    GstElement* sink =      gst_bin_get_by_name(GST_BIN(receiver), "sink");
+
+    GstPad* sourcePad = gst_element_get_static_pad(depay,   "sink");
+    GstPad* depayPad =  gst_element_get_static_pad(parser,  "sink");
+    GstPad* decodePad = gst_element_get_static_pad(decoder, "src");
+    GstPad* sinkPad =   gst_element_get_static_pad(sink,    "sink");
+
+    probe.attach(sourcePad, depayPad, decodePad, sinkPad, true /* rtp */);
+
+    gst_object_unref(sourcePad);
+    gst_object_unref(depayPad);
+    gst_object_unref(decodePad);
+    gst_object_unref(sinkPad);
+    gst_object_unref(depay);
+    gst_object_unref(parser);
+    gst_object_unref(decoder);
+    gst_object_unref(sink);
+}
+
+/// Runs the sender to completion into the receiver
+///     @return false: Pipelines could not be created, required plugins are missing
+static bool _runUdpLoop(VideoLatencyProbe& probe)
+{
+    GstElement* receiver =  gst_parse_launch(_receiverPipeline, NULL);
+    GstElement* sender =    gst_parse_launch(_senderPipeline, NULL);
+
+    if (!receiver || !sender) {
+        if (receiver) {
+            gst_object_unref(receiver);
+        }
+        if (sender) {
+            gst_object_unref(sender);
+        }
+        return false;
+    }
+
+    _attachProbe(probe, receiver);
+
+    gst_element_set_state(receiver, GST_STATE_PLAYING);
+    gst_element_set_state(sender, GST_STATE_PLAYING);
+
+    GstBus*     bus = gst_element_get_bus(sender);
+    GstMessage* message = gst_bus_timed_pop_filtered(bus, 10 * GST_SECOND, (GstMessageType)(GST_MESSAGE_EOS | GST_MESSAGE_ERROR));
+    if (message) {
+        gst_message_unref(message);
+    }
+    gst_object_unref(bus);
+
+    // Let the receiver drain what is still in flight
+    QTest::qWait(500);
+
+    gst_element_set_state(sender, GST_STATE_NULL);
+    gst_element_set_state(receiver, GST_STATE_NULL);
+    gst_object_unref(sender);
+    gst_object_unref(receiver);
+
+    return true;
+}
+
+#endif
+
+void VideoLatencyProbeTest::_udpLoop(void)
+{
+#if defined(QGC_GST_STREAMING)
+    VideoLatencyProbe probe;
+
+    if (!_runUdpLoop(probe)) {
+        QSKIP("GStreamer plugins for the UDP loop not available");
+    }
+    QVERIFY(probe.attached());
+
+    VideoLatencyStatistics statistics = probe.takeStatistics();
+    probe.detach();
+
+    QVERIFY(statistics.frames > 0);
+    QVERIFY(statistics.frames <= _testFrames);
+    QVERIFY(statistics.frameRate > 0);
+    QVERIFY(statistics.receiveMsecs >= 0);
+    QVERIFY(statistics.decodeMsecs >= 0);
+    QVERIFY(statistics.renderMsecs >= 0);
+    QVERIFY(statistics.totalMsecs >= statistics.receiveMsecs);
+    QVERIFY(qAbs(statistics.totalMsecs - (statistics.receiveMsecs + statistics.decodeMsecs + statistics.renderMsecs)) < 0.01);
+    QVERIFY(statistics.maxTotalMsecs >= statistics.totalMsecs);
+    QVERIFY(statistics.frameJitterMsecs >= 0);
+    QVERIFY(statistics.maxFrameJitterMsecs >= statistics.frameJitterMsecs);
+    QVERIFY(statistics.droppedFrames + (quint32)statistics.frames <= (quint32)_testFrames);
+
+    // Statistics are per period
+    statistics = probe.takeStatistics();
+    QCOMPARE(statistics.frames, 0);
+    QCOMPARE(statistics.totalMsecs, 0.0);
+#else
+    QSKIP("Built without video streaming");
+#endif
+}
+
+void VideoLatencyProbeTest::_detach(void)
+{
+#if defined(QGC_GST_STREAMING)
+    VideoLatencyProbe probe;
+
+    QVERIFY(!probe.attached());
+
+    // Nothing attached, nothing counted
+    VideoLatencyStatistics statistics = probe.takeStatistics();
+    QCOMPARE(statistics.frames, 0);
+    QCOMPARE(statistics.droppedFrames, (quint32)0);
+    QCOMPARE(statistics.lostPackets, (quint32)0);
+
+    // Probes on NULL pads are skipped
+    probe.attach(NULL, NULL, NULL, NULL, false);
+    QVERIFY(probe.attached());
+    probe.detach();
+    QVERIFY(!probe.attached());
+    probe.detach();
+    QVERIFY(!probe.attached());
+#else
+    QSKIP("Built without video streaming");
+#endif
+}
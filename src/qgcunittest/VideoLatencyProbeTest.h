@@ -0,0 +1,26 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef VideoLatencyProbeTest_H
+#define VideoLatencyProbeTest_H
+
+#include "UnitTest.h"
+
+/// Unit tests for VideoLatencyProbe. Streams videotestsrc over a local UDP loop through a receive pipeline laid
+/// out like the one in VideoReceiver.
+class VideoLatencyProbeTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _udpLoop(void);
+    void _detach(void);
+};
+
+#endif
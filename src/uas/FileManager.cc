@@ -21,17 +21,77 @@
 
 QGC_LOGGING_CATEGORY(FileManagerLog, "FileManagerLog")
 
+void FileManagerGaps::reset(uint32_t fileSize)
+{
+    _gaps.clear();
+    if (fileSize) {
+        _gaps.insert(0, fileSize);
+    }
+    _missingBytes = fileSize;
+}
+
+void FileManagerGaps::received(uint32_t offset, uint32_t size)
+{
+    uint32_t end = offset + size;
+
+    // Start with the gap containing offset, if there is one
+    QMap<uint32_t, uint32_t>::iterator iter = _gaps.upperBound(offset);
+    if (iter != _gaps.begin()) {
+        --iter;
+        if (iter.value() <= offset) {
+            ++iter;
+        }
+    }
+
+    while (iter != _gaps.end() && iter.key() < end) {
+        uint32_t gapStart = iter.key();
+        uint32_t gapEnd = iter.value();
+
+        iter = _gaps.erase(iter);
+        _missingBytes -= qMin(gapEnd, end) - qMax(gapStart, offset);
+
+        if (gapStart < offset) {
+            _gaps.insert(gapStart, offset);
+        }
+        if (gapEnd > end) {
+            _gaps.insert(end, gapEnd);
+            break;
+        }
+    }
+}
+
+uint32_t FileManagerGaps::nextGap(uint32_t offset) const
+{
+    QMap<uint32_t, uint32_t>::const_iterator iter = _gaps.upperBound(offset);
+    if (iter != _gaps.constBegin()) {
+        QMap<uint32_t, uint32_t>::const_iterator previous = iter;
+        --previous;
+        if (previous.value() > offset) {
+            return offset;
+        }
+    }
+    if (iter != _gaps.constEnd()) {
+        return iter.key();
+    }
+    return _gaps.constBegin().key();
+}
+
 FileManager::FileManager(QObject* parent, Vehicle* vehicle)
     : QObject(parent)
     , _currentOperation(kCOIdle)
     , _vehicle(vehicle)
     , _dedicatedLink(NULL)
+    , _seqNumber(0)
     , _activeSession(0)
-    , _missingDownloadedBytes(0)
-    , _downloadingMissingParts(false)
+    , _controlDownload(NULL)
+    , _maxDownloadSessions(maxDownloadSessions)
     , _systemIdQGC(0)
 {
     connect(&_ackTimer, &QTimer::timeout, this, &FileManager::_ackTimeout);
+
+    _downloadTimer.setSingleShot(false);
+    _downloadTimer.setInterval(ackTimerTimeoutMsecs);
+    connect(&_downloadTimer, &QTimer::timeout, this, &FileManager::_downloadTimeout);
     
     _lastOutgoingRequest.hdr.seqNumber = 0;
 
@@ -41,108 +101,256 @@ FileManager::FileManager(QObject* parent, Vehicle* vehicle)
     Q_ASSERT(sizeof(RequestHeader) == 12);
 }
 
-/// Respond to the Ack associated with the Open command with the next read command.
+FileManager::~FileManager()
+{
+    qDeleteAll(_downloads);
+}
+
+/// Respond to the Ack associated with the Open command by preallocating the local file and starting the download.
 void FileManager::_openAckResponse(Request* openAck)
 {
     qCDebug(FileManagerLog) << QString("_openAckResponse: _currentOperation(%1) _readFileLength(%2)").arg(_currentOperation).arg(openAck->openFileLength);
     
 	Q_ASSERT(_currentOperation == kCOOpenRead || _currentOperation == kCOOpenBurst);
-	_currentOperation = _currentOperation == kCOOpenRead ? kCORead : kCOBurst;
-    _activeSession = openAck->hdr.session;
-    
+    _currentOperation = kCOIdle;
+
+    DownloadSession* download = _controlDownload;
+    _controlDownload = NULL;
+    if (!download) {
+        return;
+    }
+
     // File length comes back in data
     Q_ASSERT(openAck->hdr.size == sizeof(uint32_t));
-    _downloadFileSize = openAck->openFileLength;
-    
-    // Start the sequence of read commands
 
-    _downloadOffset = 0;            // Start reading at beginning of file
-    _readFileAccumulator.clear();   // Start with an empty file
-    _missingDownloadedBytes = 0;
-    _downloadingMissingParts = false;
-    _missingData.clear();
+    download->state = kDSTransfer;
+    download->session = openAck->hdr.session;
+    download->fileSize = openAck->openFileLength;
+    download->readOffset = 0;
+    download->requestOffset = 0;
+    download->firstSeqNumber = _seqNumber;
+    download->ackNumTries = 0;
+    download->gaps.reset(download->fileSize);
+    download->lastResponse.start();
+
+    if (!_downloadTimer.isActive()) {
+        _downloadTimer.start();
+    }
 
-    Request request;
-    request.hdr.session = _activeSession;
-	Q_ASSERT(_currentOperation == kCORead || _currentOperation == kCOBurst);
-	request.hdr.opcode = _currentOperation == kCORead ? kCmdReadFile : kCmdBurstReadFile;
-    request.hdr.offset = _downloadOffset;
-    request.hdr.size = sizeof(request.data);
+    // Blocks are written in place as they arrive, so the file needs its full size up front
+    if (!download->file.open(QIODevice::ReadWrite | QIODevice::Truncate) || !download->file.resize(download->fileSize)) {
+        _closeDownloadSession(download, false /* failure */, tr("Unable to open local file for writing (%1)").arg(download->file.fileName()));
+        return;
+    }
 
-    _sendRequest(&request);
+    _requestNextBlock(download);
 }
 
-/// request the next missing part of a (partially) downloaded file
-void FileManager::_requestMissingData()
+/// Requests the next missing part of a download, or closes the session once nothing is missing.
+void FileManager::_requestNextBlock(DownloadSession* download)
 {
-    if (_missingData.empty()) {
-        _downloadingMissingParts = false;
-        _missingDownloadedBytes = 0;
-        // there might be more data missing at the end
-        if ((uint32_t)_readFileAccumulator.length() != _downloadFileSize) {
-            _downloadOffset = _readFileAccumulator.length();
-            qCDebug(FileManagerLog) << QString("_requestMissingData: missing parts done, downloadOffset(%1) downloadFileSize(%2)")
-                    .arg(_downloadOffset).arg(_downloadFileSize);
+    if (download->gaps.isEmpty()) {
+        _closeDownloadSession(download, true /* success */);
+        return;
+    }
+
+    // Keep going from where the last block left off, wrapping around to whatever was dropped before that
+    uint32_t offset = download->gaps.nextGap(download->readOffset);
+    uint8_t opcode = kCmdReadFile;
+
+    if (download->burst) {
+        if (offset == download->readOffset) {
+            opcode = kCmdBurstReadFile;
         } else {
-            _closeDownloadSession(true);
-            return;
+            // Bursting again would resend everything up to the end of the file, just fetch the holes
+            download->burst = false;
         }
+    }
+
+    qCDebug(FileManagerLog) << QString("_requestNextBlock: %1 offset(%2) gaps(%3) missing(%4)")
+                               .arg(download->remotePath).arg(offset).arg(download->gaps.count()).arg(download->gaps.missingBytes());
+
+    _sendDownloadRequest(download, opcode, offset);
+}
+
+/// Closes out a download session on the vehicle. Verifying the file or signalling the error follows once the
+/// vehicle confirms the session is closed.
+///     @param success true: all bytes received, false: error during download
+///     @param errorMsg Error to signal if !success
+void FileManager::_closeDownloadSession(DownloadSession* download, bool success, const QString& errorMsg)
+{
+    qCDebug(FileManagerLog) << QString("_closeDownloadSession: %1 success(%2) missingBytes(%3)").arg(download->remotePath).arg(success).arg(download->gaps.missingBytes());
+    
+    download->state = kDSTerminate;
+    download->success = success;
+    download->errorMsg = errorMsg;
+    download->ackNumTries = 0;
+
+    _sendTerminateCommand(download);
+}
+
+/// Called once the vehicle has closed the session of a download.
+void FileManager::_finishDownloadSession(DownloadSession* download)
+{
+    if (download->success) {
+        download->file.flush();
+        download->state = kDSVerify;
     } else {
-        qCDebug(FileManagerLog) << QString("_requestMissingData: offset(%1) size(%2)").arg(_missingData.head().offset).arg(_missingData.head().size);
+        QString errorMsg = download->errorMsg;
+        _removeDownload(download, false /* keepFile */);
+        _emitErrorMessage(errorMsg);
+    }
+}
 
-        _downloadOffset = _missingData.head().offset;
+/// Removes a download from the list, closing the local file. The local file is deleted unless keepFile is set.
+void FileManager::_removeDownload(DownloadSession* download, bool keepFile)
+{
+    download->file.close();
+    if (!keepFile && !download->file.fileName().isEmpty()) {
+        download->file.remove();
     }
 
-    Request request;
-    _currentOperation = kCORead;
-    request.hdr.session = _activeSession;
-    request.hdr.opcode = kCmdReadFile;
-    request.hdr.offset = _downloadOffset;
-    request.hdr.size = sizeof(request.data);
+    _downloads.removeOne(download);
+    if (_controlDownload == download) {
+        _controlDownload = NULL;
+    }
+    delete download;
 
-    _sendRequest(&request);
+    if (_downloads.isEmpty()) {
+        // The vehicle may have had sessions tied up elsewhere, try the full amount next time around
+        _maxDownloadSessions = maxDownloadSessions;
+    }
 }
 
-/// Closes out a download session by writing the file and doing cleanup.
-///     @param success true: successful download completion, false: error during download
-void FileManager::_closeDownloadSession(bool success)
+/// Drops the download which is waiting on an Open or CalcFileCRC32 response. The caller signals the error.
+void FileManager::_abortControlDownload(void)
 {
-    qCDebug(FileManagerLog) << QString("_closeDownloadSession: success(%1) missingBytes(%2)").arg(success).arg(_missingDownloadedBytes);
-    
-    _currentOperation = kCOIdle;
-    
-    if (success) {
-        if (_missingDownloadedBytes > 0 || (uint32_t)_readFileAccumulator.length() < _downloadFileSize) {
-            // we're not done yet: request the missing parts individually (either we had missing parts or
-            // the last (few) packets right before the EOF got dropped)
-            _downloadingMissingParts = true;
-            _requestMissingData();
+    if (_controlDownload) {
+        _removeDownload(_controlDownload, false /* keepFile */);
+    }
+}
+
+/// Sends the next Open or CalcFileCRC32 command needed by the downloads, if the command state machine is free.
+void FileManager::_startNextDownloadCommand(void)
+{
+    if (_currentOperation != kCOIdle || _ackTimer.isActive()) {
+        return;
+    }
+
+    // Finish downloads before starting new ones
+    foreach (DownloadSession* download, _downloads) {
+        if (download->state == kDSVerify) {
+            _controlDownload = download;
+            _currentOperation = kCOCalcCRC;
+
+            Request request;
+            request.hdr.session = 0;
+            request.hdr.opcode = kCmdCalcFileCRC32;
+            request.hdr.offset = 0;
+            request.hdr.size = 0;
+            _fillRequestWithString(&request, download->remotePath);
+            _sendRequest(&request);
             return;
         }
+    }
+
+    if (_activeDownloadCount() >= _maxDownloadSessions) {
+        return;
+    }
 
-        QString downloadFilePath = _readFileDownloadDir.absoluteFilePath(_readFileDownloadFilename);
+    foreach (DownloadSession* download, _downloads) {
+        if (download->state == kDSQueued) {
+            _controlDownload = download;
+            _currentOperation = download->burst ? kCOOpenBurst : kCOOpenRead;
 
-        QFile file(downloadFilePath);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-            _emitErrorMessage(tr("Unable to open local file for writing (%1)").arg(downloadFilePath));
+            Request request;
+            request.hdr.session = 0;
+            request.hdr.opcode = kCmdOpenFileRO;
+            request.hdr.offset = 0;
+            request.hdr.size = 0;
+            _fillRequestWithString(&request, download->remotePath);
+            _sendRequest(&request);
             return;
         }
+    }
+}
+
+/// @return Number of downloads which hold a session on the vehicle
+int FileManager::_activeDownloadCount(void) const
+{
+    int count = 0;
+
+    foreach (const DownloadSession* download, _downloads) {
+        if (download->state == kDSTransfer || download->state == kDSTerminate) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/// @brief Respond to the Ack or Nak associated with the CalcFileCRC32 command sent for a completed download.
+void FileManager::_crcResponse(Request* crcResponse)
+{
+    _currentOperation = kCOIdle;
 
-        qint64 bytesWritten = file.write((const char *)_readFileAccumulator, _readFileAccumulator.length());
-        if (bytesWritten != _readFileAccumulator.length()) {
-            file.close();
-            _emitErrorMessage(tr("Unable to write data to local file (%1)").arg(downloadFilePath));
+    DownloadSession* download = _controlDownload;
+    _controlDownload = NULL;
+    if (!download) {
+        return;
+    }
+
+    QString localFilePath = download->file.fileName();
+
+    if (crcResponse->hdr.opcode == kRspNak) {
+        uint8_t errorCode = crcResponse->data[0];
+
+        if (errorCode == kErrUnknownCommand) {
+            // Older firmware, all we can go by is having received every byte of the reported size
+            qCDebug(FileManagerLog) << "_crcResponse: vehicle does not support CalcFileCRC32, skipping check" << download->remotePath;
+        } else {
+            _removeDownload(download, false /* keepFile */);
+            _emitErrorMessage(tr("Nak received verifying download, error: %1").arg(errorString(errorCode)));
             return;
         }
-        file.close();
+    } else {
+        uint32_t localCrc;
 
-        emit commandComplete();
+        if (!_fileCrc32(download->file, localCrc)) {
+            _removeDownload(download, false /* keepFile */);
+            _emitErrorMessage(tr("Unable to read back local file (%1)").arg(localFilePath));
+            return;
+        }
+        if (crcResponse->hdr.size != sizeof(uint32_t) || crcResponse->fileCrc32 != localCrc) {
+            _removeDownload(download, false /* keepFile */);
+            _emitErrorMessage(tr("Download: CRC of local file (%1) differs from file on vehicle (%2)").arg(localCrc, 8, 16, QChar('0')).arg(crcResponse->fileCrc32, 8, 16, QChar('0')));
+            return;
+        }
     }
-    
-    _readFileAccumulator.clear();
-    
-    // Close the open session
-    _sendResetCommand();
+
+    _removeDownload(download, true /* keepFile */);
+    emit downloadComplete(localFilePath);
+    emit commandComplete();
+}
+
+/// Calculates the CRC32 of the specified open file, same as CalcFileCRC32 on the vehicle
+bool FileManager::_fileCrc32(QFile& file, uint32_t& crc)
+{
+    char buffer[16 * 1024];
+
+    crc = 0;
+    if (!file.seek(0)) {
+        return false;
+    }
+    while (!file.atEnd()) {
+        qint64 cBytes = file.read(buffer, sizeof(buffer));
+        if (cBytes <= 0) {
+            return false;
+        }
+        crc = QGC::crc32((const quint8*)buffer, cBytes, crc);
+    }
+
+    return true;
 }
 
 /// Closes out an upload session doing cleanup.
@@ -159,78 +367,136 @@ void FileManager::_closeUploadSession(bool success)
         emit commandComplete();
     }
     
-    // Close the open session
-    _sendResetCommand();
+    // Close the open session. Resetting all sessions would also close the sessions of running downloads.
+    if (_activeDownloadCount() == 0) {
+        _sendResetCommand();
+    } else {
+        Request request;
+        request.hdr.session = _activeSession;
+        request.hdr.opcode = kCmdTerminateSession;
+        request.hdr.offset = 0;
+        request.hdr.size = 0;
+        _sendRequest(&request);
+    }
 }
 
-/// Respond to the Ack associated with the Read or Stream commands.
-///		@param readFile: true: read file, false: stream file
-void FileManager::_downloadAckResponse(Request* readAck, bool readFile)
+/// @return Download the Read, Burst or Terminate response belongs to, NULL for responses to the command state machine
+FileManager::DownloadSession* FileManager::_downloadForResponse(Request* response)
 {
-    if (readAck->hdr.session != _activeSession) {
-        _closeDownloadSession(false /* failure */);
-        _emitErrorMessage(tr("Download: Incorrect session returned"));
-        return;
+    if (response->hdr.req_opcode != kCmdReadFile && response->hdr.req_opcode != kCmdBurstReadFile && response->hdr.req_opcode != kCmdTerminateSession) {
+        return NULL;
     }
 
-    if (readAck->hdr.offset != _downloadOffset) {
-        if (readFile) {
-            _closeDownloadSession(false /* failure */);
-            _emitErrorMessage(tr("Download: Offset returned (%1) differs from offset requested/expected (%2)").arg(readAck->hdr.offset).arg(_downloadOffset));
-            return;
-        } else { // burst
-            if (readAck->hdr.offset < _downloadOffset) { // old data: ignore it
-                _setupAckTimeout();
-                return;
-            }
-            // keep track of missing data chunks
-            MissingData missingData;
-            missingData.offset = _downloadOffset;
-            missingData.size = readAck->hdr.offset - _downloadOffset;
-            _missingData.push_back(missingData);
-            _missingDownloadedBytes += readAck->hdr.offset - _downloadOffset;
-            qCDebug(FileManagerLog) << QString("_downloadAckResponse: missing data: offset(%1) size(%2)").arg(missingData.offset).arg(missingData.size);
-            _downloadOffset = readAck->hdr.offset;
-            _readFileAccumulator.resize(_downloadOffset); // placeholder for the missing data
+    foreach (DownloadSession* download, _downloads) {
+        if ((download->state == kDSTransfer || download->state == kDSTerminate) && download->session == response->hdr.session) {
+            return download;
         }
     }
-    
-    qCDebug(FileManagerLog) << QString("_downloadAckResponse: offset(%1) size(%2) burstComplete(%3)").arg(readAck->hdr.offset).arg(readAck->hdr.size).arg(readAck->hdr.burstComplete);
-
-    if (_downloadingMissingParts) {
-        Q_ASSERT(_missingData.head().offset == _downloadOffset);
-        _missingDownloadedBytes -= readAck->hdr.size;
-        _readFileAccumulator.replace(_downloadOffset, readAck->hdr.size, (const char*)readAck->data, readAck->hdr.size);
-        if (_missingData.head().size <= readAck->hdr.size) {
-            _missingData.pop_front();
-        } else {
-            _missingData.head().size -= readAck->hdr.size;
-            _missingData.head().offset += readAck->hdr.size;
+
+    return NULL;
+}
+
+/// Respond to a Read, Burst or Terminate response for a download.
+void FileManager::_downloadResponse(DownloadSession* download, Request* response)
+{
+    // Session ids are reused by the vehicle, drop stragglers from a previous download in the same session
+    if ((uint16_t)(response->hdr.seqNumber - download->firstSeqNumber - 1) >= (std::numeric_limits<uint16_t>::max()/2)) {
+        qCDebug(FileManagerLog) << "_downloadResponse: response from before download started" << download->remotePath << response->hdr.seqNumber;
+        return;
+    }
+
+    if (response->hdr.req_opcode == kCmdTerminateSession) {
+        if (download->state == kDSTerminate) {
+            _finishDownloadSession(download);
         }
+        return;
+    }
+
+    if (download->state != kDSTransfer) {
+        // Burst packets which were already on their way when we sent Terminate
+        return;
+    }
+
+    download->lastResponse.start();
+    download->ackNumTries = 0;
+
+    if (response->hdr.opcode == kRspAck) {
+        _downloadAckResponse(download, response);
+    } else if (response->hdr.opcode == kRspNak) {
+        _downloadNakResponse(download, response);
     } else {
-        _downloadOffset += readAck->hdr.size;
-        _readFileAccumulator.append((const char*)readAck->data, readAck->hdr.size);
+        _emitErrorMessage(tr("Unknown opcode returned from server: %1").arg(response->hdr.opcode));
     }
-    
-    if (_downloadFileSize != 0) {
-        emit commandProgress(100 * ((float)(_readFileAccumulator.length() - _missingDownloadedBytes) / (float)_downloadFileSize));
+}
+
+/// Respond to the Ack associated with the Read or Stream commands by writing the block to its place in the local file.
+void FileManager::_downloadAckResponse(DownloadSession* download, Request* readAck)
+{
+    uint32_t offset = readAck->hdr.offset;
+    uint32_t size = readAck->hdr.size;
+
+    qCDebug(FileManagerLog) << QString("_downloadAckResponse: offset(%1) size(%2) burstComplete(%3)").arg(offset).arg(size).arg(readAck->hdr.burstComplete);
+
+    if (size > sizeof(readAck->data) || offset > download->fileSize || size > download->fileSize - offset) {
+        _closeDownloadSession(download, false /* failure */, tr("Download: Data returned past end of file: offset(%1) size(%2) file size(%3)").arg(offset).arg(size).arg(download->fileSize));
+        return;
     }
 
-    if (_downloadingMissingParts) {
-        _requestMissingData();
-    } else if (readFile || readAck->hdr.burstComplete) {
-        // Possibly still more data to read, send next read request
+    if (!download->file.seek(offset) || download->file.write((const char*)readAck->data, size) != (qint64)size) {
+        _closeDownloadSession(download, false /* failure */, tr("Unable to write data to local file (%1)").arg(download->file.fileName()));
+        return;
+    }
 
-        Request request;
-        request.hdr.session = _activeSession;
-        request.hdr.opcode = readFile ? kCmdReadFile : kCmdBurstReadFile;
-        request.hdr.offset = _downloadOffset;
-        request.hdr.size = 0;
+    download->gaps.received(offset, size);
+    download->readOffset = offset + size;
 
-        _sendRequest(&request);
-    } else if (!readFile) {
-        // Streaming, so next ack should come automatically
-        _setupAckTimeout();
+    _emitDownloadProgress();
+
+    if (download->gaps.isEmpty()) {
+        _closeDownloadSession(download, true /* success */);
+    } else if (readAck->hdr.req_opcode == kCmdReadFile) {
+        // Duplicate responses to a resent Read still fill in data, but must not start a second chain of requests
+        if (offset == download->requestOffset) {
+            _requestNextBlock(download);
+        }
+    } else if (readAck->hdr.burstComplete) {
+        _requestNextBlock(download);
+    }
+
+    // Otherwise we are streaming, so the next ack should come automatically
+}
+
+/// Respond to the Nak associated with the Read or Stream commands.
+void FileManager::_downloadNakResponse(DownloadSession* download, Request* readNak)
+{
+    uint8_t errorCode = readNak->data[0];
+
+    if (errorCode == kErrEOF && readNak->hdr.req_opcode == kCmdBurstReadFile) {
+        // The burst ran to the end of the file, pick up whatever it dropped
+        download->burst = false;
+        _requestNextBlock(download);
+    } else if (errorCode == kErrEOF) {
+        _closeDownloadSession(download, false /* failure */, tr("Download: File on vehicle is shorter than reported (%1)").arg(download->fileSize));
+    } else {
+        _closeDownloadSession(download, false /* failure */, tr("Nak received, error: %1").arg(errorString(errorCode)));
+    }
+}
+
+/// Emits the progress over all running downloads
+void FileManager::_emitDownloadProgress(void)
+{
+    quint64 totalBytes = 0;
+    quint64 receivedBytes = 0;
+
+    foreach (const DownloadSession* download, _downloads) {
+        if (download->state == kDSTransfer) {
+            totalBytes += download->fileSize;
+            receivedBytes += download->fileSize - download->gaps.missingBytes();
+        }
+    }
+
+    if (totalBytes != 0) {
+        emit commandProgress(100 * ((float)receivedBytes / (float)totalBytes));
     }
 }
 
@@ -391,6 +657,28 @@ void FileManager::receiveMessage(mavlink_message_t message)
     
     Request* request = (Request*)&data.payload[0];
 
+    // New requests must go past every sequence number seen so far. Otherwise the vehicle could mistake a new
+    // request for a resend of the request belonging to the last response it sent.
+    if ((uint16_t)(request->hdr.seqNumber - _seqNumber) < (std::numeric_limits<uint16_t>::max()/2)) {
+        _seqNumber = request->hdr.seqNumber;
+    }
+
+    DownloadSession* download = _downloadForResponse(request);
+    if (download) {
+        _downloadResponse(download, request);
+    } else if (request->hdr.req_opcode == kCmdReadFile || request->hdr.req_opcode == kCmdBurstReadFile) {
+        // Late response for a download which is already closed, the command state machine never sends these
+        qCDebug(FileManagerLog) << "Dropping response for closed download session" << request->hdr.session;
+    } else {
+        _controlResponse(request);
+    }
+
+    _startNextDownloadCommand();
+}
+
+/// @brief Handles responses to the command state machine
+void FileManager::_controlResponse(Request* request)
+{
     uint16_t incomingSeqNumber = request->hdr.seqNumber;
     
     // Make sure we have a good sequence number
@@ -407,15 +695,7 @@ void FileManager::receiveMessage(mavlink_message_t message)
 	qCDebug(FileManagerLog) << "receiveMessage" << request->hdr.opcode;
 	
     if (incomingSeqNumber != expectedSeqNumber) {
-        bool doAbort = true;
         switch (_currentOperation) {
-            case kCOBurst: // burst download drops are handled in _downloadAckResponse()
-                doAbort = false;
-                break;
-            case kCORead:
-                _closeDownloadSession(false /* failure */);
-                break;
-            
             case kCOWrite:
                 _closeUploadSession(false /* failure */);
                 break;
@@ -424,9 +704,15 @@ void FileManager::receiveMessage(mavlink_message_t message)
             case kCOOpenBurst:
             case kCOCreate:
                 // We could have an open session hanging around
+                _abortControlDownload();
                 _currentOperation = kCOIdle;
                 _sendResetCommand();
                 break;
+
+            case kCOCalcCRC:
+                _abortControlDownload();
+                _currentOperation = kCOIdle;
+                break;
                 
             default:
                 // Don't need to do anything special
@@ -434,14 +720,9 @@ void FileManager::receiveMessage(mavlink_message_t message)
                 break;
         }
         
-        if (doAbort) {
-            _emitErrorMessage(tr("Bad sequence number on received message: expected(%1) received(%2)").arg(expectedSeqNumber).arg(incomingSeqNumber));
-            return;
-        }
+        _emitErrorMessage(tr("Bad sequence number on received message: expected(%1) received(%2)").arg(expectedSeqNumber).arg(incomingSeqNumber));
+        return;
     }
-    
-    // Move past the incoming sequence number for next request
-    _lastOutgoingRequest.hdr.seqNumber = incomingSeqNumber;
 
     if (request->hdr.opcode == kRspAck) {
         switch (request->hdr.req_opcode) {
@@ -454,13 +735,9 @@ void FileManager::receiveMessage(mavlink_message_t message)
 				_openAckResponse(request);
 				break;
 				
-			case kCmdReadFile:
-				_downloadAckResponse(request, true /* read file */);
-				break;
-				
-			case kCmdBurstReadFile:
-				_downloadAckResponse(request, false /* stream file */);
-				break;
+            case kCmdCalcFileCRC32:
+                _crcResponse(request);
+                break;
 				
             case kCmdCreateFile:
                 _createAckResponse(request);
@@ -487,9 +764,14 @@ void FileManager::receiveMessage(mavlink_message_t message)
             // This is not an error, just the end of the list loop
             emit commandComplete();
             return;
-        } else if ((request->hdr.req_opcode == kCmdReadFile || request->hdr.req_opcode == kCmdBurstReadFile) && errorCode == kErrEOF) {
-            // This is not an error, just the end of the download loop
-            _closeDownloadSession(true /* success */);
+        } else if (request->hdr.req_opcode == kCmdOpenFileRO && errorCode == kErrNoSessionsAvailable && _activeDownloadCount() != 0) {
+            // We found the vehicle's session limit. The download stays queued until one of the running ones is done.
+            _maxDownloadSessions = _activeDownloadCount();
+            _controlDownload = NULL;
+            qCDebug(FileManagerLog) << "Vehicle out of sessions, limiting concurrent downloads to" << _maxDownloadSessions;
+            return;
+        } else if (request->hdr.req_opcode == kCmdCalcFileCRC32) {
+            _crcResponse(request);
             return;
         } else if (request->hdr.req_opcode == kCmdCreateFile) {
             _emitErrorMessage(tr("Nak received creating file, error: %1").arg(errorString(request->data[0])));
@@ -499,9 +781,9 @@ void FileManager::receiveMessage(mavlink_message_t message)
             return;
         } else {
             // Generic Nak handling
-            if (request->hdr.req_opcode == kCmdReadFile || request->hdr.req_opcode == kCmdBurstReadFile) {
-                // Nak error during download loop, download failed
-                _closeDownloadSession(false /* failure */);
+            if (request->hdr.req_opcode == kCmdOpenFileRO) {
+                // Nak error opening download, download failed
+                _abortControlDownload();
             } else if (request->hdr.req_opcode == kCmdWriteFile) {
                 // Nak error during upload loop, upload failed
                 _closeUploadSession(false /* failure */);
@@ -561,11 +843,6 @@ void FileManager::_sendListCommand(void)
 
 void FileManager::downloadPath(const QString& from, const QDir& downloadDir)
 {
-    if (_currentOperation != kCOIdle) {
-        _emitErrorMessage(tr("Command not sent. Waiting for previous command to complete."));
-        return;
-    }
-
     _dedicatedLink = _vehicle->priorityLink();
     if (!_dedicatedLink) {
         _emitErrorMessage(tr("Command not sent. No Vehicle links."));
@@ -578,11 +855,6 @@ void FileManager::downloadPath(const QString& from, const QDir& downloadDir)
 
 void FileManager::streamPath(const QString& from, const QDir& downloadDir)
 {
-    if (_currentOperation != kCOIdle) {
-        _emitErrorMessage(tr("Command not sent. Waiting for previous command to complete."));
-        return;
-    }
-
     _dedicatedLink = _vehicle->priorityLink();
     if (!_dedicatedLink) {
         _emitErrorMessage(tr("Command not sent. No Vehicle links."));
@@ -599,8 +871,6 @@ void FileManager::_downloadWorker(const QString& from, const QDir& downloadDir,
 		return;
 	}
 	
-	_readFileDownloadDir.setPath(downloadDir.absolutePath());
-	
 	// We need to strip off the file name from the fully qualified path. We can't use the usual QDir
 	// routines because this path does not exist locally.
 	int i;
@@ -610,17 +880,22 @@ void FileManager::_downloadWorker(const QString& from, const QDir& downloadDir,
 		}
 	}
 	i++; // move past slash
-	_readFileDownloadFilename = from.right(from.size() - i);
-	
-	_currentOperation = readFile ? kCOOpenRead : kCOOpenBurst;
-	
-	Request request;
-	request.hdr.session = 0;
-	request.hdr.opcode = kCmdOpenFileRO;
-	request.hdr.offset = 0;
-	request.hdr.size = 0;
-	_fillRequestWithString(&request, from);
-	_sendRequest(&request);
+
+    DownloadSession* download = new DownloadSession;
+    download->state = kDSQueued;
+    download->remotePath = from;
+    download->file.setFileName(downloadDir.absoluteFilePath(from.right(from.size() - i)));
+    download->burst = !readFile;
+    download->success = false;
+    download->session = 0;
+    download->fileSize = 0;
+    download->readOffset = 0;
+    download->requestOffset = 0;
+    download->firstSeqNumber = 0;
+    download->ackNumTries = 0;
+    _downloads.append(download);
+
+    _startNextDownloadCommand();
 }
 
 /// @brief Uploads the specified file.
@@ -771,19 +1046,7 @@ void FileManager::_ackTimeout(void)
     
     if (++_ackNumTries <= ackTimerMaxRetries) {
         qCDebug(FileManagerLog) << "ack timeout - retrying";
-        if (_currentOperation == kCOBurst) {
-            // for burst downloads try to initiate a new burst
-            Request request;
-            request.hdr.session = _activeSession;
-            request.hdr.opcode = kCmdBurstReadFile;
-            request.hdr.offset = _downloadOffset;
-            request.hdr.size = 0;
-            request.hdr.seqNumber = ++_lastOutgoingRequest.hdr.seqNumber;
-
-            _sendRequestNoAck(&request);
-        } else {
-            _sendRequestNoAck(&_lastOutgoingRequest);
-        }
+        _sendRequestNoAck(&_lastOutgoingRequest);
         return;
     }
 
@@ -794,18 +1057,19 @@ void FileManager::_ackTimeout(void)
     // to idle. FileView UI works this way with the List command.
 
     switch (_currentOperation) {
-        case kCORead:
-        case kCOBurst:
-            _closeDownloadSession(false /* failure */);
-            _emitErrorMessage(tr("Timeout waiting for ack: Download failed"));
-            break;
-            
         case kCOOpenRead:
         case kCOOpenBurst:
+            _abortControlDownload();
             _currentOperation = kCOIdle;
             _emitErrorMessage(tr("Timeout waiting for ack: Download failed"));
             _sendResetCommand();
             break;
+
+        case kCOCalcCRC:
+            _abortControlDownload();
+            _currentOperation = kCOIdle;
+            _emitErrorMessage(tr("Timeout waiting for ack: Download could not be verified"));
+            break;
             
         case kCOCreate:
             _currentOperation = kCOIdle;
@@ -826,10 +1090,78 @@ void FileManager::_ackTimeout(void)
         }
             break;
     }
+
+    _startNextDownloadCommand();
+}
+
+/// @brief Checks the running downloads for ack timeouts. Each download retries on its own.
+void FileManager::_downloadTimeout(void)
+{
+    QList<DownloadSession*> downloads = _downloads;
+
+    foreach (DownloadSession* download, downloads) {
+        if ((download->state != kDSTransfer && download->state != kDSTerminate) || download->lastResponse.elapsed() < ackTimerTimeoutMsecs) {
+            continue;
+        }
+
+        if (++download->ackNumTries <= ackTimerMaxRetries) {
+            qCDebug(FileManagerLog) << "download ack timeout - retrying" << download->remotePath;
+            if (download->state == kDSTransfer) {
+                // For burst downloads this initiates a new burst
+                _requestNextBlock(download);
+            } else {
+                _sendTerminateCommand(download);
+            }
+        } else if (download->state == kDSTransfer) {
+            _closeDownloadSession(download, false /* failure */, tr("Timeout waiting for ack: Download failed"));
+        } else {
+            // The vehicle never confirmed the session is closed, there is nothing more we can do about it
+            _finishDownloadSession(download);
+        }
+    }
+
+    if (_activeDownloadCount() == 0) {
+        _downloadTimer.stop();
+    }
+
+    _startNextDownloadCommand();
 }
 
+/// Closing a single session leaves the sessions of other downloads alone
+void FileManager::_sendTerminateCommand(DownloadSession* download)
+{
+    _sendDownloadRequest(download, kCmdTerminateSession, 0);
+}
+
+/// @brief Sends a request for a download. These are outside of the command state machine, each download keeps
+/// track of its own ack timeout.
+void FileManager::_sendDownloadRequest(DownloadSession* download, uint8_t opcode, uint32_t offset)
+{
+    Request request;
+    request.hdr.seqNumber = ++_seqNumber;
+    request.hdr.session = download->session;
+    request.hdr.opcode = opcode;
+    request.hdr.offset = offset;
+    request.hdr.size = opcode == kCmdTerminateSession ? 0 : sizeof(request.data);
+
+    if (opcode != kCmdTerminateSession) {
+        download->requestOffset = offset;
+    }
+    download->lastResponse.start();
+
+    qCDebug(FileManagerLog) << "_sendDownloadRequest opcode:" << opcode << "session:" << download->session << "offset:" << offset << "seqNumber:" << request.hdr.seqNumber;
+
+    _sendRequestNoAck(&request);
+}
+
+/// Resets all sessions on the vehicle. Skipped while downloads are running, since that would close their sessions as well.
 void FileManager::_sendResetCommand(void)
 {
+    if (_activeDownloadCount() != 0) {
+        qCDebug(FileManagerLog) << "_sendResetCommand: skipped, downloads running";
+        return;
+    }
+
     Request request;
     request.hdr.opcode = kCmdResetSessions;
     request.hdr.size = 0;
@@ -854,7 +1186,7 @@ void FileManager::_sendRequest(Request* request)
 
     _setupAckTimeout();
     
-    request->hdr.seqNumber = ++_lastOutgoingRequest.hdr.seqNumber;
+    request->hdr.seqNumber = ++_seqNumber;
     // store the current request
     if (request->hdr.size <= sizeof(request->data)) {
         memcpy(&_lastOutgoingRequest, request, sizeof(RequestHeader) + request->hdr.size);
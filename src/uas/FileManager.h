@@ -14,7 +14,10 @@
 #include <QObject>
 #include <QDir>
 #include <QTimer>
-#include <QQueue>
+#include <QFile>
+#include <QMap>
+#include <QList>
+#include <QElapsedTimer>
 
 #include "UASInterface.h"
 #include "QGCLoggingCategory.h"
@@ -30,12 +33,38 @@ Q_DECLARE_LOGGING_CATEGORY(FileManagerLog)
 
 class Vehicle;
 
+/// Byte ranges of a download which have not been received yet. Blocks can arrive in any order, each one only
+/// touches the gaps it overlaps.
+class FileManagerGaps
+{
+public:
+    FileManagerGaps(void) : _missingBytes(0) { }
+
+    /// Starts over with a single gap covering the whole file
+    void reset(uint32_t fileSize);
+
+    /// Removes the specified range from the gaps. Ranges which were already received are ignored.
+    void received(uint32_t offset, uint32_t size);
+
+    /// @return First missing offset at or after the specified offset, wrapping around to the first gap. Only valid if !isEmpty().
+    uint32_t nextGap(uint32_t offset) const;
+
+    bool        isEmpty     (void) const { return _gaps.isEmpty(); }
+    int         count       (void) const { return _gaps.count(); }
+    uint32_t    missingBytes(void) const { return _missingBytes; }
+
+private:
+    QMap<uint32_t, uint32_t>    _gaps;          ///< Gap start offset -> gap end offset (exclusive)
+    uint32_t                    _missingBytes;
+};
+
 class FileManager : public QObject
 {
     Q_OBJECT
     
 public:
     FileManager(QObject* parent, Vehicle* vehicle);
+    ~FileManager();
     
     /// These methods are only used for testing purposes.
     bool _sendCmdTestAck(void) { return _sendOpcodeOnlyCmd(kCmdNone, kCOAck); };
@@ -47,12 +76,17 @@ public:
 
     static const int ackTimerMaxRetries = 6;
 
-	/// Downloads the specified file.
+    /// Maximum number of downloads which run at the same time. Fewer are used if the vehicle runs out of sessions.
+    static const int maxDownloadSessions = 4;
+
+	/// Downloads the specified file. Downloads are queued and run concurrently, each one signals commandComplete
+	/// or commandError when done. Blocks are written straight to the local file and the result is checked against
+	/// the CRC of the file on the vehicle.
 	///     @param from File to download from UAS, fully qualified path
 	///     @param downloadDir Local directory to download file to
 	void downloadPath(const QString& from, const QDir& downloadDir);
 	
-	/// Stream downloads the specified file.
+	/// Stream downloads the specified file. Same as downloadPath, using Burst reads.
 	///     @param from File to download from UAS, fully qualified path
 	///     @param downloadDir Local directory to download file to
 	void streamPath(const QString& from, const QDir& downloadDir);
@@ -77,6 +111,10 @@ signals:
     
     /// Signalled after a command has completed
     void commandComplete(void);
+
+    /// Signalled along with commandComplete when a download has completed
+    ///     @param localFilePath Fully qualified path of the downloaded file
+    void downloadComplete(const QString& localFilePath);
     
     /// Signalled when an error occurs during a command. In this case a commandComplete signal will
     /// not be sent.
@@ -91,6 +129,7 @@ public slots:
 	
 private slots:
 	void _ackTimeout(void);
+    void _downloadTimeout(void);
 
 private:
     /// @brief This is the fixed length portion of the protocol data.
@@ -125,6 +164,9 @@ private:
 
             // Length of file chunk written by write command
             uint32_t writeFileLength;
+
+            // CRC32 returned by CalcFileCRC32 command
+            uint32_t fileCrc32;
         };
     }) Request;
 
@@ -176,12 +218,38 @@ private:
             kCOList,		// waiting for List response
             kCOOpenRead,    // waiting for Open response followed by Read download
 			kCOOpenBurst,   // waiting for Open response, followed by Burst download
-            kCORead,		// waiting for Read response
-			kCOBurst,		// waiting for Burst response
+            kCOCalcCRC,     // waiting for CRC32 of a downloaded file
             kCOWrite,       // waiting for Write response
             kCOCreate,      // waiting for Create response
             kCOCreateDir,   // waiting for Create Directory response
         };
+
+    /// The Read/Burst requests of a download are sent outside of the command state machine so that several
+    /// downloads can be in flight. Open and CRC32 still go through the state machine one at a time.
+    enum DownloadState
+        {
+            kDSQueued,      // waiting for the command state machine to send Open
+            kDSTransfer,    // Read/Burst requests in flight
+            kDSTerminate,   // waiting for Terminate response
+            kDSVerify,      // waiting for the command state machine to send CalcFileCRC32
+        };
+
+    struct DownloadSession {
+        DownloadState   state;
+        QString         remotePath;
+        QFile           file;               ///< Local file, preallocated to the full size once opened
+        bool            burst;              ///< true: Burst requests, false: Read requests (also used to fill in after a burst)
+        bool            success;            ///< Result of the transfer, valid from kDSTerminate on
+        QString         errorMsg;           ///< Error to signal if !success
+        uint8_t         session;            ///< Session id returned by Open
+        uint32_t        fileSize;
+        uint32_t        readOffset;         ///< Offset following the last block received
+        uint32_t        requestOffset;      ///< Offset of the last Read/Burst request
+        uint16_t        firstSeqNumber;     ///< Responses at or before this belong to an earlier user of the session id
+        FileManagerGaps gaps;
+        QElapsedTimer   lastResponse;
+        int             ackNumTries;
+    };
     
     bool _sendOpcodeOnlyCmd(uint8_t opcode, OperationState newOpState);
     void _setupAckTimeout(void);
@@ -191,18 +259,32 @@ private:
     void _sendRequest(Request* request);
     void _sendRequestNoAck(Request* request);
     void _fillRequestWithString(Request* request, const QString& str);
+    void _controlResponse(Request* request);
     void _openAckResponse(Request* openAck);
-    void _downloadAckResponse(Request* readAck, bool readFile);
+    void _crcResponse(Request* crcResponse);
+    void _downloadResponse(DownloadSession* download, Request* response);
+    void _downloadAckResponse(DownloadSession* download, Request* readAck);
+    void _downloadNakResponse(DownloadSession* download, Request* readNak);
     void _listAckResponse(Request* listAck);
     void _createAckResponse(Request* createAck);
     void _writeAckResponse(Request* writeAck);
     void _writeFileDatablock(void);
     void _sendListCommand(void);
     void _sendResetCommand(void);
-    void _closeDownloadSession(bool success);
+    void _closeDownloadSession(DownloadSession* download, bool success, const QString& errorMsg = QString());
     void _closeUploadSession(bool success);
     void _downloadWorker(const QString& from, const QDir& downloadDir, bool readFile);
-    void _requestMissingData();
+    void _requestNextBlock(DownloadSession* download);
+    void _sendDownloadRequest(DownloadSession* download, uint8_t opcode, uint32_t offset);
+    void _sendTerminateCommand(DownloadSession* download);
+    void _finishDownloadSession(DownloadSession* download);
+    void _removeDownload(DownloadSession* download, bool keepFile);
+    void _abortControlDownload(void);
+    void _startNextDownloadCommand(void);
+    void _emitDownloadProgress(void);
+    DownloadSession* _downloadForResponse(Request* response);
+    int _activeDownloadCount(void) const;
+    static bool _fileCrc32(QFile& file, uint32_t& crc);
     
     static QString errorString(uint8_t errorCode);
 
@@ -213,32 +295,23 @@ private:
     Vehicle*        _vehicle;
     LinkInterface*  _dedicatedLink; ///< Link to use for communication
     
-    Request  _lastOutgoingRequest; ///< contains the last outgoing packet
+    Request  _lastOutgoingRequest; ///< contains the last outgoing packet of the command state machine
+    uint16_t _seqNumber;           ///< Highest sequence number sent or received, next request goes past it
 
     unsigned    _listOffset;    ///< offset for the current List operation
     QString     _listPath;      ///< path for the current List operation
     
-    uint8_t     _activeSession;             ///< currently active session, 0 for none
-    
-    uint32_t    _readOffset;                ///< current read offset
+    uint8_t     _activeSession;             ///< currently active upload session, 0 for none
     
     uint32_t    _writeOffset;               ///< current write offset
     uint32_t    _writeSize;                 ///< current write data size
     uint32_t    _writeFileSize;             ///< Size of file being uploaded
     QByteArray  _writeFileAccumulator;      ///< Holds file being uploaded
     
-    struct MissingData {
-        uint32_t offset;
-        uint32_t size;
-    };
-    uint32_t    _downloadOffset;            ///< current download offset
-    uint32_t    _missingDownloadedBytes;    ///< number of missing bytes for burst download
-    QQueue<MissingData> _missingData;       ///< missing chunks of downloaded file (for burst downloads)
-    bool        _downloadingMissingParts;   ///< true if we are currently downloading missing parts
-    QByteArray  _readFileAccumulator;       ///< Holds file being downloaded
-    QDir        _readFileDownloadDir;       ///< Directory to download file to
-    QString     _readFileDownloadFilename;  ///< Filename (no path) for download file
-    uint32_t    _downloadFileSize;          ///< Size of file being downloaded
+    QList<DownloadSession*> _downloads;             ///< Queued and running downloads, in request order
+    DownloadSession*        _controlDownload;       ///< Download waiting for Open or CalcFileCRC32 response
+    QTimer                  _downloadTimer;         ///< Checks running downloads for ack timeouts
+    int                     _maxDownloadSessions;   ///< Lowered when the vehicle runs out of sessions
 
     uint8_t     _systemIdQGC;               ///< System ID for QGC
     uint8_t     _systemIdServer;            ///< System ID for server
@@ -27,6 +27,7 @@
 #include "QGCFlightGearLink.h"
 #include "QGCJSBSimLink.h"
 #include "QGCXPlaneLink.h"
+#include "QGCLockstepHilLink.h"
 #endif
 
 Q_DECLARE_LOGGING_CATEGORY(UASLog)
@@ -263,6 +264,7 @@ public slots:
     void enableHilFlightGear(bool enable, QString options, bool sensorHil, QObject * configuration);
     void enableHilJSBSim(bool enable, QString options);
     void enableHilXPlane(bool enable);
+    void enableHilLockstep(bool enable);
 
     /** @brief Send the full HIL state to the MAV */
     void sendHilState(quint64 time_us, float roll, float pitch, float yaw, float rollRotationRate,
@@ -297,6 +299,9 @@ public slots:
      */
     void sendHilGps(quint64 time_us, double lat, double lon, double alt, int fix_type, float eph, float epv, float vel, float vn, float ve, float vd,  float cog, int satellites);
 
+    /** @brief Sensors and GPS of a lockstep simulation step, stamped with simulation time and sent without added noise or rate limit */
+    void sendHilLockstepState(HilLockstepState state);
+
 
     /** @brief Places the UAV in Hardware-in-the-Loop simulation status **/
     void startHil();
@@ -305,8 +310,8 @@ public slots:
     void stopHil();
 #endif
 
-    /** @brief Set the values for the manual control of the vehicle */
-    void setExternalControlSetpoint(float roll, float pitch, float yaw, float thrust, quint16 buttons, int joystickMode);
+    /** @brief Set the values for the manual control of the vehicle, elapsedSecs is the time since the previous setpoint */
+    void setExternalControlSetpoint(float roll, float pitch, float yaw, float thrust, quint16 buttons, int joystickMode, float elapsedSecs);
 
     /** @brief Set the values for the 6dof manual control of the vehicle */
 #ifndef __mobile__
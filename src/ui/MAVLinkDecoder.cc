@@ -10,6 +10,8 @@ MAVLinkDecoder::MAVLinkDecoder(MAVLinkProtocol* protocol) :
     // http://blog.qt.digia.com/blog/2010/06/17/youre-doing-it-wrong/
     moveToThread(this);
 
+    qRegisterMetaType<QVector<MAVLinkDecoderSample> >("QVector<MAVLinkDecoderSample>");
+
     // Fill filter
     // Allow system status
 //    messageFilter.insert(MAVLINK_MSG_ID_HEARTBEAT, false);
@@ -56,19 +58,62 @@ void MAVLinkDecoder::run()
     moveToThread(creationThread);
 }
 
+uint qHash(const MAVLinkDecoder::SeriesKey& key, uint seed)
+{
+    return qHashBits(&key, sizeof(key), seed);
+}
+
+const MAVLinkDecoder::MessageDescriptor* MAVLinkDecoder::_messageDescriptor(const mavlink_message_t& message)
+{
+    QHash<uint32_t, MessageDescriptor>::const_iterator iter = _messageDescriptors.constFind(message.msgid);
+    if (iter != _messageDescriptors.constEnd()) {
+        return iter->info ? &iter.value() : NULL;
+    }
+
+    // First time we see this message id, build the field table once
+    MessageDescriptor& descriptor = _messageDescriptors[message.msgid];
+    descriptor.info = mavlink_get_message_info(&message);
+    if (!descriptor.info) {
+        return NULL;
+    }
+    descriptor.filtered = messageFilter.contains(message.msgid);
+    descriptor.textFiltered = textMessageFilter.contains(message.msgid);
+
+    // See if first value is a time value and if it is, use that as the arrival time for this data.
+    if (descriptor.info->num_fields > 0) {
+        const mavlink_field_info_t& firstField = descriptor.info->fields[0];
+        if (strcmp(firstField.name, "time_boot_ms") == 0 && firstField.type == MAVLINK_TYPE_UINT32_T) {
+            descriptor.timeField = MessageDescriptor::TimeBootMsField;
+        } else if (strstr(firstField.name, "usec") && firstField.type == MAVLINK_TYPE_UINT64_T) {
+            descriptor.timeField = MessageDescriptor::TimeUsecField;
+        }
+    }
+
+    descriptor.fields.reserve(descriptor.info->num_fields);
+    for (unsigned int i = 0; i < descriptor.info->num_fields; ++i) {
+        const mavlink_field_info_t& fieldInfo = descriptor.info->fields[i];
+        FieldDescriptor field;
+        field.fieldIndex = i;
+        field.type = fieldInfo.type;
+        field.arrayLength = fieldInfo.array_length;
+        field.wireOffset = fieldInfo.wire_offset;
+        descriptor.fields.append(field);
+    }
+
+    return &descriptor;
+}
+
 void MAVLinkDecoder::receiveMessage(LinkInterface* link,mavlink_message_t message)
 {
     Q_UNUSED(link);
 
     uint32_t msgid = message.msgid;
-    const mavlink_message_info_t* msgInfo = mavlink_get_message_info(&message);
-    if(!msgInfo) {
+    const MessageDescriptor* descriptor = _messageDescriptor(message);
+    if(!descriptor) {
         qWarning() << "Invalid MAVLink message received. ID:" << msgid;
         return;
     }
 
-    msgDict[message.msgid] = message;
-
     // Store an arrival time for this message. This value ends up being calculated later.
     quint64 time = 0;
 
@@ -82,18 +127,15 @@ void MAVLinkDecoder::receiveMessage(LinkInterface* link,mavlink_message_t messag
     }
     else
     {
+        const uint8_t* m = (const uint8_t*)(message.payload64);
 
-        // See if first value is a time value and if it is, use that as the arrival time for this data.
-        uint8_t fieldid = 0;
-        uint8_t* m = (uint8_t*)(msgDict[msgid].payload64);
-
-        if (QString(msgInfo->fields[fieldid].name) == QString("time_boot_ms") && msgInfo->fields[fieldid].type == MAVLINK_TYPE_UINT32_T)
+        if (descriptor->timeField == MessageDescriptor::TimeBootMsField)
         {
-            time = *((quint32*)(m+msgInfo->fields[fieldid].wire_offset));
+            time = *((const quint32*)(m+descriptor->fields[0].wireOffset));
         }
-        else if (QString(msgInfo->fields[fieldid].name).contains("usec") && msgInfo->fields[fieldid].type == MAVLINK_TYPE_UINT64_T)
+        else if (descriptor->timeField == MessageDescriptor::TimeUsecField)
         {
-            time = *((quint64*)(m+msgInfo->fields[fieldid].wire_offset));
+            time = *((const quint64*)(m+descriptor->fields[0].wireOffset));
             time = (time+500)/1000; // Scale to milliseconds, round up/down correctly
         }
     }
@@ -101,16 +143,106 @@ void MAVLinkDecoder::receiveMessage(LinkInterface* link,mavlink_message_t messag
     // Align UAS time to global time
     time = getUnixTimeFromMs(message.sysid, time);
 
-    // Send out all field values for this message
-    for (unsigned int i = 0; i < msgInfo->num_fields; ++i)
+    // Collect all field values for this message and send them out as a single batch
+    _samples.clear();
+    for (int i = 0; i < descriptor->fields.count(); ++i)
     {
-        emitFieldValue(&message, i, time);
+        emitFieldValue(&message, *descriptor, descriptor->fields[i], time);
+    }
+    if (!_samples.isEmpty()) {
+        emit samplesReceived(message.sysid, _samples);
     }
 
     // Send out combined math expressions
     // FIXME XXX TODO
 }
 
+bool MAVLinkDecoder::seriesInfo(quint32 seriesId, QString& name, QString& unit, bool& isDouble)
+{
+    QMutexLocker lock(&_seriesMutex);
+
+    if ((int)seriesId >= _series.count()) {
+        return false;
+    }
+
+    const SeriesEntry& entry = _series[seriesId];
+    const SeriesKey& key = entry.key;
+    const mavlink_field_info_t& fieldInfo = entry.info->fields[key.fieldIndex];
+    QString fieldName(fieldInfo.name);
+
+    switch (key.msgid) {
+    case MAVLINK_MSG_ID_DEBUG_VECT:
+        name = QString("%1.%2").arg(QString::fromLatin1(key.tag, qstrnlen(key.tag, sizeof(key.tag)))).arg(fieldName);
+        break;
+    case MAVLINK_MSG_ID_DEBUG:
+        name = QString("debug.%1").arg(key.port);
+        break;
+    case MAVLINK_MSG_ID_NAMED_VALUE_FLOAT:
+    case MAVLINK_MSG_ID_NAMED_VALUE_INT:
+        name = QString::fromLatin1(key.tag, qstrnlen(key.tag, sizeof(key.tag)));
+        break;
+    case MAVLINK_MSG_ID_RC_CHANNELS_RAW:
+    case MAVLINK_MSG_ID_RC_CHANNELS_SCALED:
+    case MAVLINK_MSG_ID_SERVO_OUTPUT_RAW:
+        name = QString("port%1_%2.%3").arg(key.port).arg(entry.info->name).arg(fieldName);
+        break;
+    default:
+        name = QString("%1.%2").arg(entry.info->name).arg(fieldName);
+        break;
+    }
+
+    if (key.compid != 0) {
+        name.prepend(QString("C%1:").arg(key.compid));
+    }
+    name.prepend(QString("M%1:").arg(key.sysid));
+
+    static const char* typeNames[] = { "char", "uint8_t", "int8_t", "uint16_t", "int16_t", "uint32_t", "int32_t", "uint64_t", "int64_t", "float", "double" };
+    QString typeName = fieldInfo.type < sizeof(typeNames) / sizeof(typeNames[0]) ? typeNames[fieldInfo.type] : "";
+    if (fieldInfo.type == MAVLINK_TYPE_CHAR || fieldInfo.array_length > 0) {
+        unit = QString("%1[%2]").arg(typeName).arg(fieldInfo.array_length);
+    } else {
+        unit = typeName;
+    }
+    if (key.element != 0) {
+        name += QString(".%1").arg(key.element - 1);
+    }
+
+    isDouble = entry.isDouble;
+
+    return true;
+}
+
+quint32 MAVLinkDecoder::_seriesId(const SeriesKey& key, const mavlink_message_info_t* info, bool isDouble)
+{
+    QHash<SeriesKey, quint32>::const_iterator iter = _seriesIds.constFind(key);
+    if (iter != _seriesIds.constEnd()) {
+        return iter.value();
+    }
+
+    QMutexLocker lock(&_seriesMutex);
+
+    SeriesEntry entry;
+    entry.key = key;
+    entry.info = info;
+    entry.isDouble = isDouble;
+    quint32 seriesId = _series.count();
+    _series.append(entry);
+    _seriesIds[key] = seriesId;
+
+    return seriesId;
+}
+
+void MAVLinkDecoder::_appendSample(SeriesKey& key, const MessageDescriptor& descriptor, const FieldDescriptor& field, int element, double value, quint64 time)
+{
+    key.element = element + 1;
+
+    MAVLinkDecoderSample sample;
+    sample.seriesId = _seriesId(key, descriptor.info, field.type == MAVLINK_TYPE_FLOAT || field.type == MAVLINK_TYPE_DOUBLE);
+    sample.time = time;
+    sample.value = value;
+    _samples.append(sample);
+}
+
 quint64 MAVLinkDecoder::getUnixTimeFromMs(int systemID, quint64 time)
 {
     quint64 ret = 0;
@@ -189,315 +321,155 @@ quint64 MAVLinkDecoder::getUnixTimeFromMs(int systemID, quint64 time)
     return ret;
 }
 
-void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, int fieldid, quint64 time)
-{
-    bool multiComponentSourceDetected = false;
-    const mavlink_message_info_t* msgInfo = mavlink_get_message_info(msg);
 
+void MAVLinkDecoder::emitFieldValue(mavlink_message_t* msg, const MessageDescriptor& descriptor, const FieldDescriptor& field, quint64 time)
+{
     uint32_t msgid = msg->msgid;
 
     // create new system data if it wasn't dectected yet
-    if (!(sysDict.keys().contains(msgid))) {
-        sysDict[msgid] = SystemData();
-    }
+    SystemData& systemData = sysDict[msgid];
 
     // Store component ID
-    if (sysDict[msgid].componentID == -1)
+    if (systemData.componentID == -1)
     {
-        sysDict[msgid].componentID = msg->compid;
+        systemData.componentID = msg->compid;
     }
     else
     {
         // Got this message already
-        if (sysDict[msgid].componentID != msg->compid)
+        if (systemData.componentID != msg->compid)
         {
-            sysDict[msgid].componentMulti = true;
+            systemData.componentMulti = true;
         }
     }
 
-    if (sysDict[msgid].componentMulti == true) {
-        multiComponentSourceDetected = true;
-    }
+    if (descriptor.filtered) return;
 
-    // Add field tree widget item
-    if (messageFilter.contains(msgid)) return;
-    QString fieldName(msgInfo->fields[fieldid].name);
-    QString fieldType;
-    uint8_t* m = (uint8_t*)(msgDict[msgid].payload64);
-    QString name("%1.%2");
-    QString unit("");
+    uint8_t* m = (uint8_t*)(msg->payload64);
+
+    SeriesKey key;
+    memset(&key, 0, sizeof(key));
+    key.msgid = msgid;
+    key.sysid = msg->sysid;
+    key.compid = systemData.componentMulti ? msg->compid : 0;
+    key.fieldIndex = field.fieldIndex;
+    key.port = -1;
 
     // Debug vector messages
     if (msgid == MAVLINK_MSG_ID_DEBUG_VECT)
     {
         mavlink_debug_vect_t debug;
         mavlink_msg_debug_vect_decode(msg, &debug);
-        char buf[11];
-        strncpy(buf, debug.name, 10);
-        buf[10] = '\0';
-        name = QString("%1.%2").arg(buf).arg(fieldName);
+        strncpy(key.tag, debug.name, sizeof(key.tag));
         time = getUnixTimeFromMs(msg->sysid, (debug.time_usec+500)/1000); // Scale to milliseconds, round up/down correctly
     }
     else if (msgid == MAVLINK_MSG_ID_DEBUG)
     {
         mavlink_debug_t debug;
         mavlink_msg_debug_decode(msg, &debug);
-        name = name.arg(QString("debug")).arg(debug.ind);
+        key.port = debug.ind;
         time = getUnixTimeFromMs(msg->sysid, debug.time_boot_ms);
     }
     else if (msgid == MAVLINK_MSG_ID_NAMED_VALUE_FLOAT)
     {
         mavlink_named_value_float_t debug;
         mavlink_msg_named_value_float_decode(msg, &debug);
-        char buf[11];
-        strncpy(buf, debug.name, 10);
-        buf[10] = '\0';
-        name = QString(buf);
+        strncpy(key.tag, debug.name, sizeof(key.tag));
         time = getUnixTimeFromMs(msg->sysid, debug.time_boot_ms);
     }
     else if (msgid == MAVLINK_MSG_ID_NAMED_VALUE_INT)
     {
         mavlink_named_value_int_t debug;
         mavlink_msg_named_value_int_decode(msg, &debug);
-        char buf[11];
-        strncpy(buf, debug.name, 10);
-        buf[10] = '\0';
-        name = QString(buf);
+        strncpy(key.tag, debug.name, sizeof(key.tag));
         time = getUnixTimeFromMs(msg->sysid, debug.time_boot_ms);
     }
     else if (msgid == MAVLINK_MSG_ID_RC_CHANNELS_RAW)
     {
-        // XXX this is really ugly, but we do not know a better way to do this
-        mavlink_rc_channels_raw_t raw;
-        mavlink_msg_rc_channels_raw_decode(msg, &raw);
-        name = name.arg(msgInfo->name).arg(fieldName);
-        name.prepend(QString("port%1_").arg(raw.port));
+        key.port = mavlink_msg_rc_channels_raw_get_port(msg);
     }
     else if (msgid == MAVLINK_MSG_ID_RC_CHANNELS_SCALED)
     {
-        // XXX this is really ugly, but we do not know a better way to do this
-        mavlink_rc_channels_scaled_t scaled;
-        mavlink_msg_rc_channels_scaled_decode(msg, &scaled);
-        name = name.arg(msgInfo->name).arg(fieldName);
-        name.prepend(QString("port%1_").arg(scaled.port));
+        key.port = mavlink_msg_rc_channels_scaled_get_port(msg);
     }
     else if (msgid == MAVLINK_MSG_ID_SERVO_OUTPUT_RAW)
     {
-        // XXX this is really ugly, but we do not know a better way to do this
-        mavlink_servo_output_raw_t servo;
-        mavlink_msg_servo_output_raw_decode(msg, &servo);
-        name = name.arg(msgInfo->name).arg(fieldName);
-        name.prepend(QString("port%1_").arg(servo.port));
-    }
-    else
-    {
-        name = name.arg(msgInfo->name).arg(fieldName);
-    }
-
-    if (multiComponentSourceDetected)
-    {
-        name = name.prepend(QString("C%1:").arg(msg->compid));
+        key.port = mavlink_msg_servo_output_raw_get_port(msg);
     }
 
-    name = name.prepend(QString("M%1:").arg(msg->sysid));
+    int count = field.arrayLength > 0 ? field.arrayLength : 1;
+    int firstElement = field.arrayLength > 0 ? 0 : -1;
+    uint8_t* fieldData = m + field.wireOffset;
 
-    switch (msgInfo->fields[fieldid].type)
+    switch (field.type)
     {
     case MAVLINK_TYPE_CHAR:
-        if (msgInfo->fields[fieldid].array_length > 0)
+        if (field.arrayLength > 0)
         {
-            char* str = (char*)(m+msgInfo->fields[fieldid].wire_offset);
-            // Enforce null termination
-            str[msgInfo->fields[fieldid].array_length-1] = '\0';
-            QString string(name + ": " + str);
-            if (!textMessageFilter.contains(msgid)) emit textMessageReceived(msg->sysid, msg->compid, MAV_SEVERITY_INFO, string);
+            if (!descriptor.textFiltered) {
+                char* str = (char*)fieldData;
+                // Enforce null termination
+                str[field.arrayLength-1] = '\0';
+                QString name, unit;
+                bool isDouble;
+                seriesInfo(_seriesId(key, descriptor.info, false), name, unit, isDouble);
+                emit textMessageReceived(msg->sysid, msg->compid, MAV_SEVERITY_INFO, name + ": " + str);
+            }
         }
         else
         {
             // Single char
-            char b = *((char*)(m+msgInfo->fields[fieldid].wire_offset));
-            unit = QString("char[%1]").arg(msgInfo->fields[fieldid].array_length);
-            emit valueChanged(msg->sysid, name, unit, b, time);
+            _appendSample(key, descriptor, field, -1, *((char*)fieldData), time);
         }
         break;
     case MAVLINK_TYPE_UINT8_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            uint8_t* nums = m+msgInfo->fields[fieldid].wire_offset;
-            fieldType = QString("uint8_t[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            uint8_t u = *(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = "uint8_t";
-            emit valueChanged(msg->sysid, name, fieldType, u, time);
+        for (int j = 0; j < count; ++j) {
+            _appendSample(key, descriptor, field, firstElement + j, ((uint8_t*)fieldData)[j], time);
         }
         break;
     case MAVLINK_TYPE_INT8_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            int8_t* nums = (int8_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("int8_t[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            int8_t n = *((int8_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "int8_t";
-            emit valueChanged(msg->sysid, name, fieldType, n, time);
+        for (int j = 0; j < count; ++j) {
+            _appendSample(key, descriptor, field, firstElement + j, ((int8_t*)fieldData)[j], time);
         }
         break;
     case MAVLINK_TYPE_UINT16_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            uint16_t* nums = (uint16_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("uint16_t[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            uint16_t n = *((uint16_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "uint16_t";
-            emit valueChanged(msg->sysid, name, fieldType, n, time);
+        for (int j = 0; j < count; ++j) {
+            _appendSample(key, descriptor, field, firstElement + j, ((uint16_t*)fieldData)[j], time);
         }
         break;
     case MAVLINK_TYPE_INT16_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            int16_t* nums = (int16_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("int16_t[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            int16_t n = *((int16_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "int16_t";
-            emit valueChanged(msg->sysid, name, fieldType, n, time);
+        for (int j = 0; j < count; ++j) {
+            _appendSample(key, descriptor, field, firstElement + j, ((int16_t*)fieldData)[j], time);
         }
         break;
     case MAVLINK_TYPE_UINT32_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            uint32_t* nums = (uint32_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("uint32_t[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            uint32_t n = *((uint32_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "uint32_t";
-            emit valueChanged(msg->sysid, name, fieldType, n, time);
+        for (int j = 0; j < count; ++j) {
+            _appendSample(key, descriptor, field, firstElement + j, ((uint32_t*)fieldData)[j], time);
         }
         break;
     case MAVLINK_TYPE_INT32_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            int32_t* nums = (int32_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("int32_t[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            int32_t n = *((int32_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "int32_t";
-            emit valueChanged(msg->sysid, name, fieldType, n, time);
+        for (int j = 0; j < count; ++j) {
+            _appendSample(key, descriptor, field, firstElement + j, ((int32_t*)fieldData)[j], time);
         }
         break;
     case MAVLINK_TYPE_FLOAT:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            float* nums = (float*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("float[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, (float)(nums[j]), time);
-            }
-        }
-        else
-        {
-            // Single value
-            float f = *((float*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "float";
-            emit valueChanged(msg->sysid, name, fieldType, f, time);
+        for (int j = 0; j < count; ++j) {
+            _appendSample(key, descriptor, field, firstElement + j, ((float*)fieldData)[j], time);
         }
         break;
     case MAVLINK_TYPE_DOUBLE:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            double* nums = (double*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("double[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            double f = *((double*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "double";
-            emit valueChanged(msg->sysid, name, fieldType, f, time);
+        for (int j = 0; j < count; ++j) {
+            _appendSample(key, descriptor, field, firstElement + j, ((double*)fieldData)[j], time);
         }
         break;
     case MAVLINK_TYPE_UINT64_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            uint64_t* nums = (uint64_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("uint64_t[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, (quint64) nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            uint64_t n = *((uint64_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "uint64_t";
-            emit valueChanged(msg->sysid, name, fieldType, (quint64) n, time);
+        for (int j = 0; j < count; ++j) {
+            _appendSample(key, descriptor, field, firstElement + j, ((uint64_t*)fieldData)[j], time);
         }
         break;
     case MAVLINK_TYPE_INT64_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            int64_t* nums = (int64_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            fieldType = QString("int64_t[%1]").arg(msgInfo->fields[fieldid].array_length);
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                emit valueChanged(msg->sysid, QString("%1.%2").arg(name).arg(j), fieldType, (qint64) nums[j], time);
-            }
-        }
-        else
-        {
-            // Single value
-            int64_t n = *((int64_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            fieldType = "int64_t";
-            emit valueChanged(msg->sysid, name, fieldType, (qint64) n, time);
+        for (int j = 0; j < count; ++j) {
+            _appendSample(key, descriptor, field, firstElement + j, ((int64_t*)fieldData)[j], time);
         }
         break;
     default:
@@ -3,6 +3,10 @@
 
 #include <QObject>
 #include <QHash>
+#include <QMutex>
+#include <QVector>
+
+#include <cstring>
 
 #include "MAVLinkProtocol.h"
 
@@ -24,6 +28,17 @@ struct SystemData {
     quint64 firstOnboardTime;   ///< First seen onboard time
 };
 
+/// One numeric sample of a decoded message field. The series id is resolved to a
+/// name/unit through MAVLinkDecoder::seriesInfo only when a consumer first sees it.
+struct MAVLinkDecoderSample {
+    quint32 seriesId;
+    quint64 time;               ///< Unix time in milliseconds
+    double  value;
+};
+
+Q_DECLARE_METATYPE(MAVLinkDecoderSample)
+Q_DECLARE_METATYPE(QVector<MAVLinkDecoderSample>)
+
 class MAVLinkDecoder : public QThread
 {
     Q_OBJECT
@@ -32,25 +47,87 @@ public:
 
     void run();
 
+    /// Resolves a series id published through samplesReceived. Thread safe.
+    ///     @param seriesId Series id from a MAVLinkDecoderSample
+    ///     @param[out] name Curve name, for example "M1:ATTITUDE.roll"
+    ///     @param[out] unit Field type, for example "float" or "uint16_t[8]"
+    ///     @param[out] isDouble true: field is a floating point type
+    /// @return false: unknown series id
+    bool seriesInfo(quint32 seriesId, QString& name, QString& unit, bool& isDouble);
+
 signals:
     void textMessageReceived(int uasid, int componentid, int severity, const QString& text);
-    void valueChanged(const int uasId, const QString& name, const QString& unit, const QVariant& value, const quint64 msec);
+    /// All numeric field values of one message, emitted once per message
+    void samplesReceived(int uasId, const QVector<MAVLinkDecoderSample>& samples);
     void finish(); ///< Trigger a thread safe shutdown
 
 public slots:
     /** @brief Receive one message from the protocol and decode it */
     void receiveMessage(LinkInterface* link,mavlink_message_t message);
 protected:
+    /// Layout of one field, computed once per message id
+    struct FieldDescriptor {
+        uint8_t     fieldIndex;
+        uint8_t     type;           ///< MAVLINK_TYPE_*
+        uint8_t     arrayLength;
+        uint16_t    wireOffset;
+    };
+
+    /// Field table for one message id, computed the first time the message is seen
+    struct MessageDescriptor {
+        MessageDescriptor() : info(NULL), timeField(NoTimeField), filtered(false), textFiltered(false) { }
+
+        enum TimeField {
+            NoTimeField,
+            TimeBootMsField,
+            TimeUsecField
+        };
+
+        const mavlink_message_info_t*   info;
+        TimeField                       timeField;
+        bool                            filtered;       ///< true: message is in messageFilter
+        bool                            textFiltered;   ///< true: message is in textMessageFilter
+        QVector<FieldDescriptor>        fields;
+    };
+
+    /// Everything which makes up a curve name. Used to hand out stable series ids without building strings.
+    struct SeriesKey {
+        uint32_t    msgid;
+        uint8_t     sysid;
+        uint8_t     compid;         ///< 0 unless multiple components send this message
+        uint8_t     fieldIndex;
+        uint8_t     element;        ///< Array element + 1, 0 for scalar fields
+        int16_t     port;           ///< Port for RC/servo messages, index for DEBUG, -1 otherwise
+        char        tag[10];        ///< Name for DEBUG_VECT/NAMED_VALUE_*, zero filled otherwise
+
+        bool operator==(const SeriesKey& other) const { return memcmp(this, &other, sizeof(SeriesKey)) == 0; }
+    };
+    friend uint qHash(const SeriesKey& key, uint seed);
+
+    struct SeriesEntry {
+        SeriesKey                       key;
+        const mavlink_message_info_t*   info;
+        bool                            isDouble;
+    };
+
     /** @brief Emit the value of one message field */
-    void emitFieldValue(mavlink_message_t* msg, int fieldid, quint64 time);
+    void emitFieldValue(mavlink_message_t* msg, const MessageDescriptor& descriptor, const FieldDescriptor& field, quint64 time);
     /** @brief Shift a timestamp in Unix time if necessary */
     quint64 getUnixTimeFromMs(int systemID, quint64 time);
+    const MessageDescriptor* _messageDescriptor(const mavlink_message_t& message);
+    quint32 _seriesId(const SeriesKey& key, const mavlink_message_info_t* info, bool isDouble);
+    void _appendSample(SeriesKey& key, const MessageDescriptor& descriptor, const FieldDescriptor& field, int element, double value, quint64 time);
 
     QMap<uint16_t, bool> messageFilter;                     ///< Message/field names not to emit
     QMap<uint16_t, bool> textMessageFilter;                 ///< Message/field names not to emit in text mode
-    QHash<int, mavlink_message_t> msgDict; ///< dictionary of all mavlink messages
     QHash<int, SystemData> sysDict; ///< dictionary of all systmes
     QThread* creationThread;                                ///< QThread on which the object is created
+
+    QHash<uint32_t, MessageDescriptor>  _messageDescriptors;    ///< Decoder thread only
+    QVector<MAVLinkDecoderSample>       _samples;               ///< Batch currently being built, decoder thread only
+    QHash<SeriesKey, quint32>           _seriesIds;             ///< Decoder thread only
+    QMutex                              _seriesMutex;           ///< Protects _series
+    QVector<SeriesEntry>                _series;                ///< Indexed by series id
 };
 
 #endif // MAVLINKDECODER_H
@@ -15,6 +15,7 @@
 
 #include "QGCHilFlightGearConfiguration.h"
 #include "QGCHilJSBSimConfiguration.h"
+#include "QGCHilLockstepConfiguration.h"
 #include "QGCHilXPlaneConfiguration.h"
 #include "UAS.h"
 
@@ -101,6 +102,18 @@ void QGCHilConfiguration::on_simComboBox_currentIndexChanged(int index)
             connect(xplane, &QGCXPlaneLink::statusMessage, ui->statusLabel, &QLabel::setText);
         }
     }
+    else if (4 == index)
+    {
+        // Ensure the sim exists and is disabled
+        _vehicle->uas()->enableHilLockstep(false);
+        QGCLockstepHilLink* lockstep = dynamic_cast<QGCLockstepHilLink*>(_vehicle->uas()->getHILSimulation());
+        if (lockstep)
+        {
+            QGCHilLockstepConfiguration* hlconf = new QGCHilLockstepConfiguration(lockstep, this);
+            hlconf->show();
+            ui->simulatorConfigurationLayout->addWidget(hlconf);
+        }
+    }
 // Disabling JSB Sim since its not well maintained,
 // but as refactoring is pending we're not ditching the code yet
 //    else if (4)
@@ -0,0 +1,63 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCHilLockstepConfiguration.h"
+#include "ui_QGCHilLockstepConfiguration.h"
+#include "QGCHilConfiguration.h"
+
+QGCHilLockstepConfiguration::QGCHilLockstepConfiguration(QGCLockstepHilLink* link, QGCHilConfiguration *parent)
+    : QWidget(parent)
+    , _link(link)
+    , _ui(new Ui::QGCHilLockstepConfiguration)
+{
+    _ui->setupUi(this);
+
+    _ui->portSpinBox->setValue(_link->getPort());
+    _simulationConnected(_link->isConnected());
+
+    connect(_ui->startButton, &QPushButton::clicked, this, &QGCHilLockstepConfiguration::_toggleSimulation);
+    connect(_link, &QGCHilLink::statusMessage, parent, &QGCHilConfiguration::receiveStatusMessage);
+    connect(_link, static_cast<void (QGCHilLink::*)(bool)>(&QGCHilLink::simulationConnected), this, &QGCHilLockstepConfiguration::_simulationConnected);
+    connect(_link, &QGCLockstepHilLink::lockstepStatisticsChanged, this, &QGCHilLockstepConfiguration::_statisticsChanged);
+}
+
+QGCHilLockstepConfiguration::~QGCHilLockstepConfiguration()
+{
+    delete _ui;
+}
+
+void QGCHilLockstepConfiguration::_toggleSimulation(void)
+{
+    if (_link->isConnected()) {
+        _link->disconnectSimulation();
+    } else {
+        if (_ui->portSpinBox->value() != _link->getPort()) {
+            _link->setPort(_ui->portSpinBox->value());
+        }
+        _link->connectSimulation();
+    }
+}
+
+void QGCHilLockstepConfiguration::_simulationConnected(bool connected)
+{
+    _ui->startButton->setText(connected ? tr("Disconnect") : tr("Connect"));
+    _ui->portSpinBox->setEnabled(!connected);
+    if (!connected) {
+        _ui->statisticsLabel->clear();
+    }
+}
+
+void QGCHilLockstepConfiguration::_statisticsChanged(double stepRate, double controlLatencyMsecs, double maxControlLatencyMsecs, int stepTimeouts)
+{
+    _ui->statisticsLabel->setText(tr("%1 steps/s, control latency %2 ms (max %3 ms), %4 timeouts")
+                                  .arg(stepRate, 0, 'f', 0)
+                                  .arg(controlLatencyMsecs, 0, 'f', 2)
+                                  .arg(maxControlLatencyMsecs, 0, 'f', 2)
+                                  .arg(stepTimeouts));
+}
@@ -0,0 +1,40 @@
+/****************************************************************************
+ *
+ *   (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#ifndef QGCHILLOCKSTEPCONFIGURATION_H
+#define QGCHILLOCKSTEPCONFIGURATION_H
+
+#include <QWidget>
+
+#include "QGCLockstepHilLink.h"
+
+class QGCHilConfiguration;
+namespace Ui {
+class QGCHilLockstepConfiguration;
+}
+
+class QGCHilLockstepConfiguration : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit QGCHilLockstepConfiguration(QGCLockstepHilLink* link, QGCHilConfiguration *parent = 0);
+    ~QGCHilLockstepConfiguration();
+
+private slots:
+    void _toggleSimulation(void);
+    void _simulationConnected(bool connected);
+    void _statisticsChanged(double stepRate, double controlLatencyMsecs, double maxControlLatencyMsecs, int stepTimeouts);
+
+private:
+    QGCLockstepHilLink*             _link;
+    Ui::QGCHilLockstepConfiguration* _ui;
+};
+
+#endif // QGCHILLOCKSTEPCONFIGURATION_H
@@ -3,18 +3,19 @@
 #include "MultiVehicleManager.h"
 #include "UAS.h"
 #include "QGCApplication.h"
+#include "QGCQFileDialog.h"
+#include "QGCMessageBox.h"
 
 #include "ui_QGCMAVLinkInspector.h"
 
 #include <QList>
 #include <QDebug>
-
-const float QGCMAVLinkInspector::updateHzLowpass = 0.2f;
-const unsigned int QGCMAVLinkInspector::updateInterval = 1000U;
+#include <QStandardPaths>
 
 QGCMAVLinkInspector::QGCMAVLinkInspector(const QString& title, QAction* action, MAVLinkProtocol* protocol, QWidget *parent) :
     QGCDockWidget(title, action, parent),
     _protocol(protocol),
+    _statistics(protocol->messageStatistics()),
     selectedSystemID(0),
     selectedComponentID(0),
     ui(new Ui::QGCMAVLinkInspector)
@@ -39,15 +40,24 @@ QGCMAVLinkInspector::QGCMAVLinkInspector(const QString& title, QAction* action,
             this, &QGCMAVLinkInspector::selectDropDownMenuComponent);
 
     connect(ui->clearButton, &QPushButton::clicked, this, &QGCMAVLinkInspector::clearView);
+    connect(ui->exportButton, &QPushButton::clicked, this, [this]() {
+        QString fileName = QGCQFileDialog::getSaveFileName(this,
+            tr("Export MAVLink Statistics"),
+            QStandardPaths::writableLocation(QStandardPaths::DesktopLocation),
+            tr("CSV Files (*.csv)"),
+            "csv");
+        if (!fileName.isEmpty() && !_statistics->exportToCSV(fileName)) {
+            QGCMessageBox::warning(tr("Export MAVLink Statistics"), tr("Unable to write to file %1.").arg(fileName));
+        }
+    });
+    connect(ui->treeWidget, &QTreeWidget::itemExpanded, this, &QGCMAVLinkInspector::_itemExpanded);
 
     // Connect external connections
     connect(qgcApp()->toolbox()->multiVehicleManager(), &MultiVehicleManager::vehicleAdded, this, &QGCMAVLinkInspector::_vehicleAdded);
-    connect(protocol, &MAVLinkProtocol::messageReceived, this, &QGCMAVLinkInspector::receiveMessage);
 
-    // Attach the UI's refresh rate to a timer.
-    connect(&updateTimer, &QTimer::timeout, this, &QGCMAVLinkInspector::refreshView);
-    updateTimer.start(updateInterval);
-    
+    // The statistics are recomputed at 1 Hz, refresh the view along with them
+    connect(_statistics, &MAVLinkMessageStatistics::statisticsUpdated, this, &QGCMAVLinkInspector::refreshView);
+
     loadSettings();
 }
 
@@ -102,589 +112,175 @@ void QGCMAVLinkInspector::addComponent(int uas, int component, const QString& na
 }
 
 /**
- * Reset the view. This entails clearing all data structures and resetting data from already-
- * received messages.
+ * Reset the view. Messages are shown again once they are received after this. The collected
+ * statistics are shared with other users and are left alone.
  */
 void QGCMAVLinkInspector::clearView()
 {
-    QMap<int, mavlink_message_t* >::iterator ite;
-    for(ite=uasMessageStorage.begin(); ite!=uasMessageStorage.end();++ite)
-    {
-        delete ite.value();
-        ite.value() = NULL;
-    }
-    uasMessageStorage.clear();
-
-    QMap<int, QMap<int, QTreeWidgetItem*>* >::iterator iteMsg;
+    QMap<int, QMap<quint32, QTreeWidgetItem*>* >::iterator iteMsg;
     for (iteMsg=uasMsgTreeItems.begin(); iteMsg!=uasMsgTreeItems.end();++iteMsg)
     {
-        QMap<int, QTreeWidgetItem*>* msgTreeItems = iteMsg.value();
-
-        QList<int> groupKeys = msgTreeItems->uniqueKeys();
-        QList<int>::iterator listKeys;
-        for (listKeys=groupKeys.begin();listKeys!=groupKeys.end();++listKeys)
-        {
-            delete msgTreeItems->take(*listKeys);
-        }
+        QMap<quint32, QTreeWidgetItem*>* msgTreeItems = iteMsg.value();
+        qDeleteAll(*msgTreeItems);
+        delete msgTreeItems;
     }
     uasMsgTreeItems.clear();
 
-    QMap<int, QTreeWidgetItem* >::iterator iteTree;
-    for(iteTree=uasTreeWidgetItems.begin(); iteTree!=uasTreeWidgetItems.end();++iteTree)
-    {
-        delete iteTree.value();
-        iteTree.value() = NULL;
-    }
+    qDeleteAll(uasTreeWidgetItems);
     uasTreeWidgetItems.clear();
-    
-    QMap<int, QMap<int, float>* >::iterator iteHz;
-    for (iteHz=uasMessageHz.begin(); iteHz!=uasMessageHz.end();++iteHz)
-    {
-
-        iteHz.value()->clear();
-        delete iteHz.value();
-        iteHz.value() = NULL;
-    }
-    uasMessageHz.clear();
 
-    QMap<int, QMap<int, unsigned int>* >::iterator iteCount;
-    for(iteCount=uasMessageCount.begin(); iteCount!=uasMessageCount.end();++iteCount)
-    {
-        iteCount.value()->clear();
-        delete iteCount.value();
-        iteCount.value() = NULL;
-    }
-    uasMessageCount.clear();
+    ui->treeWidget->clear();
 
-    QMap<int, QMap<int, quint64>* >::iterator iteLast;
-    for(iteLast=uasLastMessageUpdate.begin(); iteLast!=uasLastMessageUpdate.end();++iteLast)
+    clearedCounts.clear();
+    const QVector<MAVLinkMessageStatistics::MessageStats>& allStats = _statistics->allStats();
+    for (int i=0; i<allStats.count(); i++)
     {
-        iteLast.value()->clear();
-        delete iteLast.value();
-        iteLast.value() = NULL;
+        const MAVLinkMessageStatistics::MessageStats& stats = allStats[i];
+        clearedCounts.insert(((quint64)stats.sysid << 32) | ((quint64)stats.compid << 24) | stats.msgid, stats.count);
     }
-    uasLastMessageUpdate.clear();
+}
 
-    onboardMessageInterval.clear();
+void QGCMAVLinkInspector::showEvent(QShowEvent* event)
+{
+    QGCDockWidget::showEvent(event);
 
-    ui->treeWidget->clear();
+    // Nothing is updated while hidden, catch up right away
+    refreshView();
 }
 
 void QGCMAVLinkInspector::refreshView()
 {
-    QMap<int, mavlink_message_t* >::const_iterator ite;
-
-    for(ite=uasMessageStorage.constBegin(); ite!=uasMessageStorage.constEnd();++ite)
-    {
-        mavlink_message_t* msg = ite.value();
-        const mavlink_message_info_t* msgInfo = mavlink_get_message_info(msg);
-
-        if (!msgInfo) {
-            qWarning() << QStringLiteral("QGCMAVLinkInspector::refreshView NULL msgInfo msgid(%1)").arg(msg->msgid);
-            continue;
-        }
+    if (!isVisible()) {
+        return;
+    }
 
-        // Ignore NULL values
-        if (msg->msgid == 0xFF) continue;
+    const QVector<MAVLinkMessageStatistics::MessageStats>& allStats = _statistics->allStats();
 
-        // Update the message frenquency
+    for (int i=0; i<allStats.count(); i++)
+    {
+        const MAVLinkMessageStatistics::MessageStats& stats = allStats[i];
 
-        // Get the previous frequency for low-pass filtering
-        float msgHz = 0.0f;
-        QMap<int, QMap<int, float>* >::const_iterator iteHz = uasMessageHz.find(msg->sysid);
-        QMap<int, float>* uasMsgHz = iteHz.value();
+        if (selectedSystemID != 0 && selectedSystemID != stats.sysid) continue;
+        if (selectedComponentID != 0 && selectedComponentID != stats.compid) continue;
 
-        while((iteHz != uasMessageHz.end()) && (iteHz.key() == msg->sysid))
+        // Not received since the view was cleared
+        quint64 statsKey = ((quint64)stats.sysid << 32) | ((quint64)stats.compid << 24) | stats.msgid;
+        if (clearedCounts.contains(statsKey))
         {
-            if(iteHz.value()->contains(msg->msgid))
-            {
-                uasMsgHz = iteHz.value();
-                msgHz = iteHz.value()->value(msg->msgid);
-                break;
-            }
-            ++iteHz;
+            if (stats.count == clearedCounts.value(statsKey)) continue;
+            clearedCounts.remove(statsKey);
         }
 
-        // Get the number of message received
-        float msgCount = 0;
-        QMap<int, QMap<int, unsigned int> * >::const_iterator iter = uasMessageCount.find(msg->sysid);
-        QMap<int, unsigned int>* uasMsgCount = iter.value();
-
-        while((iter != uasMessageCount.end()) && (iter.key()==msg->sysid))
-        {
-            if(iter.value()->contains(msg->msgid))
-            {
-                msgCount = (float) iter.value()->value(msg->msgid);
-                uasMsgCount = iter.value();
-                break;
-            }
-            ++iter;
+        const mavlink_message_info_t* msgInfo = mavlink_get_message_info(&stats.lastMessage);
+        if (!msgInfo) {
+            qWarning() << QStringLiteral("QGCMAVLinkInspector::refreshView NULL msgInfo msgid(%1)").arg(stats.msgid);
+            continue;
         }
 
-        // Compute the new low-pass filtered frequency and update the message count
-        msgHz = (1.0f-updateHzLowpass)* msgHz + updateHzLowpass*msgCount/((float)updateInterval/1000.0f);
-        uasMsgHz->insert(msg->msgid,msgHz);
-        uasMsgCount->insert(msg->msgid,(unsigned int) 0);
-
-        // Update the tree view
-        QString messageName("%1 (%2 Hz, #%3)");
-        messageName = messageName.arg(msgInfo->name).arg(msgHz, 3, 'f', 1).arg(msg->msgid);
-
-        addUAStoTree(msg->sysid);
+        addUAStoTree(stats.sysid);
 
         // Look for the tree for the UAS sysid
-        QMap<int, QTreeWidgetItem*>* msgTreeItems = uasMsgTreeItems.value(msg->sysid);
+        QMap<quint32, QTreeWidgetItem*>* msgTreeItems = uasMsgTreeItems.value(stats.sysid);
         if (!msgTreeItems)
         {
             // The UAS tree has not been created yet, no update
-            return;
+            continue;
         }
 
-        // Add the message with msgid to the tree if not done yet
-        if(!msgTreeItems->contains(msg->msgid))
+        // Add the message to the tree if not done yet. Field items are only created once the message is expanded.
+        quint32 itemKey = ((quint32)stats.compid << 24) | stats.msgid;
+        QTreeWidgetItem* message = msgTreeItems->value(itemKey, NULL);
+        if (!message)
         {
-            QStringList fields;
-            fields << messageName;
-            QTreeWidgetItem* widget = new QTreeWidgetItem();
-            for (unsigned int i = 0; i < msgInfo->num_fields; ++i)
-            {
-                QTreeWidgetItem* field = new QTreeWidgetItem();
-                widget->addChild(field);
-            }
-            msgTreeItems->insert(msg->msgid,widget);
-            QList<int> groupKeys = msgTreeItems->uniqueKeys();
-            int insertIndex = groupKeys.indexOf(msg->msgid);
-            uasTreeWidgetItems.value(msg->sysid)->insertChild(insertIndex,widget);
+            message = new QTreeWidgetItem();
+            message->setFirstColumnSpanned(true);
+            message->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+            message->setData(0, Qt::UserRole, stats.sysid);
+            message->setData(1, Qt::UserRole, stats.compid);
+            message->setData(2, Qt::UserRole, stats.msgid);
+            msgTreeItems->insert(itemKey, message);
+            int insertIndex = msgTreeItems->keys().indexOf(itemKey);
+            uasTreeWidgetItems.value(stats.sysid)->insertChild(insertIndex, message);
         }
 
         // Update the message
-        QTreeWidgetItem* message = msgTreeItems->value(msg->msgid);
-        if(message)
-        {
-            message->setFirstColumnSpanned(true);
-            message->setData(0, Qt::DisplayRole, QVariant(messageName));
-            for (unsigned int i = 0; i < msgInfo->num_fields; ++i)
-            {
-                updateField(msg, msgInfo, i, message->child(i));
-            }
+        QString messageName("%1 (%2 Hz, #%3, comp %4)");
+        messageName = messageName.arg(msgInfo->name).arg(stats.rateHz, 3, 'f', 1).arg(stats.msgid).arg(stats.compid);
+        message->setData(0, Qt::DisplayRole, QVariant(messageName));
+
+        if (message->isExpanded()) {
+            updateFields(message);
         }
     }
 }
 
-void QGCMAVLinkInspector::addUAStoTree(int sysId)
+void QGCMAVLinkInspector::_itemExpanded(QTreeWidgetItem* item)
 {
-    if(!uasTreeWidgetItems.contains(sysId))
-    {
-        // Add the UAS to the main tree after it has been created
-        Vehicle* vehicle = qgcApp()->toolbox()->multiVehicleManager()->getVehicleById(sysId);
-        if (vehicle)
-        {
-            UASInterface* uas = vehicle->uas();
-            QStringList idstring;
-            idstring << QString("Vehicle %1").arg(uas->getUASID());
-            QTreeWidgetItem* uasWidget = new QTreeWidgetItem(idstring);
-            uasWidget->setFirstColumnSpanned(true);
-            uasTreeWidgetItems.insert(sysId,uasWidget);
-            ui->treeWidget->addTopLevelItem(uasWidget);
-            uasMsgTreeItems.insert(sysId,new QMap<int, QTreeWidgetItem*>());
-        }
+    // Message items are the only ones which carry the message id
+    if (item->data(2, Qt::UserRole).isValid()) {
+        updateFields(item);
     }
 }
 
-void QGCMAVLinkInspector::receiveMessage(LinkInterface* link,mavlink_message_t message)
+void QGCMAVLinkInspector::updateFields(QTreeWidgetItem* messageItem)
 {
-    Q_UNUSED(link);
-
-    quint64 receiveTime;
-    
-    if (selectedSystemID != 0 && selectedSystemID != message.sysid) return;
-    if (selectedComponentID != 0 && selectedComponentID != message.compid) return;
-
-    // Create dynamically an array to store the messages for each UAS
-    if (!uasMessageStorage.contains(message.sysid))
-    {
-        mavlink_message_t* msg = new mavlink_message_t;
-        *msg = message;
-        uasMessageStorage.insertMulti(message.sysid,msg);
+    const MAVLinkMessageStatistics::MessageStats* stats = _statistics->stats(messageItem->data(0, Qt::UserRole).toUInt(),
+                                                                             messageItem->data(1, Qt::UserRole).toUInt(),
+                                                                             messageItem->data(2, Qt::UserRole).toUInt());
+    if (!stats) {
+        return;
     }
 
-    bool msgFound = false;
-    QMap<int, mavlink_message_t* >::const_iterator iteMsg = uasMessageStorage.find(message.sysid);
-    mavlink_message_t* uasMessage = iteMsg.value();
-    while((iteMsg != uasMessageStorage.end()) && (iteMsg.key() == message.sysid))
-    {
-        if (iteMsg.value()->msgid == message.msgid)
-        {
-            msgFound = true;
-            uasMessage = iteMsg.value();
-            break;
-        }
-        ++iteMsg;
-    }
-    if (!msgFound)
-    {
-        mavlink_message_t* msgIdMessage = new mavlink_message_t;
-        *msgIdMessage = message;
-        uasMessageStorage.insertMulti(message.sysid,msgIdMessage);
-    }
-    else
-    {
-        *uasMessage = message;
+    const mavlink_message_info_t* msgInfo = mavlink_get_message_info(&stats->lastMessage);
+    if (!msgInfo) {
+        return;
     }
 
-    // Looking if this message has already been received once
-    msgFound = false;
-    QMap<int, QMap<int, quint64>* >::const_iterator ite = uasLastMessageUpdate.find(message.sysid);
-    QMap<int, quint64>* lastMsgUpdate = ite.value();
-    while((ite != uasLastMessageUpdate.end()) && (ite.key() == message.sysid))
-    {   
-        if(ite.value()->contains(message.msgid))
+    if (messageItem->childCount() == 0) {
+        for (unsigned int i = 0; i < msgInfo->num_fields; ++i)
         {
-            msgFound = true;
-
-            // Point to the found message
-            lastMsgUpdate = ite.value();
-            break;
+            messageItem->addChild(new QTreeWidgetItem());
         }
-        ++ite;
     }
 
-    receiveTime = QGC::groundTimeMilliseconds();
-
-    // If the message doesn't exist, create a map for the frequency, message count and time of reception
-    if(!msgFound)
+    for (unsigned int i = 0; i < msgInfo->num_fields; ++i)
     {
-        // Create a map for the message frequency
-        QMap<int, float>* messageHz = new QMap<int,float>;
-        messageHz->insert(message.msgid,0.0f);
-        uasMessageHz.insertMulti(message.sysid,messageHz);
-
-        // Create a map for the message count
-        QMap<int, unsigned int>* messagesCount = new QMap<int, unsigned int>;
-        messagesCount->insert(message.msgid,0);
-        uasMessageCount.insertMulti(message.sysid,messagesCount);
-
-        // Create a map for the time of reception of the message
-        QMap<int, quint64>* lastMessage = new QMap<int, quint64>;
-        lastMessage->insert(message.msgid,receiveTime);
-        uasLastMessageUpdate.insertMulti(message.sysid,lastMessage);
-
-        // Point to the created message
-        lastMsgUpdate = lastMessage;
+        updateField(&stats->lastMessage, msgInfo, i, messageItem->child(i));
     }
-    else
+}
+
+void QGCMAVLinkInspector::addUAStoTree(int sysId)
+{
+    if(!uasTreeWidgetItems.contains(sysId))
     {
-        // The message has been found/created
-        if ((lastMsgUpdate->contains(message.msgid))&&(uasMessageCount.contains(message.sysid)))
+        // Add the UAS to the main tree after it has been created
+        Vehicle* vehicle = qgcApp()->toolbox()->multiVehicleManager()->getVehicleById(sysId);
+        if (vehicle)
         {
-            // Looking for and updating the message count
-            unsigned int count = 0;
-            QMap<int, QMap<int, unsigned int>* >::const_iterator iter = uasMessageCount.find(message.sysid);
-            QMap<int, unsigned int> * uasMsgCount = iter.value();
-            while((iter != uasMessageCount.end()) && (iter.key() == message.sysid))
-            {
-                if(iter.value()->contains(message.msgid))
-                {
-                    uasMsgCount = iter.value();
-                    count = uasMsgCount->value(message.msgid,0);
-                    uasMsgCount->insert(message.msgid,count+1);
-                    break;
-                }
-                ++iter;
-            }
+            UASInterface* uas = vehicle->uas();
+            QStringList idstring;
+            idstring << QString("Vehicle %1").arg(uas->getUASID());
+            QTreeWidgetItem* uasWidget = new QTreeWidgetItem(idstring);
+            uasWidget->setFirstColumnSpanned(true);
+            uasTreeWidgetItems.insert(sysId,uasWidget);
+            ui->treeWidget->addTopLevelItem(uasWidget);
+            uasMsgTreeItems.insert(sysId,new QMap<quint32, QTreeWidgetItem*>());
         }
-        lastMsgUpdate->insert(message.msgid,receiveTime);
-    }
-
-    if (selectedSystemID == 0 || selectedComponentID == 0)
-    {
-        return;
-    }
-
-    switch (message.msgid)
-    {
-        case MAVLINK_MSG_ID_DATA_STREAM:
-            {
-                mavlink_data_stream_t stream;
-                mavlink_msg_data_stream_decode(&message, &stream);
-                onboardMessageInterval.insert(stream.stream_id, stream.message_rate);
-            }
-            break;
-
     }
 }
 
 QGCMAVLinkInspector::~QGCMAVLinkInspector()
 {
-    clearView();
+    // Tree items are owned by the tree widget
+    qDeleteAll(uasMsgTreeItems);
     delete ui;
 }
 
-void QGCMAVLinkInspector::updateField(mavlink_message_t* msg, const mavlink_message_info_t* msgInfo, int fieldid, QTreeWidgetItem* item)
+void QGCMAVLinkInspector::updateField(const mavlink_message_t* msg, const mavlink_message_info_t* msgInfo, int fieldid, QTreeWidgetItem* item)
 {
-    // Add field tree widget item
-    item->setData(0, Qt::DisplayRole, QVariant(msgInfo->fields[fieldid].name));
-    
-    bool msgFound = false;
-    QMap<int, mavlink_message_t* >::const_iterator iteMsg = uasMessageStorage.find(msg->sysid);
-    mavlink_message_t* uasMessage = iteMsg.value();
-    while((iteMsg != uasMessageStorage.end()) && (iteMsg.key() == msg->sysid))
-    {
-        if (iteMsg.value()->msgid == msg->msgid)
-        {
-            msgFound = true;
-            uasMessage = iteMsg.value();
-            break;
-        }
-        ++iteMsg;
-    }
-
-    if (!msgFound)
-    {
-        return;
-    }
-
-    uint8_t* m = (uint8_t*)&uasMessage->payload64[0];
+    const mavlink_field_info_t& fieldInfo = msgInfo->fields[fieldid];
 
-    switch (msgInfo->fields[fieldid].type)
-    {
-    case MAVLINK_TYPE_CHAR:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            char* str = (char*)(m+msgInfo->fields[fieldid].wire_offset);
-            // Enforce null termination
-            str[msgInfo->fields[fieldid].array_length-1] = '\0';
-            QString string(str);
-            item->setData(2, Qt::DisplayRole, "char");
-            item->setData(1, Qt::DisplayRole, string);
-        }
-        else
-        {
-            // Single char
-            char b = *((char*)(m+msgInfo->fields[fieldid].wire_offset));
-            item->setData(2, Qt::DisplayRole, QString("char[%1]").arg(msgInfo->fields[fieldid].array_length));
-            item->setData(1, Qt::DisplayRole, b);
-        }
-        break;
-    case MAVLINK_TYPE_UINT8_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            uint8_t* nums = m+msgInfo->fields[fieldid].wire_offset;
-            // Enforce null termination
-            QString tmp("%1, ");
-            QString string;
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                string += tmp.arg(nums[j]);
-            }
-            item->setData(2, Qt::DisplayRole, QString("uint8_t[%1]").arg(msgInfo->fields[fieldid].array_length));
-            item->setData(1, Qt::DisplayRole, string);
-        }
-        else
-        {
-            // Single value
-            uint8_t u = *(m+msgInfo->fields[fieldid].wire_offset);
-            item->setData(2, Qt::DisplayRole, "uint8_t");
-            item->setData(1, Qt::DisplayRole, u);
-        }
-        break;
-    case MAVLINK_TYPE_INT8_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            int8_t* nums = (int8_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            // Enforce null termination
-            QString tmp("%1, ");
-            QString string;
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                string += tmp.arg(nums[j]);
-            }
-            item->setData(2, Qt::DisplayRole, QString("int8_t[%1]").arg(msgInfo->fields[fieldid].array_length));
-            item->setData(1, Qt::DisplayRole, string);
-        }
-        else
-        {
-            // Single value
-            int8_t n = *((int8_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            item->setData(2, Qt::DisplayRole, "int8_t");
-            item->setData(1, Qt::DisplayRole, n);
-        }
-        break;
-    case MAVLINK_TYPE_UINT16_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            uint16_t* nums = (uint16_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            // Enforce null termination
-            QString tmp("%1, ");
-            QString string;
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                string += tmp.arg(nums[j]);
-            }
-            item->setData(2, Qt::DisplayRole, QString("uint16_t[%1]").arg(msgInfo->fields[fieldid].array_length));
-            item->setData(1, Qt::DisplayRole, string);
-        }
-        else
-        {
-            // Single value
-            uint16_t n = *((uint16_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            item->setData(2, Qt::DisplayRole, "uint16_t");
-            item->setData(1, Qt::DisplayRole, n);
-        }
-        break;
-    case MAVLINK_TYPE_INT16_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            int16_t* nums = (int16_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            // Enforce null termination
-            QString tmp("%1, ");
-            QString string;
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                string += tmp.arg(nums[j]);
-            }
-            item->setData(2, Qt::DisplayRole, QString("int16_t[%1]").arg(msgInfo->fields[fieldid].array_length));
-            item->setData(1, Qt::DisplayRole, string);
-        }
-        else
-        {
-            // Single value
-            int16_t n = *((int16_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            item->setData(2, Qt::DisplayRole, "int16_t");
-            item->setData(1, Qt::DisplayRole, n);
-        }
-        break;
-    case MAVLINK_TYPE_UINT32_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            uint32_t* nums = (uint32_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            // Enforce null termination
-            QString tmp("%1, ");
-            QString string;
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                string += tmp.arg(nums[j]);
-            }
-            item->setData(2, Qt::DisplayRole, QString("uint32_t[%1]").arg(msgInfo->fields[fieldid].array_length));
-            item->setData(1, Qt::DisplayRole, string);
-        }
-        else
-        {
-            // Single value
-            float n = *((uint32_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            item->setData(2, Qt::DisplayRole, "uint32_t");
-            item->setData(1, Qt::DisplayRole, n);
-        }
-        break;
-    case MAVLINK_TYPE_INT32_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            int32_t* nums = (int32_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            // Enforce null termination
-            QString tmp("%1, ");
-            QString string;
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                string += tmp.arg(nums[j]);
-            }
-            item->setData(2, Qt::DisplayRole, QString("int32_t[%1]").arg(msgInfo->fields[fieldid].array_length));
-            item->setData(1, Qt::DisplayRole, string);
-        }
-        else
-        {
-            // Single value
-            int32_t n = *((int32_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            item->setData(2, Qt::DisplayRole, "int32_t");
-            item->setData(1, Qt::DisplayRole, n);
-        }
-        break;
-    case MAVLINK_TYPE_FLOAT:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            float* nums = (float*)(m+msgInfo->fields[fieldid].wire_offset);
-            // Enforce null termination
-            QString tmp("%1, ");
-            QString string;
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-               string += tmp.arg(nums[j]);
-            }
-            item->setData(2, Qt::DisplayRole, QString("float[%1]").arg(msgInfo->fields[fieldid].array_length));
-            item->setData(1, Qt::DisplayRole, string);
-        }
-        else
-        {
-            // Single value
-            float f = *((float*)(m+msgInfo->fields[fieldid].wire_offset));
-            item->setData(2, Qt::DisplayRole, "float");
-            item->setData(1, Qt::DisplayRole, f);
-        }
-        break;
-    case MAVLINK_TYPE_DOUBLE:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            double* nums = (double*)(m+msgInfo->fields[fieldid].wire_offset);
-            // Enforce null termination
-            QString tmp("%1, ");
-            QString string;
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                string += tmp.arg(nums[j]);
-            }
-            item->setData(2, Qt::DisplayRole, QString("double[%1]").arg(msgInfo->fields[fieldid].array_length));
-            item->setData(1, Qt::DisplayRole, string);
-        }
-        else
-        {
-            // Single value
-            double f = *((double*)(m+msgInfo->fields[fieldid].wire_offset));
-            item->setData(2, Qt::DisplayRole, "double");
-            item->setData(1, Qt::DisplayRole, f);
-        }
-        break;
-    case MAVLINK_TYPE_UINT64_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            uint64_t* nums = (uint64_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            // Enforce null termination
-            QString tmp("%1, ");
-            QString string;
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                string += tmp.arg(nums[j]);
-            }
-            item->setData(2, Qt::DisplayRole, QString("uint64_t[%1]").arg(msgInfo->fields[fieldid].array_length));
-            item->setData(1, Qt::DisplayRole, string);
-        }
-        else
-        {
-            // Single value
-            uint64_t n = *((uint64_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            item->setData(2, Qt::DisplayRole, "uint64_t");
-            item->setData(1, Qt::DisplayRole, (quint64) n);
-        }
-        break;
-    case MAVLINK_TYPE_INT64_T:
-        if (msgInfo->fields[fieldid].array_length > 0)
-        {
-            int64_t* nums = (int64_t*)(m+msgInfo->fields[fieldid].wire_offset);
-            // Enforce null termination
-            QString tmp("%1, ");
-            QString string;
-            for (unsigned int j = 0; j < msgInfo->fields[fieldid].array_length; ++j)
-            {
-                string += tmp.arg(nums[j]);
-            }
-            item->setData(2, Qt::DisplayRole, QString("int64_t[%1]").arg(msgInfo->fields[fieldid].array_length));
-            item->setData(1, Qt::DisplayRole, string);
-        }
-        else
-        {
-            // Single value
-            int64_t n = *((int64_t*)(m+msgInfo->fields[fieldid].wire_offset));
-            item->setData(2, Qt::DisplayRole, "int64_t");
-            item->setData(1, Qt::DisplayRole, (qint64) n);
-        }
-        break;
-    }
+    item->setData(0, Qt::DisplayRole, QVariant(fieldInfo.name));
+    item->setData(1, Qt::DisplayRole, MAVLinkMessageStatistics::fieldValue(*msg, fieldInfo));
+    item->setData(2, Qt::DisplayRole, MAVLinkMessageStatistics::fieldTypeName(fieldInfo));
 }
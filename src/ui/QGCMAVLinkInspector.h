@@ -2,7 +2,7 @@
 #define QGCMAVLINKINSPECTOR_H
 
 #include <QMap>
-#include <QTimer>
+#include <QHash>
 
 #include "QGCDockWidget.h"
 #include "MAVLinkProtocol.h"
@@ -15,6 +15,8 @@ namespace Ui {
 class QTreeWidgetItem;
 class UASInterface;
 
+/// Tree view of the messages collected by MAVLinkMessageStatistics. The inspector does not look at the
+/// message stream itself. It only refreshes while visible and only decodes the messages which are expanded.
 class QGCMAVLinkInspector : public QGCDockWidget
 {
     Q_OBJECT
@@ -24,7 +26,6 @@ public:
     ~QGCMAVLinkInspector();
 
 public slots:
-    void receiveMessage(LinkInterface* link,mavlink_message_t message);
     /** @brief Clear all messages */
     void clearView();
     /** @brief Update view */
@@ -38,35 +39,30 @@ public slots:
 
 protected:
     MAVLinkProtocol *_protocol;     ///< MAVLink instance
+    MAVLinkMessageStatistics* _statistics;
     int selectedSystemID;          ///< Currently selected system
     int selectedComponentID;       ///< Currently selected component
     QMap<int, int> systems;     ///< Already observed systems
     QMap<int, int> components; ///< Already observed components
-    QMap<int, float> onboardMessageInterval; ///< Stores the onboard selected data rate
-    QTimer updateTimer; ///< Only update at 1 Hz to not overload the GUI
 
     QMap<int, QTreeWidgetItem* > uasTreeWidgetItems; ///< Tree of available uas with their widget
-    QMap<int, QMap<int, QTreeWidgetItem*>* > uasMsgTreeItems; ///< Stores the widget of the received message for each UAS
-
-    QMap<int, mavlink_message_t* > uasMessageStorage; ///< Stores the messages for every UAS
-
-    QMap<int, QMap<int, float>* > uasMessageHz; ///< Stores the frequency of each message of each UAS
-    QMap<int, QMap<int, unsigned int>* > uasMessageCount; ///< Stores the message count of each message of each UAS
-
-    QMap<int, QMap<int, quint64>* > uasLastMessageUpdate; ///< Stores the time of the last message for each message of each UAS
+    QMap<int, QMap<quint32, QTreeWidgetItem*>* > uasMsgTreeItems; ///< Stores the widget of the received message for each UAS, keyed by compid << 24 | msgid
+    QHash<quint64, quint64> clearedCounts;  ///< Message counts at the last clearView, keyed by sysid << 32 | compid << 24 | msgid
 
     /* @brief Update one message field */
-    void updateField(mavlink_message_t* msg, const mavlink_message_info_t* msgInfo, int fieldid, QTreeWidgetItem* item);
+    void updateField(const mavlink_message_t* msg, const mavlink_message_info_t* msgInfo, int fieldid, QTreeWidgetItem* item);
+    /* @brief Update the field items of an expanded message */
+    void updateFields(QTreeWidgetItem* messageItem);
     /** @brief Rebuild the list of components */
     void rebuildComponentList();
     /* @brief Create a new tree for a new UAS */
     void addUAStoTree(int sysId);
 
-    static const unsigned int updateInterval; ///< The update interval of the refresh function
-    static const float updateHzLowpass; ///< The low-pass filter value for the frequency of each message
-    
+    void showEvent(QShowEvent* event);
+
 private slots:
     void _vehicleAdded(Vehicle* vehicle);
+    void _itemExpanded(QTreeWidgetItem* item);
 
 private:
     Ui::QGCMAVLinkInspector *ui;
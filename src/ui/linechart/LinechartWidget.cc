@@ -42,7 +42,7 @@
 #include "QGCApplication.h"
 #include "SettingsManager.h"
 
-LinechartWidget::LinechartWidget(int systemid, QWidget *parent) : QWidget(parent),
+LinechartWidget::LinechartWidget(int systemid, QWidget *parent, MAVLinkDecoder* decoder) : QWidget(parent),
     sysid(systemid),
     activePlot(NULL),
     curvesLock(new QReadWriteLock()),
@@ -59,7 +59,8 @@ LinechartWidget::LinechartWidget(int systemid, QWidget *parent) : QWidget(parent
     logStartTime(0),
     updateTimer(new QTimer()),
     selectedMAV(-1),
-    lastTimestamp(0)
+    lastTimestamp(0),
+    mavlinkDecoder(decoder)
 {
     // Add elements defined in Qt Designer
     ui.setupUi(this);
@@ -312,6 +313,34 @@ void LinechartWidget::appendData(int uasId, const QString& curve, const QString&
     if(!ok || type == QMetaType::QByteArray || type == QMetaType::QString)
         return;
     bool isDouble = type == QMetaType::Float || type == QMetaType::Double;
+
+    _appendValue(uasId, curve, unit, value, isDouble, usec);
+}
+
+void LinechartWidget::appendSamples(int uasId, const QVector<MAVLinkDecoderSample>& samples)
+{
+    if (!mavlinkDecoder) {
+        return;
+    }
+
+    for (int i=0; i<samples.count(); i++) {
+        const MAVLinkDecoderSample& sample = samples[i];
+
+        QHash<quint32, DecoderSeries>::const_iterator iter = decoderSeries.constFind(sample.seriesId);
+        if (iter == decoderSeries.constEnd()) {
+            DecoderSeries series;
+            if (!mavlinkDecoder->seriesInfo(sample.seriesId, series.curve, series.unit, series.isDouble)) {
+                continue;
+            }
+            iter = decoderSeries.insert(sample.seriesId, series);
+        }
+
+        _appendValue(uasId, iter->curve, iter->unit, sample.value, iter->isDouble, sample.time);
+    }
+}
+
+void LinechartWidget::_appendValue(int uasId, const QString& curve, const QString& unit, double value, bool isDouble, quint64 usec)
+{
     QString curveID = curve + unit;
 
     if ((selectedMAV == -1 && isVisible()) || (selectedMAV == uasId && isVisible()))
@@ -330,7 +359,7 @@ void LinechartWidget::appendData(int uasId, const QString& curve, const QString&
 
         // Add int data
         if(!isDouble)
-            intData.insert(curveID, variant.toInt());
+            intData.insert(curveID, static_cast<int>(value));
     }
 
     if (lastTimestamp == 0 && usec != 0)
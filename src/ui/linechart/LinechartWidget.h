@@ -41,6 +41,7 @@
 #include "ui_Linechart.h"
 
 #include "LogCompressor.h"
+#include "MAVLinkDecoder.h"
 
 /**
  * @brief The linechart widget allows to visualize different timeseries as lineplot.
@@ -51,7 +52,7 @@ class LinechartWidget : public QWidget
     Q_OBJECT
 
 public:
-    LinechartWidget(int systemid, QWidget *parent = 0);
+    LinechartWidget(int systemid, QWidget *parent = 0, MAVLinkDecoder* decoder = NULL);
     ~LinechartWidget();
 
     static const int MIN_TIME_SCROLLBAR_VALUE = 0; ///< The minimum scrollbar value
@@ -66,6 +67,8 @@ public slots:
     void setShortNames(bool enable);
     /** @brief Append data to the given curve. */
     void appendData(int uasId, const QString& curve, const QString& unit, const QVariant& value, quint64 usec);
+    /** @brief Append a batch of decoder samples, curve names are resolved on first use */
+    void appendSamples(int uasId, const QVector<MAVLinkDecoderSample>& samples);
     /** @brief Hide curves which do not match the filter pattern */
     void filterCurves(const QString &filter);
 
@@ -110,6 +113,7 @@ protected:
     QToolButton* createButton(QWidget* parent);
     void createCurveItem(QString curve);
     void createLayout();
+    void _appendValue(int uasId, const QString& curve, const QString& unit, double value, bool isDouble, quint64 usec);
     /** @brief Get the name for a curve key */
     QString getCurveName(const QString& key, bool shortEnabled);
 
@@ -153,6 +157,13 @@ protected:
     QCheckBox* selectAllCheckBox;
     int selectedMAV; ///< The MAV for which plot items are accepted, -1 for all systems
     quint64 lastTimestamp;
+    MAVLinkDecoder* mavlinkDecoder;        ///< Resolves series ids from appendSamples
+    struct DecoderSeries {
+        QString curve;
+        QString unit;
+        bool    isDouble;
+    };
+    QHash<quint32, DecoderSeries> decoderSeries; ///< Series ids resolved so far
     bool userGroundTimeSet;
     bool autoGroundTimeSet;
     static const int updateInterval = 1000; ///< Time between number updates, in milliseconds
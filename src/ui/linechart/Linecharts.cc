@@ -4,6 +4,8 @@
 #include "MultiVehicleManager.h"
 #include "MainWindow.h"
 #include "UAS.h"
+#include "QGCApplication.h"
+#include "MAVLinkLogManager.h"
 
 Linecharts::Linecharts(const QString& title, QAction* action, MAVLinkDecoder* decoder, QWidget *parent)
     : MultiVehicleDockWidget(title, action, parent)
@@ -16,13 +18,16 @@ Linecharts::Linecharts(const QString& title, QAction* action, MAVLinkDecoder* de
 
 QWidget* Linecharts::_newVehicleWidget(Vehicle* vehicle, QWidget* parent)
 {
-    LinechartWidget* widget = new LinechartWidget(vehicle->id(), parent);
+    LinechartWidget* widget = new LinechartWidget(vehicle->id(), parent, _mavlinkDecoder);
 
     // Connect valueChanged signals
     connect(vehicle->uas(), &UAS::valueChanged, widget, &LinechartWidget::appendData);
 
+    // High rate topics decoded from the ULog stream while logging
+    connect(qgcApp()->toolbox()->mavlinkLogManager()->streamDecoder(), &ULogStreamDecoder::valueChanged, widget, &LinechartWidget::appendData);
+
     // Connect decoder
-    connect(_mavlinkDecoder, &MAVLinkDecoder::valueChanged, widget, &LinechartWidget::appendData);
+    connect(_mavlinkDecoder, &MAVLinkDecoder::samplesReceived, widget, &LinechartWidget::appendSamples);
 
     // Select system
     widget->setActive(true);
@@ -437,6 +437,69 @@ QGCView {
                         FactTextField {
                             fact:               QGroundControl.settingsManager.rtkSettings.surveyInMinObservationDuration
                         }
+
+                        FactCheckBox {
+                            text:               qsTr("Connect to NTRIP caster or RTCM TCP server")
+                            fact:               QGroundControl.settingsManager.rtkSettings.ntripServerConnectEnabled
+                            Layout.columnSpan:  2
+                        }
+
+                        QGCLabel {
+                            text:               qsTr("Host address:")
+                        }
+                        FactTextField {
+                            fact:               QGroundControl.settingsManager.rtkSettings.ntripServerHostAddress
+                            enabled:            QGroundControl.settingsManager.rtkSettings.ntripServerConnectEnabled.rawValue
+                        }
+
+                        QGCLabel {
+                            text:               qsTr("Port:")
+                        }
+                        FactTextField {
+                            fact:               QGroundControl.settingsManager.rtkSettings.ntripServerPort
+                            enabled:            QGroundControl.settingsManager.rtkSettings.ntripServerConnectEnabled.rawValue
+                        }
+
+                        QGCLabel {
+                            text:               qsTr("Mountpoint:")
+                        }
+                        FactTextField {
+                            fact:               QGroundControl.settingsManager.rtkSettings.ntripMountpoint
+                            enabled:            QGroundControl.settingsManager.rtkSettings.ntripServerConnectEnabled.rawValue
+                        }
+
+                        QGCLabel {
+                            text:               qsTr("User name:")
+                        }
+                        FactTextField {
+                            fact:               QGroundControl.settingsManager.rtkSettings.ntripUsername
+                            enabled:            QGroundControl.settingsManager.rtkSettings.ntripServerConnectEnabled.rawValue
+                        }
+
+                        QGCLabel {
+                            text:               qsTr("Password:")
+                        }
+                        FactTextField {
+                            fact:               QGroundControl.settingsManager.rtkSettings.ntripPassword
+                            enabled:            QGroundControl.settingsManager.rtkSettings.ntripServerConnectEnabled.rawValue
+                            echoMode:           TextInput.Password
+                        }
+
+                        QGCLabel {
+                            text:               qsTr("Message types:")
+                        }
+                        FactTextField {
+                            fact:               QGroundControl.settingsManager.rtkSettings.ntripWhitelist
+                            enabled:            QGroundControl.settingsManager.rtkSettings.ntripServerConnectEnabled.rawValue
+                        }
+
+                        QGCLabel {
+                            text:               qsTr("Bandwidth limit:")
+                        }
+                        FactTextField {
+                            fact:               QGroundControl.settingsManager.rtkSettings.ntripBandwidthLimit
+                            enabled:            QGroundControl.settingsManager.rtkSettings.ntripServerConnectEnabled.rawValue
+                        }
                     }
                 }
 
@@ -668,6 +731,34 @@ QGCView {
                                 anchors.verticalCenter: parent.verticalCenter
                             }
                         }
+                        Row {
+                            spacing:    ScreenTools.defaultFontPixelWidth
+                            visible:    QGroundControl.videoManager.isGStreamer && videoSource.currentIndex && videoSource.currentIndex < 4 && QGroundControl.settingsManager.videoSettings.showLatencyOverlay.visible
+                            QGCLabel {
+                                text:               qsTr("Show Latency Overlay:")
+                                width:              _labelWidth
+                                anchors.verticalCenter: parent.verticalCenter
+                            }
+                            FactCheckBox {
+                                text:                   ""
+                                fact:                   QGroundControl.settingsManager.videoSettings.showLatencyOverlay
+                                anchors.verticalCenter: parent.verticalCenter
+                            }
+                        }
+                        Row {
+                            spacing:    ScreenTools.defaultFontPixelWidth
+                            visible:    QGroundControl.videoManager.isGStreamer && videoSource.currentIndex && videoSource.currentIndex < 4 && QGroundControl.settingsManager.videoSettings.lowLatencyMode.visible
+                            QGCLabel {
+                                text:               qsTr("Low Latency Mode:")
+                                width:              _labelWidth
+                                anchors.verticalCenter: parent.verticalCenter
+                            }
+                            FactCheckBox {
+                                text:                   ""
+                                fact:                   QGroundControl.settingsManager.videoSettings.lowLatencyMode
+                                anchors.verticalCenter: parent.verticalCenter
+                            }
+                        }
                     }
                 } // Video Source - Rectangle
                 //-----------------------------------------------------------------
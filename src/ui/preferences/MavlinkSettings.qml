@@ -30,6 +30,7 @@ Rectangle {
     property int  _selectedCount:       0
     property real _columnSpacing:       ScreenTools.defaultFontPixelHeight * 0.25
     property bool _uploadedSelected:    false
+    property var  _streamDecoder:       QGroundControl.mavlinkLogManager.streamDecoder
 
     QGCPalette { id: qgcPal }
 
@@ -149,6 +150,15 @@ Rectangle {
                             QGroundControl.isVersionCheckEnabled = checked
                         }
                     }
+                    //-----------------------------------------------------------------
+                    //-- Link round trip time
+                    QGCCheckBox {
+                        text:       qsTr("Measure link round trip time (sends TIMESYNC)")
+                        checked:    QGroundControl.isTimesyncEnabled
+                        onClicked: {
+                            QGroundControl.isTimesyncEnabled = checked
+                        }
+                    }
                 }
             }
             //-----------------------------------------------------------------
@@ -209,6 +219,74 @@ Rectangle {
                             QGroundControl.mavlinkLogManager.enableAutoStart = checked
                         }
                     }
+                    //-----------------------------------------------------------------
+                    //-- Live plotting of logged topics
+                    Row {
+                        spacing:    ScreenTools.defaultFontPixelWidth
+                        anchors.horizontalCenter: parent.horizontalCenter
+                        QGCLabel {
+                            width:              _labelWidth
+                            text:               qsTr("Plot Logged Topic:")
+                            anchors.verticalCenter: parent.verticalCenter
+                        }
+                        QGCComboBox {
+                            id:                 topicCombo
+                            width:              _valueWidth
+                            model:              _streamDecoder.topics
+                            enabled:            count > 0
+                            anchors.verticalCenter: parent.verticalCenter
+                        }
+                    }
+                    Row {
+                        spacing:    ScreenTools.defaultFontPixelWidth
+                        anchors.horizontalCenter: parent.horizontalCenter
+                        QGCLabel {
+                            width:              _labelWidth
+                            text:               qsTr("Field:")
+                            anchors.verticalCenter: parent.verticalCenter
+                        }
+                        QGCComboBox {
+                            id:                 fieldCombo
+                            width:              (_valueWidth * 0.5) - (ScreenTools.defaultFontPixelWidth * 0.5)
+                            //-- Formats arrive with the topics, so the field list is refreshed along with them
+                            model:              _streamDecoder.topics.length > 0 ? _streamDecoder.fields(topicCombo.currentText) : []
+                            enabled:            count > 0
+                            anchors.verticalCenter: parent.verticalCenter
+                        }
+                        QGCButton {
+                            text:               qsTr("Plot")
+                            width:              (_valueWidth * 0.5) - (ScreenTools.defaultFontPixelWidth * 0.5)
+                            enabled:            fieldCombo.currentText !== ""
+                            onClicked:          _streamDecoder.subscribeListed(topicCombo.currentText, fieldCombo.currentText)
+                            anchors.verticalCenter: parent.verticalCenter
+                        }
+                    }
+                    //-- Subscribed fields show up in the Analyze line charts as "ULog:<topic>.<field>" while logging
+                    Repeater {
+                        model: _streamDecoder.subscriptions
+                        Row {
+                            spacing:    ScreenTools.defaultFontPixelWidth
+                            anchors.horizontalCenter: parent.horizontalCenter
+                            property var _fact: _streamDecoder.subscriptionFact(modelData)
+                            QGCLabel {
+                                width:              _labelWidth
+                                text:               modelData
+                                elide:              Text.ElideMiddle
+                                anchors.verticalCenter: parent.verticalCenter
+                            }
+                            QGCLabel {
+                                width:              (_valueWidth * 0.5) - (ScreenTools.defaultFontPixelWidth * 0.5)
+                                text:               _fact ? _fact.valueString : ""
+                                anchors.verticalCenter: parent.verticalCenter
+                            }
+                            QGCButton {
+                                text:               qsTr("Remove")
+                                width:              (_valueWidth * 0.5) - (ScreenTools.defaultFontPixelWidth * 0.5)
+                                onClicked:          _streamDecoder.removeSubscription(modelData)
+                                anchors.verticalCenter: parent.verticalCenter
+                            }
+                        }
+                    }
                 }
             }
             //-----------------------------------------------------------------
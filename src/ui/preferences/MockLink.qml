@@ -56,6 +56,24 @@ Rectangle {
                 text:       qsTr("Generic Vehicle")
                 onClicked:  QGroundControl.startGenericMockLink(sendStatusText.checked)
             }
+            Row {
+                spacing: ScreenTools.defaultFontPixelWidth
+                QGCButton {
+                    text:       qsTr("Generic Vehicle Swarm")
+                    onClicked:  QGroundControl.startSwarmMockLink(parseInt(swarmVehicleCount.text))
+                }
+                QGCTextField {
+                    id:                 swarmVehicleCount
+                    width:              ScreenTools.defaultFontPixelWidth * 6
+                    text:               "10"
+                    validator:          IntValidator { bottom: 1; top: 100 }
+                    anchors.verticalCenter: parent.verticalCenter
+                }
+                QGCLabel {
+                    text:                   qsTr("additional vehicles")
+                    anchors.verticalCenter: parent.verticalCenter
+                }
+            }
             QGCCheckBox {
                 id:     sendStatusText
                 text:   qsTr("Send status text + voice")
@@ -36,6 +36,8 @@ Item {
             subEditConfig.firmware = 0
         subEditConfig.sendStatus = sendStatus.checked
         subEditConfig.highLatency = highLatency.checked
+        subEditConfig.swarmVehicleCount = parseInt(swarmVehicleCount.text)
+        subEditConfig.swarmMessageMix = swarmMessageMix.currentIndex
     }
 
     Component.onCompleted: {
@@ -51,6 +53,8 @@ Item {
             copterVehicle.checked = true
         sendStatus.checked = subEditConfig.sendStatus
         highLatency.checked = subEditConfig.highLatency
+        swarmVehicleCount.text = subEditConfig.swarmVehicleCount
+        swarmMessageMix.currentIndex = subEditConfig.swarmMessageMix
     }
 
     Column {
@@ -74,6 +78,25 @@ Item {
             text:       qsTr("High latency")
             checked:    false
         }
+        Row {
+            spacing: ScreenTools.defaultFontPixelWidth
+            QGCLabel {
+                text:                   qsTr("Swarm vehicles:")
+                anchors.verticalCenter: parent.verticalCenter
+            }
+            QGCTextField {
+                id:         swarmVehicleCount
+                width:      ScreenTools.defaultFontPixelWidth * 6
+                text:       "0"
+                validator:  IntValidator { bottom: 0; top: 100 }
+            }
+            QGCComboBox {
+                id:         swarmMessageMix
+                width:      ScreenTools.defaultFontPixelWidth * 14
+                model:      [ qsTr("Light"), qsTr("Typical"), qsTr("Heavy") ]
+                enabled:    parseInt(swarmVehicleCount.text) > 0
+            }
+        }
         Item {
             height: ScreenTools.defaultFontPixelHeight / 2
             width:  parent.width
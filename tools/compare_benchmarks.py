@@ -0,0 +1,68 @@
+#!/usr/bin/env python
+#
+# (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+#
+# QGroundControl is licensed according to the terms in the file
+# COPYING.md in the root of the source code directory.
+#
+"""Compares two telemetry benchmark result files written by QGroundControl --benchmark:<file>.
+
+Prints the change of every metric and exits with 1 if a metric regressed by more than the threshold
+(default 10 percent), so it can gate a CI job.
+
+Usage: compare_benchmarks.py <baseline.json> <current.json> [threshold percent]
+"""
+
+from __future__ import print_function
+
+import json
+import sys
+
+# Metric name and whether a higher value is better
+METRICS = [
+    ("messagesPerSecond",       True),
+    ("p50LatencyUsecs",         False),
+    ("p99LatencyUsecs",         False),
+    ("allocationsPerMessage",   False),
+    ("peakMemoryKB",            False),
+]
+
+
+def load(filename):
+    with open(filename) as f:
+        results = json.load(f)
+    return results["version"], dict((benchmark["name"], benchmark) for benchmark in results["benchmarks"])
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__)
+        return 2
+
+    threshold = float(sys.argv[3]) if len(sys.argv) > 3 else 10.0
+    baselineVersion, baseline = load(sys.argv[1])
+    currentVersion, current = load(sys.argv[2])
+
+    print("%s -> %s" % (baselineVersion, currentVersion))
+
+    regressions = 0
+    for name in sorted(current):
+        if name not in baseline:
+            print("%-16s new benchmark" % name)
+            continue
+        for metric, higherIsBetter in METRICS:
+            old = baseline[name][metric]
+            new = current[name][metric]
+            if old <= 0 or new < 0:
+                continue
+            change = (new - old) * 100.0 / old
+            regressed = (change < -threshold) if higherIsBetter else (change > threshold)
+            if regressed:
+                regressions += 1
+            print("%-16s %-22s %12.2f %12.2f %+8.1f%%%s" % (name, metric, old, new, change, "  REGRESSION" if regressed else ""))
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,419 @@
+#!/usr/bin/env python
+#
+# (c) 2009-2016 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+#
+# QGroundControl is licensed according to the terms in the file
+# COPYING.md in the root of the source code directory.
+#
+"""Generates the precompiled mission command tables used by MissionCommandTree.
+
+The MavCmdInfo json hierarchy (Any Firmware/Any Vehicle, Any Firmware/Vehicle, Firmware/Any Vehicle,
+Firmware/Vehicle) is collapsed for every firmware and vehicle type the same way MissionCommandTree does
+it at runtime. The result is written as a C++ source file which holds the binary table in a constant
+array, see MissionCommandTable.h for the layout.
+
+Usage: generate_mission_command_table.py <source root> <output file>
+"""
+
+from __future__ import print_function
+
+import json
+import os
+import struct
+import sys
+
+TABLE_MAGIC =   b"QMCT"
+TABLE_VERSION = 1
+
+HEADER_SIZE =   16
+TABLE_SIZE =    12
+COMMAND_SIZE =  32
+PARAM_SIZE =    40
+
+# Command flags, must match MissionCommandTable.h
+FLAG_HAS_CATEGORY =                 1 << 0
+FLAG_HAS_RAW_NAME =                 1 << 1
+FLAG_HAS_FRIENDLY_NAME =            1 << 2
+FLAG_HAS_DESCRIPTION =              1 << 3
+FLAG_HAS_STANDALONE_COORDINATE =    1 << 4
+FLAG_HAS_SPECIFIES_COORDINATE =     1 << 5
+FLAG_HAS_SPECIFIES_ALTITUDE_ONLY =  1 << 6
+FLAG_HAS_FRIENDLY_EDIT =            1 << 7
+FLAG_STANDALONE_COORDINATE =        1 << 8
+FLAG_SPECIFIES_COORDINATE =         1 << 9
+FLAG_SPECIFIES_ALTITUDE_ONLY =      1 << 10
+FLAG_FRIENDLY_EDIT =                1 << 11
+
+UNKNOWN_DECIMAL_PLACES = -1   # FactMetaData::unknownDecimalPlaces
+QUIET_NAN = struct.unpack("<d", struct.pack("<Q", 0x7ff8000000000000))[0]
+ADVANCED_CATEGORY = "Advanced"
+
+# Resource prefix and source directory for each firmware, as returned by FirmwarePlugin::missionCommandOverrides.
+# The first entry is Any Firmware.
+FIRMWARES = [
+    (":/json/",     "src/MissionManager"),
+    (":/json/PX4/", "src/FirmwarePlugin/PX4"),
+    (":/json/APM/", "src/FirmwarePlugin/APM"),
+]
+
+# Json file for each vehicle type. The first entry is Any Vehicle.
+VEHICLE_FILES = [
+    "MavCmdInfoCommon.json",
+    "MavCmdInfoFixedWing.json",
+    "MavCmdInfoMultiRotor.json",
+    "MavCmdInfoVTOL.json",
+    "MavCmdInfoRover.json",
+    "MavCmdInfoSub.json",
+]
+
+INFO_KEYS = ["id", "rawName", "friendlyName", "description", "standaloneCoordinate", "specifiesCoordinate", "friendlyEdit",
+             "param1", "param2", "param3", "param4", "param5", "param6", "param7", "paramRemove", "category", "specifiesAltitudeOnly"]
+PARAM_KEYS = ["default", "decimalPlaces", "enumStrings", "enumValues", "label", "units", "nanUnchanged"]
+
+
+class TableError(Exception):
+    pass
+
+
+def _is_number(value):
+    return isinstance(value, (int, float)) and not isinstance(value, bool)
+
+
+def _to_int(value, default):
+    # QJsonValue::toInt
+    if _is_number(value) and int(value) == value:
+        return int(value)
+    return default
+
+
+def _to_double(value, default):
+    # QJsonValue::toDouble
+    if _is_number(value):
+        return float(value)
+    return default
+
+
+def _to_string(value):
+    # QJsonValue::toString
+    if isinstance(value, str) or (sys.version_info[0] == 2 and isinstance(value, unicode)):
+        return value
+    return ""
+
+
+def _string_to_int(string):
+    # QString::toInt, 0 if not a number
+    try:
+        return int(string.strip())
+    except ValueError:
+        return 0
+
+
+def _load_command(filename, jsonObject, requireFullObject):
+    """Mirrors MissionCommandUIInfo::loadJsonInfo"""
+    rawName = jsonObject.get("rawName", "")
+
+    def error(message):
+        return TableError("%s: %s %s" % (filename, rawName, message))
+
+    for key in jsonObject:
+        if key not in INFO_KEYS and key != "comment":
+            raise error("Unknown key: %s" % key)
+    if "id" not in jsonObject or (requireFullObject and "rawName" not in jsonObject):
+        raise error("Missing required key")
+    if not requireFullObject and ("rawName" in jsonObject or "friendlyName" in jsonObject):
+        raise error("Only the full object should specify rawName or friendlyName")
+
+    command = {
+        "id":           _to_int(jsonObject["id"], 0),
+        "info":         {},
+        "params":       {},
+        "paramRemove":  [],
+    }
+    info = command["info"]
+
+    for key in ["category", "rawName", "friendlyName", "description", "standaloneCoordinate", "specifiesCoordinate",
+                "specifiesAltitudeOnly", "friendlyEdit"]:
+        if key in jsonObject:
+            info[key] = jsonObject[key]
+    if "paramRemove" in jsonObject:
+        for indexString in _to_string(jsonObject["paramRemove"]).split(","):
+            command["paramRemove"].append(_string_to_int(indexString))
+
+    if requireFullObject:
+        info.setdefault("category", ADVANCED_CATEGORY)
+        info.setdefault("friendlyName", info["rawName"])
+        info.setdefault("description", "")
+        info.setdefault("standaloneCoordinate", False)
+        info.setdefault("specifiesCoordinate", False)
+        info.setdefault("friendlyEdit", False)
+        if info["friendlyEdit"] is True and info["rawName"] == info["friendlyName"]:
+            raise error("Missing friendlyName for friendly edit")
+
+    for index in range(1, 8):
+        paramKey = "param%d" % index
+        if paramKey not in jsonObject:
+            continue
+        paramObject = jsonObject[paramKey]
+
+        for key in paramObject:
+            if key not in PARAM_KEYS and key != "comment":
+                raise error("Unknown param key: %s" % key)
+        if "label" not in paramObject:
+            raise error("param object missing label key: %s" % paramKey)
+
+        info["friendlyEdit"] = True
+
+        nanUnchanged = paramObject.get("nanUnchanged", False) is True
+        if "default" in paramObject:
+            if paramObject["default"] is None:
+                if not nanUnchanged:
+                    raise error("Param %d default value was null/NaN but NaN is not allowed" % index)
+                default = QUIET_NAN
+            else:
+                default = _to_double(paramObject["default"], 0.0)
+        else:
+            default = QUIET_NAN if nanUnchanged else 0.0
+
+        enumStrings = [string for string in _to_string(paramObject.get("enumStrings", "")).split(",") if string]
+        enumValues = []
+        for enumValue in [string for string in _to_string(paramObject.get("enumValues", "")).split(",") if string]:
+            try:
+                enumValues.append(float(enumValue))
+            except ValueError:
+                raise error("Bad enumValue: %s" % enumValue)
+        if len(enumValues) != len(enumStrings):
+            raise error("enum strings/values count mismatch: %d, %d" % (len(enumStrings), len(enumValues)))
+
+        command["params"][index] = {
+            "label":            _to_string(paramObject["label"]),
+            "units":            _to_string(paramObject.get("units", "")),
+            "default":          default,
+            "decimalPlaces":    _to_int(paramObject.get("decimalPlaces"), UNKNOWN_DECIMAL_PLACES),
+            "nanUnchanged":     nanUnchanged,
+            "enumStrings":      enumStrings,
+            "enumValues":       enumValues,
+        }
+
+    return command
+
+
+def _load_command_list(filename, baseCommandList):
+    """Mirrors MissionCommandList::_loadMavCmdInfoJson"""
+    with open(filename, "rb") as jsonFile:
+        try:
+            jsonDocument = json.loads(jsonFile.read().decode("utf-8"))
+        except ValueError as e:
+            raise TableError("%s: Unable to open json document %s" % (filename, e))
+
+    if jsonDocument.get("version") != 1:
+        raise TableError("%s: Invalid version %s" % (filename, jsonDocument.get("version")))
+    if not isinstance(jsonDocument.get("mavCmdInfo"), list):
+        raise TableError("%s: mavCmdInfo not array" % filename)
+
+    commands = {}
+    for jsonObject in jsonDocument["mavCmdInfo"]:
+        if not isinstance(jsonObject, dict):
+            raise TableError("%s: mavCmdArray should contain objects" % filename)
+        command = _load_command(filename, jsonObject, baseCommandList)
+        commands[command["id"]] = command
+    return commands
+
+
+def _override(command, override):
+    """Mirrors MissionCommandUIInfo::_overrideInfo"""
+    command["info"].update(override["info"])
+    for removeIndex in override["paramRemove"]:
+        if removeIndex not in command["paramRemove"]:
+            command["paramRemove"].append(removeIndex)
+    for paramIndex, param in override["params"].items():
+        if paramIndex in command["paramRemove"]:
+            command["paramRemove"].remove(paramIndex)
+        command["params"][paramIndex] = param
+
+
+def _collapse(commandLists):
+    """Mirrors MissionCommandTree::_collapseHierarchy over all levels of the hierarchy"""
+    collapsed = {}
+    for commandList in commandLists:
+        for commandId in sorted(commandList):
+            command = commandList[commandId]
+            if commandId in collapsed:
+                _override(collapsed[commandId], command)
+            else:
+                collapsed[commandId] = {
+                    "id":           command["id"],
+                    "info":         dict(command["info"]),
+                    "params":       dict(command["params"]),
+                    "paramRemove":  list(command["paramRemove"]),
+                }
+    return collapsed
+
+
+class TableWriter(object):
+    def __init__(self):
+        self._data = bytearray()
+        self._strings = {}
+
+    def offset(self):
+        return len(self._data)
+
+    def append(self, data):
+        offset = len(self._data)
+        self._data += data
+        return offset
+
+    def align(self):
+        while len(self._data) % 4:
+            self._data.append(0)
+
+    def string(self, string):
+        if string not in self._strings:
+            encoded = string.encode("utf-8")
+            self.align()
+            self._strings[string] = self.append(struct.pack("<I", len(encoded)) + encoded)
+        return self._strings[string]
+
+    def patch(self, offset, data):
+        self._data[offset:offset + len(data)] = data
+
+    def data(self):
+        self.align()
+        return bytes(self._data)
+
+
+def _write_params(writer, command):
+    paramIndices = sorted(command["params"])
+
+    # Param records are written before any string so they stay contiguous
+    writer.align()
+    paramsOffset = writer.append(bytearray(PARAM_SIZE * len(paramIndices)))
+
+    for i, index in enumerate(paramIndices):
+        param = command["params"][index]
+        enumStrings = [writer.string(string) for string in param["enumStrings"]]
+        writer.align()
+        enumStringsOffset = writer.append(struct.pack("<%dI" % len(enumStrings), *enumStrings))
+        enumValuesOffset = writer.append(struct.pack("<%dd" % len(param["enumValues"]), *param["enumValues"]))
+        writer.patch(paramsOffset + i * PARAM_SIZE, struct.pack("<dIIiIIIII",
+                                                                 param["default"],
+                                                                 writer.string(param["label"]),
+                                                                 writer.string(param["units"]),
+                                                                 param["decimalPlaces"],
+                                                                 1 if param["nanUnchanged"] else 0,
+                                                                 len(param["enumStrings"]),
+                                                                 enumStringsOffset,
+                                                                 enumValuesOffset,
+                                                                 0))
+
+    return paramsOffset
+
+
+def _command_record(writer, command, paramsOffset):
+    info = command["info"]
+    flags = 0
+    strings = []
+
+    for key, hasFlag in [("category",       FLAG_HAS_CATEGORY),
+                         ("rawName",        FLAG_HAS_RAW_NAME),
+                         ("friendlyName",   FLAG_HAS_FRIENDLY_NAME),
+                         ("description",    FLAG_HAS_DESCRIPTION)]:
+        if key in info:
+            flags |= hasFlag
+            strings.append(writer.string(_to_string(info[key])))
+        else:
+            strings.append(0)
+
+    for key, hasFlag, valueFlag in [("standaloneCoordinate",   FLAG_HAS_STANDALONE_COORDINATE,     FLAG_STANDALONE_COORDINATE),
+                                    ("specifiesCoordinate",    FLAG_HAS_SPECIFIES_COORDINATE,      FLAG_SPECIFIES_COORDINATE),
+                                    ("specifiesAltitudeOnly",  FLAG_HAS_SPECIFIES_ALTITUDE_ONLY,   FLAG_SPECIFIES_ALTITUDE_ONLY),
+                                    ("friendlyEdit",           FLAG_HAS_FRIENDLY_EDIT,             FLAG_FRIENDLY_EDIT)]:
+        if key in info:
+            flags |= hasFlag
+            if info[key] is True:
+                flags |= valueFlag
+
+    # Bits 0-6: param 1-7 available, bits 8-14: param 1-7 removed
+    paramBits = 0
+    for index in command["params"]:
+        paramBits |= 1 << (index - 1)
+    for index in command["paramRemove"]:
+        if 1 <= index <= 7:
+            paramBits |= 1 << (index + 7)
+
+    return struct.pack("<IIIIIIII", command["id"], flags, strings[0], strings[1], strings[2], strings[3], paramBits, paramsOffset)
+
+
+def build_tables(rootDir):
+    """Returns the binary table for all firmware and vehicle type combinations"""
+    commandLists = {}
+
+    def commandList(firmwareIndex, vehicleIndex):
+        key = (firmwareIndex, vehicleIndex)
+        if key not in commandLists:
+            filename = os.path.join(rootDir, FIRMWARES[firmwareIndex][1], VEHICLE_FILES[vehicleIndex])
+            commandLists[key] = _load_command_list(filename, key == (0, 0))
+        return commandLists[key]
+
+    def resourceName(firmwareIndex, vehicleIndex):
+        return FIRMWARES[firmwareIndex][0] + VEHICLE_FILES[vehicleIndex]
+
+    # Same order as MissionCommandTree::_buildAvailableCommands
+    tables = []
+    for firmwareIndex in range(len(FIRMWARES)):
+        for vehicleIndex in range(len(VEHICLE_FILES)):
+            levels = [(0, 0)]
+            if vehicleIndex != 0:
+                levels.append((0, vehicleIndex))
+            if firmwareIndex != 0:
+                levels.append((firmwareIndex, 0))
+                if vehicleIndex != 0:
+                    levels.append((firmwareIndex, vehicleIndex))
+            sources = ";".join([resourceName(*level) for level in levels])
+            tables.append((sources, _collapse([commandList(*level) for level in levels])))
+
+    writer = TableWriter()
+    writer.append(struct.pack("<4sIII", TABLE_MAGIC, TABLE_VERSION, len(tables), 0))
+    directoryOffset = writer.append(bytearray(TABLE_SIZE * len(tables)))
+
+    for i, (sources, commands) in enumerate(tables):
+        commandIds = sorted(commands)
+        paramsOffsets = [_write_params(writer, commands[commandId]) for commandId in commandIds]
+        records = [_command_record(writer, commands[commandId], paramsOffset) for commandId, paramsOffset in zip(commandIds, paramsOffsets)]
+        writer.align()
+        commandsOffset = writer.append(b"".join(records))
+        writer.patch(directoryOffset + i * TABLE_SIZE, struct.pack("<III", writer.string(sources), len(commandIds), commandsOffset))
+
+    return writer.data()
+
+
+def write_source(data, outputFilename):
+    lines = []
+    lines.append("// Generated by tools/generate_mission_command_table.py from the MavCmdInfo json files, do not edit")
+    lines.append("")
+    lines.append("extern const unsigned int qgcMissionCommandTableSize = %d;" % len(data))
+    lines.append("")
+    lines.append("extern const unsigned char qgcMissionCommandTable[] = {")
+    for i in range(0, len(data), 16):
+        lines.append("    " + " ".join(["0x%02x," % byte for byte in bytearray(data[i:i + 16])]))
+    lines.append("};")
+    lines.append("")
+
+    with open(outputFilename, "w") as outputFile:
+        outputFile.write("\n".join(lines))
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__, file=sys.stderr)
+        return 1
+    try:
+        data = build_tables(sys.argv[1])
+    except TableError as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+    write_source(data, sys.argv[2])
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())